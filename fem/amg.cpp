@@ -0,0 +1,257 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "amg.hpp"
+#include "../linalg/solvers.hpp"
+#include "../linalg/sparsesmoothers.hpp"
+#include <cmath>
+
+namespace mfem
+{
+
+SmoothedAggregationAMG::SmoothedAggregationAMG()
+   : theta(0.05), max_levels(10), max_coarse_size(100),
+     smoother_type(SmootherType::CHEBYSHEV), smoother_order(2)
+{ }
+
+SmoothedAggregationAMG::SmoothedAggregationAMG(const SparseMatrix &A)
+   : SmoothedAggregationAMG()
+{
+   SetOperator(A);
+}
+
+SmoothedAggregationAMG::~SmoothedAggregationAMG()
+{
+   for (int i = 0; i < diags.Size(); i++) { delete diags[i]; }
+}
+
+int SmoothedAggregationAMG::Aggregate(const SparseMatrix &A, double theta,
+                                      Array<int> &aggregates)
+{
+   MFEM_VERIFY(A.Finalized(), "the matrix must be finalized");
+   const int n = A.Height();
+   const int *I = A.GetI();
+   const int *J = A.GetJ();
+   const double *V = A.GetData();
+   Vector diag(n);
+   A.GetDiag(diag);
+
+   // Strength of connection graph S in CSR format, assembled in two passes
+   // over the rows.
+   Array<int> S_I(n+1);
+   S_I[0] = 0;
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < n; i++)
+   {
+      int cnt = 0;
+      for (int k = I[i]; k < I[i+1]; k++)
+      {
+         const int j = J[k];
+         if (j != i && V[k] != 0.0 &&
+             std::abs(V[k]) >= theta*std::sqrt(std::abs(diag(i)*diag(j))))
+         {
+            cnt++;
+         }
+      }
+      S_I[i+1] = cnt;
+   }
+   S_I.PartialSum();
+   Array<int> S_J(S_I[n]);
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < n; i++)
+   {
+      int pos = S_I[i];
+      for (int k = I[i]; k < I[i+1]; k++)
+      {
+         const int j = J[k];
+         if (j != i && V[k] != 0.0 &&
+             std::abs(V[k]) >= theta*std::sqrt(std::abs(diag(i)*diag(j))))
+         {
+            S_J[pos++] = j;
+         }
+      }
+   }
+
+   // Phase 1: unaggregated unknowns whose strong neighbors are all free
+   // form new aggregates together with their neighbors. Unknowns without
+   // strong connections are marked with -2 and are not aggregated.
+   aggregates.SetSize(n);
+   for (int i = 0; i < n; i++)
+   {
+      aggregates[i] = (S_I[i+1] > S_I[i]) ? -1 : -2;
+   }
+   int num_agg = 0;
+   for (int i = 0; i < n; i++)
+   {
+      if (aggregates[i] != -1) { continue; }
+      bool free = true;
+      for (int k = S_I[i]; k < S_I[i+1]; k++)
+      {
+         if (aggregates[S_J[k]] >= 0) { free = false; break; }
+      }
+      if (!free) { continue; }
+      aggregates[i] = num_agg;
+      for (int k = S_I[i]; k < S_I[i+1]; k++)
+      {
+         if (aggregates[S_J[k]] == -1) { aggregates[S_J[k]] = num_agg; }
+      }
+      num_agg++;
+   }
+
+   // Phase 2: the remaining unknowns join an aggregate of a strong neighbor
+   // from phase 1.
+   Array<int> phase1(aggregates);
+   for (int i = 0; i < n; i++)
+   {
+      if (aggregates[i] != -1) { continue; }
+      for (int k = S_I[i]; k < S_I[i+1]; k++)
+      {
+         if (phase1[S_J[k]] >= 0) { aggregates[i] = phase1[S_J[k]]; break; }
+      }
+   }
+
+   // Phase 3: the unknowns left form new aggregates with their free strong
+   // neighbors.
+   for (int i = 0; i < n; i++)
+   {
+      if (aggregates[i] != -1) { continue; }
+      aggregates[i] = num_agg;
+      for (int k = S_I[i]; k < S_I[i+1]; k++)
+      {
+         if (aggregates[S_J[k]] == -1) { aggregates[S_J[k]] = num_agg; }
+      }
+      num_agg++;
+   }
+
+   for (int i = 0; i < n; i++)
+   {
+      if (aggregates[i] == -2) { aggregates[i] = -1; }
+   }
+   return num_agg;
+}
+
+SparseMatrix *SmoothedAggregationAMG::BuildProlongator(
+   const SparseMatrix &A) const
+{
+   const int n = A.Height();
+   Array<int> aggregates;
+   const int num_agg = Aggregate(A, theta, aggregates);
+   if (num_agg == 0 || num_agg >= n) { return NULL; }
+
+   // Tentative prolongator: piecewise constant on the aggregates, with
+   // columns of unit norm
+   Array<int> agg_size(num_agg);
+   agg_size = 0;
+   for (int i = 0; i < n; i++)
+   {
+      if (aggregates[i] >= 0) { agg_size[aggregates[i]]++; }
+   }
+   int *T_I = Memory<int>(n+1);
+   T_I[0] = 0;
+   for (int i = 0; i < n; i++)
+   {
+      T_I[i+1] = T_I[i] + (aggregates[i] >= 0 ? 1 : 0);
+   }
+   int *T_J = Memory<int>(T_I[n]);
+   double *T_V = Memory<double>(T_I[n]);
+   for (int i = 0; i < n; i++)
+   {
+      if (aggregates[i] < 0) { continue; }
+      T_J[T_I[i]] = aggregates[i];
+      T_V[T_I[i]] = 1.0/std::sqrt(double(agg_size[aggregates[i]]));
+   }
+   SparseMatrix T(T_I, T_J, T_V, n, num_agg);
+
+   // Smoothed prolongator P = (I - omega D^{-1} A) T with
+   // omega = 4/(3 rho(D^{-1} A))
+   SparseMatrix DinvA(A);
+   Vector dinv(n);
+   A.GetDiag(dinv);
+   double *d_dinv = dinv.HostReadWrite();
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < n; i++)
+   {
+      d_dinv[i] = (d_dinv[i] != 0.0) ? 1.0/d_dinv[i] : 0.0;
+   }
+   DinvA.ScaleRows(dinv);
+   PowerMethod power_method;
+   Vector ev(n);
+   const double rho =
+      power_method.EstimateLargestEigenvalue(DinvA, ev, 20, 1e-3);
+   const double omega = 4.0/(3.0*rho);
+   SparseMatrix *DinvAT = mfem::Mult(DinvA, T);
+   SparseMatrix *P = Add(1.0, T, -omega, *DinvAT);
+   delete DinvAT;
+   return P;
+}
+
+Solver *SmoothedAggregationAMG::MakeSmoother(SparseMatrix &A, int level)
+{
+   if (smoother_type == SmootherType::JACOBI)
+   {
+      return new DSmoother(A, 0, 2.0/3.0, smoother_order);
+   }
+   A.GetDiag(*diags[level]);
+   return new OperatorChebyshevSmoother(&A, *diags[level], no_ess_tdofs,
+                                        smoother_order);
+}
+
+void SmoothedAggregationAMG::SetOperator(const Operator &op)
+{
+   const SparseMatrix *A = dynamic_cast<const SparseMatrix*>(&op);
+   MFEM_VERIFY(A != NULL, "SmoothedAggregationAMG requires a SparseMatrix");
+   MFEM_VERIFY(A->Finalized(), "the matrix must be finalized");
+
+   ClearLevels();
+   for (int i = 0; i < diags.Size(); i++) { delete diags[i]; }
+   diags.SetSize(0);
+
+   // Build the hierarchy from the finest to the coarsest level
+   Array<SparseMatrix*> ops;
+   Array<SparseMatrix*> prolongators;
+   ops.Append(const_cast<SparseMatrix*>(A));
+   while (ops.Size() < max_levels && ops.Last()->Height() > max_coarse_size)
+   {
+      SparseMatrix *P = BuildProlongator(*ops.Last());
+      if (P == NULL) { break; }
+      prolongators.Append(P);
+      ops.Append(RAP(*P, *ops.Last(), *P));
+   }
+
+   // Multigrid levels are numbered from the coarsest to the finest one
+   const int num_levels = ops.Size();
+   diags.SetSize(num_levels);
+   for (int level = 0; level < num_levels; level++)
+   {
+      SparseMatrix &A_l = *ops[num_levels - 1 - level];
+      diags[level] = new Vector(A_l.Height());
+      Solver *solver;
+      if (level == 0 && A_l.Height() <= max_coarse_size)
+      {
+         A_l.ToDenseMatrix(coarse_mat);
+         solver = new DenseMatrixInverse(coarse_mat);
+      }
+      else
+      {
+         solver = MakeSmoother(A_l, level);
+      }
+      Operator *P = (level > 0) ? prolongators[num_levels - 1 - level] : NULL;
+      AddLevel(&A_l, solver, P, level < num_levels - 1, true, true);
+   }
+}
+
+} // namespace mfem
@@ -0,0 +1,106 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_AMG
+#define MFEM_AMG
+
+#include "multigrid.hpp"
+#include "../linalg/sparsemat.hpp"
+#include "../linalg/densemat.hpp"
+
+namespace mfem
+{
+
+/// Smoothed aggregation algebraic multigrid for a (serial) SparseMatrix
+/** The multigrid hierarchy is constructed from the matrix entries alone:
+    strongly connected unknowns are grouped into aggregates, which define a
+    piecewise constant tentative prolongator that is improved by one damped
+    Jacobi smoothing step. The coarse operators are the Galerkin products
+    P^T A P. The levels are applied with the V- or W-cycles of Multigrid, see
+    Multigrid::SetCycleType(), using Chebyshev or Jacobi smoothers and a dense
+    direct solver on the coarsest level.
+
+    The method is intended for scalar, symmetric positive definite problems,
+    e.g. diffusion; the near null space is assumed to be the constant vector.
+    Unknowns without strong connections, such as eliminated essential dofs,
+    are not aggregated and are only treated by the smoothers.
+
+    The options must be set before SetOperator(), which builds the hierarchy.
+    With OpenMP enabled, the strength of connection and the prolongator
+    smoothing are computed in parallel. */
+class SmoothedAggregationAMG : public Multigrid
+{
+public:
+   enum class SmootherType
+   {
+      JACOBI,
+      CHEBYSHEV
+   };
+
+protected:
+   double theta;
+   int max_levels, max_coarse_size;
+   SmootherType smoother_type;
+   int smoother_order;
+
+   Array<Vector*> diags;     ///< Level diagonals used by the smoothers
+   Array<int> no_ess_tdofs;  ///< Empty list for OperatorChebyshevSmoother
+   DenseMatrix coarse_mat;
+
+   /// Return the smoothed prolongator for @a A, or NULL if @a A cannot be
+   /// coarsened.
+   SparseMatrix *BuildProlongator(const SparseMatrix &A) const;
+
+   Solver *MakeSmoother(SparseMatrix &A, int level);
+
+public:
+   /// Construct an empty AMG solver; call SetOperator() to set it up.
+   SmoothedAggregationAMG();
+
+   /// Construct the AMG solver for @a A, using the default options.
+   SmoothedAggregationAMG(const SparseMatrix &A);
+
+   virtual ~SmoothedAggregationAMG();
+
+   /** @brief Set the strength of connection threshold: a_ij is strong if
+       |a_ij| >= theta sqrt(|a_ii a_jj|). The default is 0.05; smaller values
+       give larger aggregates and fewer levels. */
+   void SetStrengthThreshold(double theta_) { theta = theta_; }
+
+   /// Set the maximum number of levels, the default is 10.
+   void SetMaxLevels(int levels) { max_levels = levels; }
+
+   /** @brief Set the size below which no further coarsening is done; the
+       coarsest level is solved directly. The default is 100. */
+   void SetMaxCoarseSize(int size) { max_coarse_size = size; }
+
+   /** @brief Set the type of the level smoothers. For CHEBYSHEV, @a order is
+       the polynomial order; for JACOBI it is the number of damped Jacobi
+       sweeps. The default is CHEBYSHEV of order 2. */
+   void SetSmoother(SmootherType type, int order = 2)
+   { smoother_type = type; smoother_order = order; }
+
+   /// Build the multigrid hierarchy for @a op, which must be a SparseMatrix.
+   virtual void SetOperator(const Operator &op) override;
+
+   /** @brief Group the unknowns of @a A into aggregates based on the strength
+       of connection threshold @a theta.
+
+       On return, @a aggregates[i] is the aggregate of unknown i, or -1 if
+       the unknown has no strong connections. Returns the number of
+       aggregates. */
+   static int Aggregate(const SparseMatrix &A, double theta,
+                        Array<int> &aggregates);
+};
+
+} // namespace mfem
+
+#endif
@@ -14,21 +14,96 @@
 #include "fem.hpp"
 #include "../general/device.hpp"
 #include <cmath>
+#include <algorithm>
 
 namespace mfem
 {
 
+// Build the element-to-dof (or element-to-vdof) table of the space with the
+// signs of the dofs removed.
+static void GetUnsignedElementDofTable(FiniteElementSpace &fes, bool use_vdofs,
+                                       Table &elem_dof)
+{
+   const int ne = fes.GetNE();
+   Array<int> dofs;
+   elem_dof.MakeI(ne);
+   for (int i = 0; i < ne; i++)
+   {
+      if (use_vdofs) { fes.GetElementVDofs(i, dofs); }
+      else { fes.GetElementDofs(i, dofs); }
+      elem_dof.AddColumnsInRow(i, dofs.Size());
+   }
+   elem_dof.MakeJ();
+   for (int i = 0; i < ne; i++)
+   {
+      if (use_vdofs) { fes.GetElementVDofs(i, dofs); }
+      else { fes.GetElementDofs(i, dofs); }
+      for (int j = 0; j < dofs.Size(); j++)
+      {
+         if (dofs[j] < 0) { dofs[j] = -1-dofs[j]; }
+      }
+      elem_dof.AddConnections(i, dofs.GetData(), dofs.Size());
+   }
+   elem_dof.ShiftUpI();
+}
+
+// Add the element matrix to the finalized CSR matrix (I,J,A). Unlike
+// SparseMatrix::AddSubMatrix this does not use the internal column pointer of
+// the matrix, so it can be called concurrently for elements with disjoint dofs.
+// With skip_zeros != 0, zero entries are skipped unless their transpose is
+// nonzero, as in SparseMatrix::AddSubMatrix with the same rows and columns.
+static void AddElementMatrixCSR(const Array<int> &vdofs,
+                                const DenseMatrix &elmat, int skip_zeros,
+                                bool sorted, const int *I, const int *J,
+                                double *A)
+{
+   const int n = vdofs.Size();
+   for (int i = 0; i < n; i++)
+   {
+      int gi = vdofs[i], s = 1;
+      if (gi < 0) { gi = -1-gi; s = -1; }
+      const int *row_J = J + I[gi];
+      const int row_size = I[gi+1] - I[gi];
+      double *row_A = A + I[gi];
+      for (int j = 0; j < n; j++)
+      {
+         int gj = vdofs[j], t = s;
+         if (gj < 0) { gj = -1-gj; t = -s; }
+         const double a = elmat(i, j);
+         if (skip_zeros && a == 0.0 && elmat(j, i) == 0.0) { continue; }
+         int k;
+         if (sorted)
+         {
+            k = std::lower_bound(row_J, row_J + row_size, gj) - row_J;
+         }
+         else
+         {
+            for (k = 0; k < row_size && row_J[k] != gj; k++) { }
+         }
+         MFEM_VERIFY(k < row_size && row_J[k] == gj,
+                     "entry (" << gi << "," << gj << ") is not in the "
+                     "sparsity pattern of the matrix");
+         row_A[k] += (t < 0) ? -a : a;
+      }
+   }
+}
+
 void BilinearForm::AllocMat()
 {
    if (static_cond) { return; }
 
-   if (precompute_sparsity == 0 || fes->GetVDim() > 1)
+   // The threaded assembly requires the full CSR pattern, including vdim > 1
+   const bool threaded = ThreadedAssemblyEnabled();
+   if (!threaded && (precompute_sparsity == 0 || fes->GetVDim() > 1))
    {
       mat = new SparseMatrix(height);
       return;
    }
 
-   const Table &elem_dof = fes->GetElementToDofTable();
+   Table elem_vdof;
+   if (threaded) { GetUnsignedElementDofTable(*fes, true, elem_vdof); }
+   const Table &elem_dof =
+      threaded ? elem_vdof : fes->GetElementToDofTable();
    Table dof_dof;
 
    if (fbfi.Size() > 0)
@@ -74,6 +149,9 @@ BilinearForm::BilinearForm(FiniteElementSpace * f)
    static_cond = NULL;
    hybridization = NULL;
    precompute_sparsity = 0;
+   fast_assembly = false;
+   threaded_assembly = false;
+   elem_colors = NULL;
    diag_policy = DIAG_KEEP;
 
    assembly = AssemblyLevel::FULL;
@@ -92,6 +170,9 @@ BilinearForm::BilinearForm (FiniteElementSpace * f, BilinearForm * bf, int ps)
    static_cond = NULL;
    hybridization = NULL;
    precompute_sparsity = ps;
+   fast_assembly = false;
+   threaded_assembly = false;
+   elem_colors = NULL;
    diag_policy = DIAG_KEEP;
 
    assembly = AssemblyLevel::FULL;
@@ -122,8 +203,8 @@ void BilinearForm::SetAssemblyLevel(AssemblyLevel assembly_level)
    switch (assembly)
    {
       case AssemblyLevel::FULL:
-         // ext = new FABilinearFormExtension(this);
-         // Use the original BilinearForm implementation for now
+         // Use the original BilinearForm implementation, unless the device
+         // assembly is enabled with UseFastAssembly(), see Assemble()
          break;
       case AssemblyLevel::ELEMENT:
          ext = new EABilinearFormExtension(this);
@@ -132,8 +213,7 @@ void BilinearForm::SetAssemblyLevel(AssemblyLevel assembly_level)
          ext = new PABilinearFormExtension(this);
          break;
       case AssemblyLevel::NONE:
-         mfem_error("Matrix-free action not supported yet... stay tuned!");
-         // ext = new MFBilinearFormExtension(this);
+         ext = new MFBilinearFormExtension(this);
          break;
       default:
          mfem_error("Unknown assembly level");
@@ -373,8 +453,170 @@ void BilinearForm::AssembleBdrElementMatrix(
    }
 }
 
+bool BilinearForm::ThreadedAssemblyEnabled() const
+{
+#if defined(MFEM_USE_OPENMP) && defined(MFEM_THREAD_SAFE)
+   if (Device::Allows(Backend::OMP_MASK)) { return true; }
+#endif
+   return threaded_assembly;
+}
+
+void BilinearForm::ComputeElementColoring()
+{
+   delete elem_colors;
+
+   // Greedy coloring of the graph where two elements are connected if they
+   // share a dof
+   Table elem_dof, dof_elem;
+   GetUnsignedElementDofTable(*fes, false, elem_dof);
+   Transpose(elem_dof, dof_elem, fes->GetNDofs());
+
+   const int ne = fes->GetNE();
+   Array<int> color(ne), color_mark;
+   color = -1;
+   int num_colors = 0;
+   for (int i = 0; i < ne; i++)
+   {
+      const int *dofs = elem_dof.GetRow(i);
+      for (int j = 0; j < elem_dof.RowSize(i); j++)
+      {
+         const int *elems = dof_elem.GetRow(dofs[j]);
+         for (int k = 0; k < dof_elem.RowSize(dofs[j]); k++)
+         {
+            const int c = color[elems[k]];
+            if (c >= 0) { color_mark[c] = i; }
+         }
+      }
+      int c = 0;
+      while (c < num_colors && color_mark[c] == i) { c++; }
+      if (c == num_colors) { color_mark.Append(-1); num_colors++; }
+      color[i] = c;
+   }
+
+   elem_colors = new Table;
+   elem_colors->MakeI(num_colors);
+   for (int i = 0; i < ne; i++) { elem_colors->AddAColumnInRow(color[i]); }
+   elem_colors->MakeJ();
+   for (int i = 0; i < ne; i++) { elem_colors->AddConnection(color[i], i); }
+   elem_colors->ShiftUpI();
+}
+
+void BilinearForm::ThreadedAssembleDomain(int skip_zeros)
+{
+   MFEM_VERIFY(mat && mat->Finalized(), "the matrix must be finalized");
+
+   if (elem_colors == NULL) { ComputeElementColoring(); }
+
+   const int *I = mat->HostReadI();
+   const int *J = mat->HostReadJ();
+   double *A = mat->HostReadWriteData();
+   const bool sorted = mat->ColumnsAreSorted();
+
+   // Evaluate one element matrix per geometry type serially, so that the
+   // integration rules and other data created on first use are not
+   // constructed concurrently.
+   {
+      Array<bool> geom_seen(Geometry::NUM_GEOMETRIES);
+      geom_seen = false;
+      DenseMatrix elmat;
+      for (int i = 0; i < fes->GetNE(); i++)
+      {
+         const int geom = fes->GetFE(i)->GetGeomType();
+         if (geom_seen[geom]) { continue; }
+         geom_seen[geom] = true;
+         ElementTransformation *eltrans = fes->GetElementTransformation(i);
+         for (int k = 0; k < dbfi.Size(); k++)
+         {
+            dbfi[k]->AssembleElementMatrix(*fes->GetFE(i), *eltrans, elmat);
+         }
+      }
+   }
+
+   const int num_colors = elem_colors->Size();
+#if defined(MFEM_USE_OPENMP) && defined(MFEM_THREAD_SAFE)
+   #pragma omp parallel
+#endif
+   {
+      DenseMatrix elmat, elmat_k;
+      IsoparametricTransformation eltrans;
+      Array<int> el_vdofs;
+      for (int c = 0; c < num_colors; c++)
+      {
+         const int *elems = elem_colors->GetRow(c);
+         const int nc = elem_colors->RowSize(c);
+#if defined(MFEM_USE_OPENMP) && defined(MFEM_THREAD_SAFE)
+         #pragma omp for schedule(dynamic, 16)
+#endif
+         for (int k = 0; k < nc; k++)
+         {
+            const int i = elems[k];
+            const FiniteElement &fe = *fes->GetFE(i);
+            fes->GetElementVDofs(i, el_vdofs);
+            fes->GetElementTransformation(i, &eltrans);
+            dbfi[0]->AssembleElementMatrix(fe, eltrans, elmat);
+            for (int m = 1; m < dbfi.Size(); m++)
+            {
+               dbfi[m]->AssembleElementMatrix(fe, eltrans, elmat_k);
+               elmat += elmat_k;
+            }
+            AddElementMatrixCSR(el_vdofs, elmat, skip_zeros, sorted, I, J, A);
+         }
+      }
+   }
+}
+
+bool BilinearForm::SupportsFastAssembly() const
+{
+   if (static_cond || hybridization || element_matrices) { return false; }
+   if (bbfi.Size() > 0) { return false; }
+   for (int k = 0; k < dbfi.Size(); k++)
+   {
+      if (!dbfi[k]->SupportsEA()) { return false; }
+   }
+   for (int k = 0; k < fbfi.Size(); k++)
+   {
+      if (!fbfi[k]->SupportsEAFaces()) { return false; }
+   }
+   for (int k = 0; k < bfbfi.Size(); k++)
+   {
+      if (!bfbfi[k]->SupportsEAFaces() || bfbfi_marker[k]) { return false; }
+   }
+
+   if (fes->GetVDim() != 1 || !fes->Conforming()) { return false; }
+   if (fes->GetNURBSext()) { return false; }
+   if ((fbfi.Size() > 0 || bfbfi.Size() > 0) &&
+       !dynamic_cast<const L2_FECollection*>(fes->FEColl()))
+   {
+      return false;
+   }
+   const Mesh &mesh = *fes->GetMesh();
+   if (mesh.GetNumGeometries(mesh.Dimension()) > 1) { return false; }
+   if (fes->GetNE() > 0 &&
+       !dynamic_cast<const TensorBasisElement*>(fes->GetFE(0)))
+   {
+      return false;
+   }
+   return true;
+}
+
 void BilinearForm::Assemble(int skip_zeros)
 {
+   if (assembly == AssemblyLevel::FULL)
+   {
+      // Switch between the device and the original full assembly, see
+      // UseFastAssembly(). The two do not share the matrix structure.
+      const bool use_fa = fast_assembly && SupportsFastAssembly();
+      if (use_fa != (ext != NULL))
+      {
+         delete ext;
+         ext = use_fa ? new FABilinearFormExtension(this) : NULL;
+         delete mat_e;
+         mat_e = NULL;
+         delete mat;
+         mat = NULL;
+      }
+   }
+
    if (ext)
    {
       ext->Assemble();
@@ -385,6 +627,14 @@ void BilinearForm::Assemble(int skip_zeros)
    Mesh *mesh = fes -> GetMesh();
    DenseMatrix elmat, *elmat_p;
 
+   // AddElementMatrixCSR() implements only the skip_zeros = 0 and 1 rules of
+   // SparseMatrix::AddSubMatrix(); other values (e.g. skip_zeros = 2) use the
+   // serial path.
+   const bool threaded = ThreadedAssemblyEnabled() && dbfi.Size() &&
+                         (skip_zeros == 0 || skip_zeros == 1) &&
+                         !static_cond && !hybridization &&
+                         !element_matrices && (!mat || mat->Finalized());
+
    if (mat == NULL)
    {
       AllocMat();
@@ -392,14 +642,18 @@ void BilinearForm::Assemble(int skip_zeros)
 
 #ifdef MFEM_USE_LEGACY_OPENMP
    int free_element_matrices = 0;
-   if (!element_matrices)
+   if (!element_matrices && !threaded)
    {
       ComputeElementMatrices();
       free_element_matrices = 1;
    }
 #endif
 
-   if (dbfi.Size())
+   if (threaded)
+   {
+      ThreadedAssembleDomain(skip_zeros);
+   }
+   else if (dbfi.Size())
    {
       for (int i = 0; i < fes -> GetNE(); i++)
       {
@@ -1006,6 +1260,19 @@ void BilinearForm::Mult(const Vector &x, Vector &y) const
    }
 }
 
+void BilinearForm::MultTranspose(const Vector &x, Vector &y) const
+{
+   if (ext)
+   {
+      ext->MultTranspose(x, y);
+   }
+   else
+   {
+      y = 0.0;
+      AddMultTranspose(x, y);
+   }
+}
+
 void BilinearForm::Update(FiniteElementSpace *nfes)
 {
    bool full_update;
@@ -1035,6 +1302,8 @@ void BilinearForm::Update(FiniteElementSpace *nfes)
       mat = NULL;
       delete hybridization;
       hybridization = NULL;
+      delete elem_colors;
+      elem_colors = NULL;
       sequence = fes->GetSequence();
    }
    else
@@ -1060,6 +1329,7 @@ BilinearForm::~BilinearForm()
    delete element_matrices;
    delete static_cond;
    delete hybridization;
+   delete elem_colors;
 
    if (!extern_bfs)
    {
@@ -50,6 +50,8 @@ enum class AssemblyLevel
     SetAssemblyLevel() function. */
 class BilinearForm : public Matrix
 {
+   friend class FABilinearFormExtension;
+
 protected:
    /// Sparse matrix \f$ M \f$ to be associated with the form. Owned.
    SparseMatrix *mat;
@@ -109,6 +111,24 @@ protected:
    // Allocate appropriate SparseMatrix and assign it to mat
    void AllocMat();
 
+   /// Indicates that UseFastAssembly() was enabled.
+   bool fast_assembly;
+
+   /// Use the thread-parallel, element-colored assembly of the domain terms.
+   bool threaded_assembly;
+   /** @brief Element coloring used by the threaded assembly: row c of the table
+       lists the elements of color c. Owned. */
+   Table *elem_colors;
+
+   // Is the threaded assembly requested, either explicitly or via the Device?
+   bool ThreadedAssemblyEnabled() const;
+
+   // Color the elements so that no two elements of the same color share a dof
+   void ComputeElementColoring();
+
+   // Assemble the domain integrators color by color into the finalized mat
+   void ThreadedAssembleDomain(int skip_zeros);
+
    void ConformingAssemble();
 
    // may be used in the construction of derived classes
@@ -118,6 +138,9 @@ protected:
       mat = mat_e = NULL; extern_bfs = 0; element_matrices = NULL;
       static_cond = NULL; hybridization = NULL;
       precompute_sparsity = 0;
+      fast_assembly = false;
+      threaded_assembly = false;
+      elem_colors = NULL;
       diag_policy = DIAG_KEEP;
       assembly = AssemblyLevel::FULL;
       batch = 1;
@@ -159,6 +182,9 @@ public:
        - AssemblyLevel::ELEMENT
        - AssemblyLevel::NONE
 
+       AssemblyLevel::FULL uses the original BilinearForm implementation,
+       unless the device assembly is enabled with UseFastAssembly().
+
        This method must be called before assembly. */
    void SetAssemblyLevel(AssemblyLevel assembly_level);
 
@@ -192,6 +218,48 @@ public:
        present in the bilinear form. */
    void UsePrecomputedSparsity(int ps = 1) { precompute_sparsity = ps; }
 
+   /// Enable or disable the device assembly of AssemblyLevel::FULL.
+   /** When enabled, Assemble() uses a FABilinearFormExtension if
+       SupportsFastAssembly() returns true, and the original BilinearForm
+       implementation otherwise. */
+   void UseFastAssembly(bool use_fa) { fast_assembly = use_fa; }
+
+   /** @brief Return true if the integrators and the FE space support the
+       device assembly of FABilinearFormExtension. */
+   /** All domain integrators must implement AssembleEA() and all interior and
+       boundary face integrators must implement AssembleEAInteriorFaces() and
+       AssembleEABoundaryFaces(), see BilinearFormIntegrator::SupportsEA() and
+       BilinearFormIntegrator::SupportsEAFaces(). There must be no boundary
+       integrators and no boundary face markers, and face integrators require
+       an L2 space. The space must be conforming, with vdim = 1 and
+       tensor-product elements of a single type. Static condensation,
+       hybridization and stored element matrices are not supported. */
+   virtual bool SupportsFastAssembly() const;
+
+   /** @brief Enable the thread-parallel full assembly of the domain
+       integrators.
+
+       The elements are colored such that elements of the same color do not
+       share any dofs. The element matrices of each color are then computed and
+       added, concurrently, directly into a preallocated CSR sparsity pattern
+       (finalized matrix). The threads are used only when MFEM is built with
+       both MFEM_USE_OPENMP and MFEM_THREAD_SAFE (the integrators use internal
+       scratch storage otherwise); in that configuration this mode is also
+       selected automatically when the Device uses an OpenMP backend.
+
+       This mode is not used with static condensation, hybridization, or stored
+       element matrices, when the internal matrix is already allocated in
+       non-finalized form, or when Assemble() is called with a @a skip_zeros
+       value other than 0 or 1. This method should be called before assembly.
+   */
+   void EnableThreadedAssembly(bool enable = true)
+   { threaded_assembly = enable; }
+
+   /** @brief Return the element coloring used by the threaded assembly, or
+       NULL if it has not been computed. Row c of the Table lists the elements
+       of color c. */
+   const Table *GetElementColoring() const { return elem_colors; }
+
    /** @brief Use the given CSR sparsity pattern to allocate the internal
        SparseMatrix.
 
@@ -272,8 +340,7 @@ public:
    { mat->AddMultTranspose(x, y); mat_e->AddMultTranspose(x, y); }
 
    /// Matrix transpose vector multiplication:  \f$ y = M^T x \f$
-   virtual void MultTranspose(const Vector & x, Vector & y) const
-   { y = 0.0; AddMultTranspose (x, y); }
+   virtual void MultTranspose(const Vector & x, Vector & y) const;
 
    /// Compute \f$ y^T M x \f$
    double InnerProduct(const Vector &x, const Vector &y) const
@@ -15,6 +15,10 @@
 #include "../general/forall.hpp"
 #include "bilinearform.hpp"
 #include "libceed/ceed.hpp"
+#ifdef MFEM_USE_MPI
+#include "pfespace.hpp"
+#endif
+#include <algorithm>
 
 namespace mfem
 {
@@ -45,6 +49,26 @@ PABilinearFormExtension::PABilinearFormExtension(BilinearForm *form)
    elem_restrict = NULL;
    int_face_restrict_lex = NULL;
    bdr_face_restrict_lex = NULL;
+   int_face_dxdn = NULL;
+   bdr_face_dxdn = NULL;
+   comm_overlap = false;
+}
+
+PABilinearFormExtension::~PABilinearFormExtension()
+{
+   delete int_face_dxdn;
+   delete bdr_face_dxdn;
+}
+
+// Return true if any of the face integrators needs normal derivatives.
+static bool RequiresFaceNormalDerivatives(
+   const Array<BilinearFormIntegrator*> &integs)
+{
+   for (int i = 0; i < integs.Size(); ++i)
+   {
+      if (integs[i]->RequiresFaceNormalDerivatives()) { return true; }
+   }
+   return false;
 }
 
 void PABilinearFormExtension::SetupRestrictionOperators(const L2FaceValues m)
@@ -82,6 +106,24 @@ void PABilinearFormExtension::SetupRestrictionOperators(const L2FaceValues m)
       faceBdrY.SetSize(bdr_face_restrict_lex->Height(), Device::GetMemoryType());
       faceBdrY.UseDevice(true); // ensure 'faceBoundY = 0.0' is done on device
    }
+
+   if (int_face_dxdn == NULL && RequiresFaceNormalDerivatives(*a->GetFBFI()))
+   {
+      int_face_dxdn = new L2NormalDerivativeFaceRestriction(*trialFes,
+                                                            FaceType::Interior);
+      faceIntDX.SetSize(int_face_dxdn->Height(), Device::GetMemoryType());
+      faceIntDY.SetSize(int_face_dxdn->Height(), Device::GetMemoryType());
+      faceIntDY.UseDevice(true);
+   }
+
+   if (bdr_face_dxdn == NULL && RequiresFaceNormalDerivatives(*a->GetBFBFI()))
+   {
+      bdr_face_dxdn = new L2NormalDerivativeFaceRestriction(*trialFes,
+                                                            FaceType::Boundary);
+      faceBdrDX.SetSize(bdr_face_dxdn->Height(), Device::GetMemoryType());
+      faceBdrDY.SetSize(bdr_face_dxdn->Height(), Device::GetMemoryType());
+      faceBdrDY.UseDevice(true);
+   }
 }
 
 void PABilinearFormExtension::Assemble()
@@ -154,6 +196,24 @@ void PABilinearFormExtension::Update()
    elem_restrict = nullptr;
    int_face_restrict_lex = nullptr;
    bdr_face_restrict_lex = nullptr;
+   delete int_face_dxdn;
+   delete bdr_face_dxdn;
+   int_face_dxdn = nullptr;
+   bdr_face_dxdn = nullptr;
+}
+
+Operator *PABilinearFormExtension::SetupRAP(const Operator *Pi,
+                                            const Operator *Po)
+{
+#ifdef MFEM_USE_MPI
+   if (comm_overlap && Pi == Po && PAOverlapRAPOperator::Supports(*this, Pi))
+   {
+      return new PAOverlapRAPOperator(
+                *this, *static_cast<const ConformingProlongationOperator*>(Pi),
+                *static_cast<const ElementRestriction*>(elem_restrict));
+   }
+#endif
+   return Operator::SetupRAP(Pi, Po);
 }
 
 void PABilinearFormExtension::FormSystemMatrix(const Array<int> &ess_tdof_list,
@@ -200,40 +260,181 @@ void PABilinearFormExtension::Mult(const Vector &x, Vector &y) const
       elem_restrict->MultTranspose(localY, y);
    }
 
-   Array<BilinearFormIntegrator*> &intFaceIntegrators = *a->GetFBFI();
-   const int iFISz = intFaceIntegrators.Size();
-   if (int_face_restrict_lex && iFISz>0)
+   AddMultFaces(*a->GetFBFI(), int_face_restrict_lex, int_face_dxdn,
+                faceIntX, faceIntY, faceIntDX, faceIntDY, x, y, false);
+   AddMultFaces(*a->GetBFBFI(), bdr_face_restrict_lex, bdr_face_dxdn,
+                faceBdrX, faceBdrY, faceBdrDX, faceBdrDY, x, y, false);
+}
+
+void PABilinearFormExtension::MultTranspose(const Vector &x, Vector &y) const
+{
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   const int iSz = integrators.Size();
+   if (elem_restrict)
    {
-      int_face_restrict_lex->Mult(x, faceIntX);
-      if (faceIntX.Size()>0)
+      elem_restrict->Mult(x, localX);
+      localY = 0.0;
+      for (int i = 0; i < iSz; ++i)
       {
-         faceIntY = 0.0;
-         for (int i = 0; i < iFISz; ++i)
-         {
-            intFaceIntegrators[i]->AddMultPA(faceIntX, faceIntY);
-         }
-         int_face_restrict_lex->MultTranspose(faceIntY, y);
+         integrators[i]->AddMultTransposePA(localX, localY);
+      }
+      elem_restrict->MultTranspose(localY, y);
+   }
+   else
+   {
+      y.UseDevice(true);
+      y = 0.0;
+      for (int i = 0; i < iSz; ++i)
+      {
+         integrators[i]->AddMultTransposePA(x, y);
       }
    }
 
-   Array<BilinearFormIntegrator*> &bdrFaceIntegrators = *a->GetBFBFI();
-   const int bFISz = bdrFaceIntegrators.Size();
-   if (bdr_face_restrict_lex && bFISz>0)
+   AddMultFaces(*a->GetFBFI(), int_face_restrict_lex, int_face_dxdn,
+                faceIntX, faceIntY, faceIntDX, faceIntDY, x, y, true);
+   AddMultFaces(*a->GetBFBFI(), bdr_face_restrict_lex, bdr_face_dxdn,
+                faceBdrX, faceBdrY, faceBdrDX, faceBdrDY, x, y, true);
+}
+
+void PABilinearFormExtension::AddMultFaces(
+   const Array<BilinearFormIntegrator*> &integs,
+   const Operator *face_restrict, const Operator *face_dxdn,
+   Vector &faceX, Vector &faceY, Vector &faceDX, Vector &faceDY,
+   const Vector &x, Vector &y, bool transpose) const
+{
+   const int nint = integs.Size();
+   if (!face_restrict || nint == 0) { return; }
+   face_restrict->Mult(x, faceX);
+   if (faceX.Size() == 0) { return; }
+   faceY = 0.0;
+   if (face_dxdn)
    {
-      bdr_face_restrict_lex->Mult(x, faceBdrX);
-      if (faceBdrX.Size()>0)
+      face_dxdn->Mult(x, faceDX);
+      faceDY = 0.0;
+   }
+   for (int i = 0; i < nint; ++i)
+   {
+      if (integs[i]->RequiresFaceNormalDerivatives())
       {
-         faceBdrY = 0.0;
-         for (int i = 0; i < bFISz; ++i)
+         if (transpose)
          {
-            bdrFaceIntegrators[i]->AddMultPA(faceBdrX, faceBdrY);
+            integs[i]->AddMultTransposePAFaceNormalDerivatives(faceX, faceDX,
+                                                               faceY, faceDY);
+         }
+         else
+         {
+            integs[i]->AddMultPAFaceNormalDerivatives(faceX, faceDX,
+                                                      faceY, faceDY);
          }
-         bdr_face_restrict_lex->MultTranspose(faceBdrY, y);
+      }
+      else if (transpose)
+      {
+         integs[i]->AddMultTransposePA(faceX, faceY);
+      }
+      else
+      {
+         integs[i]->AddMultPA(faceX, faceY);
       }
    }
+   face_restrict->MultTranspose(faceY, y);
+   if (face_dxdn) { face_dxdn->MultTranspose(faceDY, y); }
 }
 
-void PABilinearFormExtension::MultTranspose(const Vector &x, Vector &y) const
+// Data and methods for matrix-free bilinear forms
+MFBilinearFormExtension::MFBilinearFormExtension(BilinearForm *form)
+   : BilinearFormExtension(form),
+     trialFes(a->FESpace()),
+     testFes(a->FESpace())
+{
+   elem_restrict = NULL;
+}
+
+void MFBilinearFormExtension::Assemble()
+{
+   MFEM_VERIFY(a->GetFBFI()->Size() == 0 && a->GetBFBFI()->Size() == 0,
+               "face integrators are not supported with AssemblyLevel::NONE");
+   ElementDofOrdering ordering = UsesTensorBasis(*a->FESpace())?
+                                 ElementDofOrdering::LEXICOGRAPHIC:
+                                 ElementDofOrdering::NATIVE;
+   elem_restrict = trialFes->GetElementRestriction(ordering);
+   if (elem_restrict)
+   {
+      localX.SetSize(elem_restrict->Height(), Device::GetDeviceMemoryType());
+      localY.SetSize(elem_restrict->Height(), Device::GetDeviceMemoryType());
+      localY.UseDevice(true); // ensure 'localY = 0.0' is done on device
+   }
+
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   const int integratorCount = integrators.Size();
+   for (int i = 0; i < integratorCount; ++i)
+   {
+      integrators[i]->AssembleMF(*a->FESpace());
+   }
+}
+
+void MFBilinearFormExtension::AssembleDiagonal(Vector &y) const
+{
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   const int iSz = integrators.Size();
+   if (elem_restrict)
+   {
+      localY = 0.0;
+      for (int i = 0; i < iSz; ++i)
+      {
+         integrators[i]->AssembleDiagonalMF(localY);
+      }
+      const ElementRestriction* H1elem_restrict =
+         dynamic_cast<const ElementRestriction*>(elem_restrict);
+      if (H1elem_restrict)
+      {
+         H1elem_restrict->MultTransposeUnsigned(localY, y);
+      }
+      else
+      {
+         elem_restrict->MultTranspose(localY, y);
+      }
+   }
+   else
+   {
+      y.UseDevice(true); // typically this is a large vector, so store on device
+      y = 0.0;
+      for (int i = 0; i < iSz; ++i)
+      {
+         integrators[i]->AssembleDiagonalMF(y);
+      }
+   }
+}
+
+void MFBilinearFormExtension::Update()
+{
+   FiniteElementSpace *fes = a->FESpace();
+   height = width = fes->GetVSize();
+   trialFes = fes;
+   testFes = fes;
+
+   elem_restrict = nullptr;
+}
+
+void MFBilinearFormExtension::FormSystemMatrix(const Array<int> &ess_tdof_list,
+                                               OperatorHandle &A)
+{
+   Operator *oper;
+   Operator::FormSystemOperator(ess_tdof_list, oper);
+   A.Reset(oper); // A will own oper
+}
+
+void MFBilinearFormExtension::FormLinearSystem(const Array<int> &ess_tdof_list,
+                                               Vector &x, Vector &b,
+                                               OperatorHandle &A,
+                                               Vector &X, Vector &B,
+                                               int copy_interior)
+{
+   Operator *oper;
+   Operator::FormLinearSystem(ess_tdof_list, x, b, oper, X, B, copy_interior);
+   A.Reset(oper); // A will own oper
+}
+
+void MFBilinearFormExtension::Mult(const Vector &x, Vector &y) const
 {
    Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
    const int iSz = integrators.Size();
@@ -243,53 +444,144 @@ void PABilinearFormExtension::MultTranspose(const Vector &x, Vector &y) const
       localY = 0.0;
       for (int i = 0; i < iSz; ++i)
       {
-         integrators[i]->AddMultTransposePA(localX, localY);
+         integrators[i]->AddMultMF(localX, localY);
       }
       elem_restrict->MultTranspose(localY, y);
    }
    else
    {
-      y.UseDevice(true);
+      y.UseDevice(true); // typically this is a large vector, so store on device
       y = 0.0;
       for (int i = 0; i < iSz; ++i)
       {
-         integrators[i]->AddMultTransposePA(x, y);
+         integrators[i]->AddMultMF(x, y);
       }
    }
+}
 
-   Array<BilinearFormIntegrator*> &intFaceIntegrators = *a->GetFBFI();
-   const int iFISz = intFaceIntegrators.Size();
-   if (int_face_restrict_lex && iFISz>0)
+void MFBilinearFormExtension::MultTranspose(const Vector &x, Vector &y) const
+{
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   const int iSz = integrators.Size();
+   if (elem_restrict)
    {
-      int_face_restrict_lex->Mult(x, faceIntX);
-      if (faceIntX.Size()>0)
+      elem_restrict->Mult(x, localX);
+      localY = 0.0;
+      for (int i = 0; i < iSz; ++i)
       {
-         faceIntY = 0.0;
-         for (int i = 0; i < iFISz; ++i)
-         {
-            intFaceIntegrators[i]->AddMultTransposePA(faceIntX, faceIntY);
-         }
-         int_face_restrict_lex->MultTranspose(faceIntY, y);
+         integrators[i]->AddMultTransposeMF(localX, localY);
       }
+      elem_restrict->MultTranspose(localY, y);
    }
+   else
+   {
+      y.UseDevice(true);
+      y = 0.0;
+      for (int i = 0; i < iSz; ++i)
+      {
+         integrators[i]->AddMultTransposeMF(x, y);
+      }
+   }
+}
 
-   Array<BilinearFormIntegrator*> &bdrFaceIntegrators = *a->GetBFBFI();
-   const int bFISz = bdrFaceIntegrators.Size();
-   if (bdr_face_restrict_lex && bFISz>0)
+#ifdef MFEM_USE_MPI
+PAOverlapRAPOperator::PAOverlapRAPOperator(
+   const PABilinearFormExtension &ext_,
+   const ConformingProlongationOperator &P_,
+   const ElementRestriction &R_)
+   : Operator(P_.Width()), ext(ext_), P(P_), R(R_),
+     xl(P_.Height()), yl(P_.Height())
+{
+   xl.UseDevice(true);
+   yl.UseDevice(true);
+
+   // Mark the scalar dofs with (vector) ldofs owned by other processors
+   const FiniteElementSpace &fes = *ext.trialFes;
+   const int ndofs = fes.GetNDofs();
+   Array<int> external(ndofs);
+   external = 0;
+   const Array<int> &ext_ldofs = P.GetExternalLDofs();
+   for (int i = 0; i < ext_ldofs.Size(); i++)
    {
-      bdr_face_restrict_lex->Mult(x, faceBdrX);
-      if (faceBdrX.Size()>0)
+      external[fes.VDofToDof(ext_ldofs[i])] = 1;
+   }
+   for (int d = 0; d < ndofs; d++)
+   {
+      (external[d] ? dofs_ext : dofs_int).Append(d);
+   }
+
+   // Boundary elements have external dofs, the interior elements are split in
+   // two halves
+   Array<int> dofs, interior;
+   for (int e = 0; e < fes.GetNE(); e++)
+   {
+      fes.GetElementDofs(e, dofs);
+      bool bdr = false;
+      for (int j = 0; j < dofs.Size() && !bdr; j++)
       {
-         faceBdrY = 0.0;
-         for (int i = 0; i < bFISz; ++i)
-         {
-            bdrFaceIntegrators[i]->AddMultTransposePA(faceBdrX, faceBdrY);
-         }
-         bdr_face_restrict_lex->MultTranspose(faceBdrY, y);
+         bdr = external[dofs[j] >= 0 ? dofs[j] : -1-dofs[j]];
       }
+      (bdr ? elems_bdr : interior).Append(e);
+   }
+   const int n1 = interior.Size()/2;
+   elems_int1.Append(interior.GetData(), n1);
+   elems_int2.Append(interior.GetData() + n1, interior.Size() - n1);
+}
+
+bool PAOverlapRAPOperator::Supports(const PABilinearFormExtension &ext,
+                                    const Operator *P)
+{
+   if (ext.a->GetAssemblyLevel() != AssemblyLevel::PARTIAL ||
+       !dynamic_cast<const ConformingProlongationOperator*>(P) ||
+       !dynamic_cast<const ElementRestriction*>(ext.elem_restrict) ||
+       ext.a->GetFBFI()->Size() > 0 || ext.a->GetBFBFI()->Size() > 0)
+   {
+      return false;
+   }
+   const Array<BilinearFormIntegrator*> &integrators = *ext.a->GetDBFI();
+   for (int i = 0; i < integrators.Size(); ++i)
+   {
+      if (!integrators[i]->SupportsPAElementSubsets()) { return false; }
+   }
+   return true;
+}
+
+void PAOverlapRAPOperator::AddMultElements(const Array<int> &elems,
+                                           const Vector &x) const
+{
+   const Array<BilinearFormIntegrator*> &integrators = *ext.a->GetDBFI();
+   R.MultElements(elems, x, ext.localX);
+   for (int i = 0; i < integrators.Size(); ++i)
+   {
+      integrators[i]->AddMultPAElements(elems, ext.localX, ext.localY);
    }
 }
 
+void PAOverlapRAPOperator::Mult(const Vector &x, Vector &y) const
+{
+   ext.localY = 0.0;
+   P.BcastBegin(x, xl);
+   AddMultElements(elems_int1, xl);
+   P.BcastEnd(xl);
+
+   AddMultElements(elems_bdr, xl);
+   R.MultTransposeDofs(dofs_ext, ext.localY, yl);
+   P.ReduceBegin(yl);
+
+   AddMultElements(elems_int2, xl);
+   R.MultTransposeDofs(dofs_int, ext.localY, yl);
+   P.ReduceEnd(yl, y);
+}
+
+void PAOverlapRAPOperator::MultTranspose(const Vector &x, Vector &y) const
+{
+   P.Mult(x, xl);
+   ext.MultTranspose(xl, yl);
+   P.MultTranspose(yl, y);
+}
+#endif
+
+
 // Data and methods for element-assembled bilinear forms
 EABilinearFormExtension::EABilinearFormExtension(BilinearForm *form)
    : PABilinearFormExtension(form)
@@ -301,7 +593,7 @@ void EABilinearFormExtension::Assemble()
    SetupRestrictionOperators(L2FaceValues::SingleValued);
 
    ne = trialFes->GetMesh()->GetNE();
-   elemDofs = trialFes->GetFE(0)->GetDof();
+   elemDofs = trialFes->GetFE(0)->GetDof() * trialFes->GetVDim();
 
    ea_data.SetSize(ne*elemDofs*elemDofs, Device::GetMemoryType());
    ea_data.UseDevice(true);
@@ -595,6 +887,265 @@ void EABilinearFormExtension::MultTranspose(const Vector &x, Vector &y) const
    }
 }
 
+// Data and methods for fully-assembled bilinear forms
+FABilinearFormExtension::FABilinearFormExtension(BilinearForm *form)
+   : EABilinearFormExtension(form)
+{
+}
+
+void FABilinearFormExtension::SetupSparsity()
+{
+   const FiniteElementSpace &fes = *a->FESpace();
+   MFEM_VERIFY(fes.GetVDim() == 1, "vdim > 1 is not supported");
+   MFEM_VERIFY(fes.Conforming(), "non-conforming spaces are not supported");
+
+   const int ndofs = fes.GetVSize();
+   const int nd = elemDofs;
+   const int nfd = faceDofs;
+   const int n_ea = ea_data.Size();
+   const int n_int = ea_data_int.Size();
+   const int n_ext = ea_data_ext.Size();
+
+   // Map from the E-vector entries to the signed L-vector dofs
+   Array<int> e_to_l;
+   const ElementRestriction *el_restr =
+      dynamic_cast<const ElementRestriction*>(elem_restrict);
+   if (el_restr)
+   {
+      const Array<int> &gather_map = el_restr->GetGatherMap();
+      e_to_l.SetSize(gather_map.Size());
+      const int *h_map = gather_map.HostRead();
+      for (int i = 0; i < e_to_l.Size(); i++) { e_to_l[i] = h_map[i]; }
+   }
+   else
+   {
+      MFEM_VERIFY(dynamic_cast<const L2ElementRestriction*>(elem_restrict),
+                  "unsupported element restriction");
+      e_to_l.SetSize(ne*nd);
+      for (int i = 0; i < e_to_l.Size(); i++) { e_to_l[i] = i; }
+   }
+
+   // The (row, column, entry) triplets of all element and face matrices
+   Array<int> rows, cols, entries;
+   rows.Reserve(n_ea + 2*n_int + ea_data_bdr.Size());
+   cols.Reserve(rows.Capacity());
+   entries.Reserve(rows.Capacity());
+   auto add = [&](int srow, int scol, int k)
+   {
+      const bool flip = (srow < 0) != (scol < 0);
+      rows.Append(srow >= 0 ? srow : -1-srow);
+      cols.Append(scol >= 0 ? scol : -1-scol);
+      entries.Append(flip ? -1-k : k);
+   };
+
+   // Element matrices: Y(j,e) += A(i,j,e) X(i,e)
+   for (int e = 0; e < ne; e++)
+   {
+      for (int j = 0; j < nd; j++)
+      {
+         for (int i = 0; i < nd; i++)
+         {
+            add(e_to_l[j+nd*e], e_to_l[i+nd*e], i+nd*(j+nd*e));
+         }
+      }
+   }
+
+   // Interior face matrices, see EABilinearFormExtension::Mult
+   if (n_int > 0)
+   {
+      const L2FaceRestriction *face_restr =
+         dynamic_cast<const L2FaceRestriction*>(int_face_restrict_lex);
+      MFEM_VERIFY(face_restr, "unsupported interior face restriction");
+      const int *idx1 = face_restr->GetScatterIndices(0).HostRead();
+      const int *idx2 = face_restr->GetScatterIndices(1).HostRead();
+      for (int f = 0; f < nf_int; f++)
+      {
+         for (int j = 0; j < nfd; j++)
+         {
+            for (int i = 0; i < nfd; i++)
+            {
+               const int i1 = idx1[i+nfd*f], i2 = idx2[i+nfd*f];
+               const int j1 = idx1[j+nfd*f], j2 = idx2[j+nfd*f];
+               const int k0 = i+nfd*(j+nfd*(0+2*f));
+               const int k1 = i+nfd*(j+nfd*(1+2*f));
+               add(j1, i1, n_ea + k0);
+               add(j2, i2, n_ea + k1);
+               add(j2, i1, n_ea + n_int + k0);
+               add(j1, i2, n_ea + n_int + k1);
+            }
+         }
+      }
+   }
+
+   // Boundary face matrices
+   if (ea_data_bdr.Size() > 0)
+   {
+      const L2FaceRestriction *face_restr =
+         dynamic_cast<const L2FaceRestriction*>(bdr_face_restrict_lex);
+      MFEM_VERIFY(face_restr, "unsupported boundary face restriction");
+      const int *idx = face_restr->GetScatterIndices(0).HostRead();
+      for (int f = 0; f < nf_bdr; f++)
+      {
+         for (int j = 0; j < nfd; j++)
+         {
+            for (int i = 0; i < nfd; i++)
+            {
+               add(idx[j+nfd*f], idx[i+nfd*f],
+                   n_ea + n_int + n_ext + i+nfd*(j+nfd*f));
+            }
+         }
+      }
+   }
+
+   // Sort the triplets by row and then by column
+   const int ntrip = rows.Size();
+   Array<int> row_offsets(ndofs+1), perm(ntrip);
+   row_offsets = 0;
+   for (int t = 0; t < ntrip; t++) { row_offsets[rows[t]+1]++; }
+   row_offsets.PartialSum();
+   {
+      Array<int> pos(ndofs);
+      for (int r = 0; r < ndofs; r++) { pos[r] = row_offsets[r]; }
+      for (int t = 0; t < ntrip; t++) { perm[pos[rows[t]]++] = t; }
+   }
+   for (int r = 0; r < ndofs; r++)
+   {
+      std::sort(perm.GetData() + row_offsets[r],
+                perm.GetData() + row_offsets[r+1],
+                [&](int t1, int t2) { return cols[t1] < cols[t2]; });
+   }
+
+   // Build the CSR pattern and the map from the nonzeros to the triplets
+   int *I = Memory<int>(ndofs+1);
+   int nnz = 0;
+   for (int r = 0; r < ndofs; r++)
+   {
+      I[r] = nnz;
+      for (int t = row_offsets[r]; t < row_offsets[r+1]; t++)
+      {
+         if (t == row_offsets[r] || cols[perm[t]] != cols[perm[t-1]]) { nnz++; }
+      }
+   }
+   I[ndofs] = nnz;
+   int *J = Memory<int>(nnz);
+   nnz_offsets.SetSize(nnz+1);
+   nnz_map.SetSize(ntrip);
+   nnz = 0;
+   for (int r = 0; r < ndofs; r++)
+   {
+      for (int t = row_offsets[r]; t < row_offsets[r+1]; t++)
+      {
+         if (t == row_offsets[r] || cols[perm[t]] != cols[perm[t-1]])
+         {
+            J[nnz] = cols[perm[t]];
+            nnz_offsets[nnz++] = t;
+         }
+         nnz_map[t] = entries[perm[t]];
+      }
+   }
+   nnz_offsets[nnz] = ntrip;
+
+   delete a->mat;
+   double *data = Memory<double>(nnz);
+   a->mat = new SparseMatrix(I, J, data, ndofs, ndofs, true, true, true);
+}
+
+void FABilinearFormExtension::Assemble()
+{
+   MFEM_VERIFY(!a->static_cond && !a->hybridization, "static condensation "
+               "and hybridization are not supported by this assembly level");
+
+   EABilinearFormExtension::Assemble();
+
+   if (a->mat == NULL || nnz_offsets.Size() == 0) { SetupSparsity(); }
+
+   // The previous elimination of essential dofs is no longer valid
+   delete a->mat_e;
+   a->mat_e = NULL;
+
+   // Sum the element and face matrix entries into the nonzeros
+   const int nnz = nnz_offsets.Size() - 1;
+   const int n_ea = ea_data.Size();
+   const int n_int = ea_data_int.Size();
+   const int n_ext = ea_data_ext.Size();
+   const int n_bdr = ea_data_bdr.Size();
+   auto d_offsets = nnz_offsets.Read();
+   auto d_map = nnz_map.Read();
+   auto d_ea = ea_data.Read();
+   auto d_int = n_int > 0 ? ea_data_int.Read() : nullptr;
+   auto d_ext = n_ext > 0 ? ea_data_ext.Read() : nullptr;
+   auto d_bdr = n_bdr > 0 ? ea_data_bdr.Read() : nullptr;
+   auto d_A = a->mat->WriteData();
+   MFEM_FORALL(k, nnz,
+   {
+      double val = 0.0;
+      for (int t = d_offsets[k]; t < d_offsets[k+1]; t++)
+      {
+         const int s = d_map[t];
+         int m = s >= 0 ? s : -1-s;
+         double v;
+         if (m < n_ea) { v = d_ea[m]; }
+         else if ((m -= n_ea) < n_int) { v = d_int[m]; }
+         else if ((m -= n_int) < n_ext) { v = d_ext[m]; }
+         else { v = d_bdr[m - n_ext]; }
+         val += s >= 0 ? v : -v;
+      }
+      d_A[k] = val;
+   });
+}
+
+void FABilinearFormExtension::AssembleDiagonal(Vector &diag) const
+{
+   a->mat->GetDiag(diag);
+}
+
+void FABilinearFormExtension::FormSystemMatrix(const Array<int> &ess_tdof_list,
+                                               OperatorHandle &A)
+{
+   if (!a->mat_e)
+   {
+      // The elimination is performed on the host
+      a->mat->HostReadWriteI();
+      a->mat->HostReadWriteJ();
+      a->mat->HostReadWriteData();
+      a->EliminateVDofs(ess_tdof_list, a->diag_policy);
+      a->mat_e->Finalize(0);
+   }
+   A.Reset(a->mat, false);
+}
+
+void FABilinearFormExtension::FormLinearSystem(const Array<int> &ess_tdof_list,
+                                               Vector &x, Vector &b,
+                                               OperatorHandle &A,
+                                               Vector &X, Vector &B,
+                                               int copy_interior)
+{
+   FormSystemMatrix(ess_tdof_list, A);
+
+   // A, X and B point to the same data as mat, x and b
+   a->EliminateVDofsInRHS(ess_tdof_list, x, b);
+   X.NewMemoryAndSize(x.GetMemory(), x.Size(), false);
+   B.NewMemoryAndSize(b.GetMemory(), b.Size(), false);
+   if (!copy_interior) { X.SetSubVectorComplement(ess_tdof_list, 0.0); }
+}
+
+void FABilinearFormExtension::Mult(const Vector &x, Vector &y) const
+{
+   a->mat->Mult(x, y);
+}
+
+void FABilinearFormExtension::MultTranspose(const Vector &x, Vector &y) const
+{
+   a->mat->MultTranspose(x, y);
+}
+
+void FABilinearFormExtension::Update()
+{
+   EABilinearFormExtension::Update();
+   nnz_offsets.DeleteAll();
+   nnz_map.DeleteAll();
+}
+
 MixedBilinearFormExtension::MixedBilinearFormExtension(MixedBilinearForm *form)
    : Operator(form->Height(), form->Width()), a(form)
 {
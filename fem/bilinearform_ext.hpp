@@ -21,6 +21,9 @@ namespace mfem
 
 class BilinearForm;
 class MixedBilinearForm;
+#ifdef MFEM_USE_MPI
+class ConformingProlongationOperator;
+#endif
 
 /// Class extending the BilinearForm class to support different AssemblyLevels.
 /**  FA - Full Assembly
@@ -62,27 +65,6 @@ public:
    virtual void Update() = 0;
 };
 
-/** @brief Data and methods for fully-assembled bilinear forms.
-    Not yet implemented!  Use the BilinearForm Class instead. */
-class FABilinearFormExtension : public BilinearFormExtension
-{
-public:
-   FABilinearFormExtension(BilinearForm *form)
-      : BilinearFormExtension(form) { }
-
-   /// TODO
-   void Assemble() {}
-   void FormSystemMatrix(const Array<int> &ess_tdof_list, OperatorHandle &A) {}
-   void FormLinearSystem(const Array<int> &ess_tdof_list,
-                         Vector &x, Vector &b,
-                         OperatorHandle &A, Vector &X, Vector &B,
-                         int copy_interior = 0) {}
-   void Mult(const Vector &x, Vector &y) const {}
-   void MultTranspose(const Vector &x, Vector &y) const {}
-   void Update() {}
-   ~FABilinearFormExtension() {}
-};
-
 /// Data and methods for partially-assembled bilinear forms
 class PABilinearFormExtension : public BilinearFormExtension
 {
@@ -91,12 +73,30 @@ protected:
    mutable Vector localX, localY;
    mutable Vector faceIntX, faceIntY;
    mutable Vector faceBdrX, faceBdrY;
+   mutable Vector faceIntDX, faceIntDY;
+   mutable Vector faceBdrDX, faceBdrDY;
    const Operator *elem_restrict; // Not owned
    const Operator *int_face_restrict_lex; // Not owned
    const Operator *bdr_face_restrict_lex; // Not owned
+   /// Normal derivative face restrictions, used only by face integrators
+   /// that require them, see L2NormalDerivativeFaceRestriction.
+   Operator *int_face_dxdn; // Owned
+   Operator *bdr_face_dxdn; // Owned
+   /// Overlap the communication in the parallel P^t A P, see SetupRAP().
+   bool comm_overlap;
+
+#ifdef MFEM_USE_MPI
+   friend class PAOverlapRAPOperator;
+#endif
 
 public:
    PABilinearFormExtension(BilinearForm*);
+   ~PABilinearFormExtension();
+
+   /** @brief Enable or disable the overlap of the exchange of the shared dofs
+       with the element computations in the parallel system operator, see
+       PAOverlapRAPOperator. Disabled by default. */
+   void SetCommOverlap(bool enable) { comm_overlap = enable; }
 
    void Assemble();
    void AssembleDiagonal(Vector &diag) const;
@@ -111,7 +111,69 @@ public:
 
 protected:
    void SetupRestrictionOperators(const L2FaceValues m);
+
+   /** @brief Return a PAOverlapRAPOperator for the parallel P^t A P, when
+       supported, and the default RAP operator otherwise. */
+   virtual Operator *SetupRAP(const Operator *Pi, const Operator *Po);
+
+   /** Add the action (or its transpose) of the face integrators @a integs to
+       @a y, using the face restriction @a face_restrict and, if not NULL, the
+       normal derivative restriction @a face_dxdn. */
+   void AddMultFaces(const Array<BilinearFormIntegrator*> &integs,
+                     const Operator *face_restrict, const Operator *face_dxdn,
+                     Vector &faceX, Vector &faceY,
+                     Vector &faceDX, Vector &faceDY,
+                     const Vector &x, Vector &y, bool transpose) const;
+};
+
+#ifdef MFEM_USE_MPI
+/// The parallel operator P^t A P of a partially assembled ParBilinearForm
+/** The elements of each processor are split in boundary elements, which have
+    dofs owned by other processors (see
+    ConformingProlongationOperator::GetExternalLDofs()), and two sets of
+    interior elements. The action of the operator overlaps the exchange of the
+    shared dofs with the element computations:
+    -# start the broadcast of P, compute the first interior set;
+    -# finish the broadcast, compute the boundary elements and assemble the
+       external dofs, start the reduction of P^t;
+    -# compute the second interior set, assemble the other dofs and finish the
+       reduction.
+
+    Used by PABilinearFormExtension when P is a ConformingProlongationOperator
+    (ParFiniteElementSpace on two or more processors), the form has no face
+    integrators and all domain integrators support
+    BilinearFormIntegrator::AddMultPAElements(). The transpose action is not
+    overlapped. */
+class PAOverlapRAPOperator : public Operator
+{
+protected:
+   const PABilinearFormExtension &ext;
+   const ConformingProlongationOperator &P;
+   const ElementRestriction &R;
+   /// First interior, boundary and second interior elements.
+   Array<int> elems_int1, elems_bdr, elems_int2;
+   /// Scalar dofs which are external (owned by other processors) or not.
+   Array<int> dofs_ext, dofs_int;
+   mutable Vector xl, yl;
+
+   void AddMultElements(const Array<int> &elems, const Vector &x) const;
+
+public:
+   PAOverlapRAPOperator(const PABilinearFormExtension &ext,
+                        const ConformingProlongationOperator &P,
+                        const ElementRestriction &R);
+
+   /// Return true if the overlapped operator can be used for @a ext and @a P.
+   static bool Supports(const PABilinearFormExtension &ext, const Operator *P);
+
+   virtual MemoryClass GetMemoryClass() const
+   { return Device::GetDeviceMemoryClass(); }
+
+   virtual void Mult(const Vector &x, Vector &y) const;
+
+   virtual void MultTranspose(const Vector &x, Vector &y) const;
 };
+#endif
 
 /// Data and methods for element-assembled bilinear forms
 class EABilinearFormExtension : public PABilinearFormExtension
@@ -132,24 +194,70 @@ public:
    void MultTranspose(const Vector &x, Vector &y) const;
 };
 
-/// Data and methods for matrix-free bilinear forms NOT YET IMPLEMENTED.
+/// Data and methods for fully-assembled bilinear forms
+/** The element and face matrices are computed as in EABilinearFormExtension
+    and then summed into the SparseMatrix of the BilinearForm with device
+    kernels. The CSR sparsity pattern, together with the list of element and
+    face matrix entries contributing to each nonzero, is computed only once
+    from the restriction operators, so that re-assembly (e.g. with a
+    time-dependent coefficient) only refreshes the values of the matrix.
+
+    Only conforming spaces with vdim = 1 are supported. The essential boundary
+    conditions are eliminated from the SparseMatrix as in the BilinearForm. */
+class FABilinearFormExtension : public EABilinearFormExtension
+{
+protected:
+   /// Offsets into #nnz_map for each nonzero entry of the matrix.
+   Array<int> nnz_offsets;
+   /** @brief The entries of the element and face matrices that are added to
+       each nonzero, as indices into the concatenation of ea_data, ea_data_int,
+       ea_data_ext and ea_data_bdr. A negative entry, -1-k, denotes the entry k
+       with a sign flip. */
+   Array<int> nnz_map;
+
+   /// Compute the sparsity pattern of the matrix and #nnz_offsets, #nnz_map.
+   void SetupSparsity();
+
+public:
+   FABilinearFormExtension(BilinearForm *form);
+
+   void Assemble();
+   void AssembleDiagonal(Vector &diag) const;
+   void FormSystemMatrix(const Array<int> &ess_tdof_list, OperatorHandle &A);
+   void FormLinearSystem(const Array<int> &ess_tdof_list,
+                         Vector &x, Vector &b,
+                         OperatorHandle &A, Vector &X, Vector &B,
+                         int copy_interior = 0);
+   void Mult(const Vector &x, Vector &y) const;
+   void MultTranspose(const Vector &x, Vector &y) const;
+   void Update();
+};
+
+/// Data and methods for matrix-free bilinear forms
+/** The integrators recompute all quadrature point data (geometric factors and
+    the quadrature point contributions of the coefficients) inside the action,
+    so that only the mesh nodes and, for non-constant coefficients, their values
+    at the quadrature points are stored. Face integrators are not supported. */
 class MFBilinearFormExtension : public BilinearFormExtension
 {
+protected:
+   const FiniteElementSpace *trialFes, *testFes; // Not owned
+   mutable Vector localX, localY;
+   const Operator *elem_restrict; // Not owned
+
 public:
-   MFBilinearFormExtension(BilinearForm *form)
-      : BilinearFormExtension(form) { }
+   MFBilinearFormExtension(BilinearForm *form);
 
-   /// TODO
-   void Assemble() {}
-   void FormSystemMatrix(const Array<int> &ess_tdof_list, OperatorHandle &A) {}
+   void Assemble();
+   void AssembleDiagonal(Vector &diag) const;
+   void FormSystemMatrix(const Array<int> &ess_tdof_list, OperatorHandle &A);
    void FormLinearSystem(const Array<int> &ess_tdof_list,
                          Vector &x, Vector &b,
                          OperatorHandle &A, Vector &X, Vector &B,
-                         int copy_interior = 0) {}
-   void Mult(const Vector &x, Vector &y) const {}
-   void MultTranspose(const Vector &x, Vector &y) const {}
-   void Update() {}
-   ~MFBilinearFormExtension() {}
+                         int copy_interior = 0);
+   void Mult(const Vector &x, Vector &y) const;
+   void MultTranspose(const Vector &x, Vector &y) const;
+   void Update();
 };
 
 /// Class extending the MixedBilinearForm class to support different AssemblyLevels.
@@ -12,6 +12,7 @@
 // Implementation of Bilinear Form Integrators
 
 #include "fem.hpp"
+#include "../general/forall.hpp"
 #include <cmath>
 #include <algorithm>
 
@@ -93,6 +94,52 @@ void BilinearFormIntegrator::AddMultTransposePA(const Vector &, Vector &) const
                "   is not implemented for this class.");
 }
 
+void BilinearFormIntegrator::AddMultPAElements(const Array<int> &,
+                                               const Vector &, Vector &) const
+{
+   mfem_error ("BilinearFormIntegrator::AddMultPAElements(...)\n"
+               "   is not implemented for this class.");
+}
+
+void BilinearFormIntegrator::AddMultPAFaceNormalDerivatives(
+   const Vector &, const Vector &, Vector &, Vector &) const
+{
+   mfem_error ("BilinearFormIntegrator::AddMultPAFaceNormalDerivatives(...)\n"
+               "   is not implemented for this class.");
+}
+
+void BilinearFormIntegrator::AddMultTransposePAFaceNormalDerivatives(
+   const Vector &, const Vector &, Vector &, Vector &) const
+{
+   mfem_error ("BilinearFormIntegrator::"
+               "AddMultTransposePAFaceNormalDerivatives(...)\n"
+               "   is not implemented for this class.");
+}
+
+void BilinearFormIntegrator::AssembleMF(const FiniteElementSpace &fes)
+{
+   mfem_error ("BilinearFormIntegrator::AssembleMF(...)\n"
+               "   is not implemented for this class.");
+}
+
+void BilinearFormIntegrator::AssembleDiagonalMF(Vector &)
+{
+   mfem_error ("BilinearFormIntegrator::AssembleDiagonalMF(...)\n"
+               "   is not implemented for this class.");
+}
+
+void BilinearFormIntegrator::AddMultMF(const Vector &, Vector &) const
+{
+   mfem_error ("BilinearFormIntegrator::AddMultMF(...)\n"
+               "   is not implemented for this class.");
+}
+
+void BilinearFormIntegrator::AddMultTransposeMF(const Vector &, Vector &) const
+{
+   mfem_error ("BilinearFormIntegrator::AddMultTransposeMF(...)\n"
+               "   is not implemented for this class.");
+}
+
 void BilinearFormIntegrator::AssembleElementMatrix (
    const FiniteElement &el, ElementTransformation &Trans,
    DenseMatrix &elmat )
@@ -3545,4 +3592,127 @@ VectorInnerProductInterpolator::AssembleElementMatrix2(
    ran_fe.Project(dom_shape_coeff, Trans, elmat_as_vec);
 }
 
+
+void PAGeometryGroup::MakeGroups(const FiniteElementSpace &fes,
+                                 Array<PAGeometryGroup*> &groups)
+{
+   Mesh *mesh = fes.GetMesh();
+   PAGeometryGroup *geom_group[Geometry::NumGeom] = { NULL };
+   for (int e = 0; e < fes.GetNE(); e++)
+   {
+      const Geometry::Type geom = mesh->GetElementBaseGeometry(e);
+      if (geom_group[geom] == NULL)
+      {
+         geom_group[geom] = new PAGeometryGroup;
+         groups.Append(geom_group[geom]);
+      }
+      geom_group[geom]->elements.Append(e);
+   }
+}
+
+void PAGeometryGroup::DeleteGroups(Array<PAGeometryGroup*> &groups)
+{
+   for (int i = 0; i < groups.Size(); i++) { delete groups[i]; }
+   groups.SetSize(0);
+}
+
+int PAGeometryGroup::MaxDofs(const Array<PAGeometryGroup*> &groups)
+{
+   int max_dofs = 0;
+   for (int i = 0; i < groups.Size(); i++)
+   {
+      const int nd = groups[i]->maps->ndof;
+      if (nd > max_dofs) { max_dofs = nd; }
+   }
+   return max_dofs;
+}
+
+const Vector &PAGeometryGroup::GetJacobians(Mesh &mesh,
+                                            const IntegrationRule &ir,
+                                            Vector &J) const
+{
+   if (elements.Size() == mesh.GetNE())
+   {
+      return mesh.GetGeometricFactors(ir, GeometricFactors::JACOBIANS)->J;
+   }
+
+   mesh.EnsureNodes();
+   const GridFunction &nodes = *mesh.GetNodes();
+   const FiniteElementSpace &nfes = *nodes.FESpace();
+   const Operator *restr =
+      nfes.GetElementRestriction(ElementDofOrdering::NATIVE);
+   Vector enodes(restr->Height(), Device::GetDeviceMemoryType());
+   restr->Mult(nodes, enodes);
+
+   // The E-vector of the nodes has the layout (NDE, SDIM, NE), where NDE is
+   // the largest number of nodal dofs of the elements
+   const DofToQuad &nmaps =
+      nfes.GetFE(elements[0])->GetDofToQuad(ir, DofToQuad::FULL);
+   const int NE = mesh.GetNE();
+   const int NG = elements.Size();
+   const int NQ = ir.GetNPoints();
+   const int ND = nmaps.ndof;
+   const int DIM = mesh.Dimension();
+   const int SDIM = nfes.GetVDim();
+   const int NDE = enodes.Size() / (SDIM * NE);
+   J.SetSize(NQ * SDIM * DIM * NG, Device::GetDeviceMemoryType());
+   auto E = elements.Read();
+   auto G = Reshape(nmaps.G.Read(), NQ, DIM, ND);
+   auto X = Reshape(enodes.Read(), NDE, SDIM, NE);
+   auto Jq = Reshape(J.Write(), NQ, SDIM, DIM, NG);
+   MFEM_FORALL(i, NQ*NG,
+   {
+      const int q = i % NQ;
+      const int k = i / NQ;
+      const int e = E[k];
+      for (int c = 0; c < SDIM; ++c)
+      {
+         for (int d = 0; d < DIM; ++d)
+         {
+            double s = 0.0;
+            for (int j = 0; j < ND; ++j) { s += G(q,d,j) * X(j,c,e); }
+            Jq(q,c,d,k) = s;
+         }
+      }
+   });
+   return J;
+}
+
+void PAGeometryGroup::EvalCoefficient(Coefficient *Q, Mesh &mesh,
+                                      const IntegrationRule &ir,
+                                      Vector &qcoeff) const
+{
+   if (Q == NULL)
+   {
+      qcoeff.SetSize(1);
+      qcoeff(0) = 1.0;
+   }
+   else if (ConstantCoefficient *cQ = dynamic_cast<ConstantCoefficient*>(Q))
+   {
+      qcoeff.SetSize(1);
+      qcoeff(0) = cQ->constant;
+   }
+   else if (elements.Size() == mesh.GetNE())
+   {
+      Q->EvalQuadrature(qcoeff, mesh, ir);
+   }
+   else
+   {
+      const int NQ = ir.GetNPoints();
+      qcoeff.SetSize(NQ * elements.Size());
+      auto C = Reshape(qcoeff.HostWrite(), NQ, elements.Size());
+      for (int k = 0; k < elements.Size(); k++)
+      {
+         ElementTransformation &T =
+            *mesh.GetElementTransformation(elements[k]);
+         for (int q = 0; q < NQ; q++)
+         {
+            const IntegrationPoint &ip = ir.IntPoint(q);
+            T.SetIntPoint(&ip);
+            C(q,k) = Q->Eval(T, ip);
+         }
+      }
+   }
+}
+
 }
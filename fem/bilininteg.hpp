@@ -20,6 +20,52 @@
 namespace mfem
 {
 
+/** @brief Partial assembly data for the elements of one Geometry::Type.
+
+    Used by the integrators that support partial assembly on meshes with
+    simplicial or mixed element types, where the kernels use the
+    DofToQuad::FULL maps of each element type. The E-vectors of such meshes
+    use the native dof ordering and are padded to the largest number of
+    element dofs, see ElementRestriction. */
+class PAGeometryGroup
+{
+public:
+   Array<int> elements;       ///< Mesh indices of the elements in the group
+   const DofToQuad *maps;     ///< Not owned
+   Vector pa_data;            ///< Quadrature point data of the group
+   mutable Vector qvec;       ///< Work vector at the quadrature points
+
+   PAGeometryGroup() : maps(NULL) { }
+
+   /// Append to @a groups one new group per element geometry of @a fes.
+   static void MakeGroups(const FiniteElementSpace &fes,
+                          Array<PAGeometryGroup*> &groups);
+
+   /// Delete the entries of @a groups and set its size to zero.
+   static void DeleteGroups(Array<PAGeometryGroup*> &groups);
+
+   /// Return the largest number of element dofs in @a groups.
+   static int MaxDofs(const Array<PAGeometryGroup*> &groups);
+
+   /** @brief Return the Jacobians of the elements of the group at the points
+       of @a ir, with the layout (NQ, SDIM, DIM, NG) of GeometricFactors::J. */
+   /** If the group has all elements of @a mesh, these are the GeometricFactors
+       of the mesh. Otherwise they are computed on the device from the
+       E-vector of the mesh nodes and stored in @a J. */
+   const Vector &GetJacobians(Mesh &mesh, const IntegrationRule &ir,
+                              Vector &J) const;
+
+   /** @brief Evaluate @a Q at the points of @a ir in the elements of the
+       group, with the layout (NQ, NG), or as a single value if @a Q is NULL
+       or a ConstantCoefficient. */
+   /** If the group has all elements of @a mesh, Coefficient::EvalQuadrature()
+       is used. Otherwise the IntegrationRule is not valid for the other
+       elements, and @a Q is evaluated point by point. */
+   void EvalCoefficient(Coefficient *Q, Mesh &mesh, const IntegrationRule &ir,
+                        Vector &qcoeff) const;
+};
+
+
 /// Abstract base class BilinearFormIntegrator
 class BilinearFormIntegrator : public NonlinearFormIntegrator
 {
@@ -78,6 +124,68 @@ public:
        called. */
    virtual void AddMultTransposePA(const Vector &x, Vector &y) const;
 
+   /** @brief Return true if AddMultPAElements() is implemented for the current
+       partial assembly data. */
+   virtual bool SupportsPAElementSubsets() const { return false; }
+
+   /// Method for partially assembled action on a subset of the elements.
+   /** Same as AddMultPA(), restricted to the elements listed in @a elems: only
+       the entries of the E-vector @a y of these elements are updated. Used to
+       overlap the element computations with the exchange of the shared dofs
+       in parallel, see PABilinearFormExtension. */
+   virtual void AddMultPAElements(const Array<int> &elems, const Vector &x,
+                                  Vector &y) const;
+
+   /** @brief Return true if the partially assembled face action needs the
+       normal derivatives of the trial function on the faces, see
+       AddMultPAFaceNormalDerivatives(). */
+   virtual bool RequiresFaceNormalDerivatives() const { return false; }
+
+   /// Method for partially assembled face action using normal derivatives.
+   /** Used instead of AddMultPA() for face integrators for which
+       RequiresFaceNormalDerivatives() returns true. The face values @a x and
+       @a y have the layout of L2FaceRestriction (DoubleValued), while @a dxdn
+       and @a dydn hold the normal derivatives at the face dofs, see
+       L2NormalDerivativeFaceRestriction. The results are added to @a y and
+       @a dydn. */
+   virtual void AddMultPAFaceNormalDerivatives(const Vector &x,
+                                               const Vector &dxdn,
+                                               Vector &y, Vector &dydn) const;
+
+   /// Transposed version of AddMultPAFaceNormalDerivatives().
+   virtual void AddMultTransposePAFaceNormalDerivatives(const Vector &x,
+                                                        const Vector &dxdn,
+                                                        Vector &y,
+                                                        Vector &dydn) const;
+
+   /// Method defining matrix-free assembly.
+   /** The data needed for the matrix-free action is stored internally so that
+       it can be used later in the methods AddMultMF() and AddMultTransposeMF().
+       In contrast to AssemblePA(), the quadrature point data is not stored but
+       recomputed from the mesh nodes inside the action. */
+   virtual void AssembleMF(const FiniteElementSpace &fes);
+
+   /// Assemble diagonal and add it to Vector @a diag.
+   virtual void AssembleDiagonalMF(Vector &diag);
+
+   /// Method for matrix-free action.
+   /** Perform the action of integrator on the input @a x and add the result to
+       the output @a y. Both @a x and @a y are E-vectors, i.e. they represent
+       the element-wise discontinuous version of the FE space.
+
+       This method can be called only after the method AssembleMF() has been
+       called. */
+   virtual void AddMultMF(const Vector &x, Vector &y) const;
+
+   /// Method for matrix-free transposed action.
+   /** Perform the transpose action of integrator on the input @a x and add the
+       result to the output @a y. Both @a x and @a y are E-vectors, i.e. they
+       represent the element-wise discontinuous version of the FE space.
+
+       This method can be called only after the method AssembleMF() has been
+       called. */
+   virtual void AddMultTransposeMF(const Vector &x, Vector &y) const;
+
    /// Method defining element assembly.
    /** The result of the element assembly is added and stored in the @a emat
        Vector. */
@@ -94,6 +202,13 @@ public:
    virtual void AssembleEABoundaryFaces(const FiniteElementSpace &fes,
                                         Vector &ea_data_bdr);
 
+   /// Return true if AssembleEA() is implemented.
+   virtual bool SupportsEA() const { return false; }
+
+   /** @brief Return true if AssembleEAInteriorFaces() and
+       AssembleEABoundaryFaces() are implemented. */
+   virtual bool SupportsEAFaces() const { return false; }
+
    /// Given a particular Finite Element computes the element matrix elmat.
    virtual void AssembleElementMatrix(const FiniteElement &el,
                                       ElementTransformation &Trans,
@@ -264,6 +379,9 @@ public:
    virtual void AssembleEABoundaryFaces(const FiniteElementSpace &fes,
                                         Vector &ea_data_bdr);
 
+   virtual bool SupportsEA() const { return bfi->SupportsEA(); }
+   virtual bool SupportsEAFaces() const { return bfi->SupportsEAFaces(); }
+
    virtual ~TransposeIntegrator() { if (own_bfi) { delete bfi; } }
 };
 
@@ -1835,6 +1953,15 @@ private:
    const GeometricFactors *geom;  ///< Not owned
    int dim, ne, dofs1D, quad1D;
    Vector pa_data;
+   /// False if pa_data stores full (non-symmetric) matrices, see #MQ.
+   bool symmetric;
+   /// PA data on simplicial and mixed meshes, one entry per geometry. Owned.
+   Array<PAGeometryGroup*> pa_groups;
+
+   // MF extension
+   BatchedGeometricFactors *mf_geom; ///< Owned
+   Vector mf_coeff;
+   mutable Vector mf_J, mf_data;
 
 #ifdef MFEM_USE_CEED
    // CEED extension
@@ -1847,8 +1974,10 @@ public:
    {
       Q = NULL;
       MQ = NULL;
+      symmetric = true;
       maps = NULL;
       geom = NULL;
+      mf_geom = NULL;
 #ifdef MFEM_USE_CEED
       ceedDataPtr = NULL;
 #endif
@@ -1859,8 +1988,10 @@ public:
       : Q(&q)
    {
       MQ = NULL;
+      symmetric = true;
       maps = NULL;
       geom = NULL;
+      mf_geom = NULL;
 #ifdef MFEM_USE_CEED
       ceedDataPtr = NULL;
 #endif
@@ -1871,8 +2002,10 @@ public:
       : MQ(&q)
    {
       Q = NULL;
+      symmetric = true;
       maps = NULL;
       geom = NULL;
+      mf_geom = NULL;
 #ifdef MFEM_USE_CEED
       ceedDataPtr = NULL;
 #endif
@@ -1880,6 +2013,8 @@ public:
 
    virtual ~DiffusionIntegrator()
    {
+      delete mf_geom;
+      PAGeometryGroup::DeleteGroups(pa_groups);
 #ifdef MFEM_USE_CEED
       delete ceedDataPtr;
 #endif
@@ -1917,14 +2052,37 @@ public:
 
    virtual void AssembleEA(const FiniteElementSpace &fes, Vector &emat);
 
+   virtual bool SupportsEA() const { return true; }
+
    virtual void AssembleDiagonalPA(Vector &diag);
 
    virtual void AddMultPA(const Vector&, Vector&) const;
 
+   virtual bool SupportsPAElementSubsets() const;
+
+   virtual void AddMultPAElements(const Array<int> &elems, const Vector &x,
+                                  Vector &y) const;
+
+   virtual void AssembleMF(const FiniteElementSpace &fes);
+
+   virtual void AssembleDiagonalMF(Vector &diag);
+
+   virtual void AddMultMF(const Vector&, Vector&) const;
+
+   /// The operator is symmetric, so this is the same as AddMultMF().
+   virtual void AddMultTransposeMF(const Vector &x, Vector &y) const
+   { AddMultMF(x, y); }
+
    static const IntegrationRule &GetRule(const FiniteElement &trial_fe,
                                          const FiniteElement &test_fe);
 
    void SetupPA(const FiniteElementSpace &fes, const bool force = false);
+
+protected:
+   /// Partial assembly on simplicial and mixed meshes, see PAGeometryGroup.
+   void SetupPAGroups(const FiniteElementSpace &fes);
+   void AddMultPAGroups(const Vector &x, Vector &y) const;
+   void AssembleDiagonalPAGroups(Vector &diag) const;
 };
 
 /** Class for local mass matrix assembling a(u,v) := (Q u, v) */
@@ -1941,6 +2099,13 @@ protected:
    const DofToQuad *maps;         ///< Not owned
    const GeometricFactors *geom;  ///< Not owned
    int dim, ne, nq, dofs1D, quad1D;
+   /// PA data on simplicial and mixed meshes, one entry per geometry. Owned.
+   Array<PAGeometryGroup*> pa_groups;
+
+   // MF extension
+   BatchedGeometricFactors *mf_geom; ///< Owned
+   Vector mf_coeff;
+   mutable Vector mf_J, mf_data;
 
 #ifdef MFEM_USE_CEED
    // CEED extension
@@ -1954,6 +2119,7 @@ public:
       Q = NULL;
       maps = NULL;
       geom = NULL;
+      mf_geom = NULL;
 #ifdef MFEM_USE_CEED
       ceedDataPtr = NULL;
 #endif
@@ -1965,6 +2131,7 @@ public:
    {
       maps = NULL;
       geom = NULL;
+      mf_geom = NULL;
 #ifdef MFEM_USE_CEED
       ceedDataPtr = NULL;
 #endif
@@ -1972,6 +2139,8 @@ public:
 
    virtual ~MassIntegrator()
    {
+      delete mf_geom;
+      PAGeometryGroup::DeleteGroups(pa_groups);
 #ifdef MFEM_USE_CEED
       delete ceedDataPtr;
 #endif
@@ -1992,15 +2161,38 @@ public:
 
    virtual void AssembleEA(const FiniteElementSpace &fes, Vector &emat);
 
+   virtual bool SupportsEA() const { return true; }
+
    virtual void AssembleDiagonalPA(Vector &diag);
 
    virtual void AddMultPA(const Vector&, Vector&) const;
 
+   virtual bool SupportsPAElementSubsets() const;
+
+   virtual void AddMultPAElements(const Array<int> &elems, const Vector &x,
+                                  Vector &y) const;
+
+   virtual void AssembleMF(const FiniteElementSpace &fes);
+
+   virtual void AssembleDiagonalMF(Vector &diag);
+
+   virtual void AddMultMF(const Vector&, Vector&) const;
+
+   /// The operator is symmetric, so this is the same as AddMultMF().
+   virtual void AddMultTransposeMF(const Vector &x, Vector &y) const
+   { AddMultMF(x, y); }
+
    static const IntegrationRule &GetRule(const FiniteElement &trial_fe,
                                          const FiniteElement &test_fe,
                                          ElementTransformation &Trans);
 
    void SetupPA(const FiniteElementSpace &fes, const bool force = false);
+
+protected:
+   /// Partial assembly on simplicial and mixed meshes, see PAGeometryGroup.
+   void SetupPAGroups(const FiniteElementSpace &fes);
+   void AddMultPAGroups(const Vector &x, Vector &y) const;
+   void AssembleDiagonalPAGroups(Vector &diag) const;
 };
 
 /** Mass integrator (u, v) restricted to the boundary of a domain */
@@ -2029,6 +2221,11 @@ protected:
    const GeometricFactors *geom;  ///< Not owned
    int dim, ne, nq, dofs1D, quad1D;
 
+   // MF extension
+   BatchedGeometricFactors *mf_geom; ///< Owned
+   Vector mf_vel;
+   mutable Vector mf_J, mf_data;
+
 private:
 #ifndef MFEM_THREAD_SAFE
    DenseMatrix dshape, adjJ, Q_ir;
@@ -2037,7 +2234,10 @@ private:
 
 public:
    ConvectionIntegrator(VectorCoefficient &q, double a = 1.0)
-      : Q(&q) { alpha = a; }
+      : Q(&q) { alpha = a; mf_geom = NULL; }
+
+   virtual ~ConvectionIntegrator() { delete mf_geom; }
+
    virtual void AssembleElementMatrix(const FiniteElement &,
                                       ElementTransformation &,
                                       DenseMatrix &);
@@ -2048,8 +2248,18 @@ public:
 
    virtual void AssembleEA(const FiniteElementSpace &fes, Vector &emat);
 
+   virtual bool SupportsEA() const { return true; }
+
    virtual void AddMultPA(const Vector&, Vector&) const;
 
+   virtual void AddMultTransposePA(const Vector&, Vector&) const;
+
+   virtual void AssembleMF(const FiniteElementSpace&);
+
+   virtual void AddMultMF(const Vector&, Vector&) const;
+
+   virtual void AddMultTransposeMF(const Vector&, Vector&) const;
+
    static const IntegrationRule &GetRule(const FiniteElement &el,
                                          ElementTransformation &Trans);
 
@@ -2098,25 +2308,30 @@ protected:
    const DofToQuad *maps;         ///< Not owned
    const GeometricFactors *geom;  ///< Not owned
    int dim, ne, nq, dofs1D, quad1D;
+   /// Number of values per quadrature point in pa_data: 1 (scalar), dim
+   /// (diagonal) or dim*dim (matrix coefficient).
+   int pa_ncomp;
 
 public:
    /// Construct an integrator with coefficient 1.0
    VectorMassIntegrator()
-      : vdim(-1), Q_order(0), Q(NULL), VQ(NULL), MQ(NULL) { }
+      : vdim(-1), Q_order(0), Q(NULL), VQ(NULL), MQ(NULL), pa_ncomp(1) { }
    /** Construct an integrator with scalar coefficient q.  If possible, save
        memory by using a scalar integrator since the resulting matrix is block
        diagonal with the same diagonal block repeated. */
    VectorMassIntegrator(Coefficient &q, int qo = 0)
-      : vdim(-1), Q(&q) { VQ = NULL; MQ = NULL; Q_order = qo; }
+      : vdim(-1), Q(&q), pa_ncomp(1) { VQ = NULL; MQ = NULL; Q_order = qo; }
    VectorMassIntegrator(Coefficient &q, const IntegrationRule *ir)
-      : BilinearFormIntegrator(ir), vdim(-1), Q(&q)
+      : BilinearFormIntegrator(ir), vdim(-1), Q(&q), pa_ncomp(1)
    { VQ = NULL; MQ = NULL; Q_order = 0; }
    /// Construct an integrator with diagonal coefficient q
    VectorMassIntegrator(VectorCoefficient &q, int qo = 0)
-      : vdim(q.GetVDim()), VQ(&q) { Q = NULL; MQ = NULL; Q_order = qo; }
+      : vdim(q.GetVDim()), VQ(&q), pa_ncomp(1)
+   { Q = NULL; MQ = NULL; Q_order = qo; }
    /// Construct an integrator with matrix coefficient q
    VectorMassIntegrator(MatrixCoefficient &q, int qo = 0)
-      : vdim(q.GetVDim()), MQ(&q) { Q = NULL; VQ = NULL; Q_order = qo; }
+      : vdim(q.GetVDim()), MQ(&q), pa_ncomp(1)
+   { Q = NULL; VQ = NULL; Q_order = qo; }
 
    int GetVDim() const { return vdim; }
    void SetVDim(int vdim) { this->vdim = vdim; }
@@ -2514,6 +2729,12 @@ protected:
    double q_lambda, q_mu;
    Coefficient *lambda, *mu;
 
+   // PA extension
+   const DofToQuad *maps;         ///< Not owned
+   const GeometricFactors *geom;  ///< Not owned
+   int dim, ne, dofs1D, quad1D;
+   Vector pa_data;
+
 private:
 #ifndef MFEM_THREAD_SAFE
    Vector shape;
@@ -2533,6 +2754,13 @@ public:
                                       ElementTransformation &,
                                       DenseMatrix &);
 
+   using BilinearFormIntegrator::AssemblePA;
+   virtual void AssemblePA(const FiniteElementSpace &fes);
+   virtual void AssembleEA(const FiniteElementSpace &fes, Vector &emat);
+   virtual bool SupportsEA() const { return true; }
+   virtual void AssembleDiagonalPA(Vector &diag);
+   virtual void AddMultPA(const Vector &x, Vector &y) const;
+
    /** Compute the stress corresponding to the local displacement @a u and
        interpolate it at the nodes of the given @a fluxelem. Only the symmetric
        part of the stress is stored, so that the size of @a flux is equal to
@@ -2616,6 +2844,8 @@ public:
    virtual void AssembleEABoundaryFaces(const FiniteElementSpace& fes,
                                         Vector &ea_data_bdr);
 
+   virtual bool SupportsEAFaces() const { return true; }
+
    static const IntegrationRule &GetRule(Geometry::Type geom, int order,
                                          FaceElementTransformations &T);
 
@@ -2646,6 +2876,14 @@ protected:
    Vector shape1, shape2, dshape1dn, dshape2dn, nor, nh, ni;
    DenseMatrix jmat, dshape1, dshape2, mq, adjJ;
 
+   // PA extension
+   const DofToQuad *maps;         ///< Not owned
+   int dim, nf, dofs1D, quad1D;
+   Vector pa_data;
+
+private:
+   void SetupPA(const FiniteElementSpace &fes, FaceType type);
+
 public:
    DGDiffusionIntegrator(const double s, const double k)
       : Q(NULL), MQ(NULL), sigma(s), kappa(k) { }
@@ -2658,6 +2896,23 @@ public:
                                    const FiniteElement &el2,
                                    FaceElementTransformations &Trans,
                                    DenseMatrix &elmat);
+
+   /** The partially assembled face action requires L2 spaces with a
+       Gauss-Lobatto tensor basis on conforming quad/hex meshes. */
+   virtual void AssemblePAInteriorFaces(const FiniteElementSpace &fes);
+
+   virtual void AssemblePABoundaryFaces(const FiniteElementSpace &fes);
+
+   virtual bool RequiresFaceNormalDerivatives() const { return true; }
+
+   virtual void AddMultPAFaceNormalDerivatives(const Vector &x,
+                                               const Vector &dxdn,
+                                               Vector &y, Vector &dydn) const;
+
+   virtual void AddMultTransposePAFaceNormalDerivatives(const Vector &x,
+                                                        const Vector &dxdn,
+                                                        Vector &y,
+                                                        Vector &dydn) const;
 };
 
 /** Integrator for the DG elasticity form, for the formulations see:
@@ -862,4 +862,382 @@ void ConvectionIntegrator::AddMultPA(const Vector &x, Vector &y) const
                      pa_data, x, y);
 }
 
+// PA Convection Apply transpose 2D kernel
+template<int T_D1D = 0, int T_Q1D = 0> static
+void PAConvectionApplyT2D(const int ne,
+                          const Array<double> &b,
+                          const Array<double> &bt,
+                          const Array<double> &gt,
+                          const Vector &_op,
+                          const Vector &_x,
+                          Vector &_y,
+                          const int d1d = 0,
+                          const int q1d = 0)
+{
+   const int NE = ne;
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto Bt = Reshape(bt.Read(), D1D, Q1D);
+   auto Gt = Reshape(gt.Read(), D1D, Q1D);
+   auto op = Reshape(_op.Read(), Q1D, Q1D, 2, NE);
+   auto x = Reshape(_x.Read(), D1D, D1D, NE);
+   auto y = Reshape(_y.ReadWrite(), D1D, D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      // the following variables are evaluated at compile time
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+
+      double u[max_D1D][max_D1D];
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            u[dy][dx] = x(dx,dy,e);
+         }
+      }
+      double Bu[max_D1D][max_Q1D];
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            Bu[dy][qx] = 0.0;
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               Bu[dy][qx] += B(qx,dx) * u[dy][dx];
+            }
+         }
+      }
+      // Apply the quadrature data to the values of x at the points
+      double DBu0[max_Q1D][max_Q1D];
+      double DBu1[max_Q1D][max_Q1D];
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            double BBu = 0.0;
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               BBu += B(qy,dy) * Bu[dy][qx];
+            }
+            DBu0[qy][qx] = op(qx,qy,0,e) * BBu;
+            DBu1[qy][qx] = op(qx,qy,1,e) * BBu;
+         }
+      }
+      double GDBu[max_Q1D][max_D1D];
+      double BDBu[max_Q1D][max_D1D];
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            GDBu[qy][dx] = 0.0;
+            BDBu[qy][dx] = 0.0;
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               GDBu[qy][dx] += Gt(dx,qx) * DBu0[qy][qx];
+               BDBu[qy][dx] += Bt(dx,qx) * DBu1[qy][qx];
+            }
+         }
+      }
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            double GtDBu = 0.0;
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               GtDBu += Bt(dy,qy) * GDBu[qy][dx] + Gt(dy,qy) * BDBu[qy][dx];
+            }
+            y(dx,dy,e) += GtDBu;
+         }
+      }
+   });
+}
+
+// PA Convection Apply transpose 3D kernel
+template<int T_D1D = 0, int T_Q1D = 0> static
+void PAConvectionApplyT3D(const int ne,
+                          const Array<double> &b,
+                          const Array<double> &bt,
+                          const Array<double> &gt,
+                          const Vector &_op,
+                          const Vector &_x,
+                          Vector &_y,
+                          const int d1d = 0,
+                          const int q1d = 0)
+{
+   const int NE = ne;
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto Bt = Reshape(bt.Read(), D1D, Q1D);
+   auto Gt = Reshape(gt.Read(), D1D, Q1D);
+   auto op = Reshape(_op.Read(), Q1D, Q1D, Q1D, 3, NE);
+   auto x = Reshape(_x.Read(), D1D, D1D, D1D, NE);
+   auto y = Reshape(_y.ReadWrite(), D1D, D1D, D1D, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      // the following variables are evaluated at compile time
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+
+      double Bu[max_D1D][max_D1D][max_Q1D];
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               Bu[dz][dy][qx] = 0.0;
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  Bu[dz][dy][qx] += B(qx,dx) * x(dx,dy,dz,e);
+               }
+            }
+         }
+      }
+      double BBu[max_D1D][max_Q1D][max_Q1D];
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               BBu[dz][qy][qx] = 0.0;
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  BBu[dz][qy][qx] += B(qy,dy) * Bu[dz][dy][qx];
+               }
+            }
+         }
+      }
+      // Interpolate in z, apply the quadrature data to the values of x at the
+      // points and contract in z: G^T for the z derivative, B^T for the others
+      double DBu[max_Q1D][max_Q1D][max_Q1D];
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               DBu[qz][qy][qx] = 0.0;
+               for (int dz = 0; dz < D1D; ++dz)
+               {
+                  DBu[qz][qy][qx] += B(qz,dz) * BBu[dz][qy][qx];
+               }
+            }
+         }
+      }
+      double BDBu0[max_D1D][max_Q1D][max_Q1D];
+      double BDBu1[max_D1D][max_Q1D][max_Q1D];
+      double GDBu2[max_D1D][max_Q1D][max_Q1D];
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               BDBu0[dz][qy][qx] = 0.0;
+               BDBu1[dz][qy][qx] = 0.0;
+               GDBu2[dz][qy][qx] = 0.0;
+               for (int qz = 0; qz < Q1D; ++qz)
+               {
+                  const double u = DBu[qz][qy][qx];
+                  BDBu0[dz][qy][qx] += Bt(dz,qz) * op(qx,qy,qz,0,e) * u;
+                  BDBu1[dz][qy][qx] += Bt(dz,qz) * op(qx,qy,qz,1,e) * u;
+                  GDBu2[dz][qy][qx] += Gt(dz,qz) * op(qx,qy,qz,2,e) * u;
+               }
+            }
+         }
+      }
+      // Contract in y: B^T for the x and z derivatives, G^T for the y one
+      double GDBu[max_D1D][max_D1D][max_Q1D];
+      double BDBu[max_D1D][max_D1D][max_Q1D];
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               GDBu[dz][dy][qx] = 0.0;
+               BDBu[dz][dy][qx] = 0.0;
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  GDBu[dz][dy][qx] += Bt(dy,qy) * BDBu0[dz][qy][qx];
+                  BDBu[dz][dy][qx] += Gt(dy,qy) * BDBu1[dz][qy][qx] +
+                                      Bt(dy,qy) * GDBu2[dz][qy][qx];
+               }
+            }
+         }
+      }
+      // Contract in x: G^T for the x derivative, B^T for the others
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               double GtDBu = 0.0;
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  GtDBu += Gt(dx,qx) * GDBu[dz][dy][qx] +
+                           Bt(dx,qx) * BDBu[dz][dy][qx];
+               }
+               y(dx,dy,dz,e) += GtDBu;
+            }
+         }
+      }
+   });
+}
+
+static void PAConvectionApplyT(const int dim,
+                               const int D1D,
+                               const int Q1D,
+                               const int NE,
+                               const Array<double> &B,
+                               const Array<double> &Bt,
+                               const Array<double> &Gt,
+                               const Vector &op,
+                               const Vector &x,
+                               Vector &y)
+{
+   if (dim == 2)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x22: return PAConvectionApplyT2D<2,2>(NE,B,Bt,Gt,op,x,y);
+         case 0x33: return PAConvectionApplyT2D<3,3>(NE,B,Bt,Gt,op,x,y);
+         case 0x44: return PAConvectionApplyT2D<4,4>(NE,B,Bt,Gt,op,x,y);
+         case 0x55: return PAConvectionApplyT2D<5,5>(NE,B,Bt,Gt,op,x,y);
+         default:   return PAConvectionApplyT2D(NE,B,Bt,Gt,op,x,y,D1D,Q1D);
+      }
+   }
+   else if (dim == 3)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x23: return PAConvectionApplyT3D<2,3>(NE,B,Bt,Gt,op,x,y);
+         case 0x34: return PAConvectionApplyT3D<3,4>(NE,B,Bt,Gt,op,x,y);
+         case 0x45: return PAConvectionApplyT3D<4,5>(NE,B,Bt,Gt,op,x,y);
+         case 0x56: return PAConvectionApplyT3D<5,6>(NE,B,Bt,Gt,op,x,y);
+         default:   return PAConvectionApplyT3D(NE,B,Bt,Gt,op,x,y,D1D,Q1D);
+      }
+   }
+   MFEM_ABORT("Unknown kernel.");
+}
+
+// PA Convection Apply transpose kernel
+void ConvectionIntegrator::AddMultTransposePA(const Vector &x, Vector &y) const
+{
+   PAConvectionApplyT(dim, dofs1D, quad1D, ne, maps->B, maps->Bt, maps->Gt,
+                      pa_data, x, y);
+}
+
+// MF Convection Integrator
+
+void ConvectionIntegrator::AssembleMF(const FiniteElementSpace &fes)
+{
+   // Assumes tensor-product elements
+   Mesh *mesh = fes.GetMesh();
+   dim = mesh->Dimension();
+   ne = fes.GetNE();
+   delete mf_geom;
+   mf_geom = NULL;
+   if (ne == 0) { return; }
+   const FiniteElement &el = *fes.GetFE(0);
+   ElementTransformation &Trans = *fes.GetElementTransformation(0);
+   const IntegrationRule *ir = IntRule ? IntRule : &GetRule(el, Trans);
+   nq = ir->GetNPoints();
+   maps = &el.GetDofToQuad(*ir, DofToQuad::TENSOR);
+   dofs1D = maps->ndof;
+   quad1D = maps->nqpt;
+   mf_geom = new BatchedGeometricFactors(mesh, *ir);
+   if (VectorConstantCoefficient *cQ =
+          dynamic_cast<VectorConstantCoefficient*>(Q))
+   {
+      mf_vel = cQ->GetVec();
+   }
+   else
+   {
+      mf_vel.SetSize(dim * nq * ne);
+      auto C = Reshape(mf_vel.HostWrite(), dim, nq, ne);
+      Vector Vq(dim);
+      for (int e = 0; e < ne; ++e)
+      {
+         ElementTransformation& T = *fes.GetElementTransformation(e);
+         for (int q = 0; q < nq; ++q)
+         {
+            Q->Eval(Vq, T, ir->IntPoint(q));
+            for (int i = 0; i < dim; ++i)
+            {
+               C(i,q,e) = Vq(i);
+            }
+         }
+      }
+   }
+}
+
+// Compute the PA quadrature data of the elements [e0, e0+nb) into D.
+static void MFConvectionSetupBatch(const BatchedGeometricFactors &geom,
+                                   const int e0, const int nb,
+                                   const int dim, const int D1D,
+                                   const int Q1D, const Vector &vel,
+                                   const double alpha, Vector &J, Vector &D)
+{
+   const IntegrationRule &ir = geom.GetIntRule();
+   const int nq = ir.GetNPoints();
+   Vector V;
+   if (vel.Size() == dim) { V.MakeRef(const_cast<Vector&>(vel), 0, dim); }
+   else { V.MakeRef(const_cast<Vector&>(vel), e0*dim*nq, nb*dim*nq); }
+   geom.ComputeJacobians(e0, nb, J);
+   D.SetSize(dim * nq * nb, Device::GetDeviceMemoryType());
+   PAConvectionSetup(dim, D1D, Q1D, nb, ir.GetWeights(), J, V, alpha, D);
+}
+
+void ConvectionIntegrator::AddMultMF(const Vector &x, Vector &y) const
+{
+   if (ne == 0) { return; }
+   const int ND = x.Size() / ne;
+   Vector Xb, Yb;
+   for (int b = 0; b < mf_geom->GetNumBatches(); b++)
+   {
+      int e0, nb;
+      mf_geom->GetBatch(b, e0, nb);
+      MFConvectionSetupBatch(*mf_geom, e0, nb, dim, dofs1D, quad1D, mf_vel,
+                             alpha, mf_J, mf_data);
+      Xb.MakeRef(const_cast<Vector&>(x), e0*ND, nb*ND);
+      Yb.MakeRef(y, e0*ND, nb*ND);
+      PAConvectionApply(dim, dofs1D, quad1D, nb,
+                        maps->B, maps->G, maps->Bt, maps->Gt,
+                        mf_data, Xb, Yb);
+   }
+}
+
+void ConvectionIntegrator::AddMultTransposeMF(const Vector &x, Vector &y) const
+{
+   if (ne == 0) { return; }
+   const int ND = x.Size() / ne;
+   Vector Xb, Yb;
+   for (int b = 0; b < mf_geom->GetNumBatches(); b++)
+   {
+      int e0, nb;
+      mf_geom->GetBatch(b, e0, nb);
+      MFConvectionSetupBatch(*mf_geom, e0, nb, dim, dofs1D, quad1D, mf_vel,
+                             alpha, mf_J, mf_data);
+      Xb.MakeRef(const_cast<Vector&>(x), e0*ND, nb*ND);
+      Yb.MakeRef(y, e0*ND, nb*ND);
+      PAConvectionApplyT(dim, dofs1D, quad1D, nb, maps->B, maps->Bt, maps->Gt,
+                         mf_data, Xb, Yb);
+   }
+}
+
 } // namespace mfem
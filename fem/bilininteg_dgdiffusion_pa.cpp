@@ -0,0 +1,448 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "../general/forall.hpp"
+#include "bilininteg.hpp"
+#include "gridfunc.hpp"
+#include "restriction.hpp"
+
+using namespace std;
+
+namespace mfem
+{
+
+// PA DG Diffusion Integrator
+
+// The face values and the reference normal derivatives of both sides are
+// given in the lexicographic face coordinates of the first element, see
+// L2FaceRestriction and L2NormalDerivativeFaceRestriction. At each quadrature
+// point, the flux (Q grad(u)).n of side s is the dot product of a vector c_s
+// with (du/dt_1, ..., du/dt_{dim-1}, du/dn_s): the derivatives along the face
+// coordinates and along the reference normal of side s. The quadrature data
+// has the layout (NQ, 2*dim+1, NF) and stores c_1, c_2 (zero on boundary
+// faces) and kappa times the penalty weight.
+
+// Reference axis normal to the local face @a face_id of a quad or hex.
+static int NormalAxis(const int dim, const int face_id)
+{
+   if (dim == 2) { return (face_id % 2 == 0) ? 1 : 0; }
+   return (face_id == 0 || face_id == 5) ? 2 :
+          (face_id == 1 || face_id == 3) ? 1 : 0;
+}
+
+void DGDiffusionIntegrator::SetupPA(const FiniteElementSpace &fes,
+                                    FaceType type)
+{
+   nf = fes.GetNFbyType(type);
+   if (nf == 0) { return; }
+   // Assumes tensor-product elements
+   Mesh *mesh = fes.GetMesh();
+   dim = mesh->Dimension();
+   MFEM_VERIFY(dim == 2 || dim == 3, "Dimension not supported.");
+   MFEM_VERIFY(mesh->SpaceDimension() == dim,
+               "surface meshes are not supported");
+   MFEM_VERIFY(fes.IsDGSpace(), "only L2 spaces are supported");
+   const FiniteElement &el = *fes.GetFE(0);
+   const FiniteElement &face_el =
+      *fes.GetTraceElement(0, mesh->GetFaceBaseGeometry(0));
+   const IntegrationRule *ir = IntRule ? IntRule :
+                               &IntRules.Get(face_el.GetGeomType(),
+                                             2*el.GetOrder());
+   maps = &face_el.GetDofToQuad(*ir, DofToQuad::TENSOR);
+   dofs1D = maps->ndof;
+   quad1D = maps->nqpt;
+   const int nq = ir->GetNPoints();
+   pa_data.SetSize((2*dim + 1) * nq * nf, Device::GetMemoryType());
+   auto D = Reshape(pa_data.HostWrite(), nq, 2*dim + 1, nf);
+
+   Vector nor(dim), v(dim), c(dim);
+   DenseMatrix M(dim), Minv(dim), mq(dim);
+   int f_ind = 0;
+   for (int f = 0; f < fes.GetNF(); ++f)
+   {
+      int e1, e2;
+      int inf1, inf2;
+      mesh->GetFaceElements(f, &e1, &e2);
+      mesh->GetFaceInfos(f, &inf1, &inf2);
+      if (!((type==FaceType::Interior && e2>=0) ||
+            (type==FaceType::Boundary && e2<0))) { continue; }
+      const bool interior = (e2 >= 0);
+      const int face_id1 = inf1 / 64;
+      const int face_id2 = inf2 / 64;
+      FaceElementTransformations &T = *mesh->GetFaceElementTransformations(f);
+      for (int p = 0; p < nq; ++p)
+      {
+         const IntegrationPoint &ip = ir->IntPoint(p);
+         // Convert to lexicographic ordering
+         const int iq = ToLexOrdering(dim, face_id1, quad1D, p);
+         T.SetAllIntPoints(&ip);
+         CalcOrtho(T.Jacobian(), nor);
+         // Tangents of the face coordinates of the first element
+         const DenseMatrix &J1 = T.Elem1->Jacobian();
+         const int n1 = NormalAxis(dim, face_id1);
+         for (int a = 0, t = 0; t < dim; ++t)
+         {
+            if (t == n1) { continue; }
+            for (int i = 0; i < dim; ++i) { M(a,i) = J1(i,t); }
+            a++;
+         }
+         double wq = 0.0;
+         for (int s = 0; s < 2; ++s)
+         {
+            if (s == 1 && !interior)
+            {
+               for (int i = 0; i < dim; ++i) { D(iq,dim+i,f_ind) = 0.0; }
+               continue;
+            }
+            ElementTransformation &Ts = (s == 0) ? *T.Elem1 : *T.Elem2;
+            const IntegrationPoint &eip = (s == 0) ? T.GetElement1IntPoint() :
+                                          T.GetElement2IntPoint();
+            const double w = interior ? ip.weight/2 : ip.weight;
+            // v = w Q^T nor, so that (Q grad(u)).nor w = grad(u).v
+            if (MQ)
+            {
+               MQ->Eval(mq, Ts, eip);
+               mq.MultTranspose(nor, v);
+               v *= w;
+            }
+            else
+            {
+               v.Set(Q ? w*Q->Eval(Ts, eip) : w, nor);
+            }
+            wq += (v * nor) / Ts.Weight();
+            // grad(u) = M^{-1} (du/dt_1, ..., du/dn_s), so c_s = M^{-T} v
+            const DenseMatrix &Js = Ts.Jacobian();
+            const int ns = NormalAxis(dim, (s == 0) ? face_id1 : face_id2);
+            for (int i = 0; i < dim; ++i) { M(dim-1,i) = Js(i,ns); }
+            CalcInverse(M, Minv);
+            Minv.MultTranspose(v, c);
+            for (int i = 0; i < dim; ++i) { D(iq,s*dim+i,f_ind) = c(i); }
+         }
+         D(iq,2*dim,f_ind) = kappa * wq;
+      }
+      f_ind++;
+   }
+   MFEM_VERIFY(f_ind==nf, "Incorrect number of faces.");
+}
+
+void DGDiffusionIntegrator::AssemblePAInteriorFaces(
+   const FiniteElementSpace &fes)
+{
+   SetupPA(fes, FaceType::Interior);
+}
+
+void DGDiffusionIntegrator::AssemblePABoundaryFaces(
+   const FiniteElementSpace &fes)
+{
+   SetupPA(fes, FaceType::Boundary);
+}
+
+// PA DG Diffusion Apply 2D kernel. The action of the form
+//    a1 <{(Q grad(u)).n}, [v]> + a2 <[u], {(Q grad(v)).n}> + kappa <[u], [v]>,
+// with (a1, a2) = (-1, sigma) for Mult and (sigma, -1) for MultTranspose.
+template<int T_D1D = 0, int T_Q1D = 0> static
+void PADGDiffusionApply2D(const int NF,
+                          const Array<double> &b,
+                          const Array<double> &g,
+                          const Array<double> &bt,
+                          const Array<double> &gt,
+                          const double a1,
+                          const double a2,
+                          const Vector &op_,
+                          const Vector &x_,
+                          const Vector &dxdn_,
+                          Vector &y_,
+                          Vector &dydn_,
+                          const int d1d = 0,
+                          const int q1d = 0)
+{
+   constexpr int DIM = 2;
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto G = Reshape(g.Read(), Q1D, D1D);
+   auto Bt = Reshape(bt.Read(), D1D, Q1D);
+   auto Gt = Reshape(gt.Read(), D1D, Q1D);
+   auto op = Reshape(op_.Read(), Q1D, 2*DIM+1, NF);
+   auto x = Reshape(x_.Read(), D1D, 2, NF);
+   auto dxdn = Reshape(dxdn_.Read(), D1D, 2, NF);
+   auto y = Reshape(y_.ReadWrite(), D1D, 2, NF);
+   auto dydn = Reshape(dydn_.ReadWrite(), D1D, 2, NF);
+   MFEM_FORALL(f, NF,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+      // values, tangential and normal derivatives at the quadrature points
+      double u[2][max_Q1D];
+      double du[2][max_Q1D];
+      double dn[2][max_Q1D];
+      for (int s = 0; s < 2; ++s)
+      {
+         for (int q = 0; q < Q1D; ++q)
+         {
+            u[s][q] = 0.0;
+            du[s][q] = 0.0;
+            dn[s][q] = 0.0;
+            for (int d = 0; d < D1D; ++d)
+            {
+               u[s][q] += B(q,d) * x(d,s,f);
+               du[s][q] += G(q,d) * x(d,s,f);
+               dn[s][q] += B(q,d) * dxdn(d,s,f);
+            }
+         }
+      }
+      for (int q = 0; q < Q1D; ++q)
+      {
+         const double jump = u[0][q] - u[1][q];
+         double flux = 0.0;
+         for (int s = 0; s < 2; ++s)
+         {
+            flux += op(q,s*DIM,f) * du[s][q] + op(q,s*DIM+1,f) * dn[s][q];
+         }
+         const double r = a1 * flux + op(q,2*DIM,f) * jump;
+         const double aj = a2 * jump;
+         for (int s = 0; s < 2; ++s)
+         {
+            u[s][q] = (s == 0) ? r : -r;
+            du[s][q] = aj * op(q,s*DIM,f);
+            dn[s][q] = aj * op(q,s*DIM+1,f);
+         }
+      }
+      for (int s = 0; s < 2; ++s)
+      {
+         for (int d = 0; d < D1D; ++d)
+         {
+            double r_y = 0.0, r_dydn = 0.0;
+            for (int q = 0; q < Q1D; ++q)
+            {
+               r_y += Bt(d,q) * u[s][q] + Gt(d,q) * du[s][q];
+               r_dydn += Bt(d,q) * dn[s][q];
+            }
+            y(d,s,f) += r_y;
+            dydn(d,s,f) += r_dydn;
+         }
+      }
+   });
+}
+
+// PA DG Diffusion Apply 3D kernel
+template<int T_D1D = 0, int T_Q1D = 0> static
+void PADGDiffusionApply3D(const int NF,
+                          const Array<double> &b,
+                          const Array<double> &g,
+                          const Array<double> &bt,
+                          const Array<double> &gt,
+                          const double a1,
+                          const double a2,
+                          const Vector &op_,
+                          const Vector &x_,
+                          const Vector &dxdn_,
+                          Vector &y_,
+                          Vector &dydn_,
+                          const int d1d = 0,
+                          const int q1d = 0)
+{
+   constexpr int DIM = 3;
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto G = Reshape(g.Read(), Q1D, D1D);
+   auto Bt = Reshape(bt.Read(), D1D, Q1D);
+   auto Gt = Reshape(gt.Read(), D1D, Q1D);
+   auto op = Reshape(op_.Read(), Q1D, Q1D, 2*DIM+1, NF);
+   auto x = Reshape(x_.Read(), D1D, D1D, 2, NF);
+   auto dxdn = Reshape(dxdn_.Read(), D1D, D1D, 2, NF);
+   auto y = Reshape(y_.ReadWrite(), D1D, D1D, 2, NF);
+   auto dydn = Reshape(dydn_.ReadWrite(), D1D, D1D, 2, NF);
+   MFEM_FORALL(f, NF,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+      // values, tangential and normal derivatives at the quadrature points
+      double u[2][max_Q1D][max_Q1D];
+      double du1[2][max_Q1D][max_Q1D];
+      double du2[2][max_Q1D][max_Q1D];
+      double dn[2][max_Q1D][max_Q1D];
+      for (int s = 0; s < 2; ++s)
+      {
+         double Bu[max_Q1D][max_D1D];
+         double Gu[max_Q1D][max_D1D];
+         double Bn[max_Q1D][max_D1D];
+         for (int q1 = 0; q1 < Q1D; ++q1)
+         {
+            for (int d2 = 0; d2 < D1D; ++d2)
+            {
+               Bu[q1][d2] = 0.0;
+               Gu[q1][d2] = 0.0;
+               Bn[q1][d2] = 0.0;
+               for (int d1 = 0; d1 < D1D; ++d1)
+               {
+                  Bu[q1][d2] += B(q1,d1) * x(d1,d2,s,f);
+                  Gu[q1][d2] += G(q1,d1) * x(d1,d2,s,f);
+                  Bn[q1][d2] += B(q1,d1) * dxdn(d1,d2,s,f);
+               }
+            }
+         }
+         for (int q1 = 0; q1 < Q1D; ++q1)
+         {
+            for (int q2 = 0; q2 < Q1D; ++q2)
+            {
+               u[s][q1][q2] = 0.0;
+               du1[s][q1][q2] = 0.0;
+               du2[s][q1][q2] = 0.0;
+               dn[s][q1][q2] = 0.0;
+               for (int d2 = 0; d2 < D1D; ++d2)
+               {
+                  u[s][q1][q2] += B(q2,d2) * Bu[q1][d2];
+                  du1[s][q1][q2] += B(q2,d2) * Gu[q1][d2];
+                  du2[s][q1][q2] += G(q2,d2) * Bu[q1][d2];
+                  dn[s][q1][q2] += B(q2,d2) * Bn[q1][d2];
+               }
+            }
+         }
+      }
+      for (int q1 = 0; q1 < Q1D; ++q1)
+      {
+         for (int q2 = 0; q2 < Q1D; ++q2)
+         {
+            const double jump = u[0][q1][q2] - u[1][q1][q2];
+            double flux = 0.0;
+            for (int s = 0; s < 2; ++s)
+            {
+               flux += op(q1,q2,s*DIM,f) * du1[s][q1][q2] +
+                       op(q1,q2,s*DIM+1,f) * du2[s][q1][q2] +
+                       op(q1,q2,s*DIM+2,f) * dn[s][q1][q2];
+            }
+            const double r = a1 * flux + op(q1,q2,2*DIM,f) * jump;
+            const double aj = a2 * jump;
+            for (int s = 0; s < 2; ++s)
+            {
+               u[s][q1][q2] = (s == 0) ? r : -r;
+               du1[s][q1][q2] = aj * op(q1,q2,s*DIM,f);
+               du2[s][q1][q2] = aj * op(q1,q2,s*DIM+1,f);
+               dn[s][q1][q2] = aj * op(q1,q2,s*DIM+2,f);
+            }
+         }
+      }
+      for (int s = 0; s < 2; ++s)
+      {
+         double Bu[max_D1D][max_Q1D];
+         double Bdu[max_D1D][max_Q1D];
+         double Bn[max_D1D][max_Q1D];
+         for (int d2 = 0; d2 < D1D; ++d2)
+         {
+            for (int q1 = 0; q1 < Q1D; ++q1)
+            {
+               Bu[d2][q1] = 0.0;
+               Bdu[d2][q1] = 0.0;
+               Bn[d2][q1] = 0.0;
+               for (int q2 = 0; q2 < Q1D; ++q2)
+               {
+                  Bu[d2][q1] += Bt(d2,q2) * u[s][q1][q2] +
+                                Gt(d2,q2) * du2[s][q1][q2];
+                  Bdu[d2][q1] += Bt(d2,q2) * du1[s][q1][q2];
+                  Bn[d2][q1] += Bt(d2,q2) * dn[s][q1][q2];
+               }
+            }
+         }
+         for (int d2 = 0; d2 < D1D; ++d2)
+         {
+            for (int d1 = 0; d1 < D1D; ++d1)
+            {
+               double r_y = 0.0, r_dydn = 0.0;
+               for (int q1 = 0; q1 < Q1D; ++q1)
+               {
+                  r_y += Bt(d1,q1) * Bu[d2][q1] + Gt(d1,q1) * Bdu[d2][q1];
+                  r_dydn += Bt(d1,q1) * Bn[d2][q1];
+               }
+               y(d1,d2,s,f) += r_y;
+               dydn(d1,d2,s,f) += r_dydn;
+            }
+         }
+      }
+   });
+}
+
+static void PADGDiffusionApply(const int dim,
+                               const int D1D,
+                               const int Q1D,
+                               const int NF,
+                               const Array<double> &B,
+                               const Array<double> &G,
+                               const Array<double> &Bt,
+                               const Array<double> &Gt,
+                               const double a1,
+                               const double a2,
+                               const Vector &op,
+                               const Vector &x,
+                               const Vector &dxdn,
+                               Vector &y,
+                               Vector &dydn)
+{
+   if (dim == 2)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x22: return PADGDiffusionApply2D<2,2>(NF,B,G,Bt,Gt,a1,a2,
+                                                        op,x,dxdn,y,dydn);
+         case 0x33: return PADGDiffusionApply2D<3,3>(NF,B,G,Bt,Gt,a1,a2,
+                                                        op,x,dxdn,y,dydn);
+         case 0x44: return PADGDiffusionApply2D<4,4>(NF,B,G,Bt,Gt,a1,a2,
+                                                        op,x,dxdn,y,dydn);
+         case 0x55: return PADGDiffusionApply2D<5,5>(NF,B,G,Bt,Gt,a1,a2,
+                                                        op,x,dxdn,y,dydn);
+         default: return PADGDiffusionApply2D(NF,B,G,Bt,Gt,a1,a2,
+                                                 op,x,dxdn,y,dydn,D1D,Q1D);
+      }
+   }
+   else if (dim == 3)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x22: return PADGDiffusionApply3D<2,2>(NF,B,G,Bt,Gt,a1,a2,
+                                                        op,x,dxdn,y,dydn);
+         case 0x33: return PADGDiffusionApply3D<3,3>(NF,B,G,Bt,Gt,a1,a2,
+                                                        op,x,dxdn,y,dydn);
+         case 0x44: return PADGDiffusionApply3D<4,4>(NF,B,G,Bt,Gt,a1,a2,
+                                                        op,x,dxdn,y,dydn);
+         default: return PADGDiffusionApply3D(NF,B,G,Bt,Gt,a1,a2,
+                                                 op,x,dxdn,y,dydn,D1D,Q1D);
+      }
+   }
+   MFEM_ABORT("Unknown kernel.");
+}
+
+void DGDiffusionIntegrator::AddMultPAFaceNormalDerivatives(
+   const Vector &x, const Vector &dxdn, Vector &y, Vector &dydn) const
+{
+   if (nf == 0) { return; }
+   PADGDiffusionApply(dim, dofs1D, quad1D, nf,
+                      maps->B, maps->G, maps->Bt, maps->Gt,
+                      -1.0, sigma, pa_data, x, dxdn, y, dydn);
+}
+
+void DGDiffusionIntegrator::AddMultTransposePAFaceNormalDerivatives(
+   const Vector &x, const Vector &dxdn, Vector &y, Vector &dydn) const
+{
+   if (nf == 0) { return; }
+   PADGDiffusionApply(dim, dofs1D, quad1D, nf,
+                      maps->B, maps->G, maps->Bt, maps->Gt,
+                      sigma, -1.0, pa_data, x, dxdn, y, dydn);
+}
+
+} // namespace mfem
@@ -130,8 +130,8 @@ static void EADiffusionAssemble2D(const int NE,
 
 template<int T_D1D = 0, int T_Q1D = 0>
 static void EADiffusionAssemble3D(const int NE,
-                                  const Array<double> &g,
                                   const Array<double> &b,
+                                  const Array<double> &g,
                                   const Vector &padata,
                                   Vector &eadata,
                                   const int d1d = 0,
@@ -222,6 +222,10 @@ void DiffusionIntegrator::AssembleEA(const FiniteElementSpace &fes,
                                      Vector &ea_data)
 {
    AssemblePA(fes);
+   MFEM_VERIFY(pa_groups.Size() == 0, "AssemblyLevel::ELEMENT requires"
+               " tensor-product elements");
+   MFEM_VERIFY(symmetric, "non-symmetric MatrixCoefficient is not supported"
+               " with AssemblyLevel::ELEMENT");
    const int ne = fes.GetMesh()->GetNE();
    const Array<double> &B = maps->B;
    const Array<double> &G = maps->G;
@@ -10,6 +10,7 @@
 // CONTRIBUTING.md for details.
 
 #include "../general/forall.hpp"
+#include "../linalg/kernels.hpp"
 #include "bilininteg.hpp"
 #include "gridfunc.hpp"
 #include "libceed/diffusion.hpp"
@@ -82,21 +83,20 @@ static void OccaPADiffusionSetup3D(const int D1D,
 
 // PA Diffusion Assemble 2D kernel
 template<const int T_SDIM>
-static void PADiffusionSetup2D(const int Q1D,
+static void PADiffusionSetup2D(const int NQ,
                                const int NE,
                                const Array<double> &w,
                                const Vector &j,
                                const Vector &c,
                                Vector &d);
 template<>
-void PADiffusionSetup2D<2>(const int Q1D,
+void PADiffusionSetup2D<2>(const int NQ,
                            const int NE,
                            const Array<double> &w,
                            const Vector &j,
                            const Vector &c,
                            Vector &d)
 {
-   const int NQ = Q1D*Q1D;
    const bool const_c = c.Size() == 1;
    auto W = w.Read();
    auto J = Reshape(j.Read(), NQ, 2, 2, NE);
@@ -122,7 +122,7 @@ void PADiffusionSetup2D<2>(const int Q1D,
 
 // PA Diffusion Assemble 2D kernel with 3D node coords
 template<>
-void PADiffusionSetup2D<3>(const int Q1D,
+void PADiffusionSetup2D<3>(const int NQ,
                            const int NE,
                            const Array<double> &w,
                            const Vector &j,
@@ -131,7 +131,6 @@ void PADiffusionSetup2D<3>(const int Q1D,
 {
    constexpr int DIM = 2;
    constexpr int SDIM = 3;
-   const int NQ = Q1D*Q1D;
    const bool const_c = c.Size() == 1;
 
    auto W = w.Read();
@@ -163,14 +162,13 @@ void PADiffusionSetup2D<3>(const int Q1D,
 }
 
 // PA Diffusion Assemble 3D kernel
-static void PADiffusionSetup3D(const int Q1D,
+static void PADiffusionSetup3D(const int NQ,
                                const int NE,
                                const Array<double> &w,
                                const Vector &j,
                                const Vector &c,
                                Vector &d)
 {
-   const int NQ = Q1D*Q1D*Q1D;
    const bool const_c = c.Size() == 1;
    auto W = w.Read();
    auto J = Reshape(j.Read(), NQ, 3, 3, NE);
@@ -215,6 +213,54 @@ static void PADiffusionSetup3D(const int Q1D,
    });
 }
 
+// PA Diffusion Assemble kernel with a matrix coefficient M, given at the
+// quadrature points with layout (DIM, DIM, NQ, NE). Stores the entries of
+// w det(J) J^{-1} M J^{-T}: only the lower triangle when M is symmetric,
+// otherwise the full matrix in column-major order.
+template<int DIM>
+static void PADiffusionSetupMatrix(const int NQ,
+                                   const int NE,
+                                   const bool symmetric,
+                                   const Array<double> &w,
+                                   const Vector &j,
+                                   const Vector &m,
+                                   Vector &d)
+{
+   const int NS = symmetric ? (DIM*(DIM+1))/2 : DIM*DIM;
+   auto W = w.Read();
+   auto J = Reshape(j.Read(), NQ, DIM, DIM, NE);
+   auto M = Reshape(m.Read(), DIM, DIM, NQ, NE);
+   auto D = Reshape(d.Write(), NQ, NS, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int q = 0; q < NQ; ++q)
+      {
+         double Jq[DIM*DIM], iJ[DIM*DIM], Mq[DIM*DIM], iJM[DIM*DIM];
+         double R[DIM*DIM];
+         for (int k = 0; k < DIM; k++)
+         {
+            for (int l = 0; l < DIM; l++)
+            {
+               Jq[k+DIM*l] = J(q,k,l,e);
+               Mq[k+DIM*l] = M(k,l,q,e);
+            }
+         }
+         const double w_detJ = W[q] * kernels::Det<DIM>(Jq);
+         kernels::CalcInverse<DIM>(Jq, iJ);
+         kernels::Mult(DIM, DIM, DIM, iJ, Mq, iJM);
+         kernels::MultABt(DIM, DIM, DIM, iJM, iJ, R);
+         int s = 0;
+         for (int l = 0; l < DIM; l++)
+         {
+            for (int k = symmetric ? l : 0; k < DIM; k++)
+            {
+               D(q,s++,e) = w_detJ * R[k+DIM*l];
+            }
+         }
+      }
+   });
+}
+
 static void PADiffusionSetup(const int dim,
                              const int sdim,
                              const int D1D,
@@ -237,8 +283,8 @@ static void PADiffusionSetup(const int dim,
 #else
       MFEM_CONTRACT_VAR(D1D);
 #endif // MFEM_USE_OCCA
-      if (sdim == 2) { PADiffusionSetup2D<2>(Q1D, NE, W, J, C, D); }
-      if (sdim == 3) { PADiffusionSetup2D<3>(Q1D, NE, W, J, C, D); }
+      if (sdim == 2) { PADiffusionSetup2D<2>(Q1D*Q1D, NE, W, J, C, D); }
+      if (sdim == 3) { PADiffusionSetup2D<3>(Q1D*Q1D, NE, W, J, C, D); }
    }
    if (dim == 3)
    {
@@ -249,7 +295,7 @@ static void PADiffusionSetup(const int dim,
          return;
       }
 #endif // MFEM_USE_OCCA
-      PADiffusionSetup3D(Q1D, NE, W, J, C, D);
+      PADiffusionSetup3D(Q1D*Q1D*Q1D, NE, W, J, C, D);
    }
 }
 
@@ -260,11 +306,19 @@ void DiffusionIntegrator::SetupPA(const FiniteElementSpace &fes,
    fespace = &fes;
    Mesh *mesh = fes.GetMesh();
    if (mesh->GetNE() == 0) { return; }
+   if (!UsesTensorBasis(fes))
+   {
+      SetupPAGroups(fes);
+      return;
+   }
+   PAGeometryGroup::DeleteGroups(pa_groups);
    const FiniteElement &el = *fes.GetFE(0);
    const IntegrationRule *ir = IntRule ? IntRule : &GetRule(el, el);
 #ifdef MFEM_USE_CEED
    if (DeviceCanUseCeed() && !force)
    {
+      MFEM_VERIFY(MQ == NULL, "MatrixCoefficient is not supported with"
+                  " libCEED");
       if (ceedDataPtr) { delete ceedDataPtr; }
       CeedData* ptr = new CeedData();
       ceedDataPtr = ptr;
@@ -284,6 +338,49 @@ void DiffusionIntegrator::SetupPA(const FiniteElementSpace &fes,
    maps = &el.GetDofToQuad(*ir, DofToQuad::TENSOR);
    dofs1D = maps->ndof;
    quad1D = maps->nqpt;
+   symmetric = true;
+   if (MQ)
+   {
+      MFEM_VERIFY(sdim == dim, "MatrixCoefficient is not supported on"
+                  " surface meshes");
+      MFEM_VERIFY(MQ->GetHeight() == dim && MQ->GetWidth() == dim,
+                  "invalid MatrixCoefficient size");
+      Vector mcoeff(dim * dim * nq * ne);
+      auto M = Reshape(mcoeff.HostWrite(), dim, dim, nq, ne);
+      DenseMatrix Mq(dim);
+      for (int e = 0; e < ne; ++e)
+      {
+         ElementTransformation &T = *mesh->GetElementTransformation(e);
+         for (int q = 0; q < nq; ++q)
+         {
+            const IntegrationPoint &ip = ir->IntPoint(q);
+            T.SetIntPoint(&ip);
+            MQ->Eval(Mq, T, ip);
+            for (int k = 0; k < dim; k++)
+            {
+               for (int l = 0; l < dim; l++)
+               {
+                  M(k,l,q,e) = Mq(k,l);
+                  symmetric = symmetric && (Mq(k,l) == Mq(l,k));
+               }
+            }
+         }
+      }
+      const int ns = symmetric ? symmDims : dim * dim;
+      pa_data.SetSize(ns * nq * ne, Device::GetDeviceMemoryType());
+      if (dim == 2)
+      {
+         PADiffusionSetupMatrix<2>(nq, ne, symmetric, ir->GetWeights(),
+                                   geom->J, mcoeff, pa_data);
+      }
+      else if (dim == 3)
+      {
+         PADiffusionSetupMatrix<3>(nq, ne, symmetric, ir->GetWeights(),
+                                   geom->J, mcoeff, pa_data);
+      }
+      else { MFEM_ABORT("dim==1 not supported in PADiffusionSetup"); }
+      return;
+   }
    pa_data.SetSize(symmDims * nq * ne, Device::GetDeviceMemoryType());
    Vector coeff;
    if (Q == nullptr)
@@ -298,16 +395,7 @@ void DiffusionIntegrator::SetupPA(const FiniteElementSpace &fes,
    }
    else
    {
-      coeff.SetSize(nq * ne);
-      auto C = Reshape(coeff.HostWrite(), nq, ne);
-      for (int e = 0; e < ne; ++e)
-      {
-         ElementTransformation& T = *fes.GetElementTransformation(e);
-         for (int q = 0; q < nq; ++q)
-         {
-            C(q,e) = Q->Eval(T, ir->IntPoint(q));
-         }
-      }
+      Q->EvalQuadrature(coeff, *mesh, *ir);
    }
    PADiffusionSetup(dim, sdim, dofs1D, quad1D, ne, ir->GetWeights(), geom->J,
                     coeff, pa_data);
@@ -321,6 +409,7 @@ void DiffusionIntegrator::AssemblePA(const FiniteElementSpace &fes)
 
 template<int T_D1D = 0, int T_Q1D = 0>
 static void PADiffusionDiagonal2D(const int NE,
+                                  const bool symmetric,
                                   const Array<double> &b,
                                   const Array<double> &g,
                                   const Vector &d,
@@ -334,9 +423,9 @@ static void PADiffusionDiagonal2D(const int NE,
    MFEM_VERIFY(Q1D <= MAX_Q1D, "");
    auto B = Reshape(b.Read(), Q1D, D1D);
    auto G = Reshape(g.Read(), Q1D, D1D);
-   // note the different shape for D, this is a (symmetric) matrix so we only
+   // note the different shape for D, if this is a symmetric matrix we only
    // store necessary entries
-   auto D = Reshape(d.Read(), Q1D*Q1D, 3, NE);
+   auto D = Reshape(d.Read(), Q1D*Q1D, symmetric ? 3 : 4, NE);
    auto Y = Reshape(y.ReadWrite(), D1D, D1D, NE);
    MFEM_FORALL(e, NE,
    {
@@ -359,8 +448,10 @@ static void PADiffusionDiagonal2D(const int NE,
             {
                const int q = qx + qy * Q1D;
                const double D0 = D(q,0,e);
-               const double D1 = D(q,1,e);
-               const double D2 = D(q,2,e);
+               // the two off-diagonal entries contribute the same term
+               const double D1 = symmetric ? D(q,1,e) :
+                                 0.5 * (D(q,1,e) + D(q,2,e));
+               const double D2 = symmetric ? D(q,2,e) : D(q,3,e);
                QD0[qx][dy] += B(qy, dy) * B(qy, dy) * D0;
                QD1[qx][dy] += B(qy, dy) * G(qy, dy) * D1;
                QD2[qx][dy] += G(qy, dy) * G(qy, dy) * D2;
@@ -386,6 +477,7 @@ static void PADiffusionDiagonal2D(const int NE,
 // Shared memory PA Diffusion Diagonal 2D kernel
 template<int T_D1D = 0, int T_Q1D = 0, int T_NBZ = 0>
 static void SmemPADiffusionDiagonal2D(const int NE,
+                                      const bool symmetric,
                                       const Array<double> &b_,
                                       const Array<double> &g_,
                                       const Vector &d_,
@@ -402,7 +494,7 @@ static void SmemPADiffusionDiagonal2D(const int NE,
    MFEM_VERIFY(Q1D <= MQ1, "");
    auto b = Reshape(b_.Read(), Q1D, D1D);
    auto g = Reshape(g_.Read(), Q1D, D1D);
-   auto D = Reshape(d_.Read(), Q1D*Q1D, 3, NE);
+   auto D = Reshape(d_.Read(), Q1D*Q1D, symmetric ? 3 : 4, NE);
    auto Y = Reshape(y_.ReadWrite(), D1D, D1D, NE);
    MFEM_FORALL_2D(e, NE, Q1D, Q1D, NBZ,
    {
@@ -442,8 +534,10 @@ static void SmemPADiffusionDiagonal2D(const int NE,
             {
                const int q = qx + qy * Q1D;
                const double D0 = D(q,0,e);
-               const double D1 = D(q,1,e);
-               const double D2 = D(q,2,e);
+               // the two off-diagonal entries contribute the same term
+               const double D1 = symmetric ? D(q,1,e) :
+                                 0.5 * (D(q,1,e) + D(q,2,e));
+               const double D2 = symmetric ? D(q,2,e) : D(q,3,e);
                const double By = B[qy][dy];
                const double Gy = G[qy][dy];
                const double BB = By * By;
@@ -479,6 +573,7 @@ static void SmemPADiffusionDiagonal2D(const int NE,
 
 template<int T_D1D = 0, int T_Q1D = 0>
 static void PADiffusionDiagonal3D(const int NE,
+                                  const bool symmetric,
                                   const Array<double> &b,
                                   const Array<double> &g,
                                   const Vector &d,
@@ -495,7 +590,7 @@ static void PADiffusionDiagonal3D(const int NE,
    MFEM_VERIFY(Q1D <= MQ1, "");
    auto B = Reshape(b.Read(), Q1D, D1D);
    auto G = Reshape(g.Read(), Q1D, D1D);
-   auto Q = Reshape(d.Read(), Q1D*Q1D*Q1D, 6, NE);
+   auto Q = Reshape(d.Read(), Q1D*Q1D*Q1D, symmetric ? 6 : 9, NE);
    auto Y = Reshape(y.ReadWrite(), D1D, D1D, D1D, NE);
    MFEM_FORALL(e, NE,
    {
@@ -520,8 +615,8 @@ static void PADiffusionDiagonal3D(const int NE,
                      for (int qz = 0; qz < Q1D; ++qz)
                      {
                         const int q = qx + (qy + qz * Q1D) * Q1D;
-                        const int k = j >= i ?
-                        3 - (3-i)*(2-i)/2 + j:
+                        const int k = !symmetric ? i + 3*j :
+                        j >= i ? 3 - (3-i)*(2-i)/2 + j:
                         3 - (3-j)*(2-j)/2 + i;
                         const double O = Q(q,k,e);
                         const double Bz = B(qz,dz);
@@ -578,6 +673,7 @@ static void PADiffusionDiagonal3D(const int NE,
 // Shared memory PA Diffusion Diagonal 3D kernel
 template<int T_D1D = 0, int T_Q1D = 0>
 static void SmemPADiffusionDiagonal3D(const int NE,
+                                      const bool symmetric,
                                       const Array<double> &b_,
                                       const Array<double> &g_,
                                       const Vector &d_,
@@ -594,7 +690,7 @@ static void SmemPADiffusionDiagonal3D(const int NE,
    MFEM_VERIFY(Q1D <= MQ1, "");
    auto b = Reshape(b_.Read(), Q1D, D1D);
    auto g = Reshape(g_.Read(), Q1D, D1D);
-   auto D = Reshape(d_.Read(), Q1D*Q1D*Q1D, 6, NE);
+   auto D = Reshape(d_.Read(), Q1D*Q1D*Q1D, symmetric ? 6 : 9, NE);
    auto Y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE);
    MFEM_FORALL_3D(e, NE, Q1D, Q1D, Q1D,
    {
@@ -635,8 +731,8 @@ static void SmemPADiffusionDiagonal3D(const int NE,
                      for (int qz = 0; qz < Q1D; ++qz)
                      {
                         const int q = qx + (qy + qz * Q1D) * Q1D;
-                        const int k = j >= i ?
-                                      3 - (3-i)*(2-i)/2 + j:
+                        const int k = !symmetric ? i + 3*j :
+                                      j >= i ? 3 - (3-i)*(2-i)/2 + j:
                                       3 - (3-j)*(2-j)/2 + i;
                         const double O = D(q,k,e);
                         const double Bz = B[qz][dz];
@@ -693,6 +789,7 @@ static void SmemPADiffusionDiagonal3D(const int NE,
 }
 
 static void PADiffusionAssembleDiagonal(const int dim,
+                                        const bool symm,
                                         const int D1D,
                                         const int Q1D,
                                         const int NE,
@@ -705,30 +802,30 @@ static void PADiffusionAssembleDiagonal(const int dim,
    {
       switch ((D1D << 4 ) | Q1D)
       {
-         case 0x22: return SmemPADiffusionDiagonal2D<2,2,8>(NE,B,G,D,Y);
-         case 0x33: return SmemPADiffusionDiagonal2D<3,3,8>(NE,B,G,D,Y);
-         case 0x44: return SmemPADiffusionDiagonal2D<4,4,4>(NE,B,G,D,Y);
-         case 0x55: return SmemPADiffusionDiagonal2D<5,5,4>(NE,B,G,D,Y);
-         case 0x66: return SmemPADiffusionDiagonal2D<6,6,2>(NE,B,G,D,Y);
-         case 0x77: return SmemPADiffusionDiagonal2D<7,7,2>(NE,B,G,D,Y);
-         case 0x88: return SmemPADiffusionDiagonal2D<8,8,1>(NE,B,G,D,Y);
-         case 0x99: return SmemPADiffusionDiagonal2D<9,9,1>(NE,B,G,D,Y);
-         default: return PADiffusionDiagonal2D(NE,B,G,D,Y,D1D,Q1D);
+         case 0x22: return SmemPADiffusionDiagonal2D<2,2,8>(NE,symm,B,G,D,Y);
+         case 0x33: return SmemPADiffusionDiagonal2D<3,3,8>(NE,symm,B,G,D,Y);
+         case 0x44: return SmemPADiffusionDiagonal2D<4,4,4>(NE,symm,B,G,D,Y);
+         case 0x55: return SmemPADiffusionDiagonal2D<5,5,4>(NE,symm,B,G,D,Y);
+         case 0x66: return SmemPADiffusionDiagonal2D<6,6,2>(NE,symm,B,G,D,Y);
+         case 0x77: return SmemPADiffusionDiagonal2D<7,7,2>(NE,symm,B,G,D,Y);
+         case 0x88: return SmemPADiffusionDiagonal2D<8,8,1>(NE,symm,B,G,D,Y);
+         case 0x99: return SmemPADiffusionDiagonal2D<9,9,1>(NE,symm,B,G,D,Y);
+         default: return PADiffusionDiagonal2D(NE,symm,B,G,D,Y,D1D,Q1D);
       }
    }
    else if (dim == 3)
    {
       switch ((D1D << 4 ) | Q1D)
       {
-         case 0x23: return SmemPADiffusionDiagonal3D<2,3>(NE,B,G,D,Y);
-         case 0x34: return SmemPADiffusionDiagonal3D<3,4>(NE,B,G,D,Y);
-         case 0x45: return SmemPADiffusionDiagonal3D<4,5>(NE,B,G,D,Y);
-         case 0x56: return SmemPADiffusionDiagonal3D<5,6>(NE,B,G,D,Y);
-         case 0x67: return SmemPADiffusionDiagonal3D<6,7>(NE,B,G,D,Y);
-         case 0x78: return SmemPADiffusionDiagonal3D<7,8>(NE,B,G,D,Y);
-         case 0x89: return SmemPADiffusionDiagonal3D<8,9>(NE,B,G,D,Y);
-         case 0x9A: return SmemPADiffusionDiagonal3D<9,10>(NE,B,G,D,Y);
-         default: return PADiffusionDiagonal3D(NE,B,G,D,Y,D1D,Q1D);
+         case 0x23: return SmemPADiffusionDiagonal3D<2,3>(NE,symm,B,G,D,Y);
+         case 0x34: return SmemPADiffusionDiagonal3D<3,4>(NE,symm,B,G,D,Y);
+         case 0x45: return SmemPADiffusionDiagonal3D<4,5>(NE,symm,B,G,D,Y);
+         case 0x56: return SmemPADiffusionDiagonal3D<5,6>(NE,symm,B,G,D,Y);
+         case 0x67: return SmemPADiffusionDiagonal3D<6,7>(NE,symm,B,G,D,Y);
+         case 0x78: return SmemPADiffusionDiagonal3D<7,8>(NE,symm,B,G,D,Y);
+         case 0x89: return SmemPADiffusionDiagonal3D<8,9>(NE,symm,B,G,D,Y);
+         case 0x9A: return SmemPADiffusionDiagonal3D<9,10>(NE,symm,B,G,D,Y);
+         default: return PADiffusionDiagonal3D(NE,symm,B,G,D,Y,D1D,Q1D);
       }
    }
    MFEM_ABORT("Unknown kernel.");
@@ -736,8 +833,9 @@ static void PADiffusionAssembleDiagonal(const int dim,
 
 void DiffusionIntegrator::AssembleDiagonalPA(Vector &diag)
 {
+   if (pa_groups.Size() > 0) { return AssembleDiagonalPAGroups(diag); }
    if (pa_data.Size()==0) { SetupPA(*fespace, true); }
-   PADiffusionAssembleDiagonal(dim, dofs1D, quad1D, ne,
+   PADiffusionAssembleDiagonal(dim, symmetric, dofs1D, quad1D, ne,
                                maps->B, maps->G, pa_data, diag);
 }
 
@@ -845,6 +943,9 @@ static void OccaPADiffusionApply3D(const int D1D,
 // PA Diffusion Apply 2D kernel
 template<int T_D1D = 0, int T_Q1D = 0>
 static void PADiffusionApply2D(const int NE,
+                               const int *elems,
+                               const int NS,
+                               const bool symmetric,
                                const Array<double> &b_,
                                const Array<double> &g_,
                                const Array<double> &bt_,
@@ -863,11 +964,12 @@ static void PADiffusionApply2D(const int NE,
    auto G = Reshape(g_.Read(), Q1D, D1D);
    auto Bt = Reshape(bt_.Read(), D1D, Q1D);
    auto Gt = Reshape(gt_.Read(), D1D, Q1D);
-   auto D = Reshape(d_.Read(), Q1D*Q1D, 3, NE);
+   auto D = Reshape(d_.Read(), Q1D*Q1D, symmetric ? 3 : 4, NE);
    auto X = Reshape(x_.Read(), D1D, D1D, NE);
    auto Y = Reshape(y_.ReadWrite(), D1D, D1D, NE);
-   MFEM_FORALL(e, NE,
+   MFEM_FORALL(i_e, NS,
    {
+      const int e = elems ? elems[i_e] : i_e;
       const int D1D = T_D1D ? T_D1D : d1d;
       const int Q1D = T_Q1D ? T_Q1D : q1d;
       // the following variables are evaluated at compile time
@@ -919,14 +1021,15 @@ static void PADiffusionApply2D(const int NE,
             const int q = qx + qy * Q1D;
 
             const double O11 = D(q,0,e);
-            const double O12 = D(q,1,e);
-            const double O22 = D(q,2,e);
+            const double O21 = D(q,1,e);
+            const double O12 = symmetric ? O21 : D(q,2,e);
+            const double O22 = symmetric ? D(q,2,e) : D(q,3,e);
 
             const double gradX = grad[qy][qx][0];
             const double gradY = grad[qy][qx][1];
 
             grad[qy][qx][0] = (O11 * gradX) + (O12 * gradY);
-            grad[qy][qx][1] = (O12 * gradX) + (O22 * gradY);
+            grad[qy][qx][1] = (O21 * gradX) + (O22 * gradY);
          }
       }
       for (int qy = 0; qy < Q1D; ++qy)
@@ -965,6 +1068,9 @@ static void PADiffusionApply2D(const int NE,
 // Shared memory PA Diffusion Apply 2D kernel
 template<int T_D1D = 0, int T_Q1D = 0, int T_NBZ = 0>
 static void SmemPADiffusionApply2D(const int NE,
+                                   const int *elems,
+                                   const int NS,
+                                   const bool symmetric,
                                    const Array<double> &b_,
                                    const Array<double> &g_,
                                    const Vector &d_,
@@ -982,11 +1088,12 @@ static void SmemPADiffusionApply2D(const int NE,
    MFEM_VERIFY(Q1D <= MQ1, "");
    auto b = Reshape(b_.Read(), Q1D, D1D);
    auto g = Reshape(g_.Read(), Q1D, D1D);
-   auto D = Reshape(d_.Read(), Q1D*Q1D, 3, NE);
+   auto D = Reshape(d_.Read(), Q1D*Q1D, symmetric ? 3 : 4, NE);
    auto x = Reshape(x_.Read(), D1D, D1D, NE);
    auto Y = Reshape(y_.ReadWrite(), D1D, D1D, NE);
-   MFEM_FORALL_2D(e, NE, Q1D, Q1D, NBZ,
+   MFEM_FORALL_2D(i_e, NS, Q1D, Q1D, NBZ,
    {
+      const int e = elems ? elems[i_e] : i_e;
       const int tidz = MFEM_THREAD_ID(z);
       const int D1D = T_D1D ? T_D1D : d1d;
       const int Q1D = T_Q1D ? T_Q1D : q1d;
@@ -1064,12 +1171,13 @@ static void SmemPADiffusionApply2D(const int NE,
          {
             const int q = (qx + ((qy) * Q1D));
             const double O11 = D(q,0,e);
-            const double O12 = D(q,1,e);
-            const double O22 = D(q,2,e);
+            const double O21 = D(q,1,e);
+            const double O12 = symmetric ? O21 : D(q,2,e);
+            const double O22 = symmetric ? D(q,2,e) : D(q,3,e);
             const double gX = QQ0[qy][qx];
             const double gY = QQ1[qy][qx];
             QQ0[qy][qx] = (O11 * gX) + (O12 * gY);
-            QQ1[qy][qx] = (O12 * gX) + (O22 * gY);
+            QQ1[qy][qx] = (O21 * gX) + (O22 * gY);
          }
       }
       MFEM_SYNC_THREAD;
@@ -1121,6 +1229,9 @@ static void SmemPADiffusionApply2D(const int NE,
 // PA Diffusion Apply 3D kernel
 template<int T_D1D = 0, int T_Q1D = 0>
 static void PADiffusionApply3D(const int NE,
+                               const int *elems,
+                               const int NS,
+                               const bool symmetric,
                                const Array<double> &b,
                                const Array<double> &g,
                                const Array<double> &bt,
@@ -1138,11 +1249,12 @@ static void PADiffusionApply3D(const int NE,
    auto G = Reshape(g.Read(), Q1D, D1D);
    auto Bt = Reshape(bt.Read(), D1D, Q1D);
    auto Gt = Reshape(gt.Read(), D1D, Q1D);
-   auto D = Reshape(d_.Read(), Q1D*Q1D*Q1D, 6, NE);
+   auto D = Reshape(d_.Read(), Q1D*Q1D*Q1D, symmetric ? 6 : 9, NE);
    auto X = Reshape(x_.Read(), D1D, D1D, D1D, NE);
    auto Y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE);
-   MFEM_FORALL(e, NE,
+   MFEM_FORALL(i_e, NS,
    {
+      const int e = elems ? elems[i_e] : i_e;
       const int D1D = T_D1D ? T_D1D : d1d;
       const int Q1D = T_Q1D ? T_Q1D : q1d;
       constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
@@ -1227,17 +1339,20 @@ static void PADiffusionApply3D(const int NE,
             {
                const int q = qx + (qy + qz * Q1D) * Q1D;
                const double O11 = D(q,0,e);
-               const double O12 = D(q,1,e);
-               const double O13 = D(q,2,e);
-               const double O22 = D(q,3,e);
-               const double O23 = D(q,4,e);
-               const double O33 = D(q,5,e);
+               const double O21 = D(q,1,e);
+               const double O31 = D(q,2,e);
+               const double O12 = symmetric ? O21 : D(q,3,e);
+               const double O22 = symmetric ? D(q,3,e) : D(q,4,e);
+               const double O32 = symmetric ? D(q,4,e) : D(q,5,e);
+               const double O13 = symmetric ? O31 : D(q,6,e);
+               const double O23 = symmetric ? O32 : D(q,7,e);
+               const double O33 = symmetric ? D(q,5,e) : D(q,8,e);
                const double gradX = grad[qz][qy][qx][0];
                const double gradY = grad[qz][qy][qx][1];
                const double gradZ = grad[qz][qy][qx][2];
                grad[qz][qy][qx][0] = (O11*gradX)+(O12*gradY)+(O13*gradZ);
-               grad[qz][qy][qx][1] = (O12*gradX)+(O22*gradY)+(O23*gradZ);
-               grad[qz][qy][qx][2] = (O13*gradX)+(O23*gradY)+(O33*gradZ);
+               grad[qz][qy][qx][1] = (O21*gradX)+(O22*gradY)+(O23*gradZ);
+               grad[qz][qy][qx][2] = (O31*gradX)+(O32*gradY)+(O33*gradZ);
             }
          }
       }
@@ -1310,6 +1425,9 @@ static void PADiffusionApply3D(const int NE,
 // Shared memory PA Diffusion Apply 3D kernel
 template<int T_D1D = 0, int T_Q1D = 0>
 static void SmemPADiffusionApply3D(const int NE,
+                                   const int *elems,
+                                   const int NS,
+                                   const bool symmetric,
                                    const Array<double> &b_,
                                    const Array<double> &g_,
                                    const Vector &d_,
@@ -1326,11 +1444,12 @@ static void SmemPADiffusionApply3D(const int NE,
    MFEM_VERIFY(Q1D <= MQ1, "");
    auto b = Reshape(b_.Read(), Q1D, D1D);
    auto g = Reshape(g_.Read(), Q1D, D1D);
-   auto d = Reshape(d_.Read(), Q1D*Q1D*Q1D, 6, NE);
+   auto d = Reshape(d_.Read(), Q1D*Q1D*Q1D, symmetric ? 6 : 9, NE);
    auto x = Reshape(x_.Read(), D1D, D1D, D1D, NE);
    auto y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE);
-   MFEM_FORALL_3D(e, NE, Q1D, Q1D, Q1D,
+   MFEM_FORALL_3D(i_e, NS, Q1D, Q1D, Q1D,
    {
+      const int e = elems ? elems[i_e] : i_e;
       const int tidz = MFEM_THREAD_ID(z);
       const int D1D = T_D1D ? T_D1D : d1d;
       const int Q1D = T_Q1D ? T_Q1D : q1d;
@@ -1453,17 +1572,20 @@ static void SmemPADiffusionApply3D(const int NE,
             {
                const int q = qx + ((qy*Q1D) + (qz*Q1D*Q1D));
                const double O11 = d(q,0,e);
-               const double O12 = d(q,1,e);
-               const double O13 = d(q,2,e);
-               const double O22 = d(q,3,e);
-               const double O23 = d(q,4,e);
-               const double O33 = d(q,5,e);
+               const double O21 = d(q,1,e);
+               const double O31 = d(q,2,e);
+               const double O12 = symmetric ? O21 : d(q,3,e);
+               const double O22 = symmetric ? d(q,3,e) : d(q,4,e);
+               const double O32 = symmetric ? d(q,4,e) : d(q,5,e);
+               const double O13 = symmetric ? O31 : d(q,6,e);
+               const double O23 = symmetric ? O32 : d(q,7,e);
+               const double O33 = symmetric ? d(q,5,e) : d(q,8,e);
                const double gX = QQQ0[qz][qy][qx];
                const double gY = QQQ1[qz][qy][qx];
                const double gZ = QQQ2[qz][qy][qx];
                QQQ0[qz][qy][qx] = (O11*gX) + (O12*gY) + (O13*gZ);
-               QQQ1[qz][qy][qx] = (O12*gX) + (O22*gY) + (O23*gZ);
-               QQQ2[qz][qy][qx] = (O13*gX) + (O23*gY) + (O33*gZ);
+               QQQ1[qz][qy][qx] = (O21*gX) + (O22*gY) + (O23*gZ);
+               QQQ2[qz][qy][qx] = (O31*gX) + (O32*gY) + (O33*gZ);
             }
          }
       }
@@ -1547,9 +1669,12 @@ static void SmemPADiffusionApply3D(const int NE,
 }
 
 static void PADiffusionApply(const int dim,
+                             const bool symm,
                              const int D1D,
                              const int Q1D,
                              const int NE,
+                             const int *elems,
+                             const int NS,
                              const Array<double> &B,
                              const Array<double> &G,
                              const Array<double> &Bt,
@@ -1561,6 +1686,9 @@ static void PADiffusionApply(const int dim,
 #ifdef MFEM_USE_OCCA
    if (DeviceCanUseOcca())
    {
+      MFEM_VERIFY(symm, "OCCA PADiffusionApply requires a symmetric D");
+      MFEM_VERIFY(elems == nullptr, "OCCA PADiffusionApply: element subsets"
+                  " are not supported");
       if (dim == 2)
       {
          OccaPADiffusionApply2D(D1D,Q1D,NE,B,G,Bt,Gt,D,X,Y);
@@ -1578,31 +1706,50 @@ static void PADiffusionApply(const int dim,
    {
       switch ((D1D << 4 ) | Q1D)
       {
-         case 0x22: return SmemPADiffusionApply2D<2,2,16>(NE,B,G,D,X,Y);
-         case 0x33: return SmemPADiffusionApply2D<3,3,16>(NE,B,G,D,X,Y);
-         case 0x44: return SmemPADiffusionApply2D<4,4,8>(NE,B,G,D,X,Y);
-         case 0x55: return SmemPADiffusionApply2D<5,5,8>(NE,B,G,D,X,Y);
-         case 0x66: return SmemPADiffusionApply2D<6,6,4>(NE,B,G,D,X,Y);
-         case 0x77: return SmemPADiffusionApply2D<7,7,4>(NE,B,G,D,X,Y);
-         case 0x88: return SmemPADiffusionApply2D<8,8,2>(NE,B,G,D,X,Y);
-         case 0x99: return SmemPADiffusionApply2D<9,9,2>(NE,B,G,D,X,Y);
-         default:   return PADiffusionApply2D(NE,B,G,Bt,Gt,D,X,Y,D1D,Q1D);
+         case 0x22:
+            return SmemPADiffusionApply2D<2,2,16>(NE,elems,NS,symm,B,G,D,X,Y);
+         case 0x33:
+            return SmemPADiffusionApply2D<3,3,16>(NE,elems,NS,symm,B,G,D,X,Y);
+         case 0x44:
+            return SmemPADiffusionApply2D<4,4,8>(NE,elems,NS,symm,B,G,D,X,Y);
+         case 0x55:
+            return SmemPADiffusionApply2D<5,5,8>(NE,elems,NS,symm,B,G,D,X,Y);
+         case 0x66:
+            return SmemPADiffusionApply2D<6,6,4>(NE,elems,NS,symm,B,G,D,X,Y);
+         case 0x77:
+            return SmemPADiffusionApply2D<7,7,4>(NE,elems,NS,symm,B,G,D,X,Y);
+         case 0x88:
+            return SmemPADiffusionApply2D<8,8,2>(NE,elems,NS,symm,B,G,D,X,Y);
+         case 0x99:
+            return SmemPADiffusionApply2D<9,9,2>(NE,elems,NS,symm,B,G,D,X,Y);
+         default:
+            return PADiffusionApply2D(NE,elems,NS,symm,B,G,Bt,Gt,D,X,Y,D1D,Q1D);
       }
    }
    else if (dim == 3)
    {
       switch ((D1D << 4 ) | Q1D)
       {
-         case 0x23: return SmemPADiffusionApply3D<2,3>(NE,B,G,D,X,Y);
-         case 0x34: return SmemPADiffusionApply3D<3,4>(NE,B,G,D,X,Y);
-         case 0x45: return SmemPADiffusionApply3D<4,5>(NE,B,G,D,X,Y);
-         case 0x46: return SmemPADiffusionApply3D<4,6>(NE,B,G,D,X,Y);
-         case 0x56: return SmemPADiffusionApply3D<5,6>(NE,B,G,D,X,Y);
-         case 0x58: return SmemPADiffusionApply3D<5,8>(NE,B,G,D,X,Y);
-         case 0x67: return SmemPADiffusionApply3D<6,7>(NE,B,G,D,X,Y);
-         case 0x78: return SmemPADiffusionApply3D<7,8>(NE,B,G,D,X,Y);
-         case 0x89: return SmemPADiffusionApply3D<8,9>(NE,B,G,D,X,Y);
-         default:   return PADiffusionApply3D(NE,B,G,Bt,Gt,D,X,Y,D1D,Q1D);
+         case 0x23:
+            return SmemPADiffusionApply3D<2,3>(NE,elems,NS,symm,B,G,D,X,Y);
+         case 0x34:
+            return SmemPADiffusionApply3D<3,4>(NE,elems,NS,symm,B,G,D,X,Y);
+         case 0x45:
+            return SmemPADiffusionApply3D<4,5>(NE,elems,NS,symm,B,G,D,X,Y);
+         case 0x46:
+            return SmemPADiffusionApply3D<4,6>(NE,elems,NS,symm,B,G,D,X,Y);
+         case 0x56:
+            return SmemPADiffusionApply3D<5,6>(NE,elems,NS,symm,B,G,D,X,Y);
+         case 0x58:
+            return SmemPADiffusionApply3D<5,8>(NE,elems,NS,symm,B,G,D,X,Y);
+         case 0x67:
+            return SmemPADiffusionApply3D<6,7>(NE,elems,NS,symm,B,G,D,X,Y);
+         case 0x78:
+            return SmemPADiffusionApply3D<7,8>(NE,elems,NS,symm,B,G,D,X,Y);
+         case 0x89:
+            return SmemPADiffusionApply3D<8,9>(NE,elems,NS,symm,B,G,D,X,Y);
+         default:
+            return PADiffusionApply3D(NE,elems,NS,symm,B,G,Bt,Gt,D,X,Y,D1D,Q1D);
       }
    }
    MFEM_ABORT("Unknown kernel.");
@@ -1611,6 +1758,7 @@ static void PADiffusionApply(const int dim,
 // PA Diffusion Apply kernel
 void DiffusionIntegrator::AddMultPA(const Vector &x, Vector &y) const
 {
+   if (pa_groups.Size() > 0) { return AddMultPAGroups(x, y); }
 #ifdef MFEM_USE_CEED
    if (DeviceCanUseCeed())
    {
@@ -1641,10 +1789,349 @@ void DiffusionIntegrator::AddMultPA(const Vector &x, Vector &y) const
    else
 #endif
    {
-      PADiffusionApply(dim, dofs1D, quad1D, ne,
+      PADiffusionApply(dim, symmetric, dofs1D, quad1D, ne, nullptr, ne,
                        maps->B, maps->G, maps->Bt, maps->Gt,
                        pa_data, x, y);
    }
 }
 
+bool DiffusionIntegrator::SupportsPAElementSubsets() const
+{
+#ifdef MFEM_USE_OCCA
+   if (DeviceCanUseOcca()) { return false; }
+#endif
+   return pa_groups.Size() == 0 && !DeviceCanUseCeed();
+}
+
+void DiffusionIntegrator::AddMultPAElements(const Array<int> &elems,
+                                            const Vector &x, Vector &y) const
+{
+   MFEM_VERIFY(SupportsPAElementSubsets(), "not supported");
+   PADiffusionApply(dim, symmetric, dofs1D, quad1D, ne,
+                    elems.Read(), elems.Size(),
+                    maps->B, maps->G, maps->Bt, maps->Gt,
+                    pa_data, x, y);
+}
+
+// MF Diffusion Integrator
+
+void DiffusionIntegrator::AssembleMF(const FiniteElementSpace &fes)
+{
+   MFEM_VERIFY(MQ == NULL, "MatrixCoefficient is not supported with"
+               " AssemblyLevel::NONE");
+   // Assuming the same element type
+   fespace = &fes;
+   Mesh *mesh = fes.GetMesh();
+   dim = mesh->Dimension();
+   ne = fes.GetNE();
+   delete mf_geom;
+   mf_geom = NULL;
+   if (ne == 0) { return; }
+   const FiniteElement &el = *fes.GetFE(0);
+   const IntegrationRule *ir = IntRule ? IntRule : &GetRule(el, el);
+   maps = &el.GetDofToQuad(*ir, DofToQuad::TENSOR);
+   dofs1D = maps->ndof;
+   quad1D = maps->nqpt;
+   mf_geom = new BatchedGeometricFactors(mesh, *ir);
+   // Only non-constant coefficients are stored at the quadrature points: one
+   // value per point, instead of the (dim*(dim+1))/2 values of pa_data.
+   if (Q == nullptr)
+   {
+      mf_coeff.SetSize(1);
+      mf_coeff(0) = 1.0;
+   }
+   else if (ConstantCoefficient* cQ = dynamic_cast<ConstantCoefficient*>(Q))
+   {
+      mf_coeff.SetSize(1);
+      mf_coeff(0) = cQ->constant;
+   }
+   else
+   {
+      Q->EvalQuadrature(mf_coeff, *mesh, *ir);
+   }
+}
+
+// Compute the PA quadrature data of the elements [e0, e0+nb) into D.
+static void MFDiffusionSetupBatch(const BatchedGeometricFactors &geom,
+                                  const int e0, const int nb,
+                                  const int dim, const int sdim,
+                                  const int D1D, const int Q1D,
+                                  const Vector &coeff, Vector &J, Vector &D)
+{
+   const IntegrationRule &ir = geom.GetIntRule();
+   const int nq = ir.GetNPoints();
+   const int symmDims = (dim * (dim + 1)) / 2;
+   Vector C;
+   if (coeff.Size() == 1) { C.MakeRef(const_cast<Vector&>(coeff), 0, 1); }
+   else { C.MakeRef(const_cast<Vector&>(coeff), e0*nq, nb*nq); }
+   geom.ComputeJacobians(e0, nb, J);
+   D.SetSize(symmDims * nq * nb, Device::GetDeviceMemoryType());
+   PADiffusionSetup(dim, sdim, D1D, Q1D, nb, ir.GetWeights(), J, C, D);
+}
+
+void DiffusionIntegrator::AssembleDiagonalMF(Vector &diag)
+{
+   if (ne == 0) { return; }
+   const int sdim = fespace->GetMesh()->SpaceDimension();
+   const int ND = diag.Size() / ne;
+   Vector Yb;
+   for (int b = 0; b < mf_geom->GetNumBatches(); b++)
+   {
+      int e0, nb;
+      mf_geom->GetBatch(b, e0, nb);
+      MFDiffusionSetupBatch(*mf_geom, e0, nb, dim, sdim, dofs1D, quad1D,
+                            mf_coeff, mf_J, mf_data);
+      Yb.MakeRef(diag, e0*ND, nb*ND);
+      PADiffusionAssembleDiagonal(dim, true, dofs1D, quad1D, nb,
+                                  maps->B, maps->G, mf_data, Yb);
+   }
+}
+
+void DiffusionIntegrator::AddMultMF(const Vector &x, Vector &y) const
+{
+   if (ne == 0) { return; }
+   const int sdim = fespace->GetMesh()->SpaceDimension();
+   const int ND = x.Size() / ne;
+   Vector Xb, Yb;
+   for (int b = 0; b < mf_geom->GetNumBatches(); b++)
+   {
+      int e0, nb;
+      mf_geom->GetBatch(b, e0, nb);
+      MFDiffusionSetupBatch(*mf_geom, e0, nb, dim, sdim, dofs1D, quad1D,
+                            mf_coeff, mf_J, mf_data);
+      Xb.MakeRef(const_cast<Vector&>(x), e0*ND, nb*ND);
+      Yb.MakeRef(y, e0*ND, nb*ND);
+      PADiffusionApply(dim, true, dofs1D, quad1D, nb, nullptr, nb,
+                       maps->B, maps->G, maps->Bt, maps->Gt,
+                       mf_data, Xb, Yb);
+   }
+}
+
+
+// PA Diffusion Integrator on simplicial and mixed meshes
+
+void DiffusionIntegrator::SetupPAGroups(const FiniteElementSpace &fes)
+{
+   Mesh *mesh = fes.GetMesh();
+   dim = mesh->Dimension();
+   ne = fes.GetNE();
+   MFEM_VERIFY(mesh->SpaceDimension() == dim, "surface meshes are not"
+               " supported with non-tensor partial assembly");
+   MFEM_VERIFY(dim > 1, "dim==1 not supported in PADiffusionSetup");
+   PAGeometryGroup::DeleteGroups(pa_groups);
+   PAGeometryGroup::MakeGroups(fes, pa_groups);
+   MFEM_VERIFY(IntRule == NULL || pa_groups.Size() == 1,
+               "a single IntegrationRule cannot be used on mixed meshes");
+   // The quadrature point data are the dim x dim matrices
+   // w det(J) J^{-1} M J^{-T}, with the layout of the tensor path: the lower
+   // triangle if M is symmetric, otherwise the full matrix.
+   const int symmDims = (dim * (dim + 1)) / 2;
+   Array<const IntegrationRule*> irs(pa_groups.Size());
+   for (int i = 0; i < pa_groups.Size(); i++)
+   {
+      PAGeometryGroup &group = *pa_groups[i];
+      const FiniteElement &el = *fes.GetFE(group.elements[0]);
+      irs[i] = IntRule ? IntRule : &GetRule(el, el);
+      group.maps = &el.GetDofToQuad(*irs[i], DofToQuad::FULL);
+      group.qvec.SetSize(irs[i]->GetNPoints() * dim * group.elements.Size(),
+                         Device::GetDeviceMemoryType());
+   }
+   symmetric = true;
+   Vector J, coeff;
+   if (MQ)
+   {
+      MFEM_VERIFY(MQ->GetHeight() == dim && MQ->GetWidth() == dim,
+                  "invalid MatrixCoefficient size");
+      // The symmetry of M decides the layout of all groups
+      Array<Vector*> mcoeff(pa_groups.Size());
+      DenseMatrix Mq(dim);
+      for (int i = 0; i < pa_groups.Size(); i++)
+      {
+         const PAGeometryGroup &group = *pa_groups[i];
+         const int ng = group.elements.Size();
+         const int nq = irs[i]->GetNPoints();
+         mcoeff[i] = new Vector(dim * dim * nq * ng);
+         auto M = Reshape(mcoeff[i]->HostWrite(), dim, dim, nq, ng);
+         for (int e = 0; e < ng; ++e)
+         {
+            ElementTransformation &T =
+               *mesh->GetElementTransformation(group.elements[e]);
+            for (int q = 0; q < nq; ++q)
+            {
+               const IntegrationPoint &ip = irs[i]->IntPoint(q);
+               T.SetIntPoint(&ip);
+               MQ->Eval(Mq, T, ip);
+               for (int k = 0; k < dim; k++)
+               {
+                  for (int l = 0; l < dim; l++)
+                  {
+                     M(k,l,q,e) = Mq(k,l);
+                     symmetric = symmetric && (Mq(k,l) == Mq(l,k));
+                  }
+               }
+            }
+         }
+      }
+      const int ns = symmetric ? symmDims : dim * dim;
+      for (int i = 0; i < pa_groups.Size(); i++)
+      {
+         PAGeometryGroup &group = *pa_groups[i];
+         const int ng = group.elements.Size();
+         const int nq = irs[i]->GetNPoints();
+         const Vector &gJ = group.GetJacobians(*mesh, *irs[i], J);
+         group.pa_data.SetSize(ns * nq * ng, Device::GetDeviceMemoryType());
+         if (dim == 2)
+         {
+            PADiffusionSetupMatrix<2>(nq, ng, symmetric, irs[i]->GetWeights(),
+                                      gJ, *mcoeff[i], group.pa_data);
+         }
+         else
+         {
+            PADiffusionSetupMatrix<3>(nq, ng, symmetric, irs[i]->GetWeights(),
+                                      gJ, *mcoeff[i], group.pa_data);
+         }
+         delete mcoeff[i];
+      }
+      return;
+   }
+   for (int i = 0; i < pa_groups.Size(); i++)
+   {
+      PAGeometryGroup &group = *pa_groups[i];
+      const int ng = group.elements.Size();
+      const int nq = irs[i]->GetNPoints();
+      const Vector &gJ = group.GetJacobians(*mesh, *irs[i], J);
+      group.EvalCoefficient(Q, *mesh, *irs[i], coeff);
+      group.pa_data.SetSize(symmDims * nq * ng, Device::GetDeviceMemoryType());
+      if (dim == 2)
+      {
+         PADiffusionSetup2D<2>(nq, ng, irs[i]->GetWeights(), gJ, coeff,
+                               group.pa_data);
+      }
+      else
+      {
+         PADiffusionSetup3D(nq, ng, irs[i]->GetWeights(), gJ, coeff,
+                            group.pa_data);
+      }
+   }
+}
+
+// Index of the entry (c,l) of the quadrature point matrices stored by
+// SetupPAGroups(): the lower triangle, column by column, if symmetric,
+// otherwise the full matrix in column-major order.
+MFEM_HOST_DEVICE static inline
+int PAGroupIndex(const int DIM, const bool symmetric, const int c, const int l)
+{
+   if (!symmetric) { return c + DIM*l; }
+   const int i = c > l ? c : l, j = c > l ? l : c;
+   return j*DIM - (j*(j-1))/2 + (i - j);
+}
+
+// Non-tensor PA diffusion apply kernel for the elements of one geometry
+// group. The E-vectors have NDE (the largest number of element dofs) rows.
+static void PADiffusionApplyGroup(const int DIM,
+                                  const bool symmetric,
+                                  const int NDE,
+                                  const int NE,
+                                  const PAGeometryGroup &group,
+                                  const Vector &x,
+                                  Vector &y)
+{
+   const int NG = group.elements.Size();
+   const int ND = group.maps->ndof;
+   const int NQ = group.maps->nqpt;
+   const int NS = symmetric ? (DIM*(DIM+1))/2 : DIM*DIM;
+   auto E = group.elements.Read();
+   auto G = Reshape(group.maps->G.Read(), NQ, DIM, ND);
+   auto D = Reshape(group.pa_data.Read(), NQ, NS, NG);
+   auto X = Reshape(x.Read(), NDE, NE);
+   auto U = Reshape(group.qvec.Write(), NQ, DIM, NG);
+   MFEM_FORALL(i, NQ*NG,
+   {
+      const int q = i % NQ;
+      const int k = i / NQ;
+      const int e = E[k];
+      double grad[3] = { 0.0, 0.0, 0.0 };
+      for (int d = 0; d < ND; ++d)
+      {
+         const double xd = X(d,e);
+         for (int c = 0; c < DIM; ++c) { grad[c] += G(q,c,d) * xd; }
+      }
+      for (int c = 0; c < DIM; ++c)
+      {
+         double u = 0.0;
+         for (int l = 0; l < DIM; ++l)
+         {
+            u += D(q,PAGroupIndex(DIM,symmetric,c,l),k) * grad[l];
+         }
+         U(q,c,k) = u;
+      }
+   });
+   auto V = Reshape(group.qvec.Read(), NQ, DIM, NG);
+   auto Y = Reshape(y.ReadWrite(), NDE, NE);
+   MFEM_FORALL(i, ND*NG,
+   {
+      const int d = i % ND;
+      const int k = i / ND;
+      double s = 0.0;
+      for (int q = 0; q < NQ; ++q)
+      {
+         for (int c = 0; c < DIM; ++c) { s += G(q,c,d) * V(q,c,k); }
+      }
+      Y(d,E[k]) += s;
+   });
+}
+
+static void PADiffusionDiagonalGroup(const int DIM,
+                                     const bool symmetric,
+                                     const int NDE,
+                                     const int NE,
+                                     const PAGeometryGroup &group,
+                                     Vector &y)
+{
+   const int NG = group.elements.Size();
+   const int ND = group.maps->ndof;
+   const int NQ = group.maps->nqpt;
+   const int NS = symmetric ? (DIM*(DIM+1))/2 : DIM*DIM;
+   auto E = group.elements.Read();
+   auto G = Reshape(group.maps->G.Read(), NQ, DIM, ND);
+   auto D = Reshape(group.pa_data.Read(), NQ, NS, NG);
+   auto Y = Reshape(y.ReadWrite(), NDE, NE);
+   MFEM_FORALL(i, ND*NG,
+   {
+      const int d = i % ND;
+      const int k = i / ND;
+      double s = 0.0;
+      for (int q = 0; q < NQ; ++q)
+      {
+         for (int l = 0; l < DIM; ++l)
+         {
+            for (int c = 0; c < DIM; ++c)
+            {
+               s += G(q,c,d) * D(q,PAGroupIndex(DIM,symmetric,c,l),k) *
+                    G(q,l,d);
+            }
+         }
+      }
+      Y(d,E[k]) += s;
+   });
+}
+
+void DiffusionIntegrator::AddMultPAGroups(const Vector &x, Vector &y) const
+{
+   const int nde = PAGeometryGroup::MaxDofs(pa_groups);
+   for (int i = 0; i < pa_groups.Size(); i++)
+   {
+      PADiffusionApplyGroup(dim, symmetric, nde, ne, *pa_groups[i], x, y);
+   }
+}
+
+void DiffusionIntegrator::AssembleDiagonalPAGroups(Vector &diag) const
+{
+   const int nde = PAGeometryGroup::MaxDofs(pa_groups);
+   for (int i = 0; i < pa_groups.Size(); i++)
+   {
+      PADiffusionDiagonalGroup(dim, symmetric, nde, ne, *pa_groups[i], diag);
+   }
+}
+
 } // namespace mfem
@@ -0,0 +1,119 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "../general/forall.hpp"
+#include "bilininteg.hpp"
+#include "gridfunc.hpp"
+
+namespace mfem
+{
+
+// The element matrices have the layout (ND, DIM, ND, DIM, NE), matching the
+// (ND, VDIM, NE) layout of the element vectors. Each thread computes the
+// DIM x DIM block coupling one pair of scalar dofs.
+template<int DIM>
+static void EAElasticityAssemble(const int NE,
+                                 const Array<double> &b,
+                                 const Array<double> &g,
+                                 const Vector &padata,
+                                 Vector &eadata,
+                                 const int D1D,
+                                 const int Q1D)
+{
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   const int ND = (DIM == 2) ? D1D*D1D : D1D*D1D*D1D;
+   const int NQ = (DIM == 2) ? Q1D*Q1D : Q1D*Q1D*Q1D;
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto G = Reshape(g.Read(), Q1D, D1D);
+   auto D = Reshape(padata.Read(), NQ, DIM*DIM+2, NE);
+   auto A = Reshape(eadata.ReadWrite(), ND, DIM, ND, DIM, NE);
+   MFEM_FORALL(idx, NE*ND*ND,
+   {
+      const int i = idx % ND;
+      const int j = (idx / ND) % ND;
+      const int e = idx / (ND*ND);
+      const int i1d[3] = { i % D1D, (i / D1D) % D1D, i / (D1D*D1D) };
+      const int j1d[3] = { j % D1D, (j / D1D) % D1D, j / (D1D*D1D) };
+      double K[DIM][DIM];
+      for (int ci = 0; ci < DIM; ++ci)
+      {
+         for (int cj = 0; cj < DIM; ++cj) { K[ci][cj] = 0.0; }
+      }
+      for (int q = 0; q < NQ; ++q)
+      {
+         const int q1d[3] = { q % Q1D, (q / Q1D) % Q1D, q / (Q1D*Q1D) };
+         // reference gradients of the two scalar basis functions
+         double gi[DIM], gj[DIM];
+         for (int k = 0; k < DIM; ++k)
+         {
+            gi[k] = 1.0;
+            gj[k] = 1.0;
+            for (int m = 0; m < DIM; ++m)
+            {
+               gi[k] *= (m == k) ? G(q1d[m],i1d[m]) : B(q1d[m],i1d[m]);
+               gj[k] *= (m == k) ? G(q1d[m],j1d[m]) : B(q1d[m],j1d[m]);
+            }
+         }
+         // physical gradients: grad = ref_grad J^{-1}
+         double pi[DIM], pj[DIM];
+         double pipj = 0.0;
+         for (int d = 0; d < DIM; ++d)
+         {
+            pi[d] = 0.0;
+            pj[d] = 0.0;
+            for (int k = 0; k < DIM; ++k)
+            {
+               pi[d] += gi[k] * D(q,k+DIM*d,e);
+               pj[d] += gj[k] * D(q,k+DIM*d,e);
+            }
+            pipj += pi[d] * pj[d];
+         }
+         const double wl = D(q,DIM*DIM,e);
+         const double wm = D(q,DIM*DIM+1,e);
+         for (int ci = 0; ci < DIM; ++ci)
+         {
+            for (int cj = 0; cj < DIM; ++cj)
+            {
+               K[ci][cj] += wl * pi[ci] * pj[cj] + wm * pi[cj] * pj[ci];
+            }
+            K[ci][ci] += wm * pipj;
+         }
+      }
+      for (int ci = 0; ci < DIM; ++ci)
+      {
+         for (int cj = 0; cj < DIM; ++cj)
+         {
+            A(i,ci,j,cj,e) += K[ci][cj];
+         }
+      }
+   });
+}
+
+void ElasticityIntegrator::AssembleEA(const FiniteElementSpace &fes,
+                                      Vector &ea_data)
+{
+   AssemblePA(fes);
+   if (ne == 0) { return; }
+   const Array<double> &B = maps->B;
+   const Array<double> &G = maps->G;
+   if (dim == 2)
+   {
+      return EAElasticityAssemble<2>(ne,B,G,pa_data,ea_data,dofs1D,quad1D);
+   }
+   if (dim == 3)
+   {
+      return EAElasticityAssemble<3>(ne,B,G,pa_data,ea_data,dofs1D,quad1D);
+   }
+   MFEM_ABORT("Dimension not supported.");
+}
+
+} // namespace mfem
@@ -0,0 +1,695 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "../general/forall.hpp"
+#include "../linalg/kernels.hpp"
+#include "bilininteg.hpp"
+#include "gridfunc.hpp"
+
+using namespace std;
+
+namespace mfem
+{
+
+// PA Elasticity Integrator
+
+// The quadrature point data has the layout (NQ, DIM*DIM+2, NE): the first
+// DIM*DIM entries hold J^{-1} in column-major order, followed by w det(J)
+// lambda and w det(J) mu.
+
+// PA Elasticity Assemble kernel
+template<int DIM>
+static void PAElasticitySetup(const int NQ,
+                              const int NE,
+                              const Array<double> &w,
+                              const Vector &j,
+                              const Vector &lambda,
+                              const Vector &mu,
+                              Vector &op)
+{
+   auto W = w.Read();
+   auto J = Reshape(j.Read(), NQ, DIM, DIM, NE);
+   auto L = Reshape(lambda.Read(), NQ, NE);
+   auto M = Reshape(mu.Read(), NQ, NE);
+   auto D = Reshape(op.Write(), NQ, DIM*DIM+2, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int q = 0; q < NQ; ++q)
+      {
+         double Jq[DIM*DIM];
+         double Jinv[DIM*DIM];
+         for (int i = 0; i < DIM*DIM; ++i) { Jq[i] = J(q,i%DIM,i/DIM,e); }
+         kernels::CalcInverse<DIM>(Jq, Jinv);
+         const double wdetJ = W[q] * kernels::Det<DIM>(Jq);
+         for (int i = 0; i < DIM*DIM; ++i) { D(q,i,e) = Jinv[i]; }
+         D(q,DIM*DIM,e) = wdetJ * L(q,e);
+         D(q,DIM*DIM+1,e) = wdetJ * M(q,e);
+      }
+   });
+}
+
+void ElasticityIntegrator::AssemblePA(const FiniteElementSpace &fes)
+{
+   // Assumes tensor-product elements
+   Mesh *mesh = fes.GetMesh();
+   dim = mesh->Dimension();
+   ne = fes.GetNE();
+   if (ne == 0) { return; }
+   const FiniteElement &el = *fes.GetFE(0);
+   const IntegrationRule *ir
+      = IntRule ? IntRule : &DiffusionIntegrator::GetRule(el, el);
+   const int nq = ir->GetNPoints();
+   MFEM_VERIFY(mesh->SpaceDimension() == dim,
+               "surface meshes are not supported");
+   MFEM_VERIFY(fes.GetVDim() == dim, "vdim must be equal to the dimension");
+   geom = mesh->GetGeometricFactors(*ir, GeometricFactors::JACOBIANS);
+   maps = &el.GetDofToQuad(*ir, DofToQuad::TENSOR);
+   dofs1D = maps->ndof;
+   quad1D = maps->nqpt;
+   pa_data.SetSize((dim*dim + 2) * nq * ne, Device::GetDeviceMemoryType());
+
+   Vector lambda_q, mu_q;
+   mu->EvalQuadrature(mu_q, *mesh, *ir);
+   if (lambda)
+   {
+      lambda->EvalQuadrature(lambda_q, *mesh, *ir);
+   }
+   else
+   {
+      lambda_q.SetSize(mu_q.Size());
+      lambda_q = mu_q;
+      lambda_q *= q_lambda;
+      mu_q *= q_mu;
+   }
+
+   const Array<double> &w = ir->GetWeights();
+   if (dim == 2)
+   {
+      return PAElasticitySetup<2>(nq, ne, w, geom->J, lambda_q, mu_q, pa_data);
+   }
+   if (dim == 3)
+   {
+      return PAElasticitySetup<3>(nq, ne, w, geom->J, lambda_q, mu_q, pa_data);
+   }
+   MFEM_ABORT("Dimension not supported.");
+}
+
+/** Replace the reference gradient @a g, g[c][k] = d(u_c)/d(xi_k), at a
+    quadrature point by the stress sigma(g J^{-1}) contracted with J^{-T}, i.e.
+    the quantity that is tested against the reference gradients of the test
+    functions. The weights @a wl and @a wm include w det(J). */
+template<int DIM> MFEM_HOST_DEVICE static inline
+void PAElasticityStress(const double *Jinv, const double wl, const double wm,
+                        double (&g)[DIM][DIM])
+{
+   double grad_u[DIM][DIM];
+   double div_u = 0.0;
+   for (int c = 0; c < DIM; ++c)
+   {
+      for (int d = 0; d < DIM; ++d)
+      {
+         double s = 0.0;
+         for (int k = 0; k < DIM; ++k) { s += g[c][k] * Jinv[k + DIM*d]; }
+         grad_u[c][d] = s;
+      }
+      div_u += grad_u[c][c];
+   }
+   double sigma[DIM][DIM];
+   for (int c = 0; c < DIM; ++c)
+   {
+      for (int d = 0; d < DIM; ++d)
+      {
+         sigma[c][d] = wm * (grad_u[c][d] + grad_u[d][c]);
+      }
+      sigma[c][c] += wl * div_u;
+   }
+   for (int c = 0; c < DIM; ++c)
+   {
+      for (int k = 0; k < DIM; ++k)
+      {
+         double s = 0.0;
+         for (int d = 0; d < DIM; ++d) { s += sigma[c][d] * Jinv[k + DIM*d]; }
+         g[c][k] = s;
+      }
+   }
+}
+
+// PA Elasticity Apply 2D kernel
+template<int T_D1D = 0, int T_Q1D = 0> static
+void PAElasticityApply2D(const int NE,
+                         const Array<double> &b,
+                         const Array<double> &g,
+                         const Array<double> &bt,
+                         const Array<double> &gt,
+                         const Vector &d_,
+                         const Vector &x_,
+                         Vector &y_,
+                         const int d1d = 0,
+                         const int q1d = 0)
+{
+   constexpr int DIM = 2;
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto G = Reshape(g.Read(), Q1D, D1D);
+   auto Bt = Reshape(bt.Read(), D1D, Q1D);
+   auto Gt = Reshape(gt.Read(), D1D, Q1D);
+   auto D = Reshape(d_.Read(), Q1D*Q1D, DIM*DIM+2, NE);
+   auto x = Reshape(x_.Read(), D1D, D1D, DIM, NE);
+   auto y = Reshape(y_.ReadWrite(), D1D, D1D, DIM, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+
+      double grad[max_Q1D][max_Q1D][DIM][DIM];
+      for (int c = 0; c < DIM; c++)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               grad[qy][qx][c][0] = 0.0;
+               grad[qy][qx][c][1] = 0.0;
+            }
+         }
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            double gradX[max_Q1D][2];
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               gradX[qx][0] = 0.0;
+               gradX[qx][1] = 0.0;
+            }
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               const double s = x(dx,dy,c,e);
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  gradX[qx][0] += s * B(qx,dx);
+                  gradX[qx][1] += s * G(qx,dx);
+               }
+            }
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               const double wy  = B(qy,dy);
+               const double wDy = G(qy,dy);
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  grad[qy][qx][c][0] += gradX[qx][1] * wy;
+                  grad[qy][qx][c][1] += gradX[qx][0] * wDy;
+               }
+            }
+         }
+      }
+      // Stress at the quadrature points, coupling the components
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            const int q = qx + qy * Q1D;
+            double Jinv[DIM*DIM];
+            for (int i = 0; i < DIM*DIM; ++i) { Jinv[i] = D(q,i,e); }
+            PAElasticityStress<DIM>(Jinv, D(q,DIM*DIM,e), D(q,DIM*DIM+1,e),
+                                    grad[qy][qx]);
+         }
+      }
+      for (int c = 0; c < DIM; c++)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            double gradX[max_D1D][2];
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               gradX[dx][0] = 0.0;
+               gradX[dx][1] = 0.0;
+            }
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const double gX = grad[qy][qx][c][0];
+               const double gY = grad[qy][qx][c][1];
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  const double wx  = Bt(dx,qx);
+                  const double wDx = Gt(dx,qx);
+                  gradX[dx][0] += gX * wDx;
+                  gradX[dx][1] += gY * wx;
+               }
+            }
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               const double wy  = Bt(dy,qy);
+               const double wDy = Gt(dy,qy);
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  y(dx,dy,c,e) += ((gradX[dx][0] * wy) + (gradX[dx][1] * wDy));
+               }
+            }
+         }
+      }
+   });
+}
+
+// PA Elasticity Apply 3D kernel
+template<int T_D1D = 0, int T_Q1D = 0> static
+void PAElasticityApply3D(const int NE,
+                         const Array<double> &b,
+                         const Array<double> &g,
+                         const Array<double> &bt,
+                         const Array<double> &gt,
+                         const Vector &d_,
+                         const Vector &x_,
+                         Vector &y_,
+                         const int d1d = 0,
+                         const int q1d = 0)
+{
+   constexpr int DIM = 3;
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto G = Reshape(g.Read(), Q1D, D1D);
+   auto Bt = Reshape(bt.Read(), D1D, Q1D);
+   auto Gt = Reshape(gt.Read(), D1D, Q1D);
+   auto D = Reshape(d_.Read(), Q1D*Q1D*Q1D, DIM*DIM+2, NE);
+   auto x = Reshape(x_.Read(), D1D, D1D, D1D, DIM, NE);
+   auto y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, DIM, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+
+      double grad[max_Q1D][max_Q1D][max_Q1D][DIM][DIM];
+      for (int c = 0; c < DIM; ++c)
+      {
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  grad[qz][qy][qx][c][0] = 0.0;
+                  grad[qz][qy][qx][c][1] = 0.0;
+                  grad[qz][qy][qx][c][2] = 0.0;
+               }
+            }
+         }
+         for (int dz = 0; dz < D1D; ++dz)
+         {
+            double gradXY[max_Q1D][max_Q1D][3];
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  gradXY[qy][qx][0] = 0.0;
+                  gradXY[qy][qx][1] = 0.0;
+                  gradXY[qy][qx][2] = 0.0;
+               }
+            }
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               double gradX[max_Q1D][2];
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  gradX[qx][0] = 0.0;
+                  gradX[qx][1] = 0.0;
+               }
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  const double s = x(dx,dy,dz,c,e);
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     gradX[qx][0] += s * B(qx,dx);
+                     gradX[qx][1] += s * G(qx,dx);
+                  }
+               }
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  const double wy  = B(qy,dy);
+                  const double wDy = G(qy,dy);
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     const double wx  = gradX[qx][0];
+                     const double wDx = gradX[qx][1];
+                     gradXY[qy][qx][0] += wDx * wy;
+                     gradXY[qy][qx][1] += wx  * wDy;
+                     gradXY[qy][qx][2] += wx  * wy;
+                  }
+               }
+            }
+            for (int qz = 0; qz < Q1D; ++qz)
+            {
+               const double wz  = B(qz,dz);
+               const double wDz = G(qz,dz);
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     grad[qz][qy][qx][c][0] += gradXY[qy][qx][0] * wz;
+                     grad[qz][qy][qx][c][1] += gradXY[qy][qx][1] * wz;
+                     grad[qz][qy][qx][c][2] += gradXY[qy][qx][2] * wDz;
+                  }
+               }
+            }
+         }
+      }
+      // Stress at the quadrature points, coupling the components
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const int q = qx + (qy + qz * Q1D) * Q1D;
+               double Jinv[DIM*DIM];
+               for (int i = 0; i < DIM*DIM; ++i) { Jinv[i] = D(q,i,e); }
+               PAElasticityStress<DIM>(Jinv, D(q,DIM*DIM,e),
+                                       D(q,DIM*DIM+1,e), grad[qz][qy][qx]);
+            }
+         }
+      }
+      for (int c = 0; c < DIM; ++c)
+      {
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            double gradXY[max_D1D][max_D1D][3];
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  gradXY[dy][dx][0] = 0;
+                  gradXY[dy][dx][1] = 0;
+                  gradXY[dy][dx][2] = 0;
+               }
+            }
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               double gradX[max_D1D][3];
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  gradX[dx][0] = 0;
+                  gradX[dx][1] = 0;
+                  gradX[dx][2] = 0;
+               }
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  const double gX = grad[qz][qy][qx][c][0];
+                  const double gY = grad[qz][qy][qx][c][1];
+                  const double gZ = grad[qz][qy][qx][c][2];
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     const double wx  = Bt(dx,qx);
+                     const double wDx = Gt(dx,qx);
+                     gradX[dx][0] += gX * wDx;
+                     gradX[dx][1] += gY * wx;
+                     gradX[dx][2] += gZ * wx;
+                  }
+               }
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  const double wy  = Bt(dy,qy);
+                  const double wDy = Gt(dy,qy);
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     gradXY[dy][dx][0] += gradX[dx][0] * wy;
+                     gradXY[dy][dx][1] += gradX[dx][1] * wDy;
+                     gradXY[dy][dx][2] += gradX[dx][2] * wy;
+                  }
+               }
+            }
+            for (int dz = 0; dz < D1D; ++dz)
+            {
+               const double wz  = Bt(dz,qz);
+               const double wDz = Gt(dz,qz);
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     y(dx,dy,dz,c,e) +=
+                        ((gradXY[dy][dx][0] * wz) +
+                         (gradXY[dy][dx][1] * wz) +
+                         (gradXY[dy][dx][2] * wDz));
+                  }
+               }
+            }
+         }
+      }
+   });
+}
+
+// PA Elasticity Apply kernel
+void ElasticityIntegrator::AddMultPA(const Vector &x, Vector &y) const
+{
+   if (ne == 0) { return; }
+   const int D1D = dofs1D;
+   const int Q1D = quad1D;
+   const Array<double> &B = maps->B;
+   const Array<double> &G = maps->G;
+   const Array<double> &Bt = maps->Bt;
+   const Array<double> &Gt = maps->Gt;
+   const Vector &D = pa_data;
+
+   if (dim == 2)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x22: return PAElasticityApply2D<2,2>(ne,B,G,Bt,Gt,D,x,y);
+         case 0x33: return PAElasticityApply2D<3,3>(ne,B,G,Bt,Gt,D,x,y);
+         case 0x44: return PAElasticityApply2D<4,4>(ne,B,G,Bt,Gt,D,x,y);
+         case 0x55: return PAElasticityApply2D<5,5>(ne,B,G,Bt,Gt,D,x,y);
+         default:
+            return PAElasticityApply2D(ne,B,G,Bt,Gt,D,x,y,D1D,Q1D);
+      }
+   }
+   if (dim == 3)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x23: return PAElasticityApply3D<2,3>(ne,B,G,Bt,Gt,D,x,y);
+         case 0x34: return PAElasticityApply3D<3,4>(ne,B,G,Bt,Gt,D,x,y);
+         case 0x45: return PAElasticityApply3D<4,5>(ne,B,G,Bt,Gt,D,x,y);
+         case 0x56: return PAElasticityApply3D<5,6>(ne,B,G,Bt,Gt,D,x,y);
+         default:
+            return PAElasticityApply3D(ne,B,G,Bt,Gt,D,x,y,D1D,Q1D);
+      }
+   }
+   MFEM_ABORT("Unknown kernel.");
+}
+
+/** Coefficient of the (k,l) reference gradient product in the diagonal entry
+    of component @a c at quadrature point @a q of element @a e:
+    (w_l + w_m) J^{-1}(k,c) J^{-1}(l,c) + w_m (J^{-1} J^{-T})(k,l). */
+template<int DIM> MFEM_HOST_DEVICE static inline
+double PAElasticityDiagonalCoeff(const DeviceTensor<3,const double> &D,
+                                 const int q, const int e, const int c,
+                                 const int k, const int l)
+{
+   const double wl = D(q,DIM*DIM,e);
+   const double wm = D(q,DIM*DIM+1,e);
+   double JJt = 0.0;
+   for (int d = 0; d < DIM; ++d)
+   {
+      JJt += D(q,k+DIM*d,e) * D(q,l+DIM*d,e);
+   }
+   return (wl + wm) * D(q,k+DIM*c,e) * D(q,l+DIM*c,e) + wm * JJt;
+}
+
+template<int T_D1D = 0, int T_Q1D = 0>
+static void PAElasticityDiagonal2D(const int NE,
+                                   const Array<double> &b,
+                                   const Array<double> &g,
+                                   const Vector &d,
+                                   Vector &y,
+                                   const int d1d = 0,
+                                   const int q1d = 0)
+{
+   constexpr int DIM = 2;
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto G = Reshape(g.Read(), Q1D, D1D);
+   auto D = Reshape(d.Read(), Q1D*Q1D, DIM*DIM+2, NE);
+   auto Y = Reshape(y.ReadWrite(), D1D, D1D, DIM, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
+      for (int c = 0; c < DIM; ++c)
+      {
+         // gradphi \cdot Q_c \gradphi has four terms
+         double QD0[MQ1][MD1];
+         double QD1[MQ1][MD1];
+         double QD2[MQ1][MD1];
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               QD0[qx][dy] = 0.0;
+               QD1[qx][dy] = 0.0;
+               QD2[qx][dy] = 0.0;
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  const int q = qx + qy * Q1D;
+                  const double D0 = PAElasticityDiagonalCoeff<DIM>(D,q,e,c,0,0);
+                  const double D1 = PAElasticityDiagonalCoeff<DIM>(D,q,e,c,0,1);
+                  const double D2 = PAElasticityDiagonalCoeff<DIM>(D,q,e,c,1,1);
+                  QD0[qx][dy] += B(qy, dy) * B(qy, dy) * D0;
+                  QD1[qx][dy] += B(qy, dy) * G(qy, dy) * D1;
+                  QD2[qx][dy] += G(qy, dy) * G(qy, dy) * D2;
+               }
+            }
+         }
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               double temp = 0.0;
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  temp += G(qx, dx) * G(qx, dx) * QD0[qx][dy];
+                  temp += G(qx, dx) * B(qx, dx) * QD1[qx][dy];
+                  temp += B(qx, dx) * G(qx, dx) * QD1[qx][dy];
+                  temp += B(qx, dx) * B(qx, dx) * QD2[qx][dy];
+               }
+               Y(dx,dy,c,e) += temp;
+            }
+         }
+      }
+   });
+}
+
+template<int T_D1D = 0, int T_Q1D = 0>
+static void PAElasticityDiagonal3D(const int NE,
+                                   const Array<double> &b,
+                                   const Array<double> &g,
+                                   const Vector &d,
+                                   Vector &y,
+                                   const int d1d = 0,
+                                   const int q1d = 0)
+{
+   constexpr int DIM = 3;
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int Q1D = T_Q1D ? T_Q1D : q1d;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(b.Read(), Q1D, D1D);
+   auto G = Reshape(g.Read(), Q1D, D1D);
+   auto D = Reshape(d.Read(), Q1D*Q1D*Q1D, DIM*DIM+2, NE);
+   auto Y = Reshape(y.ReadWrite(), D1D, D1D, D1D, DIM, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int Q1D = T_Q1D ? T_Q1D : q1d;
+      constexpr int MD1 = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
+      double QQD[MQ1][MQ1][MD1];
+      double QDD[MQ1][MD1][MD1];
+      for (int c = 0; c < DIM; ++c)
+      {
+         for (int i = 0; i < DIM; ++i)
+         {
+            for (int j = 0; j < DIM; ++j)
+            {
+               // first tensor contraction, along z direction
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  for (int qy = 0; qy < Q1D; ++qy)
+                  {
+                     for (int dz = 0; dz < D1D; ++dz)
+                     {
+                        QQD[qx][qy][dz] = 0.0;
+                        for (int qz = 0; qz < Q1D; ++qz)
+                        {
+                           const int q = qx + (qy + qz * Q1D) * Q1D;
+                           const double O =
+                              PAElasticityDiagonalCoeff<DIM>(D,q,e,c,i,j);
+                           const double Bz = B(qz,dz);
+                           const double Gz = G(qz,dz);
+                           const double L = i==2 ? Gz : Bz;
+                           const double R = j==2 ? Gz : Bz;
+                           QQD[qx][qy][dz] += L * O * R;
+                        }
+                     }
+                  }
+               }
+               // second tensor contraction, along y direction
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  for (int dz = 0; dz < D1D; ++dz)
+                  {
+                     for (int dy = 0; dy < D1D; ++dy)
+                     {
+                        QDD[qx][dy][dz] = 0.0;
+                        for (int qy = 0; qy < Q1D; ++qy)
+                        {
+                           const double By = B(qy,dy);
+                           const double Gy = G(qy,dy);
+                           const double L = i==1 ? Gy : By;
+                           const double R = j==1 ? Gy : By;
+                           QDD[qx][dy][dz] += L * QQD[qx][qy][dz] * R;
+                        }
+                     }
+                  }
+               }
+               // third tensor contraction, along x direction
+               for (int dz = 0; dz < D1D; ++dz)
+               {
+                  for (int dy = 0; dy < D1D; ++dy)
+                  {
+                     for (int dx = 0; dx < D1D; ++dx)
+                     {
+                        double temp = 0.0;
+                        for (int qx = 0; qx < Q1D; ++qx)
+                        {
+                           const double Bx = B(qx,dx);
+                           const double Gx = G(qx,dx);
+                           const double L = i==0 ? Gx : Bx;
+                           const double R = j==0 ? Gx : Bx;
+                           temp += L * QDD[qx][dy][dz] * R;
+                        }
+                        Y(dx,dy,dz,c,e) += temp;
+                     }
+                  }
+               }
+            }
+         }
+      }
+   });
+}
+
+void ElasticityIntegrator::AssembleDiagonalPA(Vector &diag)
+{
+   if (ne == 0) { return; }
+   const Array<double> &B = maps->B;
+   const Array<double> &G = maps->G;
+   if (dim == 2)
+   {
+      return PAElasticityDiagonal2D(ne, B, G, pa_data, diag, dofs1D, quad1D);
+   }
+   if (dim == 3)
+   {
+      return PAElasticityDiagonal3D(ne, B, G, pa_data, diag, dofs1D, quad1D);
+   }
+   MFEM_ABORT("Dimension not implemented.");
+}
+
+} // namespace mfem
@@ -650,17 +650,13 @@ void CurlCurlIntegrator::AssemblePA(const FiniteElementSpace &fes)
    pa_data.SetSize(ndata * nq * ne, Device::GetMemoryType());
 
    Vector coeff(ne * nq);
-   coeff = 1.0;
    if (Q)
    {
-      for (int e=0; e<ne; ++e)
-      {
-         ElementTransformation *tr = mesh->GetElementTransformation(e);
-         for (int p=0; p<nq; ++p)
-         {
-            coeff[p + (e * nq)] = Q->Eval(*tr, ir->IntPoint(p));
-         }
-      }
+      Q->EvalQuadrature(coeff, *mesh, *ir);
+   }
+   else
+   {
+      coeff = 1.0;
    }
 
    if (el->GetDerivType() == mfem::FiniteElement::CURL && dim == 3)
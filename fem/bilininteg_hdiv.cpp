@@ -927,17 +927,13 @@ void DivDivIntegrator::AssemblePA(const FiniteElementSpace &fes)
    pa_data.SetSize(nq * ne, Device::GetMemoryType());
 
    Vector coeff(ne * nq);
-   coeff = 1.0;
    if (Q)
    {
-      for (int e=0; e<ne; ++e)
-      {
-         ElementTransformation *tr = mesh->GetElementTransformation(e);
-         for (int p=0; p<nq; ++p)
-         {
-            coeff[p + (e * nq)] = Q->Eval(*tr, ir->IntPoint(p));
-         }
-      }
+      Q->EvalQuadrature(coeff, *mesh, *ir);
+   }
+   else
+   {
+      coeff = 1.0;
    }
 
    if (el->GetDerivType() == mfem::FiniteElement::DIV && dim == 3)
@@ -1196,17 +1192,13 @@ VectorFEDivergenceIntegrator::AssemblePA(const FiniteElementSpace &trial_fes,
    pa_data.SetSize(nq * ne, Device::GetMemoryType());
 
    Vector coeff(ne * nq);
-   coeff = 1.0;
    if (Q)
    {
-      for (int e=0; e<ne; ++e)
-      {
-         ElementTransformation *tr = mesh->GetElementTransformation(e);
-         for (int p=0; p<nq; ++p)
-         {
-            coeff[p + (e * nq)] = Q->Eval(*tr, ir->IntPoint(p));
-         }
-      }
+      Q->EvalQuadrature(coeff, *mesh, *ir);
+   }
+   else
+   {
+      coeff = 1.0;
    }
 
    if (trial_el->GetDerivType() == mfem::FiniteElement::DIV && dim == 3)
@@ -203,6 +203,8 @@ void MassIntegrator::AssembleEA(const FiniteElementSpace &fes,
                                 Vector &ea_data)
 {
    AssemblePA(fes);
+   MFEM_VERIFY(pa_groups.Size() == 0, "AssemblyLevel::ELEMENT requires"
+               " tensor-product elements");
    const int ne = fes.GetMesh()->GetNE();
    const Array<double> &B = maps->B;
    if (dim == 1)
@@ -22,6 +22,55 @@ namespace mfem
 // PA Mass Integrator
 
 // PA Mass Assemble kernel
+static void PAMassSetup(const int dim,
+                        const int NQ,
+                        const int NE,
+                        const Array<double> &w,
+                        const Vector &j,
+                        const Vector &c,
+                        Vector &d)
+{
+   if (dim==1) { MFEM_ABORT("Not supported yet... stay tuned!"); }
+   const bool const_c = c.Size() == 1;
+   auto W = w.Read();
+   auto C = const_c ? Reshape(c.Read(), 1,1) : Reshape(c.Read(), NQ,NE);
+   auto v = Reshape(d.Write(), NQ, NE);
+   if (dim==2)
+   {
+      auto J = Reshape(j.Read(), NQ,2,2,NE);
+      MFEM_FORALL(e, NE,
+      {
+         for (int q = 0; q < NQ; ++q)
+         {
+            const double J11 = J(q,0,0,e);
+            const double J12 = J(q,1,0,e);
+            const double J21 = J(q,0,1,e);
+            const double J22 = J(q,1,1,e);
+            const double detJ = (J11*J22)-(J21*J12);
+            const double coeff = const_c ? C(0,0) : C(q,e);
+            v(q,e) =  W[q] * coeff * detJ;
+         }
+      });
+   }
+   if (dim==3)
+   {
+      auto J = Reshape(j.Read(), NQ,3,3,NE);
+      MFEM_FORALL(e, NE,
+      {
+         for (int q = 0; q < NQ; ++q)
+         {
+            const double J11 = J(q,0,0,e), J12 = J(q,0,1,e), J13 = J(q,0,2,e);
+            const double J21 = J(q,1,0,e), J22 = J(q,1,1,e), J23 = J(q,1,2,e);
+            const double J31 = J(q,2,0,e), J32 = J(q,2,1,e), J33 = J(q,2,2,e);
+            const double detJ = J11 * (J22 * J33 - J32 * J23) -
+            /* */               J21 * (J12 * J33 - J32 * J13) +
+            /* */               J31 * (J12 * J23 - J22 * J13);
+            const double coeff = const_c ? C(0,0) : C(q,e);
+            v(q,e) = W[q] * coeff * detJ;
+         }
+      });
+   }
+}
 
 void MassIntegrator::SetupPA(const FiniteElementSpace &fes, const bool force)
 {
@@ -29,6 +78,12 @@ void MassIntegrator::SetupPA(const FiniteElementSpace &fes, const bool force)
    fespace = &fes;
    Mesh *mesh = fes.GetMesh();
    if (mesh->GetNE() == 0) { return; }
+   if (!UsesTensorBasis(fes))
+   {
+      SetupPAGroups(fes);
+      return;
+   }
+   PAGeometryGroup::DeleteGroups(pa_groups);
    const FiniteElement &el = *fes.GetFE(0);
    ElementTransformation *T = mesh->GetElementTransformation(0);
    const IntegrationRule *ir = IntRule ? IntRule : &GetRule(el, el, *T);
@@ -64,67 +119,9 @@ void MassIntegrator::SetupPA(const FiniteElementSpace &fes, const bool force)
    }
    else
    {
-      coeff.SetSize(nq * ne);
-      auto C = Reshape(coeff.HostWrite(), nq, ne);
-      for (int e = 0; e < ne; ++e)
-      {
-         ElementTransformation& T = *fes.GetElementTransformation(e);
-         for (int q = 0; q < nq; ++q)
-         {
-            C(q,e) = Q->Eval(T, ir->IntPoint(q));
-         }
-      }
-   }
-   if (dim==1) { MFEM_ABORT("Not supported yet... stay tuned!"); }
-   if (dim==2)
-   {
-      const int NE = ne;
-      const int NQ = nq;
-      const bool const_c = coeff.Size() == 1;
-      auto w = ir->GetWeights().Read();
-      auto J = Reshape(geom->J.Read(), NQ,2,2,NE);
-      auto C =
-         const_c ? Reshape(coeff.Read(), 1,1) : Reshape(coeff.Read(), NQ,NE);
-      auto v = Reshape(pa_data.Write(), NQ, NE);
-      MFEM_FORALL(e, NE,
-      {
-         for (int q = 0; q < NQ; ++q)
-         {
-            const double J11 = J(q,0,0,e);
-            const double J12 = J(q,1,0,e);
-            const double J21 = J(q,0,1,e);
-            const double J22 = J(q,1,1,e);
-            const double detJ = (J11*J22)-(J21*J12);
-            const double coeff = const_c ? C(0,0) : C(q,e);
-            v(q,e) =  w[q] * coeff * detJ;
-         }
-      });
-   }
-   if (dim==3)
-   {
-      const int NE = ne;
-      const int NQ = nq;
-      const bool const_c = coeff.Size() == 1;
-      auto W = ir->GetWeights().Read();
-      auto J = Reshape(geom->J.Read(), NQ,3,3,NE);
-      auto C =
-         const_c ? Reshape(coeff.Read(), 1,1) : Reshape(coeff.Read(), NQ,NE);
-      auto v = Reshape(pa_data.Write(), NQ,NE);
-      MFEM_FORALL(e, NE,
-      {
-         for (int q = 0; q < NQ; ++q)
-         {
-            const double J11 = J(q,0,0,e), J12 = J(q,0,1,e), J13 = J(q,0,2,e);
-            const double J21 = J(q,1,0,e), J22 = J(q,1,1,e), J23 = J(q,1,2,e);
-            const double J31 = J(q,2,0,e), J32 = J(q,2,1,e), J33 = J(q,2,2,e);
-            const double detJ = J11 * (J22 * J33 - J32 * J23) -
-            /* */               J21 * (J12 * J33 - J32 * J13) +
-            /* */               J31 * (J12 * J23 - J22 * J13);
-            const double coeff = const_c ? C(0,0) : C(q,e);
-            v(q,e) = W[q] * coeff * detJ;
-         }
-      });
+      Q->EvalQuadrature(coeff, *mesh, *ir);
    }
+   PAMassSetup(dim, nq, ne, ir->GetWeights(), geom->J, coeff, pa_data);
 }
 
 void MassIntegrator::AssemblePA(const FiniteElementSpace &fes)
@@ -440,6 +437,7 @@ static void PAMassAssembleDiagonal(const int dim, const int D1D,
 
 void MassIntegrator::AssembleDiagonalPA(Vector &diag)
 {
+   if (pa_groups.Size() > 0) { return AssembleDiagonalPAGroups(diag); }
    if (pa_data.Size()==0) { SetupPA(*fespace, true); }
    PAMassAssembleDiagonal(dim, dofs1D, quad1D, ne, maps->B, pa_data, diag);
 }
@@ -539,6 +537,8 @@ static void OccaPAMassApply3D(const int D1D,
 
 template<int T_D1D = 0, int T_Q1D = 0>
 static void PAMassApply2D(const int NE,
+                          const int *elems,
+                          const int NS,
                           const Array<double> &b_,
                           const Array<double> &bt_,
                           const Vector &d_,
@@ -556,8 +556,9 @@ static void PAMassApply2D(const int NE,
    auto D = Reshape(d_.Read(), Q1D, Q1D, NE);
    auto X = Reshape(x_.Read(), D1D, D1D, NE);
    auto Y = Reshape(y_.ReadWrite(), D1D, D1D, NE);
-   MFEM_FORALL(e, NE,
+   MFEM_FORALL(i_e, NS,
    {
+      const int e = elems ? elems[i_e] : i_e;
       const int D1D = T_D1D ? T_D1D : d1d; // nvcc workaround
       const int Q1D = T_Q1D ? T_Q1D : q1d;
       // the following variables are evaluated at compile time
@@ -631,6 +632,8 @@ static void PAMassApply2D(const int NE,
 
 template<int T_D1D = 0, int T_Q1D = 0, int T_NBZ = 0>
 static void SmemPAMassApply2D(const int NE,
+                              const int *elems,
+                              const int NS,
                               const Array<double> &b_,
                               const Array<double> &bt_,
                               const Vector &d_,
@@ -650,8 +653,9 @@ static void SmemPAMassApply2D(const int NE,
    auto D = Reshape(d_.Read(), Q1D, Q1D, NE);
    auto x = Reshape(x_.Read(), D1D, D1D, NE);
    auto Y = Reshape(y_.ReadWrite(), D1D, D1D, NE);
-   MFEM_FORALL_2D(e, NE, Q1D, Q1D, NBZ,
+   MFEM_FORALL_2D(i_e, NS, Q1D, Q1D, NBZ,
    {
+      const int e = elems ? elems[i_e] : i_e;
       const int tidz = MFEM_THREAD_ID(z);
       const int D1D = T_D1D ? T_D1D : d1d;
       const int Q1D = T_Q1D ? T_Q1D : q1d;
@@ -753,6 +757,8 @@ static void SmemPAMassApply2D(const int NE,
 
 template<int T_D1D = 0, int T_Q1D = 0>
 static void PAMassApply3D(const int NE,
+                          const int *elems,
+                          const int NS,
                           const Array<double> &b_,
                           const Array<double> &bt_,
                           const Vector &d_,
@@ -770,8 +776,9 @@ static void PAMassApply3D(const int NE,
    auto D = Reshape(d_.Read(), Q1D, Q1D, Q1D, NE);
    auto X = Reshape(x_.Read(), D1D, D1D, D1D, NE);
    auto Y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE);
-   MFEM_FORALL(e, NE,
+   MFEM_FORALL(i_e, NS,
    {
+      const int e = elems ? elems[i_e] : i_e;
       const int D1D = T_D1D ? T_D1D : d1d;
       const int Q1D = T_Q1D ? T_Q1D : q1d;
       constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
@@ -894,6 +901,8 @@ static void PAMassApply3D(const int NE,
 
 template<int T_D1D = 0, int T_Q1D = 0>
 static void SmemPAMassApply3D(const int NE,
+                              const int *elems,
+                              const int NS,
                               const Array<double> &b_,
                               const Array<double> &bt_,
                               const Vector &d_,
@@ -912,8 +921,9 @@ static void SmemPAMassApply3D(const int NE,
    auto d = Reshape(d_.Read(), Q1D, Q1D, Q1D, NE);
    auto x = Reshape(x_.Read(), D1D, D1D, D1D, NE);
    auto y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE);
-   MFEM_FORALL_3D(e, NE, Q1D, Q1D, 1,
+   MFEM_FORALL_3D(i_e, NS, Q1D, Q1D, 1,
    {
+      const int e = elems ? elems[i_e] : i_e;
       const int D1D = T_D1D ? T_D1D : d1d;
       const int Q1D = T_Q1D ? T_Q1D : q1d;
       constexpr int MQ1 = T_Q1D ? T_Q1D : MAX_Q1D;
@@ -1122,6 +1132,8 @@ static void PAMassApply(const int dim,
                         const int D1D,
                         const int Q1D,
                         const int NE,
+                        const int *elems,
+                        const int NS,
                         const Array<double> &B,
                         const Array<double> &Bt,
                         const Vector &D,
@@ -1131,6 +1143,8 @@ static void PAMassApply(const int dim,
 #ifdef MFEM_USE_OCCA
    if (DeviceCanUseOcca())
    {
+      MFEM_VERIFY(elems == nullptr, "OCCA PA Mass Apply: element subsets are"
+                  " not supported");
       if (dim == 2)
       {
          return OccaPAMassApply2D(D1D,Q1D,NE,B,Bt,D,X,Y);
@@ -1147,40 +1161,40 @@ static void PAMassApply(const int dim,
    {
       switch (id)
       {
-         case 0x22: return SmemPAMassApply2D<2,2,16>(NE,B,Bt,D,X,Y);
-         case 0x24: return SmemPAMassApply2D<2,4,16>(NE,B,Bt,D,X,Y);
-         case 0x33: return SmemPAMassApply2D<3,3,16>(NE,B,Bt,D,X,Y);
-         case 0x34: return SmemPAMassApply2D<3,4,16>(NE,B,Bt,D,X,Y);
-         case 0x36: return SmemPAMassApply2D<3,6,16>(NE,B,Bt,D,X,Y);
-         case 0x44: return SmemPAMassApply2D<4,4,8>(NE,B,Bt,D,X,Y);
-         case 0x48: return SmemPAMassApply2D<4,8,4>(NE,B,Bt,D,X,Y);
-         case 0x55: return SmemPAMassApply2D<5,5,8>(NE,B,Bt,D,X,Y);
-         case 0x58: return SmemPAMassApply2D<5,8,2>(NE,B,Bt,D,X,Y);
-         case 0x66: return SmemPAMassApply2D<6,6,4>(NE,B,Bt,D,X,Y);
-         case 0x77: return SmemPAMassApply2D<7,7,4>(NE,B,Bt,D,X,Y);
-         case 0x88: return SmemPAMassApply2D<8,8,2>(NE,B,Bt,D,X,Y);
-         case 0x99: return SmemPAMassApply2D<9,9,2>(NE,B,Bt,D,X,Y);
-         default:   return PAMassApply2D(NE,B,Bt,D,X,Y,D1D,Q1D);
+         case 0x22: return SmemPAMassApply2D<2,2,16>(NE,elems,NS,B,Bt,D,X,Y);
+         case 0x24: return SmemPAMassApply2D<2,4,16>(NE,elems,NS,B,Bt,D,X,Y);
+         case 0x33: return SmemPAMassApply2D<3,3,16>(NE,elems,NS,B,Bt,D,X,Y);
+         case 0x34: return SmemPAMassApply2D<3,4,16>(NE,elems,NS,B,Bt,D,X,Y);
+         case 0x36: return SmemPAMassApply2D<3,6,16>(NE,elems,NS,B,Bt,D,X,Y);
+         case 0x44: return SmemPAMassApply2D<4,4,8>(NE,elems,NS,B,Bt,D,X,Y);
+         case 0x48: return SmemPAMassApply2D<4,8,4>(NE,elems,NS,B,Bt,D,X,Y);
+         case 0x55: return SmemPAMassApply2D<5,5,8>(NE,elems,NS,B,Bt,D,X,Y);
+         case 0x58: return SmemPAMassApply2D<5,8,2>(NE,elems,NS,B,Bt,D,X,Y);
+         case 0x66: return SmemPAMassApply2D<6,6,4>(NE,elems,NS,B,Bt,D,X,Y);
+         case 0x77: return SmemPAMassApply2D<7,7,4>(NE,elems,NS,B,Bt,D,X,Y);
+         case 0x88: return SmemPAMassApply2D<8,8,2>(NE,elems,NS,B,Bt,D,X,Y);
+         case 0x99: return SmemPAMassApply2D<9,9,2>(NE,elems,NS,B,Bt,D,X,Y);
+         default:   return PAMassApply2D(NE,elems,NS,B,Bt,D,X,Y,D1D,Q1D);
       }
    }
    else if (dim == 3)
    {
       switch (id)
       {
-         case 0x23: return SmemPAMassApply3D<2,3>(NE,B,Bt,D,X,Y);
-         case 0x24: return SmemPAMassApply3D<2,4>(NE,B,Bt,D,X,Y);
-         case 0x34: return SmemPAMassApply3D<3,4>(NE,B,Bt,D,X,Y);
-         case 0x36: return SmemPAMassApply3D<3,6>(NE,B,Bt,D,X,Y);
-         case 0x45: return SmemPAMassApply3D<4,5>(NE,B,Bt,D,X,Y);
-         case 0x46: return SmemPAMassApply3D<4,6>(NE,B,Bt,D,X,Y);
-         case 0x48: return SmemPAMassApply3D<4,8>(NE,B,Bt,D,X,Y);
-         case 0x56: return SmemPAMassApply3D<5,6>(NE,B,Bt,D,X,Y);
-         case 0x58: return SmemPAMassApply3D<5,8>(NE,B,Bt,D,X,Y);
-         case 0x67: return SmemPAMassApply3D<6,7>(NE,B,Bt,D,X,Y);
-         case 0x78: return SmemPAMassApply3D<7,8>(NE,B,Bt,D,X,Y);
-         case 0x89: return SmemPAMassApply3D<8,9>(NE,B,Bt,D,X,Y);
-         case 0x9A: return SmemPAMassApply3D<9,10>(NE,B,Bt,D,X,Y);
-         default:   return PAMassApply3D(NE,B,Bt,D,X,Y,D1D,Q1D);
+         case 0x23: return SmemPAMassApply3D<2,3>(NE,elems,NS,B,Bt,D,X,Y);
+         case 0x24: return SmemPAMassApply3D<2,4>(NE,elems,NS,B,Bt,D,X,Y);
+         case 0x34: return SmemPAMassApply3D<3,4>(NE,elems,NS,B,Bt,D,X,Y);
+         case 0x36: return SmemPAMassApply3D<3,6>(NE,elems,NS,B,Bt,D,X,Y);
+         case 0x45: return SmemPAMassApply3D<4,5>(NE,elems,NS,B,Bt,D,X,Y);
+         case 0x46: return SmemPAMassApply3D<4,6>(NE,elems,NS,B,Bt,D,X,Y);
+         case 0x48: return SmemPAMassApply3D<4,8>(NE,elems,NS,B,Bt,D,X,Y);
+         case 0x56: return SmemPAMassApply3D<5,6>(NE,elems,NS,B,Bt,D,X,Y);
+         case 0x58: return SmemPAMassApply3D<5,8>(NE,elems,NS,B,Bt,D,X,Y);
+         case 0x67: return SmemPAMassApply3D<6,7>(NE,elems,NS,B,Bt,D,X,Y);
+         case 0x78: return SmemPAMassApply3D<7,8>(NE,elems,NS,B,Bt,D,X,Y);
+         case 0x89: return SmemPAMassApply3D<8,9>(NE,elems,NS,B,Bt,D,X,Y);
+         case 0x9A: return SmemPAMassApply3D<9,10>(NE,elems,NS,B,Bt,D,X,Y);
+         default:   return PAMassApply3D(NE,elems,NS,B,Bt,D,X,Y,D1D,Q1D);
       }
    }
    mfem::out << "Unknown kernel 0x" << std::hex << id << std::endl;
@@ -1189,6 +1203,7 @@ static void PAMassApply(const int dim,
 
 void MassIntegrator::AddMultPA(const Vector &x, Vector &y) const
 {
+   if (pa_groups.Size() > 0) { return AddMultPAGroups(x, y); }
 #ifdef MFEM_USE_CEED
    if (DeviceCanUseCeed())
    {
@@ -1219,7 +1234,217 @@ void MassIntegrator::AddMultPA(const Vector &x, Vector &y) const
    else
 #endif
    {
-      PAMassApply(dim, dofs1D, quad1D, ne, maps->B, maps->Bt, pa_data, x, y);
+      PAMassApply(dim, dofs1D, quad1D, ne, nullptr, ne,
+                  maps->B, maps->Bt, pa_data, x, y);
+   }
+}
+
+bool MassIntegrator::SupportsPAElementSubsets() const
+{
+#ifdef MFEM_USE_OCCA
+   if (DeviceCanUseOcca()) { return false; }
+#endif
+   return pa_groups.Size() == 0 && !DeviceCanUseCeed();
+}
+
+void MassIntegrator::AddMultPAElements(const Array<int> &elems,
+                                       const Vector &x, Vector &y) const
+{
+   MFEM_VERIFY(SupportsPAElementSubsets(), "not supported");
+   PAMassApply(dim, dofs1D, quad1D, ne, elems.Read(), elems.Size(),
+               maps->B, maps->Bt, pa_data, x, y);
+}
+
+// MF Mass Integrator
+
+void MassIntegrator::AssembleMF(const FiniteElementSpace &fes)
+{
+   // Assuming the same element type
+   fespace = &fes;
+   Mesh *mesh = fes.GetMesh();
+   dim = mesh->Dimension();
+   ne = fes.GetNE();
+   delete mf_geom;
+   mf_geom = NULL;
+   if (ne == 0) { return; }
+   const FiniteElement &el = *fes.GetFE(0);
+   ElementTransformation *T = mesh->GetElementTransformation(0);
+   const IntegrationRule *ir = IntRule ? IntRule : &GetRule(el, el, *T);
+   nq = ir->GetNPoints();
+   maps = &el.GetDofToQuad(*ir, DofToQuad::TENSOR);
+   dofs1D = maps->ndof;
+   quad1D = maps->nqpt;
+   mf_geom = new BatchedGeometricFactors(mesh, *ir);
+   if (Q == nullptr)
+   {
+      mf_coeff.SetSize(1);
+      mf_coeff(0) = 1.0;
+   }
+   else if (ConstantCoefficient* cQ = dynamic_cast<ConstantCoefficient*>(Q))
+   {
+      mf_coeff.SetSize(1);
+      mf_coeff(0) = cQ->constant;
+   }
+   else
+   {
+      Q->EvalQuadrature(mf_coeff, *mesh, *ir);
+   }
+}
+
+// Compute the PA quadrature data of the elements [e0, e0+nb) into D.
+static void MFMassSetupBatch(const BatchedGeometricFactors &geom,
+                             const int e0, const int nb, const int dim,
+                             const Vector &coeff, Vector &J, Vector &D)
+{
+   const IntegrationRule &ir = geom.GetIntRule();
+   const int nq = ir.GetNPoints();
+   Vector C;
+   if (coeff.Size() == 1) { C.MakeRef(const_cast<Vector&>(coeff), 0, 1); }
+   else { C.MakeRef(const_cast<Vector&>(coeff), e0*nq, nb*nq); }
+   geom.ComputeJacobians(e0, nb, J);
+   D.SetSize(nq * nb, Device::GetDeviceMemoryType());
+   PAMassSetup(dim, nq, nb, ir.GetWeights(), J, C, D);
+}
+
+void MassIntegrator::AssembleDiagonalMF(Vector &diag)
+{
+   if (ne == 0) { return; }
+   const int ND = diag.Size() / ne;
+   Vector Yb;
+   for (int b = 0; b < mf_geom->GetNumBatches(); b++)
+   {
+      int e0, nb;
+      mf_geom->GetBatch(b, e0, nb);
+      MFMassSetupBatch(*mf_geom, e0, nb, dim, mf_coeff, mf_J, mf_data);
+      Yb.MakeRef(diag, e0*ND, nb*ND);
+      PAMassAssembleDiagonal(dim, dofs1D, quad1D, nb, maps->B, mf_data, Yb);
+   }
+}
+
+void MassIntegrator::AddMultMF(const Vector &x, Vector &y) const
+{
+   if (ne == 0) { return; }
+   const int ND = x.Size() / ne;
+   Vector Xb, Yb;
+   for (int b = 0; b < mf_geom->GetNumBatches(); b++)
+   {
+      int e0, nb;
+      mf_geom->GetBatch(b, e0, nb);
+      MFMassSetupBatch(*mf_geom, e0, nb, dim, mf_coeff, mf_J, mf_data);
+      Xb.MakeRef(const_cast<Vector&>(x), e0*ND, nb*ND);
+      Yb.MakeRef(y, e0*ND, nb*ND);
+      PAMassApply(dim, dofs1D, quad1D, nb, nullptr, nb,
+                  maps->B, maps->Bt, mf_data, Xb, Yb);
+   }
+}
+
+
+// PA Mass Integrator on simplicial and mixed meshes
+
+void MassIntegrator::SetupPAGroups(const FiniteElementSpace &fes)
+{
+   Mesh *mesh = fes.GetMesh();
+   dim = mesh->Dimension();
+   ne = fes.GetNE();
+   MFEM_VERIFY(mesh->SpaceDimension() == dim, "surface meshes are not"
+               " supported with non-tensor partial assembly");
+   PAGeometryGroup::DeleteGroups(pa_groups);
+   PAGeometryGroup::MakeGroups(fes, pa_groups);
+   MFEM_VERIFY(IntRule == NULL || pa_groups.Size() == 1,
+               "a single IntegrationRule cannot be used on mixed meshes");
+   Vector J, coeff;
+   for (int i = 0; i < pa_groups.Size(); i++)
+   {
+      PAGeometryGroup &group = *pa_groups[i];
+      const int ng = group.elements.Size();
+      const FiniteElement &el = *fes.GetFE(group.elements[0]);
+      ElementTransformation &T0 =
+         *mesh->GetElementTransformation(group.elements[0]);
+      const IntegrationRule *ir = IntRule ? IntRule : &GetRule(el, el, T0);
+      const int nq = ir->GetNPoints();
+      group.maps = &el.GetDofToQuad(*ir, DofToQuad::FULL);
+      const Vector &gJ = group.GetJacobians(*mesh, *ir, J);
+      group.EvalCoefficient(Q, *mesh, *ir, coeff);
+      group.pa_data.SetSize(nq * ng, Device::GetDeviceMemoryType());
+      PAMassSetup(dim, nq, ng, ir->GetWeights(), gJ, coeff, group.pa_data);
+      group.qvec.SetSize(nq * ng, Device::GetDeviceMemoryType());
+   }
+}
+
+// Non-tensor PA mass apply kernel for the elements of one geometry group.
+// The E-vectors have NDE (the largest number of element dofs) rows.
+static void PAMassApplyGroup(const int NDE,
+                             const int NE,
+                             const PAGeometryGroup &group,
+                             const Vector &x,
+                             Vector &y)
+{
+   const int NG = group.elements.Size();
+   const int ND = group.maps->ndof;
+   const int NQ = group.maps->nqpt;
+   auto E = group.elements.Read();
+   auto B = Reshape(group.maps->B.Read(), NQ, ND);
+   auto D = Reshape(group.pa_data.Read(), NQ, NG);
+   auto X = Reshape(x.Read(), NDE, NE);
+   auto U = Reshape(group.qvec.Write(), NQ, NG);
+   MFEM_FORALL(i, NQ*NG,
+   {
+      const int q = i % NQ;
+      const int k = i / NQ;
+      const int e = E[k];
+      double u = 0.0;
+      for (int d = 0; d < ND; ++d) { u += B(q,d) * X(d,e); }
+      U(q,k) = D(q,k) * u;
+   });
+   auto V = Reshape(group.qvec.Read(), NQ, NG);
+   auto Y = Reshape(y.ReadWrite(), NDE, NE);
+   MFEM_FORALL(i, ND*NG,
+   {
+      const int d = i % ND;
+      const int k = i / ND;
+      double s = 0.0;
+      for (int q = 0; q < NQ; ++q) { s += B(q,d) * V(q,k); }
+      Y(d,E[k]) += s;
+   });
+}
+
+static void PAMassDiagonalGroup(const int NDE,
+                                const int NE,
+                                const PAGeometryGroup &group,
+                                Vector &y)
+{
+   const int NG = group.elements.Size();
+   const int ND = group.maps->ndof;
+   const int NQ = group.maps->nqpt;
+   auto E = group.elements.Read();
+   auto B = Reshape(group.maps->B.Read(), NQ, ND);
+   auto D = Reshape(group.pa_data.Read(), NQ, NG);
+   auto Y = Reshape(y.ReadWrite(), NDE, NE);
+   MFEM_FORALL(i, ND*NG,
+   {
+      const int d = i % ND;
+      const int k = i / ND;
+      double s = 0.0;
+      for (int q = 0; q < NQ; ++q) { s += B(q,d) * B(q,d) * D(q,k); }
+      Y(d,E[k]) += s;
+   });
+}
+
+void MassIntegrator::AddMultPAGroups(const Vector &x, Vector &y) const
+{
+   const int nde = PAGeometryGroup::MaxDofs(pa_groups);
+   for (int i = 0; i < pa_groups.Size(); i++)
+   {
+      PAMassApplyGroup(nde, ne, *pa_groups[i], x, y);
+   }
+}
+
+void MassIntegrator::AssembleDiagonalPAGroups(Vector &diag) const
+{
+   const int nde = PAGeometryGroup::MaxDofs(pa_groups);
+   for (int i = 0; i < pa_groups.Size(); i++)
+   {
+      PAMassDiagonalGroup(nde, ne, *pa_groups[i], diag);
    }
 }
 
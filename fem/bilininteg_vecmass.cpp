@@ -38,26 +38,72 @@ void VectorMassIntegrator::AssemblePA(const FiniteElementSpace &fes)
    maps = &el.GetDofToQuad(*ir, DofToQuad::TENSOR);
    dofs1D = maps->ndof;
    quad1D = maps->nqpt;
-   pa_data.SetSize(ne*nq, Device::GetDeviceMemoryType());
-   double coeff = 1.0;
-   if (Q)
-   {
-      ConstantCoefficient *cQ = dynamic_cast<ConstantCoefficient*>(Q);
-      MFEM_VERIFY(cQ != NULL, "Only ConstantCoefficient is supported.");
-      coeff = cQ->constant;
-   }
    if (!(dim == 2 || dim == 3))
    {
       MFEM_ABORT("Dimension not supported.");
    }
+   // Coefficient values at the quadrature points, with layout (NQ, NC, NE),
+   // where NC is 1 for a scalar coefficient, dim for a diagonal (vector)
+   // coefficient and dim*dim for a matrix coefficient (column-major).
+   Vector coeff;
+   pa_ncomp = 1;
+   if (VQ || MQ)
+   {
+      const int cdim = VQ ? VQ->GetVDim() : MQ->GetVDim();
+      MFEM_VERIFY(cdim == dim, "The coefficient size must match the"
+                  " dimension.");
+      pa_ncomp = VQ ? dim : dim * dim;
+      coeff.SetSize(nq * pa_ncomp * ne);
+      auto C = Reshape(coeff.HostWrite(), nq, pa_ncomp, ne);
+      Vector Vq(dim);
+      DenseMatrix Mq(dim);
+      for (int e = 0; e < ne; ++e)
+      {
+         ElementTransformation &Tr = *mesh->GetElementTransformation(e);
+         for (int q = 0; q < nq; ++q)
+         {
+            const IntegrationPoint &ip = ir->IntPoint(q);
+            Tr.SetIntPoint(&ip);
+            if (VQ)
+            {
+               VQ->Eval(Vq, Tr, ip);
+               for (int c = 0; c < dim; ++c) { C(q,c,e) = Vq(c); }
+               continue;
+            }
+            MQ->Eval(Mq, Tr, ip);
+            for (int j = 0; j < dim; ++j)
+            {
+               for (int i = 0; i < dim; ++i) { C(q,i+dim*j,e) = Mq(i,j); }
+            }
+         }
+      }
+   }
+   else if (Q == NULL)
+   {
+      coeff.SetSize(1);
+      coeff(0) = 1.0;
+   }
+   else if (ConstantCoefficient *cQ = dynamic_cast<ConstantCoefficient*>(Q))
+   {
+      coeff.SetSize(1);
+      coeff(0) = cQ->constant;
+   }
+   else
+   {
+      Q->EvalQuadrature(coeff, *mesh, *ir);
+   }
+   pa_data.SetSize(ne*nq*pa_ncomp, Device::GetDeviceMemoryType());
+   const bool const_c = coeff.Size() == 1;
+   const int NE = ne;
+   const int NQ = nq;
+   const int NC = pa_ncomp;
+   auto W = ir->GetWeights().Read();
+   auto C = const_c ? Reshape(coeff.Read(), 1, 1, 1) :
+            Reshape(coeff.Read(), NQ, NC, NE);
+   auto v = Reshape(pa_data.Write(), NQ, NC, NE);
    if (dim == 2)
    {
-      const double constant = coeff;
-      const int NE = ne;
-      const int NQ = nq;
-      auto w = ir->GetWeights().Read();
       auto J = Reshape(geom->J.Read(), NQ,2,2,NE);
-      auto v = Reshape(pa_data.Write(), NQ, NE);
       MFEM_FORALL(e, NE,
       {
          for (int q = 0; q < NQ; ++q)
@@ -67,18 +113,17 @@ void VectorMassIntegrator::AssemblePA(const FiniteElementSpace &fes)
             const double J21 = J(q,0,1,e);
             const double J22 = J(q,1,1,e);
             const double detJ = (J11*J22)-(J21*J12);
-            v(q,e) =  w[q] * constant * detJ;
+            for (int c = 0; c < NC; ++c)
+            {
+               const double cq = const_c ? C(0,0,0) : C(q,c,e);
+               v(q,c,e) = W[q] * cq * detJ;
+            }
          }
       });
    }
    if (dim == 3)
    {
-      const double constant = coeff;
-      const int NE = ne;
-      const int NQ = nq;
-      auto W = ir->GetWeights().Read();
       auto J = Reshape(geom->J.Read(), NQ,3,3,NE);
-      auto v = Reshape(pa_data.Write(), NQ,NE);
       MFEM_FORALL(e, NE,
       {
          for (int q = 0; q < NQ; ++q)
@@ -89,7 +134,11 @@ void VectorMassIntegrator::AssemblePA(const FiniteElementSpace &fes)
             const double detJ = J11 * (J22 * J33 - J32 * J23) -
             /* */               J21 * (J12 * J33 - J32 * J13) +
             /* */               J31 * (J12 * J23 - J22 * J13);
-            v(q,e) = W[q] * constant * detJ;
+            for (int c = 0; c < NC; ++c)
+            {
+               const double cq = const_c ? C(0,0,0) : C(q,c,e);
+               v(q,c,e) = W[q] * cq * detJ;
+            }
          }
       });
    }
@@ -98,6 +147,7 @@ void VectorMassIntegrator::AssemblePA(const FiniteElementSpace &fes)
 template<const int T_D1D = 0,
          const int T_Q1D = 0>
 static void PAVectorMassApply2D(const int NE,
+                                const int NC,
                                 const Array<double> &_B,
                                 const Array<double> &_Bt,
                                 const Vector &_op,
@@ -113,7 +163,7 @@ static void PAVectorMassApply2D(const int NE,
    MFEM_VERIFY(Q1D <= MAX_Q1D, "");
    auto B = Reshape(_B.Read(), Q1D, D1D);
    auto Bt = Reshape(_Bt.Read(), D1D, Q1D);
-   auto op = Reshape(_op.Read(), Q1D, Q1D, NE);
+   auto op = Reshape(_op.Read(), Q1D, Q1D, NC, NE);
    auto x = Reshape(_x.Read(), D1D, D1D, VDIM, NE);
    auto y = Reshape(_y.ReadWrite(), D1D, D1D, VDIM, NE);
    MFEM_FORALL(e, NE,
@@ -126,6 +176,7 @@ static void PAVectorMassApply2D(const int NE,
       double sol_xy[max_Q1D][max_Q1D];
       for (int c = 0; c < VDIM; ++c)
       {
+         const int oc = (NC == 1) ? 0 : c;
          for (int qy = 0; qy < Q1D; ++qy)
          {
             for (int qx = 0; qx < Q1D; ++qx)
@@ -161,7 +212,7 @@ static void PAVectorMassApply2D(const int NE,
          {
             for (int qx = 0; qx < Q1D; ++qx)
             {
-               sol_xy[qy][qx] *= op(qx,qy,e);
+               sol_xy[qy][qx] *= op(qx,qy,oc,e);
             }
          }
          for (int qy = 0; qy < Q1D; ++qy)
@@ -195,6 +246,7 @@ static void PAVectorMassApply2D(const int NE,
 template<const int T_D1D = 0,
          const int T_Q1D = 0>
 static void PAVectorMassApply3D(const int NE,
+                                const int NC,
                                 const Array<double> &_B,
                                 const Array<double> &_Bt,
                                 const Vector &_op,
@@ -210,7 +262,7 @@ static void PAVectorMassApply3D(const int NE,
    MFEM_VERIFY(Q1D <= MAX_Q1D, "");
    auto B = Reshape(_B.Read(), Q1D, D1D);
    auto Bt = Reshape(_Bt.Read(), D1D, Q1D);
-   auto op = Reshape(_op.Read(), Q1D, Q1D, Q1D, NE);
+   auto op = Reshape(_op.Read(), Q1D, Q1D, Q1D, NC, NE);
    auto x = Reshape(_x.Read(), D1D, D1D, D1D, VDIM, NE);
    auto y = Reshape(_y.ReadWrite(), D1D, D1D, D1D, VDIM, NE);
    MFEM_FORALL(e, NE,
@@ -222,6 +274,7 @@ static void PAVectorMassApply3D(const int NE,
       double sol_xyz[max_Q1D][max_Q1D][max_Q1D];
       for (int c = 0; c < VDIM; ++ c)
       {
+         const int oc = (NC == 1) ? 0 : c;
          for (int qz = 0; qz < Q1D; ++qz)
          {
             for (int qy = 0; qy < Q1D; ++qy)
@@ -284,7 +337,7 @@ static void PAVectorMassApply3D(const int NE,
             {
                for (int qx = 0; qx < Q1D; ++qx)
                {
-                  sol_xyz[qz][qy][qx] *= op(qx,qy,qz,e);
+                  sol_xyz[qz][qy][qx] *= op(qx,qy,qz,oc,e);
                }
             }
          }
@@ -338,7 +391,262 @@ static void PAVectorMassApply3D(const int NE,
    });
 }
 
+// PA Vector Mass Apply 2D kernel with a full VDIM x VDIM matrix coefficient
+static void PAVectorMassApplyMatrix2D(const int NE,
+                                      const Array<double> &_B,
+                                      const Array<double> &_Bt,
+                                      const Vector &_op,
+                                      const Vector &_x,
+                                      Vector &_y,
+                                      const int D1D,
+                                      const int Q1D)
+{
+   constexpr int VDIM = 2;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(_B.Read(), Q1D, D1D);
+   auto Bt = Reshape(_Bt.Read(), D1D, Q1D);
+   auto op = Reshape(_op.Read(), Q1D, Q1D, VDIM, VDIM, NE);
+   auto x = Reshape(_x.Read(), D1D, D1D, VDIM, NE);
+   auto y = Reshape(_y.ReadWrite(), D1D, D1D, VDIM, NE);
+   MFEM_FORALL(e, NE,
+   {
+      constexpr int max_D1D = MAX_D1D;
+      constexpr int max_Q1D = MAX_Q1D;
+      double sol_xy[VDIM][max_Q1D][max_Q1D];
+      for (int c = 0; c < VDIM; ++c)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               sol_xy[c][qy][qx] = 0.0;
+            }
+         }
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            double sol_x[max_Q1D];
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               sol_x[qx] = 0.0;
+            }
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               const double s = x(dx,dy,c,e);
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  sol_x[qx] += B(qx,dx) * s;
+               }
+            }
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               const double d2q = B(qy,dy);
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  sol_xy[c][qy][qx] += d2q * sol_x[qx];
+               }
+            }
+         }
+      }
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            const double u0 = sol_xy[0][qy][qx];
+            const double u1 = sol_xy[1][qy][qx];
+            sol_xy[0][qy][qx] = op(qx,qy,0,0,e)*u0 + op(qx,qy,0,1,e)*u1;
+            sol_xy[1][qy][qx] = op(qx,qy,1,0,e)*u0 + op(qx,qy,1,1,e)*u1;
+         }
+      }
+      for (int c = 0; c < VDIM; ++c)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            double sol_x[max_D1D];
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               sol_x[dx] = 0.0;
+            }
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const double s = sol_xy[c][qy][qx];
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  sol_x[dx] += Bt(dx,qx) * s;
+               }
+            }
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               const double q2d = Bt(dy,qy);
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  y(dx,dy,c,e) += q2d * sol_x[dx];
+               }
+            }
+         }
+      }
+   });
+}
+
+// PA Vector Mass Apply 3D kernel with a full VDIM x VDIM matrix coefficient
+static void PAVectorMassApplyMatrix3D(const int NE,
+                                      const Array<double> &_B,
+                                      const Array<double> &_Bt,
+                                      const Vector &_op,
+                                      const Vector &_x,
+                                      Vector &_y,
+                                      const int D1D,
+                                      const int Q1D)
+{
+   constexpr int VDIM = 3;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(Q1D <= MAX_Q1D, "");
+   auto B = Reshape(_B.Read(), Q1D, D1D);
+   auto Bt = Reshape(_Bt.Read(), D1D, Q1D);
+   auto op = Reshape(_op.Read(), Q1D, Q1D, Q1D, VDIM, VDIM, NE);
+   auto x = Reshape(_x.Read(), D1D, D1D, D1D, VDIM, NE);
+   auto y = Reshape(_y.ReadWrite(), D1D, D1D, D1D, VDIM, NE);
+   MFEM_FORALL(e, NE,
+   {
+      constexpr int max_D1D = MAX_D1D;
+      constexpr int max_Q1D = MAX_Q1D;
+      double sol_xyz[VDIM][max_Q1D][max_Q1D][max_Q1D];
+      for (int c = 0; c < VDIM; ++c)
+      {
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  sol_xyz[c][qz][qy][qx] = 0.0;
+               }
+            }
+         }
+         for (int dz = 0; dz < D1D; ++dz)
+         {
+            double sol_xy[max_Q1D][max_Q1D];
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  sol_xy[qy][qx] = 0.0;
+               }
+            }
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               double sol_x[max_Q1D];
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  sol_x[qx] = 0;
+               }
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  const double s = x(dx,dy,dz,c,e);
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     sol_x[qx] += B(qx,dx) * s;
+                  }
+               }
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  const double wy = B(qy,dy);
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     sol_xy[qy][qx] += wy * sol_x[qx];
+                  }
+               }
+            }
+            for (int qz = 0; qz < Q1D; ++qz)
+            {
+               const double wz = B(qz,dz);
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     sol_xyz[c][qz][qy][qx] += wz * sol_xy[qy][qx];
+                  }
+               }
+            }
+         }
+      }
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               double u[VDIM];
+               for (int c = 0; c < VDIM; ++c)
+               {
+                  u[c] = sol_xyz[c][qz][qy][qx];
+               }
+               for (int i = 0; i < VDIM; ++i)
+               {
+                  double v = 0.0;
+                  for (int j = 0; j < VDIM; ++j)
+                  {
+                     v += op(qx,qy,qz,i,j,e) * u[j];
+                  }
+                  sol_xyz[i][qz][qy][qx] = v;
+               }
+            }
+         }
+      }
+      for (int c = 0; c < VDIM; ++c)
+      {
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            double sol_xy[max_D1D][max_D1D];
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  sol_xy[dy][dx] = 0;
+               }
+            }
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               double sol_x[max_D1D];
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  sol_x[dx] = 0;
+               }
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  const double s = sol_xyz[c][qz][qy][qx];
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     sol_x[dx] += Bt(dx,qx) * s;
+                  }
+               }
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  const double wy = Bt(dy,qy);
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     sol_xy[dy][dx] += wy * sol_x[dx];
+                  }
+               }
+            }
+            for (int dz = 0; dz < D1D; ++dz)
+            {
+               const double wz = Bt(dz,qz);
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     y(dx,dy,dz,c,e) += wz * sol_xy[dy][dx];
+                  }
+               }
+            }
+         }
+      }
+   });
+}
+
 static void PAVectorMassApply(const int dim,
+                              const int NC,
                               const int D1D,
                               const int Q1D,
                               const int NE,
@@ -350,22 +658,32 @@ static void PAVectorMassApply(const int dim,
 {
    if (dim == 2)
    {
-      return PAVectorMassApply2D(NE, B, Bt, op, x, y, D1D, Q1D);
+      if (NC == 4)
+      {
+         return PAVectorMassApplyMatrix2D(NE, B, Bt, op, x, y, D1D, Q1D);
+      }
+      return PAVectorMassApply2D(NE, NC, B, Bt, op, x, y, D1D, Q1D);
    }
    if (dim == 3)
    {
-      return PAVectorMassApply3D(NE, B, Bt, op, x, y, D1D, Q1D);
+      if (NC == 9)
+      {
+         return PAVectorMassApplyMatrix3D(NE, B, Bt, op, x, y, D1D, Q1D);
+      }
+      return PAVectorMassApply3D(NE, NC, B, Bt, op, x, y, D1D, Q1D);
    }
    MFEM_ABORT("Unknown kernel.");
 }
 
 void VectorMassIntegrator::AddMultPA(const Vector &x, Vector &y) const
 {
-   PAVectorMassApply(dim, dofs1D, quad1D, ne, maps->B, maps->Bt, pa_data, x, y);
+   PAVectorMassApply(dim, pa_ncomp, dofs1D, quad1D, ne, maps->B, maps->Bt,
+                     pa_data, x, y);
 }
 
 template<const int T_D1D = 0, const int T_Q1D = 0>
 static void PAVectorMassAssembleDiagonal2D(const int NE,
+                                           const int NC,
                                            const Array<double> &_B,
                                            const Array<double> &_Bt,
                                            const Vector &_op,
@@ -379,7 +697,7 @@ static void PAVectorMassAssembleDiagonal2D(const int NE,
    MFEM_VERIFY(D1D <= MAX_D1D, "");
    MFEM_VERIFY(Q1D <= MAX_Q1D, "");
    auto B = Reshape(_B.Read(), Q1D, D1D);
-   auto op = Reshape(_op.Read(), Q1D, Q1D, NE);
+   auto op = Reshape(_op.Read(), Q1D, Q1D, NC, NE);
    auto y = Reshape(_diag.ReadWrite(), D1D, D1D, VDIM, NE);
    MFEM_FORALL(e, NE,
    {
@@ -388,29 +706,43 @@ static void PAVectorMassAssembleDiagonal2D(const int NE,
       constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
       constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
 
-      double temp[max_Q1D][max_D1D];
-      for (int qx = 0; qx < Q1D; ++qx)
+      // a scalar coefficient gives the same diagonal for all components
+      const int NCD = (NC == 1) ? 1 : VDIM;
+      for (int c = 0; c < NCD; ++c)
       {
-         for (int dy = 0; dy < D1D; ++dy)
+         // index of the c-th diagonal entry of the coefficient
+         const int oc = (NC == VDIM*VDIM) ? c*(VDIM+1) : c;
+         double temp[max_Q1D][max_D1D];
+         for (int qx = 0; qx < Q1D; ++qx)
          {
-            temp[qx][dy] = 0.0;
-            for (int qy = 0; qy < Q1D; ++qy)
+            for (int dy = 0; dy < D1D; ++dy)
             {
-               temp[qx][dy] += B(qy, dy) * B(qy, dy) * op(qx, qy, e);
+               temp[qx][dy] = 0.0;
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  temp[qx][dy] += B(qy, dy) * B(qy, dy) * op(qx, qy, oc, e);
+               }
             }
          }
-      }
-      for (int dy = 0; dy < D1D; ++dy)
-      {
-         for (int dx = 0; dx < D1D; ++dx)
+         for (int dy = 0; dy < D1D; ++dy)
          {
-            double temp1 = 0.0;
-            for (int qx = 0; qx < Q1D; ++qx)
+            for (int dx = 0; dx < D1D; ++dx)
             {
-               temp1 += B(qx, dx) * B(qx, dx) * temp[qx][dy];
+               double temp1 = 0.0;
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  temp1 += B(qx, dx) * B(qx, dx) * temp[qx][dy];
+               }
+               if (NC == 1)
+               {
+                  y(dx, dy, 0, e) = temp1;
+                  y(dx, dy, 1, e) = temp1;
+               }
+               else
+               {
+                  y(dx, dy, c, e) = temp1;
+               }
             }
-            y(dx, dy, 0, e) = temp1;
-            y(dx, dy, 1, e) = temp1;
          }
       }
    });
@@ -418,6 +750,7 @@ static void PAVectorMassAssembleDiagonal2D(const int NE,
 
 template<const int T_D1D = 0, const int T_Q1D = 0>
 static void PAVectorMassAssembleDiagonal3D(const int NE,
+                                           const int NC,
                                            const Array<double> &_B,
                                            const Array<double> &_Bt,
                                            const Vector &_op,
@@ -431,7 +764,7 @@ static void PAVectorMassAssembleDiagonal3D(const int NE,
    MFEM_VERIFY(D1D <= MAX_D1D, "");
    MFEM_VERIFY(Q1D <= MAX_Q1D, "");
    auto B = Reshape(_B.Read(), Q1D, D1D);
-   auto op = Reshape(_op.Read(), Q1D, Q1D, Q1D, NE);
+   auto op = Reshape(_op.Read(), Q1D, Q1D, Q1D, NC, NE);
    auto y = Reshape(_diag.ReadWrite(), D1D, D1D, D1D, VDIM, NE);
    MFEM_FORALL(e, NE,
    {
@@ -441,51 +774,67 @@ static void PAVectorMassAssembleDiagonal3D(const int NE,
       constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
       constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
 
-      double temp[max_Q1D][max_Q1D][max_D1D];
-      for (int qx = 0; qx < Q1D; ++qx)
+      // a scalar coefficient gives the same diagonal for all components
+      const int NCD = (NC == 1) ? 1 : VDIM;
+      for (int c = 0; c < NCD; ++c)
       {
-         for (int qy = 0; qy < Q1D; ++qy)
+         // index of the c-th diagonal entry of the coefficient
+         const int oc = (NC == VDIM*VDIM) ? c*(VDIM+1) : c;
+         double temp[max_Q1D][max_Q1D][max_D1D];
+         for (int qx = 0; qx < Q1D; ++qx)
          {
-            for (int dz = 0; dz < D1D; ++dz)
+            for (int qy = 0; qy < Q1D; ++qy)
             {
-               temp[qx][qy][dz] = 0.0;
-               for (int qz = 0; qz < Q1D; ++qz)
+               for (int dz = 0; dz < D1D; ++dz)
                {
-                  temp[qx][qy][dz] += B(qz, dz) * B(qz, dz) * op(qx, qy, qz, e);
+                  temp[qx][qy][dz] = 0.0;
+                  for (int qz = 0; qz < Q1D; ++qz)
+                  {
+                     temp[qx][qy][dz] +=
+                        B(qz, dz) * B(qz, dz) * op(qx, qy, qz, oc, e);
+                  }
                }
             }
          }
-      }
-      double temp2[max_Q1D][max_D1D][max_D1D];
-      for (int qx = 0; qx < Q1D; ++qx)
-      {
-         for (int dz = 0; dz < D1D; ++dz)
+         double temp2[max_Q1D][max_D1D][max_D1D];
+         for (int qx = 0; qx < Q1D; ++qx)
          {
-            for (int dy = 0; dy < D1D; ++dy)
+            for (int dz = 0; dz < D1D; ++dz)
             {
-               temp2[qx][dy][dz] = 0.0;
-               for (int qy = 0; qy < Q1D; ++qy)
+               for (int dy = 0; dy < D1D; ++dy)
                {
-                  temp2[qx][dy][dz] += B(qy, dy) * B(qy, dy) * temp[qx][qy][dz];
+                  temp2[qx][dy][dz] = 0.0;
+                  for (int qy = 0; qy < Q1D; ++qy)
+                  {
+                     temp2[qx][dy][dz] +=
+                        B(qy, dy) * B(qy, dy) * temp[qx][qy][dz];
+                  }
                }
             }
          }
-      }
-      for (int dz = 0; dz < D1D; ++dz)
-      {
-         for (int dy = 0; dy < D1D; ++dy)
+         for (int dz = 0; dz < D1D; ++dz)
          {
-            for (int dx = 0; dx < D1D; ++dx)
+            for (int dy = 0; dy < D1D; ++dy)
             {
-               double temp3 = 0.0;
-               for (int qx = 0; qx < Q1D; ++qx)
+               for (int dx = 0; dx < D1D; ++dx)
                {
-                  temp3 += B(qx, dx) * B(qx, dx)
-                           * temp2[qx][dy][dz];
+                  double temp3 = 0.0;
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     temp3 += B(qx, dx) * B(qx, dx)
+                              * temp2[qx][dy][dz];
+                  }
+                  if (NC == 1)
+                  {
+                     y(dx, dy, dz, 0, e) = temp3;
+                     y(dx, dy, dz, 1, e) = temp3;
+                     y(dx, dy, dz, 2, e) = temp3;
+                  }
+                  else
+                  {
+                     y(dx, dy, dz, c, e) = temp3;
+                  }
                }
-               y(dx, dy, dz, 0, e) = temp3;
-               y(dx, dy, dz, 1, e) = temp3;
-               y(dx, dy, dz, 2, e) = temp3;
             }
          }
       }
@@ -493,6 +842,7 @@ static void PAVectorMassAssembleDiagonal3D(const int NE,
 }
 
 static void PAVectorMassAssembleDiagonal(const int dim,
+                                         const int NC,
                                          const int D1D,
                                          const int Q1D,
                                          const int NE,
@@ -503,11 +853,11 @@ static void PAVectorMassAssembleDiagonal(const int dim,
 {
    if (dim == 2)
    {
-      return PAVectorMassAssembleDiagonal2D(NE, B, Bt, op, y, D1D, Q1D);
+      return PAVectorMassAssembleDiagonal2D(NE, NC, B, Bt, op, y, D1D, Q1D);
    }
    else if (dim == 3)
    {
-      return PAVectorMassAssembleDiagonal3D(NE, B, Bt, op, y, D1D, Q1D);
+      return PAVectorMassAssembleDiagonal3D(NE, NC, B, Bt, op, y, D1D, Q1D);
    }
    MFEM_ABORT("Dimension not implemented.");
 }
@@ -515,6 +865,7 @@ static void PAVectorMassAssembleDiagonal(const int dim,
 void VectorMassIntegrator::AssembleDiagonalPA(Vector &diag)
 {
    PAVectorMassAssembleDiagonal(dim,
+                                pa_ncomp,
                                 dofs1D,
                                 quad1D,
                                 ne,
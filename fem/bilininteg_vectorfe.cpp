@@ -173,17 +173,13 @@ void VectorFEMassIntegrator::AssemblePA(const FiniteElementSpace &fes)
    pa_data.SetSize(symmDims * nq * ne, Device::GetMemoryType());
 
    Vector coeff(ne * nq);
-   coeff = 1.0;
    if (Q)
    {
-      for (int e=0; e<ne; ++e)
-      {
-         ElementTransformation *tr = mesh->GetElementTransformation(e);
-         for (int p=0; p<nq; ++p)
-         {
-            coeff[p + (e * nq)] = Q->Eval(*tr, ir->IntPoint(p));
-         }
-      }
+      Q->EvalQuadrature(coeff, *mesh, *ir);
+   }
+   else
+   {
+      coeff = 1.0;
    }
 
    fetype = el->GetDerivType();
@@ -332,17 +328,13 @@ void MixedVectorGradientIntegrator::AssemblePA(const FiniteElementSpace
    pa_data.SetSize(symmDims * nq * ne, Device::GetMemoryType());
 
    Vector coeff(ne * nq);
-   coeff = 1.0;
    if (Q)
    {
-      for (int e=0; e<ne; ++e)
-      {
-         ElementTransformation *tr = mesh->GetElementTransformation(e);
-         for (int p=0; p<nq; ++p)
-         {
-            coeff[p + (e * nq)] = Q->Eval(*tr, ir->IntPoint(p));
-         }
-      }
+      Q->EvalQuadrature(coeff, *mesh, *ir);
+   }
+   else
+   {
+      coeff = 1.0;
    }
 
    // Use the same setup functions as VectorFEMassIntegrator.
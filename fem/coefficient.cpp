@@ -12,6 +12,7 @@
 // Implementation of Coefficient class
 
 #include "fem.hpp"
+#include "../general/forall.hpp"
 
 #include <cmath>
 #include <limits>
@@ -28,6 +29,100 @@ double PWConstCoefficient::Eval(ElementTransformation & T,
    return (constants(att-1));
 }
 
+void Coefficient::EvalQuadrature(Vector &qcoeff, Mesh &mesh,
+                                 const IntegrationRule &ir)
+{
+   const int ne = mesh.GetNE();
+   const int nq = ir.GetNPoints();
+   qcoeff.SetSize(nq * ne);
+   auto C = Reshape(qcoeff.HostWrite(), nq, ne);
+   for (int e = 0; e < ne; ++e)
+   {
+      ElementTransformation &T = *mesh.GetElementTransformation(e);
+      for (int q = 0; q < nq; ++q)
+      {
+         const IntegrationPoint &ip = ir.IntPoint(q);
+         T.SetIntPoint(&ip);
+         C(q,e) = Eval(T, ip);
+      }
+   }
+}
+
+void Coefficient::EvalBdrFaceQuadrature(Vector &qcoeff, Mesh &mesh,
+                                        const IntegrationRule &ir)
+{
+   const int dim = mesh.Dimension();
+   const int nf = mesh.GetNFbyType(FaceType::Boundary);
+   const int nq = ir.GetNPoints();
+   const int q1d = (dim == 2) ? nq : (int) floor(sqrt(double(nq)) + 0.5);
+   Array<int> face_be(mesh.GetNumFaces());
+   face_be = -1;
+   for (int i = 0; i < mesh.GetNBE(); i++)
+   {
+      face_be[mesh.GetBdrElementEdgeIndex(i)] = i;
+   }
+   qcoeff.SetSize(nq * nf);
+   auto C = Reshape(qcoeff.HostWrite(), nq, nf);
+   int f_ind = 0;
+   for (int f = 0; f < mesh.GetNumFaces(); ++f)
+   {
+      int e1, e2;
+      int inf1, inf2;
+      mesh.GetFaceElements(f, &e1, &e2);
+      mesh.GetFaceInfos(f, &inf1, &inf2);
+      if (e2 >= 0 || inf2 >= 0) { continue; }
+      const int face_id = inf1 / 64;
+      ElementTransformation &T = *mesh.GetFaceTransformation(f);
+      if (face_be[f] >= 0) { T.Attribute = mesh.GetBdrAttribute(face_be[f]); }
+      for (int q = 0; q < nq; ++q)
+      {
+         const IntegrationPoint &ip = ir.IntPoint(q);
+         T.SetIntPoint(&ip);
+         C(ToLexOrdering(dim, face_id, q1d, q), f_ind) = Eval(T, ip);
+      }
+      f_ind++;
+   }
+   MFEM_VERIFY(f_ind == nf, "Incorrect number of faces.");
+}
+
+void ConstantCoefficient::EvalQuadrature(Vector &qcoeff, Mesh &mesh,
+                                         const IntegrationRule &ir)
+{
+   const int N = ir.GetNPoints() * mesh.GetNE();
+   const double c = constant;
+   qcoeff.SetSize(N);
+   auto C = qcoeff.Write();
+   MFEM_FORALL(i, N, C[i] = c;);
+}
+
+void ConstantCoefficient::EvalBdrFaceQuadrature(Vector &qcoeff, Mesh &mesh,
+                                                const IntegrationRule &ir)
+{
+   const int N = ir.GetNPoints() * mesh.GetNFbyType(FaceType::Boundary);
+   const double c = constant;
+   qcoeff.SetSize(N);
+   auto C = qcoeff.Write();
+   MFEM_FORALL(i, N, C[i] = c;);
+}
+
+void PWConstCoefficient::EvalQuadrature(Vector &qcoeff, Mesh &mesh,
+                                        const IntegrationRule &ir)
+{
+   const int ne = mesh.GetNE();
+   const int nq = ir.GetNPoints();
+   Array<int> attr(ne);
+   for (int e = 0; e < ne; ++e) { attr[e] = mesh.GetAttribute(e); }
+   qcoeff.SetSize(nq * ne);
+   auto A = attr.Read();
+   auto c = constants.Read();
+   auto C = Reshape(qcoeff.Write(), nq, ne);
+   MFEM_FORALL(e, ne,
+   {
+      const double val = c[A[e]-1];
+      for (int q = 0; q < nq; ++q) { C(q,e) = val; }
+   });
+}
+
 double FunctionCoefficient::Eval(ElementTransformation & T,
                                  const IntegrationPoint & ip)
 {
@@ -52,6 +147,99 @@ double GridFunctionCoefficient::Eval (ElementTransformation &T,
    return GridF -> GetValue (T, ip, Component);
 }
 
+void GridFunctionCoefficient::EvalQuadrature(Vector &qcoeff, Mesh &mesh,
+                                             const IntegrationRule &ir)
+{
+   const FiniteElementSpace &fes = *GridF->FESpace();
+   const int ne = mesh.GetNE();
+   const int dim = mesh.Dimension();
+   const int vdim = fes.GetVDim();
+   const FiniteElement *fe = (ne > 0) ? fes.GetFE(0) : NULL;
+   // The QuadratureInterpolator requires a single element type and supports
+   // only value-based scalar elements in 2D and 3D with at most 'dim'
+   // components; use the generic point-wise evaluation otherwise.
+   const bool batched =
+      fe && fes.GetMesh() == &mesh && fes.GetNURBSext() == NULL &&
+      (dim == 2 || dim == 3) && mesh.GetNumGeometries(dim) == 1 &&
+      (vdim == 1 || vdim == dim) &&
+      fe->GetRangeType() == FiniteElement::SCALAR &&
+      fe->GetMapType() == FiniteElement::VALUE &&
+      QuadratureInterpolator::SupportsByNodesLayout(dim, fe->GetDof(),
+                                                    ir.GetNPoints());
+   if (!batched)
+   {
+      Coefficient::EvalQuadrature(qcoeff, mesh, ir);
+      return;
+   }
+
+   const ElementDofOrdering ordering = ElementDofOrdering::NATIVE;
+   const Operator *R = fes.GetElementRestriction(ordering);
+   const QuadratureInterpolator *qi = fes.GetQuadratureInterpolator(ir);
+   qi->SetOutputLayout(QVectorLayout::byNODES);
+   Vector e_vec(R->Height(), Device::GetDeviceMemoryType());
+   e_vec.UseDevice(true);
+   R->Mult(*GridF, e_vec);
+
+   const int nq = ir.GetNPoints();
+   qcoeff.SetSize(nq * ne);
+   if (vdim == 1)
+   {
+      qi->Values(e_vec, qcoeff);
+      return;
+   }
+   Vector q_val(nq * vdim * ne, Device::GetDeviceMemoryType());
+   q_val.UseDevice(true);
+   qi->Values(e_vec, q_val);
+   const int comp = Component - 1;
+   auto V = Reshape(q_val.Read(), nq, vdim, ne);
+   auto C = Reshape(qcoeff.Write(), nq, ne);
+   MFEM_FORALL(i, nq * ne, C(i % nq, i / nq) = V(i % nq, comp, i / nq););
+}
+
+void GridFunctionCoefficient::EvalBdrFaceQuadrature(Vector &qcoeff, Mesh &mesh,
+                                                    const IntegrationRule &ir)
+{
+   const FiniteElementSpace &fes = *GridF->FESpace();
+   const int nf = mesh.GetNFbyType(FaceType::Boundary);
+   const int dim = mesh.Dimension();
+   const FiniteElement *fe = (nf > 0) ? fes.GetFE(0) : NULL;
+   const TensorBasisElement *tfe = dynamic_cast<const TensorBasisElement*>(fe);
+   // The FaceQuadratureInterpolator requires the lexicographic face
+   // restriction of a scalar H1 space of Gauss-Lobatto or Bernstein
+   // tensor-product elements on a conforming mesh.
+   bool batched =
+      tfe && fes.GetMesh() == &mesh && fes.GetNURBSext() == NULL &&
+      (dim == 2 || dim == 3) && mesh.GetNumGeometries(dim) == 1 &&
+      mesh.Conforming() && fes.GetVDim() == 1 &&
+      dynamic_cast<const H1_FECollection*>(fes.FEColl()) &&
+      (tfe->GetBasisType() == BasisType::GaussLobatto ||
+       tfe->GetBasisType() == BasisType::Positive);
+   if (batched)
+   {
+      const FiniteElement &tr_fe =
+         *fes.GetTraceElement(0, mesh.GetFaceBaseGeometry(0));
+      const DofToQuad &maps = tr_fe.GetDofToQuad(ir, DofToQuad::TENSOR);
+      batched = FaceQuadratureInterpolator::SupportsSizes(maps.ndof,
+                                                          maps.nqpt);
+   }
+   if (!batched)
+   {
+      Coefficient::EvalBdrFaceQuadrature(qcoeff, mesh, ir);
+      return;
+   }
+
+   const Operator *R =
+      fes.GetFaceRestriction(ElementDofOrdering::LEXICOGRAPHIC,
+                             FaceType::Boundary, L2FaceValues::SingleValued);
+   const FaceQuadratureInterpolator *qi =
+      fes.GetFaceQuadratureInterpolator(ir, FaceType::Boundary);
+   Vector f_vec(R->Height(), Device::GetDeviceMemoryType());
+   f_vec.UseDevice(true);
+   R->Mult(*GridF, f_vec);
+   qcoeff.SetSize(ir.GetNPoints() * nf);
+   qi->Values(f_vec, qcoeff);
+}
+
 double TransformedCoefficient::Eval(ElementTransformation &T,
                                     const IntegrationPoint &ip)
 {
@@ -101,6 +289,38 @@ void VectorCoefficient::Eval(DenseMatrix &M, ElementTransformation &T,
    }
 }
 
+void VectorCoefficient::EvalQuadrature(Vector &qcoeff, Mesh &mesh,
+                                       const IntegrationRule &ir)
+{
+   const int ne = mesh.GetNE();
+   const int nq = ir.GetNPoints();
+   qcoeff.SetSize(vdim * nq * ne);
+   auto C = Reshape(qcoeff.HostWrite(), vdim, nq, ne);
+   Vector V(vdim);
+   for (int e = 0; e < ne; ++e)
+   {
+      ElementTransformation &T = *mesh.GetElementTransformation(e);
+      for (int q = 0; q < nq; ++q)
+      {
+         const IntegrationPoint &ip = ir.IntPoint(q);
+         T.SetIntPoint(&ip);
+         Eval(V, T, ip);
+         for (int c = 0; c < vdim; ++c) { C(c,q,e) = V(c); }
+      }
+   }
+}
+
+void VectorConstantCoefficient::EvalQuadrature(Vector &qcoeff, Mesh &mesh,
+                                               const IntegrationRule &ir)
+{
+   const int VDIM = vdim;
+   const int N = ir.GetNPoints() * mesh.GetNE();
+   qcoeff.SetSize(VDIM * N);
+   auto v = vec.Read();
+   auto C = Reshape(qcoeff.Write(), VDIM, N);
+   MFEM_FORALL(i, VDIM * N, C(i % VDIM, i / VDIM) = v[i % VDIM];);
+}
+
 void VectorFunctionCoefficient::Eval(Vector &V, ElementTransformation &T,
                                      const IntegrationPoint &ip)
 {
@@ -183,6 +403,53 @@ void VectorGridFunctionCoefficient::Eval(
    GridFunc->GetVectorValues(T, ir, M);
 }
 
+void VectorGridFunctionCoefficient::EvalQuadrature(Vector &qcoeff, Mesh &mesh,
+                                                   const IntegrationRule &ir)
+{
+   const FiniteElementSpace &fes = *GridFunc->FESpace();
+   const int ne = mesh.GetNE();
+   const int dim = mesh.Dimension();
+   const FiniteElement *fe = (ne > 0) ? fes.GetFE(0) : NULL;
+   // Same restrictions as in GridFunctionCoefficient::EvalQuadrature(), with
+   // a vector space of exactly 'vdim' components.
+   const bool batched =
+      fe && fes.GetMesh() == &mesh && fes.GetNURBSext() == NULL &&
+      (dim == 2 || dim == 3) && mesh.GetNumGeometries(dim) == 1 &&
+      fes.GetVDim() == vdim && (vdim == 1 || vdim == dim) &&
+      fe->GetRangeType() == FiniteElement::SCALAR &&
+      fe->GetMapType() == FiniteElement::VALUE &&
+      QuadratureInterpolator::SupportsByNodesLayout(dim, fe->GetDof(),
+                                                    ir.GetNPoints());
+   if (!batched)
+   {
+      VectorCoefficient::EvalQuadrature(qcoeff, mesh, ir);
+      return;
+   }
+
+   const ElementDofOrdering ordering = ElementDofOrdering::NATIVE;
+   const Operator *R = fes.GetElementRestriction(ordering);
+   const QuadratureInterpolator *qi = fes.GetQuadratureInterpolator(ir);
+   qi->SetOutputLayout(QVectorLayout::byNODES);
+   Vector e_vec(R->Height(), Device::GetDeviceMemoryType());
+   e_vec.UseDevice(true);
+   R->Mult(*GridFunc, e_vec);
+
+   const int nq = ir.GetNPoints();
+   const int VDIM = vdim;
+   Vector q_val(nq * VDIM * ne, Device::GetDeviceMemoryType());
+   q_val.UseDevice(true);
+   qi->Values(e_vec, q_val);
+   qcoeff.SetSize(VDIM * nq * ne);
+   auto V = Reshape(q_val.Read(), nq, VDIM, ne);
+   auto C = Reshape(qcoeff.Write(), VDIM, nq, ne);
+   MFEM_FORALL(i, nq * ne,
+   {
+      const int q = i % nq;
+      const int e = i / nq;
+      for (int c = 0; c < VDIM; ++c) { C(c,q,e) = V(q,c,e); }
+   });
+}
+
 GradientGridFunctionCoefficient::GradientGridFunctionCoefficient (
    const GridFunction *gf)
    : VectorCoefficient((gf) ?
@@ -373,6 +640,44 @@ void MatrixRestrictedCoefficient::Eval(DenseMatrix &K, ElementTransformation &T,
    }
 }
 
+void SumCoefficient::EvalQuadrature(Vector &qcoeff, Mesh &mesh,
+                                    const IntegrationRule &ir)
+{
+   b->EvalQuadrature(qcoeff, mesh, ir);
+   const int N = qcoeff.Size();
+   const double al = alpha, be = beta;
+   auto C = qcoeff.ReadWrite();
+   if (a == NULL)
+   {
+      const double ac = alpha * aConst;
+      MFEM_FORALL(i, N, C[i] = ac + be * C[i];);
+      return;
+   }
+   Vector qa;
+   a->EvalQuadrature(qa, mesh, ir);
+   auto A = qa.Read();
+   MFEM_FORALL(i, N, C[i] = al * A[i] + be * C[i];);
+}
+
+void ProductCoefficient::EvalQuadrature(Vector &qcoeff, Mesh &mesh,
+                                        const IntegrationRule &ir)
+{
+   b->EvalQuadrature(qcoeff, mesh, ir);
+   const int N = qcoeff.Size();
+   if (a == NULL)
+   {
+      const double ac = aConst;
+      auto C = qcoeff.ReadWrite();
+      MFEM_FORALL(i, N, C[i] *= ac;);
+      return;
+   }
+   Vector qa;
+   a->EvalQuadrature(qa, mesh, ir);
+   auto A = qa.Read();
+   auto C = qcoeff.ReadWrite();
+   MFEM_FORALL(i, N, C[i] *= A[i];);
+}
+
 InnerProductCoefficient::InnerProductCoefficient(VectorCoefficient &A,
                                                  VectorCoefficient &B)
    : a(&A), b(&B)
@@ -903,4 +1208,30 @@ double QuadratureFunctionCoefficient::Eval(ElementTransformation &T,
    return temp[0];
 }
 
+void QuadratureFunctionCoefficient::EvalQuadrature(Vector &qcoeff, Mesh &mesh,
+                                                   const IntegrationRule &ir)
+{
+   const QuadratureSpace &qs = *QuadF.GetSpace();
+   const int ne = mesh.GetNE();
+   const int nq = ir.GetNPoints();
+   // Eval() uses the index of the IntegrationPoint to address the values, so
+   // the data can be copied directly if every element stores 'nq' values.
+   bool uniform = (qs.GetMesh() == &mesh && QuadF.GetVDim() == 1 &&
+                   qs.GetSize() == nq * ne);
+   for (int e = 0; uniform && e < ne; e++)
+   {
+      uniform = (qs.GetElementIntRule(e).GetNPoints() == nq);
+   }
+   if (!uniform)
+   {
+      Coefficient::EvalQuadrature(qcoeff, mesh, ir);
+      return;
+   }
+   const int N = nq * ne;
+   qcoeff.SetSize(N);
+   auto Q = QuadF.Read();
+   auto C = qcoeff.Write();
+   MFEM_FORALL(i, N, C[i] = Q[i];);
+}
+
 }
@@ -65,6 +65,28 @@ public:
       return Eval(T, ip);
    }
 
+   /** @brief Evaluate the coefficient at all points of the IntegrationRule
+       @a ir in every element of @a mesh. */
+   /** On return, @a qcoeff has size ir.GetNPoints() * mesh.GetNE() and holds
+       the values with the layout (NQ, NE), i.e. the layout of a scalar
+       QuadratureFunction using @a ir in all elements. The default
+       implementation calls Eval() at every point; derived classes may override
+       it with batched (device) implementations. */
+   virtual void EvalQuadrature(Vector &qcoeff, Mesh &mesh,
+                               const IntegrationRule &ir);
+
+   /** @brief Evaluate the coefficient at all points of the tensor-product
+       IntegrationRule @a ir on every boundary face of @a mesh. */
+   /** On return, @a qcoeff has layout (NQ, NF) where the NF boundary faces are
+       numbered as in FiniteElementSpace::GetFaceRestriction() with
+       FaceType::Boundary and the points of each face are in lexicographic
+       order, as in FaceGeometricFactors. Faces with a boundary element use
+       its attribute. The default implementation calls Eval() at every point;
+       derived classes may override it with batched (device) implementations.
+   */
+   virtual void EvalBdrFaceQuadrature(Vector &qcoeff, Mesh &mesh,
+                                      const IntegrationRule &ir);
+
    virtual ~Coefficient() { }
 };
 
@@ -82,6 +104,14 @@ public:
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip)
    { return (constant); }
+
+   /// Batched version of Eval(), see Coefficient::EvalQuadrature().
+   virtual void EvalQuadrature(Vector &qcoeff, Mesh &mesh,
+                               const IntegrationRule &ir);
+
+   /// Batched version of Eval(), see Coefficient::EvalBdrFaceQuadrature().
+   virtual void EvalBdrFaceQuadrature(Vector &qcoeff, Mesh &mesh,
+                                      const IntegrationRule &ir);
 };
 
 /** @brief A piecewise constant coefficient with the constants keyed
@@ -118,6 +148,10 @@ public:
    /// Evaluate the coefficient.
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip);
+
+   /// Batched version of Eval(), see Coefficient::EvalQuadrature().
+   virtual void EvalQuadrature(Vector &qcoeff, Mesh &mesh,
+                               const IntegrationRule &ir);
 };
 
 
@@ -191,6 +225,18 @@ public:
    /// Evaluate the coefficient at @a ip.
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip);
+
+   /** @brief Evaluate the coefficient at all points of @a ir in every element
+       of @a mesh using the QuadratureInterpolator of the GridFunction space,
+       when possible. */
+   virtual void EvalQuadrature(Vector &qcoeff, Mesh &mesh,
+                               const IntegrationRule &ir);
+
+   /** @brief Evaluate the coefficient on the boundary faces of @a mesh using
+       the FaceQuadratureInterpolator of the GridFunction space, when
+       possible; see Coefficient::EvalBdrFaceQuadrature(). */
+   virtual void EvalBdrFaceQuadrature(Vector &qcoeff, Mesh &mesh,
+                                      const IntegrationRule &ir);
 };
 
 
@@ -379,6 +425,15 @@ public:
    virtual void Eval(DenseMatrix &M, ElementTransformation &T,
                      const IntegrationRule &ir);
 
+   /** @brief Evaluate the vector coefficient at all points of the
+       IntegrationRule @a ir in every element of @a mesh. */
+   /** On return, @a qcoeff has size GetVDim() * ir.GetNPoints() * mesh.GetNE()
+       and holds the values with the layout (VDIM, NQ, NE). The default
+       implementation calls Eval() at every point; derived classes may override
+       it with batched (device) implementations. */
+   virtual void EvalQuadrature(Vector &qcoeff, Mesh &mesh,
+                               const IntegrationRule &ir);
+
    virtual ~VectorCoefficient() { }
 };
 
@@ -398,6 +453,10 @@ public:
    virtual void Eval(Vector &V, ElementTransformation &T,
                      const IntegrationPoint &ip) { V = vec; }
 
+   /// Batched version of Eval(), see VectorCoefficient::EvalQuadrature().
+   virtual void EvalQuadrature(Vector &qcoeff, Mesh &mesh,
+                               const IntegrationRule &ir);
+
    /// Return a reference to the constant vector in this class.
    const Vector& GetVec() { return vec; }
 };
@@ -509,6 +568,12 @@ public:
    virtual void Eval(DenseMatrix &M, ElementTransformation &T,
                      const IntegrationRule &ir);
 
+   /** @brief Evaluate the coefficient at all points of @a ir in every element
+       of @a mesh using the QuadratureInterpolator of the GridFunction space,
+       when possible; see VectorCoefficient::EvalQuadrature(). */
+   virtual void EvalQuadrature(Vector &qcoeff, Mesh &mesh,
+                               const IntegrationRule &ir);
+
    virtual ~VectorGridFunctionCoefficient() { }
 };
 
@@ -909,6 +974,10 @@ public:
       return alpha * ((a == NULL ) ? aConst : a->Eval(T, ip) )
              + beta * b->Eval(T, ip);
    }
+
+   /// Batched version of Eval(), see Coefficient::EvalQuadrature().
+   virtual void EvalQuadrature(Vector &qcoeff, Mesh &mesh,
+                               const IntegrationRule &ir);
 };
 
 /** Scalar coefficient defined as the product of two scalar coefficients or
@@ -948,6 +1017,10 @@ public:
    virtual double Eval(ElementTransformation &T,
                        const IntegrationPoint &ip)
    { return ((a == NULL ) ? aConst : a->Eval(T, ip) ) * b->Eval(T, ip); }
+
+   /// Batched version of Eval(), see Coefficient::EvalQuadrature().
+   virtual void EvalQuadrature(Vector &qcoeff, Mesh &mesh,
+                               const IntegrationRule &ir);
 };
 
 /** Scalar coefficient defined as the ratio of two scalars where one or both
@@ -1569,6 +1642,11 @@ public:
 
    virtual double Eval(ElementTransformation &T, const IntegrationPoint &ip);
 
+   /** @brief Copy the values of the QuadratureFunction when every element
+       stores ir.GetNPoints() values; see Coefficient::EvalQuadrature(). */
+   virtual void EvalQuadrature(Vector &qcoeff, Mesh &mesh,
+                               const IntegrationRule &ir);
+
    virtual ~QuadratureFunctionCoefficient() { }
 };
 
@@ -0,0 +1,358 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "dgmassinv.hpp"
+#include "bilininteg.hpp"
+#include "../general/forall.hpp"
+
+namespace mfem
+{
+
+DGMassInverse::DGMassInverse(const FiniteElementSpace &f, Coefficient *Q,
+                             const IntegrationRule *ir)
+   : Operator(f.GetVSize()),
+     fes(f),
+     elem_restr(NULL),
+     ne(f.GetNE()),
+     vdim(f.GetVDim()),
+     block_inv(NULL),
+     tensor(false),
+     dim(f.GetMesh()->Dimension()),
+     dofs1D(0)
+{
+   MFEM_VERIFY(dynamic_cast<const L2_FECollection*>(fes.FEColl()),
+               "DGMassInverse requires an L2 finite element space");
+   // For scalar spaces, the E-vector ordering of L2ElementRestriction is the
+   // same as the L-vector ordering
+   if (vdim > 1)
+   {
+      elem_restr = fes.GetElementRestriction(ElementDofOrdering::NATIVE);
+      x_e.SetSize(elem_restr->Height(), Device::GetDeviceMemoryType());
+      y_e.SetSize(elem_restr->Height(), Device::GetDeviceMemoryType());
+      x_e.UseDevice(true);
+      y_e.UseDevice(true);
+   }
+   if (ne == 0) { return; }
+
+   const FiniteElement *fe = fes.GetFE(0);
+   if (ir && (dim == 2 || dim == 3) && UsesTensorBasis(fes) &&
+       fe->GetMapType() == FiniteElement::VALUE &&
+       dynamic_cast<const TensorBasisElement*>(fe)->GetDofMap().Size() == 0 &&
+       ir->GetNPoints() == fe->GetDof())
+   {
+      SetupTensor(Q, *ir);
+   }
+   else
+   {
+      SetupBlocks(Q, ir);
+   }
+}
+
+void DGMassInverse::SetupBlocks(Coefficient *Q, const IntegrationRule *ir)
+{
+   const int nd = fes.GetFE(0)->GetDof();
+   MassIntegrator *mass = Q ? new MassIntegrator(*Q, ir) :
+                          new MassIntegrator(ir);
+
+   // One block per element and component, ordered as the E-vector
+   DenseTensor blocks(nd, nd, vdim*ne);
+   DenseMatrix elmat;
+   for (int e = 0; e < ne; e++)
+   {
+      const FiniteElement *fe = fes.GetFE(e);
+      MFEM_VERIFY(fe->GetDof() == nd,
+                  "all elements must have the same number of dofs");
+      ElementTransformation *T = fes.GetElementTransformation(e);
+      mass->AssembleElementMatrix(*fe, *T, elmat);
+      for (int c = 0; c < vdim; c++)
+      {
+         blocks(c + vdim*e) = elmat;
+      }
+   }
+   delete mass;
+
+   block_inv = new BatchedBlockDiagonalSolver(
+      blocks, BatchedBlockDiagonalSolver::INVERSE);
+}
+
+void DGMassInverse::SetupTensor(Coefficient *Q, const IntegrationRule &ir)
+{
+   tensor = true;
+   const FiniteElement *fe = fes.GetFE(0);
+   const DofToQuad &maps = fe->GetDofToQuad(ir, DofToQuad::TENSOR);
+   dofs1D = maps.ndof;
+   MFEM_VERIFY(maps.nqpt == dofs1D, "the quadrature is not collocated");
+   MFEM_VERIFY(dofs1D <= MAX_D1D, "the order is too high");
+
+   // B(q,d) is square: store its inverse Binv(d,q)
+   DenseMatrix B(dofs1D);
+   for (int d = 0; d < dofs1D; d++)
+   {
+      for (int q = 0; q < dofs1D; q++)
+      {
+         B(q,d) = maps.B[q + dofs1D*d];
+      }
+   }
+   B.Invert();
+   Binv.SetSize(dofs1D*dofs1D);
+   Binv = Vector(B.Data(), dofs1D*dofs1D);
+
+   // Inverse of the quadrature weights, in lexicographic order
+   const int NQ = ir.GetNPoints();
+   Dinv.SetSize(NQ*ne);
+   double *d_inv = Dinv.HostWrite();
+   for (int e = 0; e < ne; e++)
+   {
+      ElementTransformation *T = fes.GetElementTransformation(e);
+      for (int q = 0; q < NQ; q++)
+      {
+         const IntegrationPoint &ip = ir.IntPoint(q);
+         T->SetIntPoint(&ip);
+         double w = ip.weight * T->Weight();
+         if (Q) { w *= Q->Eval(*T, ip); }
+         d_inv[q + NQ*e] = 1.0 / w;
+      }
+   }
+}
+
+// Apply y = B^{-1} D^{-1} B^{-t} x on NB element blocks with NB/vd elements,
+// using Binv(d,q) = B^{-1}
+template<int T_D1D = 0>
+static void DGMassInverseApply2D(const int NB, const int vd, const int d1d,
+                                 const Vector &binv, const Vector &dinv,
+                                 const Vector &x, Vector &y)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   auto Bi = Reshape(binv.Read(), D1D, D1D);
+   auto Di = Reshape(dinv.Read(), D1D, D1D, NB/vd);
+   auto X = Reshape(x.Read(), D1D, D1D, NB);
+   auto Y = Reshape(y.Write(), D1D, D1D, NB);
+   MFEM_FORALL(k, NB,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      const int e = k / vd;
+      double s[max_D1D][max_D1D];
+      double t[max_D1D][max_D1D];
+      // B^{-t} x
+      for (int d2 = 0; d2 < D1D; ++d2)
+      {
+         for (int q1 = 0; q1 < D1D; ++q1)
+         {
+            double u = 0.0;
+            for (int d1 = 0; d1 < D1D; ++d1)
+            {
+               u += Bi(d1,q1) * X(d1,d2,k);
+            }
+            s[d2][q1] = u;
+         }
+      }
+      for (int q2 = 0; q2 < D1D; ++q2)
+      {
+         for (int q1 = 0; q1 < D1D; ++q1)
+         {
+            double u = 0.0;
+            for (int d2 = 0; d2 < D1D; ++d2)
+            {
+               u += Bi(d2,q2) * s[d2][q1];
+            }
+            t[q2][q1] = u * Di(q1,q2,e);
+         }
+      }
+      // B^{-1} D^{-1} B^{-t} x
+      for (int q2 = 0; q2 < D1D; ++q2)
+      {
+         for (int d1 = 0; d1 < D1D; ++d1)
+         {
+            double u = 0.0;
+            for (int q1 = 0; q1 < D1D; ++q1)
+            {
+               u += Bi(d1,q1) * t[q2][q1];
+            }
+            s[q2][d1] = u;
+         }
+      }
+      for (int d2 = 0; d2 < D1D; ++d2)
+      {
+         for (int d1 = 0; d1 < D1D; ++d1)
+         {
+            double u = 0.0;
+            for (int q2 = 0; q2 < D1D; ++q2)
+            {
+               u += Bi(d2,q2) * s[q2][d1];
+            }
+            Y(d1,d2,k) = u;
+         }
+      }
+   });
+}
+
+template<int T_D1D = 0>
+static void DGMassInverseApply3D(const int NB, const int vd, const int d1d,
+                                 const Vector &binv, const Vector &dinv,
+                                 const Vector &x, Vector &y)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   auto Bi = Reshape(binv.Read(), D1D, D1D);
+   auto Di = Reshape(dinv.Read(), D1D, D1D, D1D, NB/vd);
+   auto X = Reshape(x.Read(), D1D, D1D, D1D, NB);
+   auto Y = Reshape(y.Write(), D1D, D1D, D1D, NB);
+   MFEM_FORALL(k, NB,
+   {
+      const int D1D = T_D1D ? T_D1D : d1d;
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      const int e = k / vd;
+      double s[max_D1D][max_D1D][max_D1D];
+      double t[max_D1D][max_D1D][max_D1D];
+      // B^{-t} x
+      for (int d3 = 0; d3 < D1D; ++d3)
+      {
+         for (int d2 = 0; d2 < D1D; ++d2)
+         {
+            for (int q1 = 0; q1 < D1D; ++q1)
+            {
+               double u = 0.0;
+               for (int d1 = 0; d1 < D1D; ++d1)
+               {
+                  u += Bi(d1,q1) * X(d1,d2,d3,k);
+               }
+               s[d3][d2][q1] = u;
+            }
+         }
+      }
+      for (int d3 = 0; d3 < D1D; ++d3)
+      {
+         for (int q2 = 0; q2 < D1D; ++q2)
+         {
+            for (int q1 = 0; q1 < D1D; ++q1)
+            {
+               double u = 0.0;
+               for (int d2 = 0; d2 < D1D; ++d2)
+               {
+                  u += Bi(d2,q2) * s[d3][d2][q1];
+               }
+               t[d3][q2][q1] = u;
+            }
+         }
+      }
+      for (int q3 = 0; q3 < D1D; ++q3)
+      {
+         for (int q2 = 0; q2 < D1D; ++q2)
+         {
+            for (int q1 = 0; q1 < D1D; ++q1)
+            {
+               double u = 0.0;
+               for (int d3 = 0; d3 < D1D; ++d3)
+               {
+                  u += Bi(d3,q3) * t[d3][q2][q1];
+               }
+               s[q3][q2][q1] = u * Di(q1,q2,q3,e);
+            }
+         }
+      }
+      // B^{-1} D^{-1} B^{-t} x
+      for (int q3 = 0; q3 < D1D; ++q3)
+      {
+         for (int q2 = 0; q2 < D1D; ++q2)
+         {
+            for (int d1 = 0; d1 < D1D; ++d1)
+            {
+               double u = 0.0;
+               for (int q1 = 0; q1 < D1D; ++q1)
+               {
+                  u += Bi(d1,q1) * s[q3][q2][q1];
+               }
+               t[q3][q2][d1] = u;
+            }
+         }
+      }
+      for (int q3 = 0; q3 < D1D; ++q3)
+      {
+         for (int d2 = 0; d2 < D1D; ++d2)
+         {
+            for (int d1 = 0; d1 < D1D; ++d1)
+            {
+               double u = 0.0;
+               for (int q2 = 0; q2 < D1D; ++q2)
+               {
+                  u += Bi(d2,q2) * t[q3][q2][d1];
+               }
+               s[q3][d2][d1] = u;
+            }
+         }
+      }
+      for (int d3 = 0; d3 < D1D; ++d3)
+      {
+         for (int d2 = 0; d2 < D1D; ++d2)
+         {
+            for (int d1 = 0; d1 < D1D; ++d1)
+            {
+               double u = 0.0;
+               for (int q3 = 0; q3 < D1D; ++q3)
+               {
+                  u += Bi(d3,q3) * s[q3][d2][d1];
+               }
+               Y(d1,d2,d3,k) = u;
+            }
+         }
+      }
+   });
+}
+
+void DGMassInverse::ApplyTensor(const Vector &x, Vector &y) const
+{
+   const int NB = vdim*ne;
+   if (dim == 2)
+   {
+      switch (dofs1D)
+      {
+         case 2: return DGMassInverseApply2D<2>(NB, vdim, 2, Binv, Dinv, x, y);
+         case 3: return DGMassInverseApply2D<3>(NB, vdim, 3, Binv, Dinv, x, y);
+         case 4: return DGMassInverseApply2D<4>(NB, vdim, 4, Binv, Dinv, x, y);
+         case 5: return DGMassInverseApply2D<5>(NB, vdim, 5, Binv, Dinv, x, y);
+         default:
+            return DGMassInverseApply2D(NB, vdim, dofs1D, Binv, Dinv, x, y);
+      }
+   }
+   switch (dofs1D)
+   {
+      case 2: return DGMassInverseApply3D<2>(NB, vdim, 2, Binv, Dinv, x, y);
+      case 3: return DGMassInverseApply3D<3>(NB, vdim, 3, Binv, Dinv, x, y);
+      case 4: return DGMassInverseApply3D<4>(NB, vdim, 4, Binv, Dinv, x, y);
+      case 5: return DGMassInverseApply3D<5>(NB, vdim, 5, Binv, Dinv, x, y);
+      default:
+         return DGMassInverseApply3D(NB, vdim, dofs1D, Binv, Dinv, x, y);
+   }
+}
+
+void DGMassInverse::Mult(const Vector &x, Vector &y) const
+{
+   if (ne == 0) { return; }
+   const Vector &xe = elem_restr ? x_e : x;
+   Vector &ye = elem_restr ? y_e : y;
+   if (elem_restr) { elem_restr->Mult(x, x_e); }
+   if (tensor)
+   {
+      ApplyTensor(xe, ye);
+   }
+   else
+   {
+      block_inv->Mult(xe, ye);
+   }
+   if (elem_restr) { elem_restr->MultTranspose(y_e, y); }
+}
+
+DGMassInverse::~DGMassInverse()
+{
+   delete block_inv;
+}
+
+} // namespace mfem
@@ -0,0 +1,91 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_DGMASSINV
+#define MFEM_DGMASSINV
+
+#include "../config/config.hpp"
+#include "../linalg/densemat.hpp"
+#include "fespace.hpp"
+#include "coefficient.hpp"
+
+namespace mfem
+{
+
+/// Inverse of the block diagonal mass matrix of an L2 (DG) space
+/** The operator is applied with device kernels over all elements, so that the
+    inverse mass matrix of explicit DG schemes does not need to go through the
+    host. Vector L2 spaces are supported, using the element restriction of the
+    space (L2ElementRestriction) to gather the element blocks.
+
+    Two representations of the inverse are used:
+    - In general, the element mass matrices are assembled and inverted in the
+      constructor, and applied with a batched matrix-vector product, see
+      BatchedBlockDiagonalSolver.
+    - On meshes of quadrilaterals or hexahedra, if the integration rule @a ir
+      has as many points per direction as the element has dofs (collocated
+      quadrature, e.g. p+1 Gauss-Legendre points for the order @a p, that is
+      IntRules.Get(geom, 2*p+1)), the element mass matrix M = B^t D B has a
+      square and invertible 1D factor B. The inverse M^{-1} = B^{-1} D^{-1}
+      B^{-t} is then applied with sum factorization, storing only the inverse
+      of the 1D matrix and the quadrature weights D.
+
+    In both cases, the result is the inverse of the mass matrix assembled by
+    MassIntegrator with the same coefficient and integration rule. Since L2
+    spaces have no shared dofs, the operator can also be used on the true dofs
+    of a ParFiniteElementSpace. */
+class DGMassInverse : public Operator
+{
+protected:
+   const FiniteElementSpace &fes;
+   /// Element restriction, NULL for scalar spaces (where it is the identity).
+   const Operator *elem_restr;
+   /// Number of elements and components.
+   int ne, vdim;
+
+   /// Batched inverse of the element mass matrices, general case.
+   BatchedBlockDiagonalSolver *block_inv;
+
+   /** Sum factorization data: inverse of the 1D basis and inverse of the
+       quadrature weights (including the Jacobian and coefficient). */
+   bool tensor;
+   int dim, dofs1D;
+   Vector Binv, Dinv;
+
+   mutable Vector x_e, y_e;
+
+   void SetupBlocks(Coefficient *Q, const IntegrationRule *ir);
+   void SetupTensor(Coefficient *Q, const IntegrationRule &ir);
+   void ApplyTensor(const Vector &x, Vector &y) const;
+
+public:
+   /** @brief Construct the inverse of the mass matrix of the L2 space @a f
+       with the optional coefficient @a Q and integration rule @a ir (not
+       owned), see MassIntegrator. The sum factorization path is used if the
+       mesh and @a ir allow it. */
+   DGMassInverse(const FiniteElementSpace &f, Coefficient *Q = NULL,
+                 const IntegrationRule *ir = NULL);
+
+   /// Return true if the inverse is applied with sum factorization.
+   bool UsesSumFactorization() const { return tensor; }
+
+   virtual void Mult(const Vector &x, Vector &y) const;
+
+   /// The mass matrix is symmetric.
+   virtual void MultTranspose(const Vector &x, Vector &y) const
+   { Mult(x, y); }
+
+   virtual ~DGMassInverse();
+};
+
+} // namespace mfem
+
+#endif
@@ -27,6 +27,7 @@
 #include "linearform.hpp"
 #include "nonlinearform.hpp"
 #include "bilinearform.hpp"
+#include "dgmassinv.hpp"
 #include "hybridization.hpp"
 #include "datacollection.hpp"
 #include "estimators.hpp"
@@ -40,6 +41,7 @@
 #include "transfer.hpp"
 #include "fespacehierarchy.hpp"
 #include "multigrid.hpp"
+#include "amg.hpp"
 
 #ifdef MFEM_USE_MPI
 #include "pfespace.hpp"
@@ -890,8 +890,9 @@ int FiniteElementSpace::GetNConformingDofs() const
 const Operator *FiniteElementSpace::GetElementRestriction(
    ElementDofOrdering e_ordering) const
 {
-   // Check if we have a discontinuous space using the FE collection:
-   if (IsDGSpace())
+   // Check if we have a discontinuous space using the FE collection; mixed
+   // meshes use the general ElementRestriction below.
+   if (IsDGSpace() && mesh->GetNumGeometries(mesh->Dimension()) <= 1)
    {
       if (L2E_nat.Ptr() == NULL)
       {
@@ -1592,7 +1593,7 @@ void FiniteElementSpace::BuildNURBSFaceToDofTable() const
    // Loop over faces in correct order, to prevent a sort
    // Sort will destroy orientation info in ordering of dofs
    Array<Connection> face_dof_list;
-   Array<int> row;
+   Array<int> row, bv;
    for (int f = 0; f < GetNF(); f++)
    {
       int b = face_to_be[f];
@@ -1601,12 +1602,9 @@ void FiniteElementSpace::BuildNURBSFaceToDofTable() const
       //        same orientation.
       if (dim > 1)
       {
-         const Element *fe = mesh->GetFace(f);
-         const Element *be = mesh->GetBdrElement(b);
-         const int nv = be->GetNVertices();
-         const int *fv = fe->GetVertices();
-         const int *bv = be->GetVertices();
-         for (int i = 0; i < nv; i++)
+         const int *fv = mesh->GetFace(f)->GetVertices();
+         mesh->GetBdrElementVertices(b, bv);
+         for (int i = 0; i < bv.Size(); i++)
          {
             MFEM_VERIFY(fv[i] == bv[i],
                         "non-matching face and boundary elements detected!");
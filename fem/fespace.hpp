@@ -756,6 +756,9 @@ public:
    /// Return the total number of quadrature points.
    int GetSize() const { return size; }
 
+   /// Returns the mesh
+   inline Mesh *GetMesh() const { return mesh; }
+
    /// Get the IntegrationRule associated with mesh element @a idx.
    const IntegrationRule &GetElementIntRule(int idx) const
    { return *int_rule[mesh->GetElementBaseGeometry(idx)]; }
@@ -976,7 +979,9 @@ public:
 
 inline bool UsesTensorBasis(const FiniteElementSpace& fes)
 {
-   return dynamic_cast<const mfem::TensorBasisElement *>(fes.GetFE(0))!=nullptr;
+   const Mesh *mesh = fes.GetMesh();
+   return dynamic_cast<const mfem::TensorBasisElement *>(fes.GetFE(0))!=nullptr
+          && mesh->GetNumGeometries(mesh->Dimension()) <= 1;
 }
 
 }
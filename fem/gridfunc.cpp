@@ -13,6 +13,7 @@
 
 #include "gridfunc.hpp"
 #include "../mesh/nurbs.hpp"
+#include "../general/binaryio.hpp"
 #include "../general/text.hpp"
 
 #include <limits>
@@ -54,6 +55,21 @@ GridFunction::GridFunction(Mesh *m, std::istream &input)
          MFEM_ABORT("unknown section: " << buff);
       }
    }
+   else if (next_char == 'b') // First letter of "binary_values"
+   {
+      string buff;
+      getline(input, buff);
+      filter_dos(buff);
+      MFEM_VERIFY(buff == "binary_values", "unknown section: " << buff);
+      int header[2];
+      bin_io::ReadArray(input, header, 2);
+      MFEM_VERIFY(header[0] == bin_io::byte_order_mark,
+                  "the binary values were written with a different byte order");
+      MFEM_VERIFY(header[1] == fes->GetVSize(), "invalid number of values");
+      SetSize(header[1]);
+      bin_io::ReadArray(input, HostWrite(), size);
+      MFEM_VERIFY(input, "invalid binary values");
+   }
    else
    {
       Vector::Load(input, fes->GetVSize());
@@ -3318,6 +3334,16 @@ void GridFunction::Save(std::ostream &out) const
    out.flush();
 }
 
+void GridFunction::SaveBinary(std::ostream &out) const
+{
+   fes->Save(out);
+   out << "\nbinary_values\n";
+   const int header[2] = { bin_io::byte_order_mark, size };
+   bin_io::WriteArray(out, header, 2);
+   bin_io::WriteArray(out, HostRead(), size);
+   out.flush();
+}
+
 #ifdef MFEM_USE_ADIOS2
 void GridFunction::Save(adios2stream &out,
                         const std::string& variable_name,
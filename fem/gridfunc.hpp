@@ -593,6 +593,13 @@ public:
    /// Save the GridFunction to an output stream.
    virtual void Save(std::ostream &out) const;
 
+   /** @brief Save the GridFunction to an output stream, writing the values in
+       binary form (native byte order) after the FiniteElementSpace header. */
+   /** The result is read by the constructor GridFunction(Mesh *,
+       std::istream &) with a single block read, e.g. from a
+       mfem::mapped_ifstream. */
+   virtual void SaveBinary(std::ostream &out) const;
+
 #ifdef MFEM_USE_ADIOS2
    /// Save the GridFunction to a binary output stream using adios2 bp format.
    virtual void Save(adios2stream &out, const std::string& variable_name,
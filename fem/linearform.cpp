@@ -24,6 +24,8 @@ LinearForm::LinearForm(FiniteElementSpace *f, LinearForm *lf)
 
    fes = f;
    extern_lfs = 1;
+   ext = NULL;
+   fast_assembly = false;
 
    // Copy the pointers to the integrators
    dlfi = lf->dlfi;
@@ -31,6 +33,7 @@ LinearForm::LinearForm(FiniteElementSpace *f, LinearForm *lf)
    dlfi_delta = lf->dlfi_delta;
 
    blfi = lf->blfi;
+   blfi_marker = lf->blfi_marker;
 
    flfi = lf->flfi;
    flfi_marker = lf->flfi_marker;
@@ -76,8 +79,75 @@ void LinearForm::AddBdrFaceIntegrator(LinearFormIntegrator *lfi,
    flfi_marker.Append(&bdr_attr_marker);
 }
 
+void LinearForm::UseFastAssembly(bool use_fa)
+{
+   fast_assembly = use_fa;
+   if (!fast_assembly)
+   {
+      delete ext;
+      ext = NULL;
+   }
+}
+
+bool LinearForm::SupportsDevice() const
+{
+   if (flfi.Size() > 0) { return false; }
+   for (int k = 0; k < dlfi.Size(); k++)
+   {
+      if (!dlfi[k]->SupportsDevice()) { return false; }
+   }
+   for (int k = 0; k < blfi.Size(); k++)
+   {
+      if (!blfi[k]->SupportsDevice()) { return false; }
+   }
+
+   const Mesh &mesh = *fes->GetMesh();
+   const int dim = mesh.Dimension();
+   if (dim != 2 && dim != 3) { return false; }
+   if (mesh.SpaceDimension() != dim) { return false; }
+   if (mesh.GetNumGeometries(dim) > 1) { return false; }
+   if (fes->GetNURBSext()) { return false; }
+   if (fes->GetNE() > 0 &&
+       fes->GetFE(0)->GetRangeType() != FiniteElement::SCALAR)
+   {
+      return false;
+   }
+   if (blfi.Size() > 0)
+   {
+      if (!mesh.Conforming()) { return false; }
+      // The device kernels integrate over the boundary faces only, so
+      // boundary elements on interior (or shared) faces need the host path.
+      for (int i = 0; i < mesh.GetNBE(); i++)
+      {
+         int e1, e2, inf1, inf2;
+         const int f = mesh.GetBdrElementEdgeIndex(i);
+         mesh.GetFaceElements(f, &e1, &e2);
+         mesh.GetFaceInfos(f, &inf1, &inf2);
+         if (e2 >= 0 || inf2 >= 0) { return false; }
+      }
+      if (!dynamic_cast<const H1_FECollection*>(fes->FEColl()))
+      {
+         return false;
+      }
+      if (fes->GetNE() > 0 &&
+          !dynamic_cast<const TensorBasisElement*>(fes->GetFE(0)))
+      {
+         return false;
+      }
+   }
+   return true;
+}
+
 void LinearForm::Assemble()
 {
+   if (fast_assembly && SupportsDevice())
+   {
+      if (ext == NULL) { ext = new LinearFormExtension(this); }
+      ext->Assemble();
+      AssembleDelta();
+      return;
+   }
+
    Array<int> vdofs;
    ElementTransformation *eltrans;
    Vector elemvect;
@@ -201,6 +271,7 @@ void LinearForm::Update(FiniteElementSpace *f, Vector &v, int v_offset)
    fes = f;
    NewDataAndSize((double *)v + v_offset, fes->GetVSize());
    ResetDeltaLocations();
+   if (ext) { ext->Update(); }
 }
 
 void LinearForm::AssembleDelta()
@@ -258,6 +329,7 @@ LinearForm & LinearForm::operator=(const Vector &v)
 
 LinearForm::~LinearForm()
 {
+   delete ext;
    if (!extern_lfs)
    {
       int k;
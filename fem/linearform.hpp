@@ -15,6 +15,7 @@
 #include "../config/config.hpp"
 #include "lininteg.hpp"
 #include "gridfunc.hpp"
+#include "linearform_ext.hpp"
 
 namespace mfem
 {
@@ -44,6 +45,12 @@ protected:
    Array<LinearFormIntegrator*> flfi;
    Array<Array<int>*>           flfi_marker; ///< Entries are not owned.
 
+   /// Extension for device assembly, see UseFastAssembly(). Owned.
+   LinearFormExtension *ext;
+
+   /// Indicates that UseFastAssembly() was enabled.
+   bool fast_assembly;
+
    /// The element ids where the centers of the delta functions lie
    Array<int> dlfi_delta_elem_id;
 
@@ -64,7 +71,10 @@ public:
    /// Creates linear form associated with FE space @a *f.
    /** The pointer @a f is not owned by the newly constructed object. */
    LinearForm(FiniteElementSpace *f) : Vector(f->GetVSize())
-   { fes = f; extern_lfs = 0; UseDevice(true); }
+   {
+      fes = f; extern_lfs = 0; ext = NULL; fast_assembly = false;
+      UseDevice(true);
+   }
 
    /** @brief Create a LinearForm on the FiniteElementSpace @a f, using the
        same integrators as the LinearForm @a lf.
@@ -79,7 +89,11 @@ public:
    /** The associated FiniteElementSpace can be set later using one of the
        methods: Update(FiniteElementSpace *) or
        Update(FiniteElementSpace *, Vector &, int). */
-   LinearForm() { fes = NULL; extern_lfs = 0; UseDevice(true); }
+   LinearForm()
+   {
+      fes = NULL; extern_lfs = 0; ext = NULL; fast_assembly = false;
+      UseDevice(true);
+   }
 
    /// Construct a LinearForm using previously allocated array @a data.
    /** The LinearForm does not assume ownership of @a data which is assumed to
@@ -87,7 +101,7 @@ public:
        for externally allocated array, the pointer @a data can be NULL. The data
        array can be replaced later using the method SetData(). */
    LinearForm(FiniteElementSpace *f, double *data) : Vector(data, f->GetVSize())
-   { fes = f; extern_lfs = 0; }
+   { fes = f; extern_lfs = 0; ext = NULL; fast_assembly = false; }
 
    /// Copy assignment. Only the data of the base class Vector is copied.
    /** It is assumed that this object and @a rhs use FiniteElementSpace%s that
@@ -144,6 +158,11 @@ public:
    /// Access all integrators added with AddBoundaryIntegrator().
    Array<LinearFormIntegrator*> *GetBLFI() { return &blfi; }
 
+   /** @brief Access all boundary markers added with AddBoundaryIntegrator().
+       If no marker was specified when the integrator was added, the
+       corresponding pointer (to Array<int>) will be NULL. */
+   Array<Array<int>*> *GetBLFI_Marker() { return &blfi_marker; }
+
    /// Access all integrators added with AddBdrFaceIntegrator().
    Array<LinearFormIntegrator*> *GetFLFI() { return &flfi; }
 
@@ -155,6 +174,21 @@ public:
    /// Assembles the linear form i.e. sums over all domain/bdr integrators.
    void Assemble();
 
+   /// Enable or disable the device assembly in Assemble().
+   /** When enabled, Assemble() uses a LinearFormExtension if SupportsDevice()
+       returns true, and the element-by-element host assembly otherwise. */
+   void UseFastAssembly(bool use_fa);
+
+   /// Return true if the integrators and the FE space support device assembly.
+   /** All domain and boundary integrators must implement
+       LinearFormIntegrator::AssembleDevice(), there must be no boundary face
+       integrators, and the mesh must have a single element type with
+       dimension 2 or 3 equal to its space dimension. Boundary integrators
+       further require an H1 space of tensor-product elements on a conforming
+       mesh without boundary elements on interior faces. Delta coefficients
+       are always assembled on the host. */
+   bool SupportsDevice() const;
+
    /// Assembles delta functions of the linear form
    void AssembleDelta();
 
@@ -163,11 +197,18 @@ public:
        updated, e.g. after its associated Mesh object has been refined.
 
        @note This method does not perform assembly. */
-   void Update() { SetSize(fes->GetVSize()); ResetDeltaLocations(); }
+   void Update()
+   {
+      SetSize(fes->GetVSize()); ResetDeltaLocations();
+      if (ext) { ext->Update(); }
+   }
 
    /// Associate a new FE space, @a *f, with this object and Update() it. */
    void Update(FiniteElementSpace *f)
-   { fes = f; SetSize(f->GetVSize()); ResetDeltaLocations(); }
+   {
+      fes = f; SetSize(f->GetVSize()); ResetDeltaLocations();
+      if (ext) { ext->Update(); }
+   }
 
    /** @brief Associate a new FE space, @a *f, with this object and use the data
        of @a v, offset by @a v_offset, to initialize this object's Vector::data.
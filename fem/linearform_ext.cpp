@@ -0,0 +1,116 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+// Implementation of class LinearFormExtension
+
+#include "linearform.hpp"
+
+namespace mfem
+{
+
+LinearFormExtension::LinearFormExtension(LinearForm *form)
+   : lf(form), elem_restrict(NULL), bdr_face_restrict_lex(NULL)
+{
+   Update();
+}
+
+void LinearFormExtension::Update()
+{
+   const FiniteElementSpace &fes = *lf->FESpace();
+   Mesh &mesh = *fes.GetMesh();
+   const int ne = fes.GetNE();
+
+   elem_restrict = fes.GetElementRestriction(ElementDofOrdering::NATIVE);
+   markers.SetSize(ne);
+   markers = 1;
+   if (elem_restrict)
+   {
+      b.SetSize(elem_restrict->Height(), Device::GetMemoryType());
+      b.UseDevice(true);
+   }
+
+   bdr_face_restrict_lex = NULL;
+   if (lf->GetBLFI()->Size() == 0) { return; }
+   bdr_face_restrict_lex =
+      fes.GetFaceRestriction(ElementDofOrdering::LEXICOGRAPHIC,
+                             FaceType::Boundary,
+                             L2FaceValues::SingleValued);
+   bdr_b.SetSize(bdr_face_restrict_lex->Height(), Device::GetMemoryType());
+   bdr_b.UseDevice(true);
+
+   // The boundary faces are numbered as in the face restriction. Faces without
+   // an associated boundary element get the invalid attribute 0.
+   Array<int> face_attr(mesh.GetNumFaces());
+   face_attr = 0;
+   for (int i = 0; i < mesh.GetNBE(); i++)
+   {
+      face_attr[mesh.GetBdrElementEdgeIndex(i)] = mesh.GetBdrAttribute(i);
+   }
+   bdr_face_attributes.SetSize(fes.GetNFbyType(FaceType::Boundary));
+   int f_ind = 0;
+   for (int f = 0; f < mesh.GetNumFaces(); ++f)
+   {
+      int e1, e2;
+      int inf1, inf2;
+      mesh.GetFaceElements(f, &e1, &e2);
+      mesh.GetFaceInfos(f, &inf1, &inf2);
+      if (e2 >= 0 || inf2 >= 0) { continue; }
+      bdr_face_attributes[f_ind++] = face_attr[f];
+   }
+   MFEM_VERIFY(f_ind == bdr_face_attributes.Size(),
+               "Incorrect number of faces.");
+   bdr_face_markers.SetSize(f_ind);
+}
+
+void LinearFormExtension::Assemble()
+{
+   const FiniteElementSpace &fes = *lf->FESpace();
+   Array<LinearFormIntegrator*> &domain_integs = *lf->GetDLFI();
+   Array<LinearFormIntegrator*> &bdr_integs = *lf->GetBLFI();
+   Array<Array<int>*> &bdr_markers = *lf->GetBLFI_Marker();
+
+   if (domain_integs.Size() > 0)
+   {
+      b = 0.0;
+      for (int k = 0; k < domain_integs.Size(); ++k)
+      {
+         domain_integs[k]->AssembleDevice(fes, markers, b);
+      }
+      elem_restrict->MultTranspose(b, *lf);
+   }
+   else
+   {
+      *lf = 0.0;
+   }
+
+   if (bdr_integs.Size() > 0)
+   {
+      // Boundary integrators may have been added after the construction.
+      if (bdr_face_restrict_lex == NULL) { Update(); }
+      bdr_b = 0.0;
+      for (int k = 0; k < bdr_integs.Size(); ++k)
+      {
+         Array<int> *bdr_marker = bdr_markers[k];
+         for (int f = 0; f < bdr_face_markers.Size(); ++f)
+         {
+            const int attr = bdr_face_attributes[f];
+            bdr_face_markers[f] = (attr > 0 &&
+                                   (bdr_marker == NULL ||
+                                    (*bdr_marker)[attr-1] != 0)) ? 1 : 0;
+         }
+         bdr_integs[k]->AssembleDevice(fes, bdr_face_markers, bdr_b);
+      }
+      // The face restriction adds its result to the L-vector.
+      bdr_face_restrict_lex->MultTranspose(bdr_b, *lf);
+   }
+}
+
+}
@@ -0,0 +1,61 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_LINEARFORM_EXT
+#define MFEM_LINEARFORM_EXT
+
+#include "../config/config.hpp"
+#include "fespace.hpp"
+#include "../general/device.hpp"
+
+namespace mfem
+{
+
+class LinearForm;
+
+/// Class extending the LinearForm class to support device assembly.
+/** The element vectors of the domain integrators are assembled into an
+    E-vector and mapped to the L-vector with the transpose of the element
+    restriction; the boundary integrators are assembled on the boundary faces
+    and mapped with the transpose of the boundary face restriction. All the
+    integrators must support LinearFormIntegrator::AssembleDevice(), see
+    LinearForm::SupportsDevice(). */
+class LinearFormExtension
+{
+protected:
+   LinearForm *lf; ///< Not owned
+
+   const Operator *elem_restrict; // Not owned
+   const Operator *bdr_face_restrict_lex; // Not owned
+
+   /// Element markers (all ones) passed to the domain integrators.
+   Array<int> markers;
+   /// Boundary attribute of each boundary face, in the face restriction order.
+   Array<int> bdr_face_attributes;
+   /// Boundary face markers passed to the boundary integrators.
+   Array<int> bdr_face_markers;
+
+   /// Element and boundary face E-vectors.
+   Vector b, bdr_b;
+
+public:
+   LinearFormExtension(LinearForm *form);
+
+   /// Assemble the domain and boundary integrators of the LinearForm.
+   void Assemble();
+
+   /// Update the internal data after the FiniteElementSpace has changed.
+   void Update();
+};
+
+}
+
+#endif
@@ -22,6 +22,13 @@ void LinearFormIntegrator::AssembleRHSElementVect(
    mfem_error("LinearFormIntegrator::AssembleRHSElementVect(...)");
 }
 
+void LinearFormIntegrator::AssembleDevice(const FiniteElementSpace &fes,
+                                          const Array<int> &markers,
+                                          Vector &b)
+{
+   mfem_error("LinearFormIntegrator::AssembleDevice(...)");
+}
+
 
 void DomainLFIntegrator::AssembleRHSElementVect(const FiniteElement &el,
                                                 ElementTransformation &Tr,
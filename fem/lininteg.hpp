@@ -18,6 +18,8 @@
 namespace mfem
 {
 
+class FiniteElementSpace;
+
 /// Abstract base class LinearFormIntegrator
 class LinearFormIntegrator
 {
@@ -36,6 +38,21 @@ public:
                                        FaceElementTransformations &Tr,
                                        Vector &elvect);
 
+   /// Return true if the integrator implements AssembleDevice().
+   virtual bool SupportsDevice() const { return false; }
+
+   /** @brief Add the contribution of the integrator to the E-vector @a b using
+       device kernels, see LinearFormExtension. */
+   /** For domain integrators, @a b uses the native element dof ordering, see
+       FiniteElementSpace::GetElementRestriction(), and @a markers has one
+       entry per element. For boundary integrators, @a b is the lexicographic
+       boundary face E-vector, see FiniteElementSpace::GetFaceRestriction(),
+       and @a markers has one entry per boundary face. Elements and faces with
+       zero markers do not contribute. */
+   virtual void AssembleDevice(const FiniteElementSpace &fes,
+                               const Array<int> &markers,
+                               Vector &b);
+
    virtual void SetIntRule(const IntegrationRule *ir) { IntRule = ir; }
    const IntegrationRule* GetIntRule() { return IntRule; }
 
@@ -95,6 +112,8 @@ class DomainLFIntegrator : public DeltaLFIntegrator
    Vector shape;
    Coefficient &Q;
    int oa, ob;
+   /// Work vectors of AssembleDevice().
+   Vector qcoeff, qvec, bq;
 public:
    /// Constructs a domain integrator with a given Coefficient
    DomainLFIntegrator(Coefficient &QF, int a = 2, int b = 0)
@@ -116,6 +135,13 @@ public:
                                          ElementTransformation &Trans,
                                          Vector &elvect);
 
+   virtual bool SupportsDevice() const { return true; }
+
+   /// Device assembly, see LinearFormIntegrator::AssembleDevice().
+   virtual void AssembleDevice(const FiniteElementSpace &fes,
+                               const Array<int> &markers,
+                               Vector &b);
+
    using LinearFormIntegrator::AssembleRHSElementVect;
 };
 
@@ -152,6 +178,8 @@ class BoundaryLFIntegrator : public LinearFormIntegrator
    Vector shape;
    Coefficient &Q;
    int oa, ob;
+   /// Work vector of AssembleDevice().
+   Vector qcoeff;
 public:
    /** @brief Constructs a boundary integrator with a given Coefficient @a QG.
        Integration order will be @a a * basis_order + @a b. */
@@ -166,6 +194,13 @@ public:
    virtual void AssembleRHSElementVect(const FiniteElement &el,
                                        FaceElementTransformations &Tr,
                                        Vector &elvect);
+
+   virtual bool SupportsDevice() const { return true; }
+
+   /// Device assembly, see LinearFormIntegrator::AssembleDevice().
+   virtual void AssembleDevice(const FiniteElementSpace &fes,
+                               const Array<int> &markers,
+                               Vector &b);
 };
 
 /// Class for boundary integration \f$ L(v) = (g \cdot n, v) \f$
@@ -211,6 +246,8 @@ class VectorDomainLFIntegrator : public DeltaLFIntegrator
 private:
    Vector shape, Qvec;
    VectorCoefficient &Q;
+   /// Work vectors of AssembleDevice().
+   Vector qcoeff, qvec, bq;
 
 public:
    /// Constructs a domain integrator with a given VectorCoefficient
@@ -227,6 +264,13 @@ public:
                                          ElementTransformation &Trans,
                                          Vector &elvect);
 
+   virtual bool SupportsDevice() const { return true; }
+
+   /// Device assembly, see LinearFormIntegrator::AssembleDevice().
+   virtual void AssembleDevice(const FiniteElementSpace &fes,
+                               const Array<int> &markers,
+                               Vector &b);
+
    using LinearFormIntegrator::AssembleRHSElementVect;
 };
 
@@ -0,0 +1,190 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "../general/forall.hpp"
+#include "lininteg.hpp"
+#include "fespace.hpp"
+#include "quadinterpolator.hpp"
+#include "restriction.hpp"
+
+namespace mfem
+{
+
+// Device assembly of the domain linear form integrators: the integrand
+// w*det(J)*f is formed at the quadrature points, with layout (NQ, VDIM, NE),
+// and then mapped to the element dofs with QuadratureInterpolator's
+// MultTranspose(). The coefficient has layout (VDIM, NQ, NE), or (VDIM) when
+// it is constant. The vectors @a qvec and @a bq are work arrays kept by the
+// integrators between calls.
+static void DomainLFAssemble(const FiniteElementSpace &fes,
+                             const IntegrationRule &ir,
+                             const Array<int> &markers,
+                             const Vector &coeff,
+                             Vector &qvec,
+                             Vector &bq,
+                             Vector &b)
+{
+   Mesh &mesh = *fes.GetMesh();
+   const int vdim = fes.GetVDim();
+   const int ne = mesh.GetNE();
+   const int nq = ir.GetNPoints();
+   const GeometricFactors *geom =
+      mesh.GetGeometricFactors(ir, GeometricFactors::DETERMINANTS);
+
+   qvec.SetSize(nq * vdim * ne, Device::GetMemoryType());
+   const bool const_c = coeff.Size() == vdim;
+   const int NE = ne;
+   const int NQ = nq;
+   const int VDIM = vdim;
+   auto W = ir.GetWeights().Read();
+   auto M = markers.Read();
+   auto detJ = Reshape(geom->detJ.Read(), NQ, NE);
+   auto C = const_c ? Reshape(coeff.Read(), VDIM, 1, 1) :
+            Reshape(coeff.Read(), VDIM, NQ, NE);
+   auto Q = Reshape(qvec.Write(), NQ, VDIM, NE);
+   MFEM_FORALL(e, NE,
+   {
+      const double m = M[e];
+      for (int q = 0; q < NQ; ++q)
+      {
+         const double w = m * W[q] * detJ(q,e);
+         for (int c = 0; c < VDIM; ++c)
+         {
+            Q(q,c,e) = w * (const_c ? C(c,0,0) : C(c,q,e));
+         }
+      }
+   });
+
+   const QuadratureInterpolator *qi = fes.GetQuadratureInterpolator(ir);
+   qi->SetOutputLayout(QVectorLayout::byNODES);
+   bq.SetSize(b.Size(), Device::GetMemoryType());
+   bq.UseDevice(true);
+   Vector empty;
+   qi->MultTranspose(QuadratureInterpolator::VALUES, qvec, empty, bq);
+   b += bq;
+}
+
+void DomainLFIntegrator::AssembleDevice(const FiniteElementSpace &fes,
+                                        const Array<int> &markers,
+                                        Vector &b)
+{
+   Mesh &mesh = *fes.GetMesh();
+   if (mesh.GetNE() == 0) { return; }
+   MFEM_VERIFY(fes.GetVDim() == 1, "Only scalar spaces are supported.");
+   const FiniteElement &el = *fes.GetFE(0);
+   const IntegrationRule *ir = IntRule ? IntRule :
+                               &IntRules.Get(el.GetGeomType(),
+                                             oa * el.GetOrder() + ob);
+   if (ConstantCoefficient *cQ = dynamic_cast<ConstantCoefficient*>(&Q))
+   {
+      qcoeff.SetSize(1);
+      qcoeff(0) = cQ->constant;
+   }
+   else
+   {
+      Q.EvalQuadrature(qcoeff, mesh, *ir);
+   }
+   DomainLFAssemble(fes, *ir, markers, qcoeff, qvec, bq, b);
+}
+
+void VectorDomainLFIntegrator::AssembleDevice(const FiniteElementSpace &fes,
+                                              const Array<int> &markers,
+                                              Vector &b)
+{
+   Mesh &mesh = *fes.GetMesh();
+   const int ne = mesh.GetNE();
+   if (ne == 0) { return; }
+   const int vdim = Q.GetVDim();
+   MFEM_VERIFY(fes.GetVDim() == vdim, "The coefficient size must match the"
+               " vector dimension of the space.");
+   const FiniteElement &el = *fes.GetFE(0);
+   const IntegrationRule *ir = IntRule ? IntRule :
+                               &IntRules.Get(el.GetGeomType(),
+                                             2 * el.GetOrder());
+   if (VectorConstantCoefficient *cQ =
+          dynamic_cast<VectorConstantCoefficient*>(&Q))
+   {
+      qcoeff = cQ->GetVec();
+   }
+   else
+   {
+      Q.EvalQuadrature(qcoeff, mesh, *ir);
+   }
+   DomainLFAssemble(fes, *ir, markers, qcoeff, qvec, bq, b);
+}
+
+void BoundaryLFIntegrator::AssembleDevice(const FiniteElementSpace &fes,
+                                          const Array<int> &markers,
+                                          Vector &b)
+{
+   Mesh &mesh = *fes.GetMesh();
+   const int nf = fes.GetNFbyType(FaceType::Boundary);
+   if (nf == 0) { return; }
+   MFEM_VERIFY(fes.GetVDim() == 1, "Only scalar spaces are supported.");
+   const int dim = mesh.Dimension();
+   MFEM_VERIFY(dim == 2 || dim == 3, "Dimension not supported.");
+   // Assumes tensor-product elements
+   const FiniteElement &el =
+      *fes.GetTraceElement(0, mesh.GetFaceBaseGeometry(0));
+   const IntegrationRule *ir = IntRule ? IntRule :
+                               &IntRules.Get(el.GetGeomType(),
+                                             oa * el.GetOrder() + ob);
+   const FaceGeometricFactors *geom =
+      mesh.GetFaceGeometricFactors(*ir, FaceGeometricFactors::DETERMINANTS,
+                                   FaceType::Boundary);
+   const DofToQuad &maps = el.GetDofToQuad(*ir, DofToQuad::TENSOR);
+   const int D1D = maps.ndof;
+   const int Q1D = maps.nqpt;
+   const int nq = ir->GetNPoints();
+
+   // Coefficient values at the face quadrature points, in lexicographic order
+   if (ConstantCoefficient *cQ = dynamic_cast<ConstantCoefficient*>(&Q))
+   {
+      qcoeff.SetSize(1);
+      qcoeff(0) = cQ->constant;
+   }
+   else
+   {
+      Q.EvalBdrFaceQuadrature(qcoeff, mesh, *ir);
+   }
+
+   const bool const_c = qcoeff.Size() == 1;
+   const int NF = nf;
+   const int NQ = nq;
+   const int ND = (dim == 2) ? D1D : D1D*D1D;
+   const bool tensor = (dim == 3);
+   auto B = Reshape(maps.B.Read(), Q1D, D1D);
+   auto W = ir->GetWeights().Read();
+   auto M = markers.Read();
+   auto detJ = Reshape(geom->detJ.Read(), NQ, NF);
+   auto C = const_c ? Reshape(qcoeff.Read(), 1, 1) :
+            Reshape(qcoeff.Read(), NQ, NF);
+   auto Y = Reshape(b.ReadWrite(), ND, NF);
+   MFEM_FORALL(i, NF*ND,
+   {
+      const int d = i % ND;
+      const int f = i / ND;
+      const int dx = d % D1D;
+      const int dy = d / D1D;
+      double s = 0.0;
+      for (int q = 0; q < NQ; ++q)
+      {
+         const int qx = q % Q1D;
+         const int qy = q / Q1D;
+         const double bq = tensor ? B(qx,dx) * B(qy,dy) : B(qx,dx);
+         const double c = const_c ? C(0,0) : C(q,f);
+         s += bq * W[q] * detJ(q,f) * c;
+      }
+      Y(d,f) += M[f] * s;
+   });
+}
+
+} // namespace mfem
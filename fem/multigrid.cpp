@@ -15,34 +15,18 @@ namespace mfem
 {
 
 Multigrid::Multigrid(const FiniteElementSpaceHierarchy& fespaces_)
-   : fespaces(fespaces_), cycleType(CycleType::VCYCLE), preSmoothingSteps(1),
+   : fespaces(&fespaces_), cycleType(CycleType::VCYCLE), preSmoothingSteps(1),
+     postSmoothingSteps(1)
+{}
+
+Multigrid::Multigrid()
+   : fespaces(NULL), cycleType(CycleType::VCYCLE), preSmoothingSteps(1),
      postSmoothingSteps(1)
 {}
 
 Multigrid::~Multigrid()
 {
-   for (int i = 0; i < operators.Size(); ++i)
-   {
-      if (ownedOperators[i])
-      {
-         delete operators[i];
-      }
-      if (ownedSmoothers[i])
-      {
-         delete smoothers[i];
-      }
-      delete X[i];
-      delete Y[i];
-      delete R[i];
-      delete Z[i];
-   }
-
-   operators.DeleteAll();
-   smoothers.DeleteAll();
-   X.DeleteAll();
-   Y.DeleteAll();
-   R.DeleteAll();
-   Z.DeleteAll();
+   ClearLevels();
 
    for (int i = 0; i < bfs.Size(); ++i)
    {
@@ -62,6 +46,9 @@ Multigrid::~Multigrid()
 void Multigrid::AddLevel(Operator* opr, Solver* smoother, bool ownOperator,
                          bool ownSmoother)
 {
+   MFEM_VERIFY(fespaces != NULL || prolongations.Size() == NumLevels(),
+               "without a FiniteElementSpaceHierarchy, the levels above the"
+               " coarsest one must be added with a prolongation");
    operators.Append(opr);
    smoothers.Append(smoother);
    ownedOperators.Append(ownOperator);
@@ -79,6 +66,62 @@ void Multigrid::AddLevel(Operator* opr, Solver* smoother, bool ownOperator,
    *Z.Last() = 0.0;
 }
 
+void Multigrid::AddLevel(Operator* opr, Solver* smoother,
+                         Operator* prolongation, bool ownOperator,
+                         bool ownSmoother, bool ownProlongation)
+{
+   MFEM_VERIFY(fespaces == NULL, "the prolongations are given by the"
+               " FiniteElementSpaceHierarchy");
+   MFEM_VERIFY((prolongation == NULL) == (NumLevels() == 0),
+               "a prolongation is required for all but the coarsest level");
+   if (prolongation)
+   {
+      MFEM_VERIFY(prolongation->Height() == opr->Height() &&
+                  prolongation->Width() == operators.Last()->Height(),
+                  "incompatible prolongation");
+      prolongations.Append(prolongation);
+      ownedProlongations.Append(ownProlongation);
+   }
+   AddLevel(opr, smoother, ownOperator, ownSmoother);
+}
+
+void Multigrid::ClearLevels()
+{
+   for (int i = 0; i < operators.Size(); ++i)
+   {
+      if (ownedOperators[i])
+      {
+         delete operators[i];
+      }
+      if (ownedSmoothers[i])
+      {
+         delete smoothers[i];
+      }
+      delete X[i];
+      delete Y[i];
+      delete R[i];
+      delete Z[i];
+   }
+   for (int i = 0; i < prolongations.Size(); ++i)
+   {
+      if (ownedProlongations[i])
+      {
+         delete prolongations[i];
+      }
+   }
+
+   operators.DeleteAll();
+   smoothers.DeleteAll();
+   prolongations.DeleteAll();
+   ownedOperators.DeleteAll();
+   ownedSmoothers.DeleteAll();
+   ownedProlongations.DeleteAll();
+   X.DeleteAll();
+   Y.DeleteAll();
+   R.DeleteAll();
+   Z.DeleteAll();
+}
+
 int Multigrid::NumLevels() const { return operators.Size(); }
 
 int Multigrid::GetFinestLevelIndex() const { return NumLevels() - 1; }
@@ -135,6 +178,12 @@ void Multigrid::SetOperator(const Operator& op)
    MFEM_ABORT("SetOperator not supported in Multigrid");
 }
 
+const Operator* Multigrid::GetProlongationAtLevel(int level) const
+{
+   return fespaces ? fespaces->GetProlongationAtLevel(level) :
+          prolongations[level];
+}
+
 void Multigrid::SmoothingStep(int level) const
 {
    GetOperatorAtLevel(level)->Mult(*Y[level], *R[level]); // r = A x
@@ -161,8 +210,8 @@ void Multigrid::Cycle(int level) const
    subtract(*X[level], *R[level], *R[level]);
 
    // Restrict residual
-   fespaces.GetProlongationAtLevel(level - 1)->MultTranspose(*R[level],
-                                                             *X[level - 1]);
+   GetProlongationAtLevel(level - 1)->MultTranspose(*R[level],
+                                                    *X[level - 1]);
 
    // Init zeros
    *Y[level - 1] = 0.0;
@@ -179,7 +228,7 @@ void Multigrid::Cycle(int level) const
    }
 
    // Prolongate
-   fespaces.GetProlongationAtLevel(level - 1)->Mult(*Y[level - 1], *R[level]);
+   GetProlongationAtLevel(level - 1)->Mult(*Y[level - 1], *R[level]);
 
    // Add update
    *Y[level] += *R[level];
@@ -32,7 +32,8 @@ public:
    };
 
 protected:
-   const FiniteElementSpaceHierarchy& fespaces;
+   /// The hierarchy providing the prolongations, or NULL, see Multigrid().
+   const FiniteElementSpaceHierarchy* fespaces;
    Array<Array<int>*> essentialTrueDofs;
    Array<BilinearForm*> bfs;
 
@@ -40,8 +41,11 @@ private:
    Array<Operator*> operators;
    Array<Solver*> smoothers;
 
+   Array<Operator*> prolongations;
+
    Array<bool> ownedOperators;
    Array<bool> ownedSmoothers;
+   Array<bool> ownedProlongations;
 
    CycleType cycleType;
    int preSmoothingSteps;
@@ -56,15 +60,28 @@ public:
    /// Constructs an empty multigrid for the given FiniteElementSpaceHierarchy
    Multigrid(const FiniteElementSpaceHierarchy& fespaces_);
 
+   /// Constructs an empty multigrid without a FiniteElementSpaceHierarchy
+   /** The prolongations between the levels are then given to AddLevel(), as
+       in algebraic multigrid methods. */
+   Multigrid();
+
    /// Destructor
    virtual ~Multigrid();
 
    /// Adds a level to the multigrid operator hierarchy.
    /** The ownership of the operators and solvers/smoothers may be transferred
-       to the Multigrid by setting the according boolean variables. */
+       to the Multigrid by setting the according boolean variables. With the
+       Multigrid() constructor, this method can only add the coarsest level;
+       the other levels need the version of AddLevel() with a prolongation. */
    void AddLevel(Operator* opr, Solver* smoother, bool ownOperator,
                  bool ownSmoother);
 
+   /// Adds a level with the given prolongation from the previous level.
+   /** Used with the Multigrid() constructor; the prolongation of the first
+       (coarsest) level must be NULL. */
+   void AddLevel(Operator* opr, Solver* smoother, Operator* prolongation,
+                 bool ownOperator, bool ownSmoother, bool ownProlongation);
+
    /// Returns the number of levels
    int NumLevels() const;
 
@@ -106,7 +123,15 @@ public:
    /// Recover the solution of a linear system formed with FormFineLinearSystem()
    void RecoverFineFEMSolution(const Vector& X, const Vector& b, Vector& x);
 
+protected:
+   /// Remove all levels, deleting the owned operators, smoothers and
+   /// prolongations
+   void ClearLevels();
+
 private:
+   /// Returns the prolongation from the given level to the next finer one
+   const Operator* GetProlongationAtLevel(int level) const;
+
    /// Application of a smoothing step at particular level
    void SmoothingStep(int level) const;
 
@@ -231,6 +231,15 @@ void ParBilinearForm::AssembleSharedFaces(int skip_zeros)
    }
 }
 
+void ParBilinearForm::SetCommOverlap(bool enable)
+{
+   PABilinearFormExtension *pa_ext =
+      dynamic_cast<PABilinearFormExtension*>(ext);
+   MFEM_VERIFY(pa_ext && assembly == AssemblyLevel::PARTIAL,
+               "SetCommOverlap requires AssemblyLevel::PARTIAL");
+   pa_ext->SetCommOverlap(enable);
+}
+
 void ParBilinearForm::Assemble(int skip_zeros)
 {
    if (mat == NULL && fbfi.Size() > 0)
@@ -299,7 +308,9 @@ void ParBilinearForm::FormLinearSystem(
    const Array<int> &ess_tdof_list, Vector &x, Vector &b,
    OperatorHandle &A, Vector &X, Vector &B, int copy_interior)
 {
-   if (ext)
+   // The device full assembly only computes the local matrix, see
+   // FormSystemMatrix()
+   if (ext && assembly != AssemblyLevel::FULL)
    {
       ext->FormLinearSystem(ess_tdof_list, x, b, A, X, B, copy_interior);
       return;
@@ -348,7 +359,9 @@ void ParBilinearForm::FormLinearSystem(
 void ParBilinearForm::FormSystemMatrix(const Array<int> &ess_tdof_list,
                                        OperatorHandle &A)
 {
-   if (ext)
+   // With the device full assembly, FABilinearFormExtension computes the local
+   // matrix 'mat', which is assembled in parallel below
+   if (ext && assembly != AssemblyLevel::FULL)
    {
       ext->FormSystemMatrix(ess_tdof_list, A);
       return;
@@ -372,6 +385,12 @@ void ParBilinearForm::FormSystemMatrix(const Array<int> &ess_tdof_list,
       {
          const int remove_zeros = 0;
          Finalize(remove_zeros);
+         if (ext)
+         {
+            mat->HostReadI();
+            mat->HostReadJ();
+            mat->HostReadData();
+         }
          MFEM_VERIFY(p_mat.Ptr() == NULL && p_mat_e.Ptr() == NULL,
                      "The ParBilinearForm must be updated with Update() before "
                      "re-assembling the ParBilinearForm.");
@@ -396,7 +415,7 @@ void ParBilinearForm::FormSystemMatrix(const Array<int> &ess_tdof_list,
 void ParBilinearForm::RecoverFEMSolution(
    const Vector &X, const Vector &b, Vector &x)
 {
-   if (ext)
+   if (ext && assembly != AssemblyLevel::FULL)
    {
       ext->RecoverFEMSolution(X, b, x);
       return;
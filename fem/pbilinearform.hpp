@@ -75,6 +75,20 @@ public:
        those rows. Must be called before the first Assemble call. */
    void KeepNbrBlock(bool knb = true) { keep_nbr_block = knb; }
 
+   /** @brief The device full assembly computes the local matrix, which
+       FormSystemMatrix() assembles in parallel as in the original full
+       assembly. It does not include the shared faces, so it is not used with
+       interior face integrators. */
+   virtual bool SupportsFastAssembly() const
+   { return fbfi.Size() == 0 && BilinearForm::SupportsFastAssembly(); }
+
+   /** @brief When using AssemblyLevel::PARTIAL, enable or disable the overlap
+       of the exchange of the shared dofs with the element computations in the
+       operator returned by FormSystemMatrix() and FormLinearSystem(), see
+       PAOverlapRAPOperator. Disabled by default; when enabled, it is used if
+       supported. Must be called after SetAssemblyLevel(). */
+   void SetCommOverlap(bool enable = true);
+
    /** @brief Set the operator type id for the parallel matrix/operator when
        using AssemblyLevel::FULL. */
    /** If using static condensation or hybridization, call this method *after*
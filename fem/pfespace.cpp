@@ -3053,6 +3053,65 @@ void ConformingProlongationOperator::MultTranspose(
    gc.ReduceEnd<double>(ydata, out_layout, GroupCommunicator::Sum);
 }
 
+void ConformingProlongationOperator::BcastBegin(const Vector &x,
+                                                Vector &y) const
+{
+   MFEM_ASSERT(x.Size() == Width(), "");
+   MFEM_ASSERT(y.Size() == Height(), "");
+
+   const double *xdata = x.HostRead();
+   double *ydata = y.HostWrite();
+   const int m = external_ldofs.Size();
+
+   const int in_layout = 2; // 2 - input is ltdofs array
+   gc.BcastBegin(const_cast<double*>(xdata), in_layout);
+
+   int j = 0;
+   for (int i = 0; i < m; i++)
+   {
+      const int end = external_ldofs[i];
+      std::copy(xdata+j-i, xdata+end-i, ydata+j);
+      j = end+1;
+   }
+   std::copy(xdata+j-m, xdata+Width(), ydata+j);
+}
+
+void ConformingProlongationOperator::BcastEnd(Vector &y) const
+{
+   const int out_layout = 0; // 0 - output is ldofs array
+   gc.BcastEnd(y.HostReadWrite(), out_layout);
+}
+
+void ConformingProlongationOperator::ReduceBegin(const Vector &x) const
+{
+   MFEM_ASSERT(x.Size() == Height(), "");
+
+   gc.ReduceBegin(x.HostRead());
+}
+
+void ConformingProlongationOperator::ReduceEnd(const Vector &x,
+                                               Vector &y) const
+{
+   MFEM_ASSERT(x.Size() == Height(), "");
+   MFEM_ASSERT(y.Size() == Width(), "");
+
+   const double *xdata = x.HostRead();
+   double *ydata = y.HostWrite();
+   const int m = external_ldofs.Size();
+
+   int j = 0;
+   for (int i = 0; i < m; i++)
+   {
+      const int end = external_ldofs[i];
+      std::copy(xdata+j, xdata+end, ydata+j-i);
+      j = end+1;
+   }
+   std::copy(xdata+j, xdata+Height(), ydata+j-m);
+
+   const int out_layout = 2; // 2 - output is an array on all ltdofs
+   gc.ReduceEnd<double>(ydata, out_layout, GroupCommunicator::Sum);
+}
+
 DeviceConformingProlongationOperator::DeviceConformingProlongationOperator(
    const ParFiniteElementSpace &pfes) :
    ConformingProlongationOperator(pfes),
@@ -3120,6 +3179,7 @@ DeviceConformingProlongationOperator::DeviceConformingProlongationOperator(
       if (recv_size > 0) { req_counter++; }
    }
    requests = new MPI_Request[req_counter];
+   num_pending_requests = 0;
 }
 
 static void ExtractSubVector(const int N,
@@ -3201,6 +3261,43 @@ void DeviceConformingProlongationOperator::Mult(const Vector &x,
    BcastEndCopy(y); // copy from 'ext_buf'
 }
 
+void DeviceConformingProlongationOperator::BcastBegin(const Vector &x,
+                                                      Vector &y) const
+{
+   const GroupTopology &gtopo = gc.GetGroupTopology();
+   BcastBeginCopy(x); // copy to 'shr_buf'
+   num_pending_requests = 0;
+   for (int nbr = 1; nbr < gtopo.GetNumNeighbors(); nbr++)
+   {
+      const int send_offset = shr_buf_offsets[nbr];
+      const int send_size = shr_buf_offsets[nbr+1] - send_offset;
+      if (send_size > 0)
+      {
+         auto send_buf = mpi_gpu_aware ? shr_buf.Read() : shr_buf.HostRead();
+         MPI_Isend(send_buf + send_offset, send_size, MPI_DOUBLE,
+                   gtopo.GetNeighborRank(nbr), 41822,
+                   gtopo.GetComm(), &requests[num_pending_requests++]);
+      }
+      const int recv_offset = ext_buf_offsets[nbr];
+      const int recv_size = ext_buf_offsets[nbr+1] - recv_offset;
+      if (recv_size > 0)
+      {
+         auto recv_buf = mpi_gpu_aware ? ext_buf.Write() : ext_buf.HostWrite();
+         MPI_Irecv(recv_buf + recv_offset, recv_size, MPI_DOUBLE,
+                   gtopo.GetNeighborRank(nbr), 41822,
+                   gtopo.GetComm(), &requests[num_pending_requests++]);
+      }
+   }
+   BcastLocalCopy(x, y);
+}
+
+void DeviceConformingProlongationOperator::BcastEnd(Vector &y) const
+{
+   MPI_Waitall(num_pending_requests, requests, MPI_STATUSES_IGNORE);
+   num_pending_requests = 0;
+   BcastEndCopy(y); // copy from 'ext_buf'
+}
+
 DeviceConformingProlongationOperator::~DeviceConformingProlongationOperator()
 {
    delete [] requests;
@@ -3289,6 +3386,43 @@ void DeviceConformingProlongationOperator::MultTranspose(const Vector &x,
    ReduceEndAssemble(y); // assemble from 'shr_buf'
 }
 
+void DeviceConformingProlongationOperator::ReduceBegin(const Vector &x) const
+{
+   const GroupTopology &gtopo = gc.GetGroupTopology();
+   ReduceBeginCopy(x); // copy to 'ext_buf'
+   num_pending_requests = 0;
+   for (int nbr = 1; nbr < gtopo.GetNumNeighbors(); nbr++)
+   {
+      const int send_offset = ext_buf_offsets[nbr];
+      const int send_size = ext_buf_offsets[nbr+1] - send_offset;
+      if (send_size > 0)
+      {
+         auto send_buf = mpi_gpu_aware ? ext_buf.Read() : ext_buf.HostRead();
+         MPI_Isend(send_buf + send_offset, send_size, MPI_DOUBLE,
+                   gtopo.GetNeighborRank(nbr), 41823,
+                   gtopo.GetComm(), &requests[num_pending_requests++]);
+      }
+      const int recv_offset = shr_buf_offsets[nbr];
+      const int recv_size = shr_buf_offsets[nbr+1] - recv_offset;
+      if (recv_size > 0)
+      {
+         auto recv_buf = mpi_gpu_aware ? shr_buf.Write() : shr_buf.HostWrite();
+         MPI_Irecv(recv_buf + recv_offset, recv_size, MPI_DOUBLE,
+                   gtopo.GetNeighborRank(nbr), 41823,
+                   gtopo.GetComm(), &requests[num_pending_requests++]);
+      }
+   }
+}
+
+void DeviceConformingProlongationOperator::ReduceEnd(const Vector &x,
+                                                     Vector &y) const
+{
+   ReduceLocalCopy(x, y);
+   MPI_Waitall(num_pending_requests, requests, MPI_STATUSES_IGNORE);
+   num_pending_requests = 0;
+   ReduceEndAssemble(y); // assemble from 'shr_buf'
+}
+
 } // namespace mfem
 
 #endif
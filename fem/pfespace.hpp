@@ -393,6 +393,31 @@ protected:
 public:
    ConformingProlongationOperator(const ParFiniteElementSpace &pfes);
 
+   /// Return the sorted list of the ldofs owned by other processors.
+   const Array<int> &GetExternalLDofs() const { return external_ldofs; }
+
+   /** @brief Start the action of the operator: post the messages and set the
+       ldofs of @a y owned by this processor. */
+   /** The ldofs of @a y in GetExternalLDofs() are set by BcastEnd(), which
+       must be called before the next call to BcastBegin() or ReduceBegin().
+       BcastBegin() followed by BcastEnd() is equivalent to Mult(). The split
+       methods are used only by the communication overlap of the parallel PA
+       operator, see ParBilinearForm::SetCommOverlap(). */
+   virtual void BcastBegin(const Vector &x, Vector &y) const;
+
+   /// Complete the action of the operator started with BcastBegin().
+   virtual void BcastEnd(Vector &y) const;
+
+   /** @brief Start the transpose action of the operator: send the entries of
+       @a x at the ldofs in GetExternalLDofs(). */
+   /** Only these entries of @a x need to be set at this point; the others are
+       used by ReduceEnd(). ReduceBegin() followed by ReduceEnd() with the same
+       @a x is equivalent to MultTranspose(). */
+   virtual void ReduceBegin(const Vector &x) const;
+
+   /// Complete the transpose action of the operator started with ReduceBegin().
+   virtual void ReduceEnd(const Vector &x, Vector &y) const;
+
    virtual void Mult(const Vector &x, Vector &y) const;
 
    virtual void MultTranspose(const Vector &x, Vector &y) const;
@@ -410,6 +435,7 @@ protected:
    Array<int> ltdof_ldof, unq_ltdof;
    Array<int> unq_shr_i, unq_shr_j;
    MPI_Request *requests;
+   mutable int num_pending_requests; // posted by BcastBegin(), ReduceBegin()
    // Kernel: copy ltdofs from 'src' to 'shr_buf' - prepare for send.
    //         shr_buf[i] = src[shr_ltdof[i]]
    void BcastBeginCopy(const Vector &src) const;
@@ -442,6 +468,14 @@ public:
    virtual void Mult(const Vector &x, Vector &y) const;
 
    virtual void MultTranspose(const Vector &x, Vector &y) const;
+
+   virtual void BcastBegin(const Vector &x, Vector &y) const;
+
+   virtual void BcastEnd(Vector &y) const;
+
+   virtual void ReduceBegin(const Vector &x) const;
+
+   virtual void ReduceEnd(const Vector &x, Vector &y) const;
 };
 
 }
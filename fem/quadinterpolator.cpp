@@ -407,11 +407,66 @@ void QuadratureInterpolator::Mult(
    }
 }
 
+// Transpose of the byNODES evaluation in QuadratureInterpolator::Mult(): for
+// each element dof, sum the contributions of the values and/or reference
+// derivatives at all quadrature points.
+static void MultTransposeByNodes(const int NE,
+                                 const int vdim,
+                                 const int dim,
+                                 const DofToQuad &maps,
+                                 const Vector &q_val,
+                                 const Vector &q_der,
+                                 Vector &e_vec,
+                                 const bool use_val,
+                                 const bool use_der)
+{
+   const int ND = maps.ndof;
+   const int NQ = maps.nqpt;
+   const int VDIM = vdim;
+   const int DIM = dim;
+   auto B = Reshape(maps.B.Read(), NQ, ND);
+   auto G = Reshape(maps.G.Read(), NQ, DIM, ND);
+   auto val = Reshape(use_val ? q_val.Read() : nullptr, NQ, VDIM, NE);
+   auto der = Reshape(use_der ? q_der.Read() : nullptr, NQ, VDIM, DIM, NE);
+   auto E = Reshape(e_vec.Write(), ND, VDIM, NE);
+   MFEM_FORALL(i, NE*ND,
+   {
+      const int d = i % ND;
+      const int e = i / ND;
+      for (int c = 0; c < VDIM; c++)
+      {
+         double s = 0.0;
+         for (int q = 0; q < NQ; ++q)
+         {
+            if (use_val) { s += B(q,d) * val(q,c,e); }
+            if (use_der)
+            {
+               for (int k = 0; k < DIM; k++) { s += G(q,k,d) * der(q,c,k,e); }
+            }
+         }
+         E(d,c,e) = s;
+      }
+   });
+}
+
 void QuadratureInterpolator::MultTranspose(
    unsigned eval_flags, const Vector &q_val, const Vector &q_der,
    Vector &e_vec) const
 {
-   MFEM_ABORT("this method is not implemented yet");
+   MFEM_VERIFY(!(eval_flags & DETERMINANTS),
+               "the transpose of the determinant evaluation is not defined");
+   MFEM_VERIFY(q_layout == QVectorLayout::byNODES,
+               "MultTranspose() with 'byVDIM' layout is not implemented yet!");
+   const int ne = fespace->GetNE();
+   if (ne == 0) { return; }
+   const int vdim = fespace->GetVDim();
+   const int dim = fespace->GetMesh()->Dimension();
+   const FiniteElement *fe = fespace->GetFE(0);
+   const IntegrationRule *ir =
+      IntRule ? IntRule : &qspace->GetElementIntRule(0);
+   const DofToQuad &maps = fe->GetDofToQuad(*ir, DofToQuad::FULL);
+   MultTransposeByNodes(ne, vdim, dim, maps, q_val, q_der, e_vec,
+                        eval_flags & VALUES, eval_flags & DERIVATIVES);
 }
 
 
@@ -70,6 +70,15 @@ public:
    QuadratureInterpolator(const FiniteElementSpace &fes,
                           const QuadratureSpace &qs);
 
+   /** @brief Return true if Mult() with the QVectorLayout::byNODES output
+       layout supports elements of dimension @a dim with @a nd dofs and
+       integration rules with @a nq points. */
+   static bool SupportsByNodesLayout(int dim, int nd, int nq)
+   {
+      return (dim == 2) ? (nd <= MAX_ND2D && nq <= MAX_NQ2D) :
+             (dim == 3) ? (nd <= MAX_ND3D && nq <= MAX_NQ3D) : false;
+   }
+
    /** @brief Disable the use of tensor product evaluations, for tensor-product
        elements, e.g. quads and hexes. */
    /** Currently, tensor product evaluations are not implemented and this method
@@ -109,7 +118,9 @@ public:
        @a e_vec at quadrature points. */
    void PhysDerivatives(const Vector &e_vec, Vector &q_der) const;
 
-   /// Perform the transpose operation of Mult(). (TODO)
+   /// Perform the transpose operation of Mult(), overwriting @a e_vec.
+   /** Only the VALUES and DERIVATIVES flags with the QVectorLayout::byNODES
+       layout are currently supported. */
    void MultTranspose(unsigned eval_flags, const Vector &q_val,
                       const Vector &q_der, Vector &e_vec) const;
 
@@ -63,6 +63,11 @@ public:
    FaceQuadratureInterpolator(const FiniteElementSpace &fes,
                               const IntegrationRule &ir, FaceType type);
 
+   /** @brief Return true if the interpolation supports face elements with
+       @a nd1d dofs and integration rules with @a nq1d points per direction. */
+   static bool SupportsSizes(int nd1d, int nq1d)
+   { return nd1d <= MAX_ND1D && nq1d <= MAX_NQ1D; }
+
    /** @brief Disable the use of tensor product evaluations, for tensor-product
        elements, e.g. quads and hexes. */
    /** Currently, tensor product evaluations are not implemented and this method
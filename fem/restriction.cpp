@@ -66,6 +66,18 @@ void L2ElementRestriction::MultTranspose(const Vector &x, Vector &y) const
    });
 }
 
+// Return the largest number of dofs of the elements of @a fes.
+static int GetMaxElementDof(const FiniteElementSpace &fes)
+{
+   const Table &e2dTable = fes.GetElementToDofTable();
+   int max_dof = 0;
+   for (int e = 0; e < fes.GetNE(); ++e)
+   {
+      if (e2dTable.RowSize(e) > max_dof) { max_dof = e2dTable.RowSize(e); }
+   }
+   return max_dof;
+}
+
 ElementRestriction::ElementRestriction(const FiniteElementSpace &f,
                                        ElementDofOrdering e_ordering)
    : fes(f),
@@ -73,13 +85,13 @@ ElementRestriction::ElementRestriction(const FiniteElementSpace &f,
      vdim(fes.GetVDim()),
      byvdim(fes.GetOrdering() == Ordering::byVDIM),
      ndofs(fes.GetNDofs()),
-     dof(ne > 0 ? fes.GetFE(0)->GetDof() : 0),
+     dof(GetMaxElementDof(fes)),
      nedofs(ne*dof),
      offsets(ndofs+1),
-     indices(ne*dof),
+     indices(fes.GetElementToDofTable().Size_of_connections()),
      gatherMap(ne*dof)
 {
-   // Assuming all finite elements are the same.
+   // Elements with fewer than 'dof' dofs (mixed meshes) are padded.
    height = vdim*ne*dof;
    width = fes.GetVSize();
    const bool dof_reorder = (e_ordering == ElementDofOrdering::LEXICOGRAPHIC);
@@ -91,7 +103,7 @@ ElementRestriction::ElementRestriction(const FiniteElementSpace &f,
          const FiniteElement *fe = fes.GetFE(e);
          const TensorBasisElement* el =
             dynamic_cast<const TensorBasisElement*>(fe);
-         if (el) { continue; }
+         if (el && fe->GetDof() == dof) { continue; }
          mfem_error("Finite element not suitable for lexicographic ordering");
       }
       const FiniteElement *fe = fes.GetFE(0);
@@ -102,6 +114,7 @@ ElementRestriction::ElementRestriction(const FiniteElementSpace &f,
       dof_map = fe_dof_map.GetData();
    }
    const Table& e2dTable = fes.GetElementToDofTable();
+   const int* elementOffsets = e2dTable.GetI();
    const int* elementMap = e2dTable.GetJ();
    // We will be keeping a count of how many local nodes point to its global dof
    for (int i = 0; i <= ndofs; ++i)
@@ -110,9 +123,9 @@ ElementRestriction::ElementRestriction(const FiniteElementSpace &f,
    }
    for (int e = 0; e < ne; ++e)
    {
-      for (int d = 0; d < dof; ++d)
+      for (int j = elementOffsets[e]; j < elementOffsets[e+1]; ++j)
       {
-         const int sgid = elementMap[dof*e + d];  // signed
+         const int sgid = elementMap[j];  // signed
          const int gid = (sgid >= 0) ? sgid : -1 - sgid;
          ++offsets[gid + 1];
       }
@@ -125,13 +138,21 @@ ElementRestriction::ElementRestriction(const FiniteElementSpace &f,
    // For each global dof, fill in all local nodes that point to it
    for (int e = 0; e < ne; ++e)
    {
+      const int edof = elementOffsets[e+1] - elementOffsets[e];
       for (int d = 0; d < dof; ++d)
       {
+         const int lid = dof*e + d;
+         if (d >= edof)
+         {
+            // Padding entries gather the first dof of the element; they do
+            // not contribute to MultTranspose().
+            gatherMap[lid] = gatherMap[dof*e];
+            continue;
+         }
          const int sdid = dof_reorder ? dof_map[d] : 0;  // signed
          const int did = (!dof_reorder)?d:(sdid >= 0 ? sdid : -1-sdid);
-         const int sgid = elementMap[dof*e + did];  // signed
+         const int sgid = elementMap[elementOffsets[e] + did];  // signed
          const int gid = (sgid >= 0) ? sgid : -1-sgid;
-         const int lid = dof*e + d;
          const bool plus = (sgid >= 0 && sdid >= 0) || (sgid < 0 && sdid < 0);
          gatherMap[lid] = plus ? gid : -1-gid;
          indices[offsets[gid]++] = plus ? lid : -1-lid;
@@ -244,6 +265,63 @@ void ElementRestriction::MultTransposeUnsigned(const Vector& x, Vector& y) const
    });
 }
 
+void ElementRestriction::MultElements(const Array<int> &elems,
+                                      const Vector& x, Vector& y) const
+{
+   const int nd = dof;
+   const int vd = vdim;
+   const bool t = byvdim;
+   const int N = elems.Size();
+   auto d_elems = elems.Read();
+   auto d_x = Reshape(x.Read(), t?vd:ndofs, t?ndofs:vd);
+   auto d_y = Reshape(y.ReadWrite(), nd, vd, ne);
+   auto d_gatherMap = Reshape(gatherMap.Read(), nd, ne);
+   MFEM_FORALL(i, nd*N,
+   {
+      const int d = i % nd;
+      const int e = d_elems[i / nd];
+      const int gid = d_gatherMap(d, e);
+      const bool plus = gid >= 0;
+      const int j = plus ? gid : -1-gid;
+      for (int c = 0; c < vd; ++c)
+      {
+         const double dofValue = d_x(t?c:j, t?j:c);
+         d_y(d, c, e) = plus ? dofValue : -dofValue;
+      }
+   });
+}
+
+void ElementRestriction::MultTransposeDofs(const Array<int> &dofs,
+                                           const Vector& x, Vector& y) const
+{
+   const int nd = dof;
+   const int vd = vdim;
+   const bool t = byvdim;
+   const int N = dofs.Size();
+   auto d_dofs = dofs.Read();
+   auto d_offsets = offsets.Read();
+   auto d_indices = indices.Read();
+   auto d_x = Reshape(x.Read(), nd, vd, ne);
+   auto d_y = Reshape(y.ReadWrite(), t?vd:ndofs, t?ndofs:vd);
+   MFEM_FORALL(k, N,
+   {
+      const int i = d_dofs[k];
+      const int offset = d_offsets[i];
+      const int nextOffset = d_offsets[i + 1];
+      for (int c = 0; c < vd; ++c)
+      {
+         double dofValue = 0;
+         for (int j = offset; j < nextOffset; ++j)
+         {
+            const int idx_j = (d_indices[j] >= 0) ? d_indices[j] : -1 - d_indices[j];
+            dofValue += (d_indices[j] >= 0) ? d_x(idx_j % nd, c,
+            idx_j / nd) : -d_x(idx_j % nd, c, idx_j / nd);
+         }
+         d_y(t?c:i,t?i:c) = dofValue;
+      }
+   });
+}
+
 void ElementRestriction::BooleanMask(Vector& y) const
 {
    // Assumes all elements have the same number of dofs
@@ -257,7 +335,13 @@ void ElementRestriction::BooleanMask(Vector& y) const
    auto d_offsets = offsets.HostRead();
    auto d_indices = indices.HostRead();
    auto d_x = Reshape(processed.HostReadWrite(), t?vd:ndofs, t?ndofs:vd);
-   auto d_y = Reshape(y.HostWrite(), nd, vd, ne);
+   double *h_y = y.HostWrite();
+   // Padding entries of mixed meshes are not set in the loop below
+   if (indices.Size() < nedofs)
+   {
+      for (int i = 0; i < vd*nedofs; ++i) { h_y[i] = 0.0; }
+   }
+   auto d_y = Reshape(h_y, nd, vd, ne);
    for (int i = 0; i < ndofs; ++i)
    {
       const int offset = d_offsets[i];
@@ -1034,6 +1118,157 @@ void L2FaceRestriction::MultTranspose(const Vector& x, Vector& y) const
    }
 }
 
+L2NormalDerivativeFaceRestriction::L2NormalDerivativeFaceRestriction(
+   const FiniteElementSpace &fes, const FaceType type)
+   : nf(fes.GetNFbyType(type)),
+     ndofs(fes.GetNDofs()),
+     dof(nf > 0 ? fes.GetTraceElement(
+            0, fes.GetMesh()->GetFaceBaseGeometry(0))->GetDof() : 0),
+     dof1d(fes.GetFE(0)->GetOrder()+1),
+     scatter_indices(dof1d*dof*2*nf),
+     scatter_weights(dof1d*dof*2*nf),
+     offsets(ndofs+1)
+{
+   const FiniteElement *fe = fes.GetFE(0);
+   const TensorBasisElement *tfe = dynamic_cast<const TensorBasisElement*>(fe);
+   MFEM_VERIFY(tfe != NULL && tfe->GetBasisType()==BasisType::GaussLobatto,
+               "Only Gauss-Lobatto basis is supported in "
+               "L2NormalDerivativeFaceRestriction.");
+   MFEM_VERIFY(fes.GetVDim() == 1, "vdim > 1 is not supported");
+   MFEM_VERIFY(fes.GetMesh()->Conforming(),
+               "Non-conforming meshes not yet supported with partial assembly.");
+   height = 2*nf*dof;
+   width = fes.GetVSize();
+   if (nf == 0) { return; }
+
+   // Derivatives of the 1D basis at the two end points
+   Vector shape(dof1d), dshape0(dof1d), dshape1(dof1d);
+   tfe->GetBasis1D().Eval(0.0, shape, dshape0);
+   tfe->GetBasis1D().Eval(1.0, shape, dshape1);
+
+   const int dim = fes.GetMesh()->Dimension();
+   const Table &e2dTable = fes.GetElementToDofTable();
+   const int *elementMap = e2dTable.GetJ();
+   const int elem_dofs = fe->GetDof();
+   Array<int> faceMap(dof);
+   auto I = Reshape(scatter_indices.HostWrite(), dof1d, dof, 2, nf);
+   auto W = Reshape(scatter_weights.HostWrite(), dof1d, dof, 2, nf);
+   int f_ind = 0;
+   for (int f = 0; f < fes.GetNF(); ++f)
+   {
+      int e[2], inf[2];
+      fes.GetMesh()->GetFaceElements(f, &e[0], &e[1]);
+      fes.GetMesh()->GetFaceInfos(f, &inf[0], &inf[1]);
+      if (!((type==FaceType::Interior && e[1]>=0) ||
+            (type==FaceType::Boundary && e[1]<0))) { continue; }
+      for (int s = 0; s < 2; ++s)
+      {
+         if (e[s] < 0)
+         {
+            for (int d = 0; d < dof; ++d)
+            {
+               for (int k = 0; k < dof1d; ++k)
+               {
+                  I(k,d,s,f_ind) = -1;
+                  W(k,d,s,f_ind) = 0.0;
+               }
+            }
+            continue;
+         }
+         const int face_id = inf[s] / 64;
+         GetFaceDofs(dim, face_id, dof1d, faceMap);
+         // Normal direction and end point of the face in the reference element
+         const int nd = (dim == 2) ? (face_id % 2 == 0 ? 1 : 0) :
+                        (face_id == 0 || face_id == 5) ? 2 :
+                        (face_id == 1 || face_id == 3) ? 1 : 0;
+         const bool end = (dim == 2) ? (face_id == 1 || face_id == 2) :
+                          (face_id == 2 || face_id == 3 || face_id == 5);
+         const int stride = (nd == 0) ? 1 : (nd == 1) ? dof1d : dof1d*dof1d;
+         const Vector &dshape = end ? dshape1 : dshape0;
+         for (int d = 0; d < dof; ++d)
+         {
+            const int pd = (s == 0) ? d :
+                           PermuteFaceL2(dim, inf[0] / 64, face_id,
+                                         inf[1] % 64, dof1d, d);
+            const int first = faceMap[pd] - (end ? (dof1d-1)*stride : 0);
+            for (int k = 0; k < dof1d; ++k)
+            {
+               I(k,d,s,f_ind) = elementMap[e[s]*elem_dofs + first + k*stride];
+               W(k,d,s,f_ind) = dshape(k);
+            }
+         }
+      }
+      f_ind++;
+   }
+   MFEM_VERIFY(f_ind==nf, "Unexpected number of faces.");
+
+   // Computation of gather_indices: the positions in scatter_indices of each
+   // L-vector dof
+   const int *h_indices = scatter_indices.HostRead();
+   const int size = scatter_indices.Size();
+   offsets = 0;
+   for (int i = 0; i < size; ++i)
+   {
+      if (h_indices[i] >= 0) { ++offsets[h_indices[i] + 1]; }
+   }
+   for (int i = 1; i <= ndofs; ++i)
+   {
+      offsets[i] += offsets[i - 1];
+   }
+   gather_indices.SetSize(offsets[ndofs]);
+   for (int i = 0; i < size; ++i)
+   {
+      if (h_indices[i] >= 0) { gather_indices[offsets[h_indices[i]]++] = i; }
+   }
+   for (int i = ndofs; i > 0; --i)
+   {
+      offsets[i] = offsets[i - 1];
+   }
+   offsets[0] = 0;
+}
+
+void L2NormalDerivativeFaceRestriction::Mult(const Vector &x, Vector &y) const
+{
+   const int nd1d = dof1d;
+   auto d_indices = Reshape(scatter_indices.Read(), nd1d, 2*nf*dof);
+   auto d_weights = Reshape(scatter_weights.Read(), nd1d, 2*nf*dof);
+   auto d_x = x.Read();
+   auto d_y = y.Write();
+   MFEM_FORALL(i, 2*nf*dof,
+   {
+      double dudn = 0.0;
+      for (int k = 0; k < nd1d; ++k)
+      {
+         const int idx = d_indices(k,i);
+         dudn += (idx < 0) ? 0.0 : d_weights(k,i) * d_x[idx];
+      }
+      d_y[i] = dudn;
+   });
+}
+
+void L2NormalDerivativeFaceRestriction::MultTranspose(const Vector &x,
+                                                      Vector &y) const
+{
+   const int nd1d = dof1d;
+   auto d_offsets = offsets.Read();
+   auto d_indices = gather_indices.Read();
+   auto d_weights = scatter_weights.Read();
+   auto d_x = x.Read();
+   auto d_y = y.ReadWrite();
+   MFEM_FORALL(i, ndofs,
+   {
+      const int offset = d_offsets[i];
+      const int nextOffset = d_offsets[i + 1];
+      double dofValue = 0.0;
+      for (int j = offset; j < nextOffset; ++j)
+      {
+         const int idx_j = d_indices[j];
+         dofValue += d_weights[idx_j] * d_x[idx_j / nd1d];
+      }
+      d_y[i] += dofValue;
+   });
+}
+
 int ToLexOrdering(const int dim, const int face_id, const int size1d,
                   const int index)
 {
@@ -27,7 +27,11 @@ enum class L2FaceValues : bool {SingleValued, DoubleValued};
 
 /// Operator that converts FiniteElementSpace L-vectors to E-vectors.
 /** Objects of this type are typically created and owned by FiniteElementSpace
-    objects, see FiniteElementSpace::GetElementRestriction(). */
+    objects, see FiniteElementSpace::GetElementRestriction().
+
+    On meshes with mixed element types, the E-vector stores the dofs of every
+    element padded to the largest number of element dofs. The padding entries
+    are ignored by MultTranspose(). */
 class ElementRestriction : public Operator
 {
 protected:
@@ -52,6 +56,16 @@ public:
    /// Compute MultTranspose without applying signs based on DOF orientations.
    void MultTransposeUnsigned(const Vector &x, Vector &y) const;
 
+   /** @brief Compute Mult() only for the elements listed in @a elems; the
+       entries of @a y of the other elements are not modified. */
+   void MultElements(const Array<int> &elems, const Vector &x,
+                     Vector &y) const;
+   /** @brief Compute MultTranspose() only at the (scalar) dofs listed in
+       @a dofs, for all vector components; the other entries of @a y are not
+       modified. */
+   void MultTransposeDofs(const Array<int> &dofs, const Vector &x,
+                          Vector &y) const;
+
    /// @brief Fills the E-vector y with `boolean` values 0.0 and 1.0 such that each
    /// each entry of the L-vector is uniquely represented in `y`.
    /** This means, the sum of the E-vector `y` is equal to the sum of the
@@ -59,6 +73,10 @@ public:
        emulate SetSubVector and its transpose on GPUs. This method is running on
        the host, since the `processed` array requires a large shared memory. */
    void BooleanMask(Vector& y) const;
+
+   /** @brief Return the map from the E-vector entries to the L-vector dofs.
+       Negative entries, -1-i, correspond to dof i with a sign flip. */
+   const Array<int> &GetGatherMap() const { return gatherMap; }
 };
 
 /// Operator that converts L2 FiniteElementSpace L-vectors to E-vectors.
@@ -128,6 +146,45 @@ public:
                      const L2FaceValues m = L2FaceValues::DoubleValued);
    void Mult(const Vector &x, Vector &y) const;
    void MultTranspose(const Vector &x, Vector &y) const;
+
+   /** @brief Return the L-vector dofs of the first (@a side = 0) or the second
+       (@a side = 1) element of each face dof. The entries of the second side
+       are -1 where there is no second element. */
+   const Array<int> &GetScatterIndices(int side) const
+   { return side == 0 ? scatter_indices1 : scatter_indices2; }
+};
+
+/** @brief Operator that computes the normal derivatives of an L2 function at
+    the face degrees of freedom. */
+/** For every face, the derivative of the function in each of the two
+    neighboring elements along the reference coordinate normal to the face is
+    evaluated at the face nodes. The output has the same (DoubleValued) layout
+    as L2FaceRestriction, (face dof, 2, face), where the values of the second
+    element are permuted to match the ordering of the first one and are zero on
+    boundary faces. Only scalar, tensor-product (Gauss-Lobatto) spaces on
+    conforming meshes are supported.
+
+    Note that, unlike Mult(), the method MultTranspose() adds its result to the
+    output vector. */
+class L2NormalDerivativeFaceRestriction : public Operator
+{
+protected:
+   const int nf;
+   const int ndofs;
+   const int dof;
+   const int dof1d;
+   /// L-vector dofs of the normal lines, layout (dof1d, dof, 2, nf).
+   Array<int> scatter_indices;
+   /// Normal derivatives of the 1D basis, layout (dof1d, dof, 2, nf).
+   Vector scatter_weights;
+   Array<int> offsets;
+   Array<int> gather_indices;
+
+public:
+   L2NormalDerivativeFaceRestriction(const FiniteElementSpace &fes,
+                                     const FaceType type);
+   void Mult(const Vector &x, Vector &y) const;
+   void MultTranspose(const Vector &x, Vector &y) const;
 };
 
 // Return the face degrees of freedom returned in Lexicographic order.
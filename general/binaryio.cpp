@@ -12,6 +12,16 @@
 #include "binaryio.hpp"
 #include "error.hpp"
 
+#include <fstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define MFEM_HAVE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace mfem
 {
 namespace bin_io
@@ -52,4 +62,79 @@ void WriteBase64(std::ostream &out, const void *bytes, size_t nbytes)
 }
 
 } // namespace mfem::bin_io
+
+mapped_ifstream::buffer::pos_type
+mapped_ifstream::buffer::seekoff(off_type off, std::ios_base::seekdir dir,
+                                 std::ios_base::openmode which)
+{
+   char *pos = (dir == std::ios_base::beg) ? eback() :
+               (dir == std::ios_base::cur) ? gptr() : egptr();
+   pos += off;
+   if (!(which & std::ios_base::in) || pos < eback() || pos > egptr())
+   {
+      return pos_type(off_type(-1));
+   }
+   setg(eback(), pos, egptr());
+   return pos_type(pos - eback());
+}
+
+mapped_ifstream::mapped_ifstream(const std::string &filename)
+   : std::istream(&buf), data(NULL), size(0), mapped(false)
+{
+#ifdef MFEM_HAVE_MMAP
+   const int fd = open(filename.c_str(), O_RDONLY);
+   struct stat st;
+   if (fd >= 0 && fstat(fd, &st) == 0)
+   {
+      size = st.st_size;
+      if (size == 0)
+      {
+         mapped = true;
+      }
+      else
+      {
+         void *ptr = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+         if (ptr != MAP_FAILED)
+         {
+            data = static_cast<char*>(ptr);
+            mapped = true;
+            // the file is read sequentially
+            madvise(ptr, size, MADV_SEQUENTIAL);
+         }
+      }
+   }
+   if (fd >= 0) { close(fd); }
+#endif
+   if (!mapped)
+   {
+      std::ifstream file(filename.c_str(), std::ios_base::binary);
+      if (file)
+      {
+         file.seekg(0, std::ios_base::end);
+         size = file.tellg();
+         file.seekg(0, std::ios_base::beg);
+         data = new char[size];
+         file.read(data, size);
+         if (!file) { delete [] data; data = NULL; size = 0; }
+      }
+   }
+   if (!data && !(mapped && size == 0))
+   {
+      setstate(std::ios_base::failbit);
+   }
+   buf.set(data, data + size);
+}
+
+mapped_ifstream::~mapped_ifstream()
+{
+#ifdef MFEM_HAVE_MMAP
+   if (mapped)
+   {
+      if (size > 0) { munmap(data, size); }
+      return;
+   }
+#endif
+   delete [] data;
+}
+
 } // namespace mfem
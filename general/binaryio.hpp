@@ -15,6 +15,7 @@
 #include "../config/config.hpp"
 
 #include <iostream>
+#include <string>
 #include <vector>
 
 namespace mfem
@@ -50,8 +51,63 @@ void AppendBytes(std::vector<char> &vec, const T &val)
 
 void WriteBase64(std::ostream &out, const void *bytes, size_t length);
 
+/// Marker written in binary headers to detect a mismatch of the byte order.
+const int byte_order_mark = 0x01020304;
+
+/// Write the @a n values in @a data to stream, without conversion.
+template <typename T>
+inline void WriteArray(std::ostream &os, const T *data, size_t n)
+{
+   os.write(reinterpret_cast<const char*>(data), n*sizeof(T));
+}
+
+/// Read @a n values from the stream into @a data, without conversion.
+template <typename T>
+inline void ReadArray(std::istream &is, T *data, size_t n)
+{
+   is.read(reinterpret_cast<char*>(data), n*sizeof(T));
+}
+
 } // namespace mfem::bin_io
 
+/** @brief Input stream reading a whole file through a read-only memory
+    mapping. */
+/** The data is read directly from the mapped pages, so the large block reads
+    of the binary MFEM formats (see Mesh::PrintBinary() and
+    GridFunction::SaveBinary()) copy the file contents only once. On systems
+    without mmap(), the file is read into memory when the stream is opened.
+    Compressed files are not supported, see mfem::ifgzstream for those. */
+class mapped_ifstream : public std::istream
+{
+protected:
+   class buffer : public std::streambuf
+   {
+   public:
+      void set(char *begin, char *end) { setg(begin, begin, end); }
+
+   protected:
+      virtual pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+                               std::ios_base::openmode which);
+      virtual pos_type seekpos(pos_type pos, std::ios_base::openmode which)
+      { return seekoff(off_type(pos), std::ios_base::beg, which); }
+   };
+
+   buffer buf;
+   char *data;
+   size_t size;
+   bool mapped;
+
+public:
+   /// Open and map the file @a filename; sets the failbit on failure.
+   explicit mapped_ifstream(const std::string &filename);
+
+   /// Return true if the file is memory mapped (rather than copied).
+   bool is_mapped() const { return mapped; }
+
+   /// Unmap the file.
+   virtual ~mapped_ifstream();
+};
+
 } // namespace mfem
 
 #endif
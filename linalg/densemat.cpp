@@ -3511,88 +3511,287 @@ DenseTensor &DenseTensor::operator=(double c)
    return *this;
 }
 
+// The batched kernels below are instantiated with T_M = m for the small sizes
+// 1 <= m <= MFEM_BATCH_MAX_M, and with T_M = 0 (run-time size) otherwise.
+#define MFEM_BATCH_MAX_M 8
+
+#define MFEM_BATCH_DISPATCH(m, kernel, ...)        \
+   switch (m)                                      \
+   {                                               \
+      case 1: kernel<1>(__VA_ARGS__); break;       \
+      case 2: kernel<2>(__VA_ARGS__); break;       \
+      case 3: kernel<3>(__VA_ARGS__); break;       \
+      case 4: kernel<4>(__VA_ARGS__); break;       \
+      case 5: kernel<5>(__VA_ARGS__); break;       \
+      case 6: kernel<6>(__VA_ARGS__); break;       \
+      case 7: kernel<7>(__VA_ARGS__); break;       \
+      case 8: kernel<8>(__VA_ARGS__); break;       \
+      default: kernel<0>(__VA_ARGS__); break;      \
+   }
+
+template<int T_M>
+static void BatchLUFactorKernel(const int m, const int NE, double *data,
+                                int *ipiv, bool *d_pivot_flag,
+                                const double TOL)
+{
+   const int M = T_M ? T_M : m;
+   auto data_all = mfem::Reshape(data, M, M, NE);
+   auto ipiv_all = mfem::Reshape(ipiv, M, NE);
+
+   MFEM_FORALL(e, NE,
+   {
+      if (!kernels::LUFactor<T_M>(&data_all(0,0,e), M, &ipiv_all(0,e), TOL))
+      {
+         d_pivot_flag[0] = false;
+      }
+   });
+}
+
 void BatchLUFactor(DenseTensor &Mlu, Array<int> &P, const double TOL)
 {
    const int m = Mlu.SizeI();
    const int NE = Mlu.SizeK();
    P.SetSize(m*NE);
 
-   auto data_all = mfem::Reshape(Mlu.ReadWrite(), m, m, NE);
-   auto ipiv_all = mfem::Reshape(P.Write(), m, NE);
    Array<bool> pivot_flag(1);
    pivot_flag[0] = true;
    bool *d_pivot_flag = pivot_flag.ReadWrite();
 
+   MFEM_BATCH_DISPATCH(m, BatchLUFactorKernel, m, NE, Mlu.ReadWrite(),
+                       P.Write(), d_pivot_flag, TOL);
+
+   MFEM_ASSERT(pivot_flag.HostRead()[0], "Batch LU factorization failed \n");
+}
+
+template<int T_M>
+static void BatchLUSolveKernel(const int m, const int NE, const double *data,
+                               const int *ipiv, double *x)
+{
+   const int M = T_M ? T_M : m;
+   auto data_all = mfem::Reshape(data, M, M, NE);
+   auto piv_all = mfem::Reshape(ipiv, M, NE);
+   auto x_all = mfem::Reshape(x, M, NE);
+
    MFEM_FORALL(e, NE,
    {
-      for (int i = 0; i < m; i++)
+      kernels::LUSolve<T_M>(&data_all(0,0,e), M, &piv_all(0,e), &x_all(0,e));
+   });
+}
+
+void BatchLUSolve(const DenseTensor &Mlu, const Array<int> &P, Vector &X)
+{
+   const int m = Mlu.SizeI();
+   const int NE = Mlu.SizeK();
+   MFEM_ASSERT(X.Size() == m*NE, "incompatible sizes");
+
+   MFEM_BATCH_DISPATCH(m, BatchLUSolveKernel, m, NE, Mlu.Read(), P.Read(),
+                       X.ReadWrite());
+}
+
+template<int T_M>
+static void BatchCholeskyFactorKernel(const int m, const int NE,
+                                      double *data, bool *d_pd_flag,
+                                      const double TOL)
+{
+   const int M = T_M ? T_M : m;
+   auto data_all = mfem::Reshape(data, M, M, NE);
+
+   MFEM_FORALL(e, NE,
+   {
+      if (!kernels::CholeskyFactor<T_M>(&data_all(0,0,e), M, TOL))
       {
-         // pivoting
-         {
-            int piv = i;
-            double a = fabs(data_all(piv,i,e));
-            for (int j = i+1; j < m; j++)
-            {
-               const double b = fabs(data_all(j,i,e));
-               if (b > a)
-               {
-                  a = b;
-                  piv = j;
-               }
-            }
-            ipiv_all(i,e) = piv;
-            if (piv != i)
-            {
-               // swap rows i and piv in both L and U parts
-               for (int j = 0; j < m; j++)
-               {
-                  mfem::kernels::internal::Swap<double>(data_all(i,j,e), data_all(piv,j,e));
-               }
-            }
-         } // pivot end
+         d_pd_flag[0] = false;
+      }
+   });
+}
 
-         if (abs(data_all(i,i,e)) <= TOL)
-         {
-            d_pivot_flag[0] = false;
-         }
+void BatchCholeskyFactor(DenseTensor &Mch, const double TOL)
+{
+   const int m = Mch.SizeI();
+   const int NE = Mch.SizeK();
 
-         const double a_ii_inv = 1.0 / data_all(i,i,e);
-         for (int j = i+1; j < m; j++)
-         {
-            data_all(j,i,e) *= a_ii_inv;
-         }
+   Array<bool> pd_flag(1);
+   pd_flag[0] = true;
+   bool *d_pd_flag = pd_flag.ReadWrite();
 
-         for (int k = i+1; k < m; k++)
-         {
-            const double a_ik = data_all(i,k,e);
-            for (int j = i+1; j < m; j++)
-            {
-               data_all(j,k,e) -= a_ik * data_all(j,i,e);
-            }
-         }
+   MFEM_BATCH_DISPATCH(m, BatchCholeskyFactorKernel, m, NE, Mch.ReadWrite(),
+                       d_pd_flag, TOL);
 
-      } // m loop
+   MFEM_ASSERT(pd_flag.HostRead()[0],
+               "Batch Cholesky factorization failed \n");
+}
+
+template<int T_M>
+static void BatchCholeskySolveKernel(const int m, const int NE,
+                                     const double *data, double *x)
+{
+   const int M = T_M ? T_M : m;
+   auto data_all = mfem::Reshape(data, M, M, NE);
+   auto x_all = mfem::Reshape(x, M, NE);
 
+   MFEM_FORALL(e, NE,
+   {
+      kernels::CholeskySolve<T_M>(&data_all(0,0,e), M, &x_all(0,e));
    });
+}
 
-   MFEM_ASSERT(pivot_flag.HostRead()[0], "Batch LU factorization failed \n");
+void BatchCholeskySolve(const DenseTensor &Mch, Vector &X)
+{
+   const int m = Mch.SizeI();
+   const int NE = Mch.SizeK();
+   MFEM_ASSERT(X.Size() == m*NE, "incompatible sizes");
+
+   MFEM_BATCH_DISPATCH(m, BatchCholeskySolveKernel, m, NE, Mch.Read(),
+                       X.ReadWrite());
 }
 
-void BatchLUSolve(const DenseTensor &Mlu, const Array<int> &P, Vector &X)
+template<int T_M>
+static void BatchInverseKernel(const int m, const int NE, const double *data,
+                               const int *ipiv, double *inv)
 {
+   const int M = T_M ? T_M : m;
+   auto data_all = mfem::Reshape(data, M, M, NE);
+   auto piv_all = mfem::Reshape(ipiv, M, NE);
+   auto inv_all = mfem::Reshape(inv, M, M, NE);
 
+   MFEM_FORALL(e, NE,
+   {
+      for (int j = 0; j < M; j++)
+      {
+         for (int i = 0; i < M; i++)
+         {
+            inv_all(i,j,e) = (i == j) ? 1.0 : 0.0;
+         }
+         kernels::LUSolve<T_M>(&data_all(0,0,e), M, &piv_all(0,e),
+                               &inv_all(0,j,e));
+      }
+   });
+}
+
+void BatchInverseMatrix(const DenseTensor &Mlu, const Array<int> &P,
+                        DenseTensor &Minv)
+{
    const int m = Mlu.SizeI();
    const int NE = Mlu.SizeK();
+   Minv.SetSize(m, m, NE);
 
-   auto data_all = mfem::Reshape(Mlu.Read(), m, m, NE);
-   auto piv_all = mfem::Reshape(P.Read(), m, NE);
-   auto x_all = mfem::Reshape(X.ReadWrite(), m, NE);
+   MFEM_BATCH_DISPATCH(m, BatchInverseKernel, m, NE, Mlu.Read(), P.Read(),
+                       Minv.Write());
+}
+
+template<int T_M>
+static void BatchMultKernel(const int m, const int n, const int NE,
+                            const double *data, const double *x, double *y)
+{
+   const int M = T_M ? T_M : m;
+   auto A = mfem::Reshape(data, M, n, NE);
+   auto X = mfem::Reshape(x, n, NE);
+   auto Y = mfem::Reshape(y, M, NE);
 
    MFEM_FORALL(e, NE,
    {
-      kernels::LUSolve(&data_all(0, 0,e), m, &piv_all(0, e), &x_all(0,e));
+      for (int i = 0; i < M; i++)
+      {
+         double y_i = 0.0;
+         for (int j = 0; j < n; j++)
+         {
+            y_i += A(i,j,e) * X(j,e);
+         }
+         Y(i,e) = y_i;
+      }
    });
+}
+
+void BatchMult(const DenseTensor &A, const Vector &X, Vector &Y)
+{
+   const int m = A.SizeI();
+   const int n = A.SizeJ();
+   const int NE = A.SizeK();
+   MFEM_ASSERT(X.Size() == n*NE, "incompatible sizes");
+   Y.SetSize(m*NE);
+
+   // Square blocks are the common case: use the specialized kernels
+   if (m == n)
+   {
+      MFEM_BATCH_DISPATCH(m, BatchMultKernel, m, m, NE, A.Read(), X.Read(),
+                          Y.Write());
+   }
+   else
+   {
+      BatchMultKernel<0>(m, n, NE, A.Read(), X.Read(), Y.Write());
+   }
+}
+
+#undef MFEM_BATCH_DISPATCH
+#undef MFEM_BATCH_MAX_M
 
+
+BatchedBlockDiagonalSolver::BatchedBlockDiagonalSolver(
+   const DenseTensor &blocks, Type _type)
+   : Solver(blocks.SizeI()*blocks.SizeK()), type(_type)
+{
+   SetBlocks(blocks);
+}
+
+void BatchedBlockDiagonalSolver::SetBlocks(const DenseTensor &blocks)
+{
+   const int m = blocks.SizeI();
+   const int NE = blocks.SizeK();
+   MFEM_VERIFY(blocks.SizeJ() == m, "the blocks must be square");
+   height = width = m*NE;
+
+   factors.SetSize(m, m, NE);
+   const int N = m*m*NE;
+   auto d_blocks = blocks.Read();
+   auto d_factors = factors.Write();
+   MFEM_FORALL(i, N, d_factors[i] = d_blocks[i];);
+
+   switch (type)
+   {
+      case LU:
+         BatchLUFactor(factors, pivots);
+         break;
+      case CHOLESKY:
+         BatchCholeskyFactor(factors);
+         break;
+      case INVERSE:
+      {
+         DenseTensor lu(factors);
+         BatchLUFactor(lu, pivots);
+         BatchInverseMatrix(lu, pivots, factors);
+         pivots.DeleteAll();
+         break;
+      }
+   }
+}
+
+void BatchedBlockDiagonalSolver::SetOperator(const Operator &op)
+{
+   MFEM_ABORT("BatchedBlockDiagonalSolver::SetOperator is not supported, "
+              "use SetBlocks()");
+}
+
+void BatchedBlockDiagonalSolver::Mult(const Vector &x, Vector &y) const
+{
+   MFEM_ASSERT(x.Size() == width, "incompatible sizes");
+   if (type == INVERSE)
+   {
+      BatchMult(factors, x, y);
+      return;
+   }
+   y.SetSize(height);
+   const int N = height;
+   auto d_x = x.Read();
+   auto d_y = y.Write();
+   MFEM_FORALL(i, N, d_y[i] = d_x[i];);
+   if (type == LU)
+   {
+      BatchLUSolve(factors, pivots, y);
+   }
+   else
+   {
+      BatchCholeskySolve(factors, y);
+   }
 }
 
 } // namespace mfem
@@ -884,6 +884,76 @@ void BatchLUFactor(DenseTensor &Mlu, Array<int> &P, const double TOL = 0.0);
     dimension m x n. */
 void BatchLUSolve(const DenseTensor &Mlu, const Array<int> &P, Vector &X);
 
+/** @brief Compute the Cholesky factorization of a batch of matrices
+
+    Factorize n symmetric positive definite matrices of size (m x m) stored in
+    a dense tensor, overwriting their lower triangular parts with the Cholesky
+    factors L, such that L.L^t = A.
+
+    @param [in, out] Mch batch of square matrices - dimension m x m x n.
+    @param [in] TOL optional fuzzy comparison tolerance. Defaults to 0.0. */
+void BatchCholeskyFactor(DenseTensor &Mch, const double TOL = 0.0);
+
+/** @brief Solve batch linear systems
+
+    Assuming L.L^t = A for n factored matrices (m x m), compute x <- A^{-1} x,
+    for n companion vectors.
+
+    @param [in] Mch batch of Cholesky factors - dimension m x m x n.
+    @param [in, out] X vector storing right-hand side and then solution -
+    dimension m x n. */
+void BatchCholeskySolve(const DenseTensor &Mch, Vector &X);
+
+/** @brief Compute the inverses of a batch of LU factored matrices
+
+    @param [in] Mlu batch of LU factors, see BatchLUFactor() - dimension
+    m x m x n.
+    @param [in] P array storing pivot information - dimension m x n.
+    @param [out] Minv batch of inverse matrices - dimension m x m x n. */
+void BatchInverseMatrix(const DenseTensor &Mlu, const Array<int> &P,
+                        DenseTensor &Minv);
+
+/** @brief Compute the batch of matrix-vector products y <- A x
+
+    @param [in] A batch of matrices - dimension m x k x n.
+    @param [in] X vector of dimension k x n.
+    @param [out] Y vector of dimension m x n. */
+void BatchMult(const DenseTensor &A, const Vector &X, Vector &Y);
+
+/** @brief Solver for a block diagonal matrix with n dense (m x m) blocks,
+    stored in a DenseTensor, using the batched factorizations above.
+
+    The vectors are ordered by blocks, i.e. they have dimension m x n. With the
+    INVERSE type, the inverses of the blocks are computed once and Mult() is a
+    batched matrix-vector product, which is usually the fastest choice when the
+    solver is applied many times. */
+class BatchedBlockDiagonalSolver : public Solver
+{
+public:
+   enum Type { LU, CHOLESKY, INVERSE };
+
+protected:
+   Type type;
+   DenseTensor factors;
+   Array<int> pivots;
+
+public:
+   /** @brief Factor the blocks (m x m x n) with the given factorization
+       @a type. The CHOLESKY type requires symmetric positive definite
+       blocks. */
+   BatchedBlockDiagonalSolver(const DenseTensor &blocks, Type _type = LU);
+
+   /// Replace the blocks and compute their factorizations.
+   void SetBlocks(const DenseTensor &blocks);
+
+   Type GetType() const { return type; }
+
+   /// Not supported: the operator is given by the blocks, see SetBlocks().
+   virtual void SetOperator(const Operator &op);
+
+   virtual void Mult(const Vector &x, Vector &y) const;
+};
+
 
 // Inline methods
 
@@ -1377,41 +1377,183 @@ have_aa:
 }
 
 
+/** @brief Compute the LU factorization with partial pivoting of the (m x m)
+    matrix @a data, overwriting it with the factors, such that L.U = P.A.
+
+    The template parameter @a T_M, if not zero, is the compile-time value of
+    @a m, used in the batched kernels to unroll the loops for small sizes.
+
+    @param [in, out] data matrix A and then its LU factors
+    @param [in] m square matrix height
+    @param [out] ipiv array storing pivot information
+    @param [in] tol fuzzy comparison tolerance for the pivots
+    @return false if a pivot is not larger than @a tol in absolute value. */
+template<int T_M = 0>
+MFEM_HOST_DEVICE inline
+bool LUFactor(double *data, const int m, int *ipiv, const double tol = 0.0)
+{
+   const int M = T_M ? T_M : m;
+   bool pivot_flag = true;
+   for (int i = 0; i < M; i++)
+   {
+      // pivoting
+      int piv = i;
+      double a = fabs(data[i + i * M]);
+      for (int j = i + 1; j < M; j++)
+      {
+         const double b = fabs(data[j + i * M]);
+         if (b > a)
+         {
+            a = b;
+            piv = j;
+         }
+      }
+      ipiv[i] = piv;
+      if (piv != i)
+      {
+         // swap rows i and piv in both L and U parts
+         for (int j = 0; j < M; j++)
+         {
+            internal::Swap<double>(data[i + j * M], data[piv + j * M]);
+         }
+      }
+
+      if (fabs(data[i + i * M]) <= tol)
+      {
+         pivot_flag = false;
+      }
+
+      const double a_ii_inv = 1.0 / data[i + i * M];
+      for (int j = i + 1; j < M; j++)
+      {
+         data[j + i * M] *= a_ii_inv;
+      }
+
+      for (int k = i + 1; k < M; k++)
+      {
+         const double a_ik = data[i + k * M];
+         for (int j = i + 1; j < M; j++)
+         {
+            data[j + k * M] -= a_ik * data[j + i * M];
+         }
+      }
+   }
+   return pivot_flag;
+}
+
 /// Assuming L.U = P.A for a factored matrix (m x m),
-//  compute x <- A x
+//  compute x <- A^{-1} x
 //
 // @param [in] data LU factorization of A
 // @param [in] m square matrix height
 // @param [in] ipiv array storing pivot information
 // @param [in, out] x vector storing right-hand side and then solution
+template<int T_M = 0>
 MFEM_HOST_DEVICE
 inline void LUSolve(const double *data, const int m, const int *ipiv,
                     double *x)
 {
+   const int M = T_M ? T_M : m;
+
    // X <- P X
-   for (int i = 0; i < m; i++)
+   for (int i = 0; i < M; i++)
    {
       internal::Swap<double>(x[i], x[ipiv[i]]);
    }
 
    // X <- L^{-1} X
-   for (int j = 0; j < m; j++)
+   for (int j = 0; j < M; j++)
    {
       const double x_j = x[j];
-      for (int i = j + 1; i < m; i++)
+      for (int i = j + 1; i < M; i++)
       {
-         x[i] -= data[i + j * m] * x_j;
+         x[i] -= data[i + j * M] * x_j;
       }
    }
 
    // X <- U^{-1} X
-   for (int j = m - 1; j >= 0; j--)
+   for (int j = M - 1; j >= 0; j--)
    {
-      const double x_j = (x[j] /= data[j + j * m]);
+      const double x_j = (x[j] /= data[j + j * M]);
       for (int i = 0; i < j; i++)
       {
-         x[i] -= data[i + j * m] * x_j;
+         x[i] -= data[i + j * M] * x_j;
+      }
+   }
+}
+
+/** @brief Compute the Cholesky factorization A = L.L^t of the symmetric
+    positive definite (m x m) matrix @a data, overwriting its lower triangular
+    part with L; the strictly upper triangular part is not referenced.
+
+    @param [in, out] data matrix A and then its Cholesky factor
+    @param [in] m square matrix height
+    @param [in] tol fuzzy comparison tolerance for the diagonal of L^2
+    @return false if the matrix is not numerically positive definite. */
+template<int T_M = 0>
+MFEM_HOST_DEVICE inline
+bool CholeskyFactor(double *data, const int m, const double tol = 0.0)
+{
+   const int M = T_M ? T_M : m;
+   bool pd_flag = true;
+   for (int j = 0; j < M; j++)
+   {
+      double d = data[j + j * M];
+      for (int k = 0; k < j; k++)
+      {
+         d -= data[j + k * M] * data[j + k * M];
+      }
+      if (d <= tol)
+      {
+         pd_flag = false;
+      }
+      const double l_jj = sqrt(fabs(d));
+      data[j + j * M] = l_jj;
+
+      const double l_jj_inv = 1.0 / l_jj;
+      for (int i = j + 1; i < M; i++)
+      {
+         double a_ij = data[i + j * M];
+         for (int k = 0; k < j; k++)
+         {
+            a_ij -= data[i + k * M] * data[j + k * M];
+         }
+         data[i + j * M] = a_ij * l_jj_inv;
+      }
+   }
+   return pd_flag;
+}
+
+/// Assuming L.L^t = A for a factored matrix (m x m), compute x <- A^{-1} x
+//
+// @param [in] data Cholesky factor L of A, stored in the lower triangle
+// @param [in] m square matrix height
+// @param [in, out] x vector storing right-hand side and then solution
+template<int T_M = 0>
+MFEM_HOST_DEVICE
+inline void CholeskySolve(const double *data, const int m, double *x)
+{
+   const int M = T_M ? T_M : m;
+
+   // X <- L^{-1} X
+   for (int j = 0; j < M; j++)
+   {
+      const double x_j = (x[j] /= data[j + j * M]);
+      for (int i = j + 1; i < M; i++)
+      {
+         x[i] -= data[i + j * M] * x_j;
+      }
+   }
+
+   // X <- L^{-t} X
+   for (int i = M - 1; i >= 0; i--)
+   {
+      double x_i = x[i];
+      for (int j = i + 1; j < M; j++)
+      {
+         x_i -= data[j + i * M] * x[j];
       }
+      x[i] = x_i / data[i + i * M];
    }
 }
 
@@ -18,6 +18,7 @@
 #include "operator.hpp"
 #include "matrix.hpp"
 #include "sparsemat.hpp"
+#include "sparseformats.hpp"
 #include "complex_operator.hpp"
 #include "blockvector.hpp"
 #include "blockmatrix.hpp"
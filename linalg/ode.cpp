@@ -11,6 +11,7 @@
 
 #include "operator.hpp"
 #include "ode.hpp"
+#include "../general/forall.hpp"
 
 namespace mfem
 {
@@ -344,6 +345,257 @@ const double RK8Solver::c[] =
 };
 
 
+void LowStorageRKSolver::Init(TimeDependentOperator &_f)
+{
+   ODESolver::Init(_f);
+   dx.SetSize(f->Width(), mem_type);
+   k.SetSize(f->Width(), mem_type);
+}
+
+void LowStorageRKSolver::Step(Vector &x, double &t, double &dt)
+{
+   const int n = x.Size();
+   for (int i = 0; i < s; i++)
+   {
+      f->SetTime(t + C[i]*dt);
+      f->Mult(x, k);
+      const double a = A[i], b = B[i], h = dt;
+      const bool first = (i == 0);
+      auto X = x.ReadWrite();
+      auto DX = dx.ReadWrite();
+      auto K = k.Read();
+      MFEM_FORALL(j, n,
+      {
+         const double d = first ? h*K[j] : a*DX[j] + h*K[j];
+         DX[j] = d;
+         X[j] += b*d;
+      });
+   }
+   t += dt;
+}
+
+const double LowStorageRK3Solver::A[] = { 0., -5./9., -153./128. };
+const double LowStorageRK3Solver::B[] = { 1./3., 15./16., 8./15. };
+const double LowStorageRK3Solver::C[] = { 0., 1./3., 3./4. };
+
+const double LowStorageRK4Solver::A[] =
+{
+   0.,
+   -567301805773./1357537059087.,
+   -2404267990393./2016746695238.,
+   -3550918686646./2091501179385.,
+   -1275806237668./842570457699.
+};
+const double LowStorageRK4Solver::B[] =
+{
+   1432997174477./9575080441755.,
+   5161836677717./13612068292357.,
+   1720146321549./2090206949498.,
+   3134564353537./4481467310338.,
+   2277821191437./14882151754819.
+};
+const double LowStorageRK4Solver::C[] =
+{
+   0.,
+   1432997174477./9575080441755.,
+   2526269341429./6820363962896.,
+   2006345519317./3224310063776.,
+   2802321613138./2924317926251.
+};
+
+
+void LowStorage3SStarSolver::Init(TimeDependentOperator &_f)
+{
+   ODESolver::Init(_f);
+   S.SetSize(f->Width(), mem_type);
+   xn.SetSize(f->Width(), mem_type);
+   k.SetSize(f->Width(), mem_type);
+}
+
+void LowStorage3SStarSolver::Step(Vector &x, double &t, double &dt)
+{
+   const int n = x.Size();
+   xn = x;
+   for (int i = 0; i < s; i++)
+   {
+      f->SetTime(t + C[i]*dt);
+      f->Mult(x, k);
+      const double g1 = G1[i], g2 = G2[i], g3 = G3[i], b = B[i]*dt, d = D[i];
+      const bool first = (i == 0);
+      auto X = x.ReadWrite();
+      auto SS = S.ReadWrite();
+      auto XN = xn.Read();
+      auto K = k.Read();
+      MFEM_FORALL(j, n,
+      {
+         const double sj = first ? d*X[j] : SS[j] + d*X[j];
+         SS[j] = sj;
+         X[j] = g1*X[j] + g2*sj + g3*XN[j] + b*K[j];
+      });
+   }
+   t += dt;
+}
+
+const double LowStorage3SStarRK4Solver::G1[] =
+{
+   1.,
+   -0.063103813046998997,
+   -0.4971314983712451,
+   -0.20811793124785685,
+   1.077023097264012
+};
+const double LowStorage3SStarRK4Solver::G2[] =
+{
+   0.,
+   0.98324971269965489,
+   0.30180068728527693,
+   0.60079361096311978,
+   -0.23647827704870261
+};
+const double LowStorage3SStarRK4Solver::G3[] =
+{
+   0.,
+   -0.16764913630457623,
+   0.59197438430973237,
+   -0.88277089387319596,
+   0.62574688075402196
+};
+const double LowStorage3SStarRK4Solver::B[] =
+{
+   0.25718351561617747,
+   0.48034252609019595,
+   0.60052841212100616,
+   0.23809625196858972,
+   0.24916105437121031
+};
+const double LowStorage3SStarRK4Solver::C[] =
+{
+   0.,
+   0.25718351561617747,
+   0.5277670181305063,
+   0.63603442659178977,
+   0.8825172380389823
+};
+const double LowStorage3SStarRK4Solver::D[] =
+{
+   1.,
+   0.25171961248009345,
+   1.7474687664579358,
+   0.48102310628264811,
+   -0.50839527111108773
+};
+const double LowStorage3SStarRK5Solver::G1[] =
+{
+   1.,
+   0.16241424726125203,
+   -0.43442280573878067,
+   -0.13241177933065876,
+   0.45000529487653557,
+   -0.29795205332557329,
+   -0.1448488185553499
+};
+const double LowStorage3SStarRK5Solver::G2[] =
+{
+   0.,
+   0.64906227696613084,
+   1.2223998243684915,
+   0.33122403528124289,
+   -0.48701629317355055,
+   0.71622803053463968,
+   0.42788819259307481
+};
+const double LowStorage3SStarRK5Solver::G3[] =
+{
+   0.,
+   -0.40160184694415291,
+   -0.89937898488821411,
+   0.47655637512397342,
+   1.2938331903303542,
+   -0.68150187726349221,
+   -0.42127909396132823
+};
+const double LowStorage3SStarRK5Solver::B[] =
+{
+   0.35720913539591503,
+   0.39714904301723442,
+   0.13778407194567874,
+   0.28300689347296609,
+   0.69001745839279571,
+   0.27836485694571267,
+   0.31371273827767976
+};
+const double LowStorage3SStarRK5Solver::C[] =
+{
+   0.,
+   0.35720913539591503,
+   0.6659630521602975,
+   0.24547746975236043,
+   0.36384021966219449,
+   0.76732840297782534,
+   0.85632315263198011
+};
+const double LowStorage3SStarRK5Solver::D[] =
+{
+   1.,
+   0.90919676533221783,
+   0.,
+   0.070899285516862268,
+   -0.45275806312015709,
+   1.2363822887750151,
+   0.89641323413508622
+};
+
+void LowStorageSSPRK4Solver::Init(TimeDependentOperator &_f)
+{
+   ODESolver::Init(_f);
+   y.SetSize(f->Width(), mem_type);
+   k.SetSize(f->Width(), mem_type);
+}
+
+void LowStorageSSPRK4Solver::Step(Vector &x, double &t, double &dt)
+{
+   // SSPRK(10,4): with F(x) = x + dt/6 f(x),
+   //   y = x, x = F^5(x), y = y/25 + 9/25 x, x = 15 y - 5 x,
+   //   x = F^4(x), x = y + 3/5 x + dt/10 f(x)
+   // The mixing of the registers is fused with the stage updates.
+   const int n = x.Size();
+   const double h = dt;
+   y = x;
+   for (int i = 0; i < 9; i++)
+   {
+      // the stage times are 0, 1/6, ..., 4/6 and then 1/3, ..., 5/6
+      const double c = (i < 5) ? i/6. : (i-3)/6.;
+      f->SetTime(t + c*dt);
+      f->Mult(x, k);
+      const bool mix = (i == 4);
+      auto X = x.ReadWrite();
+      auto Y = y.ReadWrite();
+      auto K = k.Read();
+      MFEM_FORALL(j, n,
+      {
+         const double xj = X[j] + h/6.*K[j];
+         if (mix)
+         {
+            const double yj = Y[j]/25. + 9./25.*xj;
+            Y[j] = yj;
+            X[j] = 15.*yj - 5.*xj;
+         }
+         else
+         {
+            X[j] = xj;
+         }
+      });
+   }
+   f->SetTime(t + dt);
+   f->Mult(x, k);
+   auto X = x.ReadWrite();
+   auto Y = y.Read();
+   auto K = k.Read();
+   MFEM_FORALL(j, n, X[j] = Y[j] + 3./5.*X[j] + h/10.*K[j];);
+   t += dt;
+}
+
+
 AdamsBashforthSolver::AdamsBashforthSolver(int _s, const double *_a)
 {
    s = 0;
@@ -634,6 +886,385 @@ void SDIRK33Solver::Step(Vector &x, double &t, double &dt)
 }
 
 
+AdaptiveRKSolver::AdaptiveRKSolver(int q)
+   : q(q), rel_tol(1e-6), abs_tol(1e-8), safety(0.9), min_factor(0.2),
+     max_factor(5.0), dt_min(0.0), dt_max(infinity()), interpolate(true),
+     started(false), num_steps(0), num_rejected(0)
+{
+#ifdef MFEM_USE_MPI
+   comm = MPI_COMM_NULL;
+#endif
+}
+
+#ifdef MFEM_USE_MPI
+AdaptiveRKSolver::AdaptiveRKSolver(int q, MPI_Comm comm)
+   : AdaptiveRKSolver(q)
+{
+   this->comm = comm;
+}
+#endif
+
+void AdaptiveRKSolver::Init(TimeDependentOperator &_f)
+{
+   ODESolver::Init(_f);
+   const int n = f->Width();
+   x0.SetSize(n, mem_type);
+   x1.SetSize(n, mem_type);
+   err.SetSize(n, mem_type);
+   w.SetSize(n, mem_type);
+   started = false;
+   num_steps = num_rejected = 0;
+}
+
+double AdaptiveRKSolver::ErrorNorm()
+{
+   const int n = err.Size();
+   const double rtol = rel_tol, atol = abs_tol;
+   auto E = err.Read();
+   auto X0 = x0.Read();
+   auto X1 = x1.Read();
+   auto W = w.Write();
+   MFEM_FORALL(i, n,
+   {
+      const double scale = atol + rtol*fmax(fabs(X0[i]), fabs(X1[i]));
+      W[i] = E[i] / scale;
+   });
+   double sums[2] = { w*w, (double) n };
+#ifdef MFEM_USE_MPI
+   if (comm != MPI_COMM_NULL)
+   {
+      MPI_Allreduce(MPI_IN_PLACE, sums, 2, MPI_DOUBLE, MPI_SUM, comm);
+   }
+#endif
+   return (sums[1] > 0.0) ? sqrt(sums[0]/sums[1]) : 0.0;
+}
+
+void AdaptiveRKSolver::HermiteInterpolate(double theta, const Vector &f0,
+                                          const Vector &f1, Vector &x) const
+{
+   const double dt = t1 - t0;
+   const double h00 = (2.*theta - 3.)*theta*theta + 1.;
+   const double h01 = 1. - h00;
+   const double h10 = ((theta - 2.)*theta + 1.)*theta*dt;
+   const double h11 = (theta - 1.)*theta*theta*dt;
+   const int n = x.Size();
+   auto X0 = x0.Read();
+   auto X1 = x1.Read();
+   auto F0 = f0.Read();
+   auto F1 = f1.Read();
+   auto X = x.Write();
+   MFEM_FORALL(i, n,
+   {
+      X[i] = h00*X0[i] + h01*X1[i] + h10*F0[i] + h11*F1[i];
+   });
+}
+
+void AdaptiveRKSolver::Step(Vector &x, double &t, double &dt)
+{
+   const double t_target = t + dt;
+   if (!started || t != t_out)
+   {
+      // (Re)start the integration from (t, x)
+      x1 = x;
+      t0 = t1 = t;
+      h = std::min(dt, dt_max);
+      err_prev = 1.0;
+      started = true;
+      restarted = true;
+   }
+
+   // Internal steps are taken until t1 reaches the target time, up to a
+   // small relative tolerance
+   const double t_eps = 1e-12*std::max(fabs(t_target), fabs(dt));
+   double last_dt = h;
+   while (t1 < t_target - t_eps)
+   {
+      // Start a new step from the last accepted solution
+      x0.Swap(x1);
+      t0 = t1;
+      new_step = true;
+      bool rejected = false;
+      while (true)
+      {
+         // Without interpolation, the step is shortened to end at the target
+         const bool shortened = !interpolate && t0 + h > t_target;
+         const double dt_step = shortened ? t_target - t0 : h;
+         MFEM_VERIFY(dt_step > dt_min && t0 + dt_step > t0,
+                     "time step size too small: " << dt_step << " at t = "
+                     << t0);
+
+         TrialStep(x0, t0, dt_step, x1, err);
+         new_step = restarted = false;
+         const double err_norm = ErrorNorm();
+
+         if (err_norm <= 1.0)
+         {
+            // Accept the step. The PI controller proposes the next step
+            // size, unless the step was shortened.
+            if (!shortened)
+            {
+               double factor = (err_norm == 0.0) ? max_factor :
+                               safety*pow(err_norm, -0.7/(q+1))*
+                               pow(err_prev, 0.4/(q+1));
+               factor = std::max(min_factor, std::min(max_factor, factor));
+               if (rejected) { factor = std::min(factor, 1.0); }
+               h = std::min(dt_step*factor, dt_max);
+               err_prev = std::max(err_norm, 1e-4);
+            }
+            t1 = t0 + dt_step;
+            last_dt = dt_step;
+            num_steps++;
+            break;
+         }
+
+         // Reject the step and retry with a smaller one
+         const double factor = safety*pow(err_norm, -1.0/(q+1));
+         h = dt_step*std::max(min_factor, std::min(factor, 1.0));
+         rejected = true;
+         num_rejected++;
+      }
+   }
+
+   if (t1 - t_target <= t_eps || t1 == t0)
+   {
+      x = x1;
+   }
+   else
+   {
+      Interpolate((t_target - t0)/(t1 - t0), x);
+   }
+   t = t_out = t_target;
+   dt = last_dt;
+}
+
+void AdaptiveRKSolver::Run(Vector &x, double &t, double &dt, double tf)
+{
+   double dt_run = tf - t;
+   if (dt_run > 0.0) { Step(x, t, dt_run); }
+   dt = dt_run;
+}
+
+
+ExplicitEmbeddedRKSolver::ExplicitEmbeddedRKSolver(
+   int _s, const double *_a, const double *_b, const double *_c,
+   const double *_e, bool _fsal, int q)
+   : AdaptiveRKSolver(q), s(_s), a(_a), b(_b), c(_c), e(_e), fsal(_fsal)
+{
+   k = new Vector[s];
+}
+
+#ifdef MFEM_USE_MPI
+ExplicitEmbeddedRKSolver::ExplicitEmbeddedRKSolver(
+   int _s, const double *_a, const double *_b, const double *_c,
+   const double *_e, bool _fsal, int q, MPI_Comm comm)
+   : AdaptiveRKSolver(q, comm), s(_s), a(_a), b(_b), c(_c), e(_e),
+     fsal(_fsal)
+{
+   k = new Vector[s];
+}
+#endif
+
+void ExplicitEmbeddedRKSolver::Init(TimeDependentOperator &_f)
+{
+   AdaptiveRKSolver::Init(_f);
+   const int n = f->Width();
+   y.SetSize(n, mem_type);
+   for (int i = 0; i < s; i++)
+   {
+      k[i].SetSize(n, mem_type);
+   }
+}
+
+void ExplicitEmbeddedRKSolver::TrialStep(const Vector &x, double t, double dt,
+                                         Vector &x_new, Vector &x_err)
+{
+   // The first stage only changes with x; with FSAL, it is the last stage of
+   // the previous accepted step.
+   if (new_step)
+   {
+      if (fsal && !restarted)
+      {
+         k[0].Swap(k[s-1]);
+      }
+      else
+      {
+         f->SetTime(t);
+         f->Mult(x, k[0]);
+      }
+   }
+   for (int l = 0, i = 1; i < s; i++)
+   {
+      add(x, a[l++]*dt, k[0], y);
+      for (int j = 1; j < i; j++)
+      {
+         y.Add(a[l++]*dt, k[j]);
+      }
+
+      f->SetTime(t + c[i-1]*dt);
+      f->Mult(y, k[i]);
+   }
+   if (fsal)
+   {
+      // The last stage was evaluated at the new solution
+      x_new = y;
+   }
+   else
+   {
+      x_new = x;
+      for (int i = 0; i < s; i++) { x_new.Add(b[i]*dt, k[i]); }
+   }
+   x_err = 0.0;
+   for (int i = 0; i < s; i++)
+   {
+      if (e[i] != 0.0) { x_err.Add(e[i]*dt, k[i]); }
+   }
+}
+
+void ExplicitEmbeddedRKSolver::Interpolate(double theta, Vector &x) const
+{
+   if (fsal)
+   {
+      HermiteInterpolate(theta, k[0], k[s-1], x);
+   }
+   else
+   {
+      // Without FSAL, the derivative at x1 is not available
+      add(1.0 - theta, x0, theta, x1, x);
+   }
+}
+
+ExplicitEmbeddedRKSolver::~ExplicitEmbeddedRKSolver()
+{
+   delete [] k;
+}
+
+const double BogackiShampine32Solver::a[] =
+{
+   1./2.,
+   0., 3./4.,
+   2./9., 1./3., 4./9.
+};
+const double BogackiShampine32Solver::b[] = { 2./9., 1./3., 4./9., 0. };
+const double BogackiShampine32Solver::c[] = { 1./2., 3./4., 1. };
+const double BogackiShampine32Solver::e[] =
+{
+   2./9. - 7./24., 1./3. - 1./4., 4./9. - 1./3., -1./8.
+};
+
+const double DormandPrince54Solver::a[] =
+{
+   1./5.,
+   3./40., 9./40.,
+   44./45., -56./15., 32./9.,
+   19372./6561., -25360./2187., 64448./6561., -212./729.,
+   9017./3168., -355./33., 46732./5247., 49./176., -5103./18656.,
+   35./384., 0., 500./1113., 125./192., -2187./6784., 11./84.
+};
+const double DormandPrince54Solver::b[] =
+{
+   35./384., 0., 500./1113., 125./192., -2187./6784., 11./84., 0.
+};
+const double DormandPrince54Solver::c[] =
+{
+   1./5., 3./10., 4./5., 8./9., 1., 1.
+};
+const double DormandPrince54Solver::e[] =
+{
+   71./57600., 0., -71./16695., 71./1920., -17253./339200., 22./525.,
+   -1./40.
+};
+const double DormandPrince54Solver::d[] =
+{
+   -12715105075./11282082432., 0., 87487479700./32700410799.,
+   -10690763975./1880347072., 701980252875./199316789632.,
+   -1453857185./822651844., 69997945./29380423.
+};
+
+void DormandPrince54Solver::Interpolate(double theta, Vector &x) const
+{
+   // x(theta) = x0 + theta (r1 + (1-theta) (r2 + theta (r3 + (1-theta) r4)))
+   // with r1 = x1-x0, r2 = dt k0 - r1, r3 = r1 - dt k6 - r2 and
+   // r4 = dt sum_i d_i k_i
+   const double dt = t1 - t0;
+   const double th = theta, th1 = 1.0 - theta;
+   const int n = x.Size();
+   auto X0 = x0.Read();
+   auto X1 = x1.Read();
+   auto K0 = k[0].Read(), K2 = k[2].Read(), K3 = k[3].Read();
+   auto K4 = k[4].Read(), K5 = k[5].Read(), K6 = k[6].Read();
+   const double d0 = d[0], d2 = d[2], d3 = d[3], d4 = d[4], d5 = d[5];
+   const double d6 = d[6];
+   auto X = x.Write();
+   MFEM_FORALL(i, n,
+   {
+      const double r1 = X1[i] - X0[i];
+      const double r2 = dt*K0[i] - r1;
+      const double r3 = r1 - dt*K6[i] - r2;
+      const double r4 = dt*(d0*K0[i] + d2*K2[i] + d3*K3[i] + d4*K4[i] +
+                            d5*K5[i] + d6*K6[i]);
+      X[i] = X0[i] + th*(r1 + th1*(r2 + th*(r3 + th1*r4)));
+   });
+}
+
+
+void TRBDF2Solver::Init(TimeDependentOperator &_f)
+{
+   AdaptiveRKSolver::Init(_f);
+   const int n = f->Width();
+   k1.SetSize(n, mem_type);
+   k2.SetSize(n, mem_type);
+   k3.SetSize(n, mem_type);
+   y.SetSize(n, mem_type);
+}
+
+void TRBDF2Solver::TrialStep(const Vector &x, double t, double dt,
+                             Vector &x_new, Vector &x_err)
+{
+   // with g = 2-sqrt(2), d = g/2 and w = sqrt(2)/4:
+   //   0  |  0
+   //   g  |  d  d
+   //   1  |  w  w  d
+   // -----+---------
+   //      |  w  w  d
+   //      | (1-w)/3  (3w+1)/3  d/3  (embedded 3rd order)
+   const double g = 2. - sqrt(2.);
+   const double d = g/2.;
+   const double wt = sqrt(2.)/4.;
+   if (new_step)
+   {
+      if (!restarted)
+      {
+         k1.Swap(k3);
+      }
+      else
+      {
+         f->SetTime(t);
+         f->Mult(x, k1);
+      }
+   }
+
+   add(x, d*dt, k1, y);
+   f->SetTime(t + g*dt);
+   f->ImplicitSolve(d*dt, y, k2);
+
+   add(x, wt*dt, k1, y);
+   y.Add(wt*dt, k2);
+   f->SetTime(t + dt);
+   f->ImplicitSolve(d*dt, y, k3);
+
+   add(y, d*dt, k3, x_new);
+
+   // error weights e = b - bhat
+   add((4.*wt - 1.)/3.*dt, k1, -1./3.*dt, k2, x_err);
+   x_err.Add(2.*d/3.*dt, k3);
+}
+
+void TRBDF2Solver::Interpolate(double theta, Vector &x) const
+{
+   HermiteInterpolate(theta, k1, k3, x);
+}
+
+
 void GeneralizedAlphaSolver::Init(TimeDependentOperator &_f)
 {
    ODESolver::Init(_f);
@@ -15,6 +15,10 @@
 #include "../config/config.hpp"
 #include "operator.hpp"
 
+#ifdef MFEM_USE_MPI
+#include <mpi.h>
+#endif
+
 namespace mfem
 {
 
@@ -206,6 +210,124 @@ public:
 };
 
 
+/** @brief Explicit Runge-Kutta method in the 2N-storage form of Williamson,
+    J. Comput. Phys. 35, 1980:
+       dx = A[i] dx + dt f(x, t + C[i] dt),  x = x + B[i] dx,  i = 0...s-1,
+    with A[0] = 0. Besides the solution, only the update dx and the result of
+    f are stored, independent of the number of stages, and the two updates
+    of a stage are fused in a single kernel. */
+class LowStorageRKSolver : public ODESolver
+{
+protected:
+   int s;
+   const double *A, *B, *C;
+   Vector dx, k;
+
+public:
+   LowStorageRKSolver(int _s, const double *_A, const double *_B,
+                      const double *_C) : s(_s), A(_A), B(_B), C(_C) { }
+
+   virtual void Init(TimeDependentOperator &_f);
+
+   virtual void Step(Vector &x, double &t, double &dt);
+};
+
+
+/// Three stage, third order low-storage RK method of Williamson.
+class LowStorageRK3Solver : public LowStorageRKSolver
+{
+private:
+   static const double A[3], B[3], C[3];
+
+public:
+   LowStorageRK3Solver() : LowStorageRKSolver(3, A, B, C) { }
+};
+
+
+/** Five stage, fourth order low-storage RK method of Carpenter and Kennedy,
+    NASA TM-109112, 1994. */
+class LowStorageRK4Solver : public LowStorageRKSolver
+{
+private:
+   static const double A[5], B[5], C[5];
+
+public:
+   LowStorageRK4Solver() : LowStorageRKSolver(5, A, B, C) { }
+};
+
+
+/** @brief Explicit Runge-Kutta method in the 3S* low-storage form of
+    Ketcheson, J. Comput. Phys. 229(5), 2010:
+       S = S + D[i] x,
+       x = G1[i] x + G2[i] S + G3[i] xn + B[i] dt f(x, t + C[i] dt),
+    i = 0...s-1, starting with S = 0 and xn = x. Besides the solution, only
+    the registers S and xn and the result of f are stored, independent of the
+    number of stages, and the updates of a stage are fused in a single kernel.
+    The extra register leaves more freedom in the choice of the coefficients
+    than the 2N form. */
+class LowStorage3SStarSolver : public ODESolver
+{
+protected:
+   int s;
+   const double *G1, *G2, *G3, *B, *C, *D;
+   Vector S, xn, k;
+
+public:
+   LowStorage3SStarSolver(int _s, const double *_G1, const double *_G2,
+                          const double *_G3, const double *_B,
+                          const double *_C, const double *_D)
+      : s(_s), G1(_G1), G2(_G2), G3(_G3), B(_B), C(_C), D(_D) { }
+
+   virtual void Init(TimeDependentOperator &_f);
+
+   virtual void Step(Vector &x, double &t, double &dt);
+};
+
+
+/** Five stage, fourth order 3S* low-storage RK method. Its coefficients solve
+    the order conditions in the 3S* form, with stability intervals of 5.4 on
+    the negative real axis and 3.2 on the imaginary axis. */
+class LowStorage3SStarRK4Solver : public LowStorage3SStarSolver
+{
+private:
+   static const double G1[5], G2[5], G3[5], B[5], C[5], D[5];
+
+public:
+   LowStorage3SStarRK4Solver()
+      : LowStorage3SStarSolver(5, G1, G2, G3, B, C, D) { }
+};
+
+
+/** Seven stage, fifth order 3S* low-storage RK method. Its coefficients solve
+    the order conditions in the 3S* form, with stability intervals of 3.6 on
+    the negative real axis and 2.2 on the imaginary axis. */
+class LowStorage3SStarRK5Solver : public LowStorage3SStarSolver
+{
+private:
+   static const double G1[7], G2[7], G3[7], B[7], C[7], D[7];
+
+public:
+   LowStorage3SStarRK5Solver()
+      : LowStorage3SStarSolver(7, G1, G2, G3, B, C, D) { }
+};
+
+
+/** Ten stage, fourth order, strong stability preserving (SSP) RK method of
+    Ketcheson, SIAM J. Sci. Comput. 30(4), 2008, with SSP coefficient 6, in
+    its low-storage implementation: besides the solution, only one register
+    and the result of f are stored. */
+class LowStorageSSPRK4Solver : public ODESolver
+{
+protected:
+   Vector y, k;
+
+public:
+   virtual void Init(TimeDependentOperator &_f);
+
+   virtual void Step(Vector &x, double &t, double &dt);
+};
+
+
 /** An explicit Adams-Bashforth method. */
 class AdamsBashforthSolver : public ODESolver
 {
@@ -431,6 +553,208 @@ public:
 };
 
 
+/** @brief Abstract class for Runge-Kutta methods with an embedded error
+    estimator and automatic step size control.
+
+    Step() integrates from @a t [in] to the target time @a t [in] + @a dt [in]
+    with as many internal steps as needed to keep the estimated local error
+    below the tolerances set with SetTolerances(). The step sizes are chosen
+    with a PI controller, so the internal steps are independent of the output
+    times: by default, the internal steps may go past the target time and the
+    output is then obtained with the dense output (interpolation) of the
+    method, see SetInterpolation(). The output @a dt [out] is the size of the
+    last internal step. As allowed by ODESolver::Step(), when the previous
+    output was interpolated, the input @a x [in] is not used; the integration
+    restarts from @a x [in] only after Init() or when @a t [in] is not the
+    output time of the previous call. */
+class AdaptiveRKSolver : public ODESolver
+{
+protected:
+   /// Order of the embedded method: the error estimate is O(dt^(q+1)).
+   int q;
+   double rel_tol, abs_tol;
+   double safety, min_factor, max_factor, dt_min, dt_max;
+   bool interpolate;
+
+   /// Last accepted internal step from (#t0, #x0) to (#t1, #x1).
+   double t0, t1, t_out;
+   Vector x0, x1, err, w;
+   /// Proposed size of the next internal step and the previous error norm.
+   double h, err_prev;
+   bool started;
+   int num_steps, num_rejected;
+
+   /** @brief Set before each call to TrialStep(): true for the first trial
+       step from #x0; #restarted is true if, in addition, #x0 is not the
+       result of the previous accepted step. */
+   bool new_step, restarted;
+
+#ifdef MFEM_USE_MPI
+   MPI_Comm comm;
+#endif
+
+   /** @brief Compute the step of size @a dt from (@a t, @a x) to @a x_new
+       and the estimate @a x_err of its local error. */
+   virtual void TrialStep(const Vector &x, double t, double dt, Vector &x_new,
+                          Vector &x_err) = 0;
+
+   /** @brief Compute the approximate solution at time #t0 + @a theta (#t1 -
+       #t0), 0 <= @a theta <= 1, on the last accepted step. */
+   virtual void Interpolate(double theta, Vector &x) const = 0;
+
+   /** Cubic Hermite interpolation on the last accepted step, given the time
+       derivatives @a f0 at #x0 and @a f1 at #x1; accurate to O(dt^4). */
+   void HermiteInterpolate(double theta, const Vector &f0, const Vector &f1,
+                           Vector &x) const;
+
+   /// Weighted RMS norm of #err, using #x0 and #x1 for the relative scale.
+   double ErrorNorm();
+
+public:
+   AdaptiveRKSolver(int q);
+
+#ifdef MFEM_USE_MPI
+   /** The error norms and step sizes are computed consistently on all
+       processors of @a comm. */
+   AdaptiveRKSolver(int q, MPI_Comm comm);
+#endif
+
+   /** @brief Set the relative and absolute tolerances of the local error of
+       every component of the solution, default 1e-6 and 1e-8. */
+   void SetTolerances(double rtol, double atol)
+   { rel_tol = rtol; abs_tol = atol; }
+
+   /// Set the bounds of the internal step size, default 0 and infinity.
+   void SetStepBounds(double min_dt, double max_dt)
+   { dt_min = min_dt; dt_max = max_dt; }
+
+   /** @brief Set the safety factor and the bounds of the ratio of two
+       consecutive step sizes, default 0.9, 0.2 and 5. */
+   void SetControllerFactors(double _safety, double min_f, double max_f)
+   { safety = _safety; min_factor = min_f; max_factor = max_f; }
+
+   /** @brief If @a use_interpolation is false, the last internal step is
+       shortened to reach the target time exactly, instead of interpolating
+       the output. Default is true. */
+   void SetInterpolation(bool use_interpolation)
+   { interpolate = use_interpolation; }
+
+   /// Return the number of accepted internal steps since Init().
+   int GetNumSteps() const { return num_steps; }
+
+   /// Return the number of rejected internal steps since Init().
+   int GetNumRejectedSteps() const { return num_rejected; }
+
+   virtual void Init(TimeDependentOperator &_f);
+
+   virtual void Step(Vector &x, double &t, double &dt);
+
+   /// Integrate to @a tf [in] in a single call to Step().
+   virtual void Run(Vector &x, double &t, double &dt, double tf);
+};
+
+
+/** An explicit Runge-Kutta method with an embedded error estimator, given by
+    the Butcher tableau of ExplicitRKSolver and the error weights
+    e[i] = b[i] - bhat[i]. If @a fsal is true, the last stage must be
+    evaluated at the solution (first same as last), which is then reused as
+    the first stage of the next step and for the dense output. */
+class ExplicitEmbeddedRKSolver : public AdaptiveRKSolver
+{
+protected:
+   int s;
+   const double *a, *b, *c, *e;
+   bool fsal;
+   Vector y, *k;
+
+   virtual void TrialStep(const Vector &x, double t, double dt, Vector &x_new,
+                          Vector &x_err);
+
+   virtual void Interpolate(double theta, Vector &x) const;
+
+public:
+   ExplicitEmbeddedRKSolver(int _s, const double *_a, const double *_b,
+                            const double *_c, const double *_e, bool _fsal,
+                            int q);
+
+#ifdef MFEM_USE_MPI
+   ExplicitEmbeddedRKSolver(int _s, const double *_a, const double *_b,
+                            const double *_c, const double *_e, bool _fsal,
+                            int q, MPI_Comm comm);
+#endif
+
+   virtual void Init(TimeDependentOperator &_f);
+
+   virtual ~ExplicitEmbeddedRKSolver();
+};
+
+
+/** The 4-stage Bogacki-Shampine 3(2) pair with cubic Hermite dense output. */
+class BogackiShampine32Solver : public ExplicitEmbeddedRKSolver
+{
+private:
+   static const double a[6], b[4], c[3], e[4];
+
+public:
+   BogackiShampine32Solver()
+      : ExplicitEmbeddedRKSolver(4, a, b, c, e, true, 2) { }
+
+#ifdef MFEM_USE_MPI
+   BogackiShampine32Solver(MPI_Comm comm)
+      : ExplicitEmbeddedRKSolver(4, a, b, c, e, true, 2, comm) { }
+#endif
+};
+
+
+/** The 7-stage Dormand-Prince 5(4) pair, with the 4th order dense output of
+    Hairer, Norsett and Wanner, "Solving Ordinary Differential Equations I". */
+class DormandPrince54Solver : public ExplicitEmbeddedRKSolver
+{
+private:
+   static const double a[21], b[7], c[6], e[7], d[7];
+
+protected:
+   virtual void Interpolate(double theta, Vector &x) const;
+
+public:
+   DormandPrince54Solver()
+      : ExplicitEmbeddedRKSolver(7, a, b, c, e, true, 4) { }
+
+#ifdef MFEM_USE_MPI
+   DormandPrince54Solver(MPI_Comm comm)
+      : ExplicitEmbeddedRKSolver(7, a, b, c, e, true, 4, comm) { }
+#endif
+};
+
+
+/** The TR-BDF2 method as a three stage, explicit first stage, singly diagonal
+    implicit Runge-Kutta (ESDIRK) method of order 2, L-stable, with an
+    embedded 3rd order estimator, see Hosea and Shampine, Appl. Numer. Math.
+    20, 1996. Uses ImplicitSolve() for the two implicit stages; Mult() is only
+    called at the start, since the method is stiffly accurate (the last stage
+    is reused as the first stage of the next step). Dense output is cubic
+    Hermite. */
+class TRBDF2Solver : public AdaptiveRKSolver
+{
+protected:
+   Vector k1, k2, k3, y;
+
+   virtual void TrialStep(const Vector &x, double t, double dt, Vector &x_new,
+                          Vector &x_err);
+
+   virtual void Interpolate(double theta, Vector &x) const;
+
+public:
+   TRBDF2Solver() : AdaptiveRKSolver(2) { }
+
+#ifdef MFEM_USE_MPI
+   TRBDF2Solver(MPI_Comm comm) : AdaptiveRKSolver(2, comm) { }
+#endif
+
+   virtual void Init(TimeDependentOperator &_f);
+};
+
+
 /// Generalized-alpha ODE solver from "A generalized-α method for integrating
 /// the filtered Navier–Stokes equations with a stabilized finite element
 /// method" by K.E. Jansen, C.H. Whiting and G.M. Hulbert.
@@ -37,8 +37,10 @@ protected:
       const Array<int> &test_tdof_list,
       RectangularConstrainedOperator* &Aout);
 
-   /// Returns RAP Operator of this, taking in input/output Prolongation matrices
-   Operator *SetupRAP(const Operator *Pi, const Operator *Po);
+   /** @brief Returns RAP Operator of this, taking in input/output Prolongation
+       matrices. Derived classes may return a specialized operator, which is
+       owned by the caller when it is not this. */
+   virtual Operator *SetupRAP(const Operator *Pi, const Operator *Po);
 
 public:
    /// Initializes memory for true vectors of linear system
@@ -34,6 +34,7 @@ IterativeSolver::IterativeSolver()
    rel_tol = abs_tol = 0.0;
 #ifdef MFEM_USE_MPI
    dot_prod_type = 0;
+   sum_request = MPI_REQUEST_NULL;
 #endif
 }
 
@@ -48,6 +49,7 @@ IterativeSolver::IterativeSolver(MPI_Comm _comm)
    rel_tol = abs_tol = 0.0;
    dot_prod_type = 1;
    comm = _comm;
+   sum_request = MPI_REQUEST_NULL;
 }
 #endif
 
@@ -67,6 +69,30 @@ double IterativeSolver::Dot(const Vector &x, const Vector &y) const
 #endif
 }
 
+void IterativeSolver::StartGlobalSum(double *dots, int n) const
+{
+#ifdef MFEM_USE_MPI
+   if (dot_prod_type != 0)
+   {
+      MPI_Iallreduce(MPI_IN_PLACE, dots, n, MPI_DOUBLE, MPI_SUM, comm,
+                     &sum_request);
+   }
+#else
+   MFEM_CONTRACT_VAR(dots);
+   MFEM_CONTRACT_VAR(n);
+#endif
+}
+
+void IterativeSolver::FinishGlobalSum() const
+{
+#ifdef MFEM_USE_MPI
+   if (dot_prod_type != 0)
+   {
+      MPI_Wait(&sum_request, MPI_STATUS_IGNORE);
+   }
+#endif
+}
+
 void IterativeSolver::SetPrintLevel(int print_lvl)
 {
 #ifndef MFEM_USE_MPI
@@ -530,10 +556,24 @@ void CGSolver::UpdateVectors()
    r.SetSize(width);
    d.SetSize(width);
    z.SetSize(width);
+   const int pw = pipelined ? width : 0;
+   u.SetSize(pw);
+   w.SetSize(pw);
+   m.SetSize(pw);
+   n.SetSize(pw);
+   q.SetSize(pw);
+   s.SetSize(pw);
+   if (pipelined)
+   {
+      Vector *pv[] = { &r, &d, &z, &u, &w, &m, &n, &q, &s };
+      for (Vector *v : pv) { v->UseDevice(true); }
+   }
 }
 
 void CGSolver::Mult(const Vector &b, Vector &x) const
 {
+   if (pipelined) { return PipelinedMult(b, x); }
+
    int i;
    double r0, den, nom, nom0, betanom, alpha, beta;
 
@@ -717,6 +757,241 @@ void CGSolver::Mult(const Vector &b, Vector &x) const
    Monitor(final_iter, final_norm, r, x, true);
 }
 
+// Local inner products (r,u) and (w,u) of pipelined CG, computed in a single
+// pass over the vectors. On the device, a fused reduction kernel writes the
+// partial sums of both products to @a parts: work item b accumulates the
+// entries b, b + NB, b + 2 NB, ... (coalesced reads), and the NB pairs of
+// partial sums are added on the host.
+static void PipelinedCGDots(const Vector &r, const Vector &u, const Vector &w,
+                            Vector &parts, double *dots)
+{
+   const int N = r.Size();
+   double ru = 0.0, wu = 0.0;
+   if (Device::IsEnabled())
+   {
+      const int NB = (N + MFEM_CUDA_BLOCKS - 1) / MFEM_CUDA_BLOCKS;
+      parts.SetSize(2 * NB, Device::GetDeviceMemoryType());
+      parts.UseDevice(true);
+      auto d_r = r.Read();
+      auto d_u = u.Read();
+      auto d_w = w.Read();
+      auto P = Reshape(parts.Write(), 2, NB);
+      MFEM_FORALL(b, NB,
+      {
+         double p_ru = 0.0, p_wu = 0.0;
+         for (int i = b; i < N; i += NB)
+         {
+            p_ru += d_r[i] * d_u[i];
+            p_wu += d_w[i] * d_u[i];
+         }
+         P(0,b) = p_ru;
+         P(1,b) = p_wu;
+      });
+      const double *h_P = parts.HostRead();
+      for (int b = 0; b < NB; b++)
+      {
+         ru += h_P[2*b];
+         wu += h_P[2*b+1];
+      }
+   }
+   else
+   {
+      const double *R = r.HostRead();
+      const double *U = u.HostRead();
+      const double *W = w.HostRead();
+      for (int i = 0; i < N; i++)
+      {
+         ru += R[i] * U[i];
+         wu += W[i] * U[i];
+      }
+   }
+   dots[0] = ru;
+   dots[1] = wu;
+}
+
+// Fused vector updates of pipelined CG:
+//    z = n + beta z,   q = m + beta q,   s = w + beta s,   p = u + beta p,
+//    x = x + alpha p,  r = r - alpha s,  u = u - alpha q,  w = w - alpha z.
+static void PipelinedCGUpdate(const double alpha, const double beta,
+                              const Vector &m, const Vector &n,
+                              Vector &z, Vector &q, Vector &s, Vector &p,
+                              Vector &x, Vector &r, Vector &u, Vector &w)
+{
+   const int N = x.Size();
+   auto d_m = m.Read();
+   auto d_n = n.Read();
+   auto d_z = z.ReadWrite();
+   auto d_q = q.ReadWrite();
+   auto d_s = s.ReadWrite();
+   auto d_p = p.ReadWrite();
+   auto d_x = x.ReadWrite();
+   auto d_r = r.ReadWrite();
+   auto d_u = u.ReadWrite();
+   auto d_w = w.ReadWrite();
+   MFEM_FORALL(i, N,
+   {
+      const double zi = d_n[i] + beta * d_z[i];
+      const double qi = d_m[i] + beta * d_q[i];
+      const double si = d_w[i] + beta * d_s[i];
+      const double pi = d_u[i] + beta * d_p[i];
+      d_z[i] = zi;
+      d_q[i] = qi;
+      d_s[i] = si;
+      d_p[i] = pi;
+      d_x[i] += alpha * pi;
+      d_r[i] -= alpha * si;
+      d_u[i] -= alpha * qi;
+      d_w[i] -= alpha * zi;
+   });
+}
+
+// Pipelined PCG, Algorithm 3 in P. Ghysels and W. Vanroose, "Hiding global
+// synchronization latency in the preconditioned Conjugate Gradient
+// algorithm", Parallel Computing 40 (2014). The vector d is used as the
+// search direction p.
+void CGSolver::PipelinedMult(const Vector &b, Vector &x) const
+{
+   double dots[2], gamma, delta, nom0 = 0.0, r0 = 0.0;
+   double alpha = 0.0, beta, gamma_old = 0.0;
+
+   if (iterative_mode)
+   {
+      oper->Mult(x, r);
+      subtract(b, r, r); // r = b - A x
+   }
+   else
+   {
+      r = b;
+      x = 0.0;
+   }
+   if (prec)
+   {
+      prec->Mult(r, u); // u = B r
+   }
+   else
+   {
+      u = r;
+   }
+   oper->Mult(u, w);    // w = A u
+   d = 0.0;
+   z = 0.0;
+   q = 0.0;
+   s = 0.0;
+
+   converged = 0;
+   final_iter = max_iter;
+   int i;
+   for (i = 0; true; i++)
+   {
+      // Overlap the reduction with the preconditioner and operator actions
+      PipelinedCGDots(r, u, w, dot_parts, dots);
+      StartGlobalSum(dots, 2);
+      if (prec)
+      {
+         prec->Mult(w, m); // m = B w
+      }
+      else
+      {
+         m = w;
+      }
+      oper->Mult(m, n);    // n = A m
+      FinishGlobalSum();
+      gamma = dots[0];     // (B r, r)
+      delta = dots[1];     // (A B r, B r)
+      MFEM_ASSERT(IsFinite(gamma), "gamma = " << gamma);
+
+      if (i == 0)
+      {
+         nom0 = gamma;
+         r0 = std::max(gamma*rel_tol*rel_tol, abs_tol*abs_tol);
+      }
+      if (print_level == 1 || (print_level == 3 && i == 0))
+      {
+         mfem::out << "   Iteration : " << setw(3) << i << "  (B r, r) = "
+                   << gamma << (print_level == 3 ? " ...\n" : "\n");
+      }
+      Monitor(i, gamma, r, x);
+
+      if (gamma < 0.0)
+      {
+         if (print_level >= 0)
+         {
+            mfem::out << "PCG: The preconditioner is not positive definite. (Br, r) = "
+                      << gamma << '\n';
+         }
+         final_iter = i;
+         break;
+      }
+      if (i == 0 ? gamma <= r0 : gamma < r0)
+      {
+         if (print_level == 2)
+         {
+            mfem::out << "Number of PCG iterations: " << i << '\n';
+         }
+         else if (print_level == 3 && i > 0)
+         {
+            mfem::out << "   Iteration : " << setw(3) << i << "  (B r, r) = "
+                      << gamma << '\n';
+         }
+         converged = 1;
+         final_iter = i;
+         if (i == 0)
+         {
+            final_norm = sqrt(gamma);
+            return;
+         }
+         break;
+      }
+      if (i >= max_iter)
+      {
+         break;
+      }
+
+      // den = (A p, p) for the updated search direction p
+      beta = (i > 0) ? gamma/gamma_old : 0.0;
+      const double den = (i > 0) ? delta - beta*gamma/alpha : delta;
+      MFEM_ASSERT(IsFinite(den), "den = " << den);
+      if (den <= 0.0)
+      {
+         if (print_level >= 0)
+         {
+            mfem::out << "PCG: The operator is not positive definite. (Ad, d) = "
+                      << den << '\n';
+         }
+         if (den == 0.0)
+         {
+            final_iter = i;
+            break;
+         }
+      }
+      alpha = gamma/den;
+      PipelinedCGUpdate(alpha, beta, m, n, z, q, s, d, x, r, u, w);
+      gamma_old = gamma;
+   }
+   if (print_level >= 0 && !converged)
+   {
+      if (print_level != 1)
+      {
+         if (print_level != 3)
+         {
+            mfem::out << "   Iteration : " << setw(3) << 0 << "  (B r, r) = "
+                      << nom0 << " ...\n";
+         }
+         mfem::out << "   Iteration : " << setw(3) << final_iter << "  (B r, r) = "
+                   << gamma << '\n';
+      }
+      mfem::out << "PCG: No convergence!" << '\n';
+   }
+   if (print_level >= 1 || (print_level >= 0 && !converged))
+   {
+      mfem::out << "Average reduction factor = "
+                << pow (gamma/nom0, 0.5/final_iter) << '\n';
+   }
+   final_norm = sqrt(gamma);
+
+   Monitor(final_iter, final_norm, r, x, true);
+}
+
 void CG(const Operator &A, const Vector &b, Vector &x,
         int print_iter, int max_num_iter,
         double RTOLERANCE, double ATOLERANCE)
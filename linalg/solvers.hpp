@@ -58,6 +58,7 @@ class IterativeSolver : public Solver
 private:
    int dot_prod_type; // 0 - local, 1 - global over 'comm'
    MPI_Comm comm;
+   mutable MPI_Request sum_request; // see StartGlobalSum()
 #endif
 
 protected:
@@ -74,6 +75,13 @@ protected:
 
    double Dot(const Vector &x, const Vector &y) const;
    double Norm(const Vector &x) const { return sqrt(Dot(x, x)); }
+   /** @brief Start the non-blocking global sum of the @a n local inner
+       products in @a dots; the sums are available in @a dots after
+       FinishGlobalSum(). Without a global communicator, @a dots is not
+       modified. */
+   void StartGlobalSum(double *dots, int n) const;
+   /// Wait for the global sum started with StartGlobalSum() to complete.
+   void FinishGlobalSum() const;
    void Monitor(int it, double norm, const Vector& r, const Vector& x,
                 bool final=false) const;
 
@@ -239,9 +247,16 @@ class CGSolver : public IterativeSolver
 {
 protected:
    mutable Vector r, d, z;
+   // Additional vectors of the pipelined variant, see SetPipelined()
+   mutable Vector u, w, m, n, q, s;
+   // Partial sums of the fused device reduction of the pipelined variant
+   mutable Vector dot_parts;
+   bool pipelined = false;
 
    void UpdateVectors();
 
+   void PipelinedMult(const Vector &b, Vector &x) const;
+
 public:
    CGSolver() { }
 
@@ -252,6 +267,18 @@ public:
    virtual void SetOperator(const Operator &op)
    { IterativeSolver::SetOperator(op); UpdateVectors(); }
 
+   /** @brief Use the pipelined (P)CG variant of Ghysels and Vanroose.
+
+       Each iteration performs a single global reduction, for both inner
+       products, which is overlapped with the application of the
+       preconditioner and the operator. All vector updates of an iteration
+       are fused into one kernel. The variant needs six additional work
+       vectors and, due to the different recurrences, its convergence history
+       may differ slightly from the standard one. The additional rounding
+       errors also limit the attainable accuracy, so very small relative
+       tolerances (close to the machine precision) may not be reached. */
+   void SetPipelined(bool pipe = true) { pipelined = pipe; UpdateVectors(); }
+
    virtual void Mult(const Vector &b, Vector &x) const;
 };
 
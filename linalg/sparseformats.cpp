@@ -0,0 +1,323 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "sparseformats.hpp"
+#include "simd.hpp"
+#include "../general/forall.hpp"
+
+#include <algorithm>
+
+namespace mfem
+{
+
+SELLMatrix::SELLMatrix(const SparseMatrix &A, int C_, int sigma_)
+   : Operator(A.Height(), A.Width()), C(C_), sigma(sigma_)
+{
+   MFEM_VERIFY(A.Finalized(), "the matrix must be finalized");
+   if (C == 0)
+   {
+      C = std::max(4, AutoSIMDTraits<double,double>::simd_size);
+   }
+   MFEM_VERIFY(C == 1 || C == 2 || C == 4 || C == 8 || C == 16,
+               "invalid chunk size C = " << C);
+   MFEM_VERIFY(sigma > 0 && sigma % C == 0,
+               "sigma must be a positive multiple of C");
+
+   const int *A_i = A.HostReadI();
+   const int *A_j = A.HostReadJ();
+   const double *A_data = A.HostReadData();
+
+   // Sort the rows by decreasing length within each window of sigma rows.
+   // The sort is stable, so rows of equal length keep their order.
+   num_chunks = (height + C - 1) / C;
+   rows.SetSize(num_chunks*C);
+   rows = -1;
+   for (int i = 0; i < height; i++) { rows[i] = i; }
+   for (int w = 0; w < height; w += sigma)
+   {
+      std::stable_sort(rows.GetData() + w,
+                       rows.GetData() + std::min(w + sigma, height),
+                       [A_i](int r1, int r2)
+      { return A_i[r1+1] - A_i[r1] > A_i[r2+1] - A_i[r2]; });
+   }
+
+   chunk_offsets.SetSize(num_chunks+1);
+   chunk_offsets[0] = 0;
+   for (int c = 0; c < num_chunks; c++)
+   {
+      int width_c = 0;
+      for (int l = 0; l < C; l++)
+      {
+         const int r = rows[c*C + l];
+         if (r >= 0) { width_c = std::max(width_c, A_i[r+1] - A_i[r]); }
+      }
+      chunk_offsets[c+1] = chunk_offsets[c] + width_c*C;
+   }
+
+   // Padding entries have value zero and repeat the last column index of
+   // their row, so they do not load additional entries of x.
+   const int nnz = chunk_offsets[num_chunks];
+   col.SetSize(nnz);
+   val.SetSize(nnz);
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int c = 0; c < num_chunks; c++)
+   {
+      const int offset = chunk_offsets[c];
+      const int width_c = (chunk_offsets[c+1] - offset) / C;
+      for (int l = 0; l < C; l++)
+      {
+         const int r = rows[c*C + l];
+         const int begin = (r >= 0) ? A_i[r] : 0;
+         const int len = (r >= 0) ? A_i[r+1] - A_i[r] : 0;
+         for (int k = 0; k < width_c; k++)
+         {
+            const int p = offset + k*C + l;
+            if (k < len)
+            {
+               col[p] = A_j[begin + k];
+               val[p] = A_data[begin + k];
+            }
+            else
+            {
+               col[p] = (len > 0) ? A_j[begin + len - 1] : 0;
+               val[p] = 0.0;
+            }
+         }
+      }
+   }
+}
+
+template<int C>
+static void SELLAddMult(const int num_chunks, const int *chunk_offsets,
+                        const int *rows, const int *col, const double *val,
+                        const double *x, double *y, const double a)
+{
+   typedef AutoSIMD<double,C,C*sizeof(double)> vreal_t;
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int c = 0; c < num_chunks; c++)
+   {
+      vreal_t sum;
+      sum = 0.0;
+      for (int p = chunk_offsets[c]; p < chunk_offsets[c+1]; p += C)
+      {
+         vreal_t v, xv;
+         for (int l = 0; l < C; l++)
+         {
+            v[l] = val[p+l];
+            xv[l] = x[col[p+l]];
+         }
+         sum.fma(v, xv);
+      }
+      for (int l = 0; l < C; l++)
+      {
+         const int r = rows[c*C + l];
+         if (r >= 0) { y[r] += a*sum[l]; }
+      }
+   }
+}
+
+void SELLMatrix::AddMult(const Vector &x, Vector &y, const double a) const
+{
+   MFEM_ASSERT(x.Size() == width && y.Size() == height, "invalid sizes");
+   const int *d_offsets = chunk_offsets.HostRead();
+   const int *d_rows = rows.HostRead();
+   const int *d_col = col.HostRead();
+   const double *d_val = val.HostRead();
+   const double *d_x = x.HostRead();
+   double *d_y = y.HostReadWrite();
+   switch (C)
+   {
+      case 1: return SELLAddMult<1>(num_chunks, d_offsets, d_rows, d_col,
+                                       d_val, d_x, d_y, a);
+      case 2: return SELLAddMult<2>(num_chunks, d_offsets, d_rows, d_col,
+                                       d_val, d_x, d_y, a);
+      case 4: return SELLAddMult<4>(num_chunks, d_offsets, d_rows, d_col,
+                                       d_val, d_x, d_y, a);
+      case 8: return SELLAddMult<8>(num_chunks, d_offsets, d_rows, d_col,
+                                       d_val, d_x, d_y, a);
+      case 16: return SELLAddMult<16>(num_chunks, d_offsets, d_rows, d_col,
+                                         d_val, d_x, d_y, a);
+   }
+   MFEM_ABORT("invalid chunk size C = " << C);
+}
+
+void SELLMatrix::Mult(const Vector &x, Vector &y) const
+{
+   y = 0.0;
+   AddMult(x, y);
+}
+
+void SELLMatrix::MultTranspose(const Vector &x, Vector &y) const
+{
+   MFEM_ASSERT(x.Size() == height && y.Size() == width, "invalid sizes");
+   const int *h_col = col.HostRead();
+   const double *h_val = val.HostRead();
+   const double *xp = x.HostRead();
+   double *yp = y.HostWrite();
+   for (int j = 0; j < width; j++) { yp[j] = 0.0; }
+   for (int c = 0; c < num_chunks; c++)
+   {
+      for (int p = chunk_offsets[c]; p < chunk_offsets[c+1]; p += C)
+      {
+         for (int l = 0; l < C; l++)
+         {
+            const int r = rows[c*C + l];
+            if (r >= 0) { yp[h_col[p+l]] += h_val[p+l]*xp[r]; }
+         }
+      }
+   }
+}
+
+
+BSRMatrix::BSRMatrix(const SparseMatrix &A, int b_)
+   : Operator(A.Height(), A.Width()), b(b_)
+{
+   MFEM_VERIFY(A.Finalized(), "the matrix must be finalized");
+   MFEM_VERIFY(b > 0 && height % b == 0 && width % b == 0,
+               "the matrix sizes must be multiples of the block size");
+   const int nbr = height / b;
+   const int nbc = width / b;
+   const int *A_i = A.HostReadI();
+   const int *A_j = A.HostReadJ();
+   const double *A_data = A.HostReadData();
+
+   // Block pattern: the block columns of each block row, sorted
+   I.SetSize(nbr+1);
+   I[0] = 0;
+   Array<int> marker(nbc);
+   marker = -1;
+   for (int bi = 0; bi < nbr; bi++)
+   {
+      int cnt = 0;
+      for (int k = A_i[bi*b]; k < A_i[(bi+1)*b]; k++)
+      {
+         const int bj = A_j[k] / b;
+         if (marker[bj] != bi) { marker[bj] = bi; cnt++; }
+      }
+      I[bi+1] = I[bi] + cnt;
+   }
+   J.SetSize(I[nbr]);
+   marker = -1;
+   for (int bi = 0; bi < nbr; bi++)
+   {
+      int pos = I[bi];
+      for (int k = A_i[bi*b]; k < A_i[(bi+1)*b]; k++)
+      {
+         const int bj = A_j[k] / b;
+         if (marker[bj] != bi) { marker[bj] = bi; J[pos++] = bj; }
+      }
+      std::sort(J.GetData() + I[bi], J.GetData() + I[bi+1]);
+   }
+
+   // Values of the blocks, using marker[bj] as the position of the block
+   val.SetSize(J.Size()*b*b);
+   val = 0.0;
+   marker = -1;
+   for (int bi = 0; bi < nbr; bi++)
+   {
+      for (int p = I[bi]; p < I[bi+1]; p++) { marker[J[p]] = p; }
+      for (int r = 0; r < b; r++)
+      {
+         const int i = bi*b + r;
+         for (int k = A_i[i]; k < A_i[i+1]; k++)
+         {
+            const int p = marker[A_j[k] / b];
+            val[(p*b + r)*b + A_j[k] % b] += A_data[k];
+         }
+      }
+   }
+}
+
+template<int T_B = 0>
+static void BSRAddMult(const int nbr, const int b_, const Array<int> &I_,
+                       const Array<int> &J_, const Vector &val_,
+                       const Vector &x_, Vector &y_, const double a)
+{
+   const int b = T_B ? T_B : b_;
+   constexpr int max_b = T_B ? T_B : 8;
+   MFEM_VERIFY(b <= max_b, "block size " << b << " is not supported");
+   const int nnzb = J_.Size();
+   auto I = I_.Read();
+   auto J = J_.Read();
+   auto val = Reshape(val_.Read(), b, b, nnzb);
+   auto x = Reshape(x_.Read(), b, x_.Size()/b);
+   auto y = Reshape(y_.ReadWrite(), b, nbr);
+   MFEM_FORALL(bi, nbr,
+   {
+      const int b = T_B ? T_B : b_;
+      double sum[max_b];
+      for (int r = 0; r < b; r++) { sum[r] = 0.0; }
+      for (int p = I[bi]; p < I[bi+1]; p++)
+      {
+         const int bj = J[p];
+         for (int r = 0; r < b; r++)
+         {
+            double s = 0.0;
+            for (int c = 0; c < b; c++)
+            {
+               s += val(c,r,p) * x(c,bj);
+            }
+            sum[r] += s;
+         }
+      }
+      for (int r = 0; r < b; r++) { y(r,bi) += a*sum[r]; }
+   });
+}
+
+void BSRMatrix::AddMult(const Vector &x, Vector &y, const double a) const
+{
+   MFEM_ASSERT(x.Size() == width && y.Size() == height, "invalid sizes");
+   const int nbr = I.Size() - 1;
+   switch (b)
+   {
+      case 1: return BSRAddMult<1>(nbr, b, I, J, val, x, y, a);
+      case 2: return BSRAddMult<2>(nbr, b, I, J, val, x, y, a);
+      case 3: return BSRAddMult<3>(nbr, b, I, J, val, x, y, a);
+      default: return BSRAddMult(nbr, b, I, J, val, x, y, a);
+   }
+}
+
+void BSRMatrix::Mult(const Vector &x, Vector &y) const
+{
+   y = 0.0;
+   AddMult(x, y);
+}
+
+void BSRMatrix::MultTranspose(const Vector &x, Vector &y) const
+{
+   MFEM_ASSERT(x.Size() == height && y.Size() == width, "invalid sizes");
+   const int *h_I = I.HostRead();
+   const int *h_J = J.HostRead();
+   const double *h_val = val.HostRead();
+   const double *xp = x.HostRead();
+   double *yp = y.HostWrite();
+   for (int j = 0; j < width; j++) { yp[j] = 0.0; }
+   for (int bi = 0; bi < height/b; bi++)
+   {
+      for (int p = h_I[bi]; p < h_I[bi+1]; p++)
+      {
+         const double *blk = h_val + p*b*b;
+         for (int r = 0; r < b; r++)
+         {
+            for (int c = 0; c < b; c++)
+            {
+               yp[h_J[p]*b + c] += blk[r*b + c] * xp[bi*b + r];
+            }
+         }
+      }
+   }
+}
+
+}
@@ -0,0 +1,108 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_SPARSEFORMATS_HPP
+#define MFEM_SPARSEFORMATS_HPP
+
+// Alternative storage formats of a finalized SparseMatrix, used to speed up
+// the matrix-vector product.
+
+#include "sparsemat.hpp"
+
+namespace mfem
+{
+
+/** @brief Copy of a finalized SparseMatrix in the SELL-C-sigma format, see
+    Kreutzer et al., SIAM J. Sci. Comput. 36(5), 2014.
+
+    The rows are sorted by decreasing length within windows of sigma rows and
+    grouped in chunks of C consecutive (sorted) rows. The entries of a chunk
+    are stored column by column, padded with zeros to the length of the
+    longest row of the chunk, so that the product with a chunk is computed
+    with SIMD operations on C rows at a time, see linalg/simd.hpp. This suits
+    matrices with many short rows, e.g. low order H1 discretizations.
+
+    The products are computed on the host; the product with the matrix runs
+    in parallel over the chunks with OpenMP. The SparseMatrix can be destroyed
+    after the conversion. */
+class SELLMatrix : public Operator
+{
+protected:
+   int C, sigma, num_chunks;
+   /// Offsets of the chunks in #col and #val, size #num_chunks+1.
+   Array<int> chunk_offsets;
+   /// Row of the matrix stored in each slot, -1 for padding slots.
+   Array<int> rows;
+   Array<int> col;
+   Vector val;
+
+public:
+   /** @brief Convert the finalized matrix @a A. The chunk height @a C must be
+       one of 1, 2, 4, 8 or 16; if it is 0, the SIMD width of the host,
+       but at least 4, is used. @a sigma must be a multiple of @a C; with
+       @a sigma = @a C the rows are not reordered. */
+   SELLMatrix(const SparseMatrix &A, int C = 0, int sigma = 256);
+
+   /// Return the chunk height C.
+   int GetChunkSize() const { return C; }
+
+   /// Return the number of stored entries, including the padding zeros.
+   int NumStoredEntries() const { return chunk_offsets[num_chunks]; }
+
+   virtual void Mult(const Vector &x, Vector &y) const;
+
+   /// y += a * A.x
+   void AddMult(const Vector &x, Vector &y, const double a = 1.0) const;
+
+   virtual void MultTranspose(const Vector &x, Vector &y) const;
+};
+
+/** @brief Copy of a finalized SparseMatrix in the block CSR (BSR) format with
+    dense square blocks of size @a b.
+
+    This format matches the matrices of vector finite element spaces with
+    Ordering::byVDIM, e.g. from VectorMassIntegrator or ElasticityIntegrator,
+    with @a b equal to the vector dimension: the couplings between two nodes
+    form a dense b x b block, so only one column index is stored per block
+    and the products with the blocks are unrolled. The product with the matrix
+    uses MFEM_FORALL and runs on the device; the product with its transpose is
+    computed on the host. */
+class BSRMatrix : public Operator
+{
+protected:
+   int b;
+   /// Block row offsets, block column indices and row-major b x b blocks.
+   Array<int> I, J;
+   Vector val;
+
+public:
+   /** @brief Convert the finalized matrix @a A, whose height and width must be
+       multiples of the block size @a b. Entries of @a A outside its pattern
+       are stored as zeros in the blocks. */
+   BSRMatrix(const SparseMatrix &A, int b);
+
+   /// Return the block size.
+   int GetBlockSize() const { return b; }
+
+   /// Return the number of stored blocks.
+   int NumBlocks() const { return J.Size(); }
+
+   virtual void Mult(const Vector &x, Vector &y) const;
+
+   /// y += a * A.x
+   void AddMult(const Vector &x, Vector &y, const double a = 1.0) const;
+
+   virtual void MultTranspose(const Vector &x, Vector &y) const;
+};
+
+}
+
+#endif
@@ -23,6 +23,10 @@
 #include <limits>
 #include <cstring>
 
+#ifdef MFEM_USE_OPENMP
+#include <omp.h>
+#endif
+
 namespace mfem
 {
 
@@ -2977,59 +2981,97 @@ void SparseMatrixFunction (SparseMatrix & S, double (*f)(double))
    }
 }
 
+// Number of contiguous row blocks processed in parallel by Transpose(), Mult()
+// and RAP(). Each block uses its own marker/count arrays.
+static int GetNumRowBlocks(int rows)
+{
+#ifdef MFEM_USE_OPENMP
+   return std::max(1, std::min(omp_get_max_threads(), rows));
+#else
+   MFEM_CONTRACT_VAR(rows);
+   return 1;
+#endif
+}
+
+// First row of block @a b out of @a nb blocks of @a rows rows.
+static inline int RowBlockBegin(int b, int nb, int rows)
+{
+   return (int)(((long long)b * rows) / nb);
+}
+
 SparseMatrix *Transpose (const SparseMatrix &A)
 {
    MFEM_VERIFY(
       A.Finalized(),
       "Finalize must be called before Transpose. Use TransposeRowMatrix instead");
 
-   int i, j, end;
-   const int *A_i, *A_j;
-   int m, n, nnz, *At_i, *At_j;
-   const double *A_data;
-   double *At_data;
-
-   m      = A.Height(); // number of rows of A
-   n      = A.Width();  // number of columns of A
-   nnz    = A.NumNonZeroElems();
-   A_i    = A.GetI();
-   A_j    = A.GetJ();
-   A_data = A.GetData();
-
-   At_i = Memory<int>(n+1);
-   At_j = Memory<int>(nnz);
-   At_data = Memory<double>(nnz);
+   const int m   = A.Height(); // number of rows of A
+   const int n   = A.Width();  // number of columns of A
+   const int nnz = A.NumNonZeroElems();
+   const int *A_i = A.GetI();
+   const int *A_j = A.GetJ();
+   const double *A_data = A.GetData();
 
-   for (i = 0; i <= n; i++)
+   int *At_i = Memory<int>(n+1);
+   int *At_j = Memory<int>(nnz);
+   double *At_data = Memory<double>(nnz);
+
+   // Every row block of A counts its entries in each column of A; the
+   // counts are then turned into the positions where the block inserts its
+   // entries in the rows of At. The rows of At are sorted by column index.
+   const int nb = GetNumRowBlocks(m);
+   Array<int> pos(nb*n);
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for schedule(static)
+#endif
+   for (int b = 0; b < nb; b++)
    {
-      At_i[i] = 0;
+      int *b_pos = pos.GetData() + b*n;
+      for (int j = 0; j < n; j++) { b_pos[j] = 0; }
+      const int end = A_i[RowBlockBegin(b+1, nb, m)];
+      for (int k = A_i[RowBlockBegin(b, nb, m)]; k < end; k++)
+      {
+         b_pos[A_j[k]]++;
+      }
    }
-   for (i = 0; i < nnz; i++)
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for schedule(static)
+#endif
+   for (int j = 0; j < n; j++)
    {
-      At_i[A_j[i]+1]++;
+      int cnt = 0;
+      for (int b = 0; b < nb; b++)
+      {
+         const int b_cnt = pos[b*n + j];
+         pos[b*n + j] = cnt;
+         cnt += b_cnt;
+      }
+      At_i[j+1] = cnt;
    }
-   for (i = 1; i < n; i++)
+   At_i[0] = 0;
+   for (int j = 0; j < n; j++)
    {
-      At_i[i+1] += At_i[i];
+      At_i[j+1] += At_i[j];
    }
-
-   for (i = j = 0; i < m; i++)
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for schedule(static)
+#endif
+   for (int b = 0; b < nb; b++)
    {
-      end = A_i[i+1];
-      for ( ; j < end; j++)
+      int *b_pos = pos.GetData() + b*n;
+      const int end = RowBlockBegin(b+1, nb, m);
+      for (int i = RowBlockBegin(b, nb, m); i < end; i++)
       {
-         At_j[At_i[A_j[j]]] = i;
-         At_data[At_i[A_j[j]]] = A_data[j];
-         At_i[A_j[j]]++;
+         for (int k = A_i[i]; k < A_i[i+1]; k++)
+         {
+            const int j = A_j[k];
+            const int p = At_i[j] + b_pos[j]++;
+            At_j[p] = i;
+            At_data[p] = A_data[k];
+         }
       }
    }
 
-   for (i = n; i > 0; i--)
-   {
-      At_i[i] = At_i[i-1];
-   }
-   At_i[0] = 0;
-
    return  new SparseMatrix(At_i, At_j, At_data, n, m);
 }
 
@@ -3115,12 +3157,9 @@ SparseMatrix *Mult (const SparseMatrix &A, const SparseMatrix &B,
 {
    int nrowsA, ncolsA, nrowsB, ncolsB;
    const int *A_i, *A_j, *B_i, *B_j;
-   int *C_i, *C_j, *B_marker;
+   int *C_i, *C_j;
    const double *A_data, *B_data;
    double *C_data;
-   int ia, ib, ic, ja, jb, num_nonzeros;
-   int row_start, counter;
-   double a_entry, b_entry;
    SparseMatrix *C;
 
    nrowsA = A.Height();
@@ -3139,45 +3178,53 @@ SparseMatrix *Mult (const SparseMatrix &A, const SparseMatrix &B,
    B_j    = B.GetJ();
    B_data = B.GetData();
 
-   B_marker = new int[ncolsB];
-
-   for (ib = 0; ib < ncolsB; ib++)
-   {
-      B_marker[ib] = -1;
-   }
+   // The rows of C are split into contiguous blocks, processed in parallel
+   // with one marker array (dense accumulator) per block. Within a row, the
+   // entries are ordered by their first occurrence in the product, which
+   // does not depend on the number of blocks.
+   const int nb = GetNumRowBlocks(nrowsA);
 
    if (OAB == NULL)
    {
+      // Symbolic phase: count the entries of each row of C
       C_i = Memory<int>(nrowsA+1);
-
-      C_i[0] = num_nonzeros = 0;
-      for (ic = 0; ic < nrowsA; ic++)
+#ifdef MFEM_USE_OPENMP
+      #pragma omp parallel for schedule(static)
+#endif
+      for (int b = 0; b < nb; b++)
       {
-         for (ia = A_i[ic]; ia < A_i[ic+1]; ia++)
+         Array<int> B_marker(ncolsB);
+         B_marker = -1;
+         const int end = RowBlockBegin(b+1, nb, nrowsA);
+         for (int ic = RowBlockBegin(b, nb, nrowsA); ic < end; ic++)
          {
-            ja = A_j[ia];
-            for (ib = B_i[ja]; ib < B_i[ja+1]; ib++)
+            int num_nonzeros = 0;
+            for (int ia = A_i[ic]; ia < A_i[ic+1]; ia++)
             {
-               jb = B_j[ib];
-               if (B_marker[jb] != ic)
+               const int ja = A_j[ia];
+               for (int ib = B_i[ja]; ib < B_i[ja+1]; ib++)
                {
-                  B_marker[jb] = ic;
-                  num_nonzeros++;
+                  const int jb = B_j[ib];
+                  if (B_marker[jb] != ic)
+                  {
+                     B_marker[jb] = ic;
+                     num_nonzeros++;
+                  }
                }
             }
+            C_i[ic+1] = num_nonzeros;
          }
-         C_i[ic+1] = num_nonzeros;
+      }
+      C_i[0] = 0;
+      for (int ic = 0; ic < nrowsA; ic++)
+      {
+         C_i[ic+1] += C_i[ic];
       }
 
-      C_j    = Memory<int>(num_nonzeros);
-      C_data = Memory<double>(num_nonzeros);
+      C_j    = Memory<int>(C_i[nrowsA]);
+      C_data = Memory<double>(C_i[nrowsA]);
 
       C = new SparseMatrix(C_i, C_j, C_data, nrowsA, ncolsB);
-
-      for (ib = 0; ib < ncolsB; ib++)
-      {
-         B_marker[ib] = -1;
-      }
    }
    else
    {
@@ -3190,50 +3237,59 @@ SparseMatrix *Mult (const SparseMatrix &A, const SparseMatrix &B,
                   << " ncolsB = " << ncolsB
                   << ", C->Width() = " << C->Width());
 
-      // C_i    = C -> GetI(); // not used
+      C_i    = C -> GetI();
       C_j    = C -> GetJ();
       C_data = C -> GetData();
    }
 
-   counter = 0;
-   for (ic = 0; ic < nrowsA; ic++)
+   // Numeric phase. With a pre-allocated OAB, only the values are computed.
+   int num_errors = 0;
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for schedule(static) reduction(+:num_errors)
+#endif
+   for (int b = 0; b < nb; b++)
    {
-      // row_start = C_i[ic];
-      row_start = counter;
-      for (ia = A_i[ic]; ia < A_i[ic+1]; ia++)
+      Array<int> B_marker(ncolsB);
+      B_marker = -1;
+      const int end = RowBlockBegin(b+1, nb, nrowsA);
+      for (int ic = RowBlockBegin(b, nb, nrowsA); ic < end; ic++)
       {
-         ja = A_j[ia];
-         a_entry = A_data[ia];
-         for (ib = B_i[ja]; ib < B_i[ja+1]; ib++)
+         const int row_start = C_i[ic];
+         const int row_end = C_i[ic+1];
+         int counter = row_start;
+         for (int ia = A_i[ic]; ia < A_i[ic+1]; ia++)
          {
-            jb = B_j[ib];
-            b_entry = B_data[ib];
-            if (B_marker[jb] < row_start)
+            const int ja = A_j[ia];
+            const double a_entry = A_data[ia];
+            for (int ib = B_i[ja]; ib < B_i[ja+1]; ib++)
             {
-               B_marker[jb] = counter;
-               if (OAB == NULL)
+               const int jb = B_j[ib];
+               const double b_entry = B_data[ib];
+               if (B_marker[jb] < row_start)
                {
-                  C_j[counter] = jb;
+                  if (counter == row_end) { num_errors++; continue; }
+                  B_marker[jb] = counter;
+                  if (OAB == NULL)
+                  {
+                     C_j[counter] = jb;
+                  }
+                  C_data[counter] = a_entry*b_entry;
+                  counter++;
+               }
+               else
+               {
+                  C_data[B_marker[jb]] += a_entry*b_entry;
                }
-               C_data[counter] = a_entry*b_entry;
-               counter++;
-            }
-            else
-            {
-               C_data[B_marker[jb]] += a_entry*b_entry;
             }
          }
+         if (counter != row_end) { num_errors++; }
       }
    }
 
-   MFEM_VERIFY(
-      OAB == NULL || counter == OAB->NumNonZeroElems(),
-      "With pre-allocated output matrix, number of non-zeros ("
-      << OAB->NumNonZeroElems()
-      << ") did not match number of entries changed from matrix-matrix multiply, "
-      << counter);
-
-   delete [] B_marker;
+   MFEM_VERIFY(num_errors == 0,
+               "With pre-allocated output matrix, the number of non-zeros in "
+               << num_errors << " rows did not match the matrix-matrix "
+               "multiply");
 
    return C;
 }
@@ -3379,10 +3435,77 @@ DenseMatrix *RAP(DenseMatrix &A, const SparseMatrix &P)
    return _RAP;
 }
 
+// Compute the entries of C = R A P on the given sparsity pattern of C, which
+// must contain the pattern of the product. The rows of C are computed in
+// parallel, without forming the intermediate products.
+static void RAPNumeric(const SparseMatrix &R, const SparseMatrix &A,
+                       const SparseMatrix &P, SparseMatrix &C)
+{
+   MFEM_VERIFY(R.Width() == A.Height() && A.Width() == P.Height() &&
+               C.Height() == R.Height() && C.Width() == P.Width(),
+               "incompatible matrix sizes");
+   const int nrows = C.Height();
+   const int ncols = C.Width();
+   const int *R_i = R.GetI(), *R_j = R.GetJ();
+   const int *A_i = A.GetI(), *A_j = A.GetJ();
+   const int *P_i = P.GetI(), *P_j = P.GetJ();
+   const int *C_i = C.GetI(), *C_j = C.GetJ();
+   const double *R_data = R.GetData();
+   const double *A_data = A.GetData();
+   const double *P_data = P.GetData();
+   double *C_data = C.GetData();
+
+   const int nb = GetNumRowBlocks(nrows);
+   int num_errors = 0;
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for schedule(static) reduction(+:num_errors)
+#endif
+   for (int b = 0; b < nb; b++)
+   {
+      // C_marker[j] is the position of C(i,j) in C_j and C_data, or a value
+      // smaller than C_i[i] if C(i,j) is not in the pattern
+      Array<int> C_marker(ncols);
+      C_marker = -1;
+      const int end = RowBlockBegin(b+1, nb, nrows);
+      for (int i = RowBlockBegin(b, nb, nrows); i < end; i++)
+      {
+         for (int p = C_i[i]; p < C_i[i+1]; p++)
+         {
+            C_marker[C_j[p]] = p;
+            C_data[p] = 0.0;
+         }
+         for (int ir = R_i[i]; ir < R_i[i+1]; ir++)
+         {
+            const int k = R_j[ir];
+            const double r_entry = R_data[ir];
+            for (int ia = A_i[k]; ia < A_i[k+1]; ia++)
+            {
+               const int l = A_j[ia];
+               const double ra_entry = r_entry*A_data[ia];
+               for (int ip = P_i[l]; ip < P_i[l+1]; ip++)
+               {
+                  const int p = C_marker[P_j[ip]];
+                  if (p < C_i[i]) { num_errors++; continue; }
+                  C_data[p] += ra_entry*P_data[ip];
+               }
+            }
+         }
+      }
+   }
+   MFEM_VERIFY(num_errors == 0, "the sparsity pattern of the output matrix"
+               " does not contain the pattern of the product");
+}
+
 SparseMatrix *RAP (const SparseMatrix &A, const SparseMatrix &R,
                    SparseMatrix *ORAP)
 {
    SparseMatrix *P  = Transpose (R);
+   if (ORAP)
+   {
+      RAPNumeric(R, A, *P, *ORAP);
+      delete P;
+      return ORAP;
+   }
    SparseMatrix *AP = Mult (A, *P);
    delete P;
    SparseMatrix *_RAP = Mult (R, *AP, ORAP);
@@ -3391,9 +3514,15 @@ SparseMatrix *RAP (const SparseMatrix &A, const SparseMatrix &R,
 }
 
 SparseMatrix *RAP(const SparseMatrix &Rt, const SparseMatrix &A,
-                  const SparseMatrix &P)
+                  const SparseMatrix &P, SparseMatrix *ORAP)
 {
    SparseMatrix * R = Transpose(Rt);
+   if (ORAP)
+   {
+      RAPNumeric(*R, A, P, *ORAP);
+      delete R;
+      return ORAP;
+   }
    SparseMatrix * RA = Mult(*R,A);
    delete R;
    SparseMatrix * out = Mult(*RA, P);
@@ -583,6 +583,7 @@ void SparseMatrixFunction(SparseMatrix &S, double (*f)(double));
 
 
 /// Transpose of a sparse matrix. A must be finalized.
+/** With OpenMP enabled, blocks of rows of A are transposed in parallel. */
 SparseMatrix *Transpose(const SparseMatrix &A);
 /// Transpose of a sparse matrix. A does not need to be a CSR matrix.
 SparseMatrix *TransposeAbstractSparseMatrix (const AbstractSparseMatrix &A,
@@ -593,6 +594,10 @@ SparseMatrix *TransposeAbstractSparseMatrix (const AbstractSparseMatrix &A,
     result in @a OAB. If @a OAB is NULL, we create a new SparseMatrix to store
     the result and return a pointer to it.
 
+    With OpenMP enabled, the symbolic and the numeric phases of the product
+    are computed in parallel over blocks of rows of A; the result does not
+    depend on the number of threads.
+
     All matrices must be finalized. */
 SparseMatrix *Mult(const SparseMatrix &A, const SparseMatrix &B,
                    SparseMatrix *OAB = NULL);
@@ -613,14 +618,17 @@ DenseMatrix *RAP(const SparseMatrix &A, DenseMatrix &P);
 /// RAP matrix product (with R=P^T)
 DenseMatrix *RAP(DenseMatrix &A, const SparseMatrix &P);
 
-/** RAP matrix product (with P=R^T). ORAP is like OAB above.
+/** RAP matrix product (with P=R^T). If @a ORAP is not NULL, its sparsity
+    pattern must contain the pattern of R.A.P; only the values of @a ORAP are
+    then recomputed, without forming the intermediate products, which is
+    useful when the same product is formed repeatedly with different values.
     All matrices must be finalized. */
 SparseMatrix *RAP(const SparseMatrix &A, const SparseMatrix &R,
                   SparseMatrix *ORAP = NULL);
 
-/// General RAP with given R^T, A and P
+/// General RAP with given R^T, A and P. ORAP is like in RAP() above.
 SparseMatrix *RAP(const SparseMatrix &Rt, const SparseMatrix &A,
-                  const SparseMatrix &P);
+                  const SparseMatrix &P, SparseMatrix *ORAP = NULL);
 
 /// Matrix multiplication A^t D A. All matrices must be finalized.
 SparseMatrix *Mult_AtDA(const SparseMatrix &A, const Vector &D,
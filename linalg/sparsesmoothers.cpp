@@ -15,6 +15,7 @@
 #include "matrix.hpp"
 #include "sparsemat.hpp"
 #include "sparsesmoothers.hpp"
+#include "../general/forall.hpp"
 #include <iostream>
 
 namespace mfem
@@ -51,6 +52,135 @@ void GSSmoother::Mult(const Vector &x, Vector &y) const
    }
 }
 
+MulticolorGSSmoother::MulticolorGSSmoother(const SparseMatrix &a, int t,
+                                           double w, int it)
+   : SparseSmoother(a), type(t), omega(w), iterations(it)
+{
+   Setup();
+}
+
+void MulticolorGSSmoother::SetOperator(const Operator &a)
+{
+   SparseSmoother::SetOperator(a);
+   Setup();
+}
+
+void MulticolorGSSmoother::Setup()
+{
+   MFEM_VERIFY(oper->Finalized(), "the matrix must be finalized");
+   MFEM_VERIFY(height == width, "the matrix must be square");
+   const int n = height;
+   const int *I = oper->HostReadI();
+   const int *J = oper->HostReadJ();
+   const double *A = oper->HostReadData();
+
+   // Greedy coloring of the pattern of A + A^T: every row gets the smallest
+   // color not used by its already colored neighbors
+   SparseMatrix *At = Transpose(*oper);
+   const int *It = At->GetI(), *Jt = At->GetJ();
+   Array<int> colors(n), marker;
+   colors = -1;
+   num_colors = 0;
+   for (int i = 0; i < n; i++)
+   {
+      for (int k = I[i]; k < I[i+1]; k++)
+      {
+         if (colors[J[k]] >= 0) { marker[colors[J[k]]] = i; }
+      }
+      for (int k = It[i]; k < It[i+1]; k++)
+      {
+         if (colors[Jt[k]] >= 0) { marker[colors[Jt[k]]] = i; }
+      }
+      int c = 0;
+      while (c < num_colors && marker[c] == i) { c++; }
+      if (c == num_colors)
+      {
+         num_colors++;
+         marker.Append(-1);
+      }
+      colors[i] = c;
+   }
+   delete At;
+
+   // Group the rows by color
+   color_offsets.SetSize(num_colors+1);
+   color_offsets = 0;
+   for (int i = 0; i < n; i++) { color_offsets[colors[i]+1]++; }
+   color_offsets.PartialSum();
+   color_rows.SetSize(n);
+   marker.SetSize(num_colors);
+   for (int c = 0; c < num_colors; c++) { marker[c] = color_offsets[c]; }
+   for (int i = 0; i < n; i++) { color_rows[marker[colors[i]]++] = i; }
+
+   inv_diag.SetSize(n);
+   for (int i = 0; i < n; i++)
+   {
+      double d = 0.0;
+      for (int k = I[i]; k < I[i+1]; k++)
+      {
+         if (J[k] == i) { d += A[k]; }
+      }
+      MFEM_VERIFY(d != 0.0, "zero diagonal entry in row " << i);
+      inv_diag[i] = 1.0 / d;
+   }
+}
+
+void MulticolorGSSmoother::GetColors(Array<int> &colors) const
+{
+   colors.SetSize(height);
+   for (int c = 0; c < num_colors; c++)
+   {
+      for (int k = color_offsets[c]; k < color_offsets[c+1]; k++)
+      {
+         colors[color_rows[k]] = c;
+      }
+   }
+}
+
+void MulticolorGSSmoother::ColorSweep(int c, const Vector &x, Vector &y) const
+{
+   const int offset = color_offsets[c];
+   const int size = color_offsets[c+1] - offset;
+   const double w = omega;
+   auto rows = color_rows.Read() + offset;
+   auto I = oper->ReadI();
+   auto J = oper->ReadJ();
+   auto A = oper->ReadData();
+   auto D = inv_diag.Read();
+   auto X = x.Read();
+   auto Y = y.ReadWrite();
+   MFEM_FORALL(k, size,
+   {
+      const int i = rows[k];
+      double r = X[i];
+      for (int p = I[i]; p < I[i+1]; p++)
+      {
+         r -= A[p] * Y[J[p]];
+      }
+      Y[i] += w * D[i] * r;
+   });
+}
+
+/// Matrix vector multiplication with the multicolor GS smoother.
+void MulticolorGSSmoother::Mult(const Vector &x, Vector &y) const
+{
+   if (!iterative_mode)
+   {
+      y = 0.0;
+   }
+   for (int it = 0; it < iterations; it++)
+   {
+      if (type != 2)
+      {
+         for (int c = 0; c < num_colors; c++) { ColorSweep(c, x, y); }
+      }
+      if (type != 1)
+      {
+         for (int c = num_colors-1; c >= 0; c--) { ColorSweep(c, x, y); }
+      }
+   }
+}
+
 /// Create the Jacobi smoother.
 DSmoother::DSmoother(const SparseMatrix &a, int t, double s, int it)
    : SparseSmoother(a)
@@ -51,6 +51,56 @@ public:
    virtual void Mult(const Vector &x, Vector &y) const;
 };
 
+/** @brief Multicolor Gauss-Seidel/SOR smoother of a finalized sparse matrix.
+
+    The rows are colored once, when the operator is set, such that rows of the
+    same color are not coupled in the (symmetrized) sparsity pattern. A sweep
+    then updates the colors one after the other, and all rows of a color in
+    parallel with MFEM_FORALL, so the smoother runs with the OpenMP and device
+    backends. The result equals a sequential Gauss-Seidel sweep with the rows
+    reordered by color; the number of iterations needed may therefore differ
+    slightly from GSSmoother. */
+class MulticolorGSSmoother : public SparseSmoother
+{
+protected:
+   int type; // 0, 1, 2 - symmetric, forward, backward
+   double omega;
+   int iterations;
+
+   int num_colors;
+   /// The rows of color c are color_rows[color_offsets[c]...].
+   Array<int> color_offsets, color_rows;
+   Vector inv_diag;
+
+   /// Compute the coloring and the inverse of the diagonal of the matrix.
+   void Setup();
+
+   /// Update the rows of color @a c of @a y.
+   void ColorSweep(int c, const Vector &x, Vector &y) const;
+
+public:
+   /** @brief Create a smoother of the given @a type (0 - symmetric, 1 -
+       forward, 2 - backward) with relaxation parameter @a w (SOR, or SSOR
+       for type 0), applying @a it sweeps. */
+   MulticolorGSSmoother(int t = 0, double w = 1.0, int it = 1)
+      : type(t), omega(w), iterations(it), num_colors(0) { }
+
+   /// Create a smoother of the matrix @a a, see the other constructor.
+   MulticolorGSSmoother(const SparseMatrix &a, int t = 0, double w = 1.0,
+                        int it = 1);
+
+   virtual void SetOperator(const Operator &a);
+
+   /// Return the number of colors of the rows of the matrix.
+   int GetNumColors() const { return num_colors; }
+
+   /// Return the color of every row of the matrix in @a colors.
+   void GetColors(Array<int> &colors) const;
+
+   /// Matrix vector multiplication with the multicolor GS smoother.
+   virtual void Mult(const Vector &x, Vector &y) const;
+};
+
 /// Data type for scaled Jacobi-type smoother of sparse matrix
 class DSmoother : public SparseSmoother
 {
@@ -17,6 +17,7 @@
 #include "../general/binaryio.hpp"
 #include "../general/text.hpp"
 #include "../general/device.hpp"
+#include "../general/forall.hpp"
 #include "../general/tic_toc.hpp"
 #include "../general/gecko.hpp"
 #include "../fem/quadinterpolator.hpp"
@@ -374,8 +375,8 @@ void Mesh::GetElementTransformation(int i, const Vector &nodes,
    if (Nodes == NULL)
    {
       MFEM_ASSERT(nodes.Size() == spaceDim*GetNV(), "");
-      int       nv = elements[i]->GetNVertices();
-      const int *v = elements[i]->GetVertices();
+      int       nv = Geometry::NumVerts[GetElementBaseGeometry(i)];
+      const int *v = ElementVertices(i);
       int n = vertices.Size();
       pm.SetSize(spaceDim, nv);
       for (int k = 0; k < spaceDim; k++)
@@ -805,6 +806,7 @@ void Mesh::DeleteGeometricFactors()
       delete face_geom_factors[i];
    }
    face_geom_factors.SetSize(0);
+   elem_bb_grid.Clear();
 }
 
 void Mesh::GetLocalFaceTransformation(
@@ -1002,7 +1004,7 @@ FaceElementTransformations *Mesh::GetBdrFaceTransformations(int BdrElemNo)
    }
    else
    {
-      fn = boundary[BdrElemNo]->GetVertices()[0];
+      fn = BdrElementVertices(BdrElemNo)[0];
    }
    // Check if the face is interior, shared, or non-conforming.
    if (FaceIsTrueInterior(fn) || faces_info[fn].NCFace >= 0)
@@ -1010,7 +1012,7 @@ FaceElementTransformations *Mesh::GetBdrFaceTransformations(int BdrElemNo)
       return NULL;
    }
    tr = GetFaceElementTransformations(fn, 21);
-   tr->Attribute = boundary[BdrElemNo]->GetAttribute();
+   tr->Attribute = GetBdrAttribute(BdrElemNo);
    tr->ElementNo = BdrElemNo;
    tr->ElementType = ElementTransformation::BDR_FACE;
    return tr;
@@ -1067,6 +1069,7 @@ void Mesh::Init()
    own_nodes = 1;
    NURBSext = NULL;
    ncmesh = NULL;
+   compact_elements = compact_boundary = NULL;
    last_operation = Mesh::NONE;
 }
 
@@ -1106,14 +1109,23 @@ void Mesh::DestroyPointers()
 
    delete NURBSext;
 
-   for (int i = 0; i < NumOfElements; i++)
+   if (compact_elements)
    {
-      FreeElement(elements[i]);
+      delete compact_elements;
+      delete compact_boundary;
+      compact_elements = compact_boundary = NULL;
    }
-
-   for (int i = 0; i < NumOfBdrElements; i++)
+   else
    {
-      FreeElement(boundary[i]);
+      for (int i = 0; i < NumOfElements; i++)
+      {
+         FreeElement(elements[i]);
+      }
+
+      for (int i = 0; i < NumOfBdrElements; i++)
+      {
+         FreeElement(boundary[i]);
+      }
    }
 
    for (int i = 0; i < faces.Size(); i++)
@@ -1337,6 +1349,8 @@ void Mesh::GenerateBoundaryElements()
    int i, j;
    Array<int> &be2face = (Dim == 2) ? be_to_edge : be_to_face;
 
+   UseCompactElementStorage(false);
+
    // GenerateFaces();
 
    for (i = 0; i < boundary.Size(); i++)
@@ -1376,6 +1390,7 @@ void Mesh::FinalizeCheck()
                vertices.Size() == 0,
                "incorrect number of vertices: preallocated: " << vertices.Size()
                << ", actually added: " << NumOfVertices);
+   if (compact_elements) { return; }
    MFEM_VERIFY(elements.Size() == NumOfElements,
                "incorrect number of elements: preallocated: " << elements.Size()
                << ", actually added: " << NumOfElements);
@@ -1696,6 +1711,8 @@ void Mesh::GetHilbertElementOrdering(Array<int> &ordering)
 
 void Mesh::ReorderElements(const Array<int> &ordering, bool reorder_vertices)
 {
+   UseCompactElementStorage(false);
+
    if (NURBSext)
    {
       MFEM_WARNING("element reordering of NURBS meshes is not supported.");
@@ -2411,6 +2428,8 @@ void Mesh::FinalizeTopology(bool generate_bdr)
 
 void Mesh::Finalize(bool refine, bool fix_orientation)
 {
+   UseCompactElementStorage(false);
+
    if (NURBSext || ncmesh)
    {
       MFEM_ASSERT(CheckElementOrientation(false) == 0, "");
@@ -2963,23 +2982,30 @@ Mesh::Mesh(const Mesh &mesh, bool copy_nodes)
    sequence = 0;
    last_operation = Mesh::NONE;
 
-   // Duplicate the elements
-   elements.SetSize(NumOfElements);
-   for (int i = 0; i < NumOfElements; i++)
+   // Duplicate the elements and the boundary, in the same storage
+   if (mesh.compact_elements)
+   {
+      compact_elements = new CompactElementArray(*mesh.compact_elements);
+      compact_boundary = new CompactElementArray(*mesh.compact_boundary);
+   }
+   else
    {
-      elements[i] = mesh.elements[i]->Duplicate(this);
+      compact_elements = compact_boundary = NULL;
+      elements.SetSize(NumOfElements);
+      for (int i = 0; i < NumOfElements; i++)
+      {
+         elements[i] = mesh.elements[i]->Duplicate(this);
+      }
+      boundary.SetSize(NumOfBdrElements);
+      for (int i = 0; i < NumOfBdrElements; i++)
+      {
+         boundary[i] = mesh.boundary[i]->Duplicate(this);
+      }
    }
 
    // Copy the vertices
    mesh.vertices.Copy(vertices);
 
-   // Duplicate the boundary
-   boundary.SetSize(NumOfBdrElements);
-   for (int i = 0; i < NumOfBdrElements; i++)
-   {
-      boundary[i] = mesh.boundary[i]->Duplicate(this);
-   }
-
    // Copy the element-to-face Table, el_to_face
    el_to_face = (mesh.el_to_face) ? new Table(*mesh.el_to_face) : NULL;
 
@@ -3233,7 +3259,7 @@ void Mesh::SetMeshGen()
    meshgen = mesh_geoms = 0;
    for (int i = 0; i < NumOfElements; i++)
    {
-      const Element::Type type = GetElement(i)->GetType();
+      const Element::Type type = GetElementType(i);
       switch (type)
       {
          case Element::TETRAHEDRON:
@@ -3294,6 +3320,7 @@ void Mesh::Loader(std::istream &input, int generate_edges,
    bool mfem_v10 = (mesh_type == "MFEM mesh v1.0");
    bool mfem_v11 = (mesh_type == "MFEM mesh v1.1");
    bool mfem_v12 = (mesh_type == "MFEM mesh v1.2");
+   bool mfem_bin = (mesh_type == "MFEM binary mesh v1.0");
    if (mfem_v10 || mfem_v11 || mfem_v12) // MFEM's own mesh formats
    {
       // Formats mfem_v12 and newer have a tag indicating the end of the mesh
@@ -3306,6 +3333,12 @@ void Mesh::Loader(std::istream &input, int generate_edges,
       }
       ReadMFEMMesh(input, mfem_v11, curved);
    }
+   else if (mfem_bin) // binary MFEM mesh format
+   {
+      // the binary format always ends with a section delimiter
+      if (parse_tag.empty()) { parse_tag = "mfem_mesh_end"; }
+      ReadMFEMBinaryMesh(input, curved);
+   }
    else if (mesh_type == "linemesh") // 1D mesh
    {
       ReadLineMesh(input);
@@ -3418,7 +3451,7 @@ void Mesh::Loader(std::istream &input, int generate_edges,
 
    // If a parse tag was supplied, keep reading the stream until the tag is
    // encountered.
-   if (mfem_v12)
+   if (mfem_v12 || mfem_bin)
    {
       string line;
       do
@@ -3443,7 +3476,7 @@ Mesh::Mesh(Mesh *mesh_array[], int num_pieces)
 {
    int      i, j, ie, ib, iv, *v, nv;
    Element *el;
-   Mesh    *m;
+   const Mesh *m;
 
    SetEmpty();
 
@@ -4092,7 +4125,7 @@ int Mesh::CheckElementOrientation(bool fix_it)
       {
          if (Nodes == NULL)
          {
-            vi = elements[i]->GetVertices();
+            vi = ElementVertices(i);
             for (j = 0; j < 3; j++)
             {
                v[j] = vertices[vi[j]]();
@@ -4138,7 +4171,7 @@ int Mesh::CheckElementOrientation(bool fix_it)
 
       for (i = 0; i < NumOfElements; i++)
       {
-         vi = elements[i]->GetVertices();
+         vi = ElementVertices(i);
          switch (GetElementType(i))
          {
             case Element::TETRAHEDRON:
@@ -4459,7 +4492,7 @@ int Mesh::CheckBdrElementOrientation(bool fix_it)
       {
          if (faces_info[be_to_edge[i]].Elem2No < 0) // boundary face
          {
-            int *bv = boundary[i]->GetVertices();
+            int *bv = BdrElementVertices(i);
             int *fv = faces[be_to_edge[i]]->GetVertices();
             if (bv[0] != fv[0])
             {
@@ -4482,7 +4515,7 @@ int Mesh::CheckBdrElementOrientation(bool fix_it)
          if (faces_info[fi].Elem2No >= 0) { continue; }
 
          // boundary face
-         int *bv = boundary[i]->GetVertices();
+         int *bv = BdrElementVertices(i);
          // Make sure the 'faces' are generated:
          MFEM_ASSERT(fi < faces.Size(), "internal error");
          const int *fv = faces[fi]->GetVertices();
@@ -4590,12 +4623,13 @@ void Mesh::GetElementEdges(int i, Array<int> &edges, Array<int> &cor) const
                  "is not generated.");
    }
 
-   const int *v = elements[i]->GetVertices();
-   const int ne = elements[i]->GetNEdges();
+   const Element *ref = ReferenceElement(i);
+   const int *v = ElementVertices(i);
+   const int ne = ref->GetNEdges();
    cor.SetSize(ne);
    for (int j = 0; j < ne; j++)
    {
-      const int *e = elements[i]->GetEdgeVertices(j);
+      const int *e = ref->GetEdgeVertices(j);
       cor[j] = (v[e[0]] < v[e[1]]) ? (1) : (-1);
    }
 }
@@ -4607,7 +4641,7 @@ void Mesh::GetBdrElementEdges(int i, Array<int> &edges, Array<int> &cor) const
       edges.SetSize(1);
       cor.SetSize(1);
       edges[0] = be_to_edge[i];
-      const int *v = boundary[i]->GetVertices();
+      const int *v = BdrElementVertices(i);
       cor[0] = (v[0] < v[1]) ? (1) : (-1);
    }
    else if (Dim == 3)
@@ -4621,12 +4655,13 @@ void Mesh::GetBdrElementEdges(int i, Array<int> &edges, Array<int> &cor) const
          mfem_error("Mesh::GetBdrElementEdges(...)");
       }
 
-      const int *v = boundary[i]->GetVertices();
-      const int ne = boundary[i]->GetNEdges();
+      const Element *be = GetBdrElement(i);
+      const int *v = be->GetVertices();
+      const int ne = be->GetNEdges();
       cor.SetSize(ne);
       for (int j = 0; j < ne; j++)
       {
-         const int *e = boundary[i]->GetEdgeVertices(j);
+         const int *e = be->GetEdgeVertices(j);
          cor[j] = (v[e[0]] < v[e[1]]) ? (1) : (-1);
       }
    }
@@ -4690,6 +4725,9 @@ Table *Mesh::GetFaceEdgeTable() const
    }
 #endif
 
+   // use the edge numbering of el_to_edge, see GetEdgeVertexTable()
+   GetEdgeVertexTable();
+
    DSTable v_to_v(NumOfVertices);
    GetVertexToVertexTable(v_to_v);
 
@@ -4706,6 +4744,28 @@ Table *Mesh::GetEdgeVertexTable() const
       return edge_vertex;
    }
 
+   if (el_to_edge)
+   {
+      // The edges are not necessarily numbered in the order of the DSTable,
+      // e.g. after TensorUniformRefinement(), so follow el_to_edge.
+      edge_vertex = new Table(NumOfEdges, 2);
+      for (int i = 0; i < NumOfElements; i++)
+      {
+         const Element *ref = ReferenceElement(i);
+         const int *v = ElementVertices(i);
+         const int *ee = el_to_edge->GetRow(i);
+         const int ne = ref->GetNEdges();
+         for (int j = 0; j < ne; j++)
+         {
+            const int *e = ref->GetEdgeVertices(j);
+            int *ev = edge_vertex->GetRow(ee[j]);
+            ev[0] = std::min(v[e[0]], v[e[1]]);
+            ev[1] = std::max(v[e[0]], v[e[1]]);
+         }
+      }
+      return edge_vertex;
+   }
+
    DSTable v_to_v(NumOfVertices);
    GetVertexToVertexTable(v_to_v);
 
@@ -4727,7 +4787,8 @@ Table *Mesh::GetEdgeVertexTable() const
 
 Table *Mesh::GetVertexToElementTable()
 {
-   int i, j, nv, *v;
+   int i, j, nv;
+   const int *v;
 
    Table *vert_elem = new Table;
 
@@ -4735,8 +4796,8 @@ Table *Mesh::GetVertexToElementTable()
 
    for (i = 0; i < NumOfElements; i++)
    {
-      nv = elements[i]->GetNVertices();
-      v  = elements[i]->GetVertices();
+      nv = Geometry::NumVerts[GetElementBaseGeometry(i)];
+      v  = ElementVertices(i);
       for (j = 0; j < nv; j++)
       {
          vert_elem->AddAColumnInRow(v[j]);
@@ -4747,8 +4808,8 @@ Table *Mesh::GetVertexToElementTable()
 
    for (i = 0; i < NumOfElements; i++)
    {
-      nv = elements[i]->GetNVertices();
-      v  = elements[i]->GetVertices();
+      nv = Geometry::NumVerts[GetElementBaseGeometry(i)];
+      v  = ElementVertices(i);
       for (j = 0; j < nv; j++)
       {
          vert_elem->AddConnection(v[j], i);
@@ -4837,7 +4898,7 @@ void Mesh::GetBdrElementFace(int i, int *f, int *o) const
    const int *bv, *fv;
 
    *f = be_to_face[i];
-   bv = boundary[i]->GetVertices();
+   bv = BdrElementVertices(i);
    fv = faces[be_to_face[i]]->GetVertices();
 
    // find the orientation of the bdr. elem. w.r.t.
@@ -4859,7 +4920,7 @@ int Mesh::GetBdrElementEdgeIndex(int i) const
 {
    switch (Dim)
    {
-      case 1: return boundary[i]->GetVertices()[0];
+      case 1: return BdrElementVertices(i)[0];
       case 2: return be_to_edge[i];
       case 3: return be_to_face[i];
       default: mfem_error("Mesh::GetBdrElementEdgeIndex: invalid dimension!");
@@ -4873,7 +4934,7 @@ void Mesh::GetBdrElementAdjacentElement(int bdr_el, int &el, int &info) const
    const FaceInfo &fi = faces_info[fid];
    MFEM_ASSERT(fi.Elem1Inf%64 == 0, "internal error"); // orientation == 0
    const int *fv = (Dim > 1) ? faces[fid]->GetVertices() : NULL;
-   const int *bv = boundary[bdr_el]->GetVertices();
+   const int *bv = BdrElementVertices(bdr_el);
    int ori;
    switch (GetBdrElementBaseGeometry(bdr_el))
    {
@@ -4889,12 +4950,13 @@ void Mesh::GetBdrElementAdjacentElement(int bdr_el, int &el, int &info) const
 
 Element::Type Mesh::GetElementType(int i) const
 {
-   return elements[i]->GetType();
+   return ReferenceElement(i)->GetType();
 }
 
 Element::Type Mesh::GetBdrElementType(int i) const
 {
-   return boundary[i]->GetType();
+   return compact_boundary ? compact_boundary->GetReferenceElement(
+             GetBdrElementBaseGeometry(i))->GetType() : boundary[i]->GetType();
 }
 
 void Mesh::GetPointMatrix(int i, DenseMatrix &pointmat) const
@@ -4902,8 +4964,8 @@ void Mesh::GetPointMatrix(int i, DenseMatrix &pointmat) const
    int k, j, nv;
    const int *v;
 
-   v  = elements[i]->GetVertices();
-   nv = elements[i]->GetNVertices();
+   v  = ElementVertices(i);
+   nv = Geometry::NumVerts[GetElementBaseGeometry(i)];
 
    pointmat.SetSize(spaceDim, nv);
    for (k = 0; k < spaceDim; k++)
@@ -4920,8 +4982,8 @@ void Mesh::GetBdrPointMatrix(int i,DenseMatrix &pointmat) const
    int k, j, nv;
    const int *v;
 
-   v  = boundary[i]->GetVertices();
-   nv = boundary[i]->GetNVertices();
+   v  = BdrElementVertices(i);
+   nv = Geometry::NumVerts[GetBdrElementBaseGeometry(i)];
 
    pointmat.SetSize(spaceDim, nv);
    for (k = 0; k < spaceDim; k++)
@@ -4968,6 +5030,30 @@ void Mesh::GetElementArrayEdgeTable(const Array<Element*> &elem_array,
    el_to_edge.ShiftUpI();
 }
 
+void Mesh::GetElementArrayEdgeTable(const CompactElementArray &elems,
+                                    const DSTable &v_to_v, Table &el_to_edge)
+{
+   el_to_edge.MakeI(elems.Size());
+   for (int i = 0; i < elems.Size(); i++)
+   {
+      el_to_edge.AddColumnsInRow(i, Geometry::NumEdges[elems.GetGeometry(i)]);
+   }
+   el_to_edge.MakeJ();
+   for (int i = 0; i < elems.Size(); i++)
+   {
+      const Geometry::Type geom = elems.GetGeometry(i);
+      const Element *ref = elems.GetReferenceElement(geom);
+      const int *v = elems.GetVertices(i);
+      const int ne = Geometry::NumEdges[geom];
+      for (int j = 0; j < ne; j++)
+      {
+         const int *e = ref->GetEdgeVertices(j);
+         el_to_edge.AddConnection(i, v_to_v(v[e[0]], v[e[1]]));
+      }
+   }
+   el_to_edge.ShiftUpI();
+}
+
 void Mesh::GetVertexToVertexTable(DSTable &v_to_v) const
 {
    if (edge_vertex)
@@ -4982,11 +5068,12 @@ void Mesh::GetVertexToVertexTable(DSTable &v_to_v) const
    {
       for (int i = 0; i < NumOfElements; i++)
       {
-         const int *v = elements[i]->GetVertices();
-         const int ne = elements[i]->GetNEdges();
+         const Element *ref = ReferenceElement(i);
+         const int *v = ElementVertices(i);
+         const int ne = ref->GetNEdges();
          for (int j = 0; j < ne; j++)
          {
-            const int *e = elements[i]->GetEdgeVertices(j);
+            const int *e = ref->GetEdgeVertices(j);
             v_to_v.Push(v[e[0]], v[e[1]]);
          }
       }
@@ -5003,7 +5090,14 @@ int Mesh::GetElementToEdgeTable(Table & e_to_f, Array<int> &be_to_f)
    NumberOfEdges = v_to_v.NumberOfEntries();
 
    // Fill the element to edge table
-   GetElementArrayEdgeTable(elements, v_to_v, e_to_f);
+   if (compact_elements)
+   {
+      GetElementArrayEdgeTable(*compact_elements, v_to_v, e_to_f);
+   }
+   else
+   {
+      GetElementArrayEdgeTable(elements, v_to_v, e_to_f);
+   }
 
    if (Dim == 2)
    {
@@ -5011,7 +5105,7 @@ int Mesh::GetElementToEdgeTable(Table & e_to_f, Array<int> &be_to_f)
       be_to_f.SetSize(NumOfBdrElements);
       for (i = 0; i < NumOfBdrElements; i++)
       {
-         const int *v = boundary[i]->GetVertices();
+         const int *v = BdrElementVertices(i);
          be_to_f[i] = v_to_v(v[0], v[1]);
       }
    }
@@ -5021,7 +5115,14 @@ int Mesh::GetElementToEdgeTable(Table & e_to_f, Array<int> &be_to_f)
       {
          bel_to_edge = new Table;
       }
-      GetElementArrayEdgeTable(boundary, v_to_v, *bel_to_edge);
+      if (compact_boundary)
+      {
+         GetElementArrayEdgeTable(*compact_boundary, v_to_v, *bel_to_edge);
+      }
+      else
+      {
+         GetElementArrayEdgeTable(boundary, v_to_v, *bel_to_edge);
+      }
    }
    else
    {
@@ -5203,7 +5304,7 @@ void Mesh::GenerateFaces()
    }
    for (i = 0; i < NumOfElements; i++)
    {
-      const int *v = elements[i]->GetVertices();
+      const int *v = ElementVertices(i);
       const int *ef;
       if (Dim == 1)
       {
@@ -5213,10 +5314,11 @@ void Mesh::GenerateFaces()
       else if (Dim == 2)
       {
          ef = el_to_edge->GetRow(i);
-         const int ne = elements[i]->GetNEdges();
+         const Element *ref = ReferenceElement(i);
+         const int ne = ref->GetNEdges();
          for (int j = 0; j < ne; j++)
          {
-            const int *e = elements[i]->GetEdgeVertices(j);
+            const int *e = ref->GetEdgeVertices(j);
             AddSegmentFaceElement(j, ef[j], i, v[e[0]], v[e[1]]);
          }
       }
@@ -5329,7 +5431,7 @@ STable3D *Mesh::GetFacesTable()
    STable3D *faces_tbl = new STable3D(NumOfVertices);
    for (int i = 0; i < NumOfElements; i++)
    {
-      const int *v = elements[i]->GetVertices();
+      const int *v = ElementVertices(i);
       switch (GetElementType(i))
       {
          case Element::TETRAHEDRON:
@@ -5375,7 +5477,8 @@ STable3D *Mesh::GetFacesTable()
 
 STable3D *Mesh::GetElementToFaceTable(int ret_ftbl)
 {
-   int i, *v;
+   int i;
+   const int *v;
    STable3D *faces_tbl;
 
    if (el_to_face != NULL)
@@ -5386,7 +5489,7 @@ STable3D *Mesh::GetElementToFaceTable(int ret_ftbl)
    faces_tbl = new STable3D(NumOfVertices);
    for (i = 0; i < NumOfElements; i++)
    {
-      v = elements[i]->GetVertices();
+      v = ElementVertices(i);
       switch (GetElementType(i))
       {
          case Element::TETRAHEDRON:
@@ -5436,7 +5539,7 @@ STable3D *Mesh::GetElementToFaceTable(int ret_ftbl)
    be_to_face.SetSize(NumOfBdrElements);
    for (i = 0; i < NumOfBdrElements; i++)
    {
-      v = boundary[i]->GetVertices();
+      v = BdrElementVertices(i);
       switch (GetBdrElementType(i))
       {
          case Element::TRIANGLE:
@@ -5493,6 +5596,8 @@ void Mesh::ReorientTetMesh()
       return;
    }
 
+   UseCompactElementStorage(false);
+
    ResetLazyData();
 
    DSTable *old_v_to_v = NULL;
@@ -5589,7 +5694,12 @@ int *Mesh::CartesianPartitioning(int nxyz[])
 
 int *Mesh::GeneratePartitioning(int nparts, int part_method)
 {
-#ifdef MFEM_USE_METIS
+   MFEM_VERIFY(part_method >= 0 && part_method <= 9,
+               "invalid partitioning method: " << part_method);
+#ifndef MFEM_USE_METIS
+   // Without METIS, the graph based methods use the native partitioner
+   if (part_method <= 5) { part_method = 9; }
+#endif
 
    int print_messages = 1;
    // If running in parallel, print messages only from rank 0.
@@ -5625,6 +5735,27 @@ int *Mesh::GeneratePartitioning(int nparts, int part_method)
          partitioning[i] = i;
       }
    }
+   else if (part_method >= 6)
+   {
+      switch (part_method)
+      {
+         case 6: PartitionRCB(nparts, partitioning); break;
+         case 7: PartitionSFC(nparts, true, partitioning); break;
+         case 8: PartitionSFC(nparts, false, partitioning); break;
+         case 9: PartitionGraph(nparts, partitioning); break;
+      }
+#ifdef MFEM_DEBUG
+      if (print_messages)
+      {
+         int edgecut;
+         double imbalance;
+         GetPartitioningStats(partitioning, nparts, edgecut, imbalance);
+         mfem::out << "Mesh::GeneratePartitioning(...): edgecut = "
+                   << edgecut << ", imbalance = " << imbalance << endl;
+      }
+#endif
+   }
+#ifdef MFEM_USE_METIS
    else
    {
       idx_t *I, *J, n;
@@ -5820,6 +5951,7 @@ int *Mesh::GeneratePartitioning(int nparts, int part_method)
          delete[] mpartitioning;
       }
    }
+#endif
 
    delete el_to_el;
    el_to_el = NULL;
@@ -5851,8 +5983,8 @@ int *Mesh::GeneratePartitioning(int nparts, int part_method)
       {
          if (print_messages)
          {
-            mfem::err << "Mesh::GeneratePartitioning(...): METIS returned "
-                      << empty_parts << " empty parts!"
+            mfem::err << "Mesh::GeneratePartitioning(...): partitioner "
+                      << "returned " << empty_parts << " empty parts!"
                       << " Applying a simple fix ..." << endl;
          }
 
@@ -5900,15 +6032,6 @@ int *Mesh::GeneratePartitioning(int nparts, int part_method)
    }
 
    return partitioning;
-
-#else
-
-   mfem_error("Mesh::GeneratePartitioning(...): "
-              "MFEM was compiled without Metis.");
-
-   return NULL;
-
-#endif
 }
 
 /* required: 0 <= partitioning[i] < num_part */
@@ -6315,9 +6438,8 @@ void Mesh::CheckDisplacements(const Vector &displacements, double &tmax)
    }
    for (int i = 0; i < NumOfElements; i++)
    {
-      Element *el = elements[i];
-      int nv = el->GetNVertices();
-      int *v = el->GetVertices();
+      const int nv = Geometry::NumVerts[GetElementBaseGeometry(i)];
+      const int *v = ElementVertices(i);
       P.SetSize(spaceDim, nv);
       V.SetSize(spaceDim, nv);
       for (int j = 0; j < spaceDim; j++)
@@ -6328,9 +6450,9 @@ void Mesh::CheckDisplacements(const Vector &displacements, double &tmax)
          }
       DS.SetSize(nv, spaceDim);
       const FiniteElement *fe =
-         GetTransformationFEforElementType(el->GetType());
+         GetTransformationFEforElementType(GetElementType(i));
       // check if  det(P.DShape+t*V.DShape) > 0 for all x and 0<=t<=1
-      switch (el->GetType())
+      switch (GetElementType(i))
       {
          case Element::TRIANGLE:
          case Element::TETRAHEDRON:
@@ -6380,6 +6502,7 @@ void Mesh::CheckDisplacements(const Vector &displacements, double &tmax)
 
 void Mesh::MoveVertices(const Vector &displacements)
 {
+   elem_bb_grid.Clear();
    for (int i = 0, nv = vertices.Size(); i < nv; i++)
       for (int j = 0; j < spaceDim; j++)
       {
@@ -6400,6 +6523,7 @@ void Mesh::GetVertices(Vector &vert_coord) const
 
 void Mesh::SetVertices(const Vector &vert_coord)
 {
+   elem_bb_grid.Clear();
    for (int i = 0, nv = vertices.Size(); i < nv; i++)
       for (int j = 0; j < spaceDim; j++)
       {
@@ -6448,6 +6572,7 @@ void Mesh::SetNode(int i, const double *coord)
 
 void Mesh::MoveNodes(const Vector &displacements)
 {
+   elem_bb_grid.Clear();
    if (Nodes)
    {
       (*Nodes) += displacements;
@@ -6472,6 +6597,7 @@ void Mesh::GetNodes(Vector &node_coord) const
 
 void Mesh::SetNodes(const Vector &node_coord)
 {
+   elem_bb_grid.Clear();
    if (Nodes)
    {
       (*Nodes) = node_coord;
@@ -6484,6 +6610,7 @@ void Mesh::SetNodes(const Vector &node_coord)
 
 void Mesh::NewNodes(GridFunction &nodes, bool make_owner)
 {
+   elem_bb_grid.Clear();
    if (own_nodes) { delete Nodes; }
    Nodes = &nodes;
    spaceDim = Nodes->FESpace()->GetVDim();
@@ -6498,6 +6625,7 @@ void Mesh::NewNodes(GridFunction &nodes, bool make_owner)
 
 void Mesh::SwapNodes(GridFunction *&nodes, int &own_nodes_)
 {
+   elem_bb_grid.Clear();
    mfem::Swap<GridFunction*>(Nodes, nodes);
    mfem::Swap<int>(own_nodes, own_nodes_);
    // TODO:
@@ -7287,121 +7415,575 @@ void Mesh::UniformRefinement3D_base(Array<int> *f2qf_ptr, DSTable *v_to_v_p,
    if (update_nodes) { UpdateNodes(); }
 }
 
-void Mesh::LocalRefinement(const Array<int> &marked_el, int type)
+void Mesh::UniformRefinement2D()
 {
-   int i, j, ind, nedges;
-   Array<int> v;
-
-   ResetLazyData();
+   if (GetNumGeometries(2) == 1 && HasGeometry(Geometry::SQUARE))
+   {
+      TensorUniformRefinement();
+   }
+   else
+   {
+      UniformRefinement2D_base();
+   }
+}
 
-   if (ncmesh)
+void Mesh::UniformRefinement3D()
+{
+   if (GetNumGeometries(3) == 1 && HasGeometry(Geometry::CUBE))
    {
-      MFEM_ABORT("Local and nonconforming refinements cannot be mixed.");
+      TensorUniformRefinement();
    }
+   else
+   {
+      UniformRefinement3D_base();
+   }
+}
 
-   InitRefinementTransforms();
+// The children of a refined quadrilateral and hexahedron, in the order of
+// UniformRefinement2D_base() and UniformRefinement3D_base(). Each child vertex
+// is given by the parent entity it is the midpoint of: the parent vertices
+// 0..nv-1 are followed by the edges, the faces (hexahedron) and the center.
+static const int quad_child_verts[4][4] =
+{
+   { 0, 4, 8, 7 }, { 4, 1, 5, 8 }, { 8, 5, 2, 6 }, { 7, 8, 6, 3 }
+};
+static const int hex_child_verts[8][8] =
+{
+   {  0,  8, 20, 11, 16, 21, 26, 24 }, {  8,  1,  9, 20, 21, 17, 22, 26 },
+   { 20,  9,  2, 10, 26, 22, 18, 23 }, { 11, 20, 10,  3, 24, 26, 23, 19 },
+   { 16, 21, 26, 24,  4, 12, 25, 15 }, { 21, 17, 22, 26, 12,  5, 13, 25 },
+   { 26, 22, 18, 23, 25, 13,  6, 14 }, { 24, 26, 23, 19, 15, 25, 14,  7 }
+};
 
-   if (Dim == 1) // --------------------------------------------------------
-   {
-      int cne = NumOfElements, cnv = NumOfVertices;
-      NumOfVertices += marked_el.Size();
-      NumOfElements += marked_el.Size();
-      vertices.SetSize(NumOfVertices);
-      elements.SetSize(NumOfElements);
-      CoarseFineTr.embeddings.SetSize(NumOfElements);
+// Return the local index of vertex v in the quadrilateral face fv.
+static inline int QuadFaceVertex(const int *fv, int v)
+{
+   int k = 0;
+   while (fv[k] != v) { k++; }
+   return k;
+}
 
-      for (j = 0; j < marked_el.Size(); j++)
-      {
-         i = marked_el[j];
-         Segment *c_seg = (Segment *)elements[i];
-         int *vert = c_seg->GetVertices(), attr = c_seg->GetAttribute();
-         int new_v = cnv + j, new_e = cne + j;
-         AverageVertices(vert, 2, new_v);
-         elements[new_e] = new Segment(new_v, vert[1], attr);
-         vert[1] = new_v;
+// Return k such that (v0,v1) is the edge (fv[k],fv[(k+1)%4]) of the face fv.
+static inline int QuadFaceEdge(const int *fv, int v0, int v1)
+{
+   const int k0 = QuadFaceVertex(fv, v0), k1 = QuadFaceVertex(fv, v1);
+   return ((k0+1) % 4 == k1) ? k0 : k1;
+}
 
-         CoarseFineTr.embeddings[i] = Embedding(i, 1);
-         CoarseFineTr.embeddings[new_e] = Embedding(i, 2);
-      }
+// Renumber the entities in the table el_to_ent in the order in which they first
+// appear, element by element, as DSTable and STable3D number them. Returns the
+// map from the old to the new numbers in perm.
+static void FirstAppearanceOrder(Table &el_to_ent, int nent, Array<int> &perm)
+{
+   int *J = el_to_ent.GetJ();
+   const int nnz = el_to_ent.Size_of_connections();
+   perm.SetSize(nent);
+   perm = -1;
+   int cnt = 0;
+   for (int k = 0; k < nnz; k++)
+   {
+      if (perm[J[k]] < 0) { perm[J[k]] = cnt++; }
+   }
+   MFEM_VERIFY(cnt == nent, "not all entities appear in the table");
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int k = 0; k < nnz; k++) { J[k] = perm[J[k]]; }
+}
 
-      static double seg_children[3*2] = { 0.0,1.0, 0.0,0.5, 0.5,1.0 };
-      CoarseFineTr.point_matrices[Geometry::SEGMENT].
-      UseExternalData(seg_children, 1, 2, 3);
+void Mesh::TensorUniformRefinement(bool update_nodes)
+{
+   ResetLazyData();
 
+   if (el_to_edge == NULL)
+   {
+      el_to_edge = new Table;
+      NumOfEdges = GetElementToEdgeTable(*el_to_edge, be_to_edge);
+   }
+   if (Dim == 3 && el_to_face == NULL)
+   {
+      GetElementToFaceTable();
       GenerateFaces();
+   }
 
-   } // end of 'if (Dim == 1)'
-   else if (Dim == 2) // ---------------------------------------------------
+   const bool hex = (Dim == 3);
+   const Geometry::Type geom = hex ? Geometry::CUBE : Geometry::SQUARE;
+   const int nv = hex ? 8 : 4, ne = hex ? 12 : 4, nf = hex ? 6 : 0;
+   const int nc = 1 << Dim; // number of children
+   const int (*el_edges)[2] = hex ? hex_t::Edges : quad_t::Edges;
+   const int *child_verts = hex ? hex_child_verts[0] : quad_child_verts[0];
+   // the interior edges of a child connect the center with the midpoints of
+   // the parent edges (2D) or faces (3D), numbered from 'tmid'
+   const int nmid = hex ? nf : ne, tmid = nv + ne + nf - nmid;
+
+   const int NV = NumOfVertices, NEd = NumOfEdges, NE = NumOfElements;
+   const int NF = hex ? NumOfFaces : 0, NBE = NumOfBdrElements;
+
+   // Offsets of the new vertices: edge midpoints, face and element centers.
+   const int oedge = NV, oface = oedge + NEd, oelem = oface + NF;
+   // Offsets of the new edges: the halves of the coarse edges, the edges in
+   // the coarse faces (3D) and the edges inside the coarse elements.
+   const int fedge = 2*NEd, iedge = fedge + 4*NF;
+   const int nedges = iedge + nmid*NE;
+   // Offsets of the new faces (3D): children of the coarse faces, followed by
+   // the faces inside the coarse elements.
+   const int iface = 4*NF;
+   const int nfaces = hex ? iface + 12*NE : 0;
+
+   // The coarse edges with sorted vertices, numbered as in el_to_edge.
+   Table *coarse_edge_vertex = GetEdgeVertexTable();
+   edge_vertex = NULL;
+
+   vertices.SetSize(oelem + NE);
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < NEd; i++)
    {
-      // 1. Get table of vertex to vertex connections.
-      DSTable v_to_v(NumOfVertices);
-      GetVertexToVertexTable(v_to_v);
+      AverageVertices(coarse_edge_vertex->GetRow(i), 2, oedge + i);
+   }
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < NF; i++)
+   {
+      AverageVertices(faces[i]->GetVertices(), 4, oface + i);
+   }
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < NE; i++)
+   {
+      AverageVertices(elements[i]->GetVertices(), nv, oelem + i);
+   }
 
-      // 2. Get edge to element connections in arrays edge1 and edge2
-      nedges = v_to_v.NumberOfEntries();
-      int *edge1  = new int[nedges];
-      int *edge2  = new int[nedges];
-      int *middle = new int[nedges];
+   Array<Element*> new_elements(nc*NE);
+   Table *new_el_to_edge = new Table(nc*NE, ne);
+   Table *new_el_to_face = hex ? new Table(nc*NE, nf) : NULL;
+   Table *new_edge_vertex = new Table(nedges, 2);
 
-      for (i = 0; i < nedges; i++)
-      {
-         edge1[i] = edge2[i] = middle[i] = -1;
-      }
+   // The halves of the coarse edges: the first one contains the coarse vertex
+   // with the smaller index.
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < NEd; i++)
+   {
+      const int *cv = coarse_edge_vertex->GetRow(i);
+      int *ev0 = new_edge_vertex->GetRow(2*i);
+      int *ev1 = new_edge_vertex->GetRow(2*i+1);
+      ev0[0] = std::min(cv[0], cv[1]);  ev0[1] = oedge + i;
+      ev1[0] = std::max(cv[0], cv[1]);  ev1[1] = oedge + i;
+   }
 
-      for (i = 0; i < NumOfElements; i++)
-      {
-         elements[i]->GetVertices(v);
-         for (j = 1; j < v.Size(); j++)
-         {
-            ind = v_to_v(v[j-1], v[j]);
-            (edge1[ind] == -1) ? (edge1[ind] = i) : (edge2[ind] = i);
-         }
-         ind = v_to_v(v[0], v[v.Size()-1]);
-         (edge1[ind] == -1) ? (edge1[ind] = i) : (edge2[ind] = i);
-      }
+   // Refine the elements. The edges in a coarse face are written to
+   // new_edge_vertex by the first element of the face only.
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < NE; i++)
+   {
+      const int attr = elements[i]->GetAttribute();
+      const int *v = elements[i]->GetVertices();
+      const int *e = el_to_edge->GetRow(i);
+      const int *f = hex ? el_to_face->GetRow(i) : NULL;
 
-      // 3. Do the red refinement.
-      for (i = 0; i < marked_el.Size(); i++)
-      {
-         RedRefinement(marked_el[i], v_to_v, edge1, edge2, middle);
-      }
+      // the new vertex of each parent entity
+      int pv[27];
+      for (int k = 0; k < nv; k++) { pv[k] = v[k]; }
+      for (int k = 0; k < ne; k++) { pv[nv+k] = oedge + e[k]; }
+      for (int k = 0; k < nf; k++) { pv[nv+ne+k] = oface + f[k]; }
+      pv[nv+ne+nf] = oelem + i;
 
-      // 4. Do the green refinement (to get conforming mesh).
-      int need_refinement;
-      do
+      for (int c = 0; c < nc; c++)
       {
-         need_refinement = 0;
-         for (i = 0; i < nedges; i++)
+         const int ci = nc*i + c;
+         const int *cp = child_verts + c*nv;
+         int cv[8];
+         for (int k = 0; k < nv; k++) { cv[k] = pv[cp[k]]; }
+         if (hex) { new_elements[ci] = new Hexahedron(cv, attr); }
+         else { new_elements[ci] = new Quadrilateral(cv, attr); }
+
+         int *ce = new_el_to_edge->GetRow(ci);
+         for (int j = 0; j < ne; j++)
          {
-            if (middle[i] != -1 && edge1[i] != -1)
+            int a = cp[el_edges[j][0]], b = cp[el_edges[j][1]];
+            if (a > b) { std::swap(a, b); }
+            bool owner = true;
+            if (a < nv)
             {
-               need_refinement = 1;
-               GreenRefinement(edge1[i], v_to_v, edge1, edge2, middle);
+               // half of the parent edge b-nv containing the vertex a
+               const int *pe = el_edges[b-nv];
+               const int o = (pe[0] == a) ? pe[1] : pe[0];
+               ce[j] = 2*e[b-nv] + (v[a] < v[o] ? 0 : 1);
+               owner = false;
+            }
+            else if (a < tmid)
+            {
+               // edge between the center of the parent face b-nv-ne and the
+               // midpoint of the parent edge a-nv
+               const int gf = f[b-nv-ne];
+               const int *pe = el_edges[a-nv];
+               const int k =
+                  QuadFaceEdge(faces[gf]->GetVertices(), v[pe[0]], v[pe[1]]);
+               ce[j] = fedge + 4*gf + k;
+               owner = (faces_info[gf].Elem1No == i);
+            }
+            else
+            {
+               // edge between the parent center and the midpoint a
+               ce[j] = iedge + nmid*i + (a - tmid);
+            }
+            if (owner)
+            {
+               const int v0 = cv[el_edges[j][0]], v1 = cv[el_edges[j][1]];
+               int *ev = new_edge_vertex->GetRow(ce[j]);
+               ev[0] = std::min(v0, v1);
+               ev[1] = std::max(v0, v1);
             }
          }
-      }
-      while (need_refinement == 1);
 
-      // 5. Update the boundary elements.
-      int v1[2], v2[2], bisect, temp;
-      temp = NumOfBdrElements;
-      for (i = 0; i < temp; i++)
-      {
-         boundary[i]->GetVertices(v);
-         bisect = v_to_v(v[0], v[1]);
-         if (middle[bisect] != -1) // the element was refined (needs updating)
+         if (!hex) { continue; }
+         int *cf = new_el_to_face->GetRow(ci);
+         for (int j = 0; j < nf; j++)
          {
-            if (boundary[i]->GetType() == Element::SEGMENT)
+            const int *fv = hex_t::FaceVert[j];
+            int a = cp[fv[0]], b = a;
+            for (int k = 1; k < 4; k++)
             {
-               v1[0] =           v[0]; v1[1] = middle[bisect];
-               v2[0] = middle[bisect]; v2[1] =           v[1];
-
-               boundary[i]->SetVertices(v1);
-               boundary.Append(new Segment(v2, boundary[i]->GetAttribute()));
+               a = std::min(a, cp[fv[k]]);
+               b = std::max(b, cp[fv[k]]);
+            }
+            if (a < nv)
+            {
+               // child of the parent face b-nv-ne containing the vertex a
+               const int gf = f[b-nv-ne];
+               cf[j] = 4*gf + QuadFaceVertex(faces[gf]->GetVertices(), v[a]);
             }
             else
-               mfem_error("Only bisection of segment is implemented"
-                          " for bdr elem.");
+            {
+               // face inside the parent, containing the midpoint of edge a-nv
+               cf[j] = iface + 12*i + (a - nv);
+            }
+         }
+      }
+      FreeElement(elements[i]);
+   }
+   mfem::Swap(elements, new_elements);
+   delete el_to_edge;
+   el_to_edge = new_el_to_edge;
+   if (hex)
+   {
+      delete el_to_face;
+      el_to_face = new_el_to_face;
+   }
+
+   // refine boundary elements
+   const int nbc = nc/2;
+   Array<Element*> new_boundary(nbc*NBE);
+   if (!hex)
+   {
+      Array<int> new_be_to_edge(nbc*NBE);
+#ifdef MFEM_USE_OPENMP
+      #pragma omp parallel for
+#endif
+      for (int i = 0; i < NBE; i++)
+      {
+         const int attr = boundary[i]->GetAttribute();
+         const int *v = boundary[i]->GetVertices();
+         const int ge = be_to_edge[i];
+
+         new_boundary[2*i] = new Segment(v[0], oedge+ge, attr);
+         new_boundary[2*i+1] = new Segment(oedge+ge, v[1], attr);
+         new_be_to_edge[2*i] = 2*ge + (v[0] < v[1] ? 0 : 1);
+         new_be_to_edge[2*i+1] = 2*ge + (v[1] < v[0] ? 0 : 1);
+
+         FreeElement(boundary[i]);
+      }
+      mfem::Swap(be_to_edge, new_be_to_edge);
+   }
+   else
+   {
+      Array<int> new_be_to_face(nbc*NBE);
+      Table *new_bel_to_edge = new Table(nbc*NBE, 4);
+#ifdef MFEM_USE_OPENMP
+      #pragma omp parallel for
+#endif
+      for (int i = 0; i < NBE; i++)
+      {
+         const int attr = boundary[i]->GetAttribute();
+         const int *v = boundary[i]->GetVertices();
+         const int *e = bel_to_edge->GetRow(i);
+         const int gf = be_to_face[i];
+         const int *fv = faces[gf]->GetVertices();
+
+         int pv[9];
+         for (int k = 0; k < 4; k++) { pv[k] = v[k]; pv[4+k] = oedge + e[k]; }
+         pv[8] = oface + gf;
+
+         for (int c = 0; c < 4; c++)
+         {
+            const int ci = 4*i + c;
+            const int *cp = quad_child_verts[c];
+            int cv[4];
+            for (int k = 0; k < 4; k++) { cv[k] = pv[cp[k]]; }
+            new_boundary[ci] = new Quadrilateral(cv, attr);
+            new_be_to_face[ci] = 4*gf + QuadFaceVertex(fv, v[c]);
+
+            int *ce = new_bel_to_edge->GetRow(ci);
+            for (int j = 0; j < 4; j++)
+            {
+               int a = cp[quad_t::Edges[j][0]], b = cp[quad_t::Edges[j][1]];
+               if (a > b) { std::swap(a, b); }
+               if (a < 4)
+               {
+                  const int *pe = quad_t::Edges[b-4];
+                  const int o = (pe[0] == a) ? pe[1] : pe[0];
+                  ce[j] = 2*e[b-4] + (v[a] < v[o] ? 0 : 1);
+               }
+               else
+               {
+                  const int *pe = quad_t::Edges[a-4];
+                  ce[j] = fedge + 4*gf + QuadFaceEdge(fv, v[pe[0]], v[pe[1]]);
+               }
+            }
+         }
+         FreeElement(boundary[i]);
+      }
+      mfem::Swap(be_to_face, new_be_to_face);
+      delete bel_to_edge;
+      bel_to_edge = new_bel_to_edge;
+   }
+   mfem::Swap(boundary, new_boundary);
+
+   // Renumber the new edges and faces in the order of the DSTable and the
+   // STable3D, so that the numbering does not change when the refined mesh is
+   // printed and loaded again.
+   Array<int> perm;
+   FirstAppearanceOrder(*el_to_edge, nedges, perm);
+   delete coarse_edge_vertex;
+   edge_vertex = new Table(nedges, 2);
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < nedges; i++)
+   {
+      const int *ev = new_edge_vertex->GetRow(i);
+      int *pev = edge_vertex->GetRow(perm[i]);
+      pev[0] = ev[0];
+      pev[1] = ev[1];
+   }
+   delete new_edge_vertex;
+   if (!hex)
+   {
+#ifdef MFEM_USE_OPENMP
+      #pragma omp parallel for
+#endif
+      for (int i = 0; i < be_to_edge.Size(); i++)
+      {
+         be_to_edge[i] = perm[be_to_edge[i]];
+      }
+   }
+   else
+   {
+      int *J = bel_to_edge->GetJ();
+      const int nnz = bel_to_edge->Size_of_connections();
+#ifdef MFEM_USE_OPENMP
+      #pragma omp parallel for
+#endif
+      for (int k = 0; k < nnz; k++) { J[k] = perm[J[k]]; }
+
+      FirstAppearanceOrder(*el_to_face, nfaces, perm);
+#ifdef MFEM_USE_OPENMP
+      #pragma omp parallel for
+#endif
+      for (int i = 0; i < be_to_face.Size(); i++)
+      {
+         be_to_face[i] = perm[be_to_face[i]];
+      }
+   }
+
+   // The point matrices of the children follow from child_verts.
+   CoarseFineTr.Clear();
+   DenseTensor &pm = CoarseFineTr.point_matrices[geom];
+   pm.SetSize(Dim, nv, nc);
+   const IntegrationRule &ref_verts = *Geometries.GetVertices(geom);
+   for (int c = 0; c < nc; c++)
+   {
+      for (int k = 0; k < nv; k++)
+      {
+         const int t = child_verts[c*nv + k];
+         int idx[8], n;
+         if (t < nv) { idx[0] = t; n = 1; }
+         else if (t < nv + ne)
+         {
+            idx[0] = el_edges[t-nv][0];  idx[1] = el_edges[t-nv][1];  n = 2;
+         }
+         else if (t < nv + ne + nf)
+         {
+            for (n = 0; n < 4; n++) { idx[n] = hex_t::FaceVert[t-nv-ne][n]; }
+         }
+         else
+         {
+            for (n = 0; n < nv; n++) { idx[n] = n; }
+         }
+         for (int d = 0; d < Dim; d++) { pm(d, k, c) = 0.0; }
+         for (int m = 0; m < n; m++)
+         {
+            double x[3];
+            ref_verts.IntPoint(idx[m]).Get(x, Dim);
+            for (int d = 0; d < Dim; d++) { pm(d, k, c) += x[d] / n; }
+         }
+      }
+   }
+   CoarseFineTr.embeddings.SetSize(nc*NE);
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < nc*NE; i++)
+   {
+      Embedding &emb = CoarseFineTr.embeddings[i];
+      emb.parent = i / nc;
+      emb.matrix = i % nc;
+   }
+
+   NumOfVertices    = vertices.Size();
+   NumOfElements    = nc * NumOfElements;
+   NumOfBdrElements = nbc * NumOfBdrElements;
+   NumOfEdges       = nedges;
+   NumOfFaces       = nfaces;
+
+   GenerateFaces();
+
+   last_operation = Mesh::REFINE;
+   sequence++;
+
+   if (update_nodes) { UpdateNodes(); }
+
+#ifdef MFEM_DEBUG
+   if (!Nodes || update_nodes)
+   {
+      CheckElementOrientation(false);
+   }
+   CheckBdrElementOrientation(false);
+#endif
+}
+
+void Mesh::LocalRefinement(const Array<int> &marked_el, int type)
+{
+   int i, j, ind, nedges;
+   Array<int> v;
+
+   ResetLazyData();
+
+   if (ncmesh)
+   {
+      MFEM_ABORT("Local and nonconforming refinements cannot be mixed.");
+   }
+
+   InitRefinementTransforms();
+
+   if (Dim == 1) // --------------------------------------------------------
+   {
+      int cne = NumOfElements, cnv = NumOfVertices;
+      NumOfVertices += marked_el.Size();
+      NumOfElements += marked_el.Size();
+      vertices.SetSize(NumOfVertices);
+      elements.SetSize(NumOfElements);
+      CoarseFineTr.embeddings.SetSize(NumOfElements);
+
+      for (j = 0; j < marked_el.Size(); j++)
+      {
+         i = marked_el[j];
+         Segment *c_seg = (Segment *)elements[i];
+         int *vert = c_seg->GetVertices(), attr = c_seg->GetAttribute();
+         int new_v = cnv + j, new_e = cne + j;
+         AverageVertices(vert, 2, new_v);
+         elements[new_e] = new Segment(new_v, vert[1], attr);
+         vert[1] = new_v;
+
+         CoarseFineTr.embeddings[i] = Embedding(i, 1);
+         CoarseFineTr.embeddings[new_e] = Embedding(i, 2);
+      }
+
+      static double seg_children[3*2] = { 0.0,1.0, 0.0,0.5, 0.5,1.0 };
+      CoarseFineTr.point_matrices[Geometry::SEGMENT].
+      UseExternalData(seg_children, 1, 2, 3);
+
+      GenerateFaces();
+
+   } // end of 'if (Dim == 1)'
+   else if (Dim == 2) // ---------------------------------------------------
+   {
+      // 1. Get table of vertex to vertex connections.
+      DSTable v_to_v(NumOfVertices);
+      GetVertexToVertexTable(v_to_v);
+
+      // 2. Get edge to element connections in arrays edge1 and edge2
+      nedges = v_to_v.NumberOfEntries();
+      int *edge1  = new int[nedges];
+      int *edge2  = new int[nedges];
+      int *middle = new int[nedges];
+
+      for (i = 0; i < nedges; i++)
+      {
+         edge1[i] = edge2[i] = middle[i] = -1;
+      }
+
+      for (i = 0; i < NumOfElements; i++)
+      {
+         elements[i]->GetVertices(v);
+         for (j = 1; j < v.Size(); j++)
+         {
+            ind = v_to_v(v[j-1], v[j]);
+            (edge1[ind] == -1) ? (edge1[ind] = i) : (edge2[ind] = i);
+         }
+         ind = v_to_v(v[0], v[v.Size()-1]);
+         (edge1[ind] == -1) ? (edge1[ind] = i) : (edge2[ind] = i);
+      }
+
+      // 3. Do the red refinement.
+      for (i = 0; i < marked_el.Size(); i++)
+      {
+         RedRefinement(marked_el[i], v_to_v, edge1, edge2, middle);
+      }
+
+      // 4. Do the green refinement (to get conforming mesh).
+      int need_refinement;
+      do
+      {
+         need_refinement = 0;
+         for (i = 0; i < nedges; i++)
+         {
+            if (middle[i] != -1 && edge1[i] != -1)
+            {
+               need_refinement = 1;
+               GreenRefinement(edge1[i], v_to_v, edge1, edge2, middle);
+            }
+         }
+      }
+      while (need_refinement == 1);
+
+      // 5. Update the boundary elements.
+      int v1[2], v2[2], bisect, temp;
+      temp = NumOfBdrElements;
+      for (i = 0; i < temp; i++)
+      {
+         boundary[i]->GetVertices(v);
+         bisect = v_to_v(v[0], v[1]);
+         if (middle[bisect] != -1) // the element was refined (needs updating)
+         {
+            if (boundary[i]->GetType() == Element::SEGMENT)
+            {
+               v1[0] =           v[0]; v1[1] = middle[bisect];
+               v2[0] = middle[bisect]; v2[1] =           v[1];
+
+               boundary[i]->SetVertices(v1);
+               boundary.Append(new Segment(v2, boundary[i]->GetAttribute()));
+            }
+            else
+               mfem_error("Only bisection of segment is implemented"
+                          " for bdr elem.");
          }
       }
       NumOfBdrElements = boundary.Size();
@@ -7736,6 +8318,8 @@ void Mesh::Swap(Mesh& other, bool non_geometry)
    mfem::Swap(elements, other.elements);
    mfem::Swap(vertices, other.vertices);
    mfem::Swap(boundary, other.boundary);
+   mfem::Swap(compact_elements, other.compact_elements);
+   mfem::Swap(compact_boundary, other.compact_boundary);
    mfem::Swap(faces, other.faces);
    mfem::Swap(faces_info, other.faces_info);
    mfem::Swap(nc_faces_info, other.nc_faces_info);
@@ -7753,6 +8337,8 @@ void Mesh::Swap(Mesh& other, bool non_geometry)
    mfem::Swap(bdr_attributes, other.bdr_attributes);
 
    mfem::Swap(geom_factors, other.geom_factors);
+   elem_bb_grid.Clear();
+   other.elem_bb_grid.Clear();
 
 #ifdef MFEM_USE_MEMALLOC
    TetMemory.Swap(other.TetMemory);
@@ -7805,6 +8391,8 @@ static Array<int>& AllElements(Array<int> &list, int nelem)
 
 void Mesh::UniformRefinement(int ref_algo)
 {
+   UseCompactElementStorage(false); // refinement uses the Element objects
+
    Array<int> list;
 
    if (NURBSext)
@@ -7835,6 +8423,8 @@ void Mesh::UniformRefinement(int ref_algo)
 void Mesh::GeneralRefinement(const Array<Refinement> &refinements,
                              int nonconforming, int nc_limit)
 {
+   UseCompactElementStorage(false); // refinement uses the Element objects
+
    if (ncmesh)
    {
       nonconforming = 1;
@@ -7904,6 +8494,7 @@ void Mesh::EnsureNCMesh(bool simplices_nonconforming)
 {
    MFEM_VERIFY(!NURBSext, "Cannot convert a NURBS mesh to an NC mesh. "
                "Project the NURBS to Nodes first.");
+   UseCompactElementStorage(false);
 
    if (!ncmesh)
    {
@@ -8434,9 +9025,9 @@ void Mesh::PrintXG(std::ostream &out) const
       out << NumOfBdrElements << '\n';
       for (i = 0; i < NumOfBdrElements; i++)
       {
-         boundary[i]->GetVertices(v);
+         GetBdrElement(i)->GetVertices(v);
 
-         out << boundary[i]->GetAttribute();
+         out << GetBdrElement(i)->GetAttribute();
          for (j = 0; j < v.Size(); j++)
          {
             out << ' ' << v[j] + 1;
@@ -8448,9 +9039,9 @@ void Mesh::PrintXG(std::ostream &out) const
       out << NumOfElements << '\n';
       for (i = 0; i < NumOfElements; i++)
       {
-         elements[i]->GetVertices(v);
+         GetElement(i)->GetVertices(v);
 
-         out << elements[i]->GetAttribute() << ' ' << v.Size();
+         out << GetElement(i)->GetAttribute() << ' ' << v.Size();
          for (j = 0; j < v.Size(); j++)
          {
             out << ' ' << v[j] + 1;
@@ -8506,9 +9097,9 @@ void Mesh::PrintXG(std::ostream &out) const
          out << NumOfElements << '\n';
          for (i = 0; i < NumOfElements; i++)
          {
-            nv = elements[i]->GetNVertices();
-            ind = elements[i]->GetVertices();
-            out << elements[i]->GetAttribute();
+            nv = GetElement(i)->GetNVertices();
+            ind = GetElement(i)->GetVertices();
+            out << GetElement(i)->GetAttribute();
             for (j = 0; j < nv; j++)
             {
                out << ' ' << ind[j]+1;
@@ -8520,9 +9111,9 @@ void Mesh::PrintXG(std::ostream &out) const
          out << NumOfBdrElements << '\n';
          for (i = 0; i < NumOfBdrElements; i++)
          {
-            nv = boundary[i]->GetNVertices();
-            ind = boundary[i]->GetVertices();
-            out << boundary[i]->GetAttribute();
+            nv = GetBdrElement(i)->GetNVertices();
+            ind = GetBdrElement(i)->GetVertices();
+            out << GetBdrElement(i)->GetAttribute();
             for (j = 0; j < nv; j++)
             {
                out << ' ' << ind[j]+1;
@@ -8549,9 +9140,9 @@ void Mesh::PrintXG(std::ostream &out) const
 
          for (i = 0; i < NumOfElements; i++)
          {
-            nv = elements[i]->GetNVertices();
-            ind = elements[i]->GetVertices();
-            out << i+1 << ' ' << elements[i]->GetAttribute();
+            nv = GetElement(i)->GetNVertices();
+            ind = GetElement(i)->GetVertices();
+            out << i+1 << ' ' << GetElement(i)->GetAttribute();
             for (j = 0; j < nv; j++)
             {
                out << ' ' << ind[j]+1;
@@ -8561,9 +9152,9 @@ void Mesh::PrintXG(std::ostream &out) const
 
          for (i = 0; i < NumOfBdrElements; i++)
          {
-            nv = boundary[i]->GetNVertices();
-            ind = boundary[i]->GetVertices();
-            out << boundary[i]->GetAttribute();
+            nv = GetBdrElement(i)->GetNVertices();
+            ind = GetBdrElement(i)->GetVertices();
+            out << GetBdrElement(i)->GetAttribute();
             for (j = 0; j < nv; j++)
             {
                out << ' ' << ind[j]+1;
@@ -8614,13 +9205,13 @@ void Mesh::Printer(std::ostream &out, std::string section_delimiter) const
        << "\n\nelements\n" << NumOfElements << '\n';
    for (i = 0; i < NumOfElements; i++)
    {
-      PrintElement(elements[i], out);
+      PrintElement(GetElement(i), out);
    }
 
    out << "\nboundary\n" << NumOfBdrElements << '\n';
    for (i = 0; i < NumOfBdrElements; i++)
    {
-      PrintElement(boundary[i], out);
+      PrintElement(GetBdrElement(i), out);
    }
 
    if (ncmesh)
@@ -8659,6 +9250,69 @@ void Mesh::Printer(std::ostream &out, std::string section_delimiter) const
    }
 }
 
+// Write the attributes, geometries and vertices of the elements (or of the
+// boundary elements if 'bdr' is true) of 'mesh' as three contiguous arrays.
+static void WriteBinaryElements(std::ostream &out, const Mesh &mesh, bool bdr)
+{
+   const int n = bdr ? mesh.GetNBE() : mesh.GetNE();
+   Array<int> attr(n), geom(n), vert, v;
+   for (int i = 0; i < n; i++)
+   {
+      if (bdr)
+      {
+         attr[i] = mesh.GetBdrAttribute(i);
+         geom[i] = mesh.GetBdrElementBaseGeometry(i);
+         mesh.GetBdrElementVertices(i, v);
+      }
+      else
+      {
+         attr[i] = mesh.GetAttribute(i);
+         geom[i] = mesh.GetElementBaseGeometry(i);
+         mesh.GetElementVertices(i, v);
+      }
+      vert.Append(v);
+   }
+   bin_io::WriteArray(out, attr.GetData(), n);
+   bin_io::WriteArray(out, geom.GetData(), n);
+   bin_io::WriteArray(out, vert.GetData(), vert.Size());
+}
+
+void Mesh::BinaryPrinter(std::ostream &out,
+                         std::string section_delimiter) const
+{
+   MFEM_VERIFY(!NURBSext && !ncmesh, "the binary MFEM mesh format does not"
+               " support NURBS and nonconforming meshes");
+
+   out << "MFEM binary mesh v1.0\n";
+   const int header[7] = { bin_io::byte_order_mark, Dim, spaceDim,
+                           NumOfElements, NumOfBdrElements, NumOfVertices,
+                           Nodes != NULL
+                         };
+   bin_io::WriteArray(out, header, 7);
+   WriteBinaryElements(out, *this, false);
+   WriteBinaryElements(out, *this, true);
+   if (Nodes == NULL)
+   {
+      Array<double> coord(NumOfVertices*spaceDim);
+      for (int i = 0; i < NumOfVertices; i++)
+      {
+         for (int j = 0; j < spaceDim; j++)
+         {
+            coord[i*spaceDim + j] = vertices[i](j);
+         }
+      }
+      bin_io::WriteArray(out, coord.GetData(), coord.Size());
+   }
+   else
+   {
+      out << '\n';
+      Nodes->SaveBinary(out);
+   }
+
+   out << '\n' << (section_delimiter.empty() ? "mfem_mesh_end" :
+                   section_delimiter) << endl;
+}
+
 void Mesh::PrintTopo(std::ostream &out,const Array<int> &e_to_k) const
 {
    int i;
@@ -8678,13 +9332,13 @@ void Mesh::PrintTopo(std::ostream &out,const Array<int> &e_to_k) const
        << "\n\nelements\n" << NumOfElements << '\n';
    for (i = 0; i < NumOfElements; i++)
    {
-      PrintElement(elements[i], out);
+      PrintElement(GetElement(i), out);
    }
 
    out << "\nboundary\n" << NumOfBdrElements << '\n';
    for (i = 0; i < NumOfBdrElements; i++)
    {
-      PrintElement(boundary[i], out);
+      PrintElement(GetBdrElement(i), out);
    }
 
    out << "\nedges\n" << NumOfEdges << '\n';
@@ -8763,13 +9417,13 @@ void Mesh::PrintVTK(std::ostream &out)
       int size = 0;
       for (int i = 0; i < NumOfElements; i++)
       {
-         size += elements[i]->GetNVertices() + 1;
+         size += Geometry::NumVerts[GetElementBaseGeometry(i)] + 1;
       }
       out << "CELLS " << NumOfElements << ' ' << size << '\n';
       for (int i = 0; i < NumOfElements; i++)
       {
-         const int *v = elements[i]->GetVertices();
-         const int nv = elements[i]->GetNVertices();
+         const int *v = ElementVertices(i);
+         const int nv = Geometry::NumVerts[GetElementBaseGeometry(i)];
          out << nv;
          for (int j = 0; j < nv; j++)
          {
@@ -8828,7 +9482,7 @@ void Mesh::PrintVTK(std::ostream &out)
          else if (order == 2)
          {
             const int *vtk_mfem;
-            switch (elements[i]->GetGeometryType())
+            switch (GetElementBaseGeometry(i))
             {
                case Geometry::SEGMENT:
                case Geometry::TRIANGLE:
@@ -8855,7 +9509,7 @@ void Mesh::PrintVTK(std::ostream &out)
    for (int i = 0; i < NumOfElements; i++)
    {
       int vtk_cell_type = 5;
-      Geometry::Type geom_type = GetElement(i)->GetGeometryType();
+      Geometry::Type geom_type = GetElementBaseGeometry(i);
       if (order == 1)
       {
          switch (geom_type)
@@ -8893,7 +9547,7 @@ void Mesh::PrintVTK(std::ostream &out)
        << "LOOKUP_TABLE default\n";
    for (int i = 0; i < NumOfElements; i++)
    {
-      out << elements[i]->GetAttribute() << '\n';
+      out << GetAttribute(i) << '\n';
    }
    out.flush();
 }
@@ -9433,7 +10087,8 @@ void Mesh::PrintWithPartitioning(int *partitioning, std::ostream &out,
 {
    if (Dim != 3 && Dim != 2) { return; }
 
-   int i, j, k, l, nv, nbe, *v;
+   int i, j, k, l, nv, nbe;
+   const int *v;
 
    out << "MFEM mesh v1.0\n";
 
@@ -9453,10 +10108,10 @@ void Mesh::PrintWithPartitioning(int *partitioning, std::ostream &out,
        << "\n\nelements\n" << NumOfElements << '\n';
    for (i = 0; i < NumOfElements; i++)
    {
-      out << int((elem_attr) ? partitioning[i]+1 : elements[i]->GetAttribute())
-          << ' ' << elements[i]->GetGeometryType();
-      nv = elements[i]->GetNVertices();
-      v  = elements[i]->GetVertices();
+      out << int((elem_attr) ? partitioning[i]+1 : GetAttribute(i))
+          << ' ' << GetElementBaseGeometry(i);
+      nv = GetElement(i)->GetNVertices();
+      v  = GetElement(i)->GetVertices();
       for (j = 0; j < nv; j++)
       {
          out << ' ' << v[j];
@@ -9566,8 +10221,8 @@ void Mesh::PrintElementsWithPartitioning(int *partitioning,
    }
    for (i = 0; i < NumOfElements; i++)
    {
-      nv = elements[i]->GetNVertices();
-      ind = elements[i]->GetVertices();
+      nv = Geometry::NumVerts[GetElementBaseGeometry(i)];
+      ind = ElementVertices(i);
       for (j = 0; j < nv; j++)
       {
          vcount[ind[j]]++;
@@ -9591,7 +10246,7 @@ void Mesh::PrintElementsWithPartitioning(int *partitioning,
    if (Dim == 2)
    {
       int nv, nbe;
-      int *ind;
+      const int *ind;
 
       Table edge_el;
       Transpose(ElementToEdgeTable(), edge_el);
@@ -9599,8 +10254,8 @@ void Mesh::PrintElementsWithPartitioning(int *partitioning,
       // Fake printing of the elements.
       for (i = 0; i < NumOfElements; i++)
       {
-         nv  = elements[i]->GetNVertices();
-         ind = elements[i]->GetVertices();
+         nv  = Geometry::NumVerts[GetElementBaseGeometry(i)];
+         ind = ElementVertices(i);
          for (j = 0; j < nv; j++)
          {
             vcount[ind[j]]--;
@@ -9684,8 +10339,8 @@ void Mesh::PrintElementsWithPartitioning(int *partitioning,
       out << NumOfElements << '\n';
       for (i = 0; i < NumOfElements; i++)
       {
-         nv  = elements[i]->GetNVertices();
-         ind = elements[i]->GetVertices();
+         nv  = Geometry::NumVerts[GetElementBaseGeometry(i)];
+         ind = ElementVertices(i);
          out << partitioning[i]+1 << ' '; // use subdomain number as attribute
          out << nv << ' ';
          for (j = 0; j < nv; j++)
@@ -9733,8 +10388,8 @@ void Mesh::PrintElementsWithPartitioning(int *partitioning,
       out << NumOfElements << '\n';
       for (i = 0; i < NumOfElements; i++)
       {
-         nv = elements[i]->GetNVertices();
-         ind = elements[i]->GetVertices();
+         nv = Geometry::NumVerts[GetElementBaseGeometry(i)];
+         ind = ElementVertices(i);
          out << partitioning[i]+1; // use subdomain number as attribute
          for (j = 0; j < nv; j++)
          {
@@ -9847,8 +10502,8 @@ void Mesh::PrintElementsWithPartitioning(int *partitioning,
 
       for (i = 0; i < NumOfElements; i++)
       {
-         nv = elements[i]->GetNVertices();
-         ind = elements[i]->GetVertices();
+         nv = Geometry::NumVerts[GetElementBaseGeometry(i)];
+         ind = ElementVertices(i);
          out << i+1 << ' ' << partitioning[i]+1; // partitioning as attribute
          for (j = 0; j < nv; j++)
          {
@@ -9948,7 +10603,7 @@ void Mesh::PrintSurfaces(const Table & Aface_face, std::ostream &out) const
        << "\n\nelements\n" << NumOfElements << '\n';
    for (i = 0; i < NumOfElements; i++)
    {
-      PrintElement(elements[i], out);
+      PrintElement(GetElement(i), out);
    }
 
    out << "\nboundary\n" << Aface_face.Size_of_connections() << '\n';
@@ -10128,6 +10783,7 @@ void Mesh::ScaleElements(double sf)
 
 void Mesh::Transform(void (*f)(const Vector&, Vector&))
 {
+   elem_bb_grid.Clear();
    // TODO: support for different new spaceDim.
    if (Nodes == NULL)
    {
@@ -10153,6 +10809,7 @@ void Mesh::Transform(void (*f)(const Vector&, Vector&))
 
 void Mesh::Transform(VectorCoefficient &deformation)
 {
+   elem_bb_grid.Clear();
    MFEM_VERIFY(spaceDim == deformation.GetVDim(),
                "incompatible vector dimensions");
    if (Nodes == NULL)
@@ -10284,6 +10941,7 @@ void Mesh::RemoveUnusedVertices()
 
 void Mesh::RemoveInternalBoundaries()
 {
+   UseCompactElementStorage(false);
    if (NURBSext || ncmesh) { return; }
 
    int num_bdr_elem = 0;
@@ -10395,6 +11053,15 @@ std::ostream &operator<<(std::ostream &out, const Mesh &mesh)
    return out;
 }
 
+const ElementBoundingBoxGrid &Mesh::GetElementBoundingBoxGrid()
+{
+   if (elem_bb_grid.GetSequence() != sequence)
+   {
+      elem_bb_grid.Build(*this);
+   }
+   return elem_bb_grid;
+}
+
 int Mesh::FindPoints(DenseMatrix &point_mat, Array<int>& elem_ids,
                      Array<IntegrationPoint>& ips, bool warn,
                      InverseElementTransformation *inv_trans)
@@ -10408,36 +11075,131 @@ int Mesh::FindPoints(DenseMatrix &point_mat, Array<int>& elem_ids,
    if (!GetNE()) { return 0; }
 
    double *data = point_mat.GetData();
-   InverseElementTransformation *inv_tr = inv_trans;
-   inv_tr = inv_tr ? inv_tr : new InverseElementTransformation;
+   const ElementBoundingBoxGrid &grid = GetElementBoundingBoxGrid();
+
+   // Invert one transformation per geometry type serially, so that the data
+   // created on first use by the inverse transformations (e.g. the refined
+   // geometries used for the initial guess) is not constructed concurrently.
+   {
+      InverseElementTransformation *inv_tr = inv_trans;
+      inv_tr = inv_tr ? inv_tr : new InverseElementTransformation;
+      Array<bool> geom_seen(Geometry::NUM_GEOMETRIES);
+      geom_seen = false;
+      IsoparametricTransformation T;
+      Vector pt(spaceDim);
+      IntegrationPoint ip;
+      for (int i = 0; i < GetNE(); i++)
+      {
+         const int geom = GetElementBaseGeometry(i);
+         if (geom_seen[geom]) { continue; }
+         geom_seen[geom] = true;
+         GetElementTransformation(i, &T);
+         T.Transform(Geometries.GetCenter(geom), pt);
+         inv_tr->SetTransformation(T);
+         inv_tr->Transform(pt, ip);
+      }
+      if (inv_trans == NULL) { delete inv_tr; }
+   }
 
-   // For each point in 'point_mat', find the element whose center is closest.
-   Vector min_dist(npts);
-   Array<int> e_idx(npts);
-   min_dist = std::numeric_limits<double>::max();
-   e_idx = -1;
+   // For each point in 'point_mat', try the elements whose bounding boxes
+   // contain it. With the default InverseElementTransformation, the points are
+   // processed in parallel when threads are available.
+   int pts_found = 0;
+#if defined(MFEM_USE_OPENMP) && defined(MFEM_THREAD_SAFE)
+   #pragma omp parallel if (inv_trans == NULL) reduction(+:pts_found)
+#endif
+   {
+      InverseElementTransformation *inv_tr = inv_trans;
+      inv_tr = inv_tr ? inv_tr : new InverseElementTransformation;
+      IsoparametricTransformation T;
+      Array<int> candidates;
+      Vector pt;
+#if defined(MFEM_USE_OPENMP) && defined(MFEM_THREAD_SAFE)
+      #pragma omp for schedule(dynamic, 64)
+#endif
+      for (int k = 0; k < npts; k++)
+      {
+         pt.SetDataAndSize(data+k*spaceDim, spaceDim);
+         grid.FindCandidates(pt.GetData(), candidates);
+         for (int j = 0; j < candidates.Size(); j++)
+         {
+            GetElementTransformation(candidates[j], &T);
+            inv_tr->SetTransformation(T);
+            int res = inv_tr->Transform(pt, ips[k]);
+            if (res == InverseElementTransformation::Inside)
+            {
+               elem_ids[k] = candidates[j];
+               pts_found++;
+               break;
+            }
+         }
+      }
+      if (inv_trans == NULL) { delete inv_tr; }
+   }
 
+   // For the points not found above, try the element whose center is closest
+   // and its neighbors, in case a bounding box does not contain its element.
+   if (pts_found != npts)
+   {
+      pts_found += FindPointsNearClosestElement(point_mat, elem_ids, ips,
+                                                inv_trans);
+   }
+
+   if (warn && pts_found != npts)
+   {
+      MFEM_WARNING((npts-pts_found) << " points were not found");
+   }
+   return pts_found;
+}
+
+int Mesh::FindPointsNearClosestElement(DenseMatrix &point_mat,
+                                       Array<int> &elem_ids,
+                                       Array<IntegrationPoint> &ips,
+                                       InverseElementTransformation *inv_trans)
+{
+   const int npts = point_mat.Width();
+   double *data = point_mat.GetData();
+   const ElementBoundingBoxGrid &grid = GetElementBoundingBoxGrid();
+
+   // For each point not found yet and inside the grid, find the element whose
+   // center is closest, among the elements of the nearby cells. The points
+   // outside the grid, e.g. the points of the other ranks in ParMesh, are
+   // skipped.
+   Array<int> e_idx(npts), nearby;
+   e_idx = -1;
    Vector pt(spaceDim);
-   for (int i = 0; i < GetNE(); i++)
+   for (int k = 0; k < npts; k++)
    {
-      GetElementTransformation(i)->Transform(
-         Geometries.GetCenter(GetElementBaseGeometry(i)), pt);
-      for (int k = 0; k < npts; k++)
+      if (elem_ids[k] != -1 || !grid.Contains(data+k*spaceDim)) { continue; }
+      grid.FindNearbyElements(data+k*spaceDim, nearby);
+      double min_dist = std::numeric_limits<double>::max();
+      for (int j = 0; j < nearby.Size(); j++)
       {
-         double dist = pt.DistanceTo(data+k*spaceDim);
-         if (dist < min_dist(k))
+         const int i = nearby[j];
+         GetElementTransformation(i)->Transform(
+            Geometries.GetCenter(GetElementBaseGeometry(i)), pt);
+         const double dist = pt.DistanceTo(data+k*spaceDim);
+         if (dist < min_dist)
          {
-            min_dist(k) = dist;
+            min_dist = dist;
             e_idx[k] = i;
          }
       }
    }
+   if (e_idx.Max() < 0) { return 0; }
+
+   InverseElementTransformation *inv_tr = inv_trans;
+   inv_tr = inv_tr ? inv_tr : new InverseElementTransformation;
 
-   // Checks if the points lie in the closest element
+   // Check if the points lie in the closest element or in its vertex-neighbors
+   // (or face-neighbors for non-conforming meshes)
    int pts_found = 0;
+   Array<int> vertices, neigh;
+   Table *vtoel = GetVertexToElementTable();
    pt.NewDataAndSize(NULL, spaceDim);
    for (int k = 0; k < npts; k++)
    {
+      if (e_idx[k] < 0) { continue; }
       pt.SetData(data+k*spaceDim);
       inv_tr->SetTransformation(*GetElementTransformation(e_idx[k]));
       int res = inv_tr->Transform(pt, ips[k]);
@@ -10445,68 +11207,415 @@ int Mesh::FindPoints(DenseMatrix &point_mat, Array<int>& elem_ids,
       {
          elem_ids[k] = e_idx[k];
          pts_found++;
+         continue;
       }
-   }
-   if (pts_found != npts)
-   {
-      Array<int> vertices;
-      Table *vtoel = GetVertexToElementTable();
-      for (int k = 0; k < npts; k++)
+      GetElementVertices(e_idx[k], vertices);
+      for (int v = 0; v < vertices.Size(); v++)
       {
-         if (elem_ids[k] != -1) { continue; }
-         // Try all vertex-neighbors of element e_idx[k]
-         pt.SetData(data+k*spaceDim);
-         GetElementVertices(e_idx[k], vertices);
-         for (int v = 0; v < vertices.Size(); v++)
+         int vv = vertices[v];
+         int ne = vtoel->RowSize(vv);
+         const int* els = vtoel->GetRow(vv);
+         for (int e = 0; e < ne; e++)
          {
-            int vv = vertices[v];
-            int ne = vtoel->RowSize(vv);
-            const int* els = vtoel->GetRow(vv);
-            for (int e = 0; e < ne; e++)
+            if (els[e] == e_idx[k]) { continue; }
+            inv_tr->SetTransformation(*GetElementTransformation(els[e]));
+            res = inv_tr->Transform(pt, ips[k]);
+            if (res == InverseElementTransformation::Inside)
             {
-               if (els[e] == e_idx[k]) { continue; }
-               inv_tr->SetTransformation(*GetElementTransformation(els[e]));
-               int res = inv_tr->Transform(pt, ips[k]);
-               if (res == InverseElementTransformation::Inside)
-               {
-                  elem_ids[k] = els[e];
-                  pts_found++;
-                  goto next_point;
-               }
+               elem_ids[k] = els[e];
+               pts_found++;
+               goto next_point;
+            }
+         }
+      }
+      if (ncmesh)
+      {
+         int le = ncmesh->leaf_elements[e_idx[k]];
+         ncmesh->FindNeighbors(le, neigh);
+         for (int e = 0; e < neigh.Size(); e++)
+         {
+            int nn = neigh[e];
+            if (ncmesh->IsGhost(ncmesh->elements[nn])) { continue; }
+            int el = ncmesh->elements[nn].index;
+            inv_tr->SetTransformation(*GetElementTransformation(el));
+            res = inv_tr->Transform(pt, ips[k]);
+            if (res == InverseElementTransformation::Inside)
+            {
+               elem_ids[k] = el;
+               pts_found++;
+               goto next_point;
             }
          }
-         // Try neighbors for non-conforming meshes
-         if (ncmesh)
+      }
+   next_point: ;
+   }
+   delete vtoel;
+   if (inv_trans == NULL) { delete inv_tr; }
+   return pts_found;
+}
+
+static Element *NewCompactTmpElement(Geometry::Type geom)
+{
+   switch (geom)
+   {
+      case Geometry::POINT:       return new Point;
+      case Geometry::SEGMENT:     return new Segment;
+      case Geometry::TRIANGLE:    return new Triangle;
+      case Geometry::SQUARE:      return new Quadrilateral;
+      case Geometry::TETRAHEDRON: return new Tetrahedron;
+      case Geometry::CUBE:        return new Hexahedron;
+      case Geometry::PRISM:       return new Wedge;
+      default: MFEM_ABORT("invalid Geometry::Type, geom = " << geom);
+   }
+   return NULL;
+}
+
+CompactElementArray::CompactElementArray(const Array<Element *> &elems,
+                                         int n)
+{
+   offsets.SetSize(n+1);
+   attributes.SetSize(n);
+   geoms.SetSize(n);
+   offsets[0] = 0;
+   bool has_flags = false, has_transforms = false;
+   for (int i = 0; i < n; i++)
+   {
+      const Element *el = elems[i];
+      offsets[i+1] = offsets[i] + el->GetNVertices();
+      attributes[i] = el->GetAttribute();
+      geoms[i] = char(el->GetGeometryType());
+      if (el->GetType() == Element::TETRAHEDRON)
+      {
+         has_flags |= (((Tetrahedron*) el)->GetRefinementFlag() != 0);
+      }
+      has_transforms |= (el->GetTransform() != 0);
+   }
+
+   vertices.SetSize(offsets[n]);
+   for (int i = 0; i < n; i++)
+   {
+      const int *v = elems[i]->GetVertices();
+      for (int j = offsets[i]; j < offsets[i+1]; j++)
+      {
+         vertices[j] = v[j - offsets[i]];
+      }
+   }
+   if (has_flags)
+   {
+      flags.SetSize(n);
+      for (int i = 0; i < n; i++)
+      {
+         flags[i] = (elems[i]->GetType() == Element::TETRAHEDRON) ?
+                    ((Tetrahedron*) elems[i])->GetRefinementFlag() : 0;
+      }
+   }
+   if (has_transforms)
+   {
+      transforms.SetSize(n);
+      for (int i = 0; i < n; i++) { transforms[i] = elems[i]->GetTransform(); }
+   }
+   AllocateTmpElements();
+}
+
+CompactElementArray::CompactElementArray(const CompactElementArray &other)
+{
+   other.offsets.Copy(offsets);
+   other.vertices.Copy(vertices);
+   other.attributes.Copy(attributes);
+   other.geoms.Copy(geoms);
+   other.flags.Copy(flags);
+   other.transforms.Copy(transforms);
+   AllocateTmpElements();
+}
+
+void CompactElementArray::AllocateTmpElements()
+{
+   // Allocate all temporaries here, so that the const methods do not modify
+   // the array other than through the data of the returned temporaries
+   for (int g = 0; g < Geometry::NumGeom; g++) { tmp[g] = NULL; }
+   for (int i = 0; i < geoms.Size(); i++)
+   {
+      const int g = geoms[i];
+      if (tmp[g] == NULL) { tmp[g] = NewCompactTmpElement(Geometry::Type(g)); }
+   }
+}
+
+void CompactElementArray::CopyTo(int i, Element &el) const
+{
+   MFEM_ASSERT(el.GetGeometryType() == GetGeometry(i), "invalid geometry");
+   el.SetVertices(GetVertices(i));
+   el.SetAttribute(attributes[i]);
+   if (flags.Size() && el.GetType() == Element::TETRAHEDRON)
+   {
+      static_cast<Tetrahedron&>(el).SetRefinementFlag(flags[i]);
+   }
+   el.ResetTransform(transforms.Size() ? transforms[i] : 0);
+}
+
+const Element *CompactElementArray::GetReferenceElement(
+   Geometry::Type geom) const
+{
+   MFEM_ASSERT(tmp[geom], "geometry not present: " << geom);
+   return tmp[geom];
+}
+
+const Element *CompactElementArray::GetElement(int i) const
+{
+   Element *el = const_cast<Element*>(GetReferenceElement(GetGeometry(i)));
+   CopyTo(i, *el);
+   return el;
+}
+
+long CompactElementArray::MemoryUsage() const
+{
+   return offsets.MemoryUsage() + vertices.MemoryUsage() +
+          attributes.MemoryUsage() + geoms.MemoryUsage() +
+          flags.MemoryUsage() + transforms.MemoryUsage();
+}
+
+CompactElementArray::~CompactElementArray()
+{
+   for (int g = 0; g < Geometry::NumGeom; g++) { delete tmp[g]; }
+}
+
+void Mesh::UseCompactElementStorage(bool compact)
+{
+   if (compact == HasCompactElementStorage()) { return; }
+
+   if (compact)
+   {
+      MFEM_VERIFY(Dim > 0 && !NURBSext && !ncmesh, "the compact storage "
+                  "requires a finalized, conforming, non-NURBS mesh");
+      compact_elements = new CompactElementArray(elements, NumOfElements);
+      compact_boundary = new CompactElementArray(boundary, NumOfBdrElements);
+      for (int i = 0; i < NumOfElements; i++) { FreeElement(elements[i]); }
+      for (int i = 0; i < NumOfBdrElements; i++) { FreeElement(boundary[i]); }
+      elements.DeleteAll();
+      boundary.DeleteAll();
+   }
+   else
+   {
+      elements.SetSize(NumOfElements);
+      for (int i = 0; i < NumOfElements; i++)
+      {
+         elements[i] = NewElement(compact_elements->GetGeometry(i));
+         compact_elements->CopyTo(i, *elements[i]);
+      }
+      boundary.SetSize(NumOfBdrElements);
+      for (int i = 0; i < NumOfBdrElements; i++)
+      {
+         boundary[i] = NewElement(compact_boundary->GetGeometry(i));
+         compact_boundary->CopyTo(i, *boundary[i]);
+      }
+      delete compact_elements;
+      delete compact_boundary;
+      compact_elements = compact_boundary = NULL;
+   }
+}
+
+void Mesh::ExpandCompactElementStorage(const char *caller)
+{
+   MFEM_WARNING("the non-const Mesh::" << caller << "() switches the mesh "
+                "from the compact element storage back to Element objects; "
+                "use a const Mesh for read-only access, or SetAttribute() "
+                "and SetBdrAttribute() to change the attributes");
+   UseCompactElementStorage(false);
+}
+
+void ElementBoundingBoxGrid::Build(Mesh &mesh, double pad)
+{
+   Clear();
+   sdim = mesh.SpaceDimension();
+   const int ne = mesh.GetNE();
+   MFEM_VERIFY(sdim >= 1 && sdim <= 3, "invalid space dimension: " << sdim);
+
+   // Compute the padded element bounding boxes, and the bounding box of the
+   // whole mesh. The nodes of a curved element do not bound it, so such
+   // elements are also mapped on a refined lattice of reference points.
+   bb_min.SetSize(sdim, ne);
+   bb_max.SetSize(sdim, ne);
+   double xmin[3], xmax[3];
+   for (int d = 0; d < sdim; d++)
+   {
+      xmin[d] = std::numeric_limits<double>::infinity();
+      xmax[d] = -xmin[d];
+   }
+   IsoparametricTransformation T;
+   DenseMatrix pos;
+   for (int e = 0; e < ne; e++)
+   {
+      mesh.GetElementTransformation(e, &T);
+      const DenseMatrix &pm = T.GetPointMat();
+      const int order = T.GetFE()->GetOrder();
+      if (order > 1)
+      {
+         const Geometry::Type geom = mesh.GetElementBaseGeometry(e);
+         T.Transform(GlobGeometryRefiner.Refine(geom, 2*order)->RefPts, pos);
+      }
+      else
+      {
+         pos.SetSize(sdim, 0);
+      }
+      double ext = 0.0;
+      for (int d = 0; d < sdim; d++)
+      {
+         double lo = pm(d,0), hi = pm(d,0);
+         for (int j = 1; j < pm.Width(); j++)
+         {
+            lo = std::min(lo, pm(d,j));
+            hi = std::max(hi, pm(d,j));
+         }
+         for (int j = 0; j < pos.Width(); j++)
+         {
+            lo = std::min(lo, pos(d,j));
+            hi = std::max(hi, pos(d,j));
+         }
+         bb_min(d,e) = lo;
+         bb_max(d,e) = hi;
+         ext = std::max(ext, hi - lo);
+      }
+      for (int d = 0; d < sdim; d++)
+      {
+         bb_min(d,e) -= pad*ext;
+         bb_max(d,e) += pad*ext;
+         xmin[d] = std::min(xmin[d], bb_min(d,e));
+         xmax[d] = std::max(xmax[d], bb_max(d,e));
+      }
+   }
+
+   // Choose cells of roughly equal size in all directions such that the number
+   // of cells is about the number of elements
+   double vol = 1.0;
+   int nd = 0;
+   for (int d = 0; d < sdim; d++)
+   {
+      if (ne > 0 && xmax[d] > xmin[d]) { vol *= xmax[d] - xmin[d]; nd++; }
+   }
+   const double hc = nd ? std::pow(vol/ne, 1.0/nd) : 1.0;
+   for (int d = 0; d < 3; d++)
+   {
+      n[d] = 1;
+      x0[d] = 0.0;
+      h[d] = 1.0;
+      if (d >= sdim || ne == 0) { continue; }
+      x0[d] = xmin[d];
+      if (xmax[d] > xmin[d])
+      {
+         n[d] = std::max(1, std::min(ne, (int)std::ceil((xmax[d]-xmin[d])/hc)));
+         h[d] = (xmax[d] - xmin[d])/n[d];
+      }
+   }
+
+   // Assign the elements to all cells intersecting their bounding boxes
+   const int ncells = n[0]*n[1]*n[2];
+   for (int pass = 0; pass < 2; pass++)
+   {
+      if (pass == 0) { cell_elem.MakeI(ncells); }
+      else { cell_elem.MakeJ(); }
+      for (int e = 0; e < ne; e++)
+      {
+         int lo[3] = {0, 0, 0}, hi[3] = {0, 0, 0};
+         for (int d = 0; d < sdim; d++)
+         {
+            lo[d] = std::max(0, CellIndex(d, bb_min(d,e)));
+            hi[d] = CellIndex(d, bb_max(d,e));
+            if (hi[d] < 0) { hi[d] = n[d]-1; }
+         }
+         for (int k = lo[2]; k <= hi[2]; k++)
          {
-            Array<int> neigh;
-            int le = ncmesh->leaf_elements[e_idx[k]];
-            ncmesh->FindNeighbors(le,neigh);
-            for (int e = 0; e < neigh.Size(); e++)
+            for (int j = lo[1]; j <= hi[1]; j++)
             {
-               int nn = neigh[e];
-               if (ncmesh->IsGhost(ncmesh->elements[nn])) { continue; }
-               int el = ncmesh->elements[nn].index;
-               inv_tr->SetTransformation(*GetElementTransformation(el));
-               int res = inv_tr->Transform(pt, ips[k]);
-               if (res == InverseElementTransformation::Inside)
+               for (int i = lo[0]; i <= hi[0]; i++)
                {
-                  elem_ids[k] = el;
-                  pts_found++;
-                  goto next_point;
+                  const int c = i + n[0]*(j + n[1]*k);
+                  if (pass == 0) { cell_elem.AddAColumnInRow(c); }
+                  else { cell_elem.AddConnection(c, e); }
                }
             }
          }
-      next_point: ;
       }
-      delete vtoel;
    }
-   if (inv_trans == NULL) { delete inv_tr; }
+   cell_elem.ShiftUpI();
 
-   if (warn && pts_found != npts)
+   sequence = mesh.GetSequence();
+}
+
+void ElementBoundingBoxGrid::Clear()
+{
+   sequence = -1;
+   bb_min.Clear();
+   bb_max.Clear();
+   cell_elem.Clear();
+}
+
+int ElementBoundingBoxGrid::CellIndex(int d, double x) const
+{
+   const double t = (x - x0[d])/h[d];
+   if (!(t >= 0.0) || t > n[d]) { return -1; }
+   return std::min((int)t, n[d]-1);
+}
+
+void ElementBoundingBoxGrid::FindCandidates(const double *x,
+                                            Array<int> &elems) const
+{
+   MFEM_ASSERT(IsBuilt(), "the grid is not built");
+   elems.SetSize(0);
+   int c = 0;
+   for (int d = sdim-1; d >= 0; d--)
    {
-      MFEM_WARNING((npts-pts_found) << " points were not found");
+      const int i = CellIndex(d, x[d]);
+      if (i < 0) { return; }
+      c = c*n[d] + i;
+   }
+   const int *row = cell_elem.GetRow(c);
+   for (int k = 0; k < cell_elem.RowSize(c); k++)
+   {
+      const int e = row[k];
+      bool inside = true;
+      for (int d = 0; d < sdim && inside; d++)
+      {
+         inside = (bb_min(d,e) <= x[d] && x[d] <= bb_max(d,e));
+      }
+      if (inside) { elems.Append(e); }
    }
-   return pts_found;
+}
+
+bool ElementBoundingBoxGrid::Contains(const double *x) const
+{
+   MFEM_ASSERT(IsBuilt(), "the grid is not built");
+   for (int d = 0; d < sdim; d++)
+   {
+      if (CellIndex(d, x[d]) < 0) { return false; }
+   }
+   return true;
+}
+
+void ElementBoundingBoxGrid::FindNearbyElements(const double *x,
+                                                Array<int> &elems) const
+{
+   MFEM_ASSERT(IsBuilt(), "the grid is not built");
+   elems.SetSize(0);
+   int lo[3] = {0, 0, 0}, hi[3] = {0, 0, 0};
+   for (int d = 0; d < sdim; d++)
+   {
+      const int i = CellIndex(d, x[d]);
+      if (i < 0) { return; }
+      lo[d] = std::max(0, i-1);
+      hi[d] = std::min(n[d]-1, i+1);
+   }
+   for (int k = lo[2]; k <= hi[2]; k++)
+   {
+      for (int j = lo[1]; j <= hi[1]; j++)
+      {
+         for (int i = lo[0]; i <= hi[0]; i++)
+         {
+            const int c = i + n[0]*(j + n[1]*k);
+            elems.Append(cell_elem.GetRow(c), cell_elem.RowSize(c));
+         }
+      }
+   }
+   elems.Sort();
+   elems.Unique();
 }
 
 
@@ -10612,6 +11721,62 @@ FaceGeometricFactors::FaceGeometricFactors(const Mesh *mesh,
    qi->Mult(Fnodes, eval_flags, X, J, detJ, normal);
 }
 
+BatchedGeometricFactors::BatchedGeometricFactors(Mesh *mesh,
+                                                 const IntegrationRule &ir,
+                                                 int batch)
+   : IntRule(&ir)
+{
+   MFEM_VERIFY(batch > 0, "invalid batch size: " << batch);
+   mesh->EnsureNodes();
+   const GridFunction *nodes = mesh->GetNodes();
+   const FiniteElementSpace *fespace = nodes->FESpace();
+   ne = fespace->GetNE();
+   dim = mesh->Dimension();
+   sdim = fespace->GetVDim();
+   batch_size = std::max(1, std::min(batch, ne));
+   if (ne == 0) { maps = NULL; nd = nq = 0; return; }
+   const FiniteElement *fe = fespace->GetFE(0);
+   maps = &fe->GetDofToQuad(ir, DofToQuad::FULL);
+   nd = maps->ndof;
+   nq = maps->nqpt;
+
+   const Operator *elem_restr = fespace->GetElementRestriction(
+                                   ElementDofOrdering::NATIVE);
+   Enodes.SetSize(nd*sdim*ne, Device::GetDeviceMemoryType());
+   elem_restr->Mult(*nodes, Enodes);
+}
+
+void BatchedGeometricFactors::ComputeJacobians(int e0, int nb, Vector &j) const
+{
+   MFEM_ASSERT(e0 >= 0 && nb >= 0 && e0 + nb <= ne, "invalid batch");
+   const int DIM = dim;
+   const int SDIM = sdim;
+   const int ND = nd;
+   const int NQ = nq;
+   j.SetSize(NQ*SDIM*DIM*nb, Device::GetDeviceMemoryType());
+   if (nb == 0) { return; }
+   auto G = Reshape(maps->G.Read(), NQ, DIM, ND);
+   auto E = Reshape(Enodes.Read() + e0*ND*SDIM, ND, SDIM, nb);
+   auto J = Reshape(j.Write(), NQ, SDIM, DIM, nb);
+   MFEM_FORALL(i, NQ*nb,
+   {
+      const int q = i % NQ;
+      const int e = i / NQ;
+      for (int c = 0; c < SDIM; c++)
+      {
+         for (int d = 0; d < DIM; d++)
+         {
+            double s = 0.0;
+            for (int n = 0; n < ND; n++)
+            {
+               s += G(q,d,n) * E(n,c,e);
+            }
+            J(q,c,d,e) = s;
+         }
+      }
+   });
+}
+
 NodeExtrudeCoefficient::NodeExtrudeCoefficient(const int dim, const int _n,
                                                const double _s)
    : VectorCoefficient(dim), n(_n), s(_s), tip(p, dim-1)
@@ -10672,9 +11837,8 @@ Mesh *Extrude1D(Mesh *mesh, const int ny, const double sy, const bool closed)
    Array<int> vert;
    for (int i = 0; i < mesh->GetNE(); i++)
    {
-      const Element *elem = mesh->GetElement(i);
-      elem->GetVertices(vert);
-      const int attr = elem->GetAttribute();
+      mesh->GetElementVertices(i, vert);
+      const int attr = mesh->GetAttribute(i);
       for (int j = 0; j < ny; j++)
       {
          int qv[4];
@@ -10689,9 +11853,8 @@ Mesh *Extrude1D(Mesh *mesh, const int ny, const double sy, const bool closed)
    // 2D boundary from the 1D boundary
    for (int i = 0; i < mesh->GetNBE(); i++)
    {
-      const Element *elem = mesh->GetBdrElement(i);
-      elem->GetVertices(vert);
-      const int attr = elem->GetAttribute();
+      mesh->GetBdrElementVertices(i, vert);
+      const int attr = mesh->GetBdrAttribute(i);
       for (int j = 0; j < ny; j++)
       {
          int sv[2];
@@ -10714,9 +11877,8 @@ Mesh *Extrude1D(Mesh *mesh, const int ny, const double sy, const bool closed)
                  mesh->bdr_attributes.Max() : 0);
       for (int i = 0; i < mesh->GetNE(); i++)
       {
-         const Element *elem = mesh->GetElement(i);
-         elem->GetVertices(vert);
-         const int attr = nba + elem->GetAttribute();
+         mesh->GetElementVertices(i, vert);
+         const int attr = nba + mesh->GetAttribute(i);
          int sv[2];
          sv[0] = vert[0] * nvy;
          sv[1] = vert[1] * nvy;
@@ -10829,10 +11991,9 @@ Mesh *Extrude2D(Mesh *mesh, const int nz, const double sz)
    Array<int> vert;
    for (int i = 0; i < mesh->GetNE(); i++)
    {
-      const Element *elem = mesh->GetElement(i);
-      elem->GetVertices(vert);
-      const int attr = elem->GetAttribute();
-      Geometry::Type geom = elem->GetGeometryType();
+      mesh->GetElementVertices(i, vert);
+      const int attr = mesh->GetAttribute(i);
+      Geometry::Type geom = mesh->GetElementBaseGeometry(i);
       switch (geom)
       {
          case Geometry::TRIANGLE:
@@ -10877,9 +12038,8 @@ Mesh *Extrude2D(Mesh *mesh, const int nz, const double sz)
    // 3D boundary from the 2D boundary
    for (int i = 0; i < mesh->GetNBE(); i++)
    {
-      const Element *elem = mesh->GetBdrElement(i);
-      elem->GetVertices(vert);
-      const int attr = elem->GetAttribute();
+      mesh->GetBdrElementVertices(i, vert);
+      const int attr = mesh->GetBdrAttribute(i);
       for (int j = 0; j < nz; j++)
       {
          int qv[4];
@@ -10897,10 +12057,9 @@ Mesh *Extrude2D(Mesh *mesh, const int nz, const double sz)
               mesh->bdr_attributes.Max() : 0);
    for (int i = 0; i < mesh->GetNE(); i++)
    {
-      const Element *elem = mesh->GetElement(i);
-      elem->GetVertices(vert);
-      const int attr = nba + elem->GetAttribute();
-      Geometry::Type geom = elem->GetGeometryType();
+      mesh->GetElementVertices(i, vert);
+      const int attr = nba + mesh->GetAttribute(i);
+      Geometry::Type geom = mesh->GetElementBaseGeometry(i);
       switch (geom)
       {
          case Geometry::TRIANGLE:
@@ -11055,7 +12214,7 @@ void Mesh::DebugDump(std::ostream &out) const
    out << NumOfElements << "\n";
    for (int i = 0; i < NumOfElements; i++)
    {
-      const Element* e = elements[i];
+      const Element* e = GetElement(i);
       out << e->GetNVertices() << " ";
       for (int j = 0; j < e->GetNVertices(); j++)
       {
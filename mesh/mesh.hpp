@@ -49,6 +49,129 @@ class ParMesh;
 class ParNCMesh;
 #endif
 
+class Mesh;
+
+/** @brief Uniform grid over the (padded) bounding boxes of the elements of a
+    Mesh, used to accelerate the point location in Mesh::FindPoints(). */
+/** Each cell of the grid stores the elements whose bounding boxes intersect
+    the cell, so that the candidate elements for a point are obtained in
+    constant time, on average. The bounding boxes are computed from the vertices
+    or the nodes of the elements and, for curved elements, from the element
+    transformation sampled on a refined lattice. They are enlarged by a fraction
+    of their size to account for the curvature between the samples. Typically
+    objects of this type are constructed and owned by objects of class Mesh, see
+    Mesh::GetElementBoundingBoxGrid(). */
+class ElementBoundingBoxGrid
+{
+protected:
+   long sequence; ///< Mesh::GetSequence() at the time of the construction.
+   int sdim;      ///< Space dimension.
+   int n[3];      ///< Number of cells in each direction.
+   double x0[3];  ///< Lower corner of the grid.
+   double h[3];   ///< Size of the cells in each direction.
+   DenseMatrix bb_min, bb_max; ///< Element bounding boxes, sdim x NE.
+   Table cell_elem; ///< Elements intersecting each cell.
+
+   /// Return the index of the cell containing x in direction d, or -1.
+   int CellIndex(int d, double x) const;
+
+public:
+   /// Construct an empty grid, see Build().
+   ElementBoundingBoxGrid() : sequence(-1), sdim(0) { }
+
+   /** @brief Build the grid for the given @a mesh. The element bounding boxes
+       are enlarged by the fraction @a pad of their largest extent. */
+   void Build(Mesh &mesh, double pad = 0.1);
+
+   /// Free the grid data. The grid needs to be rebuilt before use.
+   void Clear();
+
+   /// Return true if the grid was built.
+   bool IsBuilt() const { return sequence >= 0; }
+
+   /// Return the Mesh sequence number for which the grid was built.
+   long GetSequence() const { return sequence; }
+
+   /** @brief Return in @a elems, in increasing order, the elements whose
+       bounding boxes contain the point @a x (of size sdim). */
+   void FindCandidates(const double *x, Array<int> &elems) const;
+
+   /// Return true if the point @a x is inside the bounding box of the grid.
+   bool Contains(const double *x) const;
+
+   /** @brief Return in @a elems, in increasing order, the elements assigned to
+       the cell containing the point @a x and to its neighboring cells. */
+   void FindNearbyElements(const double *x, Array<int> &elems) const;
+};
+
+/** @brief Flat (structure-of-arrays) storage of the elements or the boundary
+    elements of a Mesh, see Mesh::UseCompactElementStorage(). */
+/** The vertices of element i are vertices[offsets[i]], ...,
+    vertices[offsets[i+1]-1], in the order used by the Element classes. Each
+    element takes its vertex indices, an attribute, an offset and a byte for the
+    geometry, instead of a pointer to a separately allocated, polymorphic
+    Element object. The refinement flags of the tetrahedra and the coarse-fine
+    transformations (see Element::GetTransform()) are stored only if some of
+    them are nonzero. */
+class CompactElementArray
+{
+protected:
+   Array<int> offsets, vertices, attributes;
+   Array<char> geoms;
+   Array<int> flags;            ///< Tetrahedron refinement flags, or empty.
+   Array<unsigned> transforms;  ///< Coarse-fine transformations, or empty.
+
+   /** Temporary elements returned by GetElement(), one per geometry present
+       in the array, allocated by the constructors. */
+   mutable Element *tmp[Geometry::NumGeom];
+
+   void AllocateTmpElements();
+
+public:
+   /// Copy the first @a n elements of @a elems.
+   CompactElementArray(const Array<Element *> &elems, int n);
+
+   CompactElementArray(const CompactElementArray &other);
+
+   int Size() const { return attributes.Size(); }
+
+   Geometry::Type GetGeometry(int i) const { return Geometry::Type(geoms[i]); }
+
+   int GetAttribute(int i) const { return attributes[i]; }
+
+   void SetAttribute(int i, int attr) { attributes[i] = attr; }
+
+   int GetNVertices(int i) const { return offsets[i+1] - offsets[i]; }
+
+   const int *GetVertices(int i) const
+   { return vertices.GetData() + offsets[i]; }
+
+   int *GetVertices(int i) { return vertices.GetData() + offsets[i]; }
+
+   void GetVertices(int i, Array<int> &v) const
+   {
+      v.SetSize(GetNVertices(i));
+      v.Assign(GetVertices(i));
+   }
+
+   /// Copy the data of element @a i to @a el which has the same geometry.
+   void CopyTo(int i, Element &el) const;
+
+   /** @brief Return a temporary Element with the data of element @a i, valid
+       until the next call for an element of the same geometry. */
+   const Element *GetElement(int i) const;
+
+   /** @brief Return an Element of the given geometry, present in the array,
+       for its local edge and face tables. Its vertices and attribute are
+       unspecified. */
+   const Element *GetReferenceElement(Geometry::Type geom) const;
+
+   /// Return the number of bytes used by the arrays.
+   long MemoryUsage() const;
+
+   ~CompactElementArray();
+};
+
 class Mesh
 {
 #ifdef MFEM_USE_MPI
@@ -205,6 +328,12 @@ public:
    Array<GeometricFactors*> geom_factors; ///< Optional geometric factors.
    Array<FaceGeometricFactors*>
    face_geom_factors; ///< Optional face geometric factors.
+   /// Optional grid of element bounding boxes, see FindPoints().
+   ElementBoundingBoxGrid elem_bb_grid;
+   /** @brief Compact storage of the elements and the boundary elements, used
+       instead of #elements and #boundary if not NULL, see
+       UseCompactElementStorage(). */
+   CompactElementArray *compact_elements, *compact_boundary;
 
    // Global parameter that can be used to control the removal of unused
    // vertices performed when reading a mesh in MFEM format. The default value
@@ -232,6 +361,7 @@ protected:
    // Readers for different mesh formats, used in the Load() method.
    // The implementations of these methods are in mesh_readers.cpp.
    void ReadMFEMMesh(std::istream &input, bool mfem_v11, int &curved);
+   void ReadMFEMBinaryMesh(std::istream &input, int &curved);
    void ReadLineMesh(std::istream &input);
    void ReadNetgen2DMesh(std::istream &input, int &curved);
    void ReadNetgen3DMesh(std::istream &input);
@@ -273,6 +403,16 @@ protected:
    STable3D *GetFacesTable();
    STable3D *GetElementToFaceTable(int ret_ftbl = 0);
 
+   // Native partitioners used by GeneratePartitioning(), which do not require
+   // METIS, see mesh_partitioning.cpp. The number of elements must be at
+   // least 'nparts'.
+   void PartitionRCB(int nparts, int *partitioning);
+   void PartitionSFC(int nparts, bool hilbert, int *partitioning);
+   void PartitionGraph(int nparts, int *partitioning);
+
+   /// Interleave the lowest 21 bits of @a x, @a y and @a z (Morton order).
+   static unsigned long long MortonKey(unsigned x, unsigned y, unsigned z);
+
    /** Red refinement. Element with index i is refined. The default
        red refinement for now is Uniform. */
    void RedRefinement(int i, const DSTable &v_to_v,
@@ -309,8 +449,22 @@ protected:
 
    void UniformRefinement2D_base(bool update_nodes = true);
 
-   /// Refine a mixed 2D mesh uniformly.
-   virtual void UniformRefinement2D() { UniformRefinement2D_base(); }
+   /** @brief Refine an all-quadrilateral 2D or an all-hexahedral 3D mesh
+       uniformly, producing the same elements as UniformRefinement2D_base()
+       and UniformRefinement3D_base(). */
+   /** The new vertices, elements and the refined edge, face and boundary
+       tables are computed independently for each coarse entity, in parallel
+       when OpenMP is enabled, from the numbering of the coarse edges and
+       faces. Unlike the general algorithm, no hash tables (DSTable, STable3D)
+       are used; the new edges and faces are then renumbered in the order the
+       hash tables would give them, so the refined mesh and its GridFunctions
+       can be printed and loaded again. ParMesh keeps the general algorithm
+       since its shared edges and faces are located with these hash tables. */
+   void TensorUniformRefinement(bool update_nodes = true);
+
+   /** @brief Refine a mixed 2D mesh uniformly. All-quadrilateral meshes use
+       TensorUniformRefinement(). */
+   virtual void UniformRefinement2D();
 
    /* If @a f2qf is not NULL, adds all quadrilateral faces to @a f2qf which
       represents a "face-to-quad-face" index map. When all faces are quads, the
@@ -319,8 +473,9 @@ protected:
                                  DSTable *v_to_v_p = NULL,
                                  bool update_nodes = true);
 
-   /// Refine a mixed 3D mesh uniformly.
-   virtual void UniformRefinement3D() { UniformRefinement3D_base(); }
+   /** @brief Refine a mixed 3D mesh uniformly. All-hexahedral meshes use
+       TensorUniformRefinement(). */
+   virtual void UniformRefinement3D();
 
    /// Refine NURBS mesh.
    virtual void NURBSUniformRefinement();
@@ -383,6 +538,59 @@ protected:
    static void GetElementArrayEdgeTable(const Array<Element*> &elem_array,
                                         const DSTable &v_to_v,
                                         Table &el_to_edge);
+   static void GetElementArrayEdgeTable(const CompactElementArray &elems,
+                                        const DSTable &v_to_v,
+                                        Table &el_to_edge);
+
+   /** Locate the points with elem_ids[k] == -1 in the element whose center is
+       closest, among the elements of the nearby cells of the grid, or in its
+       neighbors, see FindPoints(). Returns the number of points found. */
+   int FindPointsNearClosestElement(DenseMatrix &point_mat,
+                                    Array<int> &elem_ids,
+                                    Array<IntegrationPoint> &ips,
+                                    InverseElementTransformation *inv_trans);
+
+   /// Return the vertices of element @a i, in both element storages.
+   const int *ElementVertices(int i) const
+   {
+      return compact_elements ? compact_elements->GetVertices(i)
+             : elements[i]->GetVertices();
+   }
+
+   /// Return the vertices of element @a i for modification, see above.
+   int *ElementVertices(int i)
+   {
+      return compact_elements ? compact_elements->GetVertices(i)
+             : elements[i]->GetVertices();
+   }
+
+   /// Return the vertices of boundary element @a i, in both element storages.
+   const int *BdrElementVertices(int i) const
+   {
+      return compact_boundary ? compact_boundary->GetVertices(i)
+             : boundary[i]->GetVertices();
+   }
+
+   /// Return the vertices of boundary element @a i for modification.
+   int *BdrElementVertices(int i)
+   {
+      return compact_boundary ? compact_boundary->GetVertices(i)
+             : boundary[i]->GetVertices();
+   }
+
+   /** @brief Switch back from the compact element storage, if used, on the
+       request of the non-const accessor @a caller, with a warning. */
+   void ExpandCompactElementStorage(const char *caller);
+
+   /** @brief Return an Element with the local edge and face tables of element
+       @a i: the element itself or, with the compact storage, an element of the
+       same geometry whose vertices are unspecified. */
+   const Element *ReferenceElement(int i) const
+   {
+      return compact_elements ?
+             compact_elements->GetReferenceElement(GetElementBaseGeometry(i)) :
+             elements[i];
+   }
 
    /** Return vertex to vertex table. The connections stored in the table
        are from smaller to bigger vertex index, i.e. if i<j and (i, j) is
@@ -434,6 +642,11 @@ protected:
    void Printer(std::ostream &out = mfem::out,
                 std::string section_delimiter = "") const;
 
+   // Write the binary MFEM mesh format, followed by the given
+   // section_delimiter, or by "mfem_mesh_end" if it is empty.
+   void BinaryPrinter(std::ostream &out,
+                      std::string section_delimiter = "") const;
+
    /** Creates mesh for the parallelepiped [0,sx]x[0,sy]x[0,sz], divided into
        nx*ny*nz hexahedra if type=HEXAHEDRON or into 6*nx*ny*nz tetrahedrons if
        type=TETRAHEDRON. The parameter @a sfc_ordering controls how the elements
@@ -467,6 +680,8 @@ protected:
    // used in GetElementData() and GetBdrElementData()
    void GetElementData(const Array<Element*> &elem_array, int geom,
                        Array<int> &elem_vtx, Array<int> &attr) const;
+   void GetElementData(const CompactElementArray &elems, int geom,
+                       Array<int> &elem_vtx, Array<int> &attr) const;
 
 public:
 
@@ -583,6 +798,29 @@ public:
 
    virtual void SetAttributes();
 
+   /** @brief Switch the storage of the elements and the boundary elements
+       between Element objects (the default) and flat arrays. */
+   /** The compact storage (see CompactElementArray) saves the pointer,
+       virtual table and heap allocation overhead of the Element objects, and
+       the construction of the connectivity tables reads it directly. It is
+       meant for large conforming meshes that are not refined further. The
+       mesh must be finalized, and NURBS and non-conforming meshes are not
+       supported. The faces are still stored as Element objects.
+
+       With the compact storage, the const GetElement() and GetBdrElement()
+       return temporary copies, valid until the next call for an element of the
+       same geometry, while the non-const versions switch back to Element
+       objects, with a warning, so that changes made through them are stored.
+       Read-only code should therefore use a const Mesh, and the attributes can
+       be changed in place with SetAttribute() and SetBdrAttribute(). The
+       orientation checks also work in place. Refinement, reordering and the
+       conversion to a non-conforming mesh switch back to Element objects
+       first. */
+   void UseCompactElementStorage(bool compact = true);
+
+   /// Return true if the elements use the compact storage.
+   bool HasCompactElementStorage() const { return compact_elements != NULL; }
+
    /** This is our integration with the Gecko library. The method finds an
        element ordering that will increase memory coherency by putting elements
        that are in physical proximity closer in memory. It can also be used to
@@ -750,11 +988,20 @@ public:
                                                        const int flags,
                                                        FaceType type);
 
-   /// Destroy all GeometricFactors stored by the Mesh.
-   /** This method can be used to force recomputation of the GeometricFactors,
-       for example, after the mesh nodes are modified externally. */
+   /** @brief Destroy all GeometricFactors and the ElementBoundingBoxGrid
+       stored by the Mesh. */
+   /** This method can be used to force recomputation of the GeometricFactors
+       and the ElementBoundingBoxGrid, for example, after the mesh nodes are
+       modified externally. */
    void DeleteGeometricFactors();
 
+   /** @brief Return the grid of element bounding boxes used for point
+       location, building it if needed. */
+   /** The grid is rebuilt when the Mesh sequence changes (e.g. after
+       refinement) and when the vertices or nodes are modified through the
+       Mesh interface. */
+   const ElementBoundingBoxGrid &GetElementBoundingBoxGrid();
+
    /// Equals 1 + num_holes - num_loops
    inline int EulerNumber() const
    { return NumOfVertices - NumOfEdges + NumOfFaces - NumOfElements; }
@@ -776,11 +1023,19 @@ public:
    double *GetVertex(int i) { return vertices[i](); }
 
    void GetElementData(int geom, Array<int> &elem_vtx, Array<int> &attr) const
-   { GetElementData(elements, geom, elem_vtx, attr); }
+   {
+      if (compact_elements)
+      { GetElementData(*compact_elements, geom, elem_vtx, attr); }
+      else { GetElementData(elements, geom, elem_vtx, attr); }
+   }
 
    void GetBdrElementData(int geom, Array<int> &bdr_elem_vtx,
                           Array<int> &bdr_attr) const
-   { GetElementData(boundary, geom, bdr_elem_vtx, bdr_attr); }
+   {
+      if (compact_boundary)
+      { GetElementData(*compact_boundary, geom, bdr_elem_vtx, bdr_attr); }
+      else { GetElementData(boundary, geom, bdr_elem_vtx, bdr_attr); }
+   }
 
    /** @brief Set the internal Vertex array to point to the given @a vertices
        array without assuming ownership of the pointer. */
@@ -791,15 +1046,36 @@ public:
                                   bool zerocopy = false);
 
    const Element* const *GetElementsArray() const
-   { return elements.GetData(); }
+   {
+      MFEM_VERIFY(!compact_elements, "not available with the compact storage");
+      return elements.GetData();
+   }
 
-   const Element *GetElement(int i) const { return elements[i]; }
+   /** @brief Return element @a i. With the compact element storage, this is a
+       temporary copy, valid until the next call for an element of the same
+       geometry, see UseCompactElementStorage(). */
+   const Element *GetElement(int i) const
+   { return compact_elements ? compact_elements->GetElement(i) : elements[i]; }
 
-   Element *GetElement(int i) { return elements[i]; }
+   /** @brief Return element @a i for modification. The compact element
+       storage, if used, is first converted back to Element objects, with a
+       warning, see UseCompactElementStorage(). */
+   Element *GetElement(int i)
+   {
+      if (compact_elements) { ExpandCompactElementStorage("GetElement"); }
+      return elements[i];
+   }
 
-   const Element *GetBdrElement(int i) const { return boundary[i]; }
+   /// Return boundary element @a i, see GetElement().
+   const Element *GetBdrElement(int i) const
+   { return compact_boundary ? compact_boundary->GetElement(i) : boundary[i]; }
 
-   Element *GetBdrElement(int i) { return boundary[i]; }
+   /// Return boundary element @a i for modification, see GetElement().
+   Element *GetBdrElement(int i)
+   {
+      if (compact_boundary) { ExpandCompactElementStorage("GetBdrElement"); }
+      return boundary[i];
+   }
 
    const Element *GetFace(int i) const { return faces[i]; }
 
@@ -810,12 +1086,14 @@ public:
 
    Geometry::Type GetElementBaseGeometry(int i) const
    {
-      return elements[i]->GetGeometryType();
+      return compact_elements ? compact_elements->GetGeometry(i)
+             : elements[i]->GetGeometryType();
    }
 
    Geometry::Type GetBdrElementBaseGeometry(int i) const
    {
-      return boundary[i]->GetGeometryType();
+      return compact_boundary ? compact_boundary->GetGeometry(i)
+             : boundary[i]->GetGeometryType();
    }
 
    /** @brief Return true iff the given @a geom is encountered in the mesh.
@@ -853,11 +1131,17 @@ public:
 
    /// Returns the indices of the vertices of element i.
    void GetElementVertices(int i, Array<int> &v) const
-   { elements[i]->GetVertices(v); }
+   {
+      if (compact_elements) { compact_elements->GetVertices(i, v); }
+      else { elements[i]->GetVertices(v); }
+   }
 
    /// Returns the indices of the vertices of boundary element i.
    void GetBdrElementVertices(int i, Array<int> &v) const
-   { boundary[i]->GetVertices(v); }
+   {
+      if (compact_boundary) { compact_boundary->GetVertices(i, v); }
+      else { boundary[i]->GetVertices(v); }
+   }
 
    /// Return the indices and the orientations of all edges of element i.
    void GetElementEdges(int i, Array<int> &edges, Array<int> &cor) const;
@@ -1021,13 +1305,32 @@ public:
    int CheckBdrElementOrientation(bool fix_it = true);
 
    /// Return the attribute of element i.
-   int GetAttribute(int i) const { return elements[i]->GetAttribute(); }
+   int GetAttribute(int i) const
+   {
+      return compact_elements ? compact_elements->GetAttribute(i)
+             : elements[i]->GetAttribute();
+   }
 
    /// Set the attribute of element i.
-   void SetAttribute(int i, int attr) { elements[i]->SetAttribute(attr); }
+   void SetAttribute(int i, int attr)
+   {
+      if (compact_elements) { compact_elements->SetAttribute(i, attr); }
+      else { elements[i]->SetAttribute(attr); }
+   }
 
    /// Return the attribute of boundary element i.
-   int GetBdrAttribute(int i) const { return boundary[i]->GetAttribute(); }
+   int GetBdrAttribute(int i) const
+   {
+      return compact_boundary ? compact_boundary->GetAttribute(i)
+             : boundary[i]->GetAttribute();
+   }
+
+   /// Set the attribute of boundary element i.
+   void SetBdrAttribute(int i, int attr)
+   {
+      if (compact_boundary) { compact_boundary->SetAttribute(i, attr); }
+      else { boundary[i]->SetAttribute(attr); }
+   }
 
    const Table &ElementToElementTable();
 
@@ -1054,9 +1357,40 @@ public:
    virtual void ReorientTetMesh();
 
    int *CartesianPartitioning(int nxyz[]);
+
+   /** @brief Partition the elements of the mesh in @a nparts parts. Returns a
+       new array (to be deleted by the caller) with the part of each element.
+
+       The partitioning method @a part_method can be:
+       - 0, 1, 2: METIS_PartGraphRecursive, METIS_PartGraphKway or
+         METIS_PartGraphVKway (minimizing the communication volume) on the
+         element-to-element (dual) graph, with sorted neighbor lists;
+       - 3, 4, 5: same as 0, 1, 2, with unsorted neighbor lists;
+       - 6: recursive coordinate bisection of the element centers;
+       - 7: Hilbert space-filling curve through the element centers, see
+         GetHilbertElementOrdering(); for non-conforming meshes, the element
+         order of the NCMesh (already a space-filling curve) is used;
+       - 8: Morton (Z-order) space-filling curve through the element centers;
+       - 9: native multilevel k-way partitioning of the dual graph (heavy edge
+         matching coarsening, recursive graph growing bisection and greedy
+         k-way refinement).
+
+       Methods 6-9 do not require METIS. If MFEM is built without METIS, the
+       methods 0-5 are replaced by method 9. See also GetPartitioningStats(). */
    int *GeneratePartitioning(int nparts, int part_method = 1);
    void CheckPartitioning(int *partitioning);
 
+   /** @brief Compute the edge-cut of @a partitioning, i.e. the number of pairs
+       of face-neighbor elements in different parts, and its imbalance, i.e.
+       the ratio of the largest part size to the average part size. */
+   void GetPartitioningStats(const int *partitioning, int nparts,
+                             int &edgecut, double &imbalance);
+
+   /** @brief Print the minimum and maximum part sizes, the edge-cut and the
+       imbalance of @a partitioning, see GetPartitioningStats(). */
+   void PrintPartitioningStats(const int *partitioning, int nparts,
+                               std::ostream &out = mfem::out);
+
    void CheckDisplacements(const Vector &displacements, double &tmax);
 
    // Vertices are only at the corners of elements, where you would expect them
@@ -1210,6 +1544,17 @@ public:
    /// \see mfem::ofgzstream() for on-the-fly compression of ascii outputs
    virtual void Print(std::ostream &out = mfem::out) const { Printer(out); }
 
+   /** @brief Print the mesh to the given stream using the binary MFEM mesh
+       format, "MFEM binary mesh v1.0". */
+   /** The format has a text header line followed by the sizes and by
+       contiguous arrays of the element and boundary attributes, geometries and
+       vertices, and of the vertex coordinates or the Nodes (see
+       GridFunction::SaveBinary()), in the native byte order. It is read by the
+       Mesh constructors and Load() methods without parsing the data, e.g.
+       from a mfem::mapped_ifstream. NURBS and nonconforming meshes are not
+       supported. For a compressed output, use mfem::ofgzstream. */
+   void PrintBinary(std::ostream &out) const { BinaryPrinter(out); }
+
    /// Print the mesh to the given stream using the adios2 bp format
 #ifdef MFEM_USE_ADIOS2
    virtual void Print(adios2stream &out) const;
@@ -1324,6 +1669,14 @@ public:
        completely overwritten by deriving custom classes that override the
        Transform() method.
 
+       The candidate elements for each point are the elements whose bounding
+       boxes contain it, see GetElementBoundingBoxGrid(). When MFEM is built
+       with MFEM_USE_OPENMP and MFEM_THREAD_SAFE and @a inv_trans is NULL, the
+       points are processed in parallel. The points inside the bounding box of
+       the grid that are not found in these elements are then searched for in
+       the element whose center is closest, among the elements of the nearby
+       grid cells, and in its neighbors.
+
        If no element is found for the i-th point, elem_ids[i] is set to -1.
 
        In the ParMesh implementation, the @a point_mat is expected to be the
@@ -1452,6 +1805,56 @@ public:
    Vector normal;
 };
 
+/** @brief Class for computing the Jacobians of the element transformations
+    on-the-fly, for batches of elements. */
+/** In contrast to GeometricFactors, which stores the Jacobians at all
+    quadrature points of all elements, this class only keeps an E-vector with
+    the mesh nodes and recomputes the Jacobians of a range of elements when
+    requested. It is used by the matrix-free (AssemblyLevel::NONE) integrator
+    kernels which trade additional floating point work for a reduced memory
+    footprint. */
+class BatchedGeometricFactors
+{
+protected:
+   const IntegrationRule *IntRule;
+   const DofToQuad *maps; ///< Not owned, FULL maps of the nodal element
+   Vector Enodes;         ///< E-vector of the nodes, (ND x SDIM x NE)
+   int dim, sdim, ne, nd, nq, batch_size;
+
+public:
+   /** @brief Construct the factors for the IntegrationRule @a ir and the
+       maximal number of elements per batch @a batch. */
+   /** The mesh nodes are created with Mesh::EnsureNodes() if necessary. */
+   BatchedGeometricFactors(Mesh *mesh, const IntegrationRule &ir,
+                           int batch = 1024);
+
+   /// The IntegrationRule used to compute the factors.
+   const IntegrationRule &GetIntRule() const { return *IntRule; }
+
+   /// Number of elements in the mesh.
+   int GetNE() const { return ne; }
+
+   /// Maximal number of elements in one batch.
+   int GetBatchSize() const { return batch_size; }
+
+   /// Number of batches needed to cover all elements of the mesh.
+   int GetNumBatches() const { return (ne + batch_size - 1) / batch_size; }
+
+   /** @brief Return the first element @a e0 and the number of elements @a nb
+       of batch @a b. */
+   void GetBatch(int b, int &e0, int &nb) const
+   {
+      e0 = b*batch_size;
+      nb = std::min(batch_size, ne - e0);
+   }
+
+   /** @brief Compute the Jacobians of the elements [@a e0, @a e0 + @a nb) at
+       all quadrature points. */
+   /** The output uses the same layout as GeometricFactors::J, i.e. (NQ x SDIM
+       x DIM x @a nb). */
+   void ComputeJacobians(int e0, int nb, Vector &J) const;
+};
+
 /// Class used to extrude the nodes of a mesh
 class NodeExtrudeCoefficient : public VectorCoefficient
 {
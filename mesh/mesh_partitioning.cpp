@@ -0,0 +1,764 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+// Implementation of the native mesh partitioners (without METIS), see
+// Mesh::GeneratePartitioning().
+
+#include "mesh_headers.hpp"
+#include "../fem/fem.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <queue>
+
+using namespace std;
+
+namespace mfem
+{
+
+// Compute the centers of the elements of 'mesh' as 3D points (with zero
+// coordinates beyond the space dimension) and their bounding box.
+static void GetElementCenters(Mesh &mesh, Array<double> &points,
+                              double min[3], double max[3])
+{
+   const int sdim = mesh.SpaceDimension();
+   MFEM_VERIFY(sdim <= 3, "space dimension " << sdim << " is not supported");
+   points.SetSize(3*mesh.GetNE());
+   points = 0.0;
+   for (int d = 0; d < 3; d++)
+   {
+      min[d] = (d < sdim) ? numeric_limits<double>::infinity() : 0.0;
+      max[d] = (d < sdim) ? -numeric_limits<double>::infinity() : 0.0;
+   }
+   Vector center;
+   for (int i = 0; i < mesh.GetNE(); i++)
+   {
+      mesh.GetElementCenter(i, center);
+      for (int d = 0; d < sdim; d++)
+      {
+         points[3*i + d] = center(d);
+         min[d] = std::min(min[d], center(d));
+         max[d] = std::max(max[d], center(d));
+      }
+   }
+}
+
+// Assign the parts [part, part + nparts) to the points with indices in [begin,
+// end), by recursive bisection in the direction of largest extent. The sizes
+// of the parts differ by at most one.
+static void RCBPartition(const Array<double> &points, int *begin, int *end,
+                         int part, int nparts, int *partitioning)
+{
+   if (nparts == 1)
+   {
+      for (int *i = begin; i != end; i++) { partitioning[*i] = part; }
+      return;
+   }
+
+   double min[3], max[3];
+   for (int d = 0; d < 3; d++)
+   {
+      min[d] = numeric_limits<double>::infinity();
+      max[d] = -numeric_limits<double>::infinity();
+   }
+   for (int *i = begin; i != end; i++)
+   {
+      for (int d = 0; d < 3; d++)
+      {
+         min[d] = std::min(min[d], points[3*(*i) + d]);
+         max[d] = std::max(max[d], points[3*(*i) + d]);
+      }
+   }
+   int dir = 0;
+   for (int d = 1; d < 3; d++)
+   {
+      if (max[d] - min[d] > max[dir] - min[dir]) { dir = d; }
+   }
+
+   const int nparts1 = nparts/2;
+   int *mid = begin + (int)(((long long)(end - begin))*nparts1/nparts);
+   std::nth_element(begin, mid, end, [&](int a, int b)
+   {
+      const double pa = points[3*a + dir], pb = points[3*b + dir];
+      return (pa < pb) || (pa == pb && a < b);
+   });
+
+   RCBPartition(points, begin, mid, part, nparts1, partitioning);
+   RCBPartition(points, mid, end, part + nparts1, nparts - nparts1,
+                partitioning);
+}
+
+void Mesh::PartitionRCB(int nparts, int *partitioning)
+{
+   Array<double> points;
+   double min[3], max[3];
+   GetElementCenters(*this, points, min, max);
+
+   Array<int> indices(NumOfElements);
+   for (int i = 0; i < NumOfElements; i++) { indices[i] = i; }
+   RCBPartition(points, indices.begin(), indices.end(), 0, nparts,
+                partitioning);
+}
+
+unsigned long long Mesh::MortonKey(unsigned x, unsigned y, unsigned z)
+{
+   unsigned long long key = 0;
+   for (int b = 0; b < 21; b++)
+   {
+      key |= (((unsigned long long)(x >> b) & 1) << (3*b)) |
+             (((unsigned long long)(y >> b) & 1) << (3*b + 1)) |
+             (((unsigned long long)(z >> b) & 1) << (3*b + 2));
+   }
+   return key;
+}
+
+void Mesh::PartitionSFC(int nparts, bool hilbert, int *partitioning)
+{
+   // position of each element along the curve
+   Array<int> position(NumOfElements);
+   if (hilbert && ncmesh)
+   {
+      // the elements of the NCMesh are already ordered along a space-filling
+      // curve, see NCMesh::InitialPartition
+      for (int i = 0; i < NumOfElements; i++) { position[i] = i; }
+   }
+   else if (hilbert)
+   {
+      GetHilbertElementOrdering(position);
+   }
+   else
+   {
+      Array<double> points;
+      double min[3], max[3];
+      GetElementCenters(*this, points, min, max);
+
+      const double nbins = (double)(1 << 21);
+      Array<unsigned long long> keys(NumOfElements);
+      for (int i = 0; i < NumOfElements; i++)
+      {
+         unsigned c[3];
+         for (int d = 0; d < 3; d++)
+         {
+            const double h = max[d] - min[d];
+            const double t = (h > 0.0) ? (points[3*i + d] - min[d])/h : 0.0;
+            c[d] = (unsigned) std::min(std::max(t*nbins, 0.0), nbins - 1);
+         }
+         keys[i] = MortonKey(c[0], c[1], c[2]);
+      }
+
+      Array<int> indices(NumOfElements);
+      for (int i = 0; i < NumOfElements; i++) { indices[i] = i; }
+      std::sort(indices.begin(), indices.end(), [&](int a, int b)
+      { return (keys[a] < keys[b]) || (keys[a] == keys[b] && a < b); });
+      for (int i = 0; i < NumOfElements; i++) { position[indices[i]] = i; }
+   }
+
+   // split the curve in segments with sizes differing by at most one
+   for (int i = 0; i < NumOfElements; i++)
+   {
+      partitioning[i] = (int)(((long long)position[i])*nparts/NumOfElements);
+   }
+}
+
+
+namespace internal
+{
+
+// Weighted undirected graph in CSR format, used by the multilevel partitioner.
+struct PartGraph
+{
+   int n;
+   Array<int> I, J;   // adjacency
+   Array<int> ew;     // edge weights, same layout as J
+   Array<int> vw;     // vertex weights
+};
+
+// Simple deterministic random numbers, so that all processors computing the
+// partitioning of the same mesh get the same result.
+class PartRandom
+{
+   unsigned long long state;
+public:
+   PartRandom() : state(88172645463325252ULL) { }
+   int Next(int n)
+   {
+      state ^= state << 13; state ^= state >> 7; state ^= state << 17;
+      return (int)(state % (unsigned long long)n);
+   }
+};
+
+// Coarsen 'g' by heavy edge matching: 'cmap' maps the vertices of 'g' to the
+// vertices of the coarse graph 'cg'. Matching two vertices is not allowed if
+// their combined weight exceeds 'max_vw'.
+static void CoarsenGraph(const PartGraph &g, int max_vw, PartRandom &rnd,
+                         Array<int> &cmap, PartGraph &cg)
+{
+   const int n = g.n;
+   Array<int> perm(n), match(n);
+   for (int i = 0; i < n; i++) { perm[i] = i; match[i] = -1; }
+   for (int i = n-1; i > 0; i--) { std::swap(perm[i], perm[rnd.Next(i+1)]); }
+
+   cmap.SetSize(n);
+   int cn = 0;
+   for (int k = 0; k < n; k++)
+   {
+      const int v = perm[k];
+      if (match[v] >= 0) { continue; }
+      int u = v, best_w = -1;
+      for (int j = g.I[v]; j < g.I[v+1]; j++)
+      {
+         const int w = g.J[j];
+         if (match[w] < 0 && w != v && g.ew[j] > best_w &&
+             g.vw[v] + g.vw[w] <= max_vw)
+         {
+            u = w;
+            best_w = g.ew[j];
+         }
+      }
+      match[v] = u;
+      match[u] = v;
+      cmap[v] = cmap[u] = cn++;
+   }
+
+   // build the coarse graph, merging the parallel edges
+   cg.n = cn;
+   cg.vw.SetSize(cn);
+   cg.vw = 0;
+   cg.I.SetSize(cn+1);
+   cg.J.SetSize(0);
+   cg.ew.SetSize(0);
+   Array<int> pos(cn);
+   pos = -1;
+   cg.I[0] = 0;
+   int c = 0;
+   for (int k = 0; k < n; k++)
+   {
+      // visit the coarse vertices in order
+      const int v = perm[k];
+      if (cmap[v] != c) { continue; }
+      const int pair[2] = { v, match[v] };
+      const int np = (pair[1] == v) ? 1 : 2;
+      const int start = cg.J.Size();
+      for (int p = 0; p < np; p++)
+      {
+         const int x = pair[p];
+         cg.vw[c] += g.vw[x];
+         for (int j = g.I[x]; j < g.I[x+1]; j++)
+         {
+            const int cw = cmap[g.J[j]];
+            if (cw == c) { continue; }
+            if (pos[cw] < start)
+            {
+               pos[cw] = cg.J.Size();
+               cg.J.Append(cw);
+               cg.ew.Append(g.ew[j]);
+            }
+            else
+            {
+               cg.ew[pos[cw]] += g.ew[j];
+            }
+         }
+      }
+      cg.I[++c] = cg.J.Size();
+   }
+   MFEM_ASSERT(c == cn, "internal error");
+}
+
+// Return a pseudo-peripheral vertex of the vertices of 'g' with the label
+// 'lab', found by two breadth first searches starting from 'start'. The array
+// 'dist' is used as a workspace.
+static int PseudoPeripheralVertex(const PartGraph &g, const Array<int> &label,
+                                  int lab, const Array<int> &verts, int start,
+                                  Array<int> &dist)
+{
+   Array<int> queue;
+   queue.Reserve(verts.Size());
+   int root = start;
+   for (int k = 0; k < 2; k++)
+   {
+      for (int i = 0; i < verts.Size(); i++) { dist[verts[i]] = -1; }
+      queue.SetSize(0);
+      queue.Append(root);
+      dist[root] = 0;
+      for (int q = 0; q < queue.Size(); q++)
+      {
+         const int v = queue[q];
+         for (int j = g.I[v]; j < g.I[v+1]; j++)
+         {
+            const int w = g.J[j];
+            if (label[w] == lab && dist[w] < 0)
+            {
+               dist[w] = dist[v] + 1;
+               queue.Append(w);
+            }
+         }
+      }
+      root = queue.Last();
+   }
+   return root;
+}
+
+// Bisect the vertices 'verts' of 'g', which have the label 'lab', by greedy
+// graph growing: starting from 'root', the vertex with the largest reduction
+// of the cut is added to the region until its weight reaches 'target_w'. The
+// vertices of the region get the label 'lab0' and the other ones 'lab1'. The
+// array 'gain' is used as a workspace. Returns the weight of the cut edges.
+static int GrowBisection(const PartGraph &g, const Array<int> &verts,
+                         int root, int target_w, int lab, int lab0, int lab1,
+                         Array<int> &label, Array<int> &gain)
+{
+   // gain of moving a vertex to the region: weight of its edges to the region
+   // minus weight of its edges to the rest of the subset
+   for (int i = 0; i < verts.Size(); i++)
+   {
+      const int v = verts[i];
+      gain[v] = 0;
+      for (int j = g.I[v]; j < g.I[v+1]; j++)
+      {
+         if (label[g.J[j]] == lab) { gain[v] -= g.ew[j]; }
+      }
+   }
+
+   // max-heap of (gain, -vertex) with lazy deletion of outdated entries
+   std::priority_queue<std::pair<int,int>> heap;
+   heap.push(std::make_pair(gain[root], -root));
+   int w = 0, next = 0;
+   while (w < target_w)
+   {
+      if (heap.empty())
+      {
+         // restart in another connected component
+         while (next < verts.Size() && label[verts[next]] != lab) { next++; }
+         if (next == verts.Size()) { break; }
+         heap.push(std::make_pair(gain[verts[next]], -verts[next]));
+      }
+      const int gv = heap.top().first, v = -heap.top().second;
+      heap.pop();
+      if (label[v] != lab || gv != gain[v]) { continue; }
+      // do not overshoot the target by more than half of the vertex weight
+      if (w > 0 && 2*(target_w - w) < g.vw[v]) { break; }
+      label[v] = lab0;
+      w += g.vw[v];
+      for (int j = g.I[v]; j < g.I[v+1]; j++)
+      {
+         const int u = g.J[j];
+         if (label[u] == lab)
+         {
+            gain[u] += 2*g.ew[j];
+            heap.push(std::make_pair(gain[u], -u));
+         }
+      }
+   }
+
+   int cut = 0;
+   for (int i = 0; i < verts.Size(); i++)
+   {
+      const int v = verts[i];
+      if (label[v] == lab) { label[v] = lab1; continue; }
+      for (int j = g.I[v]; j < g.I[v+1]; j++)
+      {
+         const int u = g.J[j];
+         if (label[u] == lab || label[u] == lab1) { cut += g.ew[j]; }
+      }
+   }
+   return cut;
+}
+
+// Fiduccia-Mattheyses refinement of the bisection of the vertices 'verts' of
+// 'g' with labels 'lab0' and 'lab1': in each pass, vertices are moved one at
+// a time (the one with the largest reduction of the cut, even if negative)
+// and the best balanced state of the pass is kept. The weight of the 'lab0'
+// side must stay within 'tol' of 'target_w', unless it is not initially.
+// The array 'local' is used as a workspace. Returns the new cut.
+static int RefineBisection(const PartGraph &g, const Array<int> &verts,
+                           int target_w, int tol, int lab0, int lab1,
+                           int cut, Array<int> &label, Array<int> &local)
+{
+   const int nv = verts.Size();
+   for (int i = 0; i < nv; i++) { local[verts[i]] = i; }
+   int w0 = 0;
+   for (int i = 0; i < nv; i++)
+   {
+      if (label[verts[i]] == lab0) { w0 += g.vw[verts[i]]; }
+   }
+
+   Array<int> gain(nv), locked(nv), moves;
+   const int max_bad_moves = std::max(25, nv/20);
+   for (int pass = 0; pass < 4; pass++)
+   {
+      // gain of moving a vertex to the other side
+      std::priority_queue<std::pair<int,int>> heap[2];
+      for (int i = 0; i < nv; i++)
+      {
+         const int v = verts[i];
+         gain[i] = 0;
+         locked[i] = 0;
+         bool boundary = false;
+         for (int j = g.I[v]; j < g.I[v+1]; j++)
+         {
+            const int u = g.J[j];
+            if (label[u] == label[v]) { gain[i] -= g.ew[j]; }
+            else if (label[u] == lab0 || label[u] == lab1)
+            {
+               gain[i] += g.ew[j];
+               boundary = true;
+            }
+         }
+         if (boundary)
+         {
+            heap[label[v] == lab0 ? 0 : 1].push(std::make_pair(gain[i], -i));
+         }
+      }
+
+      const int init_cut = cut;
+      int best_cut = cut, best_dev = std::abs(w0 - target_w), best_pos = 0;
+      moves.SetSize(0);
+      while (moves.Size() - best_pos < max_bad_moves)
+      {
+         // remove the outdated entries from the top of the heaps
+         for (int side = 0; side < 2; side++)
+         {
+            const int side_lab = side ? lab1 : lab0;
+            while (!heap[side].empty())
+            {
+               const int i = -heap[side].top().second;
+               if (!locked[i] && label[verts[i]] == side_lab &&
+                   gain[i] == heap[side].top().first) { break; }
+               heap[side].pop();
+            }
+         }
+         // select the side to move from: the best gain among the moves that
+         // keep the balance, otherwise the heavier side
+         int from = -1;
+         for (int side = 0; side < 2; side++)
+         {
+            if (heap[side].empty()) { continue; }
+            const int v = verts[-heap[side].top().second];
+            const int nw0 = side ? w0 + g.vw[v] : w0 - g.vw[v];
+            if (std::abs(nw0 - target_w) > tol) { continue; }
+            if (from < 0 || heap[side].top().first > heap[from].top().first)
+            {
+               from = side;
+            }
+         }
+         if (from < 0)
+         {
+            from = (w0 > target_w) ? 0 : 1;
+            if (heap[from].empty()) { break; }
+         }
+
+         const int i = -heap[from].top().second;
+         heap[from].pop();
+         const int v = verts[i];
+         const int to_lab = from ? lab0 : lab1;
+         label[v] = to_lab;
+         locked[i] = 1;
+         w0 += from ? g.vw[v] : -g.vw[v];
+         cut -= gain[i];
+         moves.Append(i);
+         for (int j = g.I[v]; j < g.I[v+1]; j++)
+         {
+            const int u = g.J[j];
+            if (label[u] != lab0 && label[u] != lab1) { continue; }
+            const int k = local[u];
+            if (locked[k]) { continue; }
+            gain[k] += (label[u] == to_lab) ? -2*g.ew[j] : 2*g.ew[j];
+            heap[label[u] == lab0 ? 0 : 1].push(std::make_pair(gain[k], -k));
+         }
+
+         const int dev = std::abs(w0 - target_w);
+         if ((dev <= tol && (cut < best_cut ||
+                             (cut == best_cut && dev < best_dev))) ||
+             (best_dev > tol && dev < best_dev))
+         {
+            best_cut = cut;
+            best_dev = dev;
+            best_pos = moves.Size();
+         }
+      }
+
+      // undo the moves after the best state
+      for (int m = moves.Size() - 1; m >= best_pos; m--)
+      {
+         const int v = verts[moves[m]];
+         const bool to0 = (label[v] == lab1);
+         label[v] = to0 ? lab0 : lab1;
+         w0 += to0 ? g.vw[v] : -g.vw[v];
+      }
+      cut = best_cut;
+      if (cut >= init_cut) { break; }
+   }
+   return cut;
+}
+
+// Recursively bisect the vertices 'verts' of 'g' in the parts [part, part +
+// nparts), proportionally to the number of parts on each side. Each bisection
+// keeps the best of several graph growing tries.
+static void RecursiveBisection(const PartGraph &g, const Array<int> &verts,
+                               int part, int nparts, PartRandom &rnd,
+                               Array<int> &label, Array<int> &work)
+{
+   if (nparts == 1 || verts.Size() == 0)
+   {
+      for (int i = 0; i < verts.Size(); i++) { label[verts[i]] = part; }
+      return;
+   }
+   const int nparts0 = nparts/2;
+   int total_w = 0;
+   for (int i = 0; i < verts.Size(); i++) { total_w += g.vw[verts[i]]; }
+   const int target_w = (int)(((long long)total_w)*nparts0/nparts);
+
+   int max_vw = 0;
+   for (int i = 0; i < verts.Size(); i++)
+   {
+      max_vw = std::max(max_vw, g.vw[verts[i]]);
+   }
+   const int tol = std::max(max_vw, total_w/(50*nparts));
+
+   // temporary labels for the bisection: all other vertices have labels >= 0
+   const int lab = -1, lab0 = -2, lab1 = -3;
+   const int ntries = 4;
+   int best_cut = -1;
+   Array<int> verts0, verts1;
+   for (int t = 0; t < ntries; t++)
+   {
+      for (int i = 0; i < verts.Size(); i++) { label[verts[i]] = lab; }
+      const int start = verts[(t == 0) ? 0 : rnd.Next(verts.Size())];
+      const int root = PseudoPeripheralVertex(g, label, lab, verts, start,
+                                              work);
+      int cut = GrowBisection(g, verts, root, target_w, lab, lab0, lab1,
+                              label, work);
+      cut = RefineBisection(g, verts, target_w, tol, lab0, lab1, cut, label,
+                            work);
+      if (best_cut < 0 || cut < best_cut)
+      {
+         best_cut = cut;
+         verts0.SetSize(0);
+         verts1.SetSize(0);
+         for (int i = 0; i < verts.Size(); i++)
+         {
+            (label[verts[i]] == lab0 ? verts0 : verts1).Append(verts[i]);
+         }
+      }
+   }
+   for (int i = 0; i < verts0.Size(); i++) { label[verts0[i]] = part; }
+   for (int i = 0; i < verts1.Size(); i++)
+   {
+      label[verts1[i]] = part + nparts0;
+   }
+   RecursiveBisection(g, verts0, part, nparts0, rnd, label, work);
+   RecursiveBisection(g, verts1, part + nparts0, nparts - nparts0, rnd, label,
+                      work);
+}
+
+// Greedy k-way refinement of the partitioning 'part' of 'g': move boundary
+// vertices to the neighbor part with the largest reduction of the edge-cut,
+// while keeping the part weights below 'max_pw' (moves reducing the weight of
+// overweight parts are always allowed). Parts are never emptied.
+static void RefineKway(const PartGraph &g, int nparts, int max_pw,
+                       int npasses, Array<int> &part)
+{
+   Array<int> pw(nparts), psize(nparts);
+   pw = 0;
+   psize = 0;
+   for (int v = 0; v < g.n; v++)
+   {
+      pw[part[v]] += g.vw[v];
+      psize[part[v]]++;
+   }
+
+   Array<int> conn(nparts), touched;
+   conn = 0;
+   for (int pass = 0; pass < npasses; pass++)
+   {
+      int moves = 0;
+      for (int v = 0; v < g.n; v++)
+      {
+         const int from = part[v];
+         if (psize[from] == 1) { continue; }
+
+         // connectivity of 'v' to the parts of its neighbors
+         touched.SetSize(0);
+         for (int j = g.I[v]; j < g.I[v+1]; j++)
+         {
+            const int p = part[g.J[j]];
+            if (conn[p] == 0) { touched.Append(p); }
+            conn[p] += g.ew[j];
+         }
+         const int internal = conn[from];
+
+         int to = -1, best_gain = 0;
+         const bool overweight = pw[from] > max_pw;
+         for (int k = 0; k < touched.Size(); k++)
+         {
+            const int p = touched[k];
+            if (p == from || pw[p] + g.vw[v] > max_pw) { continue; }
+            const int gain = conn[p] - internal;
+            // accept: positive gain, zero gain with better balance, or any
+            // gain if the part is overweight
+            const bool better_balance = pw[p] + g.vw[v] < pw[from];
+            if (to < 0)
+            {
+               if (gain > 0 || (gain == 0 && better_balance) || overweight)
+               {
+                  to = p;
+                  best_gain = gain;
+               }
+            }
+            else if (gain > best_gain ||
+                     (gain == best_gain && pw[p] < pw[to]))
+            {
+               to = p;
+               best_gain = gain;
+            }
+         }
+         for (int k = 0; k < touched.Size(); k++) { conn[touched[k]] = 0; }
+
+         if (to >= 0)
+         {
+            part[v] = to;
+            pw[from] -= g.vw[v];
+            pw[to] += g.vw[v];
+            psize[from]--;
+            psize[to]++;
+            moves++;
+         }
+      }
+      if (moves == 0) { break; }
+   }
+}
+
+} // namespace internal
+
+void Mesh::PartitionGraph(int nparts, int *partitioning)
+{
+   using namespace internal;
+
+   const Table &el_el = ElementToElementTable();
+   const int n = NumOfElements;
+
+   // the dual graph with unit weights is the finest level
+   Array<PartGraph*> levels;
+   Array<Array<int>*> cmaps;
+   PartGraph *g = new PartGraph;
+   g->n = n;
+   g->I.MakeRef(const_cast<int*>(el_el.GetI()), n+1);
+   g->J.MakeRef(const_cast<int*>(el_el.GetJ()), el_el.Size_of_connections());
+   g->ew.SetSize(g->J.Size());
+   g->ew = 1;
+   g->vw.SetSize(n);
+   g->vw = 1;
+   levels.Append(g);
+
+   // coarsen until the graph is small enough or the coarsening stalls
+   PartRandom rnd;
+   const int coarse_size = std::max(20*nparts, 100);
+   const int max_vw = std::max(1, (int)(1.5*n/coarse_size));
+   while (levels.Last()->n > coarse_size)
+   {
+      const PartGraph &fg = *levels.Last();
+      Array<int> *cmap = new Array<int>;
+      PartGraph *cg = new PartGraph;
+      CoarsenGraph(fg, max_vw, rnd, *cmap, *cg);
+      if (cg->n > 0.95*fg.n)
+      {
+         delete cg;
+         delete cmap;
+         break;
+      }
+      levels.Append(cg);
+      cmaps.Append(cmap);
+   }
+
+   // initial partitioning of the coarsest graph
+   const PartGraph &coarsest = *levels.Last();
+   const int total_w = n;
+   Array<int> part(coarsest.n), verts(coarsest.n), work(coarsest.n);
+   for (int i = 0; i < coarsest.n; i++) { verts[i] = i; }
+   RecursiveBisection(coarsest, verts, 0, nparts, rnd, part, work);
+
+   // project back to the finer levels and refine
+   const int avg_w = (total_w + nparts - 1)/nparts;
+   const int max_pw = std::max((int)(1.03*avg_w), avg_w + 1);
+   for (int l = levels.Size() - 1; l >= 0; l--)
+   {
+      const PartGraph &lg = *levels[l];
+      int lmax_pw = max_pw;
+      for (int v = 0; v < lg.n; v++)
+      {
+         lmax_pw = std::max(lmax_pw, avg_w + lg.vw[v]);
+      }
+      RefineKway(lg, nparts, (l == 0) ? max_pw : lmax_pw, 8, part);
+      if (l > 0)
+      {
+         const Array<int> &cmap = *cmaps[l-1];
+         Array<int> fine_part(cmap.Size());
+         for (int v = 0; v < cmap.Size(); v++) { fine_part[v] = part[cmap[v]]; }
+         mfem::Swap(part, fine_part);
+      }
+   }
+
+   for (int i = 0; i < n; i++) { partitioning[i] = part[i]; }
+
+   for (int l = 0; l < levels.Size(); l++) { delete levels[l]; }
+   for (int l = 0; l < cmaps.Size(); l++) { delete cmaps[l]; }
+}
+
+void Mesh::GetPartitioningStats(const int *partitioning, int nparts,
+                                int &edgecut, double &imbalance)
+{
+   const bool own_el_to_el = (el_to_el == NULL);
+   const Table &el_el = ElementToElementTable();
+
+   edgecut = 0;
+   for (int i = 0; i < NumOfElements; i++)
+   {
+      for (int j = el_el.GetI()[i]; j < el_el.GetI()[i+1]; j++)
+      {
+         const int k = el_el.GetJ()[j];
+         if (i < k && partitioning[i] != partitioning[k]) { edgecut++; }
+      }
+   }
+
+   Array<int> psize(nparts);
+   psize = 0;
+   for (int i = 0; i < NumOfElements; i++) { psize[partitioning[i]]++; }
+   imbalance = (NumOfElements > 0) ?
+               ((double)psize.Max())*nparts/NumOfElements : 1.0;
+
+   if (own_el_to_el)
+   {
+      delete el_to_el;
+      el_to_el = NULL;
+   }
+}
+
+void Mesh::PrintPartitioningStats(const int *partitioning, int nparts,
+                                  std::ostream &out)
+{
+   int edgecut;
+   double imbalance;
+   GetPartitioningStats(partitioning, nparts, edgecut, imbalance);
+
+   Array<int> psize(nparts);
+   psize = 0;
+   for (int i = 0; i < NumOfElements; i++) { psize[partitioning[i]]++; }
+
+   out << "Partitioning statistics:\n"
+       << "   number of parts : " << nparts << '\n'
+       << "   part sizes      : min " << psize.Min() << ", max "
+       << psize.Max() << '\n'
+       << "   edge-cut        : " << edgecut << '\n'
+       << "   imbalance       : " << imbalance << endl;
+}
+
+} // namespace mfem
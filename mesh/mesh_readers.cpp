@@ -11,6 +11,7 @@
 
 #include "mesh_headers.hpp"
 #include "../fem/fem.hpp"
+#include "../general/binaryio.hpp"
 #include "../general/text.hpp"
 
 #include <iostream>
@@ -113,6 +114,74 @@ void Mesh::ReadMFEMMesh(std::istream &input, bool mfem_v11, int &curved)
    if (remove_unused_vertices) { RemoveUnusedVertices(); }
 }
 
+// Read 'n' elements written as arrays of attributes, geometries and vertices,
+// see Mesh::BinaryPrinter().
+static void ReadBinaryElements(std::istream &input, Mesh &mesh, int n,
+                               Array<Element *> &elems)
+{
+   Array<int> attr(n), geom(n), vert;
+   bin_io::ReadArray(input, attr.GetData(), n);
+   bin_io::ReadArray(input, geom.GetData(), n);
+   int nv = 0;
+   for (int i = 0; i < n; i++)
+   {
+      MFEM_VERIFY(geom[i] >= 0 && geom[i] < Geometry::NumGeom,
+                  "invalid binary mesh data");
+      nv += Geometry::NumVerts[geom[i]];
+   }
+   vert.SetSize(nv);
+   bin_io::ReadArray(input, vert.GetData(), nv);
+   MFEM_VERIFY(input, "invalid binary mesh data");
+
+   elems.SetSize(n);
+   for (int i = 0, j = 0; i < n; i++)
+   {
+      elems[i] = mesh.NewElement(geom[i]);
+      elems[i]->SetAttribute(attr[i]);
+      elems[i]->SetVertices(vert.GetData() + j);
+      j += Geometry::NumVerts[geom[i]];
+   }
+}
+
+void Mesh::ReadMFEMBinaryMesh(std::istream &input, int &curved)
+{
+   // Read MFEM binary mesh v1.0 format, see BinaryPrinter()
+   int header[7];
+   bin_io::ReadArray(input, header, 7);
+   MFEM_VERIFY(input, "invalid binary mesh data");
+   MFEM_VERIFY(header[0] == bin_io::byte_order_mark,
+               "the binary mesh was written with a different byte order");
+   Dim = header[1];
+   spaceDim = header[2];
+   NumOfElements = header[3];
+   NumOfBdrElements = header[4];
+   NumOfVertices = header[5];
+   curved = header[6];
+
+   ReadBinaryElements(input, *this, NumOfElements, elements);
+   ReadBinaryElements(input, *this, NumOfBdrElements, boundary);
+
+   vertices.SetSize(NumOfVertices);
+   if (!curved)
+   {
+      Array<double> coord(NumOfVertices*spaceDim);
+      bin_io::ReadArray(input, coord.GetData(), coord.Size());
+      MFEM_VERIFY(input, "invalid binary mesh data");
+      for (int i = 0; i < NumOfVertices; i++)
+      {
+         for (int j = 0; j < spaceDim; j++)
+         {
+            vertices[i](j) = coord[i*spaceDim + j];
+         }
+      }
+   }
+   else
+   {
+      // prepare to read the nodes
+      input >> ws;
+   }
+}
+
 void Mesh::ReadLineMesh(std::istream &input)
 {
    int j,p1,p2,a;
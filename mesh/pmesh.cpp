@@ -455,7 +455,7 @@ int ParMesh::BuildLocalBoundary(const Mesh& mesh, const int* partitioning,
    {
       for (int i = 0; i < mesh.GetNBE(); i++)
       {
-         int vert = mesh.boundary[i]->GetVertices()[0];
+         int vert = mesh.BdrElementVertices(i)[0];
          int el1, el2;
          mesh.GetFaceElements(vert, &el1, &el2);
          if (partitioning[el1] == MyRank)
@@ -468,7 +468,7 @@ int ParMesh::BuildLocalBoundary(const Mesh& mesh, const int* partitioning,
       boundary.SetSize(nbdry);
       for (int i = 0; i < mesh.GetNBE(); i++)
       {
-         int vert = mesh.boundary[i]->GetVertices()[0];
+         int vert = mesh.BdrElementVertices(i)[0];
          int el1, el2;
          mesh.GetFaceElements(vert, &el1, &el2);
          if (partitioning[el1] == MyRank)
@@ -1939,8 +1939,8 @@ void ParMesh::ExchangeFaceNbrData(Table *gr_sface, int *s2l_face)
             el_marker[el] = fn;
             send_face_nbr_elements.AddAColumnInRow(fn);
 
-            const int nv = elements[el]->GetNVertices();
-            const int *v = elements[el]->GetVertices();
+            const int nv = Geometry::NumVerts[GetElementBaseGeometry(el)];
+            const int *v = ElementVertices(el);
             for (int j = 0; j < nv; j++)
                if (vertex_marker[v[j]] != fn)
                {
@@ -1987,8 +1987,8 @@ void ParMesh::ExchangeFaceNbrData(Table *gr_sface, int *s2l_face)
             el_marker[el] = fn;
             send_face_nbr_elements.AddConnection(fn, el);
 
-            const int nv = elements[el]->GetNVertices();
-            const int *v = elements[el]->GetVertices();
+            const int nv = Geometry::NumVerts[GetElementBaseGeometry(el)];
+            const int *v = ElementVertices(el);
             for (int j = 0; j < nv; j++)
                if (vertex_marker[v[j]] != fn)
                {
@@ -2044,7 +2044,7 @@ void ParMesh::ExchangeFaceNbrData(Table *gr_sface, int *s2l_face)
 
       for (int el = 0; el < num_elems; el++)
       {
-         const int nv = elements[elems[el]]->GetNVertices();
+         const int nv = Geometry::NumVerts[GetElementBaseGeometry(elems[el])];
          elemdata += 2; // skip the attribute and the geometry type
          for (int j = 0; j < nv; j++)
          {
@@ -2577,6 +2577,8 @@ void ParMesh::ReorientTetMesh()
       return;
    }
 
+   UseCompactElementStorage(false);
+
    ResetLazyData();
 
    DSTable *old_v_to_v = NULL;
@@ -3974,9 +3976,9 @@ void ParMesh::PrintXG(std::ostream &out) const
       out << NumOfElements << '\n';
       for (i = 0; i < NumOfElements; i++)
       {
-         nv = elements[i]->GetNVertices();
-         ind = elements[i]->GetVertices();
-         out << elements[i]->GetAttribute();
+         nv = GetElement(i)->GetNVertices();
+         ind = GetElement(i)->GetVertices();
+         out << GetElement(i)->GetAttribute();
          for (j = 0; j < nv; j++)
          {
             out << " " << ind[j]+1;
@@ -3989,9 +3991,9 @@ void ParMesh::PrintXG(std::ostream &out) const
       // boundary
       for (i = 0; i < NumOfBdrElements; i++)
       {
-         nv = boundary[i]->GetNVertices();
-         ind = boundary[i]->GetVertices();
-         out << boundary[i]->GetAttribute();
+         nv = GetBdrElement(i)->GetNVertices();
+         ind = GetBdrElement(i)->GetVertices();
+         out << GetBdrElement(i)->GetAttribute();
          for (j = 0; j < nv; j++)
          {
             out << " " << ind[j]+1;
@@ -4037,9 +4039,9 @@ void ParMesh::PrintXG(std::ostream &out) const
       // print the elements
       for (i = 0; i < NumOfElements; i++)
       {
-         nv = elements[i]->GetNVertices();
-         ind = elements[i]->GetVertices();
-         out << i+1 << " " << elements[i]->GetAttribute();
+         nv = GetElement(i)->GetNVertices();
+         ind = GetElement(i)->GetVertices();
+         out << i+1 << " " << GetElement(i)->GetAttribute();
          for (j = 0; j < nv; j++)
          {
             out << " " << ind[j]+1;
@@ -4050,9 +4052,9 @@ void ParMesh::PrintXG(std::ostream &out) const
       // print the boundary information
       for (i = 0; i < NumOfBdrElements; i++)
       {
-         nv = boundary[i]->GetNVertices();
-         ind = boundary[i]->GetVertices();
-         out << boundary[i]->GetAttribute();
+         nv = GetBdrElement(i)->GetNVertices();
+         ind = GetBdrElement(i)->GetVertices();
+         out << GetBdrElement(i)->GetAttribute();
          for (j = 0; j < nv; j++)
          {
             out << " " << ind[j]+1;
@@ -4088,8 +4090,8 @@ void ParMesh::PrintXG(std::ostream &out) const
       // boundary
       for (i = 0; i < NumOfBdrElements; i++)
       {
-         attr = boundary[i]->GetAttribute();
-         boundary[i]->GetVertices(v);
+         attr = GetBdrElement(i)->GetAttribute();
+         GetBdrElement(i)->GetVertices(v);
          out << attr << "     ";
          for (j = 0; j < v.Size(); j++)
          {
@@ -4114,8 +4116,8 @@ void ParMesh::PrintXG(std::ostream &out) const
       out << NumOfElements << '\n';
       for (i = 0; i < NumOfElements; i++)
       {
-         attr = elements[i]->GetAttribute();
-         elements[i]->GetVertices(v);
+         attr = GetElement(i)->GetAttribute();
+         GetElement(i)->GetVertices(v);
 
          out << attr << "   ";
          if ((j = GetElementType(i)) == Element::TRIANGLE)
@@ -4228,7 +4230,7 @@ void ParMesh::Print(std::ostream &out) const
        << "\n\nelements\n" << NumOfElements << '\n';
    for (i = 0; i < NumOfElements; i++)
    {
-      PrintElement(elements[i], out);
+      PrintElement(GetElement(i), out);
    }
 
    int num_bdr_elems = NumOfBdrElements;
@@ -4239,7 +4241,7 @@ void ParMesh::Print(std::ostream &out) const
    out << "\nboundary\n" << num_bdr_elems << '\n';
    for (i = 0; i < NumOfBdrElements; i++)
    {
-      PrintElement(boundary[i], out);
+      PrintElement(GetBdrElement(i), out);
    }
 
    if (print_shared && Dim > 1)
@@ -4288,18 +4290,22 @@ void ParMesh::Print(adios2stream &out) const
 }
 #endif
 
-static void dump_element(const Element* elem, Array<int> &data)
+static void dump_element(Geometry::Type geom, const int *v, Array<int> &data)
 {
-   data.Append(elem->GetGeometryType());
+   data.Append(geom);
 
-   int nv = elem->GetNVertices();
-   const int *v = elem->GetVertices();
+   const int nv = Geometry::NumVerts[geom];
    for (int i = 0; i < nv; i++)
    {
       data.Append(v[i]);
    }
 }
 
+static void dump_element(const Element* elem, Array<int> &data)
+{
+   dump_element(elem->GetGeometryType(), elem->GetVertices(), data);
+}
+
 void ParMesh::PrintAsOne(std::ostream &out)
 {
    int i, j, k, p, nv_ne[2], &nv = nv_ne[0], &ne = nv_ne[1], vc;
@@ -4335,10 +4341,10 @@ void ParMesh::PrintAsOne(std::ostream &out)
       for (i = 0; i < NumOfElements; i++)
       {
          // processor number + 1 as attribute and geometry type
-         out << 1 << ' ' << elements[i]->GetGeometryType();
+         out << 1 << ' ' << GetElementBaseGeometry(i);
          // vertices
-         nv = elements[i]->GetNVertices();
-         v  = elements[i]->GetVertices();
+         nv = Geometry::NumVerts[GetElementBaseGeometry(i)];
+         v  = ElementVertices(i);
          for (j = 0; j < nv; j++)
          {
             out << ' ' << v[j];
@@ -4375,7 +4381,7 @@ void ParMesh::PrintAsOne(std::ostream &out)
       ne = 0;
       for (i = 0; i < NumOfElements; i++)
       {
-         ne += 1 + elements[i]->GetNVertices();
+         ne += 1 + Geometry::NumVerts[GetElementBaseGeometry(i)];
       }
       nv = NumOfVertices;
       MPI_Send(nv_ne, 2, MPI_INT, 0, 444, MyComm);
@@ -4384,7 +4390,7 @@ void ParMesh::PrintAsOne(std::ostream &out)
       ints.SetSize(0);
       for (i = 0; i < NumOfElements; i++)
       {
-         dump_element(elements[i], ints);
+         dump_element(GetElementBaseGeometry(i), ElementVertices(i), ints);
       }
       MFEM_ASSERT(ints.Size() == ne, "");
       if (ne)
@@ -4414,7 +4420,8 @@ void ParMesh::PrintAsOne(std::ostream &out)
    ne = 0;
    for (i = j = 0; i < NumOfBdrElements; i++)
    {
-      dump_element(boundary[i], ints); ne++;
+      dump_element(GetBdrElementBaseGeometry(i), BdrElementVertices(i), ints);
+      ne++;
    }
    if (!pncmesh)
    {
@@ -4656,8 +4663,8 @@ void ParMesh::PrintAsOneXG(std::ostream &out)
          out << ne << '\n';
          for (i = 0; i < NumOfElements; i++)
          {
-            nv = elements[i]->GetNVertices();
-            ind = elements[i]->GetVertices();
+            nv = Geometry::NumVerts[GetElementBaseGeometry(i)];
+            ind = ElementVertices(i);
             out << 1;
             for (j = 0; j < nv; j++)
             {
@@ -4690,8 +4697,8 @@ void ParMesh::PrintAsOneXG(std::ostream &out)
          // boundary
          for (i = 0; i < NumOfBdrElements; i++)
          {
-            nv = boundary[i]->GetNVertices();
-            ind = boundary[i]->GetVertices();
+            nv = Geometry::NumVerts[GetBdrElementBaseGeometry(i)];
+            ind = BdrElementVertices(i);
             out << 1;
             for (j = 0; j < nv; j++)
             {
@@ -4753,7 +4760,7 @@ void ParMesh::PrintAsOneXG(std::ostream &out)
          ints.SetSize(NumOfElements*4);
          for (i = 0; i < NumOfElements; i++)
          {
-            v = elements[i]->GetVertices();
+            v = ElementVertices(i);
             for (j = 0; j < 4; j++)
             {
                ints[4*i+j] = v[j];
@@ -4769,7 +4776,7 @@ void ParMesh::PrintAsOneXG(std::ostream &out)
          ints.SetSize(3*ne);
          for (i = 0; i < NumOfBdrElements; i++)
          {
-            v = boundary[i]->GetVertices();
+            v = BdrElementVertices(i);
             for (j = 0; j < 3; j++)
             {
                ints[3*i+j] = v[j];
@@ -4834,8 +4841,8 @@ void ParMesh::PrintAsOneXG(std::ostream &out)
          ne = TG_ne;
          for (i = 0; i < NumOfElements; i++)
          {
-            nv = elements[i]->GetNVertices();
-            ind = elements[i]->GetVertices();
+            nv = Geometry::NumVerts[GetElementBaseGeometry(i)];
+            ind = ElementVertices(i);
             out << i+1 << " " << 1;
             for (j = 0; j < nv; j++)
             {
@@ -4867,8 +4874,8 @@ void ParMesh::PrintAsOneXG(std::ostream &out)
          // boundary
          for (i = 0; i < NumOfBdrElements; i++)
          {
-            nv = boundary[i]->GetNVertices();
-            ind = boundary[i]->GetVertices();
+            nv = Geometry::NumVerts[GetBdrElementBaseGeometry(i)];
+            ind = BdrElementVertices(i);
             out << 1;
             for (j = 0; j < nv; j++)
             {
@@ -4930,7 +4937,7 @@ void ParMesh::PrintAsOneXG(std::ostream &out)
          ints.SetSize(NumOfElements*8);
          for (i = 0; i < NumOfElements; i++)
          {
-            v = elements[i]->GetVertices();
+            v = ElementVertices(i);
             for (j = 0; j < 8; j++)
             {
                ints[8*i+j] = v[j];
@@ -4944,7 +4951,7 @@ void ParMesh::PrintAsOneXG(std::ostream &out)
          ints.SetSize(4*ne);
          for (i = 0; i < NumOfBdrElements; i++)
          {
-            v = boundary[i]->GetVertices();
+            v = BdrElementVertices(i);
             for (j = 0; j < 4; j++)
             {
                ints[4*i+j] = v[j];
@@ -4981,8 +4988,8 @@ void ParMesh::PrintAsOneXG(std::ostream &out)
          // boundary
          for (i = 0; i < NumOfBdrElements; i++)
          {
-            attr = boundary[i]->GetAttribute();
-            boundary[i]->GetVertices(v);
+            attr = GetBdrAttribute(i);
+            GetBdrElementVertices(i, v);
             out << attr << "     ";
             for (j = 0; j < v.Size(); j++)
             {
@@ -5027,8 +5034,8 @@ void ParMesh::PrintAsOneXG(std::ostream &out)
          out << ne << '\n';
          for (i = 0; i < NumOfElements; i++)
          {
-            // attr = elements[i]->GetAttribute(); // not used
-            elements[i]->GetVertices(v);
+            // attr = GetElement(i)->GetAttribute(); // not used
+            GetElementVertices(i, v);
             out << 1 << "   " << 3 << "   ";
             for (j = 0; j < v.Size(); j++)
             {
@@ -5093,7 +5100,7 @@ void ParMesh::PrintAsOneXG(std::ostream &out)
          ints.SetSize(2*ne);
          for (i = 0; i < NumOfBdrElements; i++)
          {
-            boundary[i]->GetVertices(v);
+            GetBdrElementVertices(i, v);
             for (j = 0; j < 2; j++)
             {
                ints[2*i+j] = v[j];
@@ -5116,7 +5123,7 @@ void ParMesh::PrintAsOneXG(std::ostream &out)
          ints.SetSize(NumOfElements*3);
          for (i = 0; i < NumOfElements; i++)
          {
-            elements[i]->GetVertices(v);
+            GetElementVertices(i, v);
             for (j = 0; j < 3; j++)
             {
                ints[3*i+j] = v[j];
@@ -5301,6 +5308,22 @@ void ParMesh::ParPrint(ostream &out) const
    // be adding additional parallel mesh information.
    Printer(out, "mfem_serial_mesh_end");
 
+   PrintSharedEntities(out);
+}
+
+void ParMesh::ParPrintBinary(ostream &out) const
+{
+   MFEM_VERIFY(!NURBSext && !pncmesh,
+               "the binary format does not support NURBS or AMR meshes");
+
+   // Binary serial mesh, followed by the (text) parallel mesh information.
+   BinaryPrinter(out, "mfem_serial_mesh_end");
+
+   PrintSharedEntities(out);
+}
+
+void ParMesh::PrintSharedEntities(ostream &out) const
+{
    // write out group topology info.
    gtopo.Save(out);
 
@@ -202,6 +202,10 @@ protected:
    /// Ensure that bdr_attributes and attributes agree across processors
    void DistributeAttributes(Array<int> &attr);
 
+   /** Write the group topology and the shared entities, i.e. the part of the
+       parallel mesh format following the serial mesh. */
+   void PrintSharedEntities(std::ostream &out) const;
+
 public:
    /** Copy constructor. Performs a deep copy of (almost) all data, so that the
        source mesh can be modified (e.g. deleted, refined) without affecting the
@@ -216,6 +220,24 @@ public:
    /** The @a refine parameter is passed to the method Mesh::Finalize(). */
    ParMesh(MPI_Comm comm, std::istream &input, bool refine = true);
 
+   /** @brief Scalable parallel reading of the serial mesh file @a filename,
+       without constructing the global mesh on any rank. */
+   /** Each rank reads a contiguous chunk of the file with MPI-IO, the
+       elements are partitioned in parallel along the Morton space-filling
+       curve of their centers, and each rank receives its elements and their
+       vertices. The shared entities are then identified by exchanging them
+       with the ranks which read their vertices, so the memory used on each
+       rank is proportional to the size of its part of the mesh.
+
+       Currently, only MFEM mesh v1.0 (and serial v1.2) files with vertex
+       coordinates are supported, i.e. conforming meshes without high-order
+       nodes; other files are rejected with an error. The attributes are local
+       lists, as in the constructor reading a parallel mesh. The @a refine
+       parameter is passed to the method Mesh::Finalize(). The returned mesh is
+       owned by the caller. */
+   static ParMesh *LoadParallel(MPI_Comm comm, const char *filename,
+                                bool refine = true);
+
    /// Create a uniformly refined (by any factor) version of @a orig_mesh.
    /** @param[in] orig_mesh  The starting coarse mesh.
        @param[in] ref_factor The refinement factor, an integer > 1.
@@ -362,6 +384,12 @@ public:
    /// Save the mesh in a parallel mesh format.
    void ParPrint(std::ostream &out) const;
 
+   /** @brief Save the mesh in the parallel mesh format, writing the serial
+       part in the binary format of Mesh::PrintBinary(). */
+   /** The result is read by the constructor ParMesh(MPI_Comm, std::istream &).
+       NURBS and AMR meshes are not supported. */
+   void ParPrintBinary(std::ostream &out) const;
+
    virtual int FindPoints(DenseMatrix& point_mat, Array<int>& elem_ids,
                           Array<IntegrationPoint>& ips, bool warn = true,
                           InverseElementTransformation *inv_trans = NULL);
@@ -0,0 +1,924 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+// Implementation of ParMesh::LoadParallel(), the scalable parallel reader of
+// serial mesh files.
+
+#include "../config/config.hpp"
+
+#ifdef MFEM_USE_MPI
+
+#include "mesh_headers.hpp"
+#include "../general/sets.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+using namespace std;
+
+namespace mfem
+{
+
+// The chunk of the file read by each rank is extended by this many bytes, to
+// complete the last line starting in the chunk.
+static const int max_line_length = 1 << 16;
+
+// A mesh entity (vertex, edge or face) given by its sorted global vertex
+// indices, padded with -1.
+struct EntityKey
+{
+   int v[4];
+
+   EntityKey() { }
+
+   EntityKey(const int *vert, int nv)
+   {
+      for (int i = 0; i < nv; i++) { v[i] = vert[i]; }
+      std::sort(v, v + nv);
+      for (int i = nv; i < 4; i++) { v[i] = -1; }
+   }
+
+   bool operator<(const EntityKey &other) const
+   { return std::lexicographical_compare(v, v + 4, other.v, other.v + 4); }
+
+   bool operator==(const EntityKey &other) const
+   { return std::equal(v, v + 4, other.v); }
+};
+
+// A shared face candidate: its key and its vertices in a canonical order which
+// is the same on all ranks.
+struct FaceEntity
+{
+   EntityKey key;
+   int nv, v[4];
+
+   bool operator<(const FaceEntity &other) const { return key < other.key; }
+   bool operator==(const FaceEntity &other) const { return key == other.key; }
+};
+
+// Send the entries of 'send', ordered by destination rank with 'send_cnt'
+// entries for each rank, and receive in 'recv' the entries from all ranks,
+// ordered by source rank with 'recv_cnt' entries from each rank.
+template <typename T>
+static void ExchangeData(MPI_Comm comm, const Array<int> &send_cnt,
+                         const Array<T> &send, Array<int> &recv_cnt,
+                         Array<T> &recv)
+{
+   const int nranks = send_cnt.Size();
+   recv_cnt.SetSize(nranks);
+   MPI_Alltoall(send_cnt.GetData(), 1, MPI_INT, recv_cnt.GetData(), 1, MPI_INT,
+                comm);
+
+   Array<int> send_off(nranks), recv_off(nranks);
+   int send_size = 0, recv_size = 0;
+   for (int r = 0; r < nranks; r++)
+   {
+      send_off[r] = send_size;
+      recv_off[r] = recv_size;
+      send_size += send_cnt[r];
+      recv_size += recv_cnt[r];
+   }
+   MFEM_ASSERT(send_size == send.Size(), "invalid send counts");
+   recv.SetSize(recv_size);
+   MPI_Alltoallv(send.GetData(), send_cnt.GetData(), send_off.GetData(),
+                 MPITypeMap<T>::mpi_type, recv.GetData(), recv_cnt.GetData(),
+                 recv_off.GetData(), MPITypeMap<T>::mpi_type, comm);
+}
+
+// Return the rank that read the global vertex 'gv' from the file, given the
+// ranges 'vert_offsets' of vertices read by each rank.
+static inline int VertexOwner(const Array<int> &vert_offsets, int gv)
+{
+   return std::upper_bound(vert_offsets.begin(), vert_offsets.end(), gv) -
+          vert_offsets.begin() - 1;
+}
+
+// Get the coordinates of the sorted global vertices 'gverts' from the ranks
+// that read them. The coordinates read by this rank are in 'my_coords'.
+static void FetchVertexCoordinates(MPI_Comm comm,
+                                   const Array<int> &vert_offsets, int sdim,
+                                   const Array<double> &my_coords,
+                                   const Array<int> &gverts,
+                                   Array<double> &coords)
+{
+   int nranks, myrank;
+   MPI_Comm_size(comm, &nranks);
+   MPI_Comm_rank(comm, &myrank);
+
+   // the sorted vertices are grouped by owner
+   Array<int> send_cnt(nranks), recv_cnt, requests;
+   send_cnt = 0;
+   for (int i = 0; i < gverts.Size(); i++)
+   {
+      send_cnt[VertexOwner(vert_offsets, gverts[i])]++;
+   }
+   ExchangeData(comm, send_cnt, gverts, recv_cnt, requests);
+
+   Array<double> reply(sdim*requests.Size());
+   for (int i = 0; i < requests.Size(); i++)
+   {
+      const int lv = requests[i] - vert_offsets[myrank];
+      for (int d = 0; d < sdim; d++)
+      {
+         reply[sdim*i + d] = my_coords[sdim*lv + d];
+      }
+   }
+   for (int r = 0; r < nranks; r++) { recv_cnt[r] *= sdim; }
+   ExchangeData(comm, recv_cnt, reply, send_cnt, coords);
+}
+
+// For each of the entities 'keys' registered by this rank, and each of the
+// entities 'queries', find the ranks that registered the entity. The keys of
+// an entity from all ranks meet on the rank that read its smallest vertex,
+// which returns the registered ranks. Only the first 'klen' vertices of the
+// keys are used. The sorted lists of ranks are returned in the rows of
+// 'key_ranks' and 'query_ranks'.
+static void FindEntityRanks(MPI_Comm comm, const Array<int> &vert_offsets,
+                            int klen, const vector<EntityKey> &keys,
+                            const vector<EntityKey> &queries,
+                            Table &key_ranks, Table &query_ranks)
+{
+   int nranks;
+   MPI_Comm_size(comm, &nranks);
+
+   const int nk = keys.size(), n = nk + queries.size(), stride = klen + 1;
+
+   // order the entries by the rank collecting them
+   Array<int> dest(n), send_cnt(nranks), order(n), offset(nranks + 1);
+   send_cnt = 0;
+   for (int i = 0; i < n; i++)
+   {
+      const EntityKey &key = (i < nk) ? keys[i] : queries[i - nk];
+      dest[i] = VertexOwner(vert_offsets, key.v[0]);
+      send_cnt[dest[i]]++;
+   }
+   offset[0] = 0;
+   for (int r = 0; r < nranks; r++) { offset[r+1] = offset[r] + send_cnt[r]; }
+   for (int i = 0; i < n; i++) { order[offset[dest[i]]++] = i; }
+
+   Array<int> send(stride*n), recv, recv_cnt;
+   for (int j = 0; j < n; j++)
+   {
+      const int i = order[j];
+      const EntityKey &key = (i < nk) ? keys[i] : queries[i - nk];
+      send[stride*j] = (i < nk); // registration or query
+      for (int k = 0; k < klen; k++) { send[stride*j + 1 + k] = key.v[k]; }
+   }
+   for (int r = 0; r < nranks; r++) { send_cnt[r] *= stride; }
+   ExchangeData(comm, send_cnt, send, recv_cnt, recv);
+
+   // sort the received entries by key, and by source rank for equal keys
+   const int nrecv = recv.Size()/stride;
+   Array<int> src(nrecv), sorted(nrecv);
+   for (int r = 0, j = 0; r < nranks; r++)
+   {
+      for (int k = 0; k < recv_cnt[r]/stride; k++) { src[j++] = r; }
+   }
+   for (int j = 0; j < nrecv; j++) { sorted[j] = j; }
+   std::sort(sorted.begin(), sorted.end(), [&](int a, int b)
+   {
+      const int *ka = &recv[stride*a + 1], *kb = &recv[stride*b + 1];
+      for (int k = 0; k < klen; k++)
+      {
+         if (ka[k] != kb[k]) { return ka[k] < kb[k]; }
+      }
+      return a < b;
+   });
+
+   // collect the registered ranks of each key, replying to every entry with
+   // the number of ranks followed by the ranks
+   Array<int> entry_run(nrecv), run_off, run_ranks;
+   run_off.Append(0);
+   for (int b = 0; b < nrecv; )
+   {
+      int e = b;
+      const int *kb = &recv[stride*sorted[b] + 1];
+      for ( ; e < nrecv; e++)
+      {
+         const int *ke = &recv[stride*sorted[e] + 1];
+         if (!std::equal(kb, kb + klen, ke)) { break; }
+         entry_run[sorted[e]] = run_off.Size() - 1;
+         if (recv[stride*sorted[e]]) { run_ranks.Append(src[sorted[e]]); }
+      }
+      run_off.Append(run_ranks.Size());
+      b = e;
+   }
+
+   Array<int> reply_cnt(nranks), reply;
+   reply_cnt = 0;
+   for (int j = 0; j < nrecv; j++)
+   {
+      const int run = entry_run[j];
+      reply_cnt[src[j]] += 1 + run_off[run+1] - run_off[run];
+      reply.Append(run_off[run+1] - run_off[run]);
+      reply.Append(run_ranks.GetData() + run_off[run],
+                   run_off[run+1] - run_off[run]);
+   }
+   Array<int> ranks, ranks_cnt;
+   ExchangeData(comm, reply_cnt, reply, ranks_cnt, ranks);
+
+   // the replies are in the order of the sent entries
+   Array<int> pos(n);
+   for (int j = 0, p = 0; j < n; j++)
+   {
+      pos[order[j]] = p;
+      p += 1 + ranks[p];
+   }
+   key_ranks.MakeI(nk);
+   query_ranks.MakeI(n - nk);
+   for (int i = 0; i < n; i++)
+   {
+      Table &t = (i < nk) ? key_ranks : query_ranks;
+      t.AddColumnsInRow((i < nk) ? i : i - nk, ranks[pos[i]]);
+   }
+   key_ranks.MakeJ();
+   query_ranks.MakeJ();
+   for (int i = 0; i < n; i++)
+   {
+      Table &t = (i < nk) ? key_ranks : query_ranks;
+      for (int k = 0; k < ranks[pos[i]]; k++)
+      {
+         t.AddConnection((i < nk) ? i : i - nk, ranks[pos[i] + 1 + k]);
+      }
+   }
+   key_ranks.ShiftUpI();
+   query_ranks.ShiftUpI();
+}
+
+// Parse the element "<attribute> <geometry> <vertices>" in 'line', with global
+// index 'index' in its section, and append (index, attribute, geometry,
+// vertices) to 'data'.
+static void ParseElement(const char *line, int index, int dim, int nv,
+                         Array<int> &data)
+{
+   char *end;
+   const int attr = strtol(line, &end, 10);
+   const int geom = strtol(end, &end, 10);
+   MFEM_VERIFY(geom >= 0 && geom < Geometry::NumGeom &&
+               Geometry::Dimension[geom] == dim,
+               "invalid element in line: " << line);
+   data.Append(index);
+   data.Append(attr);
+   data.Append(geom);
+   for (int i = 0; i < Geometry::NumVerts[geom]; i++)
+   {
+      const char *start = end;
+      const int v = strtol(start, &end, 10);
+      MFEM_VERIFY(end != start && v >= 0 && v < nv,
+                  "invalid element vertex in line: " << line);
+      data.Append(v);
+   }
+}
+
+// Order the vertices of a quadrilateral, given in cyclic order, so that the
+// smallest one is first, followed by the smaller of its two neighbors.
+static void CanonicalQuad(int *v)
+{
+   const int m = std::min_element(v, v + 4) - v;
+   const int next = v[(m+1)%4], prev = v[(m+3)%4];
+   int w[4];
+   for (int i = 0; i < 4; i++)
+   {
+      w[i] = (next < prev) ? v[(m+i)%4] : v[(m+4-i)%4];
+   }
+   for (int i = 0; i < 4; i++) { v[i] = w[i]; }
+}
+
+ParMesh *ParMesh::LoadParallel(MPI_Comm comm, const char *filename,
+                               bool refine)
+{
+   int nranks, myrank;
+   MPI_Comm_size(comm, &nranks);
+   MPI_Comm_rank(comm, &myrank);
+
+   // 1. Read the chunk [begin, end) of the file, extended to the end of its
+   //    last line, and split the lines starting in the chunk. The line ends
+   //    are replaced by '\0', and the empty and comment lines are dropped.
+   MPI_File fh;
+   const int err = MPI_File_open(comm, const_cast<char*>(filename),
+                                 MPI_MODE_RDONLY, MPI_INFO_NULL, &fh);
+   MFEM_VERIFY(err == MPI_SUCCESS, "cannot open the mesh file " << filename);
+   MPI_Offset file_size;
+   MPI_File_get_size(fh, &file_size);
+   const MPI_Offset begin = file_size*myrank/nranks;
+   const MPI_Offset end = file_size*(myrank + 1)/nranks;
+   const MPI_Offset read_begin = std::max(begin - 1, MPI_Offset(0));
+   const MPI_Offset read_end = std::min(end + max_line_length, file_size);
+   MFEM_VERIFY(read_end - read_begin < INT_MAX,
+               "the mesh file is too large for " << nranks << " ranks");
+   const int buf_size = read_end - read_begin;
+   vector<char> buf(buf_size + 1);
+   MPI_File_read_at_all(fh, read_begin, buf.data(), buf_size, MPI_CHAR,
+                        MPI_STATUS_IGNORE);
+   MPI_File_close(&fh);
+   buf[buf_size] = '\n';
+
+   vector<char*> lines;
+   {
+      int i = begin - read_begin;
+      const int i_end = end - read_begin;
+      if (begin > 0 && buf[i-1] != '\n')
+      {
+         // the line started in the chunk of the previous rank
+         while (buf[i] != '\n') { i++; }
+         i++;
+      }
+      while (i < i_end)
+      {
+         char *line = &buf[i];
+         char *eol = (char *) memchr(line, '\n', buf_size + 1 - i);
+         MFEM_VERIFY(eol - buf.data() < buf_size || read_end == file_size,
+                     "line too long in the mesh file " << filename);
+         i = eol - buf.data() + 1;
+         *eol = '\0';
+         while (*line == ' ' || *line == '\t') { line++; }
+         while (eol > line && isspace(eol[-1])) { *(--eol) = '\0'; }
+         if (*line != '\0' && *line != '#') { lines.push_back(line); }
+      }
+   }
+   const long long num_lines = lines.size();
+   long long first_line = 0, total_lines = 0;
+   MPI_Exscan(&num_lines, &first_line, 1, MPI_LONG_LONG, MPI_SUM, comm);
+   MPI_Allreduce(&num_lines, &total_lines, 1, MPI_LONG_LONG, MPI_SUM, comm);
+   if (myrank == 0) { first_line = 0; }
+
+   // 2. Find the (global) line numbers of the section keywords, and read the
+   //    section sizes in the lines following them.
+   const char *keywords[4] = { "dimension", "elements", "boundary", "vertices" };
+   long long kw[5] = { -1, -1, -1, -1, -1 };
+   for (int i = 0; i < num_lines; i++)
+   {
+      for (int k = 0; k < 4; k++)
+      {
+         if (!strcmp(lines[i], keywords[k])) { kw[k] = first_line + i; }
+      }
+   }
+   if (first_line == 0 && num_lines > 0)
+   {
+      kw[4] = !strcmp(lines[0], "MFEM mesh v1.0") ||
+              !strcmp(lines[0], "MFEM mesh v1.2");
+   }
+   MPI_Allreduce(MPI_IN_PLACE, kw, 5, MPI_LONG_LONG, MPI_MAX, comm);
+   MFEM_VERIFY(kw[4] == 1, "unsupported mesh format in " << filename
+               << ": ParMesh::LoadParallel() reads only the MFEM mesh v1.0"
+               " and v1.2 formats. Other formats (MFEM NC and NURBS meshes,"
+               " Gmsh, VTK, Netgen, Cubit, ...) can be read with the serial Mesh"
+               " constructor and then partitioned with the ParMesh"
+               " constructor.");
+   MFEM_VERIFY(kw[0] >= 0 && kw[0] < kw[1] && kw[1] < kw[2] && kw[2] < kw[3],
+               "invalid MFEM mesh file: " << filename);
+
+   // dimension, number of elements, boundary elements and vertices, space
+   // dimension
+   long long sizes[5] = { -1, -1, -1, -1, -1 };
+   const long long size_line[5] = { kw[0]+1, kw[1]+1, kw[2]+1, kw[3]+1, kw[3]+2 };
+   for (int k = 0; k < 5; k++)
+   {
+      const long long i = size_line[k] - first_line;
+      if (i >= 0 && i < num_lines)
+      {
+         char *eol;
+         sizes[k] = strtol(lines[i], &eol, 10);
+         if (eol == lines[i] || *eol != '\0') { sizes[k] = -1; }
+      }
+   }
+   MPI_Allreduce(MPI_IN_PLACE, sizes, 5, MPI_LONG_LONG, MPI_MAX, comm);
+   const int dim = sizes[0], ne = sizes[1], nbe = sizes[2], nv = sizes[3];
+   const int sdim = sizes[4];
+   MFEM_VERIFY(dim >= 1 && dim <= 3 && ne >= 0 && nbe >= 0 && nv >= 0,
+               "invalid MFEM mesh file: " << filename);
+   MFEM_VERIFY(sdim >= dim && sdim <= 3, "only meshes with vertex coordinates"
+               " (without 'nodes') are supported: " << filename);
+   MFEM_VERIFY(ne >= nranks, "the mesh has fewer elements than ranks");
+
+   const long long elem_line = kw[1] + 2, bdr_line = kw[2] + 2;
+   const long long vert_line = kw[3] + 3;
+   MFEM_VERIFY(elem_line + ne <= kw[2] && bdr_line + nbe <= kw[3] &&
+               vert_line + nv <= total_lines,
+               "invalid MFEM mesh file: " << filename);
+
+   // 3. Parse the elements, boundary elements and vertices in the local lines.
+   //    The vertices read by each rank are contiguous, their ranges are in
+   //    'vert_offsets'.
+   Array<int> elem_data, bdr_data;
+   Array<double> my_coords;
+   for (int i = 0; i < num_lines; i++)
+   {
+      const long long g = first_line + i;
+      if (g >= elem_line && g < elem_line + ne)
+      {
+         ParseElement(lines[i], g - elem_line, dim, nv, elem_data);
+      }
+      else if (g >= bdr_line && g < bdr_line + nbe)
+      {
+         ParseElement(lines[i], g - bdr_line, dim - 1, nv, bdr_data);
+      }
+      else if (g >= vert_line && g < vert_line + nv)
+      {
+         char *str = lines[i];
+         for (int d = 0; d < sdim; d++)
+         {
+            char *start = str;
+            my_coords.Append(strtod(start, &str));
+            MFEM_VERIFY(str != start, "invalid vertex in line: " << lines[i]);
+         }
+      }
+   }
+   lines.clear();
+   vector<char>().swap(buf);
+
+   Array<int> vert_offsets(nranks + 1);
+   {
+      const int my_nv = my_coords.Size()/sdim;
+      MPI_Allgather(&my_nv, 1, MPI_INT, vert_offsets.GetData() + 1, 1, MPI_INT,
+                    comm);
+      vert_offsets[0] = 0;
+      for (int r = 0; r < nranks; r++) { vert_offsets[r+1] += vert_offsets[r]; }
+   }
+
+   // 4. Partition the elements along the Morton curve of their centers: the
+   //    splitters between the ranks are found by a simultaneous bisection of
+   //    their keys, balancing the global number of elements on each side.
+   Array<int> target;
+   {
+      Array<int> gverts;
+      for (int p = 0; p < elem_data.Size(); )
+      {
+         const int nev = Geometry::NumVerts[elem_data[p+2]];
+         gverts.Append(elem_data.GetData() + p + 3, nev);
+         p += 3 + nev;
+      }
+      gverts.Sort();
+      gverts.Unique();
+      Array<double> coords;
+      FetchVertexCoordinates(comm, vert_offsets, sdim, my_coords, gverts,
+                             coords);
+
+      Array<double> centers;
+      double bb_min[3], bb_max[3];
+      for (int d = 0; d < 3; d++)
+      {
+         bb_min[d] = numeric_limits<double>::infinity();
+         bb_max[d] = -numeric_limits<double>::infinity();
+      }
+      for (int p = 0; p < elem_data.Size(); )
+      {
+         const int nev = Geometry::NumVerts[elem_data[p+2]];
+         double c[3] = { 0.0, 0.0, 0.0 };
+         for (int j = 0; j < nev; j++)
+         {
+            const int k = gverts.FindSorted(elem_data[p+3+j]);
+            for (int d = 0; d < sdim; d++) { c[d] += coords[sdim*k + d]/nev; }
+         }
+         for (int d = 0; d < 3; d++)
+         {
+            centers.Append(c[d]);
+            bb_min[d] = std::min(bb_min[d], c[d]);
+            bb_max[d] = std::max(bb_max[d], c[d]);
+         }
+         p += 3 + nev;
+      }
+      MPI_Allreduce(MPI_IN_PLACE, bb_min, 3, MPI_DOUBLE, MPI_MIN, comm);
+      MPI_Allreduce(MPI_IN_PLACE, bb_max, 3, MPI_DOUBLE, MPI_MAX, comm);
+
+      const int nle = centers.Size()/3;
+      vector<unsigned long long> keys(nle);
+      for (int i = 0; i < nle; i++)
+      {
+         unsigned x[3];
+         for (int d = 0; d < 3; d++)
+         {
+            const double ext = bb_max[d] - bb_min[d];
+            x[d] = (ext > 0.0) ? (unsigned)((centers[3*i+d] - bb_min[d])/ext*
+                                            ((1 << 21) - 1)) : 0;
+         }
+         keys[i] = MortonKey(x[0], x[1], x[2]);
+      }
+      vector<unsigned long long> sorted_keys(keys);
+      std::sort(sorted_keys.begin(), sorted_keys.end());
+
+      // the splitter i is the smallest key with at least (i+1)*ne/nranks
+      // smaller keys
+      const int nsplit = nranks - 1;
+      vector<unsigned long long> lo(nsplit, 0), hi(nsplit, 1ULL << 63);
+      vector<long long> count(nsplit);
+      bool done = (nsplit == 0);
+      while (!done)
+      {
+         for (int i = 0; i < nsplit; i++)
+         {
+            const unsigned long long mid = lo[i] + (hi[i] - lo[i])/2;
+            count[i] = std::lower_bound(sorted_keys.begin(), sorted_keys.end(),
+                                        mid) - sorted_keys.begin();
+         }
+         MPI_Allreduce(MPI_IN_PLACE, count.data(), nsplit, MPI_LONG_LONG,
+                       MPI_SUM, comm);
+         done = true;
+         for (int i = 0; i < nsplit; i++)
+         {
+            const unsigned long long mid = lo[i] + (hi[i] - lo[i])/2;
+            if (count[i] >= (long long)ne*(i + 1)/nranks) { hi[i] = mid; }
+            else { lo[i] = mid + 1; }
+            done = done && (lo[i] == hi[i]);
+         }
+      }
+      target.SetSize(nle);
+      for (int i = 0; i < nle; i++)
+      {
+         target[i] = std::upper_bound(lo.begin(), lo.end(), keys[i]) -
+                     lo.begin();
+      }
+   }
+
+   // 5. Send the elements to their ranks. The elements are received in the
+   //    order of the file.
+   Array<int> elems;
+   {
+      Array<int> send_cnt(nranks), offset(nranks + 1), send, recv_cnt;
+      send_cnt = 0;
+      for (int p = 0, i = 0; p < elem_data.Size(); i++)
+      {
+         const int size = 3 + Geometry::NumVerts[elem_data[p+2]];
+         send_cnt[target[i]] += size;
+         p += size;
+      }
+      offset[0] = 0;
+      for (int r = 0; r < nranks; r++) { offset[r+1] = offset[r] + send_cnt[r]; }
+      send.SetSize(elem_data.Size());
+      for (int p = 0, i = 0; p < elem_data.Size(); i++)
+      {
+         const int size = 3 + Geometry::NumVerts[elem_data[p+2]];
+         for (int k = 0; k < size; k++)
+         {
+            send[offset[target[i]]++] = elem_data[p+k];
+         }
+         p += size;
+      }
+      elem_data.DeleteAll();
+      ExchangeData(comm, send_cnt, send, recv_cnt, elems);
+   }
+
+   // local vertices, numbered in the global order
+   Array<int> lverts, elem_off;
+   for (int p = 0; p < elems.Size(); )
+   {
+      elem_off.Append(p);
+      const int nev = Geometry::NumVerts[elems[p+2]];
+      lverts.Append(elems.GetData() + p + 3, nev);
+      p += 3 + nev;
+   }
+   elem_off.Append(elems.Size());
+   lverts.Sort();
+   lverts.Unique();
+   Array<double> lcoords;
+   FetchVertexCoordinates(comm, vert_offsets, sdim, my_coords, lverts, lcoords);
+   my_coords.DeleteAll();
+
+   // one element of each geometry, giving the local edges and faces; the
+   // elements are owned by 'geom_mesh'
+   Mesh geom_mesh(dim, 0, Geometry::NumGeom);
+   const Element *geom_el[Geometry::NumGeom];
+   for (int g = 0; g < Geometry::NumGeom; g++) { geom_el[g] = NULL; }
+   for (int e = 0; e < elem_off.Size() - 1; e++)
+   {
+      const int geom = elems[elem_off[e]+2];
+      if (!geom_el[geom])
+      {
+         Element *el = geom_mesh.NewElement(geom);
+         geom_mesh.AddElement(el);
+         geom_el[geom] = el;
+      }
+   }
+
+   // 6. Find the ranks sharing the vertices, and the ranks holding the
+   //    smallest vertex of each boundary element.
+   Table vert_ranks, bdr_ranks;
+   {
+      vector<EntityKey> vkeys(lverts.Size()), bkeys;
+      for (int i = 0; i < lverts.Size(); i++)
+      {
+         vkeys[i] = EntityKey(&lverts[i], 1);
+      }
+      for (int p = 0; p < bdr_data.Size(); )
+      {
+         const int nbv = Geometry::NumVerts[bdr_data[p+2]];
+         const int *v = &bdr_data[p+3];
+         const int vmin = *std::min_element(v, v + nbv);
+         bkeys.push_back(EntityKey(&vmin, 1));
+         p += 3 + nbv;
+      }
+      FindEntityRanks(comm, vert_offsets, 1, vkeys, bkeys, vert_ranks,
+                      bdr_ranks);
+   }
+   Array<bool> vert_shared(lverts.Size());
+   for (int i = 0; i < lverts.Size(); i++)
+   {
+      vert_shared[i] = (vert_ranks.RowSize(i) > 1);
+   }
+
+   // 7. Find the ranks sharing the edges and faces with shared vertices.
+   vector<EntityKey> edges;
+   vector<FaceEntity> faces;
+   Table edge_ranks, face_ranks;
+   for (int e = 0; e < elem_off.Size() - 1; e++)
+   {
+      const int *v = &elems[elem_off[e]+3];
+      const Element *el = geom_el[elems[elem_off[e]+2]];
+      for (int i = 0; i < el->GetNEdges() && dim >= 2; i++)
+      {
+         const int *ev = el->GetEdgeVertices(i);
+         const int ge[2] = { v[ev[0]], v[ev[1]] };
+         if (vert_shared[lverts.FindSorted(ge[0])] &&
+             vert_shared[lverts.FindSorted(ge[1])])
+         {
+            edges.push_back(EntityKey(ge, 2));
+         }
+      }
+      for (int i = 0; i < el->GetNFaces() && dim == 3; i++)
+      {
+         const int *fv = el->GetFaceVertices(i);
+         FaceEntity f;
+         f.nv = el->GetNFaceVertices(i);
+         bool shared = true;
+         for (int j = 0; j < f.nv; j++)
+         {
+            f.v[j] = v[fv[j]];
+            shared = shared && vert_shared[lverts.FindSorted(f.v[j])];
+         }
+         if (!shared) { continue; }
+         f.key = EntityKey(f.v, f.nv);
+         if (f.nv == 3) { std::sort(f.v, f.v + 3); }
+         else { CanonicalQuad(f.v); }
+         faces.push_back(f);
+      }
+   }
+   std::sort(edges.begin(), edges.end());
+   edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+   std::sort(faces.begin(), faces.end());
+   faces.erase(std::unique(faces.begin(), faces.end()), faces.end());
+   {
+      Table no_ranks;
+      vector<EntityKey> no_queries, fkeys(faces.size());
+      for (size_t i = 0; i < faces.size(); i++) { fkeys[i] = faces[i].key; }
+      FindEntityRanks(comm, vert_offsets, 2, edges, no_queries, edge_ranks,
+                      no_ranks);
+      FindEntityRanks(comm, vert_offsets, 4, fkeys, no_queries, face_ranks,
+                      no_ranks);
+   }
+
+   // 8. Send the boundary elements to the ranks holding their smallest vertex,
+   //    and keep the ones that are faces of the local elements. Faces shared
+   //    between ranks (internal boundaries) are kept by the lowest rank.
+   Array<int> bdr;
+   {
+      Array<int> send_cnt(nranks), offset(nranks + 1), send, recv_cnt, recv;
+      send_cnt = 0;
+      for (int p = 0, i = 0; p < bdr_data.Size(); i++)
+      {
+         const int size = 3 + Geometry::NumVerts[bdr_data[p+2]];
+         for (int k = 0; k < bdr_ranks.RowSize(i); k++)
+         {
+            send_cnt[bdr_ranks.GetRow(i)[k]] += size;
+         }
+         p += size;
+      }
+      offset[0] = 0;
+      for (int r = 0; r < nranks; r++) { offset[r+1] = offset[r] + send_cnt[r]; }
+      send.SetSize(offset[nranks]);
+      for (int p = 0, i = 0; p < bdr_data.Size(); i++)
+      {
+         const int size = 3 + Geometry::NumVerts[bdr_data[p+2]];
+         for (int k = 0; k < bdr_ranks.RowSize(i); k++)
+         {
+            const int r = bdr_ranks.GetRow(i)[k];
+            for (int j = 0; j < size; j++) { send[offset[r]++] = bdr_data[p+j]; }
+         }
+         p += size;
+      }
+      bdr_data.DeleteAll();
+      ExchangeData(comm, send_cnt, send, recv_cnt, recv);
+
+      // the faces of the local elements
+      vector<EntityKey> elem_faces;
+      for (int e = 0; e < elem_off.Size() - 1; e++)
+      {
+         const int *v = &elems[elem_off[e]+3];
+         const Element *el = geom_el[elems[elem_off[e]+2]];
+         const int nf = (dim == 3) ? el->GetNFaces() :
+                        (dim == 2) ? el->GetNEdges() : el->GetNVertices();
+         for (int i = 0; i < nf; i++)
+         {
+            int fv[4], nfv;
+            if (dim == 3)
+            {
+               nfv = el->GetNFaceVertices(i);
+               for (int j = 0; j < nfv; j++) { fv[j] = v[el->GetFaceVertices(i)[j]]; }
+            }
+            else if (dim == 2)
+            {
+               nfv = 2;
+               for (int j = 0; j < 2; j++) { fv[j] = v[el->GetEdgeVertices(i)[j]]; }
+            }
+            else
+            {
+               nfv = 1;
+               fv[0] = v[i];
+            }
+            elem_faces.push_back(EntityKey(fv, nfv));
+         }
+      }
+      std::sort(elem_faces.begin(), elem_faces.end());
+
+      for (int p = 0; p < recv.Size(); )
+      {
+         const int size = 3 + Geometry::NumVerts[recv[p+2]];
+         const EntityKey key(&recv[p+3], size - 3);
+         bool keep = std::binary_search(elem_faces.begin(), elem_faces.end(),
+                                        key);
+         // ranks sharing the face
+         const int *ranks = NULL;
+         int nranks_face = 0;
+         if (keep && dim == 3)
+         {
+            FaceEntity f;
+            f.key = key;
+            vector<FaceEntity>::iterator it =
+               std::lower_bound(faces.begin(), faces.end(), f);
+            if (it != faces.end() && it->key == key)
+            {
+               ranks = face_ranks.GetRow(it - faces.begin());
+               nranks_face = face_ranks.RowSize(it - faces.begin());
+            }
+         }
+         else if (keep && dim == 2)
+         {
+            vector<EntityKey>::iterator it =
+               std::lower_bound(edges.begin(), edges.end(), key);
+            if (it != edges.end() && *it == key)
+            {
+               ranks = edge_ranks.GetRow(it - edges.begin());
+               nranks_face = edge_ranks.RowSize(it - edges.begin());
+            }
+         }
+         else if (keep)
+         {
+            const int lv = lverts.FindSorted(key.v[0]);
+            ranks = vert_ranks.GetRow(lv);
+            nranks_face = vert_ranks.RowSize(lv);
+         }
+         if (keep && nranks_face > 1) { keep = (ranks[0] == myrank); }
+         if (keep) { bdr.Append(recv.GetData() + p, size); }
+         p += size;
+      }
+   }
+
+   // 9. Write the local part of the mesh in the parallel MFEM format, see
+   //    ParPrint(), with the shared entities of each group ordered by their
+   //    global vertices, and construct the ParMesh from it.
+   ostringstream out;
+   out.precision(numeric_limits<double>::max_digits10);
+   out << "MFEM mesh v1.2\n\ndimension\n" << dim << "\n\nelements\n"
+       << elem_off.Size() - 1 << '\n';
+   for (int e = 0; e < elem_off.Size() - 1; e++)
+   {
+      const int *el = &elems[elem_off[e]];
+      out << el[1] << ' ' << el[2];
+      for (int j = 0; j < Geometry::NumVerts[el[2]]; j++)
+      {
+         out << ' ' << lverts.FindSorted(el[3+j]);
+      }
+      out << '\n';
+   }
+   int nlbe = 0;
+   for (int p = 0; p < bdr.Size(); nlbe++)
+   {
+      p += 3 + Geometry::NumVerts[bdr[p+2]];
+   }
+   out << "\nboundary\n" << nlbe << '\n';
+   for (int p = 0; p < bdr.Size(); )
+   {
+      out << bdr[p+1] << ' ' << bdr[p+2];
+      for (int j = 0; j < Geometry::NumVerts[bdr[p+2]]; j++)
+      {
+         out << ' ' << lverts.FindSorted(bdr[p+3+j]);
+      }
+      out << '\n';
+      p += 3 + Geometry::NumVerts[bdr[p+2]];
+   }
+   out << "\nvertices\n" << lverts.Size() << '\n' << sdim << '\n';
+   for (int i = 0; i < lverts.Size(); i++)
+   {
+      out << lcoords[sdim*i];
+      for (int d = 1; d < sdim; d++) { out << ' ' << lcoords[sdim*i + d]; }
+      out << '\n';
+   }
+   out << "mfem_serial_mesh_end\n";
+
+   ListOfIntegerSets groups;
+   IntegerSet group;
+   group.Recreate(1, &myrank);
+   groups.Insert(group);
+   vector<vector<int> > group_verts(1), group_edges(1), group_faces(1);
+   for (int i = 0; i < lverts.Size(); i++)
+   {
+      if (vert_ranks.RowSize(i) < 2) { continue; }
+      group.Recreate(vert_ranks.RowSize(i), vert_ranks.GetRow(i));
+      const int g = groups.Insert(group);
+      group_verts.resize(groups.Size());
+      group_verts[g].push_back(i);
+   }
+   for (size_t i = 0; i < edges.size(); i++)
+   {
+      if (edge_ranks.RowSize(i) < 2) { continue; }
+      group.Recreate(edge_ranks.RowSize(i), edge_ranks.GetRow(i));
+      const int g = groups.Insert(group);
+      group_edges.resize(groups.Size());
+      group_edges[g].push_back(i);
+   }
+   for (size_t i = 0; i < faces.size(); i++)
+   {
+      if (face_ranks.RowSize(i) < 2) { continue; }
+      group.Recreate(face_ranks.RowSize(i), face_ranks.GetRow(i));
+      const int g = groups.Insert(group);
+      group_faces.resize(groups.Size());
+      group_faces[g].push_back(i);
+   }
+   const int ngroups = groups.Size();
+   group_verts.resize(ngroups);
+   group_edges.resize(ngroups);
+   group_faces.resize(ngroups);
+
+   Table group_ranks;
+   groups.AsTable(group_ranks);
+   out << "\ncommunication_groups\nnumber_of_groups " << ngroups << "\n\n";
+   int nsv = 0, nse = 0, nsf = 0;
+   for (int g = 0; g < ngroups; g++)
+   {
+      out << group_ranks.RowSize(g);
+      for (int k = 0; k < group_ranks.RowSize(g); k++)
+      {
+         out << ' ' << group_ranks.GetRow(g)[k];
+      }
+      out << '\n';
+      nsv += group_verts[g].size();
+      nse += group_edges[g].size();
+      nsf += group_faces[g].size();
+   }
+   out << "\ntotal_shared_vertices " << nsv << '\n';
+   if (dim >= 2) { out << "total_shared_edges " << nse << '\n'; }
+   if (dim >= 3) { out << "total_shared_faces " << nsf << '\n'; }
+   for (int g = 1; g < ngroups; g++)
+   {
+      out << "\nshared_vertices " << group_verts[g].size() << '\n';
+      for (size_t i = 0; i < group_verts[g].size(); i++)
+      {
+         out << group_verts[g][i] << '\n';
+      }
+      if (dim >= 2)
+      {
+         out << "\nshared_edges " << group_edges[g].size() << '\n';
+         for (size_t i = 0; i < group_edges[g].size(); i++)
+         {
+            const int *v = edges[group_edges[g][i]].v;
+            out << lverts.FindSorted(v[0]) << ' ' << lverts.FindSorted(v[1])
+                << '\n';
+         }
+      }
+      if (dim >= 3)
+      {
+         out << "\nshared_faces " << group_faces[g].size() << '\n';
+         for (size_t i = 0; i < group_faces[g].size(); i++)
+         {
+            const FaceEntity &f = faces[group_faces[g][i]];
+            out << ((f.nv == 3) ? Geometry::TRIANGLE : Geometry::SQUARE);
+            for (int j = 0; j < f.nv; j++)
+            {
+               out << ' ' << lverts.FindSorted(f.v[j]);
+            }
+            out << '\n';
+         }
+      }
+   }
+   out << "\nmfem_mesh_end\n";
+
+   istringstream in(out.str());
+   return new ParMesh(comm, in, refine);
+}
+
+} // namespace mfem
+
+#endif // MFEM_USE_MPI
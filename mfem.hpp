@@ -32,6 +32,7 @@
 #include "general/socketstream.hpp"
 #include "general/optparser.hpp"
 #include "general/zstr.hpp"
+#include "general/binaryio.hpp"
 #include "general/version.hpp"
 #include "general/globals.hpp"
 #ifdef MFEM_USE_MPI
@@ -0,0 +1,122 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace amg
+{
+
+TEST_CASE("AMG Aggregation", "[AMG]")
+{
+   // 1D Laplacian: every unknown is strongly connected to its neighbors
+   const int n = 30;
+   SparseMatrix A(n);
+   for (int i = 0; i < n; i++)
+   {
+      A.Add(i, i, 2.0);
+      if (i > 0) { A.Add(i, i-1, -1.0); }
+      if (i < n-1) { A.Add(i, i+1, -1.0); }
+   }
+   A.Finalize();
+
+   Array<int> aggregates;
+   const int num_agg = SmoothedAggregationAMG::Aggregate(A, 0.08, aggregates);
+   REQUIRE(num_agg == n/3);
+   Array<int> agg_size(num_agg);
+   agg_size = 0;
+   for (int i = 0; i < n; i++)
+   {
+      REQUIRE(aggregates[i] >= 0);
+      REQUIRE(aggregates[i] < num_agg);
+      agg_size[aggregates[i]]++;
+   }
+   for (int k = 0; k < num_agg; k++)
+   {
+      REQUIRE(agg_size[k] >= 2);
+      REQUIRE(agg_size[k] <= 4);
+   }
+
+   // Unknowns without strong connections are not aggregated
+   SparseMatrix D(n);
+   for (int i = 0; i < n; i++) { D.Add(i, i, 1.0); }
+   D.Finalize();
+   REQUIRE(SmoothedAggregationAMG::Aggregate(D, 0.08, aggregates) == 0);
+   for (int i = 0; i < n; i++) { REQUIRE(aggregates[i] == -1); }
+}
+
+static int test_amg_pcg(Mesh &mesh, int order,
+                        SmoothedAggregationAMG::SmootherType smoother,
+                        Multigrid::CycleType cycle)
+{
+   H1_FECollection fec(order, mesh.Dimension());
+   FiniteElementSpace fes(&mesh, &fec);
+
+   Array<int> ess_tdof_list, ess_bdr(mesh.bdr_attributes.Max());
+   ess_bdr = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+
+   ConstantCoefficient one(1.0);
+   LinearForm b(&fes);
+   b.AddDomainIntegrator(new DomainLFIntegrator(one));
+   b.Assemble();
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new DiffusionIntegrator(one));
+   a.Assemble();
+
+   GridFunction x(&fes);
+   x = 0.0;
+   SparseMatrix A;
+   Vector B, X;
+   a.FormLinearSystem(ess_tdof_list, x, b, A, X, B);
+
+   SmoothedAggregationAMG amg;
+   amg.SetSmoother(smoother);
+   amg.SetCycleType(cycle, 1, 1);
+   amg.SetMaxCoarseSize(50);
+   amg.SetOperator(A);
+   REQUIRE(amg.NumLevels() > 1);
+
+   CGSolver cg;
+   cg.SetRelTol(1e-8);
+   cg.SetMaxIter(200);
+   cg.SetPrintLevel(-1);
+   cg.SetPreconditioner(amg);
+   cg.SetOperator(A);
+   cg.Mult(B, X);
+   REQUIRE(cg.GetConverged());
+
+   Vector r(B);
+   A.AddMult(X, r, -1.0);
+   REQUIRE(r.Norml2() < 1e-6 * B.Norml2());
+   return cg.GetNumIterations();
+}
+
+TEST_CASE("AMG Preconditioned CG", "[AMG]")
+{
+   using SmootherType = SmoothedAggregationAMG::SmootherType;
+   using CycleType = Multigrid::CycleType;
+   Mesh mesh_2d(16, 16, Element::QUADRILATERAL, true);
+   Mesh mesh_3d(6, 6, 6, Element::HEXAHEDRON, true);
+   for (SmootherType smoother : {SmootherType::JACOBI, SmootherType::CHEBYSHEV})
+   {
+      for (CycleType cycle : {CycleType::VCYCLE, CycleType::WCYCLE})
+      {
+         REQUIRE(test_amg_pcg(mesh_2d, 1, smoother, cycle) < 30);
+         REQUIRE(test_amg_pcg(mesh_2d, 2, smoother, cycle) < 40);
+         REQUIRE(test_amg_pcg(mesh_3d, 1, smoother, cycle) < 30);
+      }
+   }
+}
+
+} // namespace amg
@@ -65,3 +65,73 @@ TEST_CASE("Test order of boundary integrators",
       delete D;
    }
 }
+
+TEST_CASE("Threaded assembly with element coloring",
+          "[BilinearForm]")
+{
+   const char *mesh_files[] = { "../../data/star-mixed.mesh",
+                                "../../data/fichera.mesh"
+                              };
+   for (const char *mesh_file : mesh_files)
+   {
+      Mesh mesh(mesh_file, 1, 1);
+      const int dim = mesh.Dimension();
+      for (int vdim = 1; vdim <= dim; vdim += dim-1)
+      {
+         H1_FECollection fec(2, dim);
+         FiniteElementSpace fes(&mesh, &fec, vdim);
+
+         ConstantCoefficient one(1.0);
+         BilinearForm a_ref(&fes), a_thr(&fes), a_sz2(&fes);
+         a_thr.EnableThreadedAssembly();
+         a_sz2.EnableThreadedAssembly();
+         for (BilinearForm *a : { &a_ref, &a_thr, &a_sz2 })
+         {
+            if (vdim == 1)
+            {
+               a->AddDomainIntegrator(new DiffusionIntegrator(one));
+               a->AddDomainIntegrator(new MassIntegrator(one));
+               a->AddBoundaryIntegrator(new MassIntegrator(one));
+            }
+            else
+            {
+               a->AddDomainIntegrator(new ElasticityIntegrator(one, one));
+               a->AddBoundaryIntegrator(new VectorMassIntegrator(one));
+            }
+            // skip_zeros = 2 is not supported by the threaded assembly
+            const int skip_zeros = (a == &a_sz2) ? 2 : 0;
+            a->Assemble(skip_zeros);
+            a->Finalize(skip_zeros);
+         }
+         REQUIRE(a_sz2.GetElementColoring() == NULL);
+
+         // Elements of the same color must not share any dofs
+         const Table *colors = a_thr.GetElementColoring();
+         REQUIRE(colors != NULL);
+         Array<int> dof_color(fes.GetNDofs()), dofs;
+         dof_color = -1;
+         bool valid = true;
+         for (int c = 0; c < colors->Size(); c++)
+         {
+            for (int k = 0; k < colors->RowSize(c); k++)
+            {
+               fes.GetElementDofs(colors->GetRow(c)[k], dofs);
+               for (int j = 0; j < dofs.Size(); j++)
+               {
+                  const int d = dofs[j] >= 0 ? dofs[j] : -1-dofs[j];
+                  if (dof_color[d] == c) { valid = false; }
+                  dof_color[d] = c;
+               }
+            }
+         }
+         REQUIRE(valid);
+
+         SparseMatrix *D = Add(1.0, a_ref.SpMat(), -1.0, a_thr.SpMat());
+         REQUIRE(D->MaxNorm() < 1e-12*a_ref.SpMat().MaxNorm());
+         delete D;
+         D = Add(1.0, a_ref.SpMat(), -1.0, a_sz2.SpMat());
+         REQUIRE(D->MaxNorm() < 1e-12*a_ref.SpMat().MaxNorm());
+         delete D;
+      }
+   }
+}
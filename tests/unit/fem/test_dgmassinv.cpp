@@ -0,0 +1,109 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace dgmassinv
+{
+
+static double coeff(const Vector &x)
+{
+   return 1.0 + x(0)*x(0) + 0.5*x(1);
+}
+
+static void curve(const Vector &x, Vector &y)
+{
+   y = x;
+   y(0) += 0.05*sin(M_PI*x(1));
+   y(1) += 0.05*sin(M_PI*x(0));
+}
+
+// Check that M (M^{-1} b) = b for the mass matrix M assembled with the same
+// coefficient and integration rule
+static void TestDGMassInverse(Mesh &mesh, int order, int vdim, bool tensor)
+{
+   L2_FECollection fec(order, mesh.Dimension(), BasisType::GaussLobatto);
+   FiniteElementSpace fes(&mesh, &fec, vdim);
+   FunctionCoefficient Q(coeff);
+   const Geometry::Type geom = mesh.GetElementBaseGeometry(0);
+   const IntegrationRule *ir =
+      tensor ? &IntRules.Get(geom, 2*order + 1) : NULL;
+
+   DGMassInverse Minv(fes, &Q, ir);
+   REQUIRE(Minv.UsesSumFactorization() == tensor);
+
+   BilinearForm m(&fes);
+   if (vdim == 1)
+   {
+      m.AddDomainIntegrator(new MassIntegrator(Q, ir));
+   }
+   else
+   {
+      VectorMassIntegrator *vmass = new VectorMassIntegrator(Q);
+      vmass->SetIntRule(ir);
+      m.AddDomainIntegrator(vmass);
+   }
+   m.Assemble();
+   m.Finalize();
+
+   Vector b(fes.GetVSize()), x(fes.GetVSize()), r(fes.GetVSize());
+   b.Randomize(1);
+   Minv.Mult(b, x);
+   m.Mult(x, r);
+   r -= b;
+   REQUIRE(r.Normlinf() < 1e-10*b.Normlinf());
+}
+
+TEST_CASE("DG Mass Inverse", "[DGMassInverse]")
+{
+   SECTION("Quadrilaterals")
+   {
+      Mesh mesh(3, 3, Element::QUADRILATERAL, true);
+      mesh.SetCurvature(2);
+      mesh.Transform(curve);
+      for (int order = 0; order <= 3; order++)
+      {
+         for (int vdim = 1; vdim <= 2; vdim++)
+         {
+            TestDGMassInverse(mesh, order, vdim, false);
+            if (order > 0) { TestDGMassInverse(mesh, order, vdim, true); }
+         }
+      }
+   }
+
+   SECTION("Triangles")
+   {
+      Mesh mesh(3, 3, Element::TRIANGLE, true);
+      for (int order = 0; order <= 3; order++)
+      {
+         TestDGMassInverse(mesh, order, 1, false);
+         TestDGMassInverse(mesh, order, 2, false);
+      }
+   }
+
+   SECTION("Hexahedra")
+   {
+      Mesh mesh(2, 2, 2, Element::HEXAHEDRON, true);
+      mesh.SetCurvature(2);
+      mesh.Transform(curve);
+      for (int order = 1; order <= 2; order++)
+      {
+         TestDGMassInverse(mesh, order, 1, false);
+         TestDGMassInverse(mesh, order, 1, true);
+         TestDGMassInverse(mesh, order, 3, true);
+      }
+   }
+}
+
+} // namespace dgmassinv
@@ -64,24 +64,25 @@ void test_ea(Mesh &&mesh, int order, bool dg, const int pb)
 
    BilinearForm k_ea(&fespace);
    BilinearForm k_fa(&fespace);
+   BilinearForm k_dfa(&fespace);
 
    ConstantCoefficient one(1.0);
    VectorFunctionCoefficient vel_coeff(dim, velocity_function);
 
-   if (pb==0) // Mass
+   for (BilinearForm *k : {&k_fa, &k_ea, &k_dfa})
    {
-      k_fa.AddDomainIntegrator(new MassIntegrator(one));
-      k_ea.AddDomainIntegrator(new MassIntegrator(one));
-   }
-   else if (pb==1) // Convection
-   {
-      AddConvectionIntegrators(k_fa, vel_coeff, dg);
-      AddConvectionIntegrators(k_ea, vel_coeff, dg);
-   }
-   else if (pb==2) // Diffusion
-   {
-      k_fa.AddDomainIntegrator(new DiffusionIntegrator(one));
-      k_ea.AddDomainIntegrator(new DiffusionIntegrator(one));
+      if (pb==0) // Mass
+      {
+         k->AddDomainIntegrator(new MassIntegrator(one));
+      }
+      else if (pb==1) // Convection
+      {
+         AddConvectionIntegrators(*k, vel_coeff, dg);
+      }
+      else if (pb==2) // Diffusion
+      {
+         k->AddDomainIntegrator(new DiffusionIntegrator(one));
+      }
    }
 
    k_fa.Assemble();
@@ -101,6 +102,21 @@ void test_ea(Mesh &&mesh, int order, bool dg, const int pb)
 
    REQUIRE(y_ea.Norml2() < 1.e-12);
 
+   // The device full assembly is used on conforming meshes, the original
+   // full assembly otherwise.
+   k_dfa.UseFastAssembly(true);
+   REQUIRE(k_dfa.SupportsFastAssembly() == fespace.Conforming());
+   for (int it = 0; it < 2; it++) // the second pass reuses the sparsity
+   {
+      if (it > 0) { k_dfa = 0.0; }
+      k_dfa.Assemble();
+      k_dfa.Finalize();
+
+      SparseMatrix *D = Add(1.0, k_fa.SpMat(), -1.0, k_dfa.SpMat());
+      REQUIRE(D->MaxNorm() < 1.e-12);
+      delete D;
+   }
+
    delete fec;
 }
 
@@ -145,4 +161,139 @@ TEST_CASE("Element Assembly", "[ElementAssembly]")
    }
 }//test case
 
+TEST_CASE("Device Full Assembly Fallback", "[ElementAssembly]")
+{
+   Mesh mesh(4, 4, Element::QUADRILATERAL);
+   const int dim = mesh.Dimension();
+   H1_FECollection fec(2, dim);
+   FiniteElementSpace fes(&mesh, &fec);
+   FiniteElementSpace vfes(&mesh, &fec, dim);
+   ConstantCoefficient one(1.0);
+
+   // Forms that the device full assembly does not support are assembled with
+   // the original implementation when UseFastAssembly() is enabled.
+   for (int t = 0; t < 3; t++)
+   {
+      FiniteElementSpace *space = (t == 1) ? &vfes : &fes;
+      BilinearForm a(space), a_dfa(space);
+      for (BilinearForm *k : {&a, &a_dfa})
+      {
+         if (t == 0)
+         {
+            k->AddDomainIntegrator(new MassIntegrator(one));
+            k->AddBoundaryIntegrator(new BoundaryMassIntegrator(one));
+         }
+         else if (t == 1)
+         {
+            k->AddDomainIntegrator(new ElasticityIntegrator(one, one));
+         }
+         else
+         {
+            k->AddDomainIntegrator(new DiffusionIntegrator(one));
+            k->AddDomainIntegrator(new LumpedIntegrator(new MassIntegrator));
+         }
+      }
+      a_dfa.UseFastAssembly(true);
+      REQUIRE(!a_dfa.SupportsFastAssembly());
+
+      a.Assemble();
+      a.Finalize();
+      a_dfa.Assemble();
+      a_dfa.Finalize();
+
+      SparseMatrix *D = Add(1.0, a.SpMat(), -1.0, a_dfa.SpMat());
+      REQUIRE(D->MaxNorm() < 1.e-12);
+      delete D;
+   }
+}
+
+#ifdef MFEM_USE_MPI
+
+TEST_CASE("Parallel Device Full Assembly", "[Parallel], [ElementAssembly]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      Mesh *mesh = (dim == 2) ?
+                   new Mesh("../../data/star-q3.mesh", 1, 1) :
+                   new Mesh("../../data/fichera-q3.mesh", 1, 1);
+      ParMesh pmesh(MPI_COMM_WORLD, *mesh);
+      delete mesh;
+
+      H1_FECollection fec(2, dim);
+      ParFiniteElementSpace fes(&pmesh, &fec);
+      ConstantCoefficient one(1.0);
+
+      // The same form with the device and the original full assembly
+      ParBilinearForm a_dfa(&fes), a_ref(&fes);
+      for (ParBilinearForm *a : {&a_dfa, &a_ref})
+      {
+         a->AddDomainIntegrator(new MassIntegrator(one));
+         a->AddDomainIntegrator(new DiffusionIntegrator(one));
+      }
+      a_dfa.UseFastAssembly(true);
+      REQUIRE(a_dfa.SupportsFastAssembly());
+      a_dfa.Assemble();
+      a_ref.Assemble();
+
+      // A*x on the true dofs
+      Array<int> no_ess;
+      OperatorHandle A_dfa, A_ref;
+      a_dfa.FormSystemMatrix(no_ess, A_dfa);
+      a_ref.FormSystemMatrix(no_ess, A_ref);
+      REQUIRE(A_dfa.Type() == Operator::Hypre_ParCSR);
+      Vector x(fes.GetTrueVSize()), y_dfa(x.Size()), y_ref(x.Size());
+      x.Randomize(1);
+      A_dfa->Mult(x, y_dfa);
+      A_ref->Mult(x, y_ref);
+      y_dfa -= y_ref;
+      const double y_max = GlobalLpNorm(infinity(), y_ref.Normlinf(),
+                                        MPI_COMM_WORLD);
+      REQUIRE(GlobalLpNorm(infinity(), y_dfa.Normlinf(), MPI_COMM_WORLD) <
+              1.e-12 * std::max(1.0, y_max));
+
+      // Solve with essential boundary conditions, after re-assembling
+      Array<int> ess_tdof_list, ess_bdr(pmesh.bdr_attributes.Max());
+      ess_bdr = 1;
+      fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+      ParLinearForm b(&fes);
+      b.AddDomainIntegrator(new DomainLFIntegrator(one));
+      b.Assemble();
+
+      ParGridFunction x_dfa(&fes), x_ref(&fes);
+      x_dfa = 0.0;
+      x_ref = 0.0;
+      OperatorHandle S_dfa, S_ref;
+      Vector X_dfa, X_ref, B_dfa, B_ref;
+      for (ParBilinearForm *a : {&a_dfa, &a_ref})
+      {
+         a->Update();
+         a->Assemble();
+      }
+      a_dfa.FormLinearSystem(ess_tdof_list, x_dfa, b, S_dfa, X_dfa, B_dfa);
+      a_ref.FormLinearSystem(ess_tdof_list, x_ref, b, S_ref, X_ref, B_ref);
+      REQUIRE(X_dfa.Size() == fes.GetTrueVSize());
+
+      CGSolver cg(MPI_COMM_WORLD);
+      cg.SetRelTol(1e-12);
+      cg.SetAbsTol(0.0);
+      cg.SetMaxIter(500);
+      cg.SetOperator(*S_dfa);
+      cg.Mult(B_dfa, X_dfa);
+      REQUIRE(cg.GetConverged());
+      cg.SetOperator(*S_ref);
+      cg.Mult(B_ref, X_ref);
+      REQUIRE(cg.GetConverged());
+      a_dfa.RecoverFEMSolution(X_dfa, b, x_dfa);
+      a_ref.RecoverFEMSolution(X_ref, b, x_ref);
+
+      x_dfa -= x_ref;
+      const double x_max = GlobalLpNorm(infinity(), x_ref.Normlinf(),
+                                        MPI_COMM_WORLD);
+      REQUIRE(GlobalLpNorm(infinity(), x_dfa.Normlinf(), MPI_COMM_WORLD) <
+              1.e-8 * x_max);
+   }
+}
+
+#endif
+
 }// namespace pa_kernels
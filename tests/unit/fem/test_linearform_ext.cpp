@@ -0,0 +1,177 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace linearform_ext
+{
+
+static double f_scalar(const Vector &x)
+{
+   double s = 1.0;
+   for (int d = 0; d < x.Size(); d++) { s += sin(M_PI*(d+1)*x(d)); }
+   return s;
+}
+
+static void f_vector(const Vector &x, Vector &v)
+{
+   for (int d = 0; d < v.Size(); d++) { v(d) = f_scalar(x) + d; }
+}
+
+// Compare the device assembly of a LinearForm with the legacy one
+static void test_linearform_ext(Mesh &mesh, int order, int vdim, bool bdr)
+{
+   const int dim = mesh.Dimension();
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(&mesh, &fec, vdim);
+
+   FunctionCoefficient f(f_scalar);
+   ConstantCoefficient c(2.5);
+   VectorFunctionCoefficient vf(vdim, f_vector);
+   Vector cv(vdim);
+   cv.Randomize(1);
+   VectorConstantCoefficient vc(cv);
+
+   // GridFunction coefficients use the batched evaluation
+   FiniteElementSpace sfes(&mesh, &fec);
+   GridFunction gf(&sfes), vgf(&fes);
+   gf.ProjectCoefficient(f);
+   vgf.ProjectCoefficient(vf);
+   GridFunctionCoefficient gfc(&gf);
+   VectorGridFunctionCoefficient vgfc(&vgf);
+   Array<int> bdr_marker(mesh.bdr_attributes.Max());
+   bdr_marker = 0;
+   bdr_marker[0] = 1;
+
+   LinearForm lf_legacy(&fes), lf_device(&fes);
+   LinearForm *forms[2] = { &lf_legacy, &lf_device };
+   for (int i = 0; i < 2; i++)
+   {
+      if (vdim == 1)
+      {
+         forms[i]->AddDomainIntegrator(new DomainLFIntegrator(f));
+         forms[i]->AddDomainIntegrator(new DomainLFIntegrator(c));
+         forms[i]->AddDomainIntegrator(new DomainLFIntegrator(gfc));
+      }
+      else
+      {
+         forms[i]->AddDomainIntegrator(new VectorDomainLFIntegrator(vf));
+         forms[i]->AddDomainIntegrator(new VectorDomainLFIntegrator(vc));
+         forms[i]->AddDomainIntegrator(new VectorDomainLFIntegrator(vgfc));
+      }
+      if (bdr)
+      {
+         forms[i]->AddBoundaryIntegrator(new BoundaryLFIntegrator(f));
+         forms[i]->AddBoundaryIntegrator(new BoundaryLFIntegrator(c),
+                                         bdr_marker);
+         forms[i]->AddBoundaryIntegrator(new BoundaryLFIntegrator(gfc));
+      }
+   }
+   lf_device.UseFastAssembly(true);
+   REQUIRE(lf_device.SupportsDevice());
+
+   lf_legacy.Assemble();
+   lf_device.Assemble();
+
+   lf_device -= lf_legacy;
+   REQUIRE(lf_device.Normlinf() <= 1e-12 * lf_legacy.Normlinf());
+}
+
+TEST_CASE("LinearForm Device Assembly", "[LinearFormExtension]")
+{
+   for (int order = 1; order <= 3; order++)
+   {
+      SECTION("2D quadrilaterals, order " + std::to_string(order))
+      {
+         Mesh mesh(3, 3, Element::QUADRILATERAL, 1, 1.0, 1.0);
+         test_linearform_ext(mesh, order, 1, true);
+         test_linearform_ext(mesh, order, 2, false);
+      }
+      SECTION("2D curved quadrilaterals, order " + std::to_string(order))
+      {
+         Mesh mesh("../../data/star-q3.mesh", 1, 1);
+         test_linearform_ext(mesh, order, 1, true);
+         test_linearform_ext(mesh, order, 2, false);
+      }
+      SECTION("2D triangles, order " + std::to_string(order))
+      {
+         Mesh mesh(3, 3, Element::TRIANGLE, 1, 1.0, 1.0);
+         test_linearform_ext(mesh, order, 1, false);
+         test_linearform_ext(mesh, order, 2, false);
+      }
+      SECTION("3D hexahedra, order " + std::to_string(order))
+      {
+         Mesh mesh(2, 2, 2, Element::HEXAHEDRON, 1, 1.0, 1.0, 1.0);
+         test_linearform_ext(mesh, order, 1, true);
+         test_linearform_ext(mesh, order, 3, false);
+      }
+      SECTION("3D curved hexahedra, order " + std::to_string(order))
+      {
+         Mesh mesh("../../data/fichera-q2.mesh", 1, 1);
+         test_linearform_ext(mesh, order, 1, true);
+      }
+   }
+}
+
+TEST_CASE("LinearForm Device Assembly Fallback", "[LinearFormExtension]")
+{
+   // Boundary integrators on simplices use the host assembly
+   Mesh mesh(2, 2, Element::TRIANGLE, 1, 1.0, 1.0);
+   H1_FECollection fec(2, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+   ConstantCoefficient one(1.0);
+   LinearForm lf(&fes);
+   lf.AddBoundaryIntegrator(new BoundaryLFIntegrator(one));
+   lf.UseFastAssembly(true);
+   REQUIRE(!lf.SupportsDevice());
+   lf.Assemble();
+   // The integral of the test functions over the boundary is its length
+   REQUIRE(lf.Sum() == Approx(4.0));
+}
+
+TEST_CASE("LinearForm Device Assembly Interior Boundary",
+          "[LinearFormExtension]")
+{
+   // Two quadrilaterals in [0,2]x[0,1] with a boundary element (attribute 2)
+   // on the interior edge x = 1, which the device kernels cannot see
+   Mesh mesh(2, 6, 2, 7);
+   for (int j = 0; j < 2; j++)
+   {
+      for (int i = 0; i < 3; i++)
+      {
+         const double v[2] = { double(i), double(j) };
+         mesh.AddVertex(v);
+      }
+   }
+   const int quads[2][4] = { {0, 1, 4, 3}, {1, 2, 5, 4} };
+   for (int i = 0; i < 2; i++) { mesh.AddQuad(quads[i]); }
+   const int segs[6][2] = { {0, 1}, {1, 2}, {2, 5}, {5, 4}, {4, 3}, {3, 0} };
+   for (int i = 0; i < 6; i++) { mesh.AddBdrSegment(segs[i], 1); }
+   const int interior[2] = { 1, 4 };
+   mesh.AddBdrSegment(interior, 2);
+   mesh.FinalizeQuadMesh(1, 1, true);
+
+   H1_FECollection fec(2, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+   ConstantCoefficient one(1.0);
+   LinearForm lf(&fes);
+   lf.AddBoundaryIntegrator(new BoundaryLFIntegrator(one));
+   lf.UseFastAssembly(true);
+   REQUIRE(!lf.SupportsDevice());
+   lf.Assemble();
+   // The perimeter plus the length of the interior boundary element
+   REQUIRE(lf.Sum() == Approx(7.0));
+}
+
+} // namespace linearform_ext
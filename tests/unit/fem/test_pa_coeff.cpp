@@ -156,6 +156,112 @@ TEST_CASE("H1 pa_coeff")
    }
 }
 
+bool symmetricMatrix;
+
+void matrixFunction(const Vector &x, DenseMatrix &M)
+{
+   const int dim = x.Size();
+   M.SetSize(dim);
+   for (int i = 0; i < dim; i++)
+   {
+      for (int j = 0; j < dim; j++)
+      {
+         M(i,j) = (i == j) ? 2.0 + x(i) : 0.25 * sin(x(0) + x(1));
+         if (!symmetricMatrix && i < j) { M(i,j) += 0.5 * x(j) + 0.1 * i; }
+      }
+   }
+}
+
+void diagonalFunction(const Vector &x, Vector &v)
+{
+   v.SetSize(x.Size());
+   for (int i = 0; i < x.Size(); i++) { v(i) = 1.0 + i + x(i) * x(i); }
+}
+
+void skewTransform(const Vector &x, Vector &y)
+{
+   y = x;
+   y(0) += 0.1 * x(1) * x(1);
+   y(1) += 0.2 * x(0);
+}
+
+TEST_CASE("H1 pa_coeff with matrix and vector coefficients")
+{
+   for (dimension = 2; dimension < 4; ++dimension)
+   {
+      for (int coeffType = 0; coeffType < 4; ++coeffType)
+      {
+         // 0, 1: symmetric and non-symmetric matrix diffusion coefficients
+         // 2, 3: vector (diagonal) and matrix vector mass coefficients
+         const bool diffusion = coeffType < 2;
+         symmetricMatrix = (coeffType == 0);
+         for (int order = 1; order < 4; ++order)
+         {
+            const int ne = 2;
+            Mesh *mesh;
+            if (dimension == 2)
+            {
+               mesh = new Mesh(ne, ne, Element::QUADRILATERAL, 1, 1.0, 1.0);
+            }
+            else
+            {
+               mesh = new Mesh(ne, ne, ne, Element::HEXAHEDRON, 1, 1.0, 1.0,
+                               1.0);
+            }
+            mesh->Transform(skewTransform);
+            H1_FECollection fec(order, dimension);
+            FiniteElementSpace fespace(mesh, &fec, diffusion ? 1 : dimension);
+
+            MatrixFunctionCoefficient mcoeff(dimension, matrixFunction);
+            VectorFunctionCoefficient vcoeff(dimension, diagonalFunction);
+
+            BilinearForm paform(&fespace), assemblyform(&fespace);
+            paform.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+            if (diffusion)
+            {
+               paform.AddDomainIntegrator(new DiffusionIntegrator(mcoeff));
+               assemblyform.AddDomainIntegrator(
+                  new DiffusionIntegrator(mcoeff));
+            }
+            else if (coeffType == 2)
+            {
+               paform.AddDomainIntegrator(new VectorMassIntegrator(vcoeff));
+               assemblyform.AddDomainIntegrator(
+                  new VectorMassIntegrator(vcoeff));
+            }
+            else
+            {
+               paform.AddDomainIntegrator(new VectorMassIntegrator(mcoeff));
+               assemblyform.AddDomainIntegrator(
+                  new VectorMassIntegrator(mcoeff));
+            }
+            paform.Assemble();
+            assemblyform.Assemble();
+            assemblyform.Finalize();
+            const SparseMatrix &A_explicit = assemblyform.SpMat();
+
+            Vector xin(fespace.GetTrueVSize());
+            xin.Randomize();
+            Vector y_mat(xin.Size()), y_pa(xin.Size());
+            y_pa = 0.0;
+            paform.Mult(xin, y_pa);
+            A_explicit.Mult(xin, y_mat);
+            y_pa -= y_mat;
+            REQUIRE(y_pa.Normlinf() < 1.e-12 * y_mat.Normlinf());
+
+            Vector diag_pa(xin.Size()), diag_mat(xin.Size());
+            diag_pa = 0.0;
+            paform.AssembleDiagonal(diag_pa);
+            A_explicit.GetDiag(diag_mat);
+            diag_pa -= diag_mat;
+            REQUIRE(diag_pa.Normlinf() < 1.e-12 * diag_mat.Normlinf());
+
+            delete mesh;
+         }
+      }
+   }
+}
+
 TEST_CASE("Hcurl/Hdiv pa_coeff")
 {
    for (dimension = 2; dimension < 4; ++dimension)
@@ -457,4 +457,570 @@ TEST_CASE("PA Convection", "[PartialAssembly]")
    }
 }//test case
 
+double mf_coeff_function(const Vector &x)
+{
+   return 1.0 + x(0)*x(0);
+}
+
+template <typename INTEGRATOR>
+void test_mf_integrator(Mesh &&mesh, int order, Coefficient *Q)
+{
+   mesh.EnsureNodes();
+   mesh.SetCurvature(mesh.GetNodalFESpace()->GetOrder(0));
+   int dim = mesh.Dimension();
+
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(&mesh, &fec);
+
+   BilinearForm blf_fa(&fes), blf_mf(&fes);
+   blf_fa.AddDomainIntegrator(Q ? new INTEGRATOR(*Q) : new INTEGRATOR);
+   blf_fa.Assemble();
+   blf_fa.Finalize();
+   blf_mf.SetAssemblyLevel(AssemblyLevel::NONE);
+   blf_mf.AddDomainIntegrator(Q ? new INTEGRATOR(*Q) : new INTEGRATOR);
+   blf_mf.Assemble();
+
+   GridFunction x(&fes), y_fa(&fes), y_mf(&fes);
+   x.Randomize(1);
+   blf_fa.Mult(x, y_fa);
+   blf_mf.Mult(x, y_mf);
+   y_mf -= y_fa;
+   REQUIRE(y_mf.Normlinf() < 1.e-12 * std::max(1.0, y_fa.Normlinf()));
+
+   blf_fa.MultTranspose(x, y_fa);
+   blf_mf.MultTranspose(x, y_mf);
+   y_mf -= y_fa;
+   REQUIRE(y_mf.Normlinf() < 1.e-12 * std::max(1.0, y_fa.Normlinf()));
+
+   Vector diag_fa(fes.GetTrueVSize()), diag_mf(fes.GetTrueVSize());
+   blf_fa.SpMat().GetDiag(diag_fa);
+   blf_mf.AssembleDiagonal(diag_mf);
+   diag_mf -= diag_fa;
+   REQUIRE(diag_mf.Normlinf() < 1.e-12 * std::max(1.0, diag_fa.Normlinf()));
+}
+
+TEST_CASE("MF Mass and Diffusion", "[MatrixFree]")
+{
+   FunctionCoefficient coeff(mf_coeff_function);
+   for (Coefficient *Q : {(Coefficient*)NULL, (Coefficient*)&coeff})
+   {
+      SECTION("2D")
+      {
+         for (int order : {1, 2, 3})
+         {
+            test_mf_integrator<MassIntegrator>(
+               Mesh("../../data/star-q3.mesh", 1, 1), order, Q);
+            test_mf_integrator<DiffusionIntegrator>(
+               Mesh("../../data/star-q3.mesh", 1, 1), order, Q);
+         }
+      }
+
+      SECTION("3D")
+      {
+         int order = 2;
+         test_mf_integrator<MassIntegrator>(
+            Mesh("../../data/fichera-q3.mesh", 1, 1), order, Q);
+         test_mf_integrator<DiffusionIntegrator>(
+            Mesh("../../data/fichera-q3.mesh", 1, 1), order, Q);
+      }
+   }
+}
+
+template <typename INTEGRATOR, typename COEFFICIENT = Coefficient>
+void test_pa_simplex_integrator(Mesh &&mesh, FiniteElementCollection &fec,
+                                COEFFICIENT *Q)
+{
+   FiniteElementSpace fes(&mesh, &fec);
+
+   BilinearForm blf_fa(&fes), blf_pa(&fes);
+   blf_fa.AddDomainIntegrator(Q ? new INTEGRATOR(*Q) : new INTEGRATOR);
+   blf_fa.Assemble();
+   blf_fa.Finalize();
+   blf_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   blf_pa.AddDomainIntegrator(Q ? new INTEGRATOR(*Q) : new INTEGRATOR);
+   blf_pa.Assemble();
+
+   GridFunction x(&fes), y_fa(&fes), y_pa(&fes);
+   x.Randomize(1);
+   blf_fa.Mult(x, y_fa);
+   blf_pa.Mult(x, y_pa);
+   y_pa -= y_fa;
+   REQUIRE(y_pa.Normlinf() < 1.e-12 * std::max(1.0, y_fa.Normlinf()));
+
+   Vector diag_fa(fes.GetVSize()), diag_pa(fes.GetVSize());
+   blf_fa.SpMat().GetDiag(diag_fa);
+   blf_pa.AssembleDiagonal(diag_pa);
+   diag_pa -= diag_fa;
+   REQUIRE(diag_pa.Normlinf() < 1.e-12 * std::max(1.0, diag_fa.Normlinf()));
+}
+
+TEST_CASE("PA Simplices and Mixed Meshes", "[PartialAssembly]")
+{
+   FunctionCoefficient coeff(mf_coeff_function);
+   for (Coefficient *Q : {(Coefficient*)NULL, (Coefficient*)&coeff})
+   {
+      SECTION("2D")
+      {
+         for (int order : {1, 2, 3})
+         {
+            H1_FECollection fec(order, 2);
+            test_pa_simplex_integrator<MassIntegrator>(
+               Mesh(3, 3, Element::TRIANGLE, true), fec, Q);
+            test_pa_simplex_integrator<DiffusionIntegrator>(
+               Mesh(3, 3, Element::TRIANGLE, true), fec, Q);
+            test_pa_simplex_integrator<MassIntegrator>(
+               Mesh("../../data/star-mixed.mesh", 1, 1), fec, Q);
+            test_pa_simplex_integrator<DiffusionIntegrator>(
+               Mesh("../../data/star-mixed.mesh", 1, 1), fec, Q);
+            L2_FECollection l2_fec(order, 2);
+            test_pa_simplex_integrator<MassIntegrator>(
+               Mesh("../../data/star-mixed.mesh", 1, 1), l2_fec, Q);
+         }
+      }
+
+      SECTION("3D")
+      {
+         int order = 2;
+         H1_FECollection fec(order, 3);
+         test_pa_simplex_integrator<MassIntegrator>(
+            Mesh("../../data/beam-tet.mesh", 1, 1), fec, Q);
+         test_pa_simplex_integrator<DiffusionIntegrator>(
+            Mesh("../../data/beam-tet.mesh", 1, 1), fec, Q);
+         test_pa_simplex_integrator<MassIntegrator>(
+            Mesh("../../data/fichera-mixed.mesh", 1, 1), fec, Q);
+         test_pa_simplex_integrator<DiffusionIntegrator>(
+            Mesh("../../data/fichera-mixed.mesh", 1, 1), fec, Q);
+      }
+   }
+
+   SECTION("Curved mixed mesh and matrix coefficients")
+   {
+      // Symmetric and non-symmetric matrix coefficients select the two
+      // layouts of the quadrature point data
+      MatrixFunctionCoefficient sym(2, [](const Vector &x, DenseMatrix &M)
+      {
+         M(0,0) = 2.0 + x(0)*x(0); M(0,1) = 0.3*x(1);
+         M(1,0) = 0.3*x(1);        M(1,1) = 1.5 + x(0)*x(1);
+      });
+      MatrixFunctionCoefficient nonsym(2, [](const Vector &x, DenseMatrix &M)
+      {
+         M(0,0) = 2.0 + x(0)*x(0); M(0,1) = 0.3*x(1);
+         M(1,0) = -0.2*x(0);       M(1,1) = 1.5 + x(0)*x(1);
+      });
+      H1_FECollection fec(2, 2);
+      for (MatrixCoefficient *MQ : {(MatrixCoefficient*)&sym,
+                                    (MatrixCoefficient*)&nonsym})
+      {
+         test_pa_simplex_integrator<DiffusionIntegrator>(
+            Mesh(3, 3, Element::TRIANGLE, true), fec, MQ);
+         test_pa_simplex_integrator<DiffusionIntegrator>(
+            Mesh("../../data/star-mixed.mesh", 1, 1), fec, MQ);
+      }
+      Mesh curved("../../data/star-mixed.mesh", 1, 1);
+      curved.SetCurvature(3);
+      test_pa_simplex_integrator<MassIntegrator>(Mesh(curved), fec, &coeff);
+      test_pa_simplex_integrator<DiffusionIntegrator>(Mesh(curved), fec,
+                                                      &coeff);
+   }
+}
+
+void test_mf_convection(Mesh &&mesh, int order)
+{
+   mesh.EnsureNodes();
+   int dim = mesh.Dimension();
+
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fespace(&mesh, &fec);
+
+   VectorFunctionCoefficient vel_coeff(dim, velocity_function);
+   BilinearForm k_fa(&fespace), k_pa(&fespace), k_mf(&fespace);
+   k_fa.AddDomainIntegrator(new ConvectionIntegrator(vel_coeff, -1.0));
+   k_pa.AddDomainIntegrator(new ConvectionIntegrator(vel_coeff, -1.0));
+   k_mf.AddDomainIntegrator(new ConvectionIntegrator(vel_coeff, -1.0));
+   k_fa.Assemble();
+   k_fa.Finalize();
+   k_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   k_pa.Assemble();
+   k_mf.SetAssemblyLevel(AssemblyLevel::NONE);
+   k_mf.Assemble();
+
+   GridFunction x(&fespace), y_pa(&fespace), y_mf(&fespace);
+   x.Randomize(1);
+   k_pa.Mult(x, y_pa);
+   k_mf.Mult(x, y_mf);
+   y_mf -= y_pa;
+
+   REQUIRE(y_mf.Norml2() < 1.e-12);
+
+   // the transpose kernels, compared with the assembled matrix
+   GridFunction y_fa(&fespace);
+   k_fa.MultTranspose(x, y_fa);
+   k_pa.MultTranspose(x, y_pa);
+   k_mf.MultTranspose(x, y_mf);
+   const double norm = std::max(1.0, y_fa.Normlinf());
+   y_pa -= y_fa;
+   y_mf -= y_fa;
+   REQUIRE(y_pa.Normlinf() < 1.e-12 * norm);
+   REQUIRE(y_mf.Normlinf() < 1.e-12 * norm);
+}
+
+TEST_CASE("MF Convection", "[MatrixFree]")
+{
+   SECTION("2D")
+   {
+      test_mf_convection(Mesh("../../data/periodic-square.mesh", 1, 1), 3);
+      test_mf_convection(Mesh("../../data/amr-quad.mesh", 1, 1), 2);
+   }
+
+   SECTION("3D")
+   {
+      test_mf_convection(Mesh("../../data/fichera-q3.mesh", 1, 1), 2);
+   }
+}
+
+double lambda_function(const Vector &x)
+{
+   return 1.0 + x(0)*x(0) + 0.5*x(1);
+}
+
+void test_pa_elasticity(Mesh &&mesh, int order, bool scaled)
+{
+   const int dim = mesh.Dimension();
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(&mesh, &fec, dim);
+
+   const FiniteElement &el = *fes.GetFE(0);
+   const IntegrationRule &ir = IntRules.Get(el.GetGeomType(), 2*order + 2);
+
+   FunctionCoefficient lambda(lambda_function);
+   ConstantCoefficient mu(2.5);
+   auto new_integrator = [&]() -> BilinearFormIntegrator*
+   {
+      // with scaled == true: lambda = 0.7 f and mu = 1.3 f
+      BilinearFormIntegrator *integ =
+         scaled ? new ElasticityIntegrator(lambda, 0.7, 1.3) :
+         new ElasticityIntegrator(lambda, mu);
+      integ->SetIntRule(&ir);
+      return integ;
+   };
+
+   BilinearForm a_fa(&fes), a_pa(&fes), a_ea(&fes);
+   a_fa.AddDomainIntegrator(new_integrator());
+   a_pa.AddDomainIntegrator(new_integrator());
+   a_ea.AddDomainIntegrator(new_integrator());
+   a_fa.Assemble();
+   a_fa.Finalize();
+   a_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   a_pa.Assemble();
+   a_ea.SetAssemblyLevel(AssemblyLevel::ELEMENT);
+   a_ea.Assemble();
+
+   GridFunction x(&fes), y_fa(&fes), y_pa(&fes), y_ea(&fes);
+   x.Randomize(1);
+   a_fa.Mult(x, y_fa);
+   a_pa.Mult(x, y_pa);
+   a_ea.Mult(x, y_ea);
+   const double norm = y_fa.Norml2();
+   y_pa -= y_fa;
+   y_ea -= y_fa;
+   REQUIRE(y_pa.Norml2() < 1.e-12 * norm);
+   REQUIRE(y_ea.Norml2() < 1.e-12 * norm);
+
+   Vector diag_fa(fes.GetVSize()), diag_pa(fes.GetVSize());
+   a_fa.SpMat().GetDiag(diag_fa);
+   a_pa.AssembleDiagonal(diag_pa);
+   diag_pa -= diag_fa;
+   REQUIRE(diag_pa.Norml2() < 1.e-12 * diag_fa.Norml2());
+}
+
+TEST_CASE("PA Elasticity", "[PartialAssembly], [VectorPA]")
+{
+   SECTION("2D")
+   {
+      for (bool scaled : {false, true})
+      {
+         for (int order = 1; order <= 3; ++order)
+         {
+            test_pa_elasticity(Mesh(3, 2, Element::QUADRILATERAL, true,
+                                    1.0, 2.0), order, scaled);
+            test_pa_elasticity(Mesh("../../data/star-q3.mesh", 1, 1),
+                               order, scaled);
+         }
+      }
+   }
+
+   SECTION("3D")
+   {
+      for (bool scaled : {false, true})
+      {
+         for (int order = 1; order <= 2; ++order)
+         {
+            test_pa_elasticity(Mesh(2, 2, 1, Element::HEXAHEDRON, true,
+                                    1.0, 1.0, 0.5), order, scaled);
+            test_pa_elasticity(Mesh("../../data/fichera-q2.mesh", 1, 1),
+                               order, scaled);
+         }
+      }
+   }
+}
+
+double dg_diffusion_coeff(const Vector &x)
+{
+   return 1.0 + x(0)*x(0) + 0.5*x(1);
+}
+
+void test_pa_dg_diffusion(Mesh &&mesh, int order, double sigma, bool coeff)
+{
+   mesh.EnsureNodes();
+   const int dim = mesh.Dimension();
+   L2_FECollection fec(order, dim, BasisType::GaussLobatto);
+   FiniteElementSpace fes(&mesh, &fec);
+
+   const double kappa = (order+1)*(order+1);
+   FunctionCoefficient q(dg_diffusion_coeff);
+   auto add_integrators = [&](BilinearForm &a)
+   {
+      if (coeff)
+      {
+         a.AddInteriorFaceIntegrator(
+            new DGDiffusionIntegrator(q, sigma, kappa));
+         a.AddBdrFaceIntegrator(new DGDiffusionIntegrator(q, sigma, kappa));
+      }
+      else
+      {
+         a.AddInteriorFaceIntegrator(new DGDiffusionIntegrator(sigma, kappa));
+         a.AddBdrFaceIntegrator(new DGDiffusionIntegrator(sigma, kappa));
+      }
+   };
+
+   BilinearForm a_fa(&fes), a_pa(&fes);
+   add_integrators(a_fa);
+   add_integrators(a_pa);
+   a_fa.Assemble();
+   a_fa.Finalize();
+   a_pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   a_pa.Assemble();
+
+   GridFunction x(&fes), y_fa(&fes), y_pa(&fes);
+   x.Randomize(1);
+
+   a_fa.Mult(x, y_fa);
+   a_pa.Mult(x, y_pa);
+   y_pa -= y_fa;
+   REQUIRE(y_pa.Norml2() < 1.e-12 * y_fa.Norml2());
+
+   a_fa.MultTranspose(x, y_fa);
+   a_pa.MultTranspose(x, y_pa);
+   y_pa -= y_fa;
+   REQUIRE(y_pa.Norml2() < 1.e-12 * y_fa.Norml2());
+}
+
+TEST_CASE("PA DG Diffusion", "[PartialAssembly]")
+{
+   SECTION("2D")
+   {
+      for (bool coeff : {false, true})
+      {
+         for (double sigma : {-1.0, 1.0})
+         {
+            for (int order = 1; order <= 3; ++order)
+            {
+               test_pa_dg_diffusion(Mesh(3, 2, Element::QUADRILATERAL, true,
+                                         1.0, 2.0), order, sigma, coeff);
+               test_pa_dg_diffusion(Mesh("../../data/star-q3.mesh", 1, 1),
+                                    order, sigma, coeff);
+            }
+         }
+      }
+   }
+
+   SECTION("3D")
+   {
+      for (bool coeff : {false, true})
+      {
+         for (double sigma : {-1.0, 1.0})
+         {
+            for (int order = 1; order <= 2; ++order)
+            {
+               test_pa_dg_diffusion(Mesh(2, 2, 1, Element::HEXAHEDRON, true,
+                                         1.0, 1.0, 0.5), order, sigma, coeff);
+               test_pa_dg_diffusion(Mesh("../../data/fichera-q2.mesh", 1, 1),
+                                    order, sigma, coeff);
+            }
+         }
+      }
+   }
+}
+
+// Apply the element restriction and the PA integrator in two passes, on the
+// even and odd elements (gather and kernel) and on two halves of the dofs
+// (scatter), as done by PAOverlapRAPOperator, and compare with the full
+// application. With vdim > 1, only the element restriction is tested.
+template <typename INTEGRATOR>
+void test_pa_element_subsets(Mesh &&mesh, int order, int vdim)
+{
+   const int dim = mesh.Dimension();
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(&mesh, &fec, vdim);
+
+   const ElementRestriction *R = dynamic_cast<const ElementRestriction*>(
+                                    fes.GetElementRestriction(
+                                       ElementDofOrdering::LEXICOGRAPHIC));
+   REQUIRE(R != nullptr);
+
+   FunctionCoefficient coeff(mf_coeff_function);
+   INTEGRATOR integ(coeff);
+   if (vdim == 1)
+   {
+      integ.AssemblePA(fes);
+      REQUIRE(integ.SupportsPAElementSubsets());
+   }
+
+   Array<int> elems[2], dofs[2];
+   for (int e = 0; e < fes.GetNE(); e++) { elems[e % 2].Append(e); }
+   for (int d = 0; d < fes.GetNDofs(); d++)
+   {
+      dofs[2*d < fes.GetNDofs() ? 0 : 1].Append(d);
+   }
+
+   GridFunction x(&fes), y(&fes), y_sub(&fes);
+   x.Randomize(1);
+   Vector ex(R->Height()), ey(R->Height()), ex_sub(R->Height()),
+          ey_sub(R->Height());
+
+   R->Mult(x, ex);
+   ey = 0.0;
+   if (vdim == 1) { integ.AddMultPA(ex, ey); }
+   else { ey = ex; }
+   R->MultTranspose(ey, y);
+
+   ex_sub = 0.0;
+   ey_sub = 0.0;
+   for (int i = 0; i < 2; i++)
+   {
+      R->MultElements(elems[i], x, ex_sub);
+      if (vdim == 1) { integ.AddMultPAElements(elems[i], ex_sub, ey_sub); }
+   }
+   if (vdim > 1) { ey_sub = ex_sub; }
+   y_sub = 0.0;
+   for (int i = 0; i < 2; i++)
+   {
+      R->MultTransposeDofs(dofs[i], ey_sub, y_sub);
+   }
+
+   ex_sub -= ex;
+   REQUIRE(ex_sub.Normlinf() == 0.0);
+   ey_sub -= ey;
+   REQUIRE(ey_sub.Normlinf() < 1.e-12 * std::max(1.0, ey.Normlinf()));
+   y_sub -= y;
+   REQUIRE(y_sub.Normlinf() < 1.e-12 * std::max(1.0, y.Normlinf()));
+}
+
+TEST_CASE("PA Element Subsets", "[PartialAssembly]")
+{
+   for (int vdim : {1, 2})
+   {
+      SECTION("2D")
+      {
+         for (int order : {1, 2, 3})
+         {
+            test_pa_element_subsets<MassIntegrator>(
+               Mesh("../../data/star-q3.mesh", 1, 1), order, vdim);
+            test_pa_element_subsets<DiffusionIntegrator>(
+               Mesh("../../data/star-q3.mesh", 1, 1), order, vdim);
+         }
+      }
+
+      SECTION("3D")
+      {
+         int order = 2;
+         test_pa_element_subsets<MassIntegrator>(
+            Mesh("../../data/fichera-q3.mesh", 1, 1), order, vdim);
+         test_pa_element_subsets<DiffusionIntegrator>(
+            Mesh("../../data/fichera-q3.mesh", 1, 1), order, vdim);
+      }
+   }
+}
+
+#ifdef MFEM_USE_MPI
+
+TEST_CASE("PA Parallel Communication Overlap", "[Parallel], [PartialAssembly]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      Mesh *mesh = (dim == 2) ?
+                   new Mesh("../../data/star-q3.mesh", 1, 1) :
+                   new Mesh("../../data/fichera-q3.mesh", 1, 1);
+      ParMesh pmesh(MPI_COMM_WORLD, *mesh);
+      delete mesh;
+
+      H1_FECollection fec(2, dim);
+      ParFiniteElementSpace fes(&pmesh, &fec);
+      ConstantCoefficient one(1.0);
+
+      // The same PA form with and without the communication overlap
+      ParBilinearForm a_ovl(&fes), a_ref(&fes);
+      for (ParBilinearForm *a : {&a_ovl, &a_ref})
+      {
+         a->SetAssemblyLevel(AssemblyLevel::PARTIAL);
+         a->AddDomainIntegrator(new MassIntegrator(one));
+         a->AddDomainIntegrator(new DiffusionIntegrator(one));
+      }
+      a_ovl.SetCommOverlap(true);
+      a_ref.SetCommOverlap(false);
+      a_ovl.Assemble();
+      a_ref.Assemble();
+
+      // A*x on the true dofs
+      Array<int> no_ess;
+      OperatorHandle A_ovl, A_ref;
+      a_ovl.FormSystemMatrix(no_ess, A_ovl);
+      a_ref.FormSystemMatrix(no_ess, A_ref);
+      Vector x(fes.GetTrueVSize()), y_ovl(x.Size()), y_ref(x.Size());
+      x.Randomize(1);
+      A_ovl->Mult(x, y_ovl);
+      A_ref->Mult(x, y_ref);
+      y_ovl -= y_ref;
+      const double y_max = GlobalLpNorm(infinity(), y_ref.Normlinf(),
+                                        MPI_COMM_WORLD);
+      REQUIRE(GlobalLpNorm(infinity(), y_ovl.Normlinf(), MPI_COMM_WORLD) <
+              1.e-12 * std::max(1.0, y_max));
+
+      // Solve with essential boundary conditions
+      Array<int> ess_tdof_list, ess_bdr(pmesh.bdr_attributes.Max());
+      ess_bdr = 1;
+      fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+      ParLinearForm b(&fes);
+      b.AddDomainIntegrator(new DomainLFIntegrator(one));
+      b.Assemble();
+
+      ParGridFunction x_ovl(&fes), x_ref(&fes);
+      x_ovl = 0.0;
+      x_ref = 0.0;
+      OperatorHandle S_ovl, S_ref;
+      Vector X_ovl, X_ref, B_ovl, B_ref;
+      a_ovl.FormLinearSystem(ess_tdof_list, x_ovl, b, S_ovl, X_ovl, B_ovl);
+      a_ref.FormLinearSystem(ess_tdof_list, x_ref, b, S_ref, X_ref, B_ref);
+
+      CGSolver cg(MPI_COMM_WORLD);
+      cg.SetRelTol(1e-12);
+      cg.SetAbsTol(0.0);
+      cg.SetMaxIter(500);
+      cg.SetOperator(*S_ovl);
+      cg.Mult(B_ovl, X_ovl);
+      REQUIRE(cg.GetConverged());
+      cg.SetOperator(*S_ref);
+      cg.Mult(B_ref, X_ref);
+      REQUIRE(cg.GetConverged());
+
+      X_ovl -= X_ref;
+      const double x_max = GlobalLpNorm(infinity(), X_ref.Normlinf(),
+                                        MPI_COMM_WORLD);
+      REQUIRE(GlobalLpNorm(infinity(), X_ovl.Normlinf(), MPI_COMM_WORLD) <
+              1.e-8 * x_max);
+   }
+}
+
+#endif
+
 }// namespace pa_kernels
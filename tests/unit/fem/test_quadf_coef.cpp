@@ -158,5 +158,113 @@ TEST_CASE("Quadrature Function Coefficients",
 
 }
 
+static double batched_func(const Vector &x)
+{
+   return sin(x(0)) + x(1)*x(1);
+}
+
+static void batched_vfunc(const Vector &x, Vector &v)
+{
+   v.SetSize(x.Size());
+   for (int d = 0; d < x.Size(); d++) { v(d) = cos(x(d)) + d; }
+}
+
+// Compare the batched evaluation of 'coeff' with the point-wise evaluation.
+static double BatchedEvalError(Coefficient &coeff, Mesh &mesh,
+                               const IntegrationRule &ir)
+{
+   Vector batched, pointwise;
+   coeff.EvalQuadrature(batched, mesh, ir);
+   coeff.Coefficient::EvalQuadrature(pointwise, mesh, ir);
+   REQUIRE(batched.Size() == ir.GetNPoints() * mesh.GetNE());
+   REQUIRE(pointwise.Size() == batched.Size());
+   batched.HostRead();
+   pointwise -= batched;
+   return pointwise.Normlinf();
+}
+
+TEST_CASE("Batched Coefficient Evaluation",
+          "[Quadrature Function Coefficients]")
+{
+   const double tol = 1e-12;
+
+   for (int mt = 0; mt < 3; mt++)
+   {
+      Mesh *mesh;
+      if (mt == 0)
+      {
+         mesh = new Mesh(3, 3, Element::QUADRILATERAL, true, 1.0, 1.0);
+      }
+      else if (mt == 1)
+      {
+         mesh = new Mesh(2, 2, 2, Element::HEXAHEDRON, true, 1.0, 1.0, 1.0);
+      }
+      else
+      {
+         // Mixed mesh: uses the point-wise fallback paths
+         mesh = new Mesh("../../data/star-mixed.mesh", 1, 1);
+      }
+      const int dim = mesh->Dimension();
+      for (int e = 0; e < mesh->GetNE(); e++)
+      {
+         mesh->SetAttribute(e, 1 + e % 3);
+      }
+      mesh->SetAttributes();
+
+      const int order = 2;
+      const IntegrationRule &ir =
+         IntRules.Get(mesh->GetElementBaseGeometry(0), 2*order + 1);
+
+      H1_FECollection fec(order, dim);
+      FiniteElementSpace fes(mesh, &fec);
+      FiniteElementSpace vfes(mesh, &fec, dim);
+      GridFunction gf(&fes), vgf(&vfes);
+      FunctionCoefficient fcoeff(batched_func);
+      VectorFunctionCoefficient vfcoeff(dim, batched_vfunc);
+      gf.ProjectCoefficient(fcoeff);
+      vgf.ProjectCoefficient(vfcoeff);
+
+      ConstantCoefficient cc(2.5);
+      Vector pw(3);
+      pw(0) = 1.0; pw(1) = -2.0; pw(2) = 3.0;
+      PWConstCoefficient pwc(pw);
+      GridFunctionCoefficient gfc(&gf);
+      GridFunctionCoefficient vgfc(&vgf, 2);
+      SumCoefficient sum(gfc, pwc, 2.0, -0.5);
+      SumCoefficient sumc(1.5, vgfc);
+      ProductCoefficient prod(pwc, gfc);
+      ProductCoefficient prodc(-3.0, sum);
+
+      REQUIRE(BatchedEvalError(cc, *mesh, ir) < tol);
+      REQUIRE(BatchedEvalError(pwc, *mesh, ir) < tol);
+      REQUIRE(BatchedEvalError(gfc, *mesh, ir) < tol);
+      REQUIRE(BatchedEvalError(vgfc, *mesh, ir) < tol);
+      REQUIRE(BatchedEvalError(sum, *mesh, ir) < tol);
+      REQUIRE(BatchedEvalError(sumc, *mesh, ir) < tol);
+      REQUIRE(BatchedEvalError(prod, *mesh, ir) < tol);
+      REQUIRE(BatchedEvalError(prodc, *mesh, ir) < tol);
+
+      if (mt == 0)
+      {
+         // 13x13 points, more than the QuadratureInterpolator kernels support:
+         // uses the point-wise fallback
+         const IntegrationRule &ir_fine = IntRules.Get(Geometry::SQUARE, 25);
+         REQUIRE(BatchedEvalError(gfc, *mesh, ir_fine) < tol);
+      }
+
+      if (mt < 2)
+      {
+         QuadratureSpace qspace(mesh, 2*order + 1);
+         QuadratureFunction qf(&qspace);
+         REQUIRE(qspace.GetElementIntRule(0).GetNPoints() == ir.GetNPoints());
+         for (int i = 0; i < qf.Size(); i++) { qf(i) = sin(1.0 + i); }
+         QuadratureFunctionCoefficient qfc(qf);
+         REQUIRE(BatchedEvalError(qfc, *mesh, ir) < tol);
+      }
+
+      delete mesh;
+   }
+}
+
 } // namespace qf_coeff
 
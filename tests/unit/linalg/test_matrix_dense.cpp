@@ -293,3 +293,57 @@ TEST_CASE("DenseTensor LinearSolve methods",
       }
    }
 }
+
+TEST_CASE("DenseTensor batched factorizations",
+          "[DenseMatrix]")
+{
+   const double tol = 1e-10;
+   const int NE = 7;
+   // Sizes with compile-time specialized kernels and the generic kernel
+   const int sizes[] = { 1, 3, 8, 11 };
+   for (int m : sizes)
+   {
+      // Symmetric positive definite blocks A_e = B_e B_e^t + m I
+      DenseTensor A(m, m, NE);
+      Vector X(m*NE), Y_ref(m*NE);
+      X.Randomize(1);
+      for (int e = 0; e < NE; e++)
+      {
+         DenseMatrix B(m);
+         Vector b(B.Data(), m*m);
+         b.Randomize(e + 2);
+         MultAAt(B, A(e));
+         for (int i = 0; i < m; i++) { A(e)(i,i) += m; }
+
+         DenseMatrixInverse Ainv(A(e));
+         Vector x_e(X.GetData() + e*m, m), y_e(Y_ref.GetData() + e*m, m);
+         Ainv.Mult(x_e, y_e);
+      }
+
+      Vector Y(m*NE);
+      BatchedBlockDiagonalSolver::Type types[] =
+      {
+         BatchedBlockDiagonalSolver::LU,
+         BatchedBlockDiagonalSolver::CHOLESKY,
+         BatchedBlockDiagonalSolver::INVERSE
+      };
+      for (auto type : types)
+      {
+         BatchedBlockDiagonalSolver S(A, type);
+         REQUIRE(S.Height() == m*NE);
+         S.Mult(X, Y);
+         Y -= Y_ref;
+         REQUIRE(Y.Normlinf() < tol);
+      }
+
+      // The batched product inverts the batched solve
+      Y = X;
+      DenseTensor Ach(A);
+      BatchCholeskyFactor(Ach);
+      BatchCholeskySolve(Ach, Y);
+      Vector Z;
+      BatchMult(A, Y, Z);
+      Z -= X;
+      REQUIRE(Z.Normlinf() < tol);
+   }
+}
@@ -0,0 +1,119 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace multicolor_gs
+{
+
+TEST_CASE("Multicolor Gauss-Seidel Smoother", "[MulticolorGSSmoother]")
+{
+   Mesh mesh(8, 8, Element::QUADRILATERAL, true);
+   H1_FECollection fec(2, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+   Array<int> ess_tdof_list;
+   Array<int> ess_bdr(mesh.bdr_attributes.Max());
+   ess_bdr = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new DiffusionIntegrator);
+   a.Assemble();
+   LinearForm b(&fes);
+   ConstantCoefficient one(1.0);
+   b.AddDomainIntegrator(new DomainLFIntegrator(one));
+   b.Assemble();
+   GridFunction x(&fes);
+   x = 0.0;
+   SparseMatrix A;
+   Vector X, B;
+   a.FormLinearSystem(ess_tdof_list, x, b, A, X, B);
+   const int n = A.Height();
+
+   SECTION("Coloring")
+   {
+      MulticolorGSSmoother S(A);
+      Array<int> colors;
+      S.GetColors(colors);
+      REQUIRE(S.GetNumColors() > 1);
+      for (int i = 0; i < n; i++)
+      {
+         REQUIRE(colors[i] >= 0);
+         REQUIRE(colors[i] < S.GetNumColors());
+         const int *J = A.GetRowColumns(i);
+         for (int k = 0; k < A.RowSize(i); k++)
+         {
+            if (J[k] != i) { REQUIRE(colors[J[k]] != colors[i]); }
+         }
+      }
+   }
+
+   SECTION("Sweeps")
+   {
+      const double omegas[] = { 1.0, 1.3 };
+      for (double omega : omegas)
+      {
+         MulticolorGSSmoother S(A, 1, omega);
+         Array<int> colors;
+         S.GetColors(colors);
+
+         // Sequential SOR sweep with the rows ordered by color
+         Vector y_ref(n);
+         y_ref = 0.0;
+         for (int c = 0; c < S.GetNumColors(); c++)
+         {
+            for (int i = 0; i < n; i++)
+            {
+               if (colors[i] != c) { continue; }
+               double r = B(i);
+               const int *J = A.GetRowColumns(i);
+               const double *V = A.GetRowEntries(i);
+               for (int k = 0; k < A.RowSize(i); k++) { r -= V[k]*y_ref(J[k]); }
+               y_ref(i) += omega * r / A.Elem(i, i);
+            }
+         }
+
+         Vector y(n);
+         S.Mult(B, y);
+         y -= y_ref;
+         REQUIRE(y.Normlinf() < 1e-12);
+      }
+   }
+
+   SECTION("Preconditioned CG")
+   {
+      // The symmetric smoother is as effective as the sequential one, up to
+      // the different ordering of the rows
+      CGSolver cg;
+      cg.SetOperator(A);
+      cg.SetRelTol(1e-10);
+      cg.SetMaxIter(500);
+      cg.SetPrintLevel(-1);
+      GSSmoother gs(A);
+      cg.SetPreconditioner(gs);
+      X = 0.0;
+      cg.Mult(B, X);
+      REQUIRE(cg.GetConverged());
+      const int its_gs = cg.GetNumIterations();
+
+      MulticolorGSSmoother S(A);
+      cg.SetPreconditioner(S);
+      X = 0.0;
+      cg.Mult(B, X);
+      REQUIRE(cg.GetConverged());
+      REQUIRE(cg.GetNumIterations() <= its_gs + 3);
+   }
+}
+
+} // namespace multicolor_gs
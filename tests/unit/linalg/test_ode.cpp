@@ -181,6 +181,37 @@ TEST_CASE("First order ODE methods",
       REQUIRE(check.order(new RK4Solver) + tol > 4.0 );
    }
 
+   // Low-storage Runge-Kutta
+   SECTION("LowStorageRK3Solver")
+   {
+      std::cout <<"\nTesting LowStorageRK3Solver" << std::endl;
+      REQUIRE(check.order(new LowStorageRK3Solver) + tol > 3.0 );
+   }
+
+   SECTION("LowStorageRK4Solver")
+   {
+      std::cout <<"\nTesting LowStorageRK4Solver" << std::endl;
+      REQUIRE(check.order(new LowStorageRK4Solver) + tol > 4.0 );
+   }
+
+   SECTION("LowStorageSSPRK4Solver")
+   {
+      std::cout <<"\nTesting LowStorageSSPRK4Solver" << std::endl;
+      REQUIRE(check.order(new LowStorageSSPRK4Solver) + tol > 4.0 );
+   }
+
+   SECTION("LowStorage3SStarRK4Solver")
+   {
+      std::cout <<"\nTesting LowStorage3SStarRK4Solver" << std::endl;
+      REQUIRE(check.order(new LowStorage3SStarRK4Solver) + tol > 4.0 );
+   }
+
+   SECTION("LowStorage3SStarRK5Solver")
+   {
+      std::cout <<"\nTesting LowStorage3SStarRK5Solver" << std::endl;
+      REQUIRE(check.order(new LowStorage3SStarRK5Solver) + tol > 5.0 );
+   }
+
    SECTION("ImplicitMidpointSolver")
    {
       std::cout <<"\nTesting ImplicitMidpointSolver" << std::endl;
@@ -281,3 +312,81 @@ TEST_CASE("First order ODE methods",
    }
 }
 
+
+TEST_CASE("Low storage RK methods on a nonlinear ODE",
+          "[ODE1]")
+{
+   double tol = 0.1;
+
+   // Nonlinear, non-autonomous ODE
+   //    du/dt = cos(t) u^2,  u(0) = 1/2
+   // with the exact solution u(t) = 1/(2 - sin(t)).
+   class ODE : public TimeDependentOperator
+   {
+   public:
+      ODE() : TimeDependentOperator(1, 0.0) { }
+
+      virtual void Mult(const Vector &u, Vector &dudt) const
+      {
+         dudt(0) = cos(GetTime())*u(0)*u(0);
+      }
+   };
+
+   // Return the convergence order between the two finest time steps.
+   auto order = [](ODESolver *ode_solver)
+   {
+      ODE oper;
+      const int levels = 5;
+      const double t_final = 2.0;
+      Vector u(1), err(levels);
+      int steps = 8;
+      std::cout<<std::setw(12)<<"Error"
+               <<std::setw(12)<<"Order"<<std::endl;
+      for (int l = 0; l < levels; l++, steps *= 2)
+      {
+         double t = 0.0, dt = t_final/double(steps);
+         u(0) = 0.5;
+         ode_solver->Init(oper);
+         for (int ti = 0; ti < steps; ti++)
+         {
+            ode_solver->Step(u, t, dt);
+         }
+         err(l) = std::abs(u(0) - 1.0/(2.0 - sin(t_final)));
+         std::cout<<std::setw(12)<<err(l);
+         if (l > 0) { std::cout<<std::setw(12)<<log(err(l-1)/err(l))/log(2); }
+         std::cout<<std::endl;
+      }
+      delete ode_solver;
+      return log(err(levels-2)/err(levels-1))/log(2);
+   };
+
+   SECTION("LowStorageRK3Solver")
+   {
+      std::cout <<"\nTesting LowStorageRK3Solver" << std::endl;
+      REQUIRE(order(new LowStorageRK3Solver) + tol > 3.0 );
+   }
+
+   SECTION("LowStorageRK4Solver")
+   {
+      std::cout <<"\nTesting LowStorageRK4Solver" << std::endl;
+      REQUIRE(order(new LowStorageRK4Solver) + tol > 4.0 );
+   }
+
+   SECTION("LowStorageSSPRK4Solver")
+   {
+      std::cout <<"\nTesting LowStorageSSPRK4Solver" << std::endl;
+      REQUIRE(order(new LowStorageSSPRK4Solver) + tol > 4.0 );
+   }
+
+   SECTION("LowStorage3SStarRK4Solver")
+   {
+      std::cout <<"\nTesting LowStorage3SStarRK4Solver" << std::endl;
+      REQUIRE(order(new LowStorage3SStarRK4Solver) + tol > 4.0 );
+   }
+
+   SECTION("LowStorage3SStarRK5Solver")
+   {
+      std::cout <<"\nTesting LowStorage3SStarRK5Solver" << std::endl;
+      REQUIRE(order(new LowStorage3SStarRK5Solver) + tol > 5.0 );
+   }
+}
@@ -0,0 +1,150 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+#include <cmath>
+
+using namespace mfem;
+
+namespace ode_adaptive
+{
+
+// du/dt = A u with A = [[-a, -1], [1, -a]]: damped rotation with the exact
+// solution u(t) = exp(-a t) R(t) u(0), R(t) the rotation by the angle t.
+class RotationODE : public TimeDependentOperator
+{
+protected:
+   double a;
+   DenseMatrix A, T;
+   Vector r;
+
+public:
+   RotationODE(double a) : TimeDependentOperator(2, 0.0), a(a), A(2), T(2),
+      r(2)
+   {
+      A(0,0) = -a; A(0,1) = -1.0;
+      A(1,0) = 1.0; A(1,1) = -a;
+   }
+
+   virtual void Mult(const Vector &u, Vector &dudt) const { A.Mult(u, dudt); }
+
+   // Solve dudt = A (u + dt dudt)
+   virtual void ImplicitSolve(const double dt, const Vector &u, Vector &dudt)
+   {
+      A.Mult(u, r);
+      T = A;
+      T *= -dt;
+      T(0,0) += 1.0; T(1,1) += 1.0;
+      T.Invert();
+      T.Mult(r, dudt);
+   }
+
+   void Exact(double t, Vector &u) const
+   {
+      u.SetSize(2);
+      u(0) = exp(-a*t)*cos(t);
+      u(1) = exp(-a*t)*sin(t);
+   }
+};
+
+// Run from u(0) = (1,0) to t = 2 pi with an output every 'dt_out' and return
+// the maximum error at the output times
+static double RunRotation(AdaptiveRKSolver &ode, RotationODE &oper,
+                          double dt_out)
+{
+   Vector u(2), u_ex;
+   u(0) = 1.0; u(1) = 0.0;
+   double t = 0.0, err = 0.0;
+   const double t_final = 2.0*M_PI;
+   ode.Init(oper);
+   while (t < t_final - 1e-12)
+   {
+      double dt = std::min(dt_out, t_final - t);
+      ode.Step(u, t, dt);
+      oper.Exact(t, u_ex);
+      u_ex -= u;
+      err = std::max(err, u_ex.Normlinf());
+   }
+   REQUIRE(fabs(t - t_final) < 1e-12);
+   return err;
+}
+
+TEST_CASE("Adaptive Runge-Kutta methods", "[ODE1]")
+{
+   RotationODE oper(0.1);
+
+   SECTION("Tolerances")
+   {
+      BogackiShampine32Solver bs3;
+      DormandPrince54Solver dp5;
+      TRBDF2Solver trbdf2;
+      AdaptiveRKSolver *solvers[3] = { &bs3, &dp5, &trbdf2 };
+      for (AdaptiveRKSolver *ode : solvers)
+      {
+         // The tolerances bound the local error; the global error of the
+         // second order TR-BDF2 is a larger multiple of the tolerance.
+         int steps[2];
+         double err[2];
+         for (int i = 0; i < 2; i++)
+         {
+            const double tol = (i == 0) ? 1e-4 : 1e-7;
+            ode->SetTolerances(tol, tol);
+            err[i] = RunRotation(*ode, oper, 2.0*M_PI);
+            REQUIRE(err[i] < 1000*tol);
+            steps[i] = ode->GetNumSteps();
+         }
+         // Tighter tolerances need more steps and give smaller errors
+         REQUIRE(steps[1] > steps[0]);
+         REQUIRE(err[1] < err[0]/10);
+      }
+      // The higher order pair takes larger steps
+      REQUIRE(dp5.GetNumSteps() < bs3.GetNumSteps());
+   }
+
+   SECTION("Dense Output")
+   {
+      DormandPrince54Solver dp5;
+      dp5.SetTolerances(1e-8, 1e-8);
+      const double err_large = RunRotation(dp5, oper, 2.0*M_PI);
+      const int steps_large = dp5.GetNumSteps();
+
+      // Many output times: the outputs are interpolated, so the internal
+      // steps are essentially the same (only the initial step differs)
+      const double err_dense = RunRotation(dp5, oper, 0.01);
+      REQUIRE(dp5.GetNumSteps() < steps_large + 10);
+      REQUIRE(err_dense < 100*1e-8);
+      REQUIRE(err_large < 100*1e-8);
+
+      // Without interpolation, the steps are shortened at the output times
+      dp5.SetInterpolation(false);
+      const double err_short = RunRotation(dp5, oper, 0.5);
+      REQUIRE(dp5.GetNumSteps() > steps_large);
+      REQUIRE(err_short < 100*1e-8);
+   }
+
+   SECTION("Stiff Problem")
+   {
+      // Eigenvalues -1000 +/- i: the step size of the explicit pair is
+      // limited by stability, while the L-stable TR-BDF2 takes steps limited
+      // by accuracy only
+      RotationODE stiff(1000.0);
+      DormandPrince54Solver dp5;
+      TRBDF2Solver trbdf2;
+      dp5.SetTolerances(1e-4, 1e-6);
+      trbdf2.SetTolerances(1e-4, 1e-6);
+      REQUIRE(RunRotation(dp5, stiff, 1.0) < 1e-4);
+      REQUIRE(RunRotation(trbdf2, stiff, 1.0) < 1e-4);
+      REQUIRE(5*trbdf2.GetNumSteps() < dp5.GetNumSteps());
+   }
+}
+
+} // namespace ode_adaptive
@@ -0,0 +1,100 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace sparse_formats
+{
+
+// Distance between the products of op and A (and their transposes) with a
+// random vector
+static double ProductDiff(const Operator &op, const SparseMatrix &A)
+{
+   Vector x(A.Width()), y(A.Height()), z(A.Height());
+   x.Randomize(1);
+   A.Mult(x, y);
+   op.Mult(x, z);
+   z -= y;
+   double err = z.Normlinf();
+
+   Vector xt(A.Height()), yt(A.Width()), zt(A.Width());
+   xt.Randomize(2);
+   A.MultTranspose(xt, yt);
+   op.MultTranspose(xt, zt);
+   zt -= yt;
+   return std::max(err, zt.Normlinf());
+}
+
+TEST_CASE("SELL-C-sigma Matrix", "[SparseMatrix]")
+{
+   // Rows of random length between 0 and 9
+   const int m = 103, n = 57;
+   SparseMatrix A(m, n);
+   srand(7);
+   for (int i = 0; i < m; i++)
+   {
+      const int len = rand() % 10;
+      for (int k = 0; k < len; k++)
+      {
+         A.Add(i, rand() % n, double(rand())/RAND_MAX - 0.5);
+      }
+   }
+   A.Finalize();
+
+   const int Cs[] = { 0, 1, 4, 8, 16 };
+   for (int C : Cs)
+   {
+      for (int sigma_chunks = 1; sigma_chunks <= 16; sigma_chunks *= 4)
+      {
+         const int sigma = (C ? C : 16) * sigma_chunks;
+         SELLMatrix S(A, C, sigma);
+         REQUIRE(S.NumStoredEntries() >= A.NumNonZeroElems());
+         REQUIRE(ProductDiff(S, A) < 1e-14);
+      }
+   }
+}
+
+TEST_CASE("BSR Matrix", "[SparseMatrix]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      Mesh *mesh = (dim == 2) ?
+                   new Mesh(4, 3, Element::QUADRILATERAL, true) :
+                   new Mesh(3, 2, 2, Element::HEXAHEDRON, true);
+      H1_FECollection fec(2, dim);
+      FiniteElementSpace fes(mesh, &fec, dim, Ordering::byVDIM);
+
+      ConstantCoefficient one(1.0), two(2.0);
+      BilinearForm a(&fes);
+      a.AddDomainIntegrator(new ElasticityIntegrator(one, two));
+      a.AddDomainIntegrator(new VectorMassIntegrator);
+      // Keep the zero entries, so the pattern consists of full blocks
+      a.Assemble(0);
+      a.Finalize(0);
+      const SparseMatrix &A = a.SpMat();
+      const int nnz = A.GetI()[A.Height()];
+
+      BSRMatrix B(A, dim);
+      REQUIRE(B.NumBlocks()*dim*dim == nnz);
+      REQUIRE(ProductDiff(B, A) < 1e-12);
+
+      // Blocks of size 1 give back the CSR matrix
+      BSRMatrix B1(A, 1);
+      REQUIRE(B1.NumBlocks() == nnz);
+      REQUIRE(ProductDiff(B1, A) < 1e-12);
+      delete mesh;
+   }
+}
+
+} // namespace sparse_formats
@@ -0,0 +1,116 @@
+// Copyright (c) 2010-2020, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "catch.hpp"
+
+using namespace mfem;
+
+namespace sparse_products
+{
+
+// Random sparse matrix with about 'per_row' entries per row
+static SparseMatrix *RandomSparse(int m, int n, int per_row, int seed)
+{
+   srand(seed);
+   SparseMatrix *S = new SparseMatrix(m, n);
+   for (int i = 0; i < m; i++)
+   {
+      for (int k = 0; k < per_row; k++)
+      {
+         S->Add(i, rand() % n, double(rand())/RAND_MAX - 0.5);
+      }
+   }
+   S->Finalize();
+   return S;
+}
+
+static double DenseDiff(const SparseMatrix &S, const DenseMatrix &D)
+{
+   DenseMatrix SD;
+   S.ToDenseMatrix(SD);
+   SD -= D;
+   return SD.MaxMaxNorm();
+}
+
+TEST_CASE("Sparse Matrix Products", "[SparseMatrix]")
+{
+   const int m = 40, n = 30, k = 35;
+   SparseMatrix *A = RandomSparse(m, n, 4, 1);
+   SparseMatrix *B = RandomSparse(n, k, 3, 2);
+   SparseMatrix *S = RandomSparse(n, n, 5, 3);
+   DenseMatrix Ad, Bd, Sd;
+   A->ToDenseMatrix(Ad);
+   B->ToDenseMatrix(Bd);
+   S->ToDenseMatrix(Sd);
+
+   SECTION("Transpose")
+   {
+      SparseMatrix *At = Transpose(*A);
+      DenseMatrix Adt(Ad, 't');
+      REQUIRE(DenseDiff(*At, Adt) == 0.0);
+      // The rows of the transpose are sorted by column index
+      for (int i = 0; i < At->Height(); i++)
+      {
+         const int *J = At->GetRowColumns(i);
+         for (int p = 1; p < At->RowSize(i); p++) { REQUIRE(J[p-1] < J[p]); }
+      }
+      delete At;
+   }
+
+   SECTION("Mult")
+   {
+      SparseMatrix *AB = Mult(*A, *B);
+      DenseMatrix ABd(m, k);
+      mfem::Mult(Ad, Bd, ABd);
+      REQUIRE(DenseDiff(*AB, ABd) < 1e-12);
+
+      // Reuse the pattern with new values of A
+      *A *= 2.0;
+      ABd *= 2.0;
+      REQUIRE(Mult(*A, *B, AB) == AB);
+      REQUIRE(DenseDiff(*AB, ABd) < 1e-12);
+      delete AB;
+   }
+
+   SECTION("RAP")
+   {
+      // R S R^T with R = A
+      SparseMatrix *RAPm = RAP(*S, *A);
+      DenseMatrix ASd(m, n), RAPd(m, m);
+      mfem::Mult(Ad, Sd, ASd);
+      MultABt(ASd, Ad, RAPd);
+      REQUIRE(DenseDiff(*RAPm, RAPd) < 1e-12);
+
+      // P^T S P with P = A^T
+      SparseMatrix *At = Transpose(*A);
+      SparseMatrix *PtAP = RAP(*At, *S, *At);
+      REQUIRE(DenseDiff(*PtAP, RAPd) < 1e-12);
+
+      // Reuse the patterns with new values of S
+      *S *= -3.0;
+      RAPd *= -3.0;
+      REQUIRE(RAP(*S, *A, RAPm) == RAPm);
+      REQUIRE(DenseDiff(*RAPm, RAPd) < 1e-12);
+      REQUIRE(RAP(*At, *S, *At, PtAP) == PtAP);
+      REQUIRE(DenseDiff(*PtAP, RAPd) < 1e-12);
+
+      delete PtAP;
+      delete At;
+      delete RAPm;
+   }
+
+   delete S;
+   delete B;
+   delete A;
+}
+
+} // namespace sparse_products
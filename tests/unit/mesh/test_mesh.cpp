@@ -91,3 +91,681 @@ TEST_CASE("Gecko integration in MFEM", "[Mesh]")
       }
    }
 }
+
+TEST_CASE("Point location with the element bounding box grid", "[Mesh]")
+{
+   for (int order : {1, 3})
+   {
+      Mesh mesh("../../data/star-mixed.mesh", 1, 1);
+      if (order > 1) { mesh.SetCurvature(order); }
+
+      for (int ref = 0; ref < 2; ref++)
+      {
+         // Points in the interior of some of the elements
+         const int ne = mesh.GetNE(), sdim = mesh.SpaceDimension();
+         const int npts = std::min(ne, 50);
+         DenseMatrix point_mat(sdim, npts);
+         Array<int> expected(npts);
+         IntegrationPoint ip;
+         ip.Set2(0.3, 0.2);
+         Vector pt;
+         for (int k = 0; k < npts; k++)
+         {
+            expected[k] = (k*7919) % ne;
+            point_mat.GetColumnReference(k, pt);
+            mesh.GetElementTransformation(expected[k])->Transform(ip, pt);
+         }
+
+         Array<int> elem_ids;
+         Array<IntegrationPoint> ips;
+         REQUIRE(mesh.FindPoints(point_mat, elem_ids, ips) == npts);
+
+         bool all_found = true;
+         for (int k = 0; k < npts; k++)
+         {
+            all_found &= (elem_ids[k] == expected[k]);
+            all_found &= (std::abs(ips[k].x - ip.x) < 1e-8);
+            all_found &= (std::abs(ips[k].y - ip.y) < 1e-8);
+         }
+         REQUIRE(all_found);
+
+         // Points outside of the mesh are not found
+         point_mat = 1e3;
+         REQUIRE(mesh.FindPoints(point_mat, elem_ids, ips, false) == 0);
+
+         // The grid is rebuilt after refinement
+         mesh.UniformRefinement();
+      }
+   }
+}
+
+TEST_CASE("Point location in curved elements", "[Mesh]")
+{
+   // The edges y = const of the mesh are bent so that the elements bulge out of
+   // the bounding boxes of their vertices
+   Mesh mesh(2, 2, Element::QUADRILATERAL, true, 1.0, 1.0);
+   mesh.SetCurvature(3);
+   mesh.Transform([](const Vector &x, Vector &y)
+   {
+      y = x;
+      y(1) += 0.6*x(1)*sin(2.0*M_PI*x(0));
+   });
+
+   const int ne = mesh.GetNE(), sdim = mesh.SpaceDimension();
+   const double ref_pts[3][2] = { {0.5, 0.9}, {0.5, 0.1}, {0.1, 0.5} };
+   DenseMatrix point_mat(sdim, 3*ne);
+   Array<int> expected(3*ne);
+   Vector pt;
+   for (int e = 0; e < ne; e++)
+   {
+      for (int i = 0; i < 3; i++)
+      {
+         IntegrationPoint ip;
+         ip.Set2(ref_pts[i][0], ref_pts[i][1]);
+         point_mat.GetColumnReference(3*e + i, pt);
+         mesh.GetElementTransformation(e)->Transform(ip, pt);
+         expected[3*e + i] = e;
+      }
+   }
+
+   // The bounding box of each element contains its points, even without the
+   // padding of the boxes
+   ElementBoundingBoxGrid grid;
+   grid.Build(mesh, 0.0);
+   Array<int> candidates;
+   bool all_candidates = true;
+   for (int k = 0; k < point_mat.Width(); k++)
+   {
+      grid.FindCandidates(point_mat.GetColumn(k), candidates);
+      all_candidates &= (candidates.Find(expected[k]) >= 0);
+   }
+   REQUIRE(all_candidates);
+
+   // The elements of the nearby cells, searched for the points not found in
+   // the candidates, include the candidates. There are none outside the grid.
+   Array<int> nearby;
+   bool all_nearby = true;
+   for (int k = 0; k < point_mat.Width(); k++)
+   {
+      const double *x = point_mat.GetColumn(k);
+      grid.FindCandidates(x, candidates);
+      grid.FindNearbyElements(x, nearby);
+      all_nearby &= grid.Contains(x);
+      for (int j = 0; j < candidates.Size(); j++)
+      {
+         all_nearby &= (nearby.Find(candidates[j]) >= 0);
+      }
+   }
+   REQUIRE(all_nearby);
+   const double far[2] = { 10.0, 0.5 };
+   REQUIRE(!grid.Contains(far));
+   grid.FindNearbyElements(far, nearby);
+   REQUIRE(nearby.Size() == 0);
+
+   Array<int> elem_ids;
+   Array<IntegrationPoint> ips;
+   REQUIRE(mesh.FindPoints(point_mat, elem_ids, ips) == point_mat.Width());
+   bool all_found = true;
+   for (int k = 0; k < point_mat.Width(); k++)
+   {
+      all_found &= (elem_ids[k] == expected[k]);
+   }
+   REQUIRE(all_found);
+}
+
+TEST_CASE("Native mesh partitioners", "[Mesh]")
+{
+   auto check_partitioning = [](Mesh &mesh, int nparts, int part_method,
+                                int &edgecut, double &imbalance)
+   {
+      int *partitioning = mesh.GeneratePartitioning(nparts, part_method);
+      Array<int> psize(nparts);
+      psize = 0;
+      for (int i = 0; i < mesh.GetNE(); i++)
+      {
+         REQUIRE(partitioning[i] >= 0);
+         REQUIRE(partitioning[i] < nparts);
+         psize[partitioning[i]]++;
+      }
+      REQUIRE(psize.Min() > 0);
+      if (part_method != 9)
+      {
+         // geometric partitioners split the elements evenly
+         REQUIRE(psize.Max() - psize.Min() <= 1);
+      }
+      mesh.GetPartitioningStats(partitioning, nparts, edgecut, imbalance);
+      REQUIRE(imbalance == Approx(double(psize.Max())*nparts/mesh.GetNE()));
+      delete [] partitioning;
+   };
+
+   Mesh quad_mesh(24, 24, Element::QUADRILATERAL);
+   Mesh hex_mesh(10, 10, 10, Element::HEXAHEDRON);
+   Mesh tet_mesh(6, 6, 6, Element::TETRAHEDRON);
+   for (Mesh *mesh_ptr : {&quad_mesh, &hex_mesh, &tet_mesh})
+   {
+      Mesh &mesh = *mesh_ptr;
+      for (int nparts : {2, 7, 16})
+      {
+         int edgecut[4];
+         double imbalance[4];
+         for (int m = 0; m < 4; m++)
+         {
+            check_partitioning(mesh, nparts, 6 + m, edgecut[m], imbalance[m]);
+         }
+         // the graph partitioner is balanced and its edge-cut is comparable
+         // to the one of recursive coordinate bisection
+         REQUIRE(imbalance[3] <= 1.05);
+         REQUIRE(edgecut[3] <= 1.3*edgecut[0]);
+      }
+   }
+
+   SECTION("Non-conforming mesh")
+   {
+      Mesh mesh(8, 8, Element::QUADRILATERAL);
+      mesh.EnsureNCMesh();
+      Array<int> refs;
+      for (int i = 0; i < mesh.GetNE(); i += 3) { refs.Append(i); }
+      mesh.GeneralRefinement(refs);
+      int edgecut;
+      double imbalance;
+      check_partitioning(mesh, 5, 7, edgecut, imbalance);
+      check_partitioning(mesh, 5, 9, edgecut, imbalance);
+   }
+}
+
+TEST_CASE("Binary mesh format", "[Mesh]")
+{
+   // the binary format must load the same mesh as the text format
+   auto check_same = [](Mesh &a, Mesh &b)
+   {
+      REQUIRE(a.Dimension() == b.Dimension());
+      REQUIRE(a.SpaceDimension() == b.SpaceDimension());
+      REQUIRE(a.GetNE() == b.GetNE());
+      REQUIRE(a.GetNBE() == b.GetNBE());
+      REQUIRE(a.GetNV() == b.GetNV());
+      Array<int> va, vb;
+      for (int i = 0; i < a.GetNE(); i++)
+      {
+         REQUIRE(a.GetAttribute(i) == b.GetAttribute(i));
+         a.GetElementVertices(i, va);
+         b.GetElementVertices(i, vb);
+         for (int j = 0; j < va.Size(); j++) { REQUIRE(va[j] == vb[j]); }
+      }
+      for (int i = 0; i < a.GetNBE(); i++)
+      {
+         REQUIRE(a.GetBdrAttribute(i) == b.GetBdrAttribute(i));
+         a.GetBdrElementVertices(i, va);
+         b.GetBdrElementVertices(i, vb);
+         for (int j = 0; j < va.Size(); j++) { REQUIRE(va[j] == vb[j]); }
+      }
+      for (int i = 0; i < a.GetNV(); i++)
+      {
+         for (int d = 0; d < a.SpaceDimension(); d++)
+         {
+            REQUIRE(a.GetVertex(i)[d] == b.GetVertex(i)[d]);
+         }
+      }
+      REQUIRE((a.GetNodes() == NULL) == (b.GetNodes() == NULL));
+      if (a.GetNodes())
+      {
+         Vector diff(*a.GetNodes());
+         diff -= *b.GetNodes();
+         REQUIRE(diff.Normlinf() == 0.0);
+      }
+   };
+
+   Mesh quad_mesh(5, 4, Element::QUADRILATERAL, true, 2.0, 1.0);
+   Mesh tet_mesh(3, 2, 4, Element::TETRAHEDRON);
+   Mesh curved_mesh(3, 3, 3, Element::HEXAHEDRON);
+   curved_mesh.SetCurvature(2);
+   for (Mesh *mesh_ptr : {&quad_mesh, &tet_mesh, &curved_mesh})
+   {
+      std::stringstream text, binary;
+      text.precision(17);
+      mesh_ptr->Print(text);
+      mesh_ptr->PrintBinary(binary);
+      Mesh text_mesh(text, 1, 1, true);
+      Mesh binary_mesh(binary, 1, 1, true);
+      check_same(text_mesh, binary_mesh);
+   }
+
+   SECTION("Memory mapped file")
+   {
+      const char *mesh_file = "binary_test.mesh";
+      {
+         std::ofstream out(mesh_file, std::ios::binary);
+         tet_mesh.PrintBinary(out);
+      }
+      std::stringstream binary;
+      tet_mesh.PrintBinary(binary);
+      Mesh ref_mesh(binary, 1, 1, true);
+
+      mapped_ifstream in(mesh_file);
+      REQUIRE(in.good());
+      Mesh mapped_mesh(in, 1, 1, true);
+      check_same(ref_mesh, mapped_mesh);
+      remove(mesh_file);
+   }
+
+   SECTION("GridFunction")
+   {
+      H1_FECollection fec(3, 3);
+      FiniteElementSpace fes(&curved_mesh, &fec, 2);
+      GridFunction x(&fes);
+      for (int i = 0; i < x.Size(); i++) { x(i) = sin(1.0 + i); }
+
+      std::stringstream binary;
+      x.SaveBinary(binary);
+      GridFunction y(&curved_mesh, binary);
+      REQUIRE(y.FESpace()->GetVSize() == x.Size());
+      REQUIRE(y.FESpace()->GetVDim() == 2);
+      y -= x;
+      REQUIRE(y.Normlinf() == 0.0);
+   }
+}
+
+TEST_CASE("Compact element storage", "[Mesh]")
+{
+   auto print = [](const Mesh &mesh)
+   {
+      std::ostringstream out;
+      mesh.Print(out);
+      return out.str();
+   };
+   auto same_table = [](const Table &a, const Table &b)
+   {
+      if (a.Size() != b.Size() || a.Size_of_connections() !=
+          b.Size_of_connections()) { return false; }
+      for (int i = 0; i <= a.Size(); i++)
+      {
+         if (a.GetI()[i] != b.GetI()[i]) { return false; }
+      }
+      for (int i = 0; i < a.Size_of_connections(); i++)
+      {
+         if (a.GetJ()[i] != b.GetJ()[i]) { return false; }
+      }
+      return true;
+   };
+   FunctionCoefficient f([](const Vector &x)
+   { return sin(x(0) + 2.0*x(1)) + x.Sum(); });
+
+   const Element::Type types[4] =
+   {
+      Element::QUADRILATERAL, Element::TRIANGLE,
+      Element::HEXAHEDRON, Element::TETRAHEDRON
+   };
+   for (int t = 0; t < 4; t++)
+   {
+      Mesh *ref_ptr = (t < 2) ? new Mesh(6, 5, types[t]) :
+                      new Mesh(3, 4, 2, types[t]);
+      Mesh &ref = *ref_ptr;
+      for (int i = 0; i < ref.GetNE(); i++) { ref.SetAttribute(i, 1 + i%3); }
+      ref.SetAttributes();
+      const int dim = ref.Dimension();
+
+      Mesh mesh(ref);
+      mesh.UseCompactElementStorage();
+      REQUIRE(mesh.HasCompactElementStorage());
+      REQUIRE(print(mesh) == print(ref));
+
+      // rebuild the topology from the compact storage
+      mesh.FinalizeTopology(false);
+      REQUIRE(mesh.HasCompactElementStorage());
+      REQUIRE(mesh.GetNEdges() == ref.GetNEdges());
+      REQUIRE(mesh.GetNFaces() == ref.GetNFaces());
+      REQUIRE(same_table(mesh.ElementToEdgeTable(), ref.ElementToEdgeTable()));
+      REQUIRE(same_table(mesh.ElementToElementTable(),
+                         ref.ElementToElementTable()));
+      if (dim == 3)
+      {
+         REQUIRE(same_table(mesh.ElementToFaceTable(),
+                            ref.ElementToFaceTable()));
+      }
+      Table *v2e = mesh.GetVertexToElementTable();
+      Table *ref_v2e = ref.GetVertexToElementTable();
+      REQUIRE(same_table(*v2e, *ref_v2e));
+      delete v2e;
+      delete ref_v2e;
+
+      Array<int> edges, cor, ref_edges, ref_cor;
+      for (int i = 0; i < mesh.GetNE(); i++)
+      {
+         REQUIRE(mesh.GetElementType(i) == ref.GetElementType(i));
+         mesh.GetElementEdges(i, edges, cor);
+         ref.GetElementEdges(i, ref_edges, ref_cor);
+         for (int j = 0; j < edges.Size(); j++)
+         {
+            REQUIRE(edges[j] == ref_edges[j]);
+            REQUIRE(cor[j] == ref_cor[j]);
+         }
+      }
+      for (int i = 0; i < mesh.GetNBE(); i++)
+      {
+         REQUIRE(mesh.GetBdrElementEdgeIndex(i) ==
+                 ref.GetBdrElementEdgeIndex(i));
+      }
+
+      // finite element spaces and the copy constructor work on the compact
+      // storage
+      Mesh copy(mesh);
+      REQUIRE(copy.HasCompactElementStorage());
+      for (Mesh *m : {&mesh, &copy})
+      {
+         H1_FECollection h1_fec(2, dim);
+         ND_FECollection nd_fec(1, dim);
+         FiniteElementSpace h1_fes(m, &h1_fec), ref_h1_fes(&ref, &h1_fec);
+         FiniteElementSpace nd_fes(m, &nd_fec), ref_nd_fes(&ref, &nd_fec);
+         REQUIRE(h1_fes.GetTrueVSize() == ref_h1_fes.GetTrueVSize());
+         REQUIRE(nd_fes.GetTrueVSize() == ref_nd_fes.GetTrueVSize());
+         GridFunction x(&h1_fes), ref_x(&ref_h1_fes);
+         x.ProjectCoefficient(f);
+         ref_x.ProjectCoefficient(f);
+         REQUIRE(x.ComputeL2Error(f) == Approx(ref_x.ComputeL2Error(f)));
+      }
+
+      // reading through the const accessors keeps the compact storage, while
+      // changes through the non-const ones switch back and are stored
+      const Mesh &cmesh = copy;
+      for (int i = 0; i < cmesh.GetNBE(); i++)
+      {
+         REQUIRE(cmesh.GetBdrElement(i)->GetAttribute() ==
+                 ref.GetBdrAttribute(i));
+      }
+      REQUIRE(copy.HasCompactElementStorage());
+      copy.GetBdrElement(0)->SetAttribute(7);
+      copy.GetElement(1)->SetAttribute(8);
+      REQUIRE(!copy.HasCompactElementStorage());
+      REQUIRE(copy.GetBdrAttribute(0) == 7);
+      REQUIRE(copy.GetAttribute(1) == 8);
+
+      // the orientation checks read and fix the compact storage in place
+      REQUIRE(mesh.CheckElementOrientation(false) == 0);
+      REQUIRE(mesh.CheckBdrElementOrientation(false) == 0);
+      REQUIRE(mesh.CheckElementOrientation(true) == 0);
+      REQUIRE(mesh.CheckBdrElementOrientation(true) == 0);
+      REQUIRE(mesh.HasCompactElementStorage());
+      {
+         Mesh flipped(ref);
+         int *bv = flipped.GetBdrElement(0)->GetVertices();
+         std::swap(bv[0], (dim == 3 && t != 3) ? bv[2] : bv[1]);
+         if (t != 2)
+         {
+            int *v = flipped.GetElement(0)->GetVertices();
+            std::swap((t == 0) ? v[1] : v[0], (t == 0) ? v[3] : v[1]);
+         }
+         flipped.UseCompactElementStorage();
+         REQUIRE(flipped.CheckElementOrientation(false) == (t != 2));
+         REQUIRE(flipped.CheckBdrElementOrientation(false) == 1);
+         REQUIRE(flipped.CheckElementOrientation(true) == (t != 2));
+         REQUIRE(flipped.CheckBdrElementOrientation(true) == 1);
+         REQUIRE(flipped.HasCompactElementStorage());
+         REQUIRE(print(flipped) == print(ref));
+      }
+
+      // refinement switches back to the Element objects
+      mesh.UniformRefinement();
+      ref.UniformRefinement();
+      REQUIRE(!mesh.HasCompactElementStorage());
+      REQUIRE(print(mesh) == print(ref));
+
+      delete ref_ptr;
+   }
+}
+
+// A Mesh refined uniformly with the general (hash table based) algorithm.
+class GeneralRefinementMesh : public Mesh
+{
+public:
+   GeneralRefinementMesh(const Mesh &mesh) : Mesh(mesh) { }
+   virtual void UniformRefinement2D() { UniformRefinement2D_base(); }
+   virtual void UniformRefinement3D() { UniformRefinement3D_base(); }
+};
+
+TEST_CASE("Tensor uniform refinement", "[Mesh]")
+{
+   auto print = [](const Mesh &mesh)
+   {
+      std::ostringstream out;
+      mesh.Print(out);
+      return out.str();
+   };
+   auto sorted = [](Array<int> a) { a.Sort(); return a; };
+   FunctionCoefficient f([](const Vector &x)
+   { return sin(x(0) + 2.0*x(1)) + x.Sum(); });
+   FunctionCoefficient p2([](const Vector &x) { return x*x + x(0) - 1.0; });
+
+   for (int t = 0; t < 3; t++)
+   {
+      Mesh *mesh_ptr = (t < 2) ? new Mesh(4, 3, Element::QUADRILATERAL) :
+                       new Mesh(3, 2, 4, Element::HEXAHEDRON);
+      Mesh &mesh = *mesh_ptr;
+      const int dim = mesh.Dimension();
+      if (t == 1)
+      {
+         // curved mesh
+         mesh.SetCurvature(2);
+         mesh.Transform([](const Vector &x, Vector &y)
+         { y = x; y(0) += 0.1*sin(3.0*x(1)); });
+      }
+      GeneralRefinementMesh ref(mesh);
+
+      // the first refinement creates the same vertices and elements
+      mesh.UniformRefinement();
+      ref.UniformRefinement();
+      if (!mesh.GetNodes()) { REQUIRE(print(mesh) == print(ref)); }
+
+      // so does the second one, since the edges and faces are numbered in
+      // the same way
+      mesh.UniformRefinement();
+      ref.UniformRefinement();
+      if (!mesh.GetNodes()) { REQUIRE(print(mesh) == print(ref)); }
+      REQUIRE(mesh.GetNV() == ref.GetNV());
+      REQUIRE(mesh.GetNE() == ref.GetNE());
+      REQUIRE(mesh.GetNBE() == ref.GetNBE());
+      REQUIRE(mesh.GetNEdges() == ref.GetNEdges());
+      REQUIRE(mesh.GetNFaces() == ref.GetNFaces());
+
+      // the refined mesh can be printed and loaded again together with a
+      // high-order grid function
+      {
+         std::istringstream mesh_in(print(mesh));
+         Mesh reloaded(mesh_in, 1, 1);
+         Array<int> edges, ref_edges, faces, ref_faces, cor;
+         for (int i = 0; i < mesh.GetNE(); i++)
+         {
+            mesh.GetElementEdges(i, edges, cor);
+            reloaded.GetElementEdges(i, ref_edges, cor);
+            REQUIRE(edges == ref_edges);
+            if (dim < 3) { continue; }
+            mesh.GetElementFaces(i, faces, cor);
+            reloaded.GetElementFaces(i, ref_faces, cor);
+            REQUIRE(faces == ref_faces);
+         }
+
+         H1_FECollection fec(3, dim);
+         FiniteElementSpace fes(&mesh, &fec);
+         GridFunction x(&fes);
+         x.ProjectCoefficient(f);
+         std::ostringstream gf_out;
+         x.Save(gf_out);
+         std::istringstream gf_in(gf_out.str());
+         GridFunction y(&reloaded, gf_in);
+         REQUIRE(y.ComputeL2Error(f) == Approx(x.ComputeL2Error(f)));
+         REQUIRE(y.ComputeL2Error(f) < 1e-2);
+      }
+
+      // the tables are consistent with the element vertices
+      Array<int> v, ev, fv, edges, cor, faces;
+      for (int i = 0; i < mesh.GetNE(); i++)
+      {
+         const Element *el = mesh.GetElement(i);
+         el->GetVertices(v);
+         mesh.GetElementEdges(i, edges, cor);
+         for (int j = 0; j < edges.Size(); j++)
+         {
+            const int *e = el->GetEdgeVertices(j);
+            mesh.GetEdgeVertices(edges[j], ev);
+            REQUIRE(ev[0] == std::min(v[e[0]], v[e[1]]));
+            REQUIRE(ev[1] == std::max(v[e[0]], v[e[1]]));
+         }
+         if (dim < 3) { continue; }
+         mesh.GetElementFaces(i, faces, cor);
+         for (int j = 0; j < faces.Size(); j++)
+         {
+            const int *lfv = el->GetFaceVertices(j);
+            Array<int> efv(4);
+            for (int k = 0; k < 4; k++) { efv[k] = v[lfv[k]]; }
+            mesh.GetFaceVertices(faces[j], fv);
+            REQUIRE(sorted(fv) == sorted(efv));
+         }
+      }
+      for (int i = 0; i < mesh.GetNBE(); i++)
+      {
+         mesh.GetBdrElementVertices(i, v);
+         if (dim == 2)
+         {
+            mesh.GetEdgeVertices(mesh.GetBdrElementEdgeIndex(i), ev);
+            REQUIRE(sorted(ev) == sorted(v));
+         }
+         else
+         {
+            mesh.GetFaceVertices(mesh.GetBdrElementEdgeIndex(i), fv);
+            REQUIRE(sorted(fv) == sorted(v));
+            mesh.GetBdrElementEdges(i, edges, cor);
+            for (int j = 0; j < edges.Size(); j++)
+            {
+               const int *e = mesh.GetBdrElement(i)->GetEdgeVertices(j);
+               mesh.GetEdgeVertices(edges[j], ev);
+               REQUIRE(ev[0] == std::min(v[e[0]], v[e[1]]));
+               REQUIRE(ev[1] == std::max(v[e[0]], v[e[1]]));
+            }
+         }
+      }
+      // the elements are numbered in the same way, so are their neighbors
+      const Table &el_to_el = mesh.ElementToElementTable();
+      const Table &ref_el_to_el = ref.ElementToElementTable();
+      for (int i = 0; i < mesh.GetNE(); i++)
+      {
+         Array<int> row, ref_row;
+         el_to_el.GetRow(i, row);
+         ref_el_to_el.GetRow(i, ref_row);
+         REQUIRE(sorted(row) == sorted(ref_row));
+      }
+
+      // finite element spaces on the two meshes are equivalent
+      H1_FECollection h1_fec(2, dim);
+      ND_FECollection nd_fec(1, dim);
+      FiniteElementSpace h1_fes(&mesh, &h1_fec), ref_h1_fes(&ref, &h1_fec);
+      FiniteElementSpace nd_fes(&mesh, &nd_fec), ref_nd_fes(&ref, &nd_fec);
+      REQUIRE(h1_fes.GetTrueVSize() == ref_h1_fes.GetTrueVSize());
+      REQUIRE(nd_fes.GetTrueVSize() == ref_nd_fes.GetTrueVSize());
+      GridFunction x(&h1_fes), ref_x(&ref_h1_fes);
+      x.ProjectCoefficient(f);
+      ref_x.ProjectCoefficient(f);
+      REQUIRE(x.ComputeL2Error(f) == Approx(ref_x.ComputeL2Error(f)));
+      GridFunction y(&nd_fes), ref_y(&ref_nd_fes);
+      VectorFunctionCoefficient g(dim, [](const Vector &x, Vector &y)
+      { y = 0.0; y(0) = x(1); y(1) = x(0)*x(0); });
+      y.ProjectCoefficient(g);
+      ref_y.ProjectCoefficient(g);
+      REQUIRE(y.ComputeL2Error(g) == Approx(ref_y.ComputeL2Error(g)));
+
+      // the refinement transformations transfer grid functions exactly
+      x.ProjectCoefficient(p2);
+      const double err = x.ComputeL2Error(p2);
+      mesh.UniformRefinement();
+      h1_fes.Update();
+      x.Update();
+      REQUIRE(fabs(x.ComputeL2Error(p2) - err) < 1e-8);
+
+      delete mesh_ptr;
+   }
+}
+
+#ifdef MFEM_USE_MPI
+
+TEST_CASE("Scalable parallel mesh loading", "[Parallel], [Mesh]")
+{
+   int myid;
+   MPI_Comm_rank(MPI_COMM_WORLD, &myid);
+
+   const char *mesh_file = "parallel_load_test.mesh";
+   const Element::Type types[4] =
+   {
+      Element::QUADRILATERAL, Element::TRIANGLE,
+      Element::HEXAHEDRON, Element::TETRAHEDRON
+   };
+   for (int t = 0; t < 4; t++)
+   {
+      Mesh *mesh_ptr = (t < 2) ? new Mesh(7, 5, types[t], true, 1.0, 1.0) :
+                       new Mesh(4, 3, 5, types[t], true, 1.0, 1.0, 1.0);
+      Mesh &mesh = *mesh_ptr;
+      const int dim = mesh.Dimension();
+      if (myid == 0)
+      {
+         std::ofstream out(mesh_file);
+         out.precision(17);
+         mesh.Print(out);
+      }
+      MPI_Barrier(MPI_COMM_WORLD);
+
+      ParMesh *pmesh = ParMesh::LoadParallel(MPI_COMM_WORLD, mesh_file);
+      REQUIRE(pmesh->GetGlobalNE() == mesh.GetNE());
+      REQUIRE(pmesh->ReduceInt(pmesh->GetNBE()) == mesh.GetNBE());
+
+      double vol = 0.0, pvol = 0.0;
+      for (int i = 0; i < mesh.GetNE(); i++) { vol += mesh.GetElementVolume(i); }
+      for (int i = 0; i < pmesh->GetNE(); i++)
+      {
+         pvol += pmesh->GetElementVolume(i);
+      }
+      MPI_Allreduce(MPI_IN_PLACE, &pvol, 1, MPI_DOUBLE, MPI_SUM,
+                    MPI_COMM_WORLD);
+      REQUIRE(pvol == Approx(vol));
+
+      // the shared vertices, edges and faces are identified correctly if the
+      // global number of true dofs of the lowest order spaces match
+      H1_FECollection h1_fec(1, dim);
+      ND_FECollection nd_fec(1, dim);
+      RT_FECollection rt_fec(0, dim);
+      ParFiniteElementSpace h1_fes(pmesh, &h1_fec);
+      ParFiniteElementSpace nd_fes(pmesh, &nd_fec);
+      ParFiniteElementSpace rt_fes(pmesh, &rt_fec);
+      REQUIRE(h1_fes.GlobalTrueVSize() == mesh.GetNV());
+      REQUIRE(nd_fes.GlobalTrueVSize() == mesh.GetNEdges());
+      REQUIRE(rt_fes.GlobalTrueVSize() == mesh.GetNumFaces());
+
+      delete pmesh;
+      delete mesh_ptr;
+      MPI_Barrier(MPI_COMM_WORLD);
+   }
+   if (myid == 0) { remove(mesh_file); }
+}
+
+TEST_CASE("Binary parallel mesh format", "[Parallel], [Mesh]")
+{
+   Mesh mesh(3, 4, 2, Element::HEXAHEDRON);
+   mesh.SetCurvature(2);
+   ParMesh pmesh(MPI_COMM_WORLD, mesh);
+
+   std::stringstream text, binary;
+   text.precision(17);
+   pmesh.ParPrint(text);
+   pmesh.ParPrintBinary(binary);
+   ParMesh text_pmesh(MPI_COMM_WORLD, text);
+   ParMesh binary_pmesh(MPI_COMM_WORLD, binary);
+
+   REQUIRE(binary_pmesh.GetNE() == text_pmesh.GetNE());
+   REQUIRE(binary_pmesh.GetNBE() == text_pmesh.GetNBE());
+   REQUIRE(binary_pmesh.GetNSharedFaces() == text_pmesh.GetNSharedFaces());
+   Vector diff(*binary_pmesh.GetNodes());
+   diff -= *text_pmesh.GetNodes();
+   REQUIRE(diff.Normlinf() == 0.0);
+
+   H1_FECollection fec(2, 3);
+   ParFiniteElementSpace fes(&binary_pmesh, &fec);
+   REQUIRE(fes.GlobalTrueVSize() ==
+           ParFiniteElementSpace(&text_pmesh, &fec).GlobalTrueVSize());
+}
+
+#endif // MFEM_USE_MPI